@@ -0,0 +1,75 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "vtkCriticalSection.h"
+
+#include <kaapic.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+vtkSimpleCriticalSection vtkSMPToolsCS;
+bool vtkSMPToolsInitialized = false;
+
+void vtkSMPToolsFinalizeKaapi()
+{
+  kaapic_finalize();
+}
+}
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+void vtkSMPToolsInitializeKaapi()
+{
+  vtkSMPTools::Initialize(0);
+}
+}
+}
+}
+
+void vtkSMPTools::Initialize(int numThreads)
+{
+  vtkSMPToolsCS.Lock();
+  if (!vtkSMPToolsInitialized)
+    {
+    // Kaapi reads the number of workers from the environment when it
+    // starts, so it can only be set before the first initialization.
+    if (numThreads > 0)
+      {
+      char buffer[64];
+      sprintf(buffer, "KAAPI_CPUCOUNT=%d", numThreads);
+      putenv(strdup(buffer));
+      }
+    kaapic_init(KAAPIC_START_ONLY_MAIN);
+    atexit(vtkSMPToolsFinalizeKaapi);
+    vtkSMPToolsInitialized = true;
+    }
+  vtkSMPToolsCS.Unlock();
+}
+
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  vtkSMPTools::Initialize(0);
+  return kaapic_get_concurrency();
+}
@@ -0,0 +1,31 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include <omp.h>
+
+void vtkSMPTools::Initialize(int numThreads)
+{
+  if (numThreads > 0)
+    {
+    omp_set_num_threads(numThreads);
+    }
+}
+
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return omp_get_max_threads();
+}
@@ -0,0 +1,82 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "vtkCriticalSection.h"
+
+#include <tbb/task_scheduler_init.h>
+
+namespace
+{
+vtkSimpleCriticalSection vtkSMPToolsCS;
+tbb::task_scheduler_init* vtkSMPToolsInit = 0;
+int vtkSMPToolsNumberOfThreads = 0;
+
+// Destroys the scheduler at exit so that TBB worker threads are joined.
+class vtkSMPToolsInitCleanup
+{
+public:
+  ~vtkSMPToolsInitCleanup()
+    {
+    delete vtkSMPToolsInit;
+    vtkSMPToolsInit = 0;
+    }
+};
+vtkSMPToolsInitCleanup vtkSMPToolsInitCleanupInstance;
+}
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+void vtkSMPToolsInitializeTBB()
+{
+  if (!vtkSMPToolsInit)
+    {
+    vtkSMPTools::Initialize(0);
+    }
+}
+}
+}
+}
+
+void vtkSMPTools::Initialize(int numThreads)
+{
+  vtkSMPToolsCS.Lock();
+  if (!vtkSMPToolsInit)
+    {
+    vtkSMPToolsInit = new tbb::task_scheduler_init(
+      numThreads > 0 ? numThreads : tbb::task_scheduler_init::automatic);
+    }
+  else if (numThreads > 0)
+    {
+    vtkSMPToolsInit->terminate();
+    vtkSMPToolsInit->initialize(numThreads);
+    }
+  if (numThreads > 0)
+    {
+    vtkSMPToolsNumberOfThreads = numThreads;
+    }
+  vtkSMPToolsCS.Unlock();
+}
+
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtkSMPToolsNumberOfThreads > 0 ? vtkSMPToolsNumberOfThreads :
+    tbb::task_scheduler_init::default_num_threads();
+}
@@ -0,0 +1,185 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+
+#include <stdlib.h>
+
+// An allocator that counts its calls and the bytes it holds.
+class CountingAllocator : public vtkArrayAllocator
+{
+public:
+  static CountingAllocator *New();
+  vtkTypeMacro(CountingAllocator,vtkArrayAllocator);
+
+  void *Allocate(size_t size)
+    {
+    this->Allocations++;
+    this->Bytes += size;
+    return this->Superclass::Allocate(size);
+    }
+  void *Reallocate(void *ptr, size_t size, size_t newSize)
+    {
+    this->Reallocations++;
+    this->Bytes += newSize - size;
+    return this->Superclass::Reallocate(ptr, size, newSize);
+    }
+  void Free(void *ptr, size_t size)
+    {
+    this->Frees++;
+    this->Bytes -= size;
+    this->Superclass::Free(ptr, size);
+    }
+
+  int Allocations;
+  int Reallocations;
+  int Frees;
+  size_t Bytes;
+
+protected:
+  CountingAllocator()
+    : Allocations(0), Reallocations(0), Frees(0), Bytes(0) {}
+};
+vtkStandardNewMacro(CountingAllocator);
+
+namespace
+{
+#define TEST_ASSERT(cond)                                               \
+  if (!(cond))                                                          \
+    {                                                                   \
+    cerr << "Line " << __LINE__ << ": " #cond " failed" << endl;        \
+    return false;                                                       \
+    }
+
+bool TestArrayAllocator()
+{
+  vtkNew<CountingAllocator> allocator;
+  {
+  vtkNew<vtkIntArray> array;
+  array->SetAllocator(allocator.GetPointer());
+  TEST_ASSERT(array->GetAllocator() == allocator.GetPointer());
+  for (int i = 0; i < 1000; i++)
+    {
+    array->InsertNextValue(i);
+    }
+  // The array grows through Reallocate().
+  TEST_ASSERT(allocator->Allocations == 1);
+  TEST_ASSERT(allocator->Reallocations > 1);
+  TEST_ASSERT(allocator->Bytes ==
+              static_cast<size_t>(array->GetSize()) * sizeof(int));
+  array->Squeeze();
+  TEST_ASSERT(allocator->Bytes == 1000 * sizeof(int));
+  for (int i = 0; i < 1000; i++)
+    {
+    TEST_ASSERT(array->GetValue(i) == i);
+    }
+
+  // A deep copy is allocated by the allocator of the copy.
+  vtkNew<vtkIntArray> copy;
+  copy->DeepCopy(array.GetPointer());
+  TEST_ASSERT(allocator->Allocations == 1);
+  copy->SetAllocator(allocator.GetPointer());
+  copy->DeepCopy(array.GetPointer());
+  TEST_ASSERT(allocator->Allocations == 2);
+  TEST_ASSERT(copy->GetValue(999) == 999);
+  }
+  // The memory is freed with the arrays.
+  TEST_ASSERT(allocator->Frees == 2);
+  TEST_ASSERT(allocator->Bytes == 0);
+  return true;
+}
+
+bool TestAllocatedArray()
+{
+  // Memory handed over to the array is resized in place and freed by its
+  // allocator, whatever the allocator of the array.
+  vtkNew<CountingAllocator> allocator;
+  vtkNew<CountingAllocator> other;
+  {
+  double *values = static_cast<double*>(allocator->Allocate(
+    10 * sizeof(double)));
+  for (int i = 0; i < 10; i++)
+    {
+    values[i] = i;
+    }
+  vtkNew<vtkDoubleArray> array;
+  array->SetAllocator(other.GetPointer());
+  array->SetAllocatedArray(values, 10, allocator.GetPointer());
+  TEST_ASSERT(array->GetNumberOfTuples() == 10);
+  array->InsertNextValue(10.0);
+  TEST_ASSERT(allocator->Reallocations == 1);
+  TEST_ASSERT(other->Allocations == 0);
+  for (int i = 0; i <= 10; i++)
+    {
+    TEST_ASSERT(array->GetValue(i) == i);
+    }
+
+  // New memory comes from the allocator of the array.
+  array->Initialize();
+  TEST_ASSERT(allocator->Frees == 1 && allocator->Bytes == 0);
+  array->SetNumberOfValues(20);
+  TEST_ASSERT(other->Allocations == 1);
+
+  // Memory saved by the user is copied when the array grows.
+  double user[4] = {0.0, 1.0, 2.0, 3.0};
+  array->SetArray(user, 4, 1);
+  TEST_ASSERT(other->Frees == 1);
+  array->InsertNextValue(4.0);
+  TEST_ASSERT(other->Allocations == 2);
+  TEST_ASSERT(array->GetValue(3) == 3.0 && array->GetValue(4) == 4.0);
+  }
+  TEST_ASSERT(other->Frees == 2 && other->Bytes == 0);
+  TEST_ASSERT(allocator->Bytes == 0);
+  return true;
+}
+
+bool TestDefaultAllocator()
+{
+  vtkNew<CountingAllocator> allocator;
+  vtkArrayAllocator::SetDefaultAllocator(allocator.GetPointer());
+  TEST_ASSERT(vtkArrayAllocator::GetDefaultAllocator() ==
+              allocator.GetPointer());
+  vtkIdTypeArray *array = vtkIdTypeArray::New();
+  array->SetNumberOfValues(100);
+  TEST_ASSERT(allocator->Allocations == 1);
+
+  // The array keeps using the allocator of its memory.
+  vtkArrayAllocator::SetDefaultAllocator(NULL);
+  array->Resize(200);
+  TEST_ASSERT(allocator->Reallocations == 1);
+  array->Delete();
+  TEST_ASSERT(allocator->Frees == 1 && allocator->Bytes == 0);
+
+  // Without allocator, the arrays use malloc().
+  vtkNew<vtkIdTypeArray> other;
+  other->SetNumberOfValues(100);
+  TEST_ASSERT(allocator->Allocations == 1);
+  return true;
+}
+}
+
+int TestArrayAllocator(int, char *[])
+{
+  if (!TestArrayAllocator() || !TestAllocatedArray() ||
+      !TestDefaultAllocator())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
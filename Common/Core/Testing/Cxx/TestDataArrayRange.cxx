@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayRange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBitArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkShortArray.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+namespace
+{
+#define TEST_ASSERT(cond)                                               \
+  if (!(cond))                                                          \
+    {                                                                   \
+    cerr << "Line " << __LINE__ << ": " #cond " failed" << endl;        \
+    return false;                                                       \
+    }
+
+// Records the range it is called with and compares it to the array.
+struct CheckWorker
+{
+  vtkDataArray *Array;
+  int TupleSize;
+  int ValueSize;
+  bool Same;
+
+  template <class T, int N>
+  void operator()(vtkDataArrayTupleRange<T, N>& range)
+    {
+    this->TupleSize = N;
+    this->ValueSize = static_cast<int>(sizeof(T));
+    this->Same =
+      range.GetNumberOfTuples() == this->Array->GetNumberOfTuples() &&
+      range.GetNumberOfComponents() == this->Array->GetNumberOfComponents();
+    vtkIdType i = 0;
+    typename vtkDataArrayTupleRange<T, N>::iterator it;
+    for (it = range.begin(); it != range.end(); ++it, ++i)
+      {
+      for (int c = 0; c < range.GetNumberOfComponents(); c++)
+        {
+        this->Same = this->Same &&
+          (*it)[c] == range(i, c) &&
+          range(i, c) == static_cast<T>(this->Array->GetComponent(i, c));
+        }
+      }
+    this->Same = this->Same && i == range.GetNumberOfTuples() &&
+      range.end() - range.begin() == range.GetNumberOfTuples() &&
+      range.GetValueEnd() - range.GetValueBegin() ==
+      range.GetNumberOfValues();
+    }
+};
+
+void Fill(vtkDataArray *array, int numComps, vtkIdType numTuples)
+{
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; i++)
+    {
+    for (int c = 0; c < numComps; c++)
+      {
+      array->SetComponent(i, c, (i * numComps + c) % 100);
+      }
+    }
+}
+
+bool TestDispatch(vtkDataArray *array, int numComps, int tupleSize)
+{
+  Fill(array, numComps, 17);
+  CheckWorker worker;
+  worker.Array = array;
+  worker.TupleSize = -1;
+  worker.Same = false;
+  TEST_ASSERT(vtkDataArrayRangeDispatch::Execute(array, worker));
+  TEST_ASSERT(worker.TupleSize == tupleSize);
+  TEST_ASSERT(worker.ValueSize == array->GetDataTypeSize());
+  TEST_ASSERT(worker.Same);
+  return true;
+}
+
+bool TestRange()
+{
+  vtkNew<vtkFloatArray> array;
+  Fill(array.GetPointer(), 3, 10);
+  vtkDataArrayTupleRange<float, 3> range(array.GetPointer());
+  TEST_ASSERT(range.GetNumberOfTuples() == 10);
+  TEST_ASSERT(range.GetNumberOfValues() == 30);
+
+  // Writing through the range writes to the array.
+  range(4, 2) = -1.0f;
+  TEST_ASSERT(array->GetComponent(4, 2) == -1.0);
+  range.GetTuple(5)[0] = -2.0f;
+  TEST_ASSERT(array->GetComponent(5, 0) == -2.0);
+
+  // Random access.
+  vtkDataArrayTupleRange<float, 3>::iterator it = range.begin();
+  TEST_ASSERT(it[7] == range.GetTuple(7));
+  it += 8;
+  TEST_ASSERT(*it == range.GetTuple(8));
+  TEST_ASSERT(*(--it) == range.GetTuple(7));
+  TEST_ASSERT(*(it - 7) == range.GetTuple(0));
+  TEST_ASSERT(range.begin() < it && it < range.end());
+  TEST_ASSERT(range.end() - it == 3);
+
+  // Runtime number of components over raw memory.
+  vtkDataArrayTupleRange<float> view(array->GetPointer(0), 5, 6);
+  TEST_ASSERT(view.GetNumberOfComponents() == 6);
+  TEST_ASSERT(view(2, 2) == -1.0f && view(2, 3) == -2.0f);
+  TEST_ASSERT(view.end() - view.begin() == 5);
+
+  // Values iterate over all the components.
+  std::fill(range.GetValueBegin(), range.GetValueEnd(), 3.0f);
+  TEST_ASSERT(array->GetComponent(9, 2) == 3.0);
+  return true;
+}
+
+bool TestFixed()
+{
+  vtkNew<vtkDoubleArray> points;
+  Fill(points.GetPointer(), 3, 8);
+  CheckWorker worker;
+  worker.Array = points.GetPointer();
+  worker.TupleSize = -1;
+  worker.Same = false;
+  TEST_ASSERT(vtkDataArrayRangeDispatch::ExecuteFixed<3>(
+                points.GetPointer(), worker));
+  TEST_ASSERT(worker.TupleSize == 3 && worker.Same);
+
+  // Arrays that are not handled are left to the caller.
+  worker.TupleSize = -1;
+  TEST_ASSERT(!vtkDataArrayRangeDispatch::ExecuteFixed<2>(
+                points.GetPointer(), worker));
+  vtkNew<vtkBitArray> bits;
+  bits->SetNumberOfTuples(8);
+  TEST_ASSERT(!vtkDataArrayRangeDispatch::Execute(bits.GetPointer(), worker));
+  TEST_ASSERT(worker.TupleSize == -1);
+  return true;
+}
+}
+
+int TestDataArrayRange(int, char *[])
+{
+  vtkNew<vtkUnsignedCharArray> ucharArray;
+  vtkNew<vtkShortArray> shortArray;
+  vtkNew<vtkIntArray> intArray;
+  vtkNew<vtkFloatArray> floatArray;
+  vtkNew<vtkDoubleArray> doubleArray;
+  if (!TestDispatch(ucharArray.GetPointer(), 1, 1) ||
+      !TestDispatch(shortArray.GetPointer(), 2, 0) ||
+      !TestDispatch(intArray.GetPointer(), 3, 3) ||
+      !TestDispatch(floatArray.GetPointer(), 9, 9) ||
+      !TestDispatch(doubleArray.GetPointer(), 4, 0) ||
+      !TestRange() || !TestFixed())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
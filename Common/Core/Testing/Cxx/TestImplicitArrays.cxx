@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAffineArray.h"
+#include "vtkConstantArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredPointArray.h"
+
+#include <stdlib.h>
+
+namespace
+{
+#define TEST_ASSERT(cond)                                               \
+  if (!(cond))                                                          \
+    {                                                                   \
+    cerr << "Line " << __LINE__ << ": " #cond " failed" << endl;        \
+    return false;                                                       \
+    }
+
+bool TestConstantArray()
+{
+  vtkNew<vtkConstantArray<float> > array;
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(1000000);
+  array->SetConstantValue(2.5f);
+  TEST_ASSERT(array->GetNumberOfValues() == 3000000);
+  TEST_ASSERT(array->GetActualMemorySize() < 8);
+  TEST_ASSERT(array->GetComponent(999999, 2) == 2.5);
+  TEST_ASSERT(array->GetDataType() == VTK_FLOAT);
+  TEST_ASSERT(!array->HasStandardMemoryLayout());
+  double *range = array->GetRange(1);
+  TEST_ASSERT(range[0] == 2.5 && range[1] == 2.5);
+
+  // Values are copied into ordinary arrays.
+  vtkSmartPointer<vtkDataArray> copy;
+  copy.TakeReference(array->NewInstance());
+  TEST_ASSERT(copy->IsA("vtkFloatArray"));
+  copy->SetNumberOfComponents(3);
+  copy->InsertNextTuple(10, array.GetPointer());
+  TEST_ASSERT(copy->GetNumberOfTuples() == 1);
+  TEST_ASSERT(copy->GetComponent(0, 1) == 2.5);
+
+  // The values are materialized for raw access, and follow the parameter.
+  float *values = static_cast<float*>(array->GetVoidPointer(0));
+  TEST_ASSERT(values[2999999] == 2.5f);
+  array->SetConstantValue(-1.0f);
+  values = static_cast<float*>(array->GetVoidPointer(0));
+  TEST_ASSERT(values[0] == -1.0f);
+  range = array->GetRange(0);
+  TEST_ASSERT(range[0] == -1.0 && range[1] == -1.0);
+
+  // The values cannot be modified.
+  vtkObject::GlobalWarningDisplayOff();
+  array->SetComponent(0, 0, 1.0);
+  vtkObject::GlobalWarningDisplayOn();
+  TEST_ASSERT(array->GetComponent(0, 0) == -1.0);
+  return true;
+}
+
+bool TestAffineArray()
+{
+  vtkNew<vtkAffineArray<vtkIdType> > ids;
+  ids->SetNumberOfTuples(100);
+  TEST_ASSERT(ids->GetValue(42) == 42);
+  TEST_ASSERT(ids->LookupValue(17) == 17);
+
+  vtkNew<vtkAffineArray<double> > array;
+  array->SetNumberOfComponents(2);
+  array->SetNumberOfTuples(10);
+  array->SetOffset(5.0);
+  array->SetSlope(-0.5);
+  TEST_ASSERT(array->GetComponent(3, 1) == 5.0 - 0.5 * 7);
+  double range[2];
+  array->GetRange(range, 0);
+  TEST_ASSERT(range[0] == 5.0 - 0.5 * 18 && range[1] == 5.0);
+
+  // Deep copy and interpolation into ordinary arrays.
+  vtkNew<vtkIdTypeArray> idsCopy;
+  idsCopy->DeepCopy(ids.GetPointer());
+  TEST_ASSERT(idsCopy->GetNumberOfTuples() == 100);
+  TEST_ASSERT(idsCopy->GetValue(99) == 99);
+  vtkNew<vtkDoubleArray> interpolated;
+  interpolated->SetNumberOfComponents(2);
+  interpolated->InterpolateTuple(0, 2, array.GetPointer(), 4,
+                                 array.GetPointer(), 0.5);
+  TEST_ASSERT(interpolated->GetComponent(0, 0) == array->GetComponent(3, 0));
+  return true;
+}
+
+bool TestStructuredPointArray()
+{
+  double origin[3] = {1.0, 2.0, 3.0};
+  double spacing[3] = {0.5, 0.25, 2.0};
+  int extent[6] = {-2, 2, 0, 3, 1, 2};
+  vtkNew<vtkStructuredPointArray<double> > coords;
+  coords->SetImage(origin, spacing, extent);
+  TEST_ASSERT(coords->GetNumberOfComponents() == 3);
+  TEST_ASSERT(coords->GetNumberOfTuples() == 5 * 4 * 2);
+
+  // Used as the points of a point set.
+  vtkNew<vtkPoints> points;
+  points->SetData(coords.GetPointer());
+  TEST_ASSERT(points->GetDataType() == VTK_DOUBLE);
+  TEST_ASSERT(points->GetNumberOfPoints() == 40);
+  double x[3];
+  points->GetPoint(5 * 4 + 5 + 3, x);
+  TEST_ASSERT(x[0] == 1.0 + 1 * 0.5 && x[1] == 2.0 + 1 * 0.25 &&
+              x[2] == 3.0 + 2 * 2.0);
+  double bounds[6];
+  points->GetBounds(bounds);
+  TEST_ASSERT(bounds[0] == 0.0 && bounds[1] == 2.0);
+  TEST_ASSERT(bounds[2] == 2.0 && bounds[3] == 2.75);
+  TEST_ASSERT(bounds[4] == 5.0 && bounds[5] == 7.0);
+  double *range = coords->GetRange(1);
+  TEST_ASSERT(range[0] == 2.0 && range[1] == 2.75);
+
+  // Deep copies store the points.
+  vtkNew<vtkPoints> copy;
+  copy->DeepCopy(points.GetPointer());
+  TEST_ASSERT(copy->GetData()->HasStandardMemoryLayout());
+  TEST_ASSERT(copy->GetNumberOfPoints() == 40);
+  copy->GetPoint(39, x);
+  TEST_ASSERT(x[0] == 2.0 && x[1] == 2.75 && x[2] == 7.0);
+  points->DeepCopy(copy.GetPointer());
+  TEST_ASSERT(points->GetData()->HasStandardMemoryLayout());
+  TEST_ASSERT(points->GetNumberOfPoints() == 40);
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  TEST_ASSERT(points->GetNumberOfPoints() == 41);
+
+  // Coordinates of a rectilinear grid.
+  vtkNew<vtkFloatArray> xs;
+  vtkNew<vtkFloatArray> ys;
+  vtkNew<vtkFloatArray> zs;
+  xs->InsertNextValue(0.0f);
+  xs->InsertNextValue(1.0f);
+  xs->InsertNextValue(4.0f);
+  ys->InsertNextValue(-1.0f);
+  ys->InsertNextValue(3.0f);
+  zs->InsertNextValue(7.0f);
+  vtkNew<vtkStructuredPointArray<float> > rectilinear;
+  rectilinear->SetRectilinear(xs.GetPointer(), ys.GetPointer(),
+                              zs.GetPointer());
+  TEST_ASSERT(rectilinear->GetNumberOfTuples() == 6);
+  float tuple[3];
+  rectilinear->GetTupleValue(5, tuple);
+  TEST_ASSERT(tuple[0] == 4.0f && tuple[1] == 3.0f && tuple[2] == 7.0f);
+  rectilinear->GetTuple(1, x);
+  TEST_ASSERT(x[0] == 1.0 && x[1] == -1.0 && x[2] == 7.0);
+  range = rectilinear->GetRange(0);
+  TEST_ASSERT(range[0] == 0.0 && range[1] == 4.0);
+  return true;
+}
+}
+
+int TestImplicitArrays(int, char *[])
+{
+  if (!TestConstantArray() || !TestAffineArray() ||
+      !TestStructuredPointArray())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
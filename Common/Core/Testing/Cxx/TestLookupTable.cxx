@@ -17,7 +17,12 @@
 #include "vtkLookupTable.h"
 #include "vtkMath.h"
 #include "vtkCommand.h"
+#include "vtkDoubleArray.h"
 #include "vtkSmartPointer.h"
+#include "vtkTypeTraits.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vector>
 
 // simple macro for performing tests
 #define TestAssert(t) \
@@ -47,6 +52,99 @@ private:
   unsigned long EventId;
 };
 
+// the color expected for a value, from MapValue()
+void expectedColor(vtkLookupTable *table, double v, int outFormat,
+                   unsigned char color[4])
+{
+  const unsigned char *rgba = table->MapValue(v);
+  double alpha = table->GetAlpha();
+  unsigned char a = (alpha >= 1.0 ? rgba[3] :
+    static_cast<unsigned char>(rgba[3]*alpha + 0.5));
+  unsigned char l = static_cast<unsigned char>(
+    rgba[0]*0.30 + rgba[1]*0.59 + rgba[2]*0.11 + 0.5);
+  switch (outFormat)
+    {
+    case VTK_RGBA:
+      color[0] = rgba[0]; color[1] = rgba[1]; color[2] = rgba[2];
+      color[3] = a;
+      break;
+    case VTK_RGB:
+      color[0] = rgba[0]; color[1] = rgba[1]; color[2] = rgba[2];
+      break;
+    case VTK_LUMINANCE_ALPHA:
+      color[0] = l; color[1] = a;
+      break;
+    default:
+      color[0] = l;
+      break;
+    }
+}
+
+// map every inIncr-th value and return the number of colors that differ
+// from MapValue()
+template<class T>
+int checkMapping(vtkLookupTable *table, std::vector<T>& values, int inIncr,
+                 int outFormat)
+{
+  int n = static_cast<int>(values.size())/inIncr;
+  std::vector<unsigned char> colors(n*outFormat);
+  table->MapScalarsThroughTable(&values[0], &colors[0],
+                                vtkTypeTraits<T>::VTKTypeID(), n, inIncr,
+                                outFormat);
+  int errors = 0;
+  for (int i = 0; i < n; i++)
+    {
+    unsigned char color[4];
+    expectedColor(table, values[i*inIncr], outFormat, color);
+    for (int c = 0; c < outFormat; c++)
+      {
+      errors += (colors[i*outFormat + c] != color[c]);
+      }
+    }
+  return errors;
+}
+
+// map a ramp of values of type T, with every format, on the linear and
+// logarithmic scales, with and without alpha
+template<class T>
+int checkMappings(vtkLookupTable *table, double lo, double hi)
+{
+  const int n = 100000;
+  std::vector<T> values(n);
+  for (int i = 0; i < n; i++)
+    {
+    values[i] = static_cast<T>(lo + (hi - lo)*((i*7919) % n)/(n - 1));
+    }
+  if (vtkTypeTraits<T>::VTKTypeID() == VTK_FLOAT ||
+      vtkTypeTraits<T>::VTKTypeID() == VTK_DOUBLE)
+    {
+    for (int i = 0; i < n; i += 97)
+      {
+      values[i] = static_cast<T>(vtkMath::Nan());
+      }
+    }
+
+  int errors = 0;
+  for (int scale = 0; scale < 2; scale++)
+    {
+    table->SetScaleToLinear();
+    table->SetTableRange(scale == 0 ? lo + 1 : 1, hi - 1);
+    table->SetScale(scale == 0 ? VTK_SCALE_LINEAR : VTK_SCALE_LOG10);
+    for (int blend = 0; blend < 2; blend++)
+      {
+      table->SetAlpha(blend == 0 ? 1.0 : 0.5);
+      for (int outFormat = VTK_LUMINANCE; outFormat <= VTK_RGBA; outFormat++)
+        {
+        errors += checkMapping(table, values, 1, outFormat);
+        }
+      errors += checkMapping(table, values, 3, VTK_RGBA);
+      }
+    }
+  table->SetScaleToLinear();
+  table->SetAlpha(1.0);
+  return errors;
+}
+
 }
 
 int TestLookupTable(int,char *[])
@@ -104,6 +202,47 @@ int TestLookupTable(int,char *[])
   TestAssert(table->GetIndex(lo*step) == 1);
   TestAssert(table->GetIndex(hi/step) == 254);
 
+  // == check mapping of arrays ==
+
+  table->SetScaleToLinear();
+  table->SetNanColor(0.1, 0.2, 0.3, 0.4);
+  table->SetAlphaRange(0.2, 1.0);
+  table->ForceBuild();
+  TestAssert(checkMappings<float>(table, -10.0, 1000.0) == 0);
+  TestAssert(checkMappings<double>(table, -10.0, 1000.0) == 0);
+  TestAssert(checkMappings<short>(table, -10.0, 1000.0) == 0);
+  TestAssert(checkMappings<int>(table, -10.0, 1000.0) == 0);
+  TestAssert(checkMappings<unsigned char>(table, 0.0, 255.0) == 0);
+  TestAssert(checkMappings<signed char>(table, -128.0, 127.0) == 0);
+
+  // magnitude of vectors
+  vtkSmartPointer<vtkDoubleArray> vectors =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(100000);
+  for (vtkIdType i = 0; i < vectors->GetNumberOfTuples(); i++)
+    {
+    vectors->SetTuple3(i, 0.1*(i % 101), -0.2*(i % 37), 0.01*i);
+    }
+  table->SetTableRange(0.0, 1000.0);
+  table->SetVectorModeToMagnitude();
+  vtkUnsignedCharArray *colors =
+    table->MapScalars(vectors, VTK_COLOR_MODE_MAP_SCALARS, -1);
+  int errors = 0;
+  for (vtkIdType i = 0; i < vectors->GetNumberOfTuples(); i++)
+    {
+    double *v = vectors->GetTuple3(i);
+    const unsigned char *rgba =
+      table->MapValue(sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]));
+    for (int c = 0; c < 4; c++)
+      {
+      errors += (colors->GetValue(4*i + c) != rgba[c]);
+      }
+    }
+  colors->Delete();
+  TestAssert(errors == 0);
+  table->SetVectorModeToComponent();
+
   // == check error reporting ==
 
   errorObserver observer;
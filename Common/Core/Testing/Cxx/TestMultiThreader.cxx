@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiThreader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAtomicInt32.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+
+#include <stdlib.h>
+
+static const int NumThreads = 4;
+static vtkAtomicInt32 Calls;
+static int Seen[NumThreads];
+
+VTK_THREAD_RETURN_TYPE CountCalls(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  int *seen = static_cast<int *>(info->UserData);
+  seen[info->ThreadID]++;
+  Calls.Increment();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Runs a nested SingleMethodExecute from within a thread.
+VTK_THREAD_RETURN_TYPE Nested(void *)
+{
+  int seen[NumThreads] = { 0, 0, 0, 0 };
+  vtkNew<vtkMultiThreader> mt;
+  mt->SetNumberOfThreads(NumThreads);
+  mt->SetSingleMethod(CountCalls, seen);
+  mt->SingleMethodExecute();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+static int CheckSeen(int expected)
+{
+  for (int i = 0; i < NumThreads; i++)
+    {
+    if (Seen[i] != expected)
+      {
+      cerr << "Thread " << i << " ran " << Seen[i] << " times, expected "
+           << expected << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestMultiThreader(int, char*[])
+{
+  const int iterations = 100;
+
+  // New threaders take UseThreadPool from the global default, which is
+  // on unless VTK_NO_THREAD_POOL is set.
+  int globalDefault = vtkMultiThreader::GetGlobalDefaultUseThreadPool();
+  if (globalDefault != (getenv("VTK_NO_THREAD_POOL") == NULL))
+    {
+    cerr << "Wrong global default for UseThreadPool." << endl;
+    return EXIT_FAILURE;
+    }
+  for (int useDefault = 0; useDefault < 2; useDefault++)
+    {
+    vtkMultiThreader::SetGlobalDefaultUseThreadPool(useDefault);
+    vtkNew<vtkMultiThreader> mt;
+    if (mt->GetUseThreadPool() != useDefault)
+      {
+      cerr << "UseThreadPool is " << mt->GetUseThreadPool()
+           << " instead of the global default " << useDefault << endl;
+      return EXIT_FAILURE;
+      }
+    if (mt->GetLastDispatchLatency() != 0.0)
+      {
+      cerr << "Dispatch latency is not initialized." << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  vtkMultiThreader::SetGlobalDefaultUseThreadPool(globalDefault);
+
+  for (int usePool = 0; usePool < 2; usePool++)
+    {
+    vtkNew<vtkMultiThreader> mt;
+    mt->SetUseThreadPool(usePool);
+    mt->SetNumberOfThreads(NumThreads);
+
+    // Repeated single method executions.
+    Calls.Set(0);
+    for (int i = 0; i < NumThreads; i++)
+      {
+      Seen[i] = 0;
+      }
+    mt->SetSingleMethod(CountCalls, Seen);
+    for (int iter = 0; iter < iterations; iter++)
+      {
+      mt->SingleMethodExecute();
+      if (mt->GetLastDispatchLatency() < 0.0)
+        {
+        cerr << "Negative dispatch latency." << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    if (Calls.Get() != iterations*NumThreads || !CheckSeen(iterations))
+      {
+      cerr << "SingleMethodExecute failed, UseThreadPool " << usePool << endl;
+      return EXIT_FAILURE;
+      }
+
+    // Multiple method executions.
+    Calls.Set(0);
+    for (int i = 0; i < NumThreads; i++)
+      {
+      Seen[i] = 0;
+      mt->SetMultipleMethod(i, CountCalls, Seen);
+      }
+    for (int iter = 0; iter < iterations; iter++)
+      {
+      mt->MultipleMethodExecute();
+      }
+    if (Calls.Get() != iterations*NumThreads || !CheckSeen(iterations))
+      {
+      cerr << "MultipleMethodExecute failed, UseThreadPool " << usePool
+           << endl;
+      return EXIT_FAILURE;
+      }
+
+    // Nested executions must not deadlock.
+    Calls.Set(0);
+    mt->SetSingleMethod(Nested, NULL);
+    mt->SingleMethodExecute();
+    if (Calls.Get() != NumThreads*NumThreads)
+      {
+      cerr << "Nested SingleMethodExecute failed, UseThreadPool " << usePool
+           << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkAtomicInt32.h"
+
+#include <vector>
+
+static const int Target = 10000;
+
+// Functor without Initialize()/Reduce(): marks every index it visits.
+class ARangeFunctor
+{
+public:
+  std::vector<int> Counts;
+  vtkAtomicInt32 Total;
+
+  ARangeFunctor() : Counts(Target, 0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i=begin; i<end; i++)
+      {
+      this->Counts[i]++;
+      this->Total.Increment();
+      }
+    }
+};
+
+// Functor with Initialize()/Reduce(): sums up per-thread partial sums.
+class MyFunctor
+{
+public:
+  vtkSMPThreadLocal<vtkIdType> Counter;
+  vtkSMPThreadLocal<int> NumberOfInitialize;
+  vtkIdType Sum;
+
+  MyFunctor() : Counter(0), NumberOfInitialize(0), Sum(0) {}
+
+  void Initialize()
+    {
+    this->NumberOfInitialize.Local()++;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType& counter = this->Counter.Local();
+    for (vtkIdType i=begin; i<end; i++)
+      {
+      counter += i;
+      }
+    }
+
+  void Reduce()
+    {
+    this->Sum = 0;
+    vtkSMPThreadLocal<vtkIdType>::iterator itr = this->Counter.begin();
+    vtkSMPThreadLocal<vtkIdType>::iterator end = this->Counter.end();
+    while (itr != end)
+      {
+      this->Sum += *itr;
+      ++itr;
+      }
+    }
+};
+
+// Const functor with a const Initialize()/Reduce().
+class MyConstFunctor
+{
+public:
+  mutable vtkAtomicInt32 Total;
+  mutable vtkAtomicInt32 Reduced;
+
+  void Initialize() const
+    {
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    this->Total.Add(static_cast<int>(end - begin));
+    }
+
+  void Reduce() const
+    {
+    this->Reduced.Increment();
+    }
+};
+
+int TestSMP(int, char*[])
+{
+  vtkSMPTools::Initialize(2);
+
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() < 1)
+    {
+    cerr << "Invalid estimated number of threads." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Every index must be visited exactly once, whatever the grain.
+  vtkIdType grains[] = { 0, 1, 7, 1000, Target, 2*Target };
+  for (size_t g=0; g<sizeof(grains)/sizeof(grains[0]); g++)
+    {
+    ARangeFunctor functor1;
+    vtkSMPTools::For(0, Target, grains[g], functor1);
+    for (int i=0; i<Target; i++)
+      {
+      if (functor1.Counts[i] != 1)
+        {
+        cerr << "Index " << i << " visited " << functor1.Counts[i]
+             << " times with grain " << grains[g] << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    if (functor1.Total.Get() != Target)
+      {
+      cerr << "Unexpected total " << functor1.Total.Get() << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Empty ranges must not call the functor.
+  ARangeFunctor functor2;
+  vtkSMPTools::For(5, 5, functor2);
+  if (functor2.Total.Get() != 0)
+    {
+    cerr << "Functor called for an empty range." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Thread local storage with Initialize() and Reduce().
+  MyFunctor functor3;
+  vtkSMPTools::For(0, Target, functor3);
+  vtkIdType expected = static_cast<vtkIdType>(Target) * (Target - 1) / 2;
+  if (functor3.Sum != expected)
+    {
+    cerr << "Sum is " << functor3.Sum << ", expected " << expected << endl;
+    return EXIT_FAILURE;
+    }
+  vtkSMPThreadLocal<int>::iterator itr = functor3.NumberOfInitialize.begin();
+  vtkSMPThreadLocal<int>::iterator end = functor3.NumberOfInitialize.end();
+  size_t numThreads = 0;
+  for (; itr != end; ++itr, ++numThreads)
+    {
+    if (*itr != 1)
+      {
+      cerr << "Initialize() called " << *itr << " times by a thread." << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (numThreads == 0 || numThreads != functor3.Counter.size())
+    {
+    cerr << "Initialize() was called by " << numThreads << " threads but "
+         << functor3.Counter.size() << " thread local objects exist." << endl;
+    return EXIT_FAILURE;
+    }
+
+  const MyConstFunctor functor4;
+  vtkSMPTools::For(0, Target, 10, functor4);
+  if (functor4.Total.Get() != Target || functor4.Reduced.Get() != 1)
+    {
+    cerr << "Const functor failed." << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
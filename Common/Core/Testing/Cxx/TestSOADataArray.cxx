@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSOADataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <stdlib.h>
+
+namespace
+{
+#define TEST_ASSERT(cond)                                               \
+  if (!(cond))                                                          \
+    {                                                                   \
+    cerr << "Line " << __LINE__ << ": " #cond " failed" << endl;        \
+    return false;                                                       \
+    }
+
+// Sums the components of the tuples of either layout.
+struct SumWorker
+{
+  double Sum;
+  int Layout;
+
+  template <class Range>
+  void Execute(const Range& range)
+    {
+    for (vtkIdType i = 0; i < range.GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < range.GetNumberOfComponents(); ++c)
+        {
+        this->Sum += range(i, c);
+        }
+      }
+    }
+
+  template <class T, int N>
+  void operator()(vtkDataArrayTupleRange<T, N>& range)
+    {
+    this->Layout = 0;
+    this->Execute(range);
+    }
+
+  template <class T, int N>
+  void operator()(vtkSOADataArrayTupleRange<T, N>& range)
+    {
+    this->Layout = N;
+    this->Execute(range);
+    }
+};
+
+// A 3-component array of 10 tuples whose tuple i is (i, 10 + i, 20 + i).
+vtkSOADataArrayTemplate<float>* NewPoints(float *x, float *y, float *z)
+{
+  for (int i = 0; i < 10; i++)
+    {
+    x[i] = i;
+    y[i] = 10 + i;
+    z[i] = 20 + i;
+    }
+  vtkSOADataArrayTemplate<float> *array = vtkSOADataArrayTemplate<float>::New();
+  array->SetNumberOfComponents(3);
+  array->SetArray(0, x, 10, true, true);
+  array->SetArray(1, y, 10, true, true);
+  array->SetArray(2, z, 10, true, true);
+  return array;
+}
+
+bool TestAdoptBuffers()
+{
+  float x[10], y[10], z[10];
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > array;
+  array.TakeReference(NewPoints(x, y, z));
+
+  // The buffers are used without copy.
+  TEST_ASSERT(array->GetComponentArrayPointer(1) == y);
+  TEST_ASSERT(array->GetNumberOfTuples() == 10);
+  TEST_ASSERT(array->GetDataType() == VTK_FLOAT);
+  TEST_ASSERT(!array->HasStandardMemoryLayout());
+  double tuple[3];
+  array->GetTuple(4, tuple);
+  TEST_ASSERT(tuple[0] == 4.0 && tuple[1] == 14.0 && tuple[2] == 24.0);
+  TEST_ASSERT(array->GetValue(3 * 5 + 2) == 25.0f);
+  array->SetComponent(2, 1, -1.0);
+  TEST_ASSERT(y[2] == -1.0f);
+
+  // GetVoidPointer() gives interleaved values, updated with the array.
+  float *values = static_cast<float*>(array->GetVoidPointer(0));
+  TEST_ASSERT(values[3 * 2 + 1] == -1.0f && values[3 * 9 + 2] == 29.0f);
+  array->SetComponent(2, 1, 12.0);
+  values = static_cast<float*>(array->GetVoidPointer(0));
+  TEST_ASSERT(values[3 * 2 + 1] == 12.0f);
+
+  double range[2];
+  array->GetRange(range, 2);
+  TEST_ASSERT(range[0] == 20.0 && range[1] == 29.0);
+
+  // Growing the array copies the saved buffers.
+  float next[3] = {10.0f, 20.0f, 30.0f};
+  TEST_ASSERT(array->InsertNextTupleValue(next) == 10);
+  TEST_ASSERT(array->GetComponentArrayPointer(0) != x);
+  TEST_ASSERT(array->GetComponent(10, 2) == 30.0);
+  TEST_ASSERT(array->GetComponent(9, 2) == 29.0);
+  TEST_ASSERT(x[9] == 9.0f);
+  return true;
+}
+
+bool TestGenericAPI()
+{
+  vtkNew<vtkSOADataArrayTemplate<int> > array;
+  array->SetNumberOfComponents(2);
+  for (int i = 0; i < 100; i++)
+    {
+    array->InsertNextTuple2(i, -i);
+    }
+  TEST_ASSERT(array->GetNumberOfTuples() == 100);
+  TEST_ASSERT(array->GetComponent(99, 1) == -99.0);
+  array->RemoveTuple(0);
+  TEST_ASSERT(array->GetNumberOfTuples() == 99);
+  TEST_ASSERT(array->GetComponent(0, 0) == 1.0);
+
+  // Arrays made like this one store interleaved values.
+  vtkSmartPointer<vtkDataArray> copy;
+  copy.TakeReference(array->NewInstance());
+  TEST_ASSERT(copy->IsA("vtkIntArray"));
+
+  // Deep copies in both directions.
+  copy->DeepCopy(array.GetPointer());
+  TEST_ASSERT(copy->GetNumberOfTuples() == 99);
+  TEST_ASSERT(copy->GetComponent(50, 1) == -51.0);
+  vtkNew<vtkSOADataArrayTemplate<int> > back;
+  back->DeepCopy(copy);
+  TEST_ASSERT(back->GetNumberOfComponents() == 2);
+  TEST_ASSERT(back->GetComponent(98, 0) == 99.0);
+  vtkNew<vtkDoubleArray> converted;
+  converted->DeepCopy(array.GetPointer());
+  TEST_ASSERT(converted->GetComponent(10, 1) == -11.0);
+
+  // Tuple copies in both directions.
+  copy->SetTuple(0, 5, array.GetPointer());
+  TEST_ASSERT(copy->GetComponent(0, 0) == 6.0);
+  copy->InsertNextTuple(7, array.GetPointer());
+  TEST_ASSERT(copy->GetNumberOfTuples() == 100);
+  TEST_ASSERT(copy->GetComponent(99, 1) == -8.0);
+  array->InsertTuple(120, 99, copy);
+  TEST_ASSERT(array->GetNumberOfTuples() == 121);
+  TEST_ASSERT(array->GetComponent(120, 1) == -8.0);
+
+  vtkNew<vtkIdList> ids;
+  ids->InsertNextId(3);
+  ids->InsertNextId(120);
+  vtkNew<vtkIntArray> tuples;
+  tuples->SetNumberOfComponents(2);
+  tuples->SetNumberOfTuples(2);
+  array->GetTuples(ids.GetPointer(), tuples.GetPointer());
+  TEST_ASSERT(tuples->GetValue(0) == 4 && tuples->GetValue(3) == -8);
+
+  // Interpolation in both directions.
+  double weights[2] = {0.5, 0.5};
+  vtkIdList *pair = ids.GetPointer();
+  pair->SetId(0, 0);
+  pair->SetId(1, 1);
+  copy->InterpolateTuple(0, pair, array.GetPointer(), weights);
+  TEST_ASSERT(copy->GetComponent(0, 0) == 2.0);
+  TEST_ASSERT(copy->GetComponent(0, 1) == -2.0);
+  array->InterpolateTuple(0, pair, copy, weights);
+  TEST_ASSERT(array->GetComponent(0, 0) == 2.0);
+  array->InterpolateTuple(1, 0, copy, 10, copy, 0.5);
+  TEST_ASSERT(array->GetComponent(1, 1) == -6.0);
+  return true;
+}
+
+bool TestRangeDispatch()
+{
+  float x[10], y[10], z[10];
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > array;
+  array.TakeReference(NewPoints(x, y, z));
+
+  SumWorker worker = {0.0, -1};
+  TEST_ASSERT(!vtkDataArrayRangeDispatch::Execute(array, worker));
+  TEST_ASSERT(!vtkDataArrayRangeDispatch::ExecuteFixed<3>(array, worker));
+  TEST_ASSERT(worker.Layout == -1);
+  TEST_ASSERT(vtkDataArrayRangeDispatch::ExecuteSOA(array, worker));
+  TEST_ASSERT(worker.Layout == 3 && worker.Sum == 3 * 45.0 + 300.0);
+  worker.Sum = 0.0;
+  TEST_ASSERT(vtkDataArrayRangeDispatch::ExecuteFixedSOA<3>(array, worker));
+  TEST_ASSERT(worker.Sum == 3 * 45.0 + 300.0);
+
+  // Other arrays are left to the caller.
+  vtkNew<vtkFloatArray> interleaved;
+  interleaved->SetNumberOfComponents(3);
+  interleaved->SetNumberOfTuples(10);
+  TEST_ASSERT(!vtkDataArrayRangeDispatch::ExecuteSOA(
+                interleaved.GetPointer(), worker));
+  TEST_ASSERT(!vtkDataArrayRangeDispatch::ExecuteFixedSOA<2>(array, worker));
+  return true;
+}
+}
+
+int TestSOADataArray(int, char *[])
+{
+  if (!TestAdoptBuffers() || !TestGenericAPI() || !TestRangeDispatch())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
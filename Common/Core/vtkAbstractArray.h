@@ -269,6 +269,16 @@ public:
   // must return true if and only if an array contains numeric data.
   virtual int IsNumeric() = 0;
 
+  // Description:
+  // Return true if the values of the array are stored as contiguous,
+  // interleaved tuples, so that GetVoidPointer() gives direct access to
+  // them. Arrays with another layout, such as vtkSOADataArrayTemplate,
+  // return false and are read and written with the tuple API.
+  virtual bool HasStandardMemoryLayout()
+    {
+    return true;
+    }
+
   // Description:
   // Subclasses must override this method and provide the right kind
   // of templated vtkArrayIteratorTemplate.
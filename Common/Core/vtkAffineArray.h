@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAffineArray - implicit array whose values are affine in index
+// .SECTION Description
+// vtkAffineArray is a read-only vtkImplicitArray whose value of index
+// valueIdx = tupleIdx * components + comp is Offset + Slope * valueIdx,
+// computed in the value type. With the default Offset of 0 and Slope of 1,
+// a vtkAffineArray<vtkIdType> is the array of the indices 0, 1, 2, ...
+// that vtkIdFilter and vtkGenerateIndexArray fill explicitly.
+//
+// .SECTION See Also
+// vtkImplicitArray vtkConstantArray
+
+#ifndef __vtkAffineArray_h
+#define __vtkAffineArray_h
+
+#include "vtkImplicitArray.h"
+#include "vtkObjectFactory.h" // For New()
+
+template <class T>
+class vtkAffineArray : public vtkImplicitArray<T>
+{
+public:
+  typedef T ValueType;
+  vtkImplicitArrayTypeMacro(vtkAffineArray<T>, vtkImplicitArray<T>);
+  static vtkAffineArray<T>* New()
+    {
+    vtkObject* ret = vtkObjectFactory::CreateInstance(
+      typeid(vtkAffineArray<T>).name());
+    if (ret)
+      {
+      return static_cast<vtkAffineArray<T>*>(ret);
+      }
+    return new vtkAffineArray<T>();
+    }
+  void PrintSelf(ostream& os, vtkIndent indent)
+    {
+    this->Superclass::PrintSelf(os, indent);
+    os << indent << "Offset: " << this->Offset << "\n";
+    os << indent << "Slope: " << this->Slope << "\n";
+    }
+
+  // Description:
+  // The value of index 0, and the increment between consecutive values.
+  void SetOffset(T offset)
+    {
+    if (this->Offset != offset)
+      {
+      this->Offset = offset;
+      this->DataChanged();
+      this->Modified();
+      }
+    }
+  T GetOffset() const { return this->Offset; }
+  void SetSlope(T slope)
+    {
+    if (this->Slope != slope)
+      {
+      this->Slope = slope;
+      this->DataChanged();
+      this->Modified();
+      }
+    }
+  T GetSlope() const { return this->Slope; }
+
+  T GetTypedComponent(vtkIdType tupleIdx, int comp) const
+    {
+    vtkIdType valueIdx = tupleIdx * this->NumberOfComponents + comp;
+    return static_cast<T>(this->Offset +
+                          this->Slope * static_cast<T>(valueIdx));
+    }
+
+protected:
+  vtkAffineArray() : Offset(0), Slope(1) {}
+  ~vtkAffineArray() {}
+
+  // The values of a component are monotonic: the range is reached at the
+  // first and last tuples.
+  void ComputeScalarRange(double range[2], int comp)
+    {
+    vtkIdType numTuples = this->GetNumberOfTuples();
+    if (numTuples > 0)
+      {
+      double first =
+        static_cast<double>(this->GetTypedComponent(0, comp));
+      double last =
+        static_cast<double>(this->GetTypedComponent(numTuples - 1, comp));
+      range[0] = (first < last ? first : last);
+      range[1] = (first < last ? last : first);
+      }
+    }
+
+  T Offset;
+  T Slope;
+
+private:
+  vtkAffineArray(const vtkAffineArray&);  // Not implemented.
+  void operator=(const vtkAffineArray&);  // Not implemented.
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
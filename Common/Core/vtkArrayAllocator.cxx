@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+vtkStandardNewMacro(vtkArrayAllocator);
+
+vtkArrayAllocator *vtkArrayAllocator::DefaultAllocator = 0;
+vtkArrayAllocatorCleanup vtkArrayAllocator::Cleanup;
+
+//----------------------------------------------------------------------------
+vtkArrayAllocatorCleanup::vtkArrayAllocatorCleanup()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkArrayAllocatorCleanup::~vtkArrayAllocatorCleanup()
+{
+  // Release the default allocator.
+  vtkArrayAllocator::SetDefaultAllocator(0);
+}
+
+//----------------------------------------------------------------------------
+vtkArrayAllocator::vtkArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkArrayAllocator::~vtkArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+void *vtkArrayAllocator::Allocate(size_t size)
+{
+  return malloc(size);
+}
+
+//----------------------------------------------------------------------------
+void *vtkArrayAllocator::Reallocate(void *ptr, size_t size, size_t newSize)
+{
+  // OS X's realloc does not free memory if the new block is smaller.  This
+  // is a very serious problem and causes huge amount of memory to be
+  // wasted. Do not use realloc on the Mac.
+#if defined __APPLE__
+  void *newPtr = this->Allocate(newSize);
+  if (newPtr)
+    {
+    memcpy(newPtr, ptr, size < newSize ? size : newSize);
+    this->Free(ptr, size);
+    }
+  return newPtr;
+#else
+  (void)size;
+  return realloc(ptr, newSize);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::Free(void *ptr, size_t vtkNotUsed(size))
+{
+  free(ptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::SetDefaultAllocator(vtkArrayAllocator *allocator)
+{
+  if (vtkArrayAllocator::DefaultAllocator == allocator)
+    {
+    return;
+    }
+  if (allocator)
+    {
+    allocator->Register(0);
+    }
+  if (vtkArrayAllocator::DefaultAllocator)
+    {
+    vtkArrayAllocator::DefaultAllocator->UnRegister(0);
+    }
+  vtkArrayAllocator::DefaultAllocator = allocator;
+}
+
+//----------------------------------------------------------------------------
+vtkArrayAllocator *vtkArrayAllocator::GetDefaultAllocator()
+{
+  return vtkArrayAllocator::DefaultAllocator;
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
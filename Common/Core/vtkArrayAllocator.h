@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkArrayAllocator - allocate the memory of data arrays
+// .SECTION Description
+// vtkArrayAllocator allocates, reallocates and frees the memory that
+// vtkDataArrayTemplate uses to store its values. This class uses malloc(),
+// realloc() and free(), as the arrays do by default; subclasses override
+// Allocate(), Reallocate() and Free() to place the arrays in huge pages,
+// NUMA-local memory, a pool or memory owned by an application.
+//
+// An allocator is given to a single array with
+// vtkDataArrayTemplate::SetAllocator(), or to all the arrays of the process
+// that do not have their own with SetDefaultAllocator(). An array remembers
+// the allocator that owns its memory and reallocates and frees that memory
+// through it, even if the allocators are changed in the meantime. Memory
+// allocated by an application can be handed over to an array with
+// vtkDataArrayTemplate::SetAllocatedArray(): the array then grows it with
+// Reallocate() instead of copying it into new memory.
+//
+// The methods of an allocator may be called concurrently by arrays used in
+// different threads.
+//
+// .SECTION See Also
+// vtkDataArrayTemplate
+
+#ifndef __vtkArrayAllocator_h
+#define __vtkArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+//BTX
+class VTKCOMMONCORE_EXPORT vtkArrayAllocatorCleanup
+{
+public:
+  vtkArrayAllocatorCleanup();
+  ~vtkArrayAllocatorCleanup();
+
+private:
+  vtkArrayAllocatorCleanup(const vtkArrayAllocatorCleanup& other); // no copy constructor
+  vtkArrayAllocatorCleanup& operator=(const vtkArrayAllocatorCleanup& rhs); // no copy assignment
+};
+//ETX
+
+class VTKCOMMONCORE_EXPORT vtkArrayAllocator : public vtkObject
+{
+public:
+  static vtkArrayAllocator *New();
+  vtkTypeMacro(vtkArrayAllocator,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Allocate a block of size bytes. Return NULL on failure.
+  virtual void *Allocate(size_t size);
+
+  // Description:
+  // Resize the block ptr of size bytes, which was allocated by this
+  // allocator, to newSize bytes, keeping its first min(size, newSize)
+  // bytes. Return the resized block, which may be ptr itself, or NULL on
+  // failure, in which case ptr is left untouched.
+  virtual void *Reallocate(void *ptr, size_t size, size_t newSize);
+
+  // Description:
+  // Release the block ptr of size bytes, which was allocated by this
+  // allocator.
+  virtual void Free(void *ptr, size_t size);
+
+  // Description:
+  // Set/Get the allocator of the arrays that do not have their own. The
+  // default is NULL, in which case the arrays use malloc(), realloc() and
+  // free() directly. The allocator is reference counted, so call Delete()
+  // on it after setting it.
+  static void SetDefaultAllocator(vtkArrayAllocator *allocator);
+  static vtkArrayAllocator *GetDefaultAllocator();
+
+//BTX
+  // Releases the default allocator when the program exits.
+  static vtkArrayAllocatorCleanup Cleanup;
+//ETX
+
+protected:
+  vtkArrayAllocator();
+  ~vtkArrayAllocator();
+
+private:
+  static vtkArrayAllocator *DefaultAllocator;
+
+  vtkArrayAllocator(const vtkArrayAllocator&);  // Not implemented.
+  void operator=(const vtkArrayAllocator&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkConstantArray - implicit array with the same value everywhere
+// .SECTION Description
+// vtkConstantArray is a read-only vtkImplicitArray whose values are all
+// equal to ConstantValue. It replaces the arrays filled with a single
+// value, such as a uniform scalar field, without allocating them:
+// \code
+// vtkConstantArray<float> *array = vtkConstantArray<float>::New();
+// array->SetNumberOfComponents(3);
+// array->SetNumberOfTuples(numPts);
+// array->SetConstantValue(1.0f);
+// \endcode
+//
+// .SECTION See Also
+// vtkImplicitArray vtkAffineArray
+
+#ifndef __vtkConstantArray_h
+#define __vtkConstantArray_h
+
+#include "vtkImplicitArray.h"
+#include "vtkObjectFactory.h" // For New()
+
+template <class T>
+class vtkConstantArray : public vtkImplicitArray<T>
+{
+public:
+  typedef T ValueType;
+  vtkImplicitArrayTypeMacro(vtkConstantArray<T>, vtkImplicitArray<T>);
+  static vtkConstantArray<T>* New()
+    {
+    vtkObject* ret = vtkObjectFactory::CreateInstance(
+      typeid(vtkConstantArray<T>).name());
+    if (ret)
+      {
+      return static_cast<vtkConstantArray<T>*>(ret);
+      }
+    return new vtkConstantArray<T>();
+    }
+  void PrintSelf(ostream& os, vtkIndent indent)
+    {
+    this->Superclass::PrintSelf(os, indent);
+    os << indent << "Constant Value: " << this->ConstantValue << "\n";
+    }
+
+  // Description:
+  // The value of all the components of all the tuples.
+  void SetConstantValue(T value)
+    {
+    if (this->ConstantValue != value)
+      {
+      this->ConstantValue = value;
+      this->DataChanged();
+      this->Modified();
+      }
+    }
+  T GetConstantValue() const { return this->ConstantValue; }
+
+  T GetTypedComponent(vtkIdType, int) const { return this->ConstantValue; }
+
+protected:
+  vtkConstantArray() : ConstantValue(0) {}
+  ~vtkConstantArray() {}
+
+  void ComputeScalarRange(double range[2], int)
+    {
+    if (this->GetNumberOfTuples() > 0)
+      {
+      range[0] = range[1] = static_cast<double>(this->ConstantValue);
+      }
+    }
+
+  T ConstantValue;
+
+private:
+  vtkConstantArray(const vtkConstantArray&);  // Not implemented.
+  void operator=(const vtkConstantArray&);  // Not implemented.
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
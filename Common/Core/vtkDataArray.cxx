@@ -138,6 +138,23 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
     vtkIdType numTuples = da->GetNumberOfTuples();
     this->NumberOfComponents = da->NumberOfComponents;
     this->SetNumberOfTuples(numTuples);
+
+    if (!da->HasStandardMemoryLayout())
+      {
+      // The values are not interleaved, use the generic double API
+      for (vtkIdType i=0; i < numTuples; i++)
+        {
+        this->SetTuple(i, da->GetTuple(i));
+        }
+      this->SetLookupTable(0);
+      if (da->LookupTable)
+        {
+        this->LookupTable = da->LookupTable->NewInstance();
+        this->LookupTable->DeepCopy(da->LookupTable);
+        }
+      return;
+      }
+
     void *input=da->GetVoidPointer(0);
 
     switch (da->GetDataType())
@@ -313,6 +330,35 @@ void vtkDataArray::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
     vtkIdType idx= i*numComp;
     double c;
 
+    if (!this->HasStandardMemoryLayout() ||
+        !fromData->HasStandardMemoryLayout())
+      {
+      // Compute the whole tuple first in case fromData == this.
+      double* tuple = new double[numComp];
+      for (int k=0; k<numComp; k++)
+        {
+        for (c=0, j=0; j<numIds; j++)
+          {
+          c += weights[j]*fromData->GetComponent(ids[j], k);
+          }
+        // Round integer types. Don't round floating point types.
+        switch (this->GetDataType())
+          {
+          vtkTemplateMacro(
+            VTK_TT v;
+            vtkDataArrayRoundIfNecessary(c, &v);
+            c = static_cast<double>(v));
+          }
+        tuple[k] = c;
+        }
+      for (int k=0; k<numComp; k++)
+        {
+        this->InsertComponent(i, k, tuple[k]);
+        }
+      delete [] tuple;
+      return;
+      }
+
     switch (fromData->GetDataType())
       {
     case VTK_BIT:
@@ -387,6 +433,25 @@ void vtkDataArray::InterpolateTuple(vtkIdType i,
   double c;
   vtkIdType loc = i * numComp;
 
+  if (!this->HasStandardMemoryLayout() ||
+      !fromData1->HasStandardMemoryLayout() ||
+      !fromData2->HasStandardMemoryLayout())
+    {
+    // Compute the whole tuple first in case a source is this array.
+    double* tuple = new double[numComp];
+    for (k=0; k<numComp; k++)
+      {
+      tuple[k] = (1.0 - t) * fromData1->GetComponent(id1, k)
+        + t * fromData2->GetComponent(id2, k);
+      }
+    for (k=0; k<numComp; k++)
+      {
+      this->InsertComponent(i, k, tuple[k]);
+      }
+    delete [] tuple;
+    return;
+    }
+
   switch (fromData1->GetDataType())
     {
     case VTK_BIT:
@@ -819,6 +884,15 @@ void vtkDataArray::GetTuples(vtkIdList *ptIds, vtkAbstractArray *aa)
     return;
     }
 
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    vtkIdType num=ptIds->GetNumberOfIds();
+    for (vtkIdType i=0; i<num; i++)
+      {
+      da->SetTuple(i,this->GetTuple(ptIds->GetId(i)));
+      }
+    return;
+    }
 
   switch (this->GetDataType())
     {
@@ -894,6 +968,16 @@ void vtkDataArray::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *aa)
     return;
     }
 
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    vtkIdType num=p2-p1+1;
+    for (vtkIdType i=0; i<num; i++)
+      {
+      da->SetTuple(i,this->GetTuple(p1+i));
+      }
+    return;
+    }
+
   switch (this->GetDataType())
     {
     vtkTemplateMacro(vtkCopyTuples1( static_cast<VTK_TT *>(this->GetVoidPointer(0)), da,
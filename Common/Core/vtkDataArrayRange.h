@@ -0,0 +1,457 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayRange.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArrayRange - typed access to the tuples of a data array
+// .SECTION Description
+// vtkDataArrayTupleRange is a light-weight view of the values of a data
+// array as tuples of their native type T. Unlike vtkDataArray::GetTuple()
+// and GetComponent(), its accessors are not virtual, do not convert to
+// double and do not use the internal tuple buffer of the array, so that
+// loops written with it are inlined, can be vectorized by the compiler and
+// can read the same array from several threads. When the number of
+// components N is given as a template argument, the tuple size is a
+// compile-time constant and the loops over the components are unrolled;
+// with N = 0 the number of components is read from the array.
+//
+// vtkDataArrayRangeDispatch turns a vtkDataArray into the matching range
+// and calls a functor with it. Execute() dispatches over the value type and
+// over the number of components, with fixed-size ranges for the common 1, 3
+// and 9 component arrays (scalars, vectors and tensors), and ExecuteFixed()
+// dispatches over the value type only, for arrays whose number of components
+// is known, such as point coordinates. The functor provides
+// \code
+// template <class T, int N>
+// void operator()(vtkDataArrayTupleRange<T, N>& range);
+// \endcode
+// Both methods return false, without calling the functor, for the arrays
+// that they do not handle (vtkBitArray, arrays whose values are not
+// interleaved, or a number of components other than N for ExecuteFixed()),
+// in which case the caller falls back to the generic vtkDataArray API.
+//
+// vtkSOADataArrayTupleRange is the range of a vtkSOADataArrayTemplate,
+// whose components are stored in separate buffers. It has the same
+// operator()(tupleId, comp) accessor, but no tuple pointers. ExecuteSOA()
+// and ExecuteFixedSOA() call a functor providing
+// \code
+// template <class T, int N>
+// void operator()(vtkSOADataArrayTupleRange<T, N>& range);
+// \endcode
+// with the range of structure-of-arrays arrays, so that workers written
+// with operator() can handle both layouts.
+//
+// \code
+// struct SumWorker
+// {
+//   double Sum;
+//   template <class T, int N>
+//   void operator()(vtkDataArrayTupleRange<T, N>& range)
+//     {
+//     for (vtkIdType i = 0; i < range.GetNumberOfTuples(); ++i)
+//       {
+//       for (int c = 0; c < range.GetNumberOfComponents(); ++c)
+//         {
+//         this->Sum += range(i, c);
+//         }
+//       }
+//     }
+// };
+// SumWorker worker = {0.0};
+// if (!vtkDataArrayRangeDispatch::Execute(array, worker))
+//   {
+//   // generic path with array->GetComponent()
+//   }
+// \endcode
+//
+// .SECTION See Also
+// vtkDataArrayTemplate vtkSOADataArrayTemplate vtkDataArrayDispatcher
+// vtkTemplateMacro
+
+#ifndef __vtkDataArrayRange_h
+#define __vtkDataArrayRange_h
+
+#include "vtkDataArray.h"
+#include "vtkDataArrayTemplate.h" // For the range of a templated array
+#include "vtkSOADataArrayTemplate.h" // For the range of a SOA array
+
+#include <iterator> // For std::random_access_iterator_tag
+
+template <class T, int N = 0>
+class vtkDataArrayTupleRange
+{
+public:
+  typedef T ValueType;
+
+  // Description:
+  // A random-access iterator over the tuples of the range. Dereferencing
+  // it yields a pointer to the components of the tuple.
+  class TupleIterator
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T* value_type;
+    typedef vtkIdType difference_type;
+    typedef T** pointer;
+    typedef T* reference;
+
+    TupleIterator() : Tuple(0), NumberOfComponents(N) {}
+    TupleIterator(T *tuple, int numComps)
+      : Tuple(tuple), NumberOfComponents(numComps) {}
+
+    T* operator*() const { return this->Tuple; }
+    T* operator[](vtkIdType n) const
+      {
+      return this->Tuple + n * this->GetStride();
+      }
+
+    TupleIterator& operator++()
+      {
+      this->Tuple += this->GetStride();
+      return *this;
+      }
+    TupleIterator operator++(int)
+      {
+      TupleIterator it(*this);
+      ++(*this);
+      return it;
+      }
+    TupleIterator& operator--()
+      {
+      this->Tuple -= this->GetStride();
+      return *this;
+      }
+    TupleIterator operator--(int)
+      {
+      TupleIterator it(*this);
+      --(*this);
+      return it;
+      }
+    TupleIterator& operator+=(vtkIdType n)
+      {
+      this->Tuple += n * this->GetStride();
+      return *this;
+      }
+    TupleIterator& operator-=(vtkIdType n)
+      {
+      this->Tuple -= n * this->GetStride();
+      return *this;
+      }
+    TupleIterator operator+(vtkIdType n) const
+      {
+      return TupleIterator(this->Tuple + n * this->GetStride(),
+                           this->NumberOfComponents);
+      }
+    TupleIterator operator-(vtkIdType n) const
+      {
+      return TupleIterator(this->Tuple - n * this->GetStride(),
+                           this->NumberOfComponents);
+      }
+    vtkIdType operator-(const TupleIterator& other) const
+      {
+      return (this->Tuple - other.Tuple) / this->GetStride();
+      }
+
+    bool operator==(const TupleIterator& other) const
+      { return this->Tuple == other.Tuple; }
+    bool operator!=(const TupleIterator& other) const
+      { return this->Tuple != other.Tuple; }
+    bool operator<(const TupleIterator& other) const
+      { return this->Tuple < other.Tuple; }
+    bool operator>(const TupleIterator& other) const
+      { return this->Tuple > other.Tuple; }
+    bool operator<=(const TupleIterator& other) const
+      { return this->Tuple <= other.Tuple; }
+    bool operator>=(const TupleIterator& other) const
+      { return this->Tuple >= other.Tuple; }
+
+  private:
+    int GetStride() const { return N > 0 ? N : this->NumberOfComponents; }
+
+    T *Tuple;
+    int NumberOfComponents;
+  };
+
+  typedef TupleIterator iterator;
+
+  // Description:
+  // A range over numberOfTuples tuples of numberOfComponents values stored
+  // contiguously at data. numberOfComponents must be N when N is not 0.
+  vtkDataArrayTupleRange(T *data, vtkIdType numberOfTuples,
+                         int numberOfComponents = N)
+    : Data(data), NumberOfTuples(numberOfTuples),
+      NumberOfComponents(numberOfComponents) {}
+
+  // Description:
+  // A range over all the tuples of an array. The number of components of
+  // the array must be N when N is not 0. The range is invalidated when the
+  // array is resized.
+  explicit vtkDataArrayTupleRange(vtkDataArrayTemplate<T> *array)
+    : Data(array->GetPointer(0)), NumberOfTuples(array->GetNumberOfTuples()),
+      NumberOfComponents(array->GetNumberOfComponents()) {}
+
+  // Description:
+  // The number of components of the tuples, N when N is not 0.
+  int GetNumberOfComponents() const
+    {
+    return N > 0 ? N : this->NumberOfComponents;
+    }
+
+  vtkIdType GetNumberOfTuples() const { return this->NumberOfTuples; }
+  vtkIdType GetNumberOfValues() const
+    {
+    return this->NumberOfTuples * this->GetNumberOfComponents();
+    }
+
+  // Description:
+  // The components of the tuple tupleId.
+  T* GetTuple(vtkIdType tupleId) const
+    {
+    return this->Data + tupleId * this->GetNumberOfComponents();
+    }
+
+  // Description:
+  // The component comp of the tuple tupleId.
+  T& operator()(vtkIdType tupleId, int comp) const
+    {
+    return this->Data[tupleId * this->GetNumberOfComponents() + comp];
+    }
+
+  // Description:
+  // Iterate over the tuples of the range.
+  TupleIterator begin() const
+    {
+    return TupleIterator(this->Data, this->NumberOfComponents);
+    }
+  TupleIterator end() const
+    {
+    return TupleIterator(this->Data + this->GetNumberOfValues(),
+                         this->NumberOfComponents);
+    }
+
+  // Description:
+  // Iterate over the values of the range, one component after the other.
+  T* GetValueBegin() const { return this->Data; }
+  T* GetValueEnd() const { return this->Data + this->GetNumberOfValues(); }
+
+private:
+  T *Data;
+  vtkIdType NumberOfTuples;
+  int NumberOfComponents;
+};
+
+template <class T, int N = 0>
+class vtkSOADataArrayTupleRange
+{
+public:
+  typedef T ValueType;
+
+  // Description:
+  // A range over all the tuples of an array. The number of components of
+  // the array must be N when N is not 0. The range is invalidated when the
+  // array is resized, and the array must be told with DataChanged() about
+  // values written through the range.
+  explicit vtkSOADataArrayTupleRange(vtkSOADataArrayTemplate<T> *array)
+    : NumberOfTuples(array->GetNumberOfTuples()),
+      NumberOfComponents(array->GetNumberOfComponents())
+    {
+    this->Components = new T*[this->NumberOfComponents];
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      this->Components[c] = array->GetComponentArrayPointer(c);
+      }
+    }
+  ~vtkSOADataArrayTupleRange()
+    {
+    delete [] this->Components;
+    }
+
+  // Description:
+  // The number of components of the tuples, N when N is not 0.
+  int GetNumberOfComponents() const
+    {
+    return N > 0 ? N : this->NumberOfComponents;
+    }
+
+  vtkIdType GetNumberOfTuples() const { return this->NumberOfTuples; }
+  vtkIdType GetNumberOfValues() const
+    {
+    return this->NumberOfTuples * this->GetNumberOfComponents();
+    }
+
+  // Description:
+  // The values of the component comp.
+  T* GetComponentArray(int comp) const { return this->Components[comp]; }
+
+  // Description:
+  // The component comp of the tuple tupleId.
+  T& operator()(vtkIdType tupleId, int comp) const
+    {
+    return this->Components[comp][tupleId];
+    }
+
+private:
+  vtkSOADataArrayTupleRange(const vtkSOADataArrayTupleRange&);  // Not implemented.
+  void operator=(const vtkSOADataArrayTupleRange&);  // Not implemented.
+
+  T **Components;
+  vtkIdType NumberOfTuples;
+  int NumberOfComponents;
+};
+
+class vtkDataArrayRangeDispatch
+{
+public:
+  // Description:
+  // Call functor with the range of array. The range is fixed-size for 1, 3
+  // and 9 components. Return false if the array is not handled.
+  template <class Functor>
+  static bool Execute(vtkDataArray *array, Functor& functor)
+    {
+    if (!array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        return vtkDataArrayRangeDispatch::ExecuteComponents(
+          static_cast<VTK_TT*>(array->GetVoidPointer(0)),
+          array->GetNumberOfTuples(), array->GetNumberOfComponents(),
+          functor));
+      }
+    return false;
+    }
+
+  // Description:
+  // Call functor with the fixed-size range of array, which has N
+  // components. Return false if the array is not handled.
+  template <int N, class Functor>
+  static bool ExecuteFixed(vtkDataArray *array, Functor& functor)
+    {
+    if (array->GetNumberOfComponents() != N ||
+        !array->HasStandardMemoryLayout())
+      {
+      return false;
+      }
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        return vtkDataArrayRangeDispatch::ExecuteRange<N>(
+          static_cast<VTK_TT*>(array->GetVoidPointer(0)),
+          array->GetNumberOfTuples(), N, functor));
+      }
+    return false;
+    }
+
+  // Description:
+  // Call functor with the range of array if it is a
+  // vtkSOADataArrayTemplate. The range is fixed-size for 1, 3 and 9
+  // components. Return false if the array is not handled.
+  template <class Functor>
+  static bool ExecuteSOA(vtkDataArray *array, Functor& functor)
+    {
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        return vtkDataArrayRangeDispatch::ExecuteSOAComponents(
+          vtkSOADataArrayTemplate<VTK_TT>::SafeDownCast(array), functor));
+      }
+    return false;
+    }
+
+  // Description:
+  // Call functor with the fixed-size range of array if it is a
+  // vtkSOADataArrayTemplate with N components. Return false if the array
+  // is not handled.
+  template <int N, class Functor>
+  static bool ExecuteFixedSOA(vtkDataArray *array, Functor& functor)
+    {
+    if (array->GetNumberOfComponents() != N)
+      {
+      return false;
+      }
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        return vtkDataArrayRangeDispatch::ExecuteSOARange<N>(
+          vtkSOADataArrayTemplate<VTK_TT>::SafeDownCast(array), functor));
+      }
+    return false;
+    }
+
+private:
+  template <int N, class T, class Functor>
+  static bool ExecuteRange(T *data, vtkIdType numTuples, int numComps,
+                           Functor& functor)
+    {
+    vtkDataArrayTupleRange<T, N> range(data, numTuples, numComps);
+    functor(range);
+    return true;
+    }
+
+  template <int N, class T, class Functor>
+  static bool ExecuteSOARange(vtkSOADataArrayTemplate<T> *array,
+                              Functor& functor)
+    {
+    if (!array)
+      {
+      return false;
+      }
+    vtkSOADataArrayTupleRange<T, N> range(array);
+    functor(range);
+    return true;
+    }
+
+  template <class T, class Functor>
+  static bool ExecuteSOAComponents(vtkSOADataArrayTemplate<T> *array,
+                                   Functor& functor)
+    {
+    switch (array ? array->GetNumberOfComponents() : 0)
+      {
+      case 0:
+        return false;
+      case 1:
+        return vtkDataArrayRangeDispatch::ExecuteSOARange<1>(array, functor);
+      case 3:
+        return vtkDataArrayRangeDispatch::ExecuteSOARange<3>(array, functor);
+      case 9:
+        return vtkDataArrayRangeDispatch::ExecuteSOARange<9>(array, functor);
+      default:
+        return vtkDataArrayRangeDispatch::ExecuteSOARange<0>(array, functor);
+      }
+    }
+
+  template <class T, class Functor>
+  static bool ExecuteComponents(T *data, vtkIdType numTuples, int numComps,
+                                Functor& functor)
+    {
+    switch (numComps)
+      {
+      case 1:
+        return vtkDataArrayRangeDispatch::ExecuteRange<1>(
+          data, numTuples, numComps, functor);
+      case 3:
+        return vtkDataArrayRangeDispatch::ExecuteRange<3>(
+          data, numTuples, numComps, functor);
+      case 9:
+        return vtkDataArrayRangeDispatch::ExecuteRange<9>(
+          data, numTuples, numComps, functor);
+      default:
+        return vtkDataArrayRangeDispatch::ExecuteRange<0>(
+          data, numTuples, numComps, functor);
+      }
+    }
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDataArrayRange.h
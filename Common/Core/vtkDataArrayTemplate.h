@@ -25,6 +25,8 @@
 #include "vtkDataArray.h"
 #include <cassert> // for assert()
 
+class vtkArrayAllocator;
+
 template <class T>
 class vtkDataArrayTemplateLookup;
 
@@ -236,6 +238,23 @@ public:
       this->SetArray(static_cast<T*>(array), size, save, deleteMethod);
     }
 
+  // Description:
+  // Hand over to the array a block of size values allocated by allocator.
+  // The array owns the block, as with SetArray() with save set to 0, but
+  // it resizes the block with allocator->Reallocate(), which may avoid a
+  // copy, and releases it with allocator->Free().
+  void SetAllocatedArray(T* array, vtkIdType size,
+                         vtkArrayAllocator* allocator);
+
+  // Description:
+  // Set/Get the allocator of the memory of this array. The default is NULL,
+  // in which case vtkArrayAllocator::GetDefaultAllocator() is used. The
+  // allocator is used for the memory allocated afterwards: the current
+  // memory is still resized and released by the allocator that allocated
+  // it.
+  void SetAllocator(vtkArrayAllocator* allocator);
+  vtkArrayAllocator* GetAllocator() { return this->Allocator; }
+
   // Description:
   // This method copies the array data to the void pointer specified
   // by the user.  It is up to the user to allocate enough memory for
@@ -289,6 +308,16 @@ protected:
   int SaveUserArray;
   int DeleteMethod;
 
+  vtkArrayAllocator* Allocator; // allocator of new memory
+  vtkArrayAllocator* ArrayAllocator; // allocator of Array, if any
+
+  // Allocate sz values with the allocator of the array, returned in owner.
+  T* NewArray(vtkIdType sz, vtkArrayAllocator** owner);
+  void SetArrayAllocator(vtkArrayAllocator* allocator);
+
+  // Copy the tuple j of a source array without standard memory layout.
+  void CopyTupleFrom(vtkIdType loc, vtkIdType j, vtkDataArray* source);
+
   virtual void ComputeScalarRange(double range[2], int comp);
   virtual void ComputeVectorRange(double range[2]);
 private:
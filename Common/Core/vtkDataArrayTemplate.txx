@@ -17,6 +17,7 @@
 
 #include "vtkDataArrayTemplate.h"
 
+#include "vtkArrayAllocator.h"
 #include "vtkArrayIteratorTemplate.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -78,6 +79,8 @@ vtkDataArrayTemplate<T>::vtkDataArrayTemplate(vtkIdType numComp):
   this->TupleSize = 0;
   this->SaveUserArray = 0;
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+  this->Allocator = 0;
+  this->ArrayAllocator = 0;
   this->Lookup = 0;
   this->ValueRange[0] = 0;
   this->ValueRange[1] = 1;
@@ -88,6 +91,7 @@ template <class T>
 vtkDataArrayTemplate<T>::~vtkDataArrayTemplate()
 {
   this->DeleteArray();
+  this->SetAllocator(0);
   if(this->Tuple)
     {
     free(this->Tuple);
@@ -123,6 +127,65 @@ void vtkDataArrayTemplate<T>::SetArray(T* array,
   this->DataChanged();
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetAllocatedArray(T* array,
+                                                vtkIdType size,
+                                                vtkArrayAllocator* allocator)
+{
+  this->SetArray(array, size, 0);
+  this->SetArrayAllocator(allocator);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetAllocator(vtkArrayAllocator* allocator)
+{
+  if(this->Allocator == allocator)
+    {
+    return;
+    }
+  if(allocator)
+    {
+    allocator->Register(this);
+    }
+  if(this->Allocator)
+    {
+    this->Allocator->UnRegister(this);
+    }
+  this->Allocator = allocator;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetArrayAllocator(vtkArrayAllocator* allocator)
+{
+  if(this->ArrayAllocator == allocator)
+    {
+    return;
+    }
+  if(allocator)
+    {
+    allocator->Register(this);
+    }
+  if(this->ArrayAllocator)
+    {
+    this->ArrayAllocator->UnRegister(this);
+    }
+  this->ArrayAllocator = allocator;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T* vtkDataArrayTemplate<T>::NewArray(vtkIdType sz, vtkArrayAllocator** owner)
+{
+  *owner = (this->Allocator ? this->Allocator :
+            vtkArrayAllocator::GetDefaultAllocator());
+  size_t bytes = static_cast<size_t>(sz) * sizeof(T);
+  return static_cast<T*>(*owner ? (*owner)->Allocate(bytes) : malloc(bytes));
+}
+
 //----------------------------------------------------------------------------
 // Allocate memory for this array. Delete old storage only if necessary.
 template <class T>
@@ -137,8 +200,8 @@ int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
     this->Size = 0;
 
     vtkIdType newSize = (sz > 0 ? sz : 1);
-    this->Array = static_cast<T*>(malloc(static_cast<size_t>(newSize)
-                                         * sizeof(T)));
+    vtkArrayAllocator* owner;
+    this->Array = this->NewArray(newSize, &owner);
     if(this->Array==0)
       {
       vtkErrorMacro("Unable to allocate " << newSize
@@ -155,6 +218,7 @@ int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
       return 0;
       #endif
       }
+    this->SetArrayAllocator(owner);
     this->Size = newSize;
     }
   this->DataChanged();
@@ -191,8 +255,10 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
     return;
     }
 
-  // If data type does not match, do copy with conversion.
-  if(fa->GetDataType() != this->GetDataType())
+  // If data type does not match, or the values are not interleaved, do
+  // copy with conversion.
+  if(fa->GetDataType() != this->GetDataType() ||
+     !fa->HasStandardMemoryLayout())
     {
     this->Superclass::DeepCopy(fa);
     this->DataChanged();
@@ -208,8 +274,8 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
   this->Size = fa->GetSize();
 
   this->Size = (this->Size > 0 ? this->Size : 1);
-  this->Array = static_cast<T* >(
-    malloc(static_cast<size_t>(this->Size) * sizeof(T)));
+  vtkArrayAllocator* owner;
+  this->Array = this->NewArray(this->Size, &owner);
   if(this->Array==0)
     {
     vtkErrorMacro("Unable to allocate " << this->Size
@@ -230,6 +296,7 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
     return;
     #endif
     }
+  this->SetArrayAllocator(owner);
   if (fa->GetSize() > 0)
     {
     memcpy(this->Array, fa->GetVoidPointer(0),
@@ -253,6 +320,15 @@ void vtkDataArrayTemplate<T>::PrintSelf(ostream& os, vtkIndent indent)
     {
     osw << indent << "Array: (null)\n";
     }
+  if(this->Allocator)
+    {
+    osw << indent << "Allocator: " << static_cast<void*>(this->Allocator)
+        << "\n";
+    }
+  else
+    {
+    osw << indent << "Allocator: (none)\n";
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -261,7 +337,12 @@ void vtkDataArrayTemplate<T>::DeleteArray()
 {
   if ((this->Array) && (!this->SaveUserArray))
     {
-    if (this->DeleteMethod == VTK_DATA_ARRAY_FREE)
+    if (this->ArrayAllocator)
+      {
+      this->ArrayAllocator->Free(this->Array,
+                                 static_cast<size_t>(this->Size)*sizeof(T));
+      }
+    else if (this->DeleteMethod == VTK_DATA_ARRAY_FREE)
       {
       free(this->Array);
       }
@@ -272,6 +353,7 @@ void vtkDataArrayTemplate<T>::DeleteArray()
     }
   this->SaveUserArray = 0;
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+  this->SetArrayAllocator(0);
   this->Array = 0;
 }
 
@@ -317,37 +399,27 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
   dontUseRealloc=true;
   #endif
 
-  // Allocate the new array or reallocate the old.
-  if (this->Array
-      &&
-      (this->SaveUserArray
-       || this->DeleteMethod==VTK_DATA_ARRAY_DELETE
-       || dontUseRealloc ))
+  // Allocate the new array or reallocate the old. Memory owned by an
+  // allocator is reallocated by it, new memory comes from the allocator of
+  // the array.
+  vtkArrayAllocator* owner = this->ArrayAllocator;
+  bool copy = false;
+  if (!this->Array)
     {
-    newArray = static_cast<T*>(malloc(static_cast<size_t>(newSize)*sizeof(T)));
-    if(!newArray)
-      {
-      vtkErrorMacro("Unable to allocate " << newSize
-                    << " elements of size " << sizeof(T)
-                    << " bytes. ");
-      #if !defined NDEBUG
-      // We're debugging, crash here preserving the stack
-      abort();
-      #elif !defined VTK_DONT_THROW_BAD_ALLOC
-      // We can throw something that has universal meaning
-      throw std::bad_alloc();
-      #else
-      // We indicate that malloc failed by return
-      return 0;
-      #endif
-      }
-    // Copy the data from the old array.
-    memcpy(newArray, this->Array,
-           static_cast<size_t>(newSize < this->Size ? newSize : this->Size)
-           * sizeof(T));
-
-    // Realease old array if we own
-    this->DeleteArray();
+    newArray = this->NewArray(newSize, &owner);
+    }
+  else if (!this->SaveUserArray && this->ArrayAllocator)
+    {
+    newArray = static_cast<T*>(this->ArrayAllocator->Reallocate(
+      this->Array, static_cast<size_t>(this->Size)*sizeof(T),
+      static_cast<size_t>(newSize)*sizeof(T)));
+    }
+  else if (this->SaveUserArray
+           || this->DeleteMethod==VTK_DATA_ARRAY_DELETE
+           || dontUseRealloc)
+    {
+    newArray = this->NewArray(newSize, &owner);
+    copy = true;
     }
   else
     {
@@ -355,23 +427,34 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
     // copying.
     newArray = static_cast<T*>(
       realloc(this->Array,static_cast<size_t>(newSize)*sizeof(T)));
-    if(!newArray)
-      {
-      vtkErrorMacro("Unable to allocate " << newSize
-                    << " elements of size " << sizeof(T)
-                    << " bytes. ");
-      #if !defined NDEBUG
-      // We're debugging, crash here preserving the stack
-      abort();
-      #elif !defined VTK_DONT_THROW_BAD_ALLOC
-      // We can throw something that has universal meaning
-      throw std::bad_alloc();
-      #else
-      // We indicate that malloc failed by return
-      return 0;
-      #endif
-      }
     }
+  if(!newArray)
+    {
+    vtkErrorMacro("Unable to allocate " << newSize
+                  << " elements of size " << sizeof(T)
+                  << " bytes. ");
+    #if !defined NDEBUG
+    // We're debugging, crash here preserving the stack
+    abort();
+    #elif !defined VTK_DONT_THROW_BAD_ALLOC
+    // We can throw something that has universal meaning
+    throw std::bad_alloc();
+    #else
+    // We indicate that malloc failed by return
+    return 0;
+    #endif
+    }
+  if (copy)
+    {
+    // Copy the data from the old array.
+    memcpy(newArray, this->Array,
+           static_cast<size_t>(newSize < this->Size ? newSize : this->Size)
+           * sizeof(T));
+
+    // Realease old array if we own
+    this->DeleteArray();
+    }
+  this->SetArrayAllocator(owner);
 
   // Allocation was successful.  Save it.
   if((newSize-1) < this->MaxId)
@@ -430,6 +513,12 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
     }
 
   vtkIdType loci = i * this->NumberOfComponents;
+  if (!source->HasStandardMemoryLayout())
+    {
+    this->CopyTupleFrom(loci, j, static_cast<vtkDataArray*>(source));
+    return;
+    }
+
   vtkIdType locj = j * source->GetNumberOfComponents();
 
   T* data = static_cast<T*>(source->GetVoidPointer(0));
@@ -470,13 +559,20 @@ void vtkDataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
       }
     }
 
-  vtkIdType locIn = j * inNumComp;
+  if (source->HasStandardMemoryLayout())
+    {
+    vtkIdType locIn = j * inNumComp;
 
-  T* outPtr = this->GetPointer(locOut);
-  T* inPtr = static_cast<T*>(source->GetVoidPointer(locIn));
+    T* outPtr = this->GetPointer(locOut);
+    T* inPtr = static_cast<T*>(source->GetVoidPointer(locIn));
 
-  size_t s=static_cast<size_t>(inNumComp);
-  memcpy(outPtr, inPtr, s*sizeof(T));
+    size_t s=static_cast<size_t>(inNumComp);
+    memcpy(outPtr, inPtr, s*sizeof(T));
+    }
+  else
+    {
+    this->CopyTupleFrom(locOut, j, static_cast<vtkDataArray*>(source));
+    }
 
   vtkIdType maxId = maxSize-1;
   if ( maxId > this->MaxId )
@@ -516,6 +612,20 @@ vtkIdType vtkDataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
       }
     }
 
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkIdType i = this->GetNumberOfTuples();
+    vtkIdType maxSize = (i + 1) * this->NumberOfComponents;
+    if (maxSize > this->Size && this->ResizeAndExtend(maxSize)==0)
+      {
+      return -1;
+      }
+    this->CopyTupleFrom(i * this->NumberOfComponents, j,
+                        static_cast<vtkDataArray*>(source));
+    this->MaxId = maxSize - 1;
+    return i;
+    }
+
   T* data = static_cast<T*>(source->GetVoidPointer(0));
   vtkIdType locj = j * source->GetNumberOfComponents();
 
@@ -526,6 +636,20 @@ vtkIdType vtkDataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
   return (this->GetNumberOfTuples()-1);
 }
 
+//----------------------------------------------------------------------------
+// Copy the tuple j of a source array of the same type whose values are not
+// interleaved into the allocated values starting at loc.
+template <class T>
+void vtkDataArrayTemplate<T>::CopyTupleFrom(vtkIdType loc, vtkIdType j,
+                                            vtkDataArray* source)
+{
+  for (int cur = 0; cur < this->NumberOfComponents; cur++)
+    {
+    this->Array[loc + cur] = static_cast<T>(source->GetComponent(j, cur));
+    }
+  this->DataChanged();
+}
+
 //----------------------------------------------------------------------------
 // Get a pointer to a tuple at the ith location. This is a dangerous method
 // (it is not thread safe since a pointer is returned).
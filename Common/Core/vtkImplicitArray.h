@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitArray - read-only data array computing its values
+// .SECTION Description
+// vtkImplicitArray is the abstract superclass of the data arrays whose
+// values are computed on demand from a few parameters instead of being
+// stored, like the point coordinates of vtkImageData. Subclasses implement
+// GetTypedComponent(); the number of values is set with
+// SetNumberOfComponents() and SetNumberOfTuples(), and costs no memory.
+//
+// The arrays are read-only: the methods of vtkDataArray that modify values
+// report an error. Arrays created with NewInstance() are ordinary
+// vtkDataArrayTemplate arrays of the same value type, so that the filters
+// copying or interpolating the attributes of their input produce arrays
+// they can write to. HasStandardMemoryLayout() returns false, so that the
+// generic code of vtkDataArray reads the values with the tuple API.
+// GetVoidPointer() materializes the values in a buffer kept until the
+// parameters of the array change, for code that needs raw pointers.
+//
+// .SECTION See Also
+// vtkConstantArray vtkAffineArray vtkStructuredPointArray
+// vtkSOADataArrayTemplate
+
+#ifndef __vtkImplicitArray_h
+#define __vtkImplicitArray_h
+
+#include "vtkDataArray.h"
+#include "vtkTypeTraits.h" // For the VTK type of the values
+
+#include <typeinfo> // For the class names of the templates
+
+// Description:
+// Equivalent of vtkTypeMacro for the implicit arrays. Since they are
+// templates, the classes are identified with typeid(), like with
+// vtkTypeTemplate, and NewInstance() creates a vtkDataArray storing the
+// values of the same type.
+#define vtkImplicitArrayTypeMacro(thisClass, superclass) \
+  typedef superclass Superclass; \
+  private: \
+  virtual const char* GetClassNameInternal() const { return #thisClass; } \
+  public: \
+  static int IsTypeOf(const char *type) \
+  { \
+    if ( !strcmp(typeid(thisClass).name(), type) ) \
+      { \
+      return 1; \
+      } \
+    return superclass::IsTypeOf(type); \
+  } \
+  virtual int IsA(const char *type) \
+  { \
+    return this->thisClass::IsTypeOf(type); \
+  } \
+  static thisClass* SafeDownCast(vtkObjectBase *o) \
+  { \
+    if ( o && o->IsA(typeid(thisClass).name()) ) \
+      { \
+      return static_cast<thisClass *>(o); \
+      } \
+    return NULL; \
+  } \
+  vtkDataArray *NewInstance() const \
+  { \
+    return static_cast<vtkDataArray *>(this->NewInstanceInternal()); \
+  } \
+  protected: \
+  virtual vtkObjectBase *NewInstanceInternal() const \
+  { \
+    return vtkDataArray::CreateDataArray( \
+      vtkTypeTraits<typename thisClass::ValueType>::VTKTypeID()); \
+  } \
+  public:
+
+template <class T>
+class vtkImplicitArray : public vtkDataArray
+{
+public:
+  typedef T ValueType;
+  vtkImplicitArrayTypeMacro(vtkImplicitArray<T>, vtkDataArray);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The component comp of the tuple tupleIdx. No range checking is
+  // performed.
+  virtual T GetTypedComponent(vtkIdType tupleIdx, int comp) const = 0;
+
+  // Description:
+  // The value valueIdx = tupleIdx * components + comp, and the tuple
+  // tupleIdx, in the native type.
+  T GetValue(vtkIdType valueIdx) const
+    {
+    return this->GetTypedComponent(valueIdx / this->NumberOfComponents,
+      static_cast<int>(valueIdx % this->NumberOfComponents));
+    }
+  void GetTupleValue(vtkIdType tupleIdx, T* tuple);
+
+  // Description:
+  // Set the number of values of the array. No memory is allocated.
+  void SetNumberOfTuples(vtkIdType number);
+  void SetNumberOfValues(vtkIdType number);
+  vtkIdType GetNumberOfValues() { return this->MaxId + 1; }
+
+  // Description:
+  // Reimplemented from vtkAbstractArray and vtkDataArray. The methods
+  // writing values report an error.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+  void Initialize();
+  int GetDataType() { return vtkTypeTraits<T>::VTKTypeID(); }
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+  bool HasStandardMemoryLayout() { return false; }
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double* tuple);
+  double GetComponent(vtkIdType i, int j);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple() { this->RemoveTuple(0); }
+  void RemoveLastTuple();
+  void SetComponent(vtkIdType i, int j, double c);
+  void InsertComponent(vtkIdType i, int j, double c);
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa)
+    { this->vtkDataArray::DeepCopy(aa); }
+  void Squeeze() {}
+  int Resize(vtkIdType numTuples);
+  void* GetVoidPointer(vtkIdType id);
+  void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  void SetVoidArray(void* array, vtkIdType size, int save);
+  void ExportToVoidPointer(void* out_ptr);
+  unsigned long GetActualMemorySize();
+  vtkArrayIterator* NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList* ids);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void DataChanged();
+  void ClearLookup() {}
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray();
+
+  // Report an error for the methods writing values.
+  void ReadOnlyError(const char* method);
+
+  double* Tuple; // for GetTuple(i)
+  T* Values; // for GetVoidPointer()
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&);  // Not implemented.
+  void operator=(const vtkImplicitArray&);  // Not implemented.
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
@@ -0,0 +1,374 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef __vtkImplicitArray_txx
+#define __vtkImplicitArray_txx
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkIdList.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+#include <cmath>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitArray<T>::vtkImplicitArray()
+{
+  this->Tuple = 0;
+  this->Values = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitArray<T>::~vtkImplicitArray()
+{
+  delete [] this->Tuple;
+  free(this->Values);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->vtkDataArray::PrintSelf(os, indent);
+  os << indent << "Materialized Values: "
+     << (this->Values ? "Yes\n" : "No\n");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::ReadOnlyError(const char* method)
+{
+  vtkErrorMacro(<< method << ": the values of " << this->GetClassName()
+                << " are read-only.");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::GetTupleValue(vtkIdType tupleIdx, T* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = this->GetTypedComponent(tupleIdx, comp);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetNumberOfTuples(vtkIdType number)
+{
+  this->SetNumberOfValues(number * this->NumberOfComponents);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetNumberOfValues(vtkIdType number)
+{
+  this->Size = (number > 0 ? number : 0);
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkImplicitArray<T>::Allocate(vtkIdType, vtkIdType)
+{
+  // There is nothing to allocate; like vtkDataArrayTemplate, the array is
+  // left empty.
+  this->SetNumberOfValues(0);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::Initialize()
+{
+  this->SetNumberOfValues(0);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkImplicitArray<T>::Resize(vtkIdType numTuples)
+{
+  vtkIdType numValues = numTuples * this->NumberOfComponents;
+  if (numValues < this->GetNumberOfValues())
+    {
+    this->SetNumberOfValues(numValues);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double* vtkImplicitArray<T>::GetTuple(vtkIdType i)
+{
+  delete [] this->Tuple;
+  this->Tuple = new double[this->NumberOfComponents];
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = static_cast<double>(this->GetTypedComponent(i, comp));
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double vtkImplicitArray<T>::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(this->GetTypedComponent(i, j));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetTuple(vtkIdType, vtkIdType, vtkAbstractArray*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::InsertTuple(vtkIdType, vtkIdType, vtkAbstractArray*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitArray<T>::InsertNextTuple(vtkIdType, vtkAbstractArray*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetTuple(vtkIdType, const float*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetTuple(vtkIdType, const double*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::InsertTuple(vtkIdType, const float*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::InsertTuple(vtkIdType, const double*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitArray<T>::InsertNextTuple(const float*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitArray<T>::InsertNextTuple(const double*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::RemoveTuple(vtkIdType)
+{
+  this->ReadOnlyError("RemoveTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::RemoveLastTuple()
+{
+  // Dropping the last tuple does not change the other values.
+  if (this->GetNumberOfTuples() > 0)
+    {
+    this->SetNumberOfTuples(this->GetNumberOfTuples() - 1);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetComponent(vtkIdType, int, double)
+{
+  this->ReadOnlyError("SetComponent");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::InsertComponent(vtkIdType, int, double)
+{
+  this->ReadOnlyError("InsertComponent");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::DeepCopy(vtkDataArray* da)
+{
+  if (da != NULL && da != this)
+    {
+    this->ReadOnlyError("DeepCopy");
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkImplicitArray<T>::GetVoidPointer(vtkIdType id)
+{
+  if (!this->Values)
+    {
+    vtkDebugMacro("GetVoidPointer called: materializing the values.");
+    vtkIdType numValues = this->GetNumberOfValues();
+    this->Values = static_cast<T*>(
+      malloc(static_cast<size_t>(numValues > 0 ? numValues : 1) * sizeof(T)));
+    this->ExportToVoidPointer(this->Values);
+    }
+  return this->Values + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkImplicitArray<T>::WriteVoidPointer(vtkIdType, vtkIdType)
+{
+  this->ReadOnlyError("WriteVoidPointer");
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetVoidArray(void*, vtkIdType, int)
+{
+  this->ReadOnlyError("SetVoidArray");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::ExportToVoidPointer(void* out_ptr)
+{
+  T* out = static_cast<T*>(out_ptr);
+  int numComps = this->NumberOfComponents;
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    for (int comp = 0; comp < numComps; ++comp)
+      {
+      *out++ = this->GetTypedComponent(i, comp);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+unsigned long vtkImplicitArray<T>::GetActualMemorySize()
+{
+  // Only the materialized values take memory.
+  double bytes = sizeof(*this);
+  if (this->Values)
+    {
+    bytes += static_cast<double>(this->GetNumberOfValues()) * sizeof(T);
+    }
+  return static_cast<unsigned long>(std::ceil(bytes / 1024.0));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkArrayIterator* vtkImplicitArray<T>::NewIterator()
+{
+  // The iterator reads the materialized values.
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitArray<T>::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  T v = vtkVariantCast<T>(value, &valid);
+  if (valid)
+    {
+    vtkIdType numValues = this->GetNumberOfValues();
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      if (this->GetValue(i) == v)
+        {
+        return i;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::LookupValue(vtkVariant value, vtkIdList* ids)
+{
+  ids->Reset();
+  bool valid = true;
+  T v = vtkVariantCast<T>(value, &valid);
+  if (valid)
+    {
+    vtkIdType numValues = this->GetNumberOfValues();
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      if (this->GetValue(i) == v)
+        {
+        ids->InsertNextId(i);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::SetVariantValue(vtkIdType, vtkVariant)
+{
+  this->ReadOnlyError("SetVariantValue");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitArray<T>::DataChanged()
+{
+  free(this->Values);
+  this->Values = 0;
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include "vtkMath.h"
 #include "vtkMathConfigure.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkVariantArray.h"
 
@@ -368,52 +369,6 @@ inline double vtkApplyLogScale(double v, const double range[2],
   return v;
 }
 
-//----------------------------------------------------------------------------
-// Apply shift/scale to the scalar value v and do table lookup.
-inline unsigned char *vtkLinearLookupMain(double v,
-                                          unsigned char *table,
-                                          double maxIndex,
-                                          double shift, double scale)
-{
-  double findx = (v + shift)*scale;
-
-  // do not change this code: it compiles into min/max opcodes
-  findx = (findx > 0 ? findx : 0);
-  findx = (findx < maxIndex ? findx : maxIndex);
-
-  return &table[4*static_cast<unsigned int>(findx)];
-}
-
-template<class T>
-unsigned char *vtkLinearLookup(
-  T v, unsigned char *table, double maxIndex, double shift, double scale,
-  unsigned char *vtkNotUsed(nanColor))
-{
-  return vtkLinearLookupMain(v, table, maxIndex, shift, scale);
-}
-
-//----------------------------------------------------------------------------
-// Check for not-a-number when mapping double or float
-inline unsigned char *vtkLinearLookup(
-  double v, unsigned char *table, double maxIndex, double shift, double scale,
-  unsigned char *nanColor)
-{
-  if (vtkMath::IsNan(v))
-    {
-    return nanColor;
-    }
-
-  return vtkLinearLookupMain(v, table, maxIndex, shift, scale);
-}
-
-inline unsigned char *vtkLinearLookup(
-  float v, unsigned char *table, double maxIndex, double shift, double scale,
-  unsigned char *nanColor)
-{
-  return vtkLinearLookup(static_cast<double>(v), table, maxIndex, shift, scale,
-                         nanColor);
-}
-
 //----------------------------------------------------------------------------
 void vtkLookupTable::GetLogRange(const double range[2], double log_range[2])
 {
@@ -536,300 +491,388 @@ unsigned char* vtkLookupTable::MapValue(double v)
 }
 
 //----------------------------------------------------------------------------
-template<class T>
-void vtkLookupTableMapData(vtkLookupTable *self, T *input,
-                           unsigned char *output, int length,
-                           int inIncr, int outFormat)
+// The values are mapped in blocks: the table indices of the values of a
+// block are computed first, in loops that the compiler can vectorize, and
+// the colors are then copied from the table. The blocks are mapped in
+// parallel by vtkSMPTools.
+namespace
 {
-  int i = length;
-  double *range = self->GetTableRange();
-  double maxIndex = self->GetNumberOfColors() - 1;
-  double shift, scale;
-  unsigned char *table = self->GetPointer(0);
-  unsigned char *cptr;
-  double alpha;
 
-  unsigned char nanColor[4];
-  const double *nanColord = self->GetNanColor();
-  for (int c = 0; c < 4; c++)
-    {
-    double v = nanColord[c];
-    if (v < 0.0) { v = 0.0; }
-    else if (v > 1.0) { v = 1.0; }
-    nanColor[c] = static_cast<unsigned char>(v*255.0 + 0.5);
-    }
+// The number of values of a block, and the least number of values mapped
+// by a thread, so that the rows mapped by threaded image filters are not
+// split further.
+const int vtkLookupTableBlockSize = 512;
+const vtkIdType vtkLookupTableGrainSize = 65536;
 
-  if ( (alpha=self->GetAlpha()) >= 1.0 ) //no blending required
-    {
-    if (self->GetScale() == VTK_SCALE_LOG10)
+//----------------------------------------------------------------------------
+// Compute the table index of a value, on a linear or a logarithmic scale.
+// Not-a-number is mapped to NanIndex, one past the end of the table.
+class vtkLookupTableIndexer
+{
+public:
+  vtkLookupTableIndexer(vtkLookupTable *self)
+  {
+    const double *range = self->GetTableRange();
+    this->Range[0] = range[0];
+    this->Range[1] = range[1];
+    this->MaxIndex = self->GetNumberOfColors() - 1;
+    this->NanIndex = static_cast<int>(self->GetNumberOfColors());
+    this->Log = (self->GetScale() == VTK_SCALE_LOG10);
+    this->HasByteIndices = false;
+
+    double r[2] = { range[0], range[1] };
+    if (this->Log)
       {
-      double val;
-      double logRange[2];
-      vtkLookupTableLogRange(range, logRange);
-      shift = -logRange[0];
-      if (logRange[1] <= logRange[0])
-        {
-        scale = VTK_DOUBLE_MAX;
-        }
-      else
+      vtkLookupTableLogRange(this->Range, this->LogRange);
+      r[0] = this->LogRange[0];
+      r[1] = this->LogRange[1];
+      }
+    this->Shift = -r[0];
+    if (r[1] <= r[0])
+      {
+      this->Scale = VTK_DOUBLE_MAX;
+      }
+    else
+      {
+      this->Scale = (this->MaxIndex + 1)/(r[1] - r[0]);
+      }
+  }
+
+  int ClampIndex(double v) const
+  {
+    double findx = (v + this->Shift)*this->Scale;
+
+    // do not change this code: it compiles into min/max opcodes
+    findx = (findx > 0 ? findx : 0);
+    findx = (findx < this->MaxIndex ? findx : this->MaxIndex);
+
+    return static_cast<int>(findx);
+  }
+
+  // Integers are never not-a-number.
+  template<class T>
+  int LinearIndex(T v) const
+  {
+    return this->ClampIndex(static_cast<double>(v));
+  }
+
+  int LinearIndex(double v) const
+  {
+    int index = this->ClampIndex(v);
+    return (vtkMath::IsNan(v) ? this->NanIndex : index);
+  }
+
+  int LinearIndex(float v) const
+  {
+    return this->LinearIndex(static_cast<double>(v));
+  }
+
+  template<class T>
+  int LogIndex(T v) const
+  {
+    return this->LinearIndex(
+      vtkApplyLogScale(static_cast<double>(v), this->Range, this->LogRange));
+  }
+
+  // Compute the indices of the 256 values of a one byte type, which are
+  // then looked up instead of computed.
+  template<class T>
+  void ComputeByteIndices()
+  {
+    for (int i = 0; i < 256; i++)
+      {
+      T v = static_cast<T>(i);
+      this->ByteIndices[static_cast<unsigned char>(v)] =
+        (this->Log ? this->LogIndex(v) : this->LinearIndex(v));
+      }
+    this->HasByteIndices = true;
+  }
+
+  double Range[2];
+  double LogRange[2];
+  double Shift;
+  double Scale;
+  double MaxIndex;
+  int NanIndex;
+  bool Log;
+  bool HasByteIndices;
+  int ByteIndices[256];
+};
+
+//----------------------------------------------------------------------------
+// Compute the indices of the values of a component.
+template<class T>
+class vtkLookupTableValues
+{
+public:
+  vtkLookupTableValues(const T *input, int inIncr)
+    : Input(input), Increment(inIncr) {}
+
+  void ComputeIndices(const vtkLookupTableIndexer& indexer, vtkIdType first,
+                      int n, int *indices) const
+  {
+    const T *input = this->Input + first*this->Increment;
+    const int inIncr = this->Increment;
+    if (indexer.HasByteIndices)
+      {
+      for (int i = 0; i < n; i++)
         {
-        scale = (maxIndex + 1)/(logRange[1] - logRange[0]);
+        indices[i] =
+          indexer.ByteIndices[static_cast<unsigned char>(input[i*inIncr])];
         }
-      if (outFormat == VTK_RGBA)
+      }
+    else if (indexer.Log)
+      {
+      for (int i = 0; i < n; i++)
         {
-        while (--i >= 0)
-          {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          output[3] = cptr[3];
-          input += inIncr;
-          output += 4;
-          }
+        indices[i] = indexer.LogIndex(input[i*inIncr]);
         }
-      else if (outFormat == VTK_RGB)
+      }
+    else if (inIncr == 1)
+      {
+      for (int i = 0; i < n; i++)
         {
-        while (--i >= 0)
-          {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          input += inIncr;
-          output += 3;
-          }
+        indices[i] = indexer.LinearIndex(input[i]);
         }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
+      }
+    else
+      {
+      for (int i = 0; i < n; i++)
         {
-        while (--i >= 0)
-          {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
-          output[0] = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          output[1] = cptr[3];
-          input += inIncr;
-          output += 2;
-          }
+        indices[i] = indexer.LinearIndex(input[i*inIncr]);
         }
-      else // outFormat == VTK_LUMINANCE
+      }
+  }
+
+private:
+  const T *Input;
+  int Increment;
+};
+
+//----------------------------------------------------------------------------
+// Compute the indices of the magnitudes of vectors.
+template<class T>
+class vtkLookupTableMagnitudes
+{
+public:
+  vtkLookupTableMagnitudes(const T *input, int numberOfComponents,
+                           int vectorSize)
+    : Input(input), NumberOfComponents(numberOfComponents),
+      VectorSize(vectorSize) {}
+
+  void ComputeIndices(const vtkLookupTableIndexer& indexer, vtkIdType first,
+                      int n, int *indices) const
+  {
+    const T *input = this->Input + first*this->NumberOfComponents;
+    double magnitudes[vtkLookupTableBlockSize];
+    for (int i = 0; i < n; i++)
+      {
+      const T *vector = input + i*this->NumberOfComponents;
+      double v = 0.0;
+      for (int j = 0; j < this->VectorSize; j++)
         {
-        while (--i >= 0)
-          {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
-          *output++ = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          input += inIncr;
-          }
+        double u = static_cast<double>(vector[j]);
+        v += u*u;
         }
-      }//if log scale
-
-    else //not log scale
+      magnitudes[i] = sqrt(v);
+      }
+    if (indexer.Log)
       {
-      shift = -range[0];
-      if (range[1] <= range[0])
+      for (int i = 0; i < n; i++)
         {
-        scale = VTK_DOUBLE_MAX;
+        indices[i] = indexer.LogIndex(magnitudes[i]);
         }
-      else
+      }
+    else
+      {
+      for (int i = 0; i < n; i++)
         {
-        scale = (maxIndex + 1)/(range[1] - range[0]);
+        indices[i] = indexer.LinearIndex(magnitudes[i]);
         }
+      }
+  }
+
+private:
+  const T *Input;
+  int NumberOfComponents;
+  int VectorSize;
+};
 
-      if (outFormat == VTK_RGBA)
+//----------------------------------------------------------------------------
+// Copy the colors of table indices to the output, blended with the alpha
+// of the table.
+class vtkLookupTableColorizer
+{
+public:
+  vtkLookupTableColorizer(vtkLookupTable *self, int outFormat)
+  {
+    const unsigned char *nanColor = self->GetNanColorAsUnsignedChars();
+    for (int c = 0; c < 4; c++)
+      {
+      this->NanColor[c] = nanColor[c];
+      }
+    this->Table = self->GetPointer(0);
+    this->NanIndex = static_cast<int>(self->GetNumberOfColors());
+    this->Alpha = self->GetAlpha();
+    this->OutputFormat = outFormat;
+  }
+
+  const unsigned char *GetColor(int index) const
+  {
+    return (index == this->NanIndex ? this->NanColor : this->Table + 4*index);
+  }
+
+  void MapIndices(const int *indices, int n, unsigned char *output) const
+  {
+    const double alpha = this->Alpha;
+    if (this->OutputFormat == VTK_RGBA)
+      {
+      if (alpha >= 1.0)
         {
-        while (--i >= 0)
+        for (int i = 0; i < n; i++)
           {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
+          const unsigned char *cptr = this->GetColor(indices[i]);
           output[0] = cptr[0];
           output[1] = cptr[1];
           output[2] = cptr[2];
           output[3] = cptr[3];
-          input += inIncr;
           output += 4;
           }
         }
-      else if (outFormat == VTK_RGB)
-        {
-        while (--i >= 0)
-          {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          input += inIncr;
-          output += 3;
-          }
-        }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-        {
-        while (--i >= 0)
-          {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          output[1] = cptr[3];
-          input += inIncr;
-          output += 2;
-          }
-        }
-      else // outFormat == VTK_LUMINANCE
-        {
-        while (--i >= 0)
-          {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          *output++ = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          input += inIncr;
-          }
-        }
-      }//if not log lookup
-    }//if blending not needed
-
-  else //blend with the specified alpha
-    {
-    if (self->GetScale() == VTK_SCALE_LOG10)
-      {
-      double val;
-      double logRange[2];
-      vtkLookupTableLogRange(range, logRange);
-      shift = -logRange[0];
-      if (logRange[1] <= logRange[0])
-        {
-        scale = VTK_DOUBLE_MAX;
-        }
       else
         {
-        scale = (maxIndex + 1)/(logRange[1] - logRange[0]);
-        }
-      if (outFormat == VTK_RGBA)
-        {
-        while (--i >= 0)
+        for (int i = 0; i < n; i++)
           {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
+          const unsigned char *cptr = this->GetColor(indices[i]);
           output[0] = cptr[0];
           output[1] = cptr[1];
           output[2] = cptr[2];
           output[3] = static_cast<unsigned char>(cptr[3]*alpha + 0.5);
-          input += inIncr;
           output += 4;
           }
         }
-      else if (outFormat == VTK_RGB)
+      }
+    else if (this->OutputFormat == VTK_RGB)
+      {
+      for (int i = 0; i < n; i++)
         {
-        while (--i >= 0)
-          {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          input += inIncr;
-          output += 3;
-          }
+        const unsigned char *cptr = this->GetColor(indices[i]);
+        output[0] = cptr[0];
+        output[1] = cptr[1];
+        output[2] = cptr[2];
+        output += 3;
         }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
+      }
+    else if (this->OutputFormat == VTK_LUMINANCE_ALPHA)
+      {
+      for (int i = 0; i < n; i++)
         {
-        while (--i >= 0)
-          {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
-          output[0] = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          output[1] = static_cast<unsigned char>(alpha*cptr[3] + 0.5);
-          input += inIncr;
-          output += 2;
-          }
+        const unsigned char *cptr = this->GetColor(indices[i]);
+        output[0] = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
+                                               cptr[2]*0.11 + 0.5);
+        output[1] = (alpha >= 1.0 ? cptr[3] :
+                     static_cast<unsigned char>(alpha*cptr[3] + 0.5));
+        output += 2;
         }
-      else // outFormat == VTK_LUMINANCE
+      }
+    else // outFormat == VTK_LUMINANCE
+      {
+      for (int i = 0; i < n; i++)
         {
-        while (--i >= 0)
-          {
-          val = vtkApplyLogScale(*input, range, logRange);
-          cptr = vtkLinearLookup(val, table, maxIndex, shift, scale, nanColor);
-          *output++ = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          input += inIncr;
-          }
+        const unsigned char *cptr = this->GetColor(indices[i]);
+        *output++ = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
+                                               cptr[2]*0.11 + 0.5);
         }
-      }//log scale with blending
+      }
+  }
+
+private:
+  const unsigned char *Table;
+  unsigned char NanColor[4];
+  int NanIndex;
+  double Alpha;
+  int OutputFormat;
+};
 
-    else //no log scale with blending
+//----------------------------------------------------------------------------
+// Map a range of values, block by block.
+template<class TReader>
+class vtkLookupTableMapFunctor
+{
+public:
+  vtkLookupTableMapFunctor(const vtkLookupTableIndexer *indexer,
+                           const vtkLookupTableColorizer *colorizer,
+                           const TReader& reader, unsigned char *output,
+                           int outFormat)
+    : Indexer(indexer), Colorizer(colorizer), Reader(reader), Output(output),
+      OutputFormat(outFormat) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    int indices[vtkLookupTableBlockSize];
+    for (vtkIdType first = begin; first < end;
+         first += vtkLookupTableBlockSize)
       {
-      shift = -range[0];
-      if (range[1] <= range[0])
-        {
-        scale = VTK_DOUBLE_MAX;
-        }
-      else
-        {
-        scale = (maxIndex + 1)/(range[1] - range[0]);
-        }
+      int n = static_cast<int>(end - first < vtkLookupTableBlockSize ?
+                               end - first : vtkLookupTableBlockSize);
+      this->Reader.ComputeIndices(*this->Indexer, first, n, indices);
+      this->Colorizer->MapIndices(
+        indices, n, this->Output + first*this->OutputFormat);
+      }
+  }
 
-      if (outFormat == VTK_RGBA)
-        {
-        while (--i >= 0)
-          {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          output[3] = static_cast<unsigned char>(cptr[3]*alpha + 0.5);
-          input += inIncr;
-          output += 4;
-          }
-        }
-      else if (outFormat == VTK_RGB)
-        {
-        while (--i >= 0)
-          {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          input += inIncr;
-          output += 3;
-          }
-        }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-        {
-        while (--i >= 0)
-          {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          output[0] = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          output[1] = static_cast<unsigned char>(cptr[3]*alpha + 0.5);
-          input += inIncr;
-          output += 2;
-          }
-        }
-      else // outFormat == VTK_LUMINANCE
-        {
-        while (--i >= 0)
-          {
-          cptr = vtkLinearLookup(*input, table, maxIndex, shift, scale,
-                                 nanColor);
-          *output++ = static_cast<unsigned char>(cptr[0]*0.30 + cptr[1]*0.59 +
-                                                 cptr[2]*0.11 + 0.5);
-          input += inIncr;
-          }
-        }
-      }//no log scale
-    }//alpha blending
+private:
+  const vtkLookupTableIndexer *Indexer;
+  const vtkLookupTableColorizer *Colorizer;
+  TReader Reader;
+  unsigned char *Output;
+  int OutputFormat;
+};
+
+//----------------------------------------------------------------------------
+template<class TReader>
+void vtkLookupTableMapIndices(vtkLookupTable *self,
+                              const vtkLookupTableIndexer& indexer,
+                              const TReader& reader, unsigned char *output,
+                              vtkIdType length, int outFormat)
+{
+  vtkLookupTableColorizer colorizer(self, outFormat);
+  vtkLookupTableMapFunctor<TReader> functor(
+    &indexer, &colorizer, reader, output, outFormat);
+  vtkSMPTools::For(0, length, vtkLookupTableGrainSize, functor);
 }
 
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+template<class T>
+void vtkLookupTableMapData(vtkLookupTable *self, T *input,
+                           unsigned char *output, int length,
+                           int inIncr, int outFormat)
+{
+  vtkLookupTableIndexer indexer(self);
+  if (sizeof(T) == 1 && length > 256)
+    {
+    indexer.ComputeByteIndices<T>();
+    }
+  vtkLookupTableMapIndices(self, indexer,
+                           vtkLookupTableValues<T>(input, inIncr),
+                           output, length, outFormat);
+}
+
+//----------------------------------------------------------------------------
+template<class T>
+void vtkLookupTableMapMagnitudes(vtkLookupTable *self, T *input,
+                                 unsigned char *output, int length,
+                                 int numberOfComponents, int vectorSize,
+                                 int outFormat)
+{
+  vtkLookupTableIndexer indexer(self);
+  vtkLookupTableMapIndices(self, indexer,
+                           vtkLookupTableMagnitudes<T>(
+                             input, numberOfComponents, vectorSize),
+                           output, length, outFormat);
+}
 
 //----------------------------------------------------------------------------
 template<class T>
@@ -1046,6 +1089,36 @@ void vtkLookupTable::MapScalarsThroughTable2(void *input,
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkLookupTable::MapVectorMagnitudesThroughTable(void *input,
+                                                     unsigned char *output,
+                                                     int inputDataType,
+                                                     int numberOfValues,
+                                                     int numberOfComponents,
+                                                     int vectorSize,
+                                                     int outputFormat)
+{
+  if (this->IndexedLookup || inputDataType == VTK_BIT)
+    {
+    this->Superclass::MapVectorMagnitudesThroughTable(
+      input, output, inputDataType, numberOfValues, numberOfComponents,
+      vectorSize, outputFormat);
+    return;
+    }
+
+  switch (inputDataType)
+    {
+    vtkTemplateMacro(
+      vtkLookupTableMapMagnitudes(this,static_cast<VTK_TT*>(input),output,
+                                  numberOfValues,numberOfComponents,
+                                  vectorSize,outputFormat)
+      );
+    default:
+      vtkErrorMacro(<< "MapVectorMagnitudesThroughTable: Unknown input ScalarType");
+      return;
+    }
+}
+
 //----------------------------------------------------------------------------
 // Specify the number of values (i.e., colors) in the lookup
 // table. This method simply allocates memory and prepares the table
@@ -255,7 +255,8 @@ public:
   vtkGetObjectMacro(Table,vtkUnsignedCharArray);
 
   // Description:
-  // map a set of scalars through the lookup table
+  // map a set of scalars through the lookup table. Large arrays are
+  // mapped in parallel, see vtkSMPTools.
   void MapScalarsThroughTable2(void *input, unsigned char *output,
                                int inputDataType, int numberOfValues,
                                int inputIncrement, int outputIncrement);
@@ -288,6 +289,13 @@ protected:
   vtkLookupTable(int sze=256, int ext=256);
   ~vtkLookupTable();
 
+  // Description:
+  // Map the magnitudes of vectors with the same kernel as the scalars.
+  void MapVectorMagnitudesThroughTable(void *input, unsigned char *output,
+                                       int inputDataType, int numberOfValues,
+                                       int numberOfComponents, int vectorSize,
+                                       int outputFormat);
+
   vtkIdType NumberOfColors;
   vtkUnsignedCharArray *Table;
   double TableRange[2];
@@ -14,10 +14,17 @@
 =========================================================================*/
 #include "vtkMultiThreader.h"
 
+#include "vtkConditionVariable.h"
 #include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkWindows.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <deque>
+#include <vector>
+#include <stdlib.h>
+
 vtkStandardNewMacro(vtkMultiThreader);
 
 // These are the includes necessary for multithreaded rendering on an SGI
@@ -45,6 +52,276 @@ typedef vtkThreadFunctionType vtkExternCThreadFunctionType;
 #include <sys/sysctl.h>
 #endif
 
+// The persistent worker pool is only implemented on top of pthreads and
+// Win32 threads.
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+#define VTK_MULTITHREADER_USE_POOL
+#endif
+
+struct vtkMultiThreaderBatch;
+
+// One thread worth of work of a SingleMethodExecute() or
+// MultipleMethodExecute() call. StartTime records when the method actually
+// started running so that the dispatch latency can be computed.
+struct vtkMultiThreaderTask
+{
+  vtkThreadFunctionType Method;
+  vtkMultiThreader::ThreadInfo *Info;
+  double StartTime;
+  vtkMultiThreaderBatch *Batch;
+};
+
+static VTK_THREAD_RETURN_TYPE vtkMultiThreaderRunTask(void *arg)
+{
+  vtkMultiThreaderTask *task = static_cast<vtkMultiThreaderTask *>(arg);
+  task->StartTime = vtksys::SystemTools::GetTime();
+  task->Method(static_cast<void *>(task->Info));
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+#ifdef VTK_MULTITHREADER_USE_POOL
+// The set of tasks submitted by one execute call. The caller waits on Done
+// until all of them have completed.
+struct vtkMultiThreaderBatch
+{
+  int Remaining;
+  vtkSimpleConditionVariable Done;
+};
+
+//----------------------------------------------------------------------------
+// Process-wide pool of persistent worker threads. Workers are created on
+// demand and are never destroyed before exit, so that repeated execute calls
+// only pay for waking up threads, not for creating them. Every task handed
+// to the pool is guaranteed its own worker: the pool grows when there are
+// not enough idle workers, so methods that wait on each other cannot
+// deadlock.
+class vtkMultiThreaderPool
+{
+public:
+  static vtkMultiThreaderPool *GetInstance();
+
+  // Hand tasks[0] to tasks[n-1] to idle workers and return immediately.
+  // Returns false, without queuing anything, if not enough workers could
+  // be created.
+  bool Submit(vtkMultiThreaderTask *tasks, int n, vtkMultiThreaderBatch *b);
+
+  // Wait until all the tasks of the batch have completed.
+  void Wait(vtkMultiThreaderBatch *b);
+
+  ~vtkMultiThreaderPool();
+
+private:
+  vtkMultiThreaderPool() : IdleWorkers(0), Shutdown(false) {}
+
+  static VTK_THREAD_RETURN_TYPE WorkerMain(void *arg);
+  void SpawnWorker();
+
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable WorkAvailable;
+  std::deque<vtkMultiThreaderTask *> Queue;
+  std::vector<vtkThreadProcessIDType> Workers;
+  int IdleWorkers;
+  bool Shutdown;
+};
+
+static vtkSimpleMutexLock vtkMultiThreaderPoolInstanceLock;
+static vtkMultiThreaderPool *vtkMultiThreaderPoolInstance = 0;
+
+// Joins the workers when the library is unloaded.
+class vtkMultiThreaderPoolCleanup
+{
+public:
+  ~vtkMultiThreaderPoolCleanup()
+    {
+    delete vtkMultiThreaderPoolInstance;
+    vtkMultiThreaderPoolInstance = 0;
+    }
+};
+static vtkMultiThreaderPoolCleanup vtkMultiThreaderPoolCleanupInstance;
+
+vtkMultiThreaderPool *vtkMultiThreaderPool::GetInstance()
+{
+  vtkMultiThreaderPoolInstanceLock.Lock();
+  if (!vtkMultiThreaderPoolInstance)
+    {
+    vtkMultiThreaderPoolInstance = new vtkMultiThreaderPool;
+    }
+  vtkMultiThreaderPoolInstanceLock.Unlock();
+  return vtkMultiThreaderPoolInstance;
+}
+
+vtkMultiThreaderPool::~vtkMultiThreaderPool()
+{
+  this->Lock.Lock();
+  this->Shutdown = true;
+  this->WorkAvailable.Broadcast();
+  this->Lock.Unlock();
+
+  for (size_t i = 0; i < this->Workers.size(); ++i)
+    {
+#ifdef VTK_USE_PTHREADS
+    pthread_join(this->Workers[i], NULL);
+#else
+    WaitForSingleObject(this->Workers[i], INFINITE);
+    CloseHandle(this->Workers[i]);
+#endif
+    }
+}
+
+// Called with this->Lock held.
+void vtkMultiThreaderPool::SpawnWorker()
+{
+  vtkThreadProcessIDType worker;
+#ifdef VTK_USE_PTHREADS
+  int threadError = pthread_create(&worker, NULL,
+    reinterpret_cast<vtkExternCThreadFunctionType>(
+      vtkMultiThreaderPool::WorkerMain), static_cast<void *>(this));
+  if (threadError != 0)
+    {
+    vtkGenericWarningMacro(
+      << "Unable to create a thread.  pthread_create() returned "
+      << threadError);
+    return;
+    }
+#else
+  DWORD threadId;
+  worker = CreateThread(NULL, 0, vtkMultiThreaderPool::WorkerMain,
+                        static_cast<void *>(this), 0, &threadId);
+  if (worker == NULL)
+    {
+    vtkGenericWarningMacro("Error in thread creation !!!");
+    return;
+    }
+#endif
+  this->Workers.push_back(worker);
+  ++this->IdleWorkers;
+}
+
+bool vtkMultiThreaderPool::Submit(vtkMultiThreaderTask *tasks, int n,
+                                  vtkMultiThreaderBatch *b)
+{
+  this->Lock.Lock();
+  b->Remaining = n;
+  while (this->IdleWorkers < n)
+    {
+    int before = this->IdleWorkers;
+    this->SpawnWorker();
+    if (this->IdleWorkers == before)
+      {
+      this->Lock.Unlock();
+      return false;
+      }
+    }
+  for (int i = 0; i < n; ++i)
+    {
+    tasks[i].Batch = b;
+    this->Queue.push_back(tasks + i);
+    }
+  this->IdleWorkers -= n;
+  this->WorkAvailable.Broadcast();
+  this->Lock.Unlock();
+  return true;
+}
+
+void vtkMultiThreaderPool::Wait(vtkMultiThreaderBatch *b)
+{
+  this->Lock.Lock();
+  while (b->Remaining > 0)
+    {
+    b->Done.Wait(this->Lock);
+    }
+  this->Lock.Unlock();
+}
+
+VTK_THREAD_RETURN_TYPE vtkMultiThreaderPool::WorkerMain(void *arg)
+{
+  vtkMultiThreaderPool *self = static_cast<vtkMultiThreaderPool *>(arg);
+
+  self->Lock.Lock();
+  for (;;)
+    {
+    while (self->Queue.empty() && !self->Shutdown)
+      {
+      self->WorkAvailable.Wait(self->Lock);
+      }
+    if (self->Queue.empty())
+      {
+      break;
+      }
+    vtkMultiThreaderTask *task = self->Queue.front();
+    self->Queue.pop_front();
+    self->Lock.Unlock();
+
+    vtkMultiThreaderRunTask(task);
+
+    self->Lock.Lock();
+    ++self->IdleWorkers;
+    // The submitting thread may destroy the batch as soon as the lock is
+    // released, so it must not be touched after this point.
+    if (--task->Batch->Remaining == 0)
+      {
+      task->Batch->Done.Signal();
+      }
+    }
+  self->Lock.Unlock();
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+#endif
+
+// Compute how long it took, since startTime, for all tasks to be running.
+static double vtkMultiThreaderDispatchLatency(
+  vtkMultiThreaderTask *tasks, int n, double startTime)
+{
+  double latency = 0.0;
+  for (int i = 0; i < n; ++i)
+    {
+    if (tasks[i].StartTime - startTime > latency)
+      {
+      latency = tasks[i].StartTime - startTime;
+      }
+    }
+  return latency;
+}
+
+#ifdef VTK_MULTITHREADER_USE_POOL
+// Run tasks[1] to tasks[n-1] on the pool and tasks[0] on the calling thread.
+// Returns false if the pool could not provide enough workers, in which case
+// nothing was executed.
+static bool vtkMultiThreaderPoolExecute(vtkMultiThreaderTask *tasks, int n,
+                                        double startTime, double &latency)
+{
+  vtkMultiThreaderBatch batch;
+  if (!vtkMultiThreaderPool::GetInstance()->Submit(tasks + 1, n - 1, &batch))
+    {
+    return false;
+    }
+  vtkMultiThreaderRunTask(static_cast<void *>(tasks));
+  vtkMultiThreaderPool::GetInstance()->Wait(&batch);
+  latency = vtkMultiThreaderDispatchLatency(tasks + 1, n - 1, startTime);
+  return true;
+}
+#endif
+
+// Whether new vtkMultiThreader instances use the worker pool.
+// -1 => Not initialized.
+static int vtkMultiThreaderGlobalDefaultUseThreadPool = -1;
+
+void vtkMultiThreader::SetGlobalDefaultUseThreadPool(int val)
+{
+  vtkMultiThreaderGlobalDefaultUseThreadPool = (val != 0);
+}
+
+int vtkMultiThreader::GetGlobalDefaultUseThreadPool()
+{
+  if (vtkMultiThreaderGlobalDefaultUseThreadPool < 0)
+    {
+    vtkMultiThreaderGlobalDefaultUseThreadPool =
+      (getenv("VTK_NO_THREAD_POOL") == NULL);
+    }
+  return vtkMultiThreaderGlobalDefaultUseThreadPool;
+}
+
 // Initialize static member that controls global maximum number of threads
 static int vtkMultiThreaderGlobalMaximumNumberOfThreads = 0;
 
@@ -164,7 +441,9 @@ vtkMultiThreader::vtkMultiThreader()
   this->SingleMethod = NULL;
   this->NumberOfThreads =
     vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
-
+  this->UseThreadPool =
+    vtkMultiThreader::GetGlobalDefaultUseThreadPool();
+  this->LastDispatchLatency = 0.0;
 }
 
 // Destructor. Nothing allocated so nothing needs to be done here.
@@ -259,6 +538,29 @@ void vtkMultiThreader::SingleMethodExecute()
     this->NumberOfThreads = vtkMultiThreaderGlobalMaximumNumberOfThreads;
     }
 
+  // Set up the per thread information once for all implementations.
+  double startTime = vtksys::SystemTools::GetTime();
+  vtkMultiThreaderTask tasks[VTK_MAX_THREADS];
+  for ( thread_loop = 0; thread_loop < this->NumberOfThreads; thread_loop++ )
+    {
+    this->ThreadInfoArray[thread_loop].UserData        = this->SingleData;
+    this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
+    tasks[thread_loop].Method    = this->SingleMethod;
+    tasks[thread_loop].Info      = &this->ThreadInfoArray[thread_loop];
+    tasks[thread_loop].StartTime = startTime;
+    tasks[thread_loop].Batch     = NULL;
+    }
+  this->LastDispatchLatency = 0.0;
+
+#ifdef VTK_MULTITHREADER_USE_POOL
+  // Hand the work to the persistent workers when possible.
+  if (this->UseThreadPool && this->NumberOfThreads > 1 &&
+      vtkMultiThreaderPoolExecute(tasks, this->NumberOfThreads, startTime,
+                                  this->LastDispatchLatency))
+    {
+    return;
+    }
+#endif
 
   // We are using sproc (on SGIs), pthreads(on Suns), or a single thread
   // (the default)
@@ -278,8 +580,8 @@ void vtkMultiThreader::SingleMethodExecute()
     this->ThreadInfoArray[thread_loop].UserData        = this->SingleData;
     this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
     process_id[thread_loop] =
-      CreateThread(NULL, 0, this->SingleMethod,
-             ((void *)(&this->ThreadInfoArray[thread_loop])), 0, &threadId);
+      CreateThread(NULL, 0, vtkMultiThreaderRunTask,
+             ((void *)(&tasks[thread_loop])), 0, &threadId);
     if (process_id[thread_loop] == NULL)
       {
       vtkErrorMacro("Error in thread creation !!!");
@@ -303,6 +605,9 @@ void vtkMultiThreader::SingleMethodExecute()
     {
     CloseHandle(process_id[thread_loop]);
     }
+
+  this->LastDispatchLatency = vtkMultiThreaderDispatchLatency(
+    tasks + 1, this->NumberOfThreads - 1, startTime);
 #endif
 
 #ifdef VTK_USE_SPROC
@@ -378,8 +683,8 @@ void vtkMultiThreader::SingleMethodExecute()
     threadError =
       pthread_create( &(process_id[thread_loop]), &attr,
                       reinterpret_cast<vtkExternCThreadFunctionType>(
-                        this->SingleMethod),
-                      ( (void *)(&this->ThreadInfoArray[thread_loop]) ) );
+                        vtkMultiThreaderRunTask),
+                      ( (void *)(&tasks[thread_loop]) ) );
     if (threadError != 0)
       {
       vtkErrorMacro(<< "Unable to create a thread.  pthread_create() returned "
@@ -399,6 +704,9 @@ void vtkMultiThreader::SingleMethodExecute()
     {
     pthread_join( process_id[thread_loop], NULL );
     }
+
+  this->LastDispatchLatency = vtkMultiThreaderDispatchLatency(
+    tasks + 1, this->NumberOfThreads - 1, startTime);
 #endif
 
 #ifndef VTK_USE_WIN32_THREADS
@@ -448,6 +756,31 @@ void vtkMultiThreader::MultipleMethodExecute()
       }
     }
 
+  // Set up the per thread information once for all implementations.
+  double startTime = vtksys::SystemTools::GetTime();
+  vtkMultiThreaderTask tasks[VTK_MAX_THREADS];
+  for ( thread_loop = 0; thread_loop < this->NumberOfThreads; thread_loop++ )
+    {
+    this->ThreadInfoArray[thread_loop].UserData =
+      this->MultipleData[thread_loop];
+    this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
+    tasks[thread_loop].Method    = this->MultipleMethod[thread_loop];
+    tasks[thread_loop].Info      = &this->ThreadInfoArray[thread_loop];
+    tasks[thread_loop].StartTime = startTime;
+    tasks[thread_loop].Batch     = NULL;
+    }
+  this->LastDispatchLatency = 0.0;
+
+#ifdef VTK_MULTITHREADER_USE_POOL
+  // Hand the work to the persistent workers when possible.
+  if (this->UseThreadPool && this->NumberOfThreads > 1 &&
+      vtkMultiThreaderPoolExecute(tasks, this->NumberOfThreads, startTime,
+                                  this->LastDispatchLatency))
+    {
+    return;
+    }
+#endif
+
   // We are using sproc (on SGIs), pthreads(on Suns), CreateThread
   // on a PC or a single thread (the default)
 
@@ -468,8 +801,8 @@ void vtkMultiThreader::MultipleMethodExecute()
       this->MultipleData[thread_loop];
     this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
     process_id[thread_loop] =
-      CreateThread(NULL, 0, this->MultipleMethod[thread_loop],
-             ((void *)(&this->ThreadInfoArray[thread_loop])), 0, &threadId);
+      CreateThread(NULL, 0, vtkMultiThreaderRunTask,
+             ((void *)(&tasks[thread_loop])), 0, &threadId);
     if (process_id[thread_loop] == NULL)
       {
       vtkErrorMacro("Error in thread creation !!!");
@@ -494,6 +827,9 @@ void vtkMultiThreader::MultipleMethodExecute()
     {
     CloseHandle(process_id[thread_loop]);
     }
+
+  this->LastDispatchLatency = vtkMultiThreaderDispatchLatency(
+    tasks + 1, this->NumberOfThreads - 1, startTime);
 #endif
 
 #ifdef VTK_USE_SPROC
@@ -568,8 +904,8 @@ void vtkMultiThreader::MultipleMethodExecute()
     pthread_create( &(process_id[thread_loop]),
                     &attr,
                     reinterpret_cast<vtkExternCThreadFunctionType>(
-                      this->MultipleMethod[thread_loop]),
-                    ( (void *)(&this->ThreadInfoArray[thread_loop]) ) );
+                      vtkMultiThreaderRunTask),
+                    ( (void *)(&tasks[thread_loop]) ) );
 #endif
     }
 
@@ -584,6 +920,9 @@ void vtkMultiThreader::MultipleMethodExecute()
     {
     pthread_join( process_id[thread_loop], NULL );
     }
+
+  this->LastDispatchLatency = vtkMultiThreaderDispatchLatency(
+    tasks + 1, this->NumberOfThreads - 1, startTime);
 #endif
 
 #ifndef VTK_USE_WIN32_THREADS
@@ -829,6 +1168,9 @@ void vtkMultiThreader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Thread Count: " << this->NumberOfThreads << "\n";
   os << indent << "Global Maximum Number Of Threads: " <<
     vtkMultiThreaderGlobalMaximumNumberOfThreads << endl;
+  os << indent << "Use Thread Pool: " << this->UseThreadPool << "\n";
+  os << indent << "Last Dispatch Latency: "
+     << this->LastDispatchLatency << "\n";
   os << "Thread system used: " <<
 #ifdef VTK_USE_PTHREADS
    "PTHREADS"
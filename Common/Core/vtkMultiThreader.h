@@ -18,6 +18,11 @@
 // execution using sproc() on an SGI, or pthread_create on any platform
 // supporting POSIX threads.  This class can be used to execute a single
 // method on multiple threads, or to specify a method per thread.
+//
+// With POSIX and Win32 threads, SingleMethodExecute() and
+// MultipleMethodExecute() run their methods on a process-wide pool of
+// persistent worker threads rather than creating and joining threads on
+// every call. See UseThreadPool.
 
 #ifndef __vtkMultiThreader_h
 #define __vtkMultiThreader_h
@@ -139,6 +144,29 @@ public:
   static void SetGlobalDefaultNumberOfThreads(int val);
   static int  GetGlobalDefaultNumberOfThreads();
 
+  // Description:
+  // Set/Get whether SingleMethodExecute() and MultipleMethodExecute() hand
+  // their work to the process-wide pool of persistent worker threads
+  // instead of creating new threads for every call. Threads of the pool are
+  // created on demand and reused by later calls. This has no effect with
+  // sproc() or without thread support.
+  vtkSetMacro(UseThreadPool, int);
+  vtkGetMacro(UseThreadPool, int);
+  vtkBooleanMacro(UseThreadPool, int);
+
+  // Description:
+  // Set/Get the value which is used to initialize UseThreadPool in the
+  // constructor. It is on unless the VTK_NO_THREAD_POOL environment
+  // variable is set.
+  static void SetGlobalDefaultUseThreadPool(int val);
+  static int  GetGlobalDefaultUseThreadPool();
+
+  // Description:
+  // Get the dispatch latency, in seconds, of the last SingleMethodExecute()
+  // or MultipleMethodExecute(): the time between the call and the moment
+  // the last additional thread started to run its method.
+  vtkGetMacro(LastDispatchLatency, double);
+
   // These methods are excluded from Tcl wrapping 1) because the
   // wrapper gives up on them and 2) because they really shouldn't be
   // called from a script anyway.
@@ -198,6 +226,12 @@ protected:
   // The number of threads to use
   int                        NumberOfThreads;
 
+  // Whether to run on the persistent worker pool
+  int                        UseThreadPool;
+
+  // Dispatch latency of the last execute call
+  double                     LastDispatchLatency;
+
   // An array of thread info containing a thread id
   // (0, 1, 2, .. VTK_MAX_THREADS-1), the thread count, and a pointer
   // to void so that user data can be passed to each thread
@@ -131,15 +131,34 @@ void vtkPoints::GetBounds(double bounds[6])
 
 int vtkPoints::Allocate(const vtkIdType sz, const vtkIdType ext)
 {
+  this->UseStandardData();
   int numComp=this->Data->GetNumberOfComponents();
   return this->Data->Allocate(sz*numComp,ext*numComp);
 }
 
 void vtkPoints::Initialize()
 {
+  this->UseStandardData();
   this->Data->Initialize();
 }
 
+void vtkPoints::UseStandardData()
+{
+  if ( this->Data->HasStandardMemoryLayout() )
+    {
+    return;
+    }
+  // NewInstance() of such arrays creates an array storing the values.
+  vtkDataArray *data = this->Data->NewInstance();
+  data->SetNumberOfComponents(3);
+  data->SetName(this->Data->GetName());
+  this->Data->UnRegister(this);
+  this->Data = data;
+  this->Data->Register(this);
+  data->Delete();
+  this->Modified();
+}
+
 int vtkPoints::GetDataType()
 {
   return this->Data->GetDataType();
@@ -198,6 +217,7 @@ void vtkPoints::DeepCopy(vtkPoints *da)
       vtkErrorMacro(<<"Number of components is different...can't copy");
       return;
       }
+    this->UseStandardData();
     this->Data->DeepCopy(da->Data);
     this->Modified();
     }
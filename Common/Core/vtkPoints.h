@@ -177,6 +177,11 @@ protected:
   vtkTimeStamp ComputeTime; // Time at which bounds computed
   vtkDataArray *Data;  // Array which represents data
 
+  // Replace Data, if its values are not stored as interleaved tuples (such
+  // as an implicit array computing them), by an array of the same type
+  // that stores them, before the points are rebuilt.
+  void UseStandardData();
+
 private:
   vtkPoints(const vtkPoints&);  // Not implemented.
   void operator=(const vtkPoints&);  // Not implemented.
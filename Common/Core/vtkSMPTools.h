@@ -0,0 +1,326 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPTools - A set of parallel (multi-threaded) utility functions.
+// .SECTION Description
+// vtkSMPTools provides a set of utility functions that can be used to
+// parallelize parts of VTK code using multiple threads. There are several
+// back-end implementations of parallel functionality (currently Sequential,
+// OpenMP, TBB and Kaapi) that actual execution is delegated to. The
+// back-end is selected at configuration time through
+// VTK_SMP_IMPLEMENTATION_TYPE, the same setting that selects the
+// implementation of vtkAtomicInt32 and vtkAtomicInt64.
+//
+// The main entry point is For(), which executes a functor over the range
+// [first, last) by splitting it into sub-ranges of roughly "grain" items
+// and handing them out to the worker threads of the back-end. The functor
+// must provide
+// \code
+// void operator()(vtkIdType begin, vtkIdType end);
+// \endcode
+// and may optionally provide
+// \code
+// void Initialize();
+// void Reduce();
+// \endcode
+// Initialize() is called once per thread, before that thread executes its
+// first sub-range. It is usually used together with vtkSMPThreadLocal to
+// set up per-thread accumulators. Reduce() is called once, from the calling
+// thread, after all sub-ranges have been executed. A functor that defines
+// Initialize() must also define Reduce().
+//
+// Sort() is a parallel sort built on For(), available with every back-end.
+//
+// .SECTION See Also
+// vtkSMPThreadLocal vtkAtomicInt32 vtkAtomicInt64
+
+#ifndef __vtkSMPTools_h
+#define __vtkSMPTools_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include "vtkSMPThreadLocal.h" // For Initialized
+#include "vtkSMPToolsInternal.h" // For the back-end For() implementation
+
+#include <algorithm> // For std::sort and std::inplace_merge
+#include <functional> // For std::less
+#include <iterator> // For std::iterator_traits
+
+//BTX
+#ifndef __WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// Compile-time detection of an Initialize() member, non-const version.
+template <typename T>
+class vtkSMPTools_Has_Initialize
+{
+  typedef char (&no_type)[1];
+  typedef char (&yes_type)[2];
+  template <typename U, void (U::*)()> struct V {};
+  template <typename U> static yes_type check(V<U, &U::Initialize>*);
+  template <typename U> static no_type check(...);
+public:
+  static bool const value = sizeof(check<T>(0)) == sizeof(yes_type);
+};
+
+// Compile-time detection of an Initialize() member, const version.
+template <typename T>
+class vtkSMPTools_Has_Initialize_const
+{
+  typedef char (&no_type)[1];
+  typedef char (&yes_type)[2];
+  template <typename U, void (U::*)() const> struct V {};
+  template <typename U> static yes_type check(V<U, &U::Initialize>*);
+  template <typename U> static no_type check(...);
+public:
+  static bool const value = sizeof(check<T>(0)) == sizeof(yes_type);
+};
+
+template <typename Functor, bool Init>
+struct vtkSMPTools_FunctorInternal;
+
+// Functor without Initialize()/Reduce(): sub-ranges are forwarded as is.
+template <typename Functor>
+struct vtkSMPTools_FunctorInternal<Functor, false>
+{
+  Functor& F;
+  vtkSMPTools_FunctorInternal(Functor& f): F(f) {}
+  void Execute(vtkIdType first, vtkIdType last)
+    {
+    this->F(first, last);
+    }
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain)
+    {
+    vtkSMPTools_Impl_For(first, last, grain, *this);
+    }
+private:
+  void operator=(const vtkSMPTools_FunctorInternal&);
+};
+
+// Functor with Initialize()/Reduce(): Initialize() is called the first time
+// a thread executes a sub-range, Reduce() once everything has completed.
+template <typename Functor>
+struct vtkSMPTools_FunctorInternal<Functor, true>
+{
+  Functor& F;
+  vtkSMPThreadLocal<unsigned char> Initialized;
+  vtkSMPTools_FunctorInternal(Functor& f): F(f), Initialized(0) {}
+  void Execute(vtkIdType first, vtkIdType last)
+    {
+    unsigned char& inited = this->Initialized.Local();
+    if (!inited)
+      {
+      this->F.Initialize();
+      inited = 1;
+      }
+    this->F(first, last);
+    }
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain)
+    {
+    vtkSMPTools_Impl_For(first, last, grain, *this);
+    this->F.Reduce();
+    }
+private:
+  void operator=(const vtkSMPTools_FunctorInternal&);
+};
+
+template <typename Functor>
+class vtkSMPTools_Lookup_For
+{
+  static bool const init = vtkSMPTools_Has_Initialize<Functor>::value;
+public:
+  typedef vtkSMPTools_FunctorInternal<Functor, init> type;
+};
+
+template <typename Functor>
+class vtkSMPTools_Lookup_For<Functor const>
+{
+  static bool const init = vtkSMPTools_Has_Initialize_const<Functor>::value;
+public:
+  typedef vtkSMPTools_FunctorInternal<Functor const, init> type;
+};
+
+// Sort fixed size chunks of a range: first step of vtkSMPTools::Sort().
+template <typename RandomAccessIterator, typename Compare>
+struct vtkSMPTools_SortChunks
+{
+  RandomAccessIterator Begin;
+  vtkIdType Size;
+  vtkIdType ChunkSize;
+  Compare Comp;
+  vtkSMPTools_SortChunks(RandomAccessIterator begin, vtkIdType size,
+                         vtkIdType chunkSize, Compare comp)
+    : Begin(begin), Size(size), ChunkSize(chunkSize), Comp(comp) {}
+  void operator()(vtkIdType first, vtkIdType last) const
+    {
+    for (vtkIdType chunk = first; chunk < last; chunk++)
+      {
+      vtkIdType begin = chunk * this->ChunkSize;
+      vtkIdType end = std::min(this->Size, begin + this->ChunkSize);
+      std::sort(this->Begin + begin, this->Begin + end, this->Comp);
+      }
+    }
+};
+
+// Merge pairs of adjacent sorted runs of the given width: the following
+// steps of vtkSMPTools::Sort().
+template <typename RandomAccessIterator, typename Compare>
+struct vtkSMPTools_MergeRuns
+{
+  RandomAccessIterator Begin;
+  vtkIdType Size;
+  vtkIdType Width;
+  Compare Comp;
+  vtkSMPTools_MergeRuns(RandomAccessIterator begin, vtkIdType size,
+                        vtkIdType width, Compare comp)
+    : Begin(begin), Size(size), Width(width), Comp(comp) {}
+  void operator()(vtkIdType first, vtkIdType last) const
+    {
+    for (vtkIdType pair = first; pair < last; pair++)
+      {
+      vtkIdType begin = 2 * pair * this->Width;
+      vtkIdType middle = std::min(this->Size, begin + this->Width);
+      vtkIdType end = std::min(this->Size, begin + 2 * this->Width);
+      if (middle < end)
+        {
+        std::inplace_merge(this->Begin + begin, this->Begin + middle,
+                           this->Begin + end, this->Comp);
+        }
+      }
+    }
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __WRAP__
+//ETX
+
+class VTKCOMMONCORE_EXPORT vtkSMPTools
+{
+public:
+  //BTX
+  // Description:
+  // Execute a for operation in parallel. First and last define the range
+  // over which to operate (which is defined by the operator). The operation
+  // executed is defined by operator() of the functor object. The grain
+  // gives the parallel engine a hint about the coarseness over which to
+  // parallelize the function (as defined by last-first of each execution
+  // of operator() ). A grain of 0 lets the back-end pick one.
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, vtkIdType grain,
+                  Functor& f)
+    {
+    typename vtk::detail::smp::vtkSMPTools_Lookup_For<Functor>::type fi(f);
+    fi.For(first, last, grain);
+    }
+
+  // Description:
+  // Same as above, for functors whose operator() (and optional
+  // Initialize()/Reduce()) are const.
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, vtkIdType grain,
+                  Functor const& f)
+    {
+    typename vtk::detail::smp::vtkSMPTools_Lookup_For<Functor const>::type
+      fi(f);
+    fi.For(first, last, grain);
+    }
+
+  // Description:
+  // Execute a for operation in parallel, letting the back-end choose the
+  // grain. See the grain version above for details.
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, Functor& f)
+    {
+    vtkSMPTools::For(first, last, 0, f);
+    }
+
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, Functor const& f)
+    {
+    vtkSMPTools::For(first, last, 0, f);
+    }
+
+  // Description:
+  // Sort the range [begin, end) in parallel, with operator< or the given
+  // comparison. Chunks of the range are sorted concurrently with
+  // std::sort(), then merged pairwise with std::inplace_merge(), each level
+  // of merges running in parallel. Like std::sort(), the sort is not
+  // stable. Small ranges are sorted serially.
+  template <typename RandomAccessIterator>
+  static void Sort(RandomAccessIterator begin, RandomAccessIterator end)
+    {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type
+      ValueType;
+    vtkSMPTools::Sort(begin, end, std::less<ValueType>());
+    }
+
+  template <typename RandomAccessIterator, typename Compare>
+  static void Sort(RandomAccessIterator begin, RandomAccessIterator end,
+                   Compare comp)
+    {
+    const vtkIdType minChunkSize = 16384;
+    vtkIdType size = static_cast<vtkIdType>(end - begin);
+    vtkIdType numChunks =
+      std::min(static_cast<vtkIdType>(
+                 4 * vtkSMPTools::GetEstimatedNumberOfThreads()),
+               size / minChunkSize);
+    if (numChunks <= 1)
+      {
+      std::sort(begin, end, comp);
+      return;
+      }
+
+    vtkIdType chunkSize = (size + numChunks - 1) / numChunks;
+    numChunks = (size + chunkSize - 1) / chunkSize;
+    vtk::detail::smp::vtkSMPTools_SortChunks<RandomAccessIterator, Compare>
+      sorter(begin, size, chunkSize, comp);
+    vtkSMPTools::For(0, numChunks, 1, sorter);
+
+    for (vtkIdType width = chunkSize; width < size; width *= 2)
+      {
+      vtk::detail::smp::vtkSMPTools_MergeRuns<RandomAccessIterator, Compare>
+        merger(begin, size, width, comp);
+      vtkSMPTools::For(0, (size + 2 * width - 1) / (2 * width), 1, merger);
+      }
+    }
+  //ETX
+
+  // Description:
+  // Initialize the underlying libraries for execution. This is not required
+  // as it is automatically called before the first execution of any
+  // parallel code. However, it can be used to control the maximum number of
+  // threads used when the back-end supports it (currently OpenMP, TBB and
+  // Kaapi). A value of 0 (the default) lets the back-end decide. Make sure
+  // to call it before any other parallel operation or creation of a
+  // vtkSMPThreadLocal.
+  static void Initialize(int numThreads = 0);
+
+  // Description:
+  // Get the estimated number of threads being used by the back-end.
+  // This should be used as just an estimate since the number of threads may
+  // vary dynamically and a particular task may not be executed on all
+  // threads.
+  static int GetEstimatedNumberOfThreads();
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPTools.h
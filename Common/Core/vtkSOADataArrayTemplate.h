@@ -0,0 +1,202 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOADataArrayTemplate - data array storing each component separately
+// .SECTION Description
+// vtkSOADataArrayTemplate is a vtkDataArray that stores its values as a
+// structure of arrays: one contiguous buffer per component, instead of the
+// interleaved tuples of vtkDataArrayTemplate. It lets applications that
+// keep, say, the x, y and z components of a field in separate buffers hand
+// them over to VTK with SetArray() without copying them.
+//
+// The whole vtkDataArray API works on this array. Since its values are not
+// interleaved, GetVoidPointer() returns an interleaved copy of the values
+// when the array has more than one component. The copy is kept until the
+// array is modified; call DataChanged() after writing directly into the
+// component buffers. The copy must not be written to, and
+// WriteVoidPointer() is not supported with more than one component.
+// Arrays created with NewInstance() are ordinary vtkDataArrayTemplate
+// arrays of the same value type, so that filters producing arrays like
+// their inputs produce arrays they can write to.
+//
+// HasStandardMemoryLayout() returns false for this class, which tells the
+// generic code of vtkDataArray to copy values with the tuple API rather
+// than through GetVoidPointer(). Performance-critical code can read the
+// component buffers directly with GetComponentArrayPointer(), or through
+// vtkDataArrayRangeDispatch::ExecuteSOA().
+//
+// .SECTION See Also
+// vtkDataArrayTemplate vtkDataArrayRange
+
+#ifndef __vtkSOADataArrayTemplate_h
+#define __vtkSOADataArrayTemplate_h
+
+#include "vtkDataArray.h"
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+#include <vector> // For the component buffers
+
+template <class T>
+class vtkSOADataArrayTemplate :
+  public vtkTypeTemplate<vtkSOADataArrayTemplate<T>, vtkDataArray>
+{
+public:
+  typedef T ValueType;
+  static vtkSOADataArrayTemplate<T>* New();
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Create an array of the same value type that stores interleaved tuples.
+  vtkDataArray* NewInstance() const
+    { return static_cast<vtkDataArray*>(this->NewInstanceInternal()); }
+
+//BTX
+  enum DeleteMethod
+  {
+    VTK_DATA_ARRAY_FREE,
+    VTK_DATA_ARRAY_DELETE
+  };
+//ETX
+
+  // Description:
+  // Use the buffer array of size values for the component comp. The
+  // number of components must be set before, and all the components must
+  // be given buffers of the same size. If updateMaxId is true, the array
+  // holds size tuples afterwards. Unless save is true, the array releases
+  // the buffer with free() or delete[], depending on deleteMethod.
+  void SetArray(int comp, T* array, vtkIdType size, bool updateMaxId = false,
+                bool save = false, int deleteMethod = VTK_DATA_ARRAY_FREE);
+
+  // Description:
+  // The buffer of the component comp. Call DataChanged() after modifying
+  // its values.
+  T* GetComponentArrayPointer(int comp);
+
+  // Description:
+  // Get/Set the component comp of the tuple tupleIdx in the native type.
+  // No range checking is performed.
+  T GetTypedComponent(vtkIdType tupleIdx, int comp) const
+    { return this->Buffers[comp].Array[tupleIdx]; }
+  void SetTypedComponent(vtkIdType tupleIdx, int comp, T value)
+    {
+    this->Buffers[comp].Array[tupleIdx] = value;
+    this->DataChanged();
+    }
+
+  // Description:
+  // Get/Set/Insert the value valueIdx = tupleIdx * components + comp in the
+  // native type.
+  T GetValue(vtkIdType valueIdx) const;
+  void SetValue(vtkIdType valueIdx, T value);
+  vtkIdType GetNumberOfValues() { return this->MaxId + 1; }
+  void SetNumberOfValues(vtkIdType number);
+  void InsertValue(vtkIdType valueIdx, T value);
+  vtkIdType InsertNextValue(T value);
+
+  // Description:
+  // Get/Set/Insert a tuple in the native type.
+  void GetTupleValue(vtkIdType tupleIdx, T* tuple);
+  void SetTupleValue(vtkIdType tupleIdx, const T* tuple);
+  void InsertTupleValue(vtkIdType tupleIdx, const T* tuple);
+  vtkIdType InsertNextTupleValue(const T* tuple);
+
+  // Description:
+  // Reimplemented from vtkAbstractArray and vtkDataArray.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+  void Initialize();
+  int GetDataType();
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+  bool HasStandardMemoryLayout() { return false; }
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double* tuple);
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple() { this->RemoveTuple(0); }
+  void RemoveLastTuple();
+  double GetComponent(vtkIdType i, int j);
+  void SetComponent(vtkIdType i, int j, double c);
+  void InsertComponent(vtkIdType i, int j, double c);
+  void InterpolateTuple(vtkIdType i, vtkIdList* ptIndices,
+                        vtkAbstractArray* source, double* weights);
+  void InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray* source1,
+                        vtkIdType id2, vtkAbstractArray* source2, double t);
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa)
+    { this->vtkDataArray::DeepCopy(aa); }
+  void Squeeze() { this->ResizeTuples(this->GetNumberOfTuples()); }
+  int Resize(vtkIdType numTuples);
+  void* GetVoidPointer(vtkIdType id);
+  void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  void SetVoidArray(void* array, vtkIdType size, int save);
+  void SetVoidArray(void* array, vtkIdType size, int save, int deleteMethod);
+  void ExportToVoidPointer(void* out_ptr);
+  unsigned long GetActualMemorySize();
+  vtkArrayIterator* NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList* ids);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void DataChanged();
+  void ClearLookup() {}
+
+protected:
+  vtkSOADataArrayTemplate();
+  ~vtkSOADataArrayTemplate();
+
+  // Arrays created by NewInstance() store interleaved tuples.
+  vtkObjectBase* NewInstanceInternal() const;
+
+  void ComputeScalarRange(double range[2], int comp);
+
+//BTX
+  struct Buffer
+  {
+    T* Array;
+    bool Save;
+    int DeleteMethod;
+  };
+  std::vector<Buffer> Buffers;
+//ETX
+
+  vtkIdType TupleCapacity;
+  double* Tuple; // for GetTuple(i)
+  T* InterleavedCopy; // for GetVoidPointer()
+  bool InterleavedCopyIsValid;
+
+  // Make the buffers match the number of components, and reallocate them
+  // to hold numTuples tuples, keeping their values.
+  bool ResizeTuples(vtkIdType numTuples);
+  // Grow the buffers, if needed, to hold numTuples tuples.
+  bool EnsureTuples(vtkIdType numTuples);
+  void ReleaseBuffer(int comp);
+  void ReleaseBuffers();
+  void SetTupleFrom(vtkIdType i, vtkIdType j, vtkDataArray* source);
+
+private:
+  vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate&);  // Not implemented.
+  void operator=(const vtkSOADataArrayTemplate&);  // Not implemented.
+};
+
+#include "vtkSOADataArrayTemplate.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSOADataArrayTemplate.h
@@ -0,0 +1,943 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef __vtkSOADataArrayTemplate_txx
+#define __vtkSOADataArrayTemplate_txx
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkIdList.h"
+#include "vtkLookupTable.h"
+#include "vtkObjectFactory.h"
+#include "vtkTypeTraits.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>* vtkSOADataArrayTemplate<T>::New()
+{
+  vtkObject* ret =
+    vtkObjectFactory::CreateInstance(typeid(vtkSOADataArrayTemplate<T>).name());
+  if (ret)
+    {
+    return static_cast<vtkSOADataArrayTemplate<T>*>(ret);
+    }
+  return new vtkSOADataArrayTemplate<T>();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::vtkSOADataArrayTemplate()
+{
+  this->TupleCapacity = 0;
+  this->Tuple = 0;
+  this->InterleavedCopy = 0;
+  this->InterleavedCopyIsValid = false;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::~vtkSOADataArrayTemplate()
+{
+  this->ReleaseBuffers();
+  delete [] this->Tuple;
+  free(this->InterleavedCopy);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkObjectBase* vtkSOADataArrayTemplate<T>::NewInstanceInternal() const
+{
+  return vtkDataArray::CreateDataArray(vtkTypeTraits<T>::VTKTypeID());
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->vtkDataArray::PrintSelf(os, indent);
+  os << indent << "Component Arrays:";
+  for (size_t comp = 0; comp < this->Buffers.size(); ++comp)
+    {
+    os << " " << static_cast<void*>(this->Buffers[comp].Array);
+    }
+  os << "\n";
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::GetDataType()
+{
+  return vtkTypeTraits<T>::VTKTypeID();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ReleaseBuffer(int comp)
+{
+  Buffer& buffer = this->Buffers[comp];
+  if (buffer.Array && !buffer.Save)
+    {
+    if (buffer.DeleteMethod == VTK_DATA_ARRAY_DELETE)
+      {
+      delete [] buffer.Array;
+      }
+    else
+      {
+      free(buffer.Array);
+      }
+    }
+  buffer.Array = 0;
+  buffer.Save = false;
+  buffer.DeleteMethod = VTK_DATA_ARRAY_FREE;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ReleaseBuffers()
+{
+  for (size_t comp = 0; comp < this->Buffers.size(); ++comp)
+    {
+    this->ReleaseBuffer(static_cast<int>(comp));
+    }
+  this->TupleCapacity = 0;
+  this->Size = 0;
+  this->MaxId = -1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool vtkSOADataArrayTemplate<T>::ResizeTuples(vtkIdType numTuples)
+{
+  size_t numComps = static_cast<size_t>(this->NumberOfComponents);
+  if (this->Buffers.size() != numComps)
+    {
+    // The number of components changed: the values are lost.
+    this->ReleaseBuffers();
+    Buffer empty = { 0, false, VTK_DATA_ARRAY_FREE };
+    this->Buffers.assign(numComps, empty);
+    }
+  if (numTuples == this->TupleCapacity)
+    {
+    return true;
+    }
+  if (numTuples <= 0)
+    {
+    this->ReleaseBuffers();
+    return true;
+    }
+
+  vtkIdType keep = std::min(numTuples, this->GetNumberOfTuples());
+  for (size_t comp = 0; comp < numComps; ++comp)
+    {
+    Buffer& buffer = this->Buffers[comp];
+    T* array;
+    if (buffer.Array && !buffer.Save &&
+        buffer.DeleteMethod == VTK_DATA_ARRAY_FREE)
+      {
+      array = static_cast<T*>(
+        realloc(buffer.Array, static_cast<size_t>(numTuples) * sizeof(T)));
+      }
+    else
+      {
+      array = static_cast<T*>(
+        malloc(static_cast<size_t>(numTuples) * sizeof(T)));
+      if (array && keep > 0)
+        {
+        memcpy(array, buffer.Array, static_cast<size_t>(keep) * sizeof(T));
+        }
+      if (array)
+        {
+        this->ReleaseBuffer(static_cast<int>(comp));
+        }
+      }
+    if (!array)
+      {
+      vtkErrorMacro("Unable to allocate " << numTuples
+                    << " elements of size " << sizeof(T) << " bytes. ");
+      return false;
+      }
+    buffer.Array = array;
+    buffer.Save = false;
+    buffer.DeleteMethod = VTK_DATA_ARRAY_FREE;
+    }
+
+  this->TupleCapacity = numTuples;
+  this->Size = numTuples * this->NumberOfComponents;
+  if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  this->DataChanged();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool vtkSOADataArrayTemplate<T>::EnsureTuples(vtkIdType numTuples)
+{
+  if (numTuples <= this->TupleCapacity &&
+      this->Buffers.size() == static_cast<size_t>(this->NumberOfComponents))
+    {
+    return true;
+    }
+  return this->ResizeTuples(std::max(numTuples, 2 * this->TupleCapacity));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetArray(int comp, T* array, vtkIdType size,
+                                          bool updateMaxId, bool save,
+                                          int deleteMethod)
+{
+  if (comp < 0 || comp >= this->NumberOfComponents)
+    {
+    vtkErrorMacro("Invalid component " << comp << ".");
+    return;
+    }
+  if (this->Buffers.size() != static_cast<size_t>(this->NumberOfComponents))
+    {
+    this->ResizeTuples(0);
+    }
+  this->ReleaseBuffer(comp);
+  Buffer& buffer = this->Buffers[comp];
+  buffer.Array = array;
+  buffer.Save = save;
+  buffer.DeleteMethod = deleteMethod;
+
+  this->TupleCapacity = size;
+  this->Size = size * this->NumberOfComponents;
+  if (updateMaxId)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  else if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T* vtkSOADataArrayTemplate<T>::GetComponentArrayPointer(int comp)
+{
+  if (comp < 0 || static_cast<size_t>(comp) >= this->Buffers.size())
+    {
+    return 0;
+    }
+  return this->Buffers[comp].Array;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
+{
+  int numComps = this->NumberOfComponents;
+  vtkIdType numTuples = (sz > 0 ? (sz + numComps - 1) / numComps : 1);
+  this->MaxId = -1;
+  if (numTuples > this->TupleCapacity ||
+      this->Buffers.size() != static_cast<size_t>(numComps))
+    {
+    // Like vtkDataArrayTemplate, do not keep the values.
+    this->ResizeTuples(0);
+    if (!this->ResizeTuples(numTuples))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::Initialize()
+{
+  this->ReleaseBuffers();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::Resize(vtkIdType numTuples)
+{
+  return this->ResizeTuples(numTuples) ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfTuples(vtkIdType number)
+{
+  if (this->EnsureTuples(number))
+    {
+    this->MaxId = number * this->NumberOfComponents - 1;
+    this->DataChanged();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfValues(vtkIdType number)
+{
+  int numComps = this->NumberOfComponents;
+  if (this->EnsureTuples((number + numComps - 1) / numComps))
+    {
+    this->MaxId = number - 1;
+    this->DataChanged();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkSOADataArrayTemplate<T>::GetValue(vtkIdType valueIdx) const
+{
+  vtkIdType tupleIdx = valueIdx / this->NumberOfComponents;
+  int comp = static_cast<int>(valueIdx % this->NumberOfComponents);
+  return this->Buffers[comp].Array[tupleIdx];
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetValue(vtkIdType valueIdx, T value)
+{
+  vtkIdType tupleIdx = valueIdx / this->NumberOfComponents;
+  int comp = static_cast<int>(valueIdx % this->NumberOfComponents);
+  this->SetTypedComponent(tupleIdx, comp, value);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertValue(vtkIdType valueIdx, T value)
+{
+  if (!this->EnsureTuples(valueIdx / this->NumberOfComponents + 1))
+    {
+    return;
+    }
+  if (valueIdx > this->MaxId)
+    {
+    this->MaxId = valueIdx;
+    }
+  this->SetValue(valueIdx, value);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextValue(T value)
+{
+  this->InsertValue(this->MaxId + 1, value);
+  return this->MaxId;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTupleValue(vtkIdType tupleIdx, T* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = this->Buffers[comp].Array[tupleIdx];
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTupleValue(vtkIdType tupleIdx,
+                                               const T* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Buffers[comp].Array[tupleIdx] = tuple[comp];
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTupleValue(vtkIdType tupleIdx,
+                                                  const T* tuple)
+{
+  if (!this->EnsureTuples(tupleIdx + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (tupleIdx + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTupleValue(tupleIdx, tuple);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTupleValue(const T* tuple)
+{
+  vtkIdType tupleIdx = this->GetNumberOfTuples();
+  this->InsertTupleValue(tupleIdx, tuple);
+  return tupleIdx;
+}
+
+//----------------------------------------------------------------------------
+// Copy the tuple j of source, which has the same number of components, into
+// the allocated tuple i.
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTupleFrom(vtkIdType i, vtkIdType j,
+                                              vtkDataArray* source)
+{
+  int numComps = this->NumberOfComponents;
+  vtkSOADataArrayTemplate<T>* soa =
+    vtkSOADataArrayTemplate<T>::SafeDownCast(source);
+  if (soa)
+    {
+    for (int comp = 0; comp < numComps; ++comp)
+      {
+      this->Buffers[comp].Array[i] = soa->Buffers[comp].Array[j];
+      }
+    }
+  else if (source->GetDataType() == this->GetDataType() &&
+           source->HasStandardMemoryLayout())
+    {
+    const T* tuple = static_cast<T*>(source->GetVoidPointer(j * numComps));
+    for (int comp = 0; comp < numComps; ++comp)
+      {
+      this->Buffers[comp].Array[i] = tuple[comp];
+      }
+    }
+  else
+    {
+    for (int comp = 0; comp < numComps; ++comp)
+      {
+      this->Buffers[comp].Array[i] =
+        static_cast<T>(source->GetComponent(j, comp));
+      }
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
+                                          vtkAbstractArray* source)
+{
+  vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+  if (!da)
+    {
+    vtkWarningMacro("Input is not a vtkDataArray.");
+    return;
+    }
+  if (da->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+  this->SetTupleFrom(i, j, da);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
+                                             vtkAbstractArray* source)
+{
+  vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+  if (!da)
+    {
+    vtkWarningMacro("Input is not a vtkDataArray.");
+    return;
+    }
+  if (da->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTupleFrom(i, j, da);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
+                                                      vtkAbstractArray* source)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, j, source);
+  return (this->GetNumberOfTuples() > i ? i : -1);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double* vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i)
+{
+  delete [] this->Tuple;
+  this->Tuple = new double[this->NumberOfComponents];
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = static_cast<double>(this->Buffers[comp].Array[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Buffers[comp].Array[i] = static_cast<T>(tuple[comp]);
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Buffers[comp].Array[i] = static_cast<T>(tuple[comp]);
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, const float* tuple)
+{
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTuple(i, tuple);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, const double* tuple)
+{
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->SetTuple(i, tuple);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const float* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const double* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveTuple(vtkIdType id)
+{
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (id < 0 || id >= numTuples)
+    {
+    return;
+    }
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    T* array = this->Buffers[comp].Array;
+    std::copy(array + id + 1, array + numTuples, array + id);
+    }
+  this->MaxId -= this->NumberOfComponents;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveLastTuple()
+{
+  if (this->GetNumberOfTuples() > 0)
+    {
+    this->MaxId -= this->NumberOfComponents;
+    this->DataChanged();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double vtkSOADataArrayTemplate<T>::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(this->Buffers[j].Array[i]);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetComponent(vtkIdType i, int j, double c)
+{
+  this->SetTypedComponent(i, j, static_cast<T>(c));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertComponent(vtkIdType i, int j, double c)
+{
+  this->InsertValue(i * this->NumberOfComponents + j, static_cast<T>(c));
+}
+
+//----------------------------------------------------------------------------
+// Round integer types, like vtkDataArray::InterpolateTuple().
+template <class T>
+inline T vtkSOADataArrayTemplateRound(double val)
+{
+  val = std::max(val, static_cast<double>(vtkTypeTraits<T>::Min()));
+  val = std::min(val, static_cast<double>(vtkTypeTraits<T>::Max()));
+  return static_cast<T>((val >= 0.0) ? (val + 0.5) : (val - 0.5));
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline float vtkSOADataArrayTemplateRound<float>(double val)
+{
+  return static_cast<float>(val);
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline double vtkSOADataArrayTemplateRound<double>(double val)
+{
+  return val;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InterpolateTuple(vtkIdType i,
+  vtkIdList* ptIndices, vtkAbstractArray* source, double* weights)
+{
+  vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+  if (!da || da->GetDataType() != this->GetDataType() ||
+      da->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkErrorMacro("Cannot InterpolateValue from array of type "
+                  << source->GetDataTypeAsString());
+    return;
+    }
+
+  // Compute the tuple before inserting it, in case source is this array.
+  int numComps = this->NumberOfComponents;
+  vtkIdType numIds = ptIndices->GetNumberOfIds();
+  vtkIdType* ids = ptIndices->GetPointer(0);
+  std::vector<T> tuple(numComps);
+  for (int comp = 0; comp < numComps; ++comp)
+    {
+    double c = 0.0;
+    for (vtkIdType j = 0; j < numIds; ++j)
+      {
+      c += weights[j] * da->GetComponent(ids[j], comp);
+      }
+    tuple[comp] = vtkSOADataArrayTemplateRound<T>(c);
+    }
+  this->InsertTupleValue(i, &tuple[0]);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InterpolateTuple(vtkIdType i,
+  vtkIdType id1, vtkAbstractArray* source1,
+  vtkIdType id2, vtkAbstractArray* source2, double t)
+{
+  vtkDataArray* da1 = vtkDataArray::SafeDownCast(source1);
+  vtkDataArray* da2 = vtkDataArray::SafeDownCast(source2);
+  int type = this->GetDataType();
+  if (!da1 || !da2 ||
+      da1->GetDataType() != type || da2->GetDataType() != type)
+    {
+    vtkErrorMacro("All arrays to InterpolateValue must be of same type.");
+    return;
+    }
+
+  int numComps = this->NumberOfComponents;
+  std::vector<T> tuple(numComps);
+  for (int comp = 0; comp < numComps; ++comp)
+    {
+    tuple[comp] = static_cast<T>((1.0 - t) * da1->GetComponent(id1, comp) +
+                                 t * da2->GetComponent(id2, comp));
+    }
+  this->InsertTupleValue(i, &tuple[0]);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DeepCopy(vtkDataArray* da)
+{
+  if (da == NULL || da == this)
+    {
+    return;
+    }
+
+  this->vtkAbstractArray::DeepCopy(da);
+  this->ResizeTuples(0);
+  this->NumberOfComponents = da->GetNumberOfComponents();
+  vtkIdType numTuples = da->GetNumberOfTuples();
+  if (!this->ResizeTuples(numTuples))
+    {
+    return;
+    }
+  this->MaxId = numTuples * this->NumberOfComponents - 1;
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    this->SetTupleFrom(i, i, da);
+    }
+
+  this->SetLookupTable(0);
+  if (da->GetLookupTable())
+    {
+    vtkLookupTable* lut = da->GetLookupTable()->NewInstance();
+    lut->DeepCopy(da->GetLookupTable());
+    this->SetLookupTable(lut);
+    lut->Delete();
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkSOADataArrayTemplate<T>::GetVoidPointer(vtkIdType id)
+{
+  if (this->NumberOfComponents == 1)
+    {
+    return this->GetComponentArrayPointer(0) + id;
+    }
+
+  if (!this->InterleavedCopyIsValid)
+    {
+    vtkDebugMacro("GetVoidPointer called: interleaving the components.");
+    free(this->InterleavedCopy);
+    this->InterleavedCopy = 0;
+    vtkIdType numValues = this->GetNumberOfValues();
+    if (numValues > 0)
+      {
+      this->InterleavedCopy = static_cast<T*>(
+        malloc(static_cast<size_t>(numValues) * sizeof(T)));
+      this->ExportToVoidPointer(this->InterleavedCopy);
+      }
+    this->InterleavedCopyIsValid = true;
+    }
+  return this->InterleavedCopy + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkSOADataArrayTemplate<T>::WriteVoidPointer(vtkIdType id,
+                                                   vtkIdType number)
+{
+  if (this->NumberOfComponents == 1)
+    {
+    vtkIdType newSize = id + number;
+    if (!this->EnsureTuples(newSize))
+      {
+      return 0;
+      }
+    if (newSize - 1 > this->MaxId)
+      {
+      this->MaxId = newSize - 1;
+      }
+    this->DataChanged();
+    return this->GetComponentArrayPointer(0) + id;
+    }
+  vtkErrorMacro("WriteVoidPointer is not supported with more than one "
+                "component.");
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVoidArray(void* array, vtkIdType size,
+                                              int save)
+{
+  this->SetVoidArray(array, size, save, VTK_DATA_ARRAY_FREE);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVoidArray(void* array, vtkIdType size,
+                                              int save, int deleteMethod)
+{
+  if (this->NumberOfComponents != 1)
+    {
+    vtkErrorMacro("SetVoidArray is not supported with more than one "
+                  "component, use SetArray().");
+    return;
+    }
+  this->SetArray(0, static_cast<T*>(array), size, true, save != 0,
+                 deleteMethod);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ExportToVoidPointer(void* out_ptr)
+{
+  T* out = static_cast<T*>(out_ptr);
+  int numComps = this->NumberOfComponents;
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  for (int comp = 0; comp < numComps; ++comp)
+    {
+    const T* array = this->Buffers[comp].Array;
+    for (vtkIdType i = 0; i < numTuples; ++i)
+      {
+      out[i * numComps + comp] = array[i];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+unsigned long vtkSOADataArrayTemplate<T>::GetActualMemorySize()
+{
+  size_t bytes = static_cast<size_t>(this->Size) * sizeof(T);
+  if (this->InterleavedCopy)
+    {
+    bytes += static_cast<size_t>(this->GetNumberOfValues()) * sizeof(T);
+    }
+  return static_cast<unsigned long>(std::ceil(bytes / 1024.0));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkArrayIterator* vtkSOADataArrayTemplate<T>::NewIterator()
+{
+  // The iterator reads the interleaved copy of the values.
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  T v = vtkVariantCast<T>(value, &valid);
+  if (valid)
+    {
+    vtkIdType numValues = this->GetNumberOfValues();
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      if (this->GetValue(i) == v)
+        {
+        return i;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant value, vtkIdList* ids)
+{
+  ids->Reset();
+  bool valid = true;
+  T v = vtkVariantCast<T>(value, &valid);
+  if (valid)
+    {
+    vtkIdType numValues = this->GetNumberOfValues();
+    for (vtkIdType i = 0; i < numValues; ++i)
+      {
+      if (this->GetValue(i) == v)
+        {
+        ids->InsertNextId(i);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVariantValue(vtkIdType idx,
+                                                 vtkVariant value)
+{
+  bool valid = true;
+  T v = vtkVariantCast<T>(value, &valid);
+  if (valid)
+    {
+    this->SetValue(idx, v);
+    }
+  else
+    {
+    vtkErrorMacro("Could not convert the variant value.");
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DataChanged()
+{
+  this->InterleavedCopyIsValid = false;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ComputeScalarRange(double range[2], int comp)
+{
+  // Scan the buffer of the component in its native type.
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (numTuples < 1)
+    {
+    return;
+    }
+  const T* array = this->Buffers[comp].Array;
+  T minValue = array[0];
+  T maxValue = array[0];
+  for (vtkIdType i = 1; i < numTuples; ++i)
+    {
+    minValue = std::min(minValue, array[i]);
+    maxValue = std::max(maxValue, array[i]);
+    }
+  range[0] = std::min(range[0], static_cast<double>(minValue));
+  range[1] = std::max(range[1], static_cast<double>(maxValue));
+}
+
+#endif
@@ -361,24 +361,9 @@ void vtkScalarsToColors::MapVectorsThroughTable(
 
     case vtkScalarsToColors::MAGNITUDE:
       {
-      // convert to magnitude in blocks of 300 values
-      int inInc = vtkDataArray::GetDataTypeSize(scalarType)*inComponents;
-      double magValues[300];
-      int blockSize = 300;
-      int numBlocks = (numValues + blockSize - 1)/blockSize;
-      int lastBlockSize = numValues - blockSize*(numBlocks - 1);
-
-      for (int i = 0; i < numBlocks; i++)
-        {
-        int numMagValues = ((i < numBlocks-1) ? blockSize : lastBlockSize);
-        this->MapVectorsToMagnitude(
-          input, magValues, scalarType, numMagValues, inComponents,
-          vectorSize);
-        this->MapScalarsThroughTable(
-          magValues, output, VTK_DOUBLE, numMagValues, 1, outputFormat);
-        input = static_cast<char *>(input) + numMagValues*inInc;
-        output += numMagValues*outputFormat;
-        }
+      this->MapVectorMagnitudesThroughTable(
+        input, output, scalarType, numValues, inComponents, vectorSize,
+        outputFormat);
       }
       break;
 
@@ -1383,6 +1368,32 @@ void vtkScalarsToColors::MapVectorsToMagnitude(
   delete [] newPtr;
 }
 
+//----------------------------------------------------------------------------
+void vtkScalarsToColors::MapVectorMagnitudesThroughTable(
+  void *input, unsigned char *output, int inputDataType,
+  int numberOfValues, int numberOfComponents, int vectorSize,
+  int outputFormat)
+{
+  // convert to magnitude in blocks of 300 values
+  int inInc = vtkDataArray::GetDataTypeSize(inputDataType)*numberOfComponents;
+  double magValues[300];
+  int blockSize = 300;
+  int numBlocks = (numberOfValues + blockSize - 1)/blockSize;
+  int lastBlockSize = numberOfValues - blockSize*(numBlocks - 1);
+
+  for (int i = 0; i < numBlocks; i++)
+    {
+    int numMagValues = ((i < numBlocks-1) ? blockSize : lastBlockSize);
+    this->MapVectorsToMagnitude(
+      input, magValues, inputDataType, numMagValues, numberOfComponents,
+      vectorSize);
+    this->MapScalarsThroughTable(
+      magValues, output, VTK_DOUBLE, numMagValues, 1, outputFormat);
+    input = static_cast<char *>(input) + numMagValues*inInc;
+    output += numMagValues*outputFormat;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkScalarsToColors::MapScalarsThroughTable2(
   void *inPtr, unsigned char *outPtr, int inputDataType,
@@ -329,6 +329,22 @@ protected:
                              int inputDataType, int numberOfValues,
                              int numberOfComponents, int vectorSize);
 
+  // Description:
+  // An internal method that maps the magnitudes of vectors through the
+  // table, used by MapVectorsThroughTable() in the MAGNITUDE mode. The
+  // default implementation maps the magnitudes computed by
+  // MapVectorsToMagnitude() with MapScalarsThroughTable2(), block by block.
+  // Subclasses can override it to compute the magnitudes while mapping, in
+  // which case subclasses of theirs that override MapScalarsThroughTable2()
+  // should override it too.
+  virtual void MapVectorMagnitudesThroughTable(void *input,
+                                               unsigned char *output,
+                                               int inputDataType,
+                                               int numberOfValues,
+                                               int numberOfComponents,
+                                               int vectorSize,
+                                               int outputFormat);
+
   /// Allocate annotation arrays if needed, then return the index of the given \a value or -1 if not present.
   virtual vtkIdType CheckForAnnotatedValue( vtkVariant value );
   /// Update the map from annotated values to indices in the array of annotations.
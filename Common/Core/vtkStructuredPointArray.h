@@ -0,0 +1,89 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStructuredPointArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStructuredPointArray - implicit coordinates of a structured grid
+// .SECTION Description
+// vtkStructuredPointArray is a read-only, 3-component vtkImplicitArray
+// holding the coordinates of the points of an axis-aligned structured grid,
+// in the order of vtkImageData: x varies fastest, then y, then z. The
+// coordinates are computed either from an origin, a spacing and an extent,
+// like those of vtkImageData, or from the coordinates along each axis, like
+// those of vtkRectilinearGrid. Used as the data of vtkPoints, it gives a
+// point set with the geometry of a grid without storing its points.
+//
+// .SECTION See Also
+// vtkImplicitArray vtkImageDataToPointSet vtkRectilinearGridToPointSet
+
+#ifndef __vtkStructuredPointArray_h
+#define __vtkStructuredPointArray_h
+
+#include "vtkImplicitArray.h"
+
+template <class T>
+class vtkStructuredPointArray : public vtkImplicitArray<T>
+{
+public:
+  typedef T ValueType;
+  vtkImplicitArrayTypeMacro(vtkStructuredPointArray<T>, vtkImplicitArray<T>);
+  static vtkStructuredPointArray<T>* New();
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Compute the coordinates of the point (i, j, k) of extent as
+  // origin + (i, j, k) * spacing, like vtkImageData.
+  void SetImage(const double origin[3], const double spacing[3],
+                const int extent[6]);
+
+  // Description:
+  // Compute the coordinates of the point (i, j, k) as (x[i], y[j], z[k]),
+  // like vtkRectilinearGrid. The number of points is the product of the
+  // number of tuples of the coordinate arrays.
+  void SetRectilinear(vtkDataArray* x, vtkDataArray* y, vtkDataArray* z);
+
+  // Description:
+  // The number of points along each axis.
+  const int* GetDimensions() const { return this->Dimensions; }
+
+  T GetTypedComponent(vtkIdType tupleIdx, int comp) const;
+
+  // Description:
+  // Reimplemented to compute the point once.
+  void GetTuple(vtkIdType i, double* tuple);
+  double* GetTuple(vtkIdType i) { return this->Superclass::GetTuple(i); }
+
+protected:
+  vtkStructuredPointArray();
+  ~vtkStructuredPointArray();
+
+  void ComputeScalarRange(double range[2], int comp);
+
+  // Index of the point tupleIdx along the axis comp.
+  int GetAxisIndex(vtkIdType tupleIdx, int comp) const;
+  void SetCoordinates(int axis, vtkDataArray* coordinates);
+
+  double Origin[3];
+  double Spacing[3];
+  int Extent[6];
+  int Dimensions[3];
+  vtkDataArray* Coordinates[3]; // of the rectilinear grid, if any
+
+private:
+  vtkStructuredPointArray(const vtkStructuredPointArray&);  // Not implemented.
+  void operator=(const vtkStructuredPointArray&);  // Not implemented.
+};
+
+#include "vtkStructuredPointArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkStructuredPointArray.h
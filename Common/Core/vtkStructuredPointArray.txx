@@ -0,0 +1,235 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStructuredPointArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef __vtkStructuredPointArray_txx
+#define __vtkStructuredPointArray_txx
+
+#include "vtkObjectFactory.h"
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkStructuredPointArray<T>* vtkStructuredPointArray<T>::New()
+{
+  vtkObject* ret = vtkObjectFactory::CreateInstance(
+    typeid(vtkStructuredPointArray<T>).name());
+  if (ret)
+    {
+    return static_cast<vtkStructuredPointArray<T>*>(ret);
+    }
+  return new vtkStructuredPointArray<T>();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkStructuredPointArray<T>::vtkStructuredPointArray()
+{
+  this->NumberOfComponents = 3;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->Origin[axis] = 0.0;
+    this->Spacing[axis] = 1.0;
+    this->Extent[2 * axis] = 0;
+    this->Extent[2 * axis + 1] = -1;
+    this->Dimensions[axis] = 0;
+    this->Coordinates[axis] = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkStructuredPointArray<T>::~vtkStructuredPointArray()
+{
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->SetCoordinates(axis, NULL);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkStructuredPointArray<T>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Dimensions: (" << this->Dimensions[0] << ", "
+     << this->Dimensions[1] << ", " << this->Dimensions[2] << ")\n";
+  if (this->Coordinates[0])
+    {
+    os << indent << "Rectilinear Coordinates: (" << this->Coordinates[0]
+       << ", " << this->Coordinates[1] << ", " << this->Coordinates[2]
+       << ")\n";
+    }
+  else
+    {
+    os << indent << "Origin: (" << this->Origin[0] << ", "
+       << this->Origin[1] << ", " << this->Origin[2] << ")\n";
+    os << indent << "Spacing: (" << this->Spacing[0] << ", "
+       << this->Spacing[1] << ", " << this->Spacing[2] << ")\n";
+    os << indent << "Extent: (" << this->Extent[0];
+    for (int idx = 1; idx < 6; ++idx)
+      {
+      os << ", " << this->Extent[idx];
+      }
+    os << ")\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkStructuredPointArray<T>::SetCoordinates(int axis,
+                                                vtkDataArray* coordinates)
+{
+  if (this->Coordinates[axis] != coordinates)
+    {
+    if (this->Coordinates[axis])
+      {
+      this->Coordinates[axis]->UnRegister(this);
+      }
+    this->Coordinates[axis] = coordinates;
+    if (coordinates)
+      {
+      coordinates->Register(this);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkStructuredPointArray<T>::SetImage(const double origin[3],
+                                          const double spacing[3],
+                                          const int extent[6])
+{
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->SetCoordinates(axis, NULL);
+    this->Origin[axis] = origin[axis];
+    this->Spacing[axis] = spacing[axis];
+    this->Extent[2 * axis] = extent[2 * axis];
+    this->Extent[2 * axis + 1] = extent[2 * axis + 1];
+    int dim = extent[2 * axis + 1] - extent[2 * axis] + 1;
+    this->Dimensions[axis] = (dim > 0 ? dim : 0);
+    }
+  this->NumberOfComponents = 3;
+  this->SetNumberOfTuples(static_cast<vtkIdType>(this->Dimensions[0]) *
+                          this->Dimensions[1] * this->Dimensions[2]);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkStructuredPointArray<T>::SetRectilinear(vtkDataArray* x,
+                                                vtkDataArray* y,
+                                                vtkDataArray* z)
+{
+  if (!x || !y || !z)
+    {
+    vtkErrorMacro("The coordinates of the three axes are needed.");
+    return;
+    }
+  vtkDataArray* coordinates[3] = { x, y, z };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->SetCoordinates(axis, coordinates[axis]);
+    this->Dimensions[axis] =
+      static_cast<int>(coordinates[axis]->GetNumberOfTuples());
+    this->Extent[2 * axis] = 0;
+    this->Extent[2 * axis + 1] = this->Dimensions[axis] - 1;
+    }
+  this->NumberOfComponents = 3;
+  this->SetNumberOfTuples(static_cast<vtkIdType>(this->Dimensions[0]) *
+                          this->Dimensions[1] * this->Dimensions[2]);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkStructuredPointArray<T>::GetAxisIndex(vtkIdType tupleIdx,
+                                             int comp) const
+{
+  switch (comp)
+    {
+    case 0:
+      return static_cast<int>(tupleIdx % this->Dimensions[0]);
+    case 1:
+      return static_cast<int>((tupleIdx / this->Dimensions[0]) %
+                              this->Dimensions[1]);
+    default:
+      return static_cast<int>(tupleIdx /
+        (static_cast<vtkIdType>(this->Dimensions[0]) * this->Dimensions[1]));
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkStructuredPointArray<T>::GetTypedComponent(vtkIdType tupleIdx,
+                                                int comp) const
+{
+  int loc = this->GetAxisIndex(tupleIdx, comp);
+  if (this->Coordinates[comp])
+    {
+    return static_cast<T>(this->Coordinates[comp]->GetComponent(loc, 0));
+    }
+  // Same expression as vtkImageData::GetPoint().
+  return static_cast<T>(this->Origin[comp] +
+                        (loc + this->Extent[2 * comp]) * this->Spacing[comp]);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkStructuredPointArray<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  vtkIdType sliceSize =
+    static_cast<vtkIdType>(this->Dimensions[0]) * this->Dimensions[1];
+  int loc[3];
+  loc[0] = static_cast<int>(i % this->Dimensions[0]);
+  loc[1] = static_cast<int>((i / this->Dimensions[0]) % this->Dimensions[1]);
+  loc[2] = static_cast<int>(i / sliceSize);
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (this->Coordinates[axis])
+      {
+      tuple[axis] = static_cast<double>(static_cast<T>(
+        this->Coordinates[axis]->GetComponent(loc[axis], 0)));
+      }
+    else
+      {
+      tuple[axis] = static_cast<double>(static_cast<T>(
+        this->Origin[axis] +
+        (loc[axis] + this->Extent[2 * axis]) * this->Spacing[axis]));
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkStructuredPointArray<T>::ComputeScalarRange(double range[2], int comp)
+{
+  if (this->GetNumberOfTuples() < 1)
+    {
+    return;
+    }
+  if (this->Coordinates[comp])
+    {
+    this->Coordinates[comp]->GetRange(range, 0);
+    return;
+    }
+  // The coordinates along an axis are monotonic.
+  double first = static_cast<double>(this->GetTypedComponent(0, comp));
+  double last = static_cast<double>(this->GetTypedComponent(
+    this->GetNumberOfTuples() - 1, comp));
+  range[0] = (first < last ? first : last);
+  range[1] = (first < last ? last : first);
+}
+
+#endif
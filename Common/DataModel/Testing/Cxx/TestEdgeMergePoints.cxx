@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEdgeMergePoints.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkEdgeMergePoints.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+typedef std::pair<vtkIdType, vtkIdType> Edge;
+
+Edge MakeEdge(vtkIdType v0, vtkIdType v1)
+{
+  return Edge(std::min(v0, v1), std::max(v0, v1));
+}
+
+bool TestMergeEdges()
+{
+  // Random edges among few points, so that most of them are repeated, in
+  // either order, and some of them are vertices.
+  const vtkIdType numEdges = 200000;
+  const vtkIdType numPts = 400;
+  std::vector<vtkIdType> edges(2 * numEdges);
+  for (vtkIdType i = 0; i < numEdges; i++)
+    {
+    edges[2*i] = static_cast<vtkIdType>(vtkMath::Random(0, numPts));
+    edges[2*i+1] = (i % 17 == 0 ? edges[2*i] :
+                    static_cast<vtkIdType>(vtkMath::Random(0, numPts)));
+    }
+
+  std::vector<vtkIdType> pointMap(numEdges);
+  vtkNew<vtkIdTypeArray> uniqueEdges;
+  vtkIdType numUnique = vtkEdgeMergePoints::MergeEdges(
+    numEdges, &edges[0], &pointMap[0], uniqueEdges.GetPointer());
+
+  // Distinct edges are numbered in order of first occurrence.
+  std::map<Edge, vtkIdType> expected;
+  for (vtkIdType i = 0; i < numEdges; i++)
+    {
+    Edge edge = MakeEdge(edges[2*i], edges[2*i+1]);
+    std::map<Edge, vtkIdType>::iterator it = expected.find(edge);
+    vtkIdType id = static_cast<vtkIdType>(expected.size());
+    if (it == expected.end())
+      {
+      expected[edge] = id;
+      }
+    else
+      {
+      id = it->second;
+      }
+    if (pointMap[i] != id)
+      {
+      cerr << "Wrong id " << pointMap[i] << " for edge " << i
+           << ", expected " << id << endl;
+      return false;
+      }
+    }
+  if (numUnique != static_cast<vtkIdType>(expected.size()) ||
+      uniqueEdges->GetNumberOfTuples() != numUnique)
+    {
+    cerr << numUnique << " distinct edges instead of " << expected.size()
+         << endl;
+    return false;
+    }
+  for (std::map<Edge, vtkIdType>::iterator it = expected.begin();
+       it != expected.end(); ++it)
+    {
+    if (uniqueEdges->GetValue(2 * it->second) != it->first.first ||
+        uniqueEdges->GetValue(2 * it->second + 1) != it->first.second)
+      {
+      cerr << "Wrong distinct edge " << it->second << endl;
+      return false;
+      }
+    }
+
+  // Without uniqueEdges, and with a single edge.
+  vtkIdType single[2] = {5, 3};
+  if (vtkEdgeMergePoints::MergeEdges(1, single, &pointMap[0]) != 1 ||
+      pointMap[0] != 0)
+    {
+    cerr << "Wrong merge of a single edge" << endl;
+    return false;
+    }
+  return true;
+}
+
+bool TestLocator()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkEdgeMergePoints> locator;
+  double bounds[6] = {0.0, 1.0, 0.0, 1.0, 0.0, 1.0};
+  locator->InitPointInsertion(points.GetPointer(), bounds);
+
+  // The table grows from its initial size.
+  const vtkIdType numEdges = 5000;
+  double x[3] = {0.5, 0.5, 0.5};
+  vtkIdType ptId;
+  for (vtkIdType i = 0; i < numEdges; i++)
+    {
+    x[0] = static_cast<double>(i) / numEdges;
+    if (!locator->InsertUniqueEdgePoint(i, i + 1, 0.5, x, ptId) ||
+        ptId != i)
+      {
+      cerr << "Edge " << i << " not inserted" << endl;
+      return false;
+      }
+    }
+  for (vtkIdType i = 0; i < numEdges; i++)
+    {
+    // Either orientation of the edge is the same point.
+    if (locator->InsertUniqueEdgePoint(i + 1, i, 0.5, x, ptId) ||
+        ptId != i || locator->IsInsertedEdgePoint(i, i + 1, 0.5) != i)
+      {
+      cerr << "Edge " << i << " inserted twice" << endl;
+      return false;
+      }
+    }
+
+  // Another parameter on the same edge, e.g. of another contour value, is
+  // another point.
+  vtkIdType numPts = numEdges;
+  if (!locator->InsertUniqueEdgePoint(1, 0, 0.75, x, ptId) ||
+      ptId != numPts ||
+      locator->InsertUniqueEdgePoint(0, 1, 0.25, x, ptId) ||
+      ptId != numPts || locator->IsInsertedEdgePoint(0, 1, 0.75) != -1)
+    {
+    cerr << "Wrong insertion of a second point on an edge" << endl;
+    return false;
+    }
+  numPts++;
+
+  // Vertices: t = 0 and t = 1 designate the end points of the edge.
+  if (!locator->InsertUniqueEdgePoint(7, 3, 0.0, x, ptId) ||
+      ptId != numPts ||
+      locator->InsertUniqueEdgePoint(7, 7, 0.3, x, ptId) ||
+      ptId != numPts ||
+      locator->InsertUniqueEdgePoint(2, 7, 1.0, x, ptId) ||
+      ptId != numPts ||
+      locator->IsInsertedEdgePoint(3, 7, 0.0) != -1)
+    {
+    cerr << "Wrong vertex insertion" << endl;
+    return false;
+    }
+  numPts++;
+
+  // Points inserted by coordinates are merged as by vtkMergePoints, and
+  // numbered after the edge points.
+  double y[3] = {0.25, 0.75, 0.5};
+  if (locator->IsInsertedPoint(y) != -1 ||
+      !locator->InsertUniquePoint(y, ptId) || ptId != numPts ||
+      locator->InsertUniquePoint(y, ptId) || ptId != numPts ||
+      locator->IsInsertedPoint(y) != numPts)
+    {
+    cerr << "Wrong insertion by coordinates" << endl;
+    return false;
+    }
+  numPts++;
+  if (points->GetNumberOfPoints() != numPts)
+    {
+    cerr << points->GetNumberOfPoints() << " points inserted" << endl;
+    return false;
+    }
+
+  // A new insertion starts from scratch.
+  vtkNew<vtkPoints> newPoints;
+  locator->InitPointInsertion(newPoints.GetPointer(), bounds, 10);
+  if (locator->IsInsertedEdgePoint(0, 1, 0.5) != -1 ||
+      !locator->InsertUniqueEdgePoint(0, 1, 0.5, x, ptId) || ptId != 0)
+    {
+    cerr << "Wrong reinitialization" << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestEdgeMergePoints(int, char*[])
+{
+  vtkMath::RandomSeed(5678);
+  if (!TestMergeEdges() || !TestLocator())
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOffsetCellArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkOffsetCellArray.h"
+#include "vtkSMPTools.h"
+
+namespace
+{
+const vtkIdType NumberOfCells = 1000;
+
+// Cell i has (i % 5) + 1 points, with ids i, i+1, ...
+void MakeCell(vtkIdType cellId, vtkIdType &npts, vtkIdType pts[5])
+{
+  npts = (cellId % 5) + 1;
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    pts[i] = cellId + i;
+    }
+}
+
+bool CheckCells(vtkOffsetCellArray *cells, const char *label)
+{
+  if (cells->GetNumberOfCells() != NumberOfCells)
+    {
+    cerr << label << ": expected " << NumberOfCells << " cells, got "
+         << cells->GetNumberOfCells() << endl;
+    return false;
+    }
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; cellId++)
+    {
+    vtkIdType npts, expected[5], nexpected;
+    const vtkIdType *pts;
+    MakeCell(cellId, nexpected, expected);
+    cells->GetCellAtId(cellId, npts, pts, ptIds.GetPointer());
+    if (npts != nexpected || cells->GetCellSize(cellId) != nexpected)
+      {
+      cerr << label << ": bad size for cell " << cellId << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      if (pts[i] != expected[i])
+        {
+        cerr << label << ": bad point id for cell " << cellId << endl;
+        return false;
+        }
+      }
+    }
+  if (cells->GetMaxCellSize() != 5)
+    {
+    cerr << label << ": bad max cell size " << cells->GetMaxCellSize()
+         << endl;
+    return false;
+    }
+  return true;
+}
+
+// Sums the point ids of all cells from several threads at once.
+class SumPointIds
+{
+public:
+  vtkOffsetCellArray *Cells;
+  vtkIdType *Sums;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      vtkIdType npts;
+      const vtkIdType *pts;
+      this->Cells->GetCellAtId(cellId, npts, pts, ptIds.GetPointer());
+      vtkIdType sum = 0;
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        sum += pts[i];
+        }
+      this->Sums[cellId] = sum;
+      }
+    }
+};
+
+bool CheckParallelAccess(vtkOffsetCellArray *cells, const char *label)
+{
+  vtkIdType sums[NumberOfCells];
+  SumPointIds functor;
+  functor.Cells = cells;
+  functor.Sums = sums;
+  vtkSMPTools::For(0, NumberOfCells, 10, functor);
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; cellId++)
+    {
+    vtkIdType npts, pts[5], sum = 0;
+    MakeCell(cellId, npts, pts);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      sum += pts[i];
+      }
+    if (sums[cellId] != sum)
+      {
+      cerr << label << ": bad parallel access to cell " << cellId << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestOffsetCellArray(int, char*[])
+{
+  vtkNew<vtkCellArray> legacy;
+  vtkNew<vtkOffsetCellArray> cells64;
+  vtkNew<vtkOffsetCellArray> cells32;
+  cells64->Use64BitStorage();
+  cells32->Use32BitStorage();
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; cellId++)
+    {
+    vtkIdType npts, pts[5];
+    MakeCell(cellId, npts, pts);
+    legacy->InsertNextCell(npts, pts);
+    if (cells64->InsertNextCell(npts, pts) != cellId ||
+        cells32->InsertNextCell(npts, pts) != cellId)
+      {
+      cerr << "InsertNextCell returned a bad cell id." << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (!cells64->IsStorage64Bit() || cells32->IsStorage64Bit() ||
+      cells32->GetConnectivityArray()->GetDataTypeSize() != 4 ||
+      cells64->GetConnectivityArray()->GetDataTypeSize() != 8)
+    {
+    cerr << "Unexpected storage width." << endl;
+    return EXIT_FAILURE;
+    }
+  if (!CheckCells(cells64.GetPointer(), "64-bit") ||
+      !CheckCells(cells32.GetPointer(), "32-bit") ||
+      !CheckParallelAccess(cells64.GetPointer(), "64-bit") ||
+      !CheckParallelAccess(cells32.GetPointer(), "32-bit"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Storage conversion keeps the cells.
+  vtkNew<vtkOffsetCellArray> converted;
+  converted->DeepCopy(cells64.GetPointer());
+  if (!converted->ConvertToSmallestStorage() ||
+      converted->IsStorage64Bit() ||
+      !CheckCells(converted.GetPointer(), "converted to 32-bit") ||
+      !converted->ConvertTo64BitStorage() ||
+      !CheckCells(converted.GetPointer(), "converted to 64-bit"))
+    {
+    return EXIT_FAILURE;
+    }
+  vtkIdType bigIds[2] = {0, static_cast<vtkIdType>(VTK_INT_MAX) + 1};
+  vtkNew<vtkOffsetCellArray> big;
+  big->Use64BitStorage();
+  big->InsertNextCell(2, bigIds);
+  if (big->CanConvertTo32BitStorage() || big->ConvertTo32BitStorage() ||
+      !big->IsStorage64Bit())
+    {
+    cerr << "Point ids above 2^31 must prevent 32-bit storage." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Import from and export to the legacy layout.
+  vtkNew<vtkOffsetCellArray> imported;
+  imported->Use32BitStorage();
+  imported->ImportLegacyFormat(legacy.GetPointer());
+  if (!CheckCells(imported.GetPointer(), "imported"))
+    {
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkCellArray> exported;
+  cells32->ExportLegacyFormat(exported.GetPointer());
+  if (exported->GetNumberOfCells() != NumberOfCells ||
+      exported->GetNumberOfConnectivityEntries() !=
+      legacy->GetNumberOfConnectivityEntries())
+    {
+    cerr << "Exported array has the wrong size." << endl;
+    return EXIT_FAILURE;
+    }
+  for (vtkIdType i = 0; i < legacy->GetNumberOfConnectivityEntries(); i++)
+    {
+    if (exported->GetPointer()[i] != legacy->GetPointer()[i])
+      {
+      cerr << "Exported array differs from the legacy array at " << i
+           << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // SetData shares arrays of the storage class and copies the others.
+  vtkNew<vtkOffsetCellArray> shared;
+  if (!shared->SetData(cells32->GetOffsetsArray(),
+                       cells32->GetConnectivityArray()) ||
+      shared->GetConnectivityArray() != cells32->GetConnectivityArray() ||
+      !CheckCells(shared.GetPointer(), "shared"))
+    {
+    cerr << "SetData did not share the arrays." << endl;
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkIntArray> offsets;
+  vtkNew<vtkIntArray> conn;
+  offsets->InsertNextValue(0);
+  offsets->InsertNextValue(3);
+  conn->InsertNextValue(4);
+  conn->InsertNextValue(5);
+  conn->InsertNextValue(6);
+  vtkNew<vtkOffsetCellArray> copied;
+  if (!copied->SetData(offsets.GetPointer(), conn.GetPointer()) ||
+      copied->GetNumberOfCells() != 1 || copied->GetCellSize(0) != 3)
+    {
+    cerr << "SetData failed on a vtkIntArray." << endl;
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkIdList> ptIds;
+  copied->ReverseCellAtId(0);
+  copied->GetCellAtId(0, ptIds.GetPointer());
+  if (ptIds->GetNumberOfIds() != 3 || ptIds->GetId(0) != 6 ||
+      ptIds->GetId(2) != 4)
+    {
+    cerr << "ReverseCellAtId failed." << endl;
+    return EXIT_FAILURE;
+    }
+  offsets->SetValue(1, 2);
+  vtkObject::GlobalWarningDisplayOff();
+  bool accepted = copied->SetData(offsets.GetPointer(), conn.GetPointer());
+  vtkObject::GlobalWarningDisplayOn();
+  if (accepted || copied->GetCellSize(0) != 3)
+    {
+    cerr << "SetData accepted inconsistent offsets." << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
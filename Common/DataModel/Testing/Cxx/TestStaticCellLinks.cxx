@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkOffsetCellArray.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+
+namespace
+{
+// Compare the static links with vtkDataSet::GetPointCells(), which uses
+// vtkCellLinks for polydata and unstructured grids.
+bool CompareLinks(vtkDataSet *ds, vtkStaticCellLinks *links,
+                  const char *label)
+{
+  if (links->GetNumberOfPoints() != ds->GetNumberOfPoints())
+    {
+    cerr << label << ": wrong number of points." << endl;
+    return false;
+    }
+  vtkNew<vtkIdList> cellIds;
+  vtkIdType total = 0;
+  for (vtkIdType ptId = 0; ptId < ds->GetNumberOfPoints(); ptId++)
+    {
+    ds->GetPointCells(ptId, cellIds.GetPointer());
+    vtkIdType *expected = cellIds->GetPointer(0);
+    std::sort(expected, expected + cellIds->GetNumberOfIds());
+    vtkIdType ncells = links->GetNcells(ptId);
+    const vtkIdType *cells = links->GetCells(ptId);
+    if (ncells != cellIds->GetNumberOfIds() ||
+        !std::equal(cells, cells + ncells, expected))
+      {
+      cerr << label << ": wrong cells for point " << ptId << endl;
+      return false;
+      }
+    total += ncells;
+    }
+  if (total != links->GetLinksSize())
+    {
+    cerr << label << ": wrong links size." << endl;
+    return false;
+    }
+  return true;
+}
+
+// A res x res grid of points covered by quads and triangles, plus a few
+// vertices and lines so that polydata cell ids span several cell arrays.
+void MakePolyData(int res, vtkPolyData *pd)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < res; j++)
+    {
+    for (int i = 0; i < res; i++)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < res - 1; j++)
+    {
+    for (int i = 0; i < res - 1; i++)
+      {
+      vtkIdType p0 = i + j * res;
+      vtkIdType quad[4] = {p0, p0 + 1, p0 + 1 + res, p0 + res};
+      if ((i + j) % 3)
+        {
+        polys->InsertNextCell(4, quad);
+        }
+      else
+        {
+        vtkIdType tri1[3] = {quad[0], quad[1], quad[2]};
+        vtkIdType tri2[3] = {quad[0], quad[2], quad[3]};
+        polys->InsertNextCell(3, tri1);
+        polys->InsertNextCell(3, tri2);
+        }
+      }
+    vtkIdType vert = j * res;
+    vtkIdType line[2] = {j * res, j * res + res - 1};
+    verts->InsertNextCell(1, &vert);
+    lines->InsertNextCell(2, line);
+    }
+  pd->SetPoints(points.GetPointer());
+  pd->SetVerts(verts.GetPointer());
+  pd->SetLines(lines.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+}
+}
+
+int TestStaticCellLinks(int, char*[])
+{
+  const int res = 101;
+
+  // Polydata, through the cells of vtkPolyData.
+  vtkNew<vtkPolyData> pd;
+  MakePolyData(res, pd.GetPointer());
+  vtkNew<vtkStaticCellLinks> links;
+  links->BuildLinks(pd.GetPointer());
+  if (!CompareLinks(pd.GetPointer(), links.GetPointer(), "vtkPolyData"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The same cells in an unstructured grid.
+  vtkNew<vtkUnstructuredGrid> ug;
+  ug->SetPoints(pd->GetPoints());
+  ug->Allocate(pd->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < pd->GetNumberOfCells(); cellId++)
+    {
+    pd->GetCellPoints(cellId, ptIds.GetPointer());
+    ug->InsertNextCell(pd->GetCellType(cellId), ptIds.GetPointer());
+    }
+  links->BuildLinks(ug.GetPointer());
+  if (!CompareLinks(ug.GetPointer(), links.GetPointer(),
+                    "vtkUnstructuredGrid"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Generic path, through vtkDataSet::GetCellPoints().
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 15, 10);
+  links->BuildLinks(image.GetPointer());
+  if (!CompareLinks(image.GetPointer(), links.GetPointer(), "vtkImageData"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Cell arrays: the polygons alone, in both layouts. Polygon cell ids in
+  // the polydata start after the vertices and lines.
+  vtkNew<vtkPolyData> polysOnly;
+  polysOnly->SetPoints(pd->GetPoints());
+  polysOnly->SetPolys(pd->GetPolys());
+  links->BuildLinks(pd->GetNumberOfPoints(), pd->GetPolys());
+  if (!CompareLinks(polysOnly.GetPointer(), links.GetPointer(),
+                    "vtkCellArray"))
+    {
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkOffsetCellArray> offsetCells;
+  offsetCells->Use32BitStorage();
+  offsetCells->ImportLegacyFormat(pd->GetPolys());
+  links->BuildLinks(pd->GetNumberOfPoints(), offsetCells.GetPointer());
+  if (!CompareLinks(polysOnly.GetPointer(), links.GetPointer(),
+                    "vtkOffsetCellArray"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkStaticCellLinks> copy;
+  copy->DeepCopy(links.GetPointer());
+  links->Initialize();
+  if (links->GetLinksSize() != 0 ||
+      !CompareLinks(polysOnly.GetPointer(), copy.GetPointer(), "DeepCopy"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,317 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// A res^3 grid of distorted hexahedra in [0,1]^3.
+void MakeGrid(int res, vtkUnstructuredGrid *ug)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= res; k++)
+    {
+    for (int j = 0; j <= res; j++)
+      {
+      for (int i = 0; i <= res; i++)
+        {
+        double x = static_cast<double>(i) / res;
+        double y = static_cast<double>(j) / res;
+        double z = static_cast<double>(k) / res;
+        points->InsertNextPoint(x + 0.02 * sin(6.0 * y), y, z * (1.0 + x));
+        }
+      }
+    }
+  ug->SetPoints(points.GetPointer());
+  ug->Allocate(res * res * res);
+  vtkIdType n = res + 1;
+  for (int k = 0; k < res; k++)
+    {
+    for (int j = 0; j < res; j++)
+      {
+      for (int i = 0; i < res; i++)
+        {
+        vtkIdType p0 = i + n * (j + n * k);
+        vtkIdType hex[8] = {p0, p0 + 1, p0 + 1 + n, p0 + n,
+                            p0 + n*n, p0 + 1 + n*n, p0 + 1 + n + n*n,
+                            p0 + n + n*n};
+        ug->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+      }
+    }
+}
+
+// A triangulated height field over [0,1]^2.
+void MakeSurface(int res, vtkPolyData *pd)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j <= res; j++)
+    {
+    for (int i = 0; i <= res; i++)
+      {
+      double x = static_cast<double>(i) / res;
+      double y = static_cast<double>(j) / res;
+      points->InsertNextPoint(x, y, 0.2 * sin(5.0 * x) * cos(3.0 * y));
+      }
+    }
+  for (int j = 0; j < res; j++)
+    {
+    for (int i = 0; i < res; i++)
+      {
+      vtkIdType p0 = i + (res + 1) * j;
+      vtkIdType tri1[3] = {p0, p0 + 1, p0 + res + 2};
+      vtkIdType tri2[3] = {p0, p0 + res + 2, p0 + res + 1};
+      polys->InsertNextCell(3, tri1);
+      polys->InsertNextCell(3, tri2);
+      }
+    }
+  pd->SetPoints(points.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+}
+
+void RandomPoint(double x[3], double lo, double hi)
+{
+  for (int i = 0; i < 3; i++)
+    {
+    x[i] = vtkMath::Random(lo, hi);
+    }
+}
+
+bool CheckFindCell(vtkUnstructuredGrid *ug, vtkStaticCellLocator *locator,
+                   const char *label)
+{
+  const int numQueries = 500;
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkPoints> queries;
+  vtkNew<vtkIdList> expected;
+  double x[3], pcoords[3], weights[8], closest[3], dist2;
+  int subId;
+  for (int q = 0; q < numQueries; q++)
+    {
+    RandomPoint(x, -0.1, 1.5);
+    queries->InsertNextPoint(x);
+    vtkIdType found = -1;
+    for (vtkIdType cellId = 0; cellId < ug->GetNumberOfCells(); cellId++)
+      {
+      ug->GetCell(cellId, cell.GetPointer());
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                 weights) == 1)
+        {
+        found = cellId;
+        break;
+        }
+      }
+    expected->InsertNextId(found);
+    if (locator->FindCell(x, 0.0, cell.GetPointer(), pcoords, weights) !=
+        found)
+      {
+      cerr << label << ": wrong FindCell result for query " << q << endl;
+      return false;
+      }
+    }
+
+  vtkNew<vtkIdList> cellIds;
+  locator->FindCells(queries.GetPointer(), cellIds.GetPointer());
+  for (int q = 0; q < numQueries; q++)
+    {
+    if (cellIds->GetId(q) != expected->GetId(q))
+      {
+      cerr << label << ": wrong FindCells result for query " << q << endl;
+      return false;
+      }
+    }
+
+  // Coherent queries along a line, which mostly hit the previous cell.
+  queries->Reset();
+  for (int q = 0; q < numQueries; q++)
+    {
+    double t = static_cast<double>(q) / numQueries;
+    queries->InsertNextPoint(0.1 + 0.8 * t, 0.5, 0.3 + 0.2 * t);
+    }
+  locator->FindCells(queries.GetPointer(), cellIds.GetPointer());
+  for (int q = 0; q < numQueries; q++)
+    {
+    queries->GetPoint(q, x);
+    vtkIdType cellId = cellIds->GetId(q);
+    if (cellId < 0)
+      {
+      cerr << label << ": coherent query " << q << " not found" << endl;
+      return false;
+      }
+    ug->GetCell(cellId, cell.GetPointer());
+    if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                               weights) != 1)
+      {
+      cerr << label << ": coherent query " << q << " in wrong cell" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+bool CheckSurface(vtkPolyData *pd, vtkStaticCellLocator *locator,
+                  const char *label)
+{
+  const int numQueries = 200;
+  vtkNew<vtkGenericCell> cell;
+  double x[3], p2[3], closest[3], pcoords[3], weights[3], dist2, t;
+  int subId;
+  vtkIdType cellId;
+  for (int q = 0; q < numQueries; q++)
+    {
+    // Closest point.
+    RandomPoint(x, -0.5, 1.5);
+    double minDist2 = VTK_DOUBLE_MAX;
+    vtkIdType minCell = -1;
+    for (vtkIdType id = 0; id < pd->GetNumberOfCells(); id++)
+      {
+      pd->GetCell(id, cell.GetPointer());
+      cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights);
+      if (dist2 < minDist2)
+        {
+        minDist2 = dist2;
+        minCell = id;
+        }
+      }
+    locator->FindClosestPoint(x, closest, cell.GetPointer(), cellId, subId,
+                              dist2);
+    if (cellId != minCell || dist2 != minDist2)
+      {
+      cerr << label << ": wrong closest point for query " << q << endl;
+      return false;
+      }
+    int inside;
+    vtkIdType found = locator->FindClosestPointWithinRadius(
+      x, 0.1, closest, cell.GetPointer(), cellId, subId, dist2, inside);
+    if ((minDist2 <= 0.01) != (found == 1) ||
+        (found && cellId != minCell))
+      {
+      cerr << label << ": wrong closest point within radius for query "
+           << q << endl;
+      return false;
+      }
+
+    // Intersection with a vertical segment.
+    x[2] = 1.0;
+    p2[0] = x[0] + 0.1;
+    p2[1] = x[1];
+    p2[2] = -1.0;
+    double minT = VTK_DOUBLE_MAX;
+    minCell = -1;
+    for (vtkIdType id = 0; id < pd->GetNumberOfCells(); id++)
+      {
+      pd->GetCell(id, cell.GetPointer());
+      if (cell->IntersectWithLine(x, p2, 0.0, t, closest, pcoords, subId) &&
+          t < minT)
+        {
+        minT = t;
+        minCell = id;
+        }
+      }
+    int hit = locator->IntersectWithLine(x, p2, 0.0, t, closest, pcoords,
+                                         subId, cellId, cell.GetPointer());
+    if ((hit != 0) != (minCell >= 0) || (hit && t != minT))
+      {
+      cerr << label << ": wrong line intersection for query " << q << endl;
+      return false;
+      }
+    }
+
+  // Cells within bounds.
+  double bbox[6] = {0.2, 0.4, 0.5, 0.55, -1.0, 1.0};
+  vtkNew<vtkIdList> cells;
+  locator->FindCellsWithinBounds(bbox, cells.GetPointer());
+  std::sort(cells->GetPointer(0),
+            cells->GetPointer(0) + cells->GetNumberOfIds());
+  vtkIdType numExpected = 0;
+  for (vtkIdType id = 0; id < pd->GetNumberOfCells(); id++)
+    {
+    double b[6];
+    pd->GetCellBounds(id, b);
+    if (b[0] <= bbox[1] && bbox[0] <= b[1] && b[2] <= bbox[3] &&
+        bbox[2] <= b[3] && b[4] <= bbox[5] && bbox[4] <= b[5])
+      {
+      if (numExpected >= cells->GetNumberOfIds() ||
+          cells->GetId(numExpected) != id)
+        {
+        cerr << label << ": wrong cells within bounds" << endl;
+        return false;
+        }
+      numExpected++;
+      }
+    }
+  if (numExpected != cells->GetNumberOfIds())
+    {
+    cerr << label << ": too many cells within bounds" << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestStaticCellLocator(int, char*[])
+{
+  vtkMath::RandomSeed(4321);
+
+  vtkNew<vtkUnstructuredGrid> ug;
+  MakeGrid(12, ug.GetPointer());
+  vtkNew<vtkPolyData> pd;
+  MakeSurface(40, pd.GetPointer());
+
+  for (int method = VTK_STATIC_CELL_LOCATOR_SAH;
+       method <= VTK_STATIC_CELL_LOCATOR_MEDIAN; method++)
+    {
+    const char *label = (method == VTK_STATIC_CELL_LOCATOR_SAH ?
+                         "SAH" : "Median");
+    vtkNew<vtkStaticCellLocator> locator;
+    locator->SetSplitMethod(method);
+    locator->SetDataSet(ug.GetPointer());
+    locator->BuildLocator();
+    if (!CheckFindCell(ug.GetPointer(), locator.GetPointer(), label))
+      {
+      return EXIT_FAILURE;
+      }
+
+    locator->SetDataSet(pd.GetPointer());
+    locator->BuildLocator();
+    if (!CheckSurface(pd.GetPointer(), locator.GetPointer(), label))
+      {
+      return EXIT_FAILURE;
+      }
+
+    vtkNew<vtkPolyData> representation;
+    locator->GenerateRepresentation(locator->GetDepth(),
+                                    representation.GetPointer());
+    if (representation->GetNumberOfCells() == 0)
+      {
+      cerr << label << ": empty representation" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticPointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Brute force closest N points, ties resolved by point id.
+void BruteForceClosestN(vtkPolyData *pd, int N, const double x[3],
+                        vtkIdList *result)
+{
+  std::vector<std::pair<double, vtkIdType> > dists;
+  double pt[3];
+  for (vtkIdType ptId = 0; ptId < pd->GetNumberOfPoints(); ptId++)
+    {
+    pd->GetPoint(ptId, pt);
+    dists.push_back(
+      std::make_pair(vtkMath::Distance2BetweenPoints(x, pt), ptId));
+    }
+  std::sort(dists.begin(), dists.end());
+  vtkIdType numIds = std::min(static_cast<vtkIdType>(N),
+                              static_cast<vtkIdType>(dists.size()));
+  result->SetNumberOfIds(numIds);
+  for (vtkIdType i = 0; i < numIds; i++)
+    {
+    result->SetId(i, dists[i].second);
+    }
+}
+
+bool SameIds(vtkIdList *a, vtkIdList *b)
+{
+  return a->GetNumberOfIds() == b->GetNumberOfIds() &&
+    std::equal(a->GetPointer(0), a->GetPointer(0) + a->GetNumberOfIds(),
+               b->GetPointer(0));
+}
+
+// Runs FindClosestPoint from several threads at once.
+class FindClosest
+{
+public:
+  vtkStaticPointLocator *Locator;
+  const double *Queries;
+  vtkIdType *Result;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Result[i] = this->Locator->FindClosestPoint(this->Queries + 3*i);
+      }
+    }
+};
+
+bool CheckLocator(vtkPolyData *pd, const char *label)
+{
+  const int numQueries = 200;
+  const int N = 8;
+  const double R = 0.1;
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(pd);
+  locator->BuildLocator();
+
+  // The automatic divisions give about one bucket per
+  // NumberOfPointsPerBucket points, whatever the shape of the bounds.
+  vtkIdType target =
+    pd->GetNumberOfPoints() / locator->GetNumberOfPointsPerBucket();
+  if (locator->GetNumberOfBuckets() > 2 * target + 1)
+    {
+    cerr << label << ": " << locator->GetNumberOfBuckets()
+         << " buckets for a target of " << target << "." << endl;
+    return false;
+    }
+
+  vtkIdType total = 0;
+  for (vtkIdType b = 0; b < locator->GetNumberOfBuckets(); b++)
+    {
+    total += locator->GetNumberOfPointsInBucket(b);
+    }
+  if (total != pd->GetNumberOfPoints())
+    {
+    cerr << label << ": buckets hold " << total << " points." << endl;
+    return false;
+    }
+
+  // Queries inside and around the bounds of the points.
+  std::vector<double> queries(3 * numQueries);
+  for (int i = 0; i < 3 * numQueries; i++)
+    {
+    queries[i] = vtkMath::Random(-0.25, 1.25);
+    }
+
+  vtkNew<vtkIdList> expected;
+  vtkNew<vtkIdList> result;
+  double pt[3];
+  for (int q = 0; q < numQueries; q++)
+    {
+    const double *x = &queries[3*q];
+
+    BruteForceClosestN(pd, N, x, expected.GetPointer());
+    if (locator->FindClosestPoint(x) != expected->GetId(0))
+      {
+      cerr << label << ": wrong closest point for query " << q << endl;
+      return false;
+      }
+
+    locator->FindClosestNPoints(N, x, result.GetPointer());
+    if (!SameIds(result.GetPointer(), expected.GetPointer()))
+      {
+      cerr << label << ": wrong closest N points for query " << q << endl;
+      return false;
+      }
+
+    double dist2;
+    pd->GetPoint(expected->GetId(0), pt);
+    double minDist2 = vtkMath::Distance2BetweenPoints(x, pt);
+    vtkIdType closest = locator->FindClosestPointWithinRadius(R, x, dist2);
+    if ((minDist2 <= R*R && (closest != expected->GetId(0) ||
+                             dist2 != minDist2)) ||
+        (minDist2 > R*R && closest != -1))
+      {
+      cerr << label << ": wrong closest point within radius for query "
+           << q << endl;
+      return false;
+      }
+
+    expected->Reset();
+    for (vtkIdType ptId = 0; ptId < pd->GetNumberOfPoints(); ptId++)
+      {
+      pd->GetPoint(ptId, pt);
+      if (vtkMath::Distance2BetweenPoints(x, pt) <= R*R)
+        {
+        expected->InsertNextId(ptId);
+        }
+      }
+    locator->FindPointsWithinRadius(R, x, result.GetPointer());
+    std::sort(result->GetPointer(0),
+              result->GetPointer(0) + result->GetNumberOfIds());
+    if (!SameIds(result.GetPointer(), expected.GetPointer()))
+      {
+      cerr << label << ": wrong points within radius for query " << q
+           << endl;
+      return false;
+      }
+    }
+
+  // Concurrent queries give the same answers.
+  std::vector<vtkIdType> closest(numQueries);
+  FindClosest functor;
+  functor.Locator = locator.GetPointer();
+  functor.Queries = &queries[0];
+  functor.Result = &closest[0];
+  vtkSMPTools::For(0, numQueries, 10, functor);
+  for (int q = 0; q < numQueries; q++)
+    {
+    if (closest[q] != locator->FindClosestPoint(&queries[3*q]))
+      {
+      cerr << label << ": wrong concurrent result for query " << q << endl;
+      return false;
+      }
+    }
+
+  vtkNew<vtkPolyData> representation;
+  locator->GenerateRepresentation(0, representation.GetPointer());
+  if (representation->GetNumberOfCells() == 0)
+    {
+    cerr << label << ": empty representation." << endl;
+    return false;
+    }
+
+  return true;
+}
+}
+
+int TestStaticPointLocator(int, char*[])
+{
+  vtkMath::RandomSeed(1234);
+
+  // Random points in the unit cube.
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 5000; i++)
+    {
+    points->InsertNextPoint(vtkMath::Random(), vtkMath::Random(),
+                            vtkMath::Random());
+    }
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points.GetPointer());
+  if (!CheckLocator(pd.GetPointer(), "volume"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Double precision points in a plane, each one repeated twice: ties
+  // must resolve to the smaller point id.
+  vtkNew<vtkPoints> planar;
+  planar->SetDataTypeToDouble();
+  for (int i = 0; i < 1000; i++)
+    {
+    double x = vtkMath::Random();
+    double y = vtkMath::Random();
+    planar->InsertNextPoint(x, y, 0.5);
+    planar->InsertNextPoint(x, y, 0.5);
+    }
+  vtkNew<vtkPolyData> planarPD;
+  planarPD->SetPoints(planar.GetPointer());
+  if (!CheckLocator(planarPD.GetPointer(), "planar"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Points in nearly flat bounds.
+  vtkNew<vtkPoints> flat;
+  for (int i = 0; i < 5000; i++)
+    {
+    flat->InsertNextPoint(vtkMath::Random(), vtkMath::Random(),
+                          vtkMath::Random(0.0, 1e-6));
+    }
+  vtkNew<vtkPolyData> flatPD;
+  flatPD->SetPoints(flat.GetPointer());
+  if (!CheckLocator(flatPD.GetPointer(), "nearly flat"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A single point.
+  vtkNew<vtkPoints> single;
+  single->InsertNextPoint(0.5, 0.5, 0.5);
+  vtkNew<vtkPolyData> singlePD;
+  singlePD->SetPoints(single.GetPointer());
+  if (!CheckLocator(singlePD.GetPointer(), "single point"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
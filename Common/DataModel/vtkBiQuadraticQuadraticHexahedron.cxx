@@ -18,6 +18,7 @@
 
 #include "vtkBiQuadraticQuadraticHexahedron.h"
 
+#include "vtkEdgeMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
@@ -399,6 +400,9 @@ void vtkBiQuadraticQuadraticHexahedron::Contour(double value,
 {
   //subdivide into 8 linear hexs
   this->Subdivide(inPd,inCd,cellId, cellScalars);
+  // The linear hexahedra are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear quad separately
   for (int i=0; i<8; i++) // For each subdivided hexahedron
@@ -412,6 +416,8 @@ void vtkBiQuadraticQuadraticHexahedron::Contour(double value,
     this->Hex->Contour(value,this->Scalars,locator,verts,lines,polys,
                        this->PointData,outPd,this->CellData,cellId,outCd);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
@@ -595,6 +601,9 @@ void vtkBiQuadraticQuadraticHexahedron::Clip(double value,
 {
   //create eight linear hexes
   this->Subdivide(inPd,inCd,cellId,cellScalars);
+  // The linear hexahedra are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear hex separately
   for (int i=0; i<8; i++) // For each subdivided hexahedron
@@ -608,6 +617,8 @@ void vtkBiQuadraticQuadraticHexahedron::Clip(double value,
     this->Hex->Clip(value,this->Scalars,locator,tets,this->PointData,outPd,
                     this->CellData,cellId,outCd,insideOut);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
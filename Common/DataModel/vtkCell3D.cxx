@@ -129,7 +129,7 @@ void vtkCell3D::Contour(double value, vtkDataArray *cellScalars,
       }
 
     this->Points->GetPoint(i, x);
-    if ( locator->InsertUniquePoint(x, id) )
+    if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, id) )
       {
       outPd->CopyData(inPd,ptId, id);
       }
@@ -192,10 +192,11 @@ void vtkCell3D::Contour(double value, vtkDataArray *cellScalars,
         }
 
       // Incorporate point into output and interpolate edge data as necessary
-      if ( locator->InsertUniquePoint(x, ptId) )
+      vtkIdType edgeId1 = this->PointIds->GetId(v1);
+      vtkIdType edgeId2 = this->PointIds->GetId(v2);
+      if ( locator->InsertUniqueEdgePoint(edgeId1, edgeId2, t, x, ptId) )
         {
-        outPd->InterpolateEdge(inPd, ptId, this->PointIds->GetId(v1),
-                               this->PointIds->GetId(v2), t);
+        outPd->InterpolateEdge(inPd, ptId, edgeId1, edgeId2, t);
         }
 
       //Insert intersection point into Delaunay triangulation
@@ -276,10 +277,11 @@ void vtkCell3D::Clip(double value, vtkDataArray *cellScalars,
       {
       ptId = this->PointIds->GetId(i);
       this->Points->GetPoint(i, x);
-      if ( locator->InsertUniquePoint(x, id) )
+      if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, id) )
         {
         outPD->CopyData(inPD,ptId, id);
         }
+      internalId[i] = id;
       this->Triangulator->InsertPoint(id, x, p, type);
       }//for all cell points of fixed topology
 
@@ -304,10 +306,24 @@ void vtkCell3D::Clip(double value, vtkDataArray *cellScalars,
             this->Triangulator->GetNextTetra(0,this->ClipTetra,
                                              cellScalars,this->ClipScalars);)
         {
-        // VERY IMPORTANT: Notice that the outPD is used twice. This is because the
-        // tetra has been defined in terms of point ids that are defined in the
-        // output (because of the templates).
-        this->ClipTetra->Clip(value, this->ClipScalars, locator, tets, outPD,
+        // VERY IMPORTANT: the tetra has been defined in terms of point ids
+        // that are defined in the output (because of the templates). Map
+        // them back to the input point ids, so that the locator identifies
+        // the intersection points by the same input edges as the other
+        // cells do.
+        for (j=0; j<4; j++)
+          {
+          id = this->ClipTetra->PointIds->GetId(j);
+          for (int k=0; k<numPts; k++)
+            {
+            if ( internalId[k] == id )
+              {
+              this->ClipTetra->PointIds->SetId(j, this->PointIds->GetId(k));
+              break;
+              }
+            }
+          }
+        this->ClipTetra->Clip(value, this->ClipScalars, locator, tets, inPD,
                               outPD, inCD, cellId, outCD, insideOut);
         }
       }//if boundary cell
@@ -335,7 +351,7 @@ void vtkCell3D::Clip(double value, vtkDataArray *cellScalars,
       }
 
     this->Points->GetPoint(i, x);
-    if ( locator->InsertUniquePoint(x, id) )
+    if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, id) )
       {
       outPD->CopyData(inPD,ptId, id);
       }
@@ -398,10 +414,11 @@ void vtkCell3D::Clip(double value, vtkDataArray *cellScalars,
         }
 
       // Incorporate point into output and interpolate edge data as necessary
-      if ( locator->InsertUniquePoint(x, ptId) )
+      vtkIdType edgeId1 = this->PointIds->GetId(v1);
+      vtkIdType edgeId2 = this->PointIds->GetId(v2);
+      if ( locator->InsertUniqueEdgePoint(edgeId1, edgeId2, t, x, ptId) )
         {
-        outPD->InterpolateEdge(inPD, ptId, this->PointIds->GetId(v1),
-                               this->PointIds->GetId(v2), t);
+        outPD->InterpolateEdge(inPD, ptId, edgeId1, edgeId2, t);
         }
 
       //Insert intersection point into Delaunay triangulation
@@ -0,0 +1,557 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkEdgeMergePoints.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkEdgeMergePoints.h"
+
+#include "vtkIdTypeArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+vtkStandardNewMacro(vtkEdgeMergePoints);
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Identify a point by its edge (v0,v1) with v0 < v1 and its parameter t
+// from v0 to v1, or by its vertex (v,v) with t = 0.
+inline void vtkEdgeMergePointsKey(vtkIdType &v0, vtkIdType &v1, double &t)
+{
+  if ( t <= 0.0 || v0 == v1 )
+    {
+    v1 = v0;
+    t = 0.0;
+    }
+  else if ( t >= 1.0 )
+    {
+    v0 = v1;
+    t = 0.0;
+    }
+  else if ( v1 < v0 )
+    {
+    std::swap(v0, v1);
+    t = 1.0 - t;
+    }
+}
+
+inline vtkIdType vtkEdgeMergePointsHash(vtkIdType v0, vtkIdType v1, double t,
+                                        vtkIdType mask)
+{
+  vtkTypeUInt64 bits;
+  memcpy(&bits, &t, sizeof(bits));
+  vtkTypeUInt64 h = static_cast<vtkTypeUInt64>(v0) * 0x9E3779B97F4A7C15ULL ^
+    static_cast<vtkTypeUInt64>(v1) * 0xC2B2AE3D27D4EB4FULL ^ bits;
+  return static_cast<vtkIdType>((h ^ (h >> 29)) & static_cast<vtkTypeUInt64>(mask));
+}
+
+//----------------------------------------------------------------------------
+// The edge tuples sorted by MergeEdges(): the edge, and its position in the
+// input.
+struct vtkEdgeMergePointsTuple
+{
+  vtkIdType V0;
+  vtkIdType V1;
+  vtkIdType Index;
+
+  bool operator<(const vtkEdgeMergePointsTuple &other) const
+    {
+    return this->V0 < other.V0 ||
+      (this->V0 == other.V0 &&
+       (this->V1 < other.V1 ||
+        (this->V1 == other.V1 && this->Index < other.Index)));
+    }
+
+  bool SameEdge(const vtkEdgeMergePointsTuple &other) const
+    {
+    return this->V0 == other.V0 && this->V1 == other.V1;
+    }
+};
+
+class vtkEdgeMergePointsMakeTuples
+{
+public:
+  const vtkIdType *Edges;
+  vtkEdgeMergePointsTuple *Tuples;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      vtkIdType v0 = this->Edges[2*i], v1 = this->Edges[2*i+1];
+      this->Tuples[i].V0 = std::min(v0, v1);
+      this->Tuples[i].V1 = std::max(v0, v1);
+      this->Tuples[i].Index = i;
+      }
+    }
+};
+
+// Each chunk of the sorted tuples processes the runs of equal edges that
+// start in it: the first edge of a run, which comes first in the input, is
+// the representative of the run.
+class vtkEdgeMergePointsFindRepresentatives
+{
+public:
+  const vtkEdgeMergePointsTuple *Tuples;
+  vtkIdType NumberOfEdges;
+  vtkIdType ChunkSize;
+  vtkIdType *Representatives;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType first = chunk * this->ChunkSize;
+      vtkIdType last = std::min(this->NumberOfEdges, first + this->ChunkSize);
+      while ( first > 0 && first < last &&
+              this->Tuples[first].SameEdge(this->Tuples[first-1]) )
+        {
+        first++;
+        }
+      vtkIdType i = first;
+      while ( i < last )
+        {
+        vtkIdType rep = this->Tuples[i].Index;
+        vtkIdType j = i;
+        do
+          {
+          this->Representatives[this->Tuples[j].Index] = rep;
+          j++;
+          }
+        while ( j < this->NumberOfEdges &&
+                this->Tuples[j].SameEdge(this->Tuples[i]) );
+        i = j;
+        }
+      }
+    }
+};
+
+// Number the representatives in input order: count them per chunk, then
+// assign their ids from the chunk offsets.
+class vtkEdgeMergePointsCount
+{
+public:
+  const vtkIdType *Representatives;
+  vtkIdType NumberOfEdges;
+  vtkIdType ChunkSize;
+  vtkIdType *Counts;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType first = chunk * this->ChunkSize;
+      vtkIdType last = std::min(this->NumberOfEdges, first + this->ChunkSize);
+      vtkIdType count = 0;
+      for (vtkIdType i = first; i < last; i++)
+        {
+        count += (this->Representatives[i] == i);
+        }
+      this->Counts[chunk] = count;
+      }
+    }
+};
+
+class vtkEdgeMergePointsNumber
+{
+public:
+  const vtkIdType *Edges;
+  const vtkIdType *Representatives;
+  vtkIdType NumberOfEdges;
+  vtkIdType ChunkSize;
+  const vtkIdType *Offsets;
+  vtkIdType *PointMap;
+  vtkIdType *UniqueEdges;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType first = chunk * this->ChunkSize;
+      vtkIdType last = std::min(this->NumberOfEdges, first + this->ChunkSize);
+      vtkIdType id = this->Offsets[chunk];
+      for (vtkIdType i = first; i < last; i++)
+        {
+        if ( this->Representatives[i] == i )
+          {
+          if ( this->UniqueEdges )
+            {
+            vtkIdType v0 = this->Edges[2*i], v1 = this->Edges[2*i+1];
+            this->UniqueEdges[2*id] = std::min(v0, v1);
+            this->UniqueEdges[2*id+1] = std::max(v0, v1);
+            }
+          this->PointMap[i] = id++;
+          }
+        }
+      }
+    }
+};
+
+class vtkEdgeMergePointsMap
+{
+public:
+  const vtkIdType *Representatives;
+  vtkIdType *PointMap;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      if ( this->Representatives[i] != i )
+        {
+        this->PointMap[i] = this->PointMap[this->Representatives[i]];
+        }
+      }
+    }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkEdgeMergePoints::vtkEdgeMergePoints()
+{
+  this->EdgeTable = NULL;
+  this->EdgeParameters = NULL;
+  this->EdgeTableSize = 0;
+  this->NumberOfEdgePoints = 0;
+  for (int i = 0; i < 6; i++)
+    {
+    this->InsertionBounds[i] = 0.0;
+    }
+  this->EstimatedNumberOfPoints = 0;
+  this->BinsInitialized = 0;
+  this->EdgeMerging = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkEdgeMergePoints::~vtkEdgeMergePoints()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgeMergePoints::FreeSearchStructure()
+{
+  delete [] this->EdgeTable;
+  this->EdgeTable = NULL;
+  delete [] this->EdgeParameters;
+  this->EdgeParameters = NULL;
+  this->EdgeTableSize = 0;
+  this->NumberOfEdgePoints = 0;
+  this->BinsInitialized = 0;
+  this->Superclass::FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgeMergePoints::InitPointInsertion(vtkPoints *newPts,
+                                           const double bounds[6])
+{
+  return this->InitPointInsertion(newPts, bounds, 0);
+}
+
+//----------------------------------------------------------------------------
+// The spatial bins are only allocated if points are inserted by their
+// coordinates.
+int vtkEdgeMergePoints::InitPointInsertion(vtkPoints *newPts,
+                                           const double bounds[6],
+                                           vtkIdType estNumPts)
+{
+  this->FreeSearchStructure();
+  if ( newPts == NULL )
+    {
+    vtkErrorMacro(<<"Must define points for point insertion");
+    return 0;
+    }
+  if ( this->Points != NULL )
+    {
+    this->Points->UnRegister(this);
+    }
+  this->Points = newPts;
+  this->Points->Register(this);
+  this->InsertionPointId = 0;
+
+  for (int i = 0; i < 6; i++)
+    {
+    this->InsertionBounds[i] = bounds[i];
+    }
+  this->EstimatedNumberOfPoints = estNumPts;
+  this->ResizeEdgeTable(estNumPts);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgeMergePoints::InitializeBins()
+{
+  if ( this->BinsInitialized || !this->Points )
+    {
+    return;
+    }
+  vtkIdType insertionPointId = this->InsertionPointId;
+  this->Superclass::InitPointInsertion(this->Points, this->InsertionBounds,
+                                       this->EstimatedNumberOfPoints);
+  this->InsertionPointId = insertionPointId;
+  this->BinsInitialized = 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgeMergePoints::ResizeEdgeTable(vtkIdType numEdges)
+{
+  vtkIdType size = 1024;
+  while ( size < 2 * numEdges )
+    {
+    size *= 2;
+    }
+  if ( size <= this->EdgeTableSize )
+    {
+    return;
+    }
+
+  vtkIdType *oldTable = this->EdgeTable;
+  double *oldParameters = this->EdgeParameters;
+  vtkIdType oldSize = this->EdgeTableSize;
+  this->EdgeTable = new vtkIdType[3 * size];
+  this->EdgeParameters = new double[size];
+  this->EdgeTableSize = size;
+  for (vtkIdType slot = 0; slot < size; slot++)
+    {
+    this->EdgeTable[3*slot+2] = -1;
+    }
+  for (vtkIdType slot = 0; slot < oldSize; slot++)
+    {
+    const vtkIdType *entry = oldTable + 3*slot;
+    if ( entry[2] >= 0 )
+      {
+      double t = oldParameters[slot];
+      vtkIdType newSlot = this->FindEdgeSlot(entry[0], entry[1], t);
+      std::copy(entry, entry + 3, this->EdgeTable + 3*newSlot);
+      this->EdgeParameters[newSlot] = t;
+      }
+    }
+  delete [] oldTable;
+  delete [] oldParameters;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgeMergePoints::FindEdgeSlot(vtkIdType v0, vtkIdType v1,
+                                           double t)
+{
+  vtkIdType mask = this->EdgeTableSize - 1;
+  vtkIdType slot = vtkEdgeMergePointsHash(v0, v1, t, mask);
+  const vtkIdType *entry = this->EdgeTable + 3*slot;
+  while ( entry[2] >= 0 && (entry[0] != v0 || entry[1] != v1 ||
+                            this->EdgeParameters[slot] != t) )
+    {
+    slot = (slot + 1) & mask;
+    entry = this->EdgeTable + 3*slot;
+    }
+  return slot;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgeMergePoints::IsInsertedEdgePoint(vtkIdType v0, vtkIdType v1,
+                                                  double t)
+{
+  if ( !this->EdgeTable )
+    {
+    return -1;
+    }
+  vtkEdgeMergePointsKey(v0, v1, t);
+  return this->EdgeTable[3*this->FindEdgeSlot(v0, v1, t) + 2];
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgeMergePoints::SuspendEdgeMerging(vtkIncrementalPointLocator *locator)
+{
+  vtkEdgeMergePoints *self = vtkEdgeMergePoints::SafeDownCast(locator);
+  if ( !self )
+    {
+    return 0;
+    }
+  int merging = self->EdgeMerging;
+  self->EdgeMerging = 0;
+  return merging;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgeMergePoints::ResumeEdgeMerging(vtkIncrementalPointLocator *locator,
+                                           int merging)
+{
+  vtkEdgeMergePoints *self = vtkEdgeMergePoints::SafeDownCast(locator);
+  if ( self )
+    {
+    self->EdgeMerging = merging;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgeMergePoints::InsertUniqueEdgePoint(vtkIdType v0, vtkIdType v1,
+                                              double t, const double x[3],
+                                              vtkIdType &ptId)
+{
+  if ( !this->EdgeMerging )
+    {
+    return this->InsertUniquePoint(x, ptId);
+    }
+  if ( 2 * (this->NumberOfEdgePoints + 1) > this->EdgeTableSize )
+    {
+    this->ResizeEdgeTable(this->NumberOfEdgePoints + 1);
+    }
+  vtkEdgeMergePointsKey(v0, v1, t);
+  vtkIdType slot = this->FindEdgeSlot(v0, v1, t);
+  vtkIdType *entry = this->EdgeTable + 3*slot;
+  if ( entry[2] >= 0 )
+    {
+    ptId = entry[2];
+    return 0;
+    }
+
+  this->Points->InsertPoint(this->InsertionPointId, x);
+  ptId = this->InsertionPointId++;
+  entry[0] = v0;
+  entry[1] = v1;
+  entry[2] = ptId;
+  this->EdgeParameters[slot] = t;
+  this->NumberOfEdgePoints++;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgeMergePoints::InsertUniquePoint(const double x[3], vtkIdType &ptId)
+{
+  this->InitializeBins();
+  return this->Superclass::InsertUniquePoint(x, ptId);
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgeMergePoints::InsertPoint(vtkIdType ptId, const double x[3])
+{
+  this->InitializeBins();
+  this->Superclass::InsertPoint(ptId, x);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgeMergePoints::InsertNextPoint(const double x[3])
+{
+  this->InitializeBins();
+  return this->Superclass::InsertNextPoint(x);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgeMergePoints::IsInsertedPoint(const double x[3])
+{
+  if ( !this->BinsInitialized )
+    {
+    return -1;
+    }
+  return this->Superclass::IsInsertedPoint(x);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgeMergePoints::IsInsertedPoint(double x, double y, double z)
+{
+  double xyz[3] = {x, y, z};
+  return this->IsInsertedPoint(xyz);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgeMergePoints::MergeEdges(vtkIdType numEdges,
+                                         const vtkIdType *edges,
+                                         vtkIdType *pointMap,
+                                         vtkIdTypeArray *uniqueEdges)
+{
+  if ( uniqueEdges )
+    {
+    uniqueEdges->SetNumberOfComponents(2);
+    uniqueEdges->SetNumberOfTuples(0);
+    }
+  if ( numEdges <= 0 )
+    {
+    return 0;
+    }
+
+  // Sort the edges, and find the representative of each run of equal
+  // edges.
+  std::vector<vtkEdgeMergePointsTuple> tuples(numEdges);
+  vtkEdgeMergePointsMakeTuples makeTuples;
+  makeTuples.Edges = edges;
+  makeTuples.Tuples = &tuples[0];
+  vtkSMPTools::For(0, numEdges, makeTuples);
+  vtkSMPTools::Sort(tuples.begin(), tuples.end());
+
+  vtkIdType numChunks = std::max(static_cast<vtkIdType>(1), std::min(
+    static_cast<vtkIdType>(4 * vtkSMPTools::GetEstimatedNumberOfThreads()),
+    numEdges / 4096));
+  vtkIdType chunkSize = (numEdges + numChunks - 1) / numChunks;
+  numChunks = (numEdges + chunkSize - 1) / chunkSize;
+
+  std::vector<vtkIdType> representatives(numEdges);
+  vtkEdgeMergePointsFindRepresentatives find;
+  find.Tuples = &tuples[0];
+  find.NumberOfEdges = numEdges;
+  find.ChunkSize = chunkSize;
+  find.Representatives = &representatives[0];
+  vtkSMPTools::For(0, numChunks, 1, find);
+  std::vector<vtkEdgeMergePointsTuple>().swap(tuples);
+
+  // Number the representatives in input order.
+  std::vector<vtkIdType> offsets(numChunks);
+  vtkEdgeMergePointsCount count;
+  count.Representatives = &representatives[0];
+  count.NumberOfEdges = numEdges;
+  count.ChunkSize = chunkSize;
+  count.Counts = &offsets[0];
+  vtkSMPTools::For(0, numChunks, 1, count);
+  vtkIdType numUnique = 0;
+  for (vtkIdType chunk = 0; chunk < numChunks; chunk++)
+    {
+    vtkIdType chunkCount = offsets[chunk];
+    offsets[chunk] = numUnique;
+    numUnique += chunkCount;
+    }
+
+  vtkEdgeMergePointsNumber number;
+  number.Edges = edges;
+  number.Representatives = &representatives[0];
+  number.NumberOfEdges = numEdges;
+  number.ChunkSize = chunkSize;
+  number.Offsets = &offsets[0];
+  number.PointMap = pointMap;
+  number.UniqueEdges = NULL;
+  if ( uniqueEdges )
+    {
+    uniqueEdges->SetNumberOfTuples(numUnique);
+    number.UniqueEdges = uniqueEdges->GetPointer(0);
+    }
+  vtkSMPTools::For(0, numChunks, 1, number);
+
+  vtkEdgeMergePointsMap map;
+  map.Representatives = &representatives[0];
+  map.PointMap = pointMap;
+  vtkSMPTools::For(0, numEdges, map);
+
+  return numUnique;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgeMergePoints::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Edge Points: " << this->NumberOfEdgePoints
+     << "\n";
+  os << indent << "Edge Table Size: " << this->EdgeTableSize << "\n";
+  os << indent << "Edge Merging: " << (this->EdgeMerging ? "On\n" : "Off\n");
+}
@@ -0,0 +1,154 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkEdgeMergePoints.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkEdgeMergePoints - merge points by the input mesh edge they lie on
+// .SECTION Description
+// vtkEdgeMergePoints is a point locator for filters that generate points on
+// the edges of the cells of their input, such as contouring, cutting and
+// clipping filters. The points are identified by the edge (v0, v1) of the
+// input mesh they are interpolated on and their parametric coordinate t on
+// that edge, or by the input vertex they lie on, rather than by their
+// coordinates: two points are merged when they lie on the same edge at the
+// same parameter (e.g., for the same contour value), which is an exact
+// comparison that requires neither bounds, tolerance nor spatial search.
+//
+// The cells pass the edge of the points they generate through
+// InsertUniqueEdgePoint(), which looks the edge up in a hash table. Points
+// are numbered in insertion order, and the point data of the first point
+// inserted on an edge is kept, as with vtkMergePoints, so filters produce
+// the same output with either locator when the input has no coincident
+// points. Points inserted with InsertUniquePoint(), by the cells that do
+// not report edges or that report local point ids (see
+// SuspendEdgeMerging()), are merged by their coordinates as vtkMergePoints
+// does; the spatial bins are then allocated on first use.
+//
+// MergeEdges() is the parallel counterpart for threaded filters that first
+// generate their points independently: it sorts a batch of edge tuples with
+// vtkSMPTools and numbers the distinct edges in parallel.
+//
+// .SECTION Caveats
+// Coincident input points, and points of different edges at the same
+// location (e.g., in non-conforming meshes), are not merged. Points
+// inserted by edge and by coordinates are not merged with each other. The
+// cells must compute t consistently for a given edge, as the VTK cells do
+// by orienting their edges from the smaller scalar to the larger one.
+//
+// .SECTION See Also
+// vtkMergePoints vtkIncrementalPointLocator vtkEdgeTable vtkSMPTools
+
+#ifndef __vtkEdgeMergePoints_h
+#define __vtkEdgeMergePoints_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkMergePoints.h"
+
+class vtkIdTypeArray;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkEdgeMergePoints : public vtkMergePoints
+{
+public:
+  static vtkEdgeMergePoints *New();
+  vtkTypeMacro(vtkEdgeMergePoints,vtkMergePoints);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Initialize the point insertion process. The bounds are only used if
+  // points are inserted by their coordinates.
+  virtual int InitPointInsertion(vtkPoints *newPts, const double bounds[6]);
+  virtual int InitPointInsertion(vtkPoints *newPts, const double bounds[6],
+                                 vtkIdType estNumPts);
+
+  // Description:
+  // Insert the point x lying at parameter t on the edge (v0,v1) of the input
+  // mesh unless a point was inserted on that edge at that parameter before;
+  // (v1,v0) at 1 - t is the same point. t = 0 and t = 1 (or v0 == v1)
+  // designate an input vertex. Return 1 if the point was
+  // inserted, 0 otherwise; the id of the point is returned in ptId.
+  virtual int InsertUniqueEdgePoint(vtkIdType v0, vtkIdType v1, double t,
+                                    const double x[3], vtkIdType &ptId);
+
+  // Description:
+  // Return the id of the point inserted on the edge (v0,v1) at parameter t,
+  // or -1 if there is none.
+  vtkIdType IsInsertedEdgePoint(vtkIdType v0, vtkIdType v1, double t);
+
+  // Description:
+  // Suspend the merging of points by edge on locator, if it is a
+  // vtkEdgeMergePoints, and return whether it was on; InsertUniqueEdgePoint()
+  // then merges points by their coordinates. This is for cells that contour
+  // or clip their subdivision in terms of local point ids, such as
+  // vtkQuadraticHexahedron. ResumeEdgeMerging() restores the returned state.
+  // The locator is not modified.
+  static int SuspendEdgeMerging(vtkIncrementalPointLocator *locator);
+  static void ResumeEdgeMerging(vtkIncrementalPointLocator *locator,
+                                int merging);
+
+  // Description:
+  // Insertion of points by their coordinates, merged as by vtkMergePoints.
+  virtual int InsertUniquePoint(const double x[3], vtkIdType &ptId);
+  virtual void InsertPoint(vtkIdType ptId, const double x[3]);
+  virtual vtkIdType InsertNextPoint(const double x[3]);
+  virtual vtkIdType IsInsertedPoint(const double x[3]);
+  virtual vtkIdType IsInsertedPoint(double x, double y, double z);
+
+  // Description:
+  // Free the edge table and the spatial bins.
+  virtual void FreeSearchStructure();
+
+  // Description:
+  // Merge numEdges edges given as pairs of point ids (edges[2*i],
+  // edges[2*i+1]), in either order; a pair of equal ids designates a
+  // vertex. Unlike InsertUniqueEdgePoint(), only the edges are compared,
+  // so the points must come from a single contour value. pointMap[i]
+  // receives the id of the distinct edge of edge i, distinct edges being
+  // numbered in order of first occurrence. If uniqueEdges is given, it
+  // receives the distinct edges as 2-component tuples (smaller id first).
+  // Return the number of distinct edges. The edges are sorted and numbered
+  // in parallel with vtkSMPTools.
+  static vtkIdType MergeEdges(vtkIdType numEdges, const vtkIdType *edges,
+                              vtkIdType *pointMap,
+                              vtkIdTypeArray *uniqueEdges = NULL);
+
+protected:
+  vtkEdgeMergePoints();
+  ~vtkEdgeMergePoints();
+
+  // Allocate the spatial bins of vtkPointLocator on first use.
+  void InitializeBins();
+
+  // Grow the edge table to hold at least numEdges edges.
+  void ResizeEdgeTable(vtkIdType numEdges);
+
+  // Slot of the edge point (v0,v1,t) in the edge table: either the slot
+  // holding it, or the empty slot where it should be inserted.
+  vtkIdType FindEdgeSlot(vtkIdType v0, vtkIdType v1, double t);
+
+  // Open addressing hash table of the edge points: three ids (v0, v1, point
+  // id) and a parameter t per slot, a point id of -1 marking an empty slot.
+  vtkIdType *EdgeTable;
+  double *EdgeParameters;
+  vtkIdType EdgeTableSize;
+  vtkIdType NumberOfEdgePoints;
+
+  double InsertionBounds[6];
+  vtkIdType EstimatedNumberOfPoints;
+  int BinsInitialized;
+  int EdgeMerging;
+
+private:
+  vtkEdgeMergePoints(const vtkEdgeMergePoints&);  // Not implemented.
+  void operator=(const vtkEdgeMergePoints&);  // Not implemented.
+};
+
+#endif
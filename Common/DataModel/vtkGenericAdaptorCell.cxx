@@ -17,6 +17,7 @@
 #include <assert.h>
 
 #include "vtkPoints.h"
+#include "vtkEdgeMergePoints.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
@@ -386,9 +387,13 @@ void vtkGenericAdaptorCell::Contour(vtkContourValues *contourValues,
       {
       if(values[vv] >= range[0] && values[vv] <= range[1])
         {
+        // The linear cell is defined in terms of local point ids: merge its
+        // points by coordinates.
+        int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
         linearCell->Contour(values[vv],this->Scalars,locator,verts,lines,
                             polys,secondaryPd, outPd, secondaryCd,
                             0, outCd);
+        vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
         }
       }
 
@@ -469,9 +474,13 @@ void vtkGenericAdaptorCell::Contour(vtkContourValues *contourValues,
       {
       if(values[vv] >= range[0] && values[vv] <= range[1])
         {
+        // The linear cell is defined in terms of local point ids: merge its
+        // points by coordinates.
+        int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
         linearCell->Contour(values[vv],this->Scalars,locator,verts,lines,
                             polys,secondaryPd, outPd, secondaryCd,
                             0, outCd);
+        vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
         }
       }
     }
@@ -616,9 +625,13 @@ void vtkGenericAdaptorCell::Clip(double value,
       locals=locals+3;
       }
 
+    // The linear cell is defined in terms of local point ids: merge its
+    // points by coordinates.
+    int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
     linearCell->Clip(value,this->Scalars,locator,connectivity,
                      secondaryPd, outPd, secondaryCd, 0, outCd,
                      insideOut);
+    vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
     return;
     }
 
@@ -687,9 +700,13 @@ void vtkGenericAdaptorCell::Clip(double value,
       ++dataIndex;
 
       }
+    // The linear cell is defined in terms of local point ids: merge its
+    // points by coordinates.
+    int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
     linearCell->Clip(value,this->Scalars,locator,connectivity,
                      secondaryPd, outPd, secondaryCd, 0, outCd,
                      insideOut);
+    vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
     }
 }
 
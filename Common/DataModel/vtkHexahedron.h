@@ -97,6 +97,13 @@ public:
   static int *GetEdgeArray(int edgeId);
   static int *GetFaceArray(int faceId);
 
+  // Description:
+  // Return the case table used by Contour() for case caseId (0 <= caseId <
+  // 256, bit i set when the scalar of vertex i is at or above the contour
+  // value). The entries are edge ids (see GetEdgeArray()), three per
+  // triangle, terminated by -1.
+  static int *GetTriangleCases(int caseId);
+
   // Description:
   // Given parametric coordinates compute inverse Jacobian transformation
   // matrix. Returns 9 elements of 3x3 inverse Jacobian plus interpolation
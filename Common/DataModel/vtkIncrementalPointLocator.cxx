@@ -25,6 +25,13 @@ vtkIncrementalPointLocator::~vtkIncrementalPointLocator()
 {
 }
 
+int vtkIncrementalPointLocator::InsertUniqueEdgePoint( vtkIdType vtkNotUsed( v0 ),
+  vtkIdType vtkNotUsed( v1 ), double vtkNotUsed( t ), const double x[3],
+  vtkIdType & ptId )
+{
+  return this->InsertUniquePoint( x, ptId );
+}
+
 void vtkIncrementalPointLocator::PrintSelf( ostream & os, vtkIndent indent )
 {
   this->Superclass::PrintSelf( os, indent );
@@ -107,6 +107,18 @@ public:
   // This method is not thread safe.
   virtual int InsertUniquePoint( const double x[3], vtkIdType & ptId ) = 0;
 
+  // Description:
+  // Insert the point x lying at parameter t on the edge (v0, v1) of the input
+  // mesh, i.e., x = x(v0) + t * (x(v1) - x(v0)), unless a duplicate has been
+  // inserted. t = 0 and t = 1 designate the vertices v0 and v1 themselves,
+  // as does v0 == v1. Cells call this method instead of InsertUniquePoint()
+  // for the points they generate on their edges and vertices, so that a
+  // locator such as vtkEdgeMergePoints may merge points by edge rather than
+  // by coordinates. By default, the point is merged by its coordinates with
+  // InsertUniquePoint(). This method is not thread safe.
+  virtual int InsertUniqueEdgePoint( vtkIdType v0, vtkIdType v1, double t,
+                                     const double x[3], vtkIdType & ptId );
+
   // Description:
   // Insert a given point with a specified point index ptId. InitPointInsertion()
   // should have been called prior to this function. Also, IsInsertedPoint()
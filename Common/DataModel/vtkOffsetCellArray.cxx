@@ -0,0 +1,728 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOffsetCellArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkOffsetCellArray.h"
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+vtkStandardNewMacro(vtkOffsetCellArray);
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Copy the values of an integer array into a storage array of another type.
+template <class TIn, class TOutArray, class TOut>
+void vtkOffsetCellArrayCopy(const TIn *in, vtkIdType num, TOutArray *out,
+                            TOut *)
+{
+  TOut *ptr = out->WritePointer(0, num);
+  for (vtkIdType i = 0; i < num; i++)
+    {
+    ptr[i] = static_cast<TOut>(in[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class TOutArray, class TOut>
+bool vtkOffsetCellArrayCopyArray(vtkDataArray *in, TOutArray *out, TOut *t)
+{
+  vtkIdType num = in->GetNumberOfTuples();
+  void *data = in->GetVoidPointer(0);
+  switch (in->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkOffsetCellArrayCopy(static_cast<VTK_TT*>(data), num, out, t));
+    default:
+      return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Scan the offsets and connectivity for the largest value.
+template <class T>
+vtkIdType vtkOffsetCellArrayMaxValue(const T *conn, vtkIdType num)
+{
+  vtkIdType maxValue = 0;
+  for (vtkIdType i = 0; i < num; i++)
+    {
+    if (static_cast<vtkIdType>(conn[i]) > maxValue)
+      {
+      maxValue = static_cast<vtkIdType>(conn[i]);
+      }
+    }
+  return maxValue;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkOffsetCellArrayMaxCellSize(const T *offsets, vtkIdType numCells)
+{
+  vtkIdType maxSize = 0;
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    if (offsets[i+1] - offsets[i] > maxSize)
+      {
+      maxSize = static_cast<vtkIdType>(offsets[i+1] - offsets[i]);
+      }
+    }
+  return static_cast<int>(maxSize);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkOffsetCellArrayReverse(T *pts, vtkIdType npts)
+{
+  for (vtkIdType i = 0; i < npts / 2; i++)
+    {
+    T tmp = pts[i];
+    pts[i] = pts[npts-i-1];
+    pts[npts-i-1] = tmp;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Convert a range of cells to the legacy layout. Cell i starts at
+// offsets[i] + i in the legacy list (one count entry per preceding cell).
+template <class T>
+class vtkOffsetCellArrayExport
+{
+public:
+  const T *Offsets;
+  const T *Connectivity;
+  vtkIdType *Legacy;
+
+  vtkOffsetCellArrayExport(const T *offsets, const T *conn,
+                           vtkIdType *legacy)
+    : Offsets(offsets), Connectivity(conn), Legacy(legacy) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      vtkIdType first = static_cast<vtkIdType>(this->Offsets[cellId]);
+      vtkIdType last = static_cast<vtkIdType>(this->Offsets[cellId+1]);
+      vtkIdType *out = this->Legacy + first + cellId;
+      *out++ = last - first;
+      for (vtkIdType i = first; i < last; i++)
+        {
+        *out++ = static_cast<vtkIdType>(this->Connectivity[i]);
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+template <class TArray, class T>
+void vtkOffsetCellArrayImport(const vtkIdType *data, vtkIdType len,
+                              TArray *offsets, TArray *connectivity, T *)
+{
+  // First pass to size both arrays exactly.
+  vtkIdType numCells = 0;
+  vtkIdType loc;
+  for (loc = 0; loc < len; loc += data[loc] + 1)
+    {
+    numCells++;
+    }
+  T *off = offsets->WritePointer(0, numCells + 1);
+  T *conn = connectivity->WritePointer(0, len - numCells);
+
+  vtkIdType connLoc = 0;
+  loc = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    vtkIdType npts = data[loc++];
+    off[cellId] = static_cast<T>(connLoc);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      conn[connLoc++] = static_cast<T>(data[loc++]);
+      }
+    }
+  off[numCells] = static_cast<T>(connLoc);
+}
+
+//----------------------------------------------------------------------------
+// Check that an offsets array starts at 0, never decreases and ends at the
+// size of the connectivity.
+template <class T>
+bool vtkOffsetCellArrayValidOffsets(const T *offsets, vtkIdType num,
+                                    vtkIdType connSize)
+{
+  if (num < 1 || offsets[0] != 0 ||
+      static_cast<vtkIdType>(offsets[num-1]) != connSize)
+    {
+    return false;
+    }
+  for (vtkIdType i = 1; i < num; i++)
+    {
+    if (offsets[i] < offsets[i-1])
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkOffsetCellArrayIsIntegerArray(vtkDataArray *array)
+{
+  if (!array || array->GetNumberOfComponents() != 1)
+    {
+    return false;
+    }
+  switch (array->GetDataType())
+    {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+    case VTK_ID_TYPE:
+#if defined(VTK_TYPE_USE_LONG_LONG)
+    case VTK_LONG_LONG:
+    case VTK_UNSIGNED_LONG_LONG:
+#endif
+#if defined(VTK_TYPE_USE___INT64)
+    case VTK___INT64:
+    case VTK_UNSIGNED___INT64:
+#endif
+      return true;
+    default:
+      return false;
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+vtkOffsetCellArray::vtkOffsetCellArray()
+{
+  this->Offsets32 = NULL;
+  this->Connectivity32 = NULL;
+  this->Offsets64 = NULL;
+  this->Connectivity64 = NULL;
+#ifdef VTK_USE_64BIT_IDS
+  this->ResetStorage(true);
+#else
+  this->ResetStorage(false);
+#endif
+}
+
+//----------------------------------------------------------------------------
+vtkOffsetCellArray::~vtkOffsetCellArray()
+{
+  if (this->Offsets32)
+    {
+    this->Offsets32->Delete();
+    this->Connectivity32->Delete();
+    }
+  if (this->Offsets64)
+    {
+    this->Offsets64->Delete();
+    this->Connectivity64->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::ResetStorage(bool storage64Bit)
+{
+  if (this->Offsets32)
+    {
+    this->Offsets32->Delete();
+    this->Connectivity32->Delete();
+    this->Offsets32 = NULL;
+    this->Connectivity32 = NULL;
+    }
+  if (this->Offsets64)
+    {
+    this->Offsets64->Delete();
+    this->Connectivity64->Delete();
+    this->Offsets64 = NULL;
+    this->Connectivity64 = NULL;
+    }
+
+  this->Storage64Bit = storage64Bit;
+  if (storage64Bit)
+    {
+    this->Offsets64 = ArrayType64::New();
+    this->Connectivity64 = ArrayType64::New();
+    this->Offsets64->InsertNextValue(0);
+    }
+  else
+    {
+    this->Offsets32 = ArrayType32::New();
+    this->Connectivity32 = ArrayType32::New();
+    this->Offsets32->InsertNextValue(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::Use32BitStorage()
+{
+  this->ResetStorage(false);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::Use64BitStorage()
+{
+  this->ResetStorage(true);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::UseDefaultStorage()
+{
+#ifdef VTK_USE_64BIT_IDS
+  this->Use64BitStorage();
+#else
+  this->Use32BitStorage();
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkOffsetCellArray::CanConvertTo32BitStorage()
+{
+  if (!this->Storage64Bit)
+    {
+    return true;
+    }
+  vtkIdType connSize = this->GetNumberOfConnectivityIds();
+  if (connSize > VTK_INT_MAX)
+    {
+    return false;
+    }
+  return vtkOffsetCellArrayMaxValue(this->Connectivity64->GetPointer(0),
+                                    connSize) <= VTK_INT_MAX;
+}
+
+//----------------------------------------------------------------------------
+bool vtkOffsetCellArray::ConvertTo32BitStorage()
+{
+  if (!this->Storage64Bit)
+    {
+    return true;
+    }
+  if (!this->CanConvertTo32BitStorage())
+    {
+    return false;
+    }
+
+  ArrayType32 *offsets = ArrayType32::New();
+  ArrayType32 *conn = ArrayType32::New();
+  vtkOffsetCellArrayCopy(this->Offsets64->GetPointer(0),
+                         this->GetNumberOfOffsets(), offsets,
+                         static_cast<ValueType32*>(NULL));
+  vtkOffsetCellArrayCopy(this->Connectivity64->GetPointer(0),
+                         this->GetNumberOfConnectivityIds(), conn,
+                         static_cast<ValueType32*>(NULL));
+  this->ResetStorage(false);
+  this->Offsets32->Delete();
+  this->Connectivity32->Delete();
+  this->Offsets32 = offsets;
+  this->Connectivity32 = conn;
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkOffsetCellArray::ConvertTo64BitStorage()
+{
+  if (this->Storage64Bit)
+    {
+    return true;
+    }
+
+  ArrayType64 *offsets = ArrayType64::New();
+  ArrayType64 *conn = ArrayType64::New();
+  vtkOffsetCellArrayCopy(this->Offsets32->GetPointer(0),
+                         this->GetNumberOfOffsets(), offsets,
+                         static_cast<ValueType64*>(NULL));
+  vtkOffsetCellArrayCopy(this->Connectivity32->GetPointer(0),
+                         this->GetNumberOfConnectivityIds(), conn,
+                         static_cast<ValueType64*>(NULL));
+  this->ResetStorage(true);
+  this->Offsets64->Delete();
+  this->Connectivity64->Delete();
+  this->Offsets64 = offsets;
+  this->Connectivity64 = conn;
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkOffsetCellArray::ConvertToSmallestStorage()
+{
+  if (this->CanConvertTo32BitStorage())
+    {
+    return this->ConvertTo32BitStorage();
+    }
+  return this->ConvertTo64BitStorage();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::Initialize()
+{
+  this->ResetStorage(this->Storage64Bit);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::Reset()
+{
+  if (this->Storage64Bit)
+    {
+    this->Offsets64->Reset();
+    this->Connectivity64->Reset();
+    this->Offsets64->InsertNextValue(0);
+    }
+  else
+    {
+    this->Offsets32->Reset();
+    this->Connectivity32->Reset();
+    this->Offsets32->InsertNextValue(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::Squeeze()
+{
+  this->GetOffsetsArray()->Squeeze();
+  this->GetConnectivityArray()->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+bool vtkOffsetCellArray::Allocate(vtkIdType numCells,
+                                  vtkIdType connectivitySize)
+{
+  this->ResetStorage(this->Storage64Bit);
+  vtkDataArray *offsets = this->GetOffsetsArray();
+  vtkDataArray *conn = this->GetConnectivityArray();
+  if (!offsets->Allocate(numCells + 1) ||
+      !conn->Allocate(connectivitySize))
+    {
+    this->ResetStorage(this->Storage64Bit);
+    return false;
+    }
+  // Allocate() resets the arrays, restore the leading offset.
+  offsets->InsertTuple1(0, 0);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray *vtkOffsetCellArray::GetOffsetsArray()
+{
+  if (this->Storage64Bit)
+    {
+    return this->Offsets64;
+    }
+  return this->Offsets32;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray *vtkOffsetCellArray::GetConnectivityArray()
+{
+  if (this->Storage64Bit)
+    {
+    return this->Connectivity64;
+    }
+  return this->Connectivity32;
+}
+
+//----------------------------------------------------------------------------
+bool vtkOffsetCellArray::SetData(vtkDataArray *offsets,
+                                 vtkDataArray *connectivity)
+{
+  if (!vtkOffsetCellArrayIsIntegerArray(offsets) ||
+      !vtkOffsetCellArrayIsIntegerArray(connectivity))
+    {
+    vtkErrorMacro("Offsets and connectivity must be single component "
+                  "integer arrays.");
+    return false;
+    }
+
+  bool storage64Bit = offsets->GetDataTypeSize() > 4 ||
+    connectivity->GetDataTypeSize() > 4;
+  vtkIdType connSize = connectivity->GetNumberOfTuples();
+  if (!storage64Bit && connSize > VTK_INT_MAX)
+    {
+    storage64Bit = true;
+    }
+
+  // Share the arrays when they already are of the storage class.
+  ArrayType32 *offsets32 = NULL;
+  ArrayType32 *conn32 = NULL;
+  ArrayType64 *offsets64 = NULL;
+  ArrayType64 *conn64 = NULL;
+  if (storage64Bit)
+    {
+    offsets64 = ArrayType64::SafeDownCast(offsets);
+    conn64 = ArrayType64::SafeDownCast(connectivity);
+    if (offsets64 && conn64)
+      {
+      offsets64->Register(this);
+      conn64->Register(this);
+      }
+    else
+      {
+      offsets64 = ArrayType64::New();
+      conn64 = ArrayType64::New();
+      vtkOffsetCellArrayCopyArray(offsets, offsets64,
+                                  static_cast<ValueType64*>(NULL));
+      vtkOffsetCellArrayCopyArray(connectivity, conn64,
+                                  static_cast<ValueType64*>(NULL));
+      }
+    if (!vtkOffsetCellArrayValidOffsets(offsets64->GetPointer(0),
+                                        offsets64->GetNumberOfTuples(),
+                                        connSize))
+      {
+      offsets64->UnRegister(this);
+      conn64->UnRegister(this);
+      vtkErrorMacro("Offsets are not consistent with the connectivity.");
+      return false;
+      }
+    }
+  else
+    {
+    offsets32 = ArrayType32::SafeDownCast(offsets);
+    conn32 = ArrayType32::SafeDownCast(connectivity);
+    if (offsets32 && conn32)
+      {
+      offsets32->Register(this);
+      conn32->Register(this);
+      }
+    else
+      {
+      offsets32 = ArrayType32::New();
+      conn32 = ArrayType32::New();
+      vtkOffsetCellArrayCopyArray(offsets, offsets32,
+                                  static_cast<ValueType32*>(NULL));
+      vtkOffsetCellArrayCopyArray(connectivity, conn32,
+                                  static_cast<ValueType32*>(NULL));
+      }
+    if (!vtkOffsetCellArrayValidOffsets(offsets32->GetPointer(0),
+                                        offsets32->GetNumberOfTuples(),
+                                        connSize))
+      {
+      offsets32->UnRegister(this);
+      conn32->UnRegister(this);
+      vtkErrorMacro("Offsets are not consistent with the connectivity.");
+      return false;
+      }
+    }
+
+  this->ResetStorage(storage64Bit);
+  if (storage64Bit)
+    {
+    this->Offsets64->Delete();
+    this->Connectivity64->Delete();
+    this->Offsets64 = offsets64;
+    this->Connectivity64 = conn64;
+    }
+  else
+    {
+    this->Offsets32->Delete();
+    this->Connectivity32->Delete();
+    this->Offsets32 = offsets32;
+    this->Connectivity32 = conn32;
+    }
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkOffsetCellArray::InsertNextCell(vtkCell *cell)
+{
+  return this->InsertNextCell(cell->GetNumberOfPoints(),
+                              cell->PointIds->GetPointer(0));
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *pts)
+{
+  vtkIdType npts;
+  const vtkIdType *ptIds;
+  this->GetCellAtId(cellId, npts, ptIds, pts);
+  if (ptIds != pts->GetPointer(0))
+    {
+    pts->SetNumberOfIds(npts);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      pts->SetId(i, ptIds[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::ReplaceCellAtId(vtkIdType cellId,
+                                         const vtkIdType *pts)
+{
+  vtkIdType npts = this->GetCellSize(cellId);
+  if (this->Storage64Bit)
+    {
+    ValueType64 *conn = this->Connectivity64->GetPointer(
+      static_cast<vtkIdType>(this->Offsets64->GetValue(cellId)));
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      conn[i] = static_cast<ValueType64>(pts[i]);
+      }
+    }
+  else
+    {
+    ValueType32 *conn = this->Connectivity32->GetPointer(
+      static_cast<vtkIdType>(this->Offsets32->GetValue(cellId)));
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      conn[i] = static_cast<ValueType32>(pts[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::ReverseCellAtId(vtkIdType cellId)
+{
+  vtkIdType npts = this->GetCellSize(cellId);
+  if (this->Storage64Bit)
+    {
+    vtkOffsetCellArrayReverse(this->Connectivity64->GetPointer(
+      static_cast<vtkIdType>(this->Offsets64->GetValue(cellId))), npts);
+    }
+  else
+    {
+    vtkOffsetCellArrayReverse(this->Connectivity32->GetPointer(
+      static_cast<vtkIdType>(this->Offsets32->GetValue(cellId))), npts);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkOffsetCellArray::GetMaxCellSize()
+{
+  if (this->Storage64Bit)
+    {
+    return vtkOffsetCellArrayMaxCellSize(this->Offsets64->GetPointer(0),
+                                         this->GetNumberOfCells());
+    }
+  return vtkOffsetCellArrayMaxCellSize(this->Offsets32->GetPointer(0),
+                                       this->GetNumberOfCells());
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::ImportLegacyFormat(vtkCellArray *cells)
+{
+  if (!cells)
+    {
+    return;
+    }
+  this->ImportLegacyFormat(cells->GetPointer(),
+                           cells->GetNumberOfConnectivityEntries());
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::ImportLegacyFormat(const vtkIdType *data,
+                                            vtkIdType len)
+{
+  // The connectivity size must be addressable with the storage width.
+  this->ResetStorage(this->Storage64Bit || len > VTK_INT_MAX);
+  if (this->Storage64Bit)
+    {
+    vtkOffsetCellArrayImport(data, len, this->Offsets64,
+                             this->Connectivity64,
+                             static_cast<ValueType64*>(NULL));
+    }
+  else
+    {
+    vtkOffsetCellArrayImport(data, len, this->Offsets32,
+                             this->Connectivity32,
+                             static_cast<ValueType32*>(NULL));
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::ExportLegacyFormat(vtkCellArray *cells)
+{
+  if (!cells)
+    {
+    return;
+    }
+  vtkIdType numCells = this->GetNumberOfCells();
+  vtkIdType *legacy = cells->WritePointer(
+    numCells, this->GetNumberOfConnectivityIds() + numCells);
+  if (this->Storage64Bit)
+    {
+    vtkOffsetCellArrayExport<ValueType64> exporter(
+      this->Offsets64->GetPointer(0), this->Connectivity64->GetPointer(0),
+      legacy);
+    vtkSMPTools::For(0, numCells, exporter);
+    }
+  else
+    {
+    vtkOffsetCellArrayExport<ValueType32> exporter(
+      this->Offsets32->GetPointer(0), this->Connectivity32->GetPointer(0),
+      legacy);
+    vtkSMPTools::For(0, numCells, exporter);
+    }
+  cells->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::DeepCopy(vtkOffsetCellArray *ca)
+{
+  // Do nothing on a NULL input.
+  if (ca == NULL || ca == this)
+    {
+    return;
+    }
+
+  this->ResetStorage(ca->Storage64Bit);
+  this->GetOffsetsArray()->DeepCopy(ca->GetOffsetsArray());
+  this->GetConnectivityArray()->DeepCopy(ca->GetConnectivityArray());
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::ShallowCopy(vtkOffsetCellArray *ca)
+{
+  if (ca == NULL || ca == this)
+    {
+    return;
+    }
+
+  this->SetData(ca->GetOffsetsArray(), ca->GetConnectivityArray());
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkOffsetCellArray::GetActualMemorySize()
+{
+  return this->GetOffsetsArray()->GetActualMemorySize() +
+    this->GetConnectivityArray()->GetActualMemorySize();
+}
+
+//----------------------------------------------------------------------------
+void vtkOffsetCellArray::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Storage: " << (this->Storage64Bit ? "64" : "32")
+     << " bit" << endl;
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << endl;
+  os << indent << "Number Of Connectivity Ids: "
+     << this->GetNumberOfConnectivityIds() << endl;
+}
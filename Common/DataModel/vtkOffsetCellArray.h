@@ -0,0 +1,367 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOffsetCellArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkOffsetCellArray - cell connectivity stored as offsets and ids
+// .SECTION Description
+// vtkOffsetCellArray represents cell connectivity with two arrays instead
+// of the single interleaved (n,id1,id2,...,idn, ...) list used by
+// vtkCellArray. The connectivity array holds the point ids of all cells
+// back to back, and the offsets array holds, for each cell, the index of
+// its first point id in the connectivity array. The offsets array has one
+// more entry than there are cells; the last entry is the total size of the
+// connectivity array, so that the number of points of cell i is
+// offsets[i+1] - offsets[i].
+//
+// With this layout any cell can be reached in constant time through
+// GetCellAtId() without building a separate locations array, and since
+// GetCellAtId() does not modify the object (there is no traversal
+// position), it may be called concurrently from several threads, e.g.
+// from a vtkSMPTools functor.
+//
+// Both arrays use either 32-bit or 64-bit integer storage, selected at run
+// time with Use32BitStorage()/Use64BitStorage() or converted afterwards with
+// ConvertTo32BitStorage()/ConvertToSmallestStorage(). 32-bit storage halves
+// the memory of meshes with less than 2^31 connectivity entries. When the
+// storage width matches vtkIdType, GetCellAtId() returns a pointer directly
+// into the connectivity array; otherwise the ids are copied into a caller
+// supplied vtkIdList.
+//
+// ImportLegacyFormat() and ExportLegacyFormat() convert from and to the
+// vtkCellArray layout.
+//
+// .SECTION See Also
+// vtkCellArray vtkCellLinks
+
+#ifndef __vtkOffsetCellArray_h
+#define __vtkOffsetCellArray_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include "vtkIdList.h" // Needed for inline methods
+#include "vtkIdTypeArray.h" // Needed for inline methods
+#include "vtkTypeInt32Array.h" // Needed for inline methods
+#include "vtkTypeInt64Array.h" // Needed for inline methods
+
+class vtkCell;
+class vtkCellArray;
+class vtkDataArray;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkOffsetCellArray : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkOffsetCellArray,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Instantiate an empty cell array using the default storage (the width
+  // of vtkIdType).
+  static vtkOffsetCellArray *New();
+
+  //BTX
+  // The array and value types used for each storage width. The storage
+  // that has the width of vtkIdType is a vtkIdTypeArray, so that its
+  // values can be handed out without a copy.
+#ifdef VTK_USE_64BIT_IDS
+  typedef vtkTypeInt32Array ArrayType32;
+  typedef vtkTypeInt32 ValueType32;
+  typedef vtkIdTypeArray ArrayType64;
+  typedef vtkIdType ValueType64;
+#else
+  typedef vtkIdTypeArray ArrayType32;
+  typedef vtkIdType ValueType32;
+  typedef vtkTypeInt64Array ArrayType64;
+  typedef vtkTypeInt64 ValueType64;
+#endif
+  //ETX
+
+  // Description:
+  // Select the storage width. These methods discard the current cells.
+  // UseDefaultStorage() selects the width of vtkIdType.
+  void Use32BitStorage();
+  void Use64BitStorage();
+  void UseDefaultStorage();
+
+  // Description:
+  // Return true if the offsets and connectivity are stored as 64-bit
+  // integers.
+  bool IsStorage64Bit()
+    {return this->Storage64Bit;}
+
+  // Description:
+  // Return true if the storage has the width of vtkIdType, in which case
+  // GetCellAtId() never copies point ids.
+  bool IsStorageShareable();
+
+  // Description:
+  // Convert the current cells to the given storage width, keeping them.
+  // ConvertTo32BitStorage() fails (returns false and leaves the array
+  // untouched) when a point id or the connectivity size does not fit in 32
+  // bits. ConvertToSmallestStorage() picks 32-bit storage whenever possible.
+  bool CanConvertTo32BitStorage();
+  bool ConvertTo32BitStorage();
+  bool ConvertTo64BitStorage();
+  bool ConvertToSmallestStorage();
+
+  // Description:
+  // Free any memory and reset to an empty state, keeping the storage width.
+  void Initialize();
+
+  // Description:
+  // Reuse the array: remove all cells but keep the allocated memory.
+  void Reset();
+
+  // Description:
+  // Reclaim any extra memory.
+  void Squeeze();
+
+  // Description:
+  // Preallocate memory for numCells cells made of connectivitySize point
+  // ids in total. Discards the current cells.
+  bool Allocate(vtkIdType numCells, vtkIdType connectivitySize);
+
+  // Description:
+  // Get the number of cells in the array.
+  vtkIdType GetNumberOfCells();
+
+  // Description:
+  // Get the number of entries of the offsets array (the number of cells
+  // plus one).
+  vtkIdType GetNumberOfOffsets();
+
+  // Description:
+  // Get the total number of point ids in the connectivity array.
+  vtkIdType GetNumberOfConnectivityIds();
+
+  // Description:
+  // Return the underlying offsets and connectivity arrays. They are either
+  // both ArrayType32 or both ArrayType64 instances.
+  vtkDataArray *GetOffsetsArray();
+  vtkDataArray *GetConnectivityArray();
+
+  // Description:
+  // Set the offsets and connectivity arrays. If both are integer arrays of
+  // the same storage class as this object uses for their width, they are
+  // shared (reference counted), otherwise their values are copied. The
+  // storage width follows the wider of the two arrays. The offsets array
+  // must start with 0 and end with the number of connectivity entries.
+  // Returns false, leaving the object unchanged, when the arrays are not
+  // single component integer arrays or are not consistent.
+  bool SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
+  // Description:
+  // Append a cell and return its id.
+  vtkIdType InsertNextCell(vtkIdType npts, const vtkIdType *pts);
+  vtkIdType InsertNextCell(vtkIdList *pts);
+  vtkIdType InsertNextCell(vtkCell *cell);
+
+  // Description:
+  // Return the number of points of the given cell.
+  vtkIdType GetCellSize(vtkIdType cellId);
+
+  // Description:
+  // Random access to the points of a cell. npts is set to the number of
+  // points of the cell and pts to its point ids. When IsStorageShareable()
+  // is true, pts points into the connectivity array and ptIds is not used
+  // (it may be NULL); otherwise the ids are copied into ptIds and pts points
+  // into ptIds. This method does not modify the object and is thread safe as
+  // long as each thread uses its own ptIds and no thread inserts cells.
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, const vtkIdType *&pts,
+                   vtkIdList *ptIds);
+
+  // Description:
+  // Copy the point ids of a cell into the given list. Thread safe in the
+  // same way as the method above.
+  void GetCellAtId(vtkIdType cellId, vtkIdList *pts);
+
+  // Description:
+  // Replace the point ids of a cell. The cell keeps its size, so pts must
+  // hold GetCellSize(cellId) ids.
+  void ReplaceCellAtId(vtkIdType cellId, const vtkIdType *pts);
+
+  // Description:
+  // Invert the ordering of the points of a cell.
+  void ReverseCellAtId(vtkIdType cellId);
+
+  // Description:
+  // Returns the size of the largest cell. The size is the number of points
+  // defining the cell.
+  int GetMaxCellSize();
+
+  // Description:
+  // Replace the contents of this object with the cells of a vtkCellArray,
+  // or of a legacy (n,id1,id2,...,idn, ...) list of the given length. The
+  // storage width is kept, unless the connectivity is too large for 32-bit
+  // storage. Point ids must fit in the storage width.
+  void ImportLegacyFormat(vtkCellArray *cells);
+  void ImportLegacyFormat(const vtkIdType *data, vtkIdType len);
+
+  // Description:
+  // Fill a vtkCellArray with the cells of this object. The legacy list is
+  // written in place into the buffer returned by vtkCellArray::WritePointer
+  // (one allocation, no intermediate copy) and the cells are converted in
+  // parallel with vtkSMPTools, since the position of every cell in the
+  // legacy list is known from its offset.
+  void ExportLegacyFormat(vtkCellArray *cells);
+
+  // Description:
+  // Perform a deep copy (no reference counting) of the given cell array.
+  void DeepCopy(vtkOffsetCellArray *ca);
+
+  // Description:
+  // Share the offsets and connectivity arrays of the given cell array.
+  void ShallowCopy(vtkOffsetCellArray *ca);
+
+  // Description:
+  // Return the memory in kilobytes consumed by this cell array.
+  unsigned long GetActualMemorySize();
+
+protected:
+  vtkOffsetCellArray();
+  ~vtkOffsetCellArray();
+
+  // Replace the storage arrays by empty ones of the requested width.
+  void ResetStorage(bool storage64Bit);
+
+  bool Storage64Bit;
+  ArrayType32 *Offsets32;
+  ArrayType32 *Connectivity32;
+  ArrayType64 *Offsets64;
+  ArrayType64 *Connectivity64;
+
+private:
+  vtkOffsetCellArray(const vtkOffsetCellArray&);  // Not implemented.
+  void operator=(const vtkOffsetCellArray&);  // Not implemented.
+};
+
+//----------------------------------------------------------------------------
+inline bool vtkOffsetCellArray::IsStorageShareable()
+{
+#ifdef VTK_USE_64BIT_IDS
+  return this->Storage64Bit;
+#else
+  return !this->Storage64Bit;
+#endif
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkOffsetCellArray::GetNumberOfOffsets()
+{
+  return this->Storage64Bit ? this->Offsets64->GetMaxId() + 1 :
+    this->Offsets32->GetMaxId() + 1;
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkOffsetCellArray::GetNumberOfCells()
+{
+  return this->GetNumberOfOffsets() - 1;
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkOffsetCellArray::GetNumberOfConnectivityIds()
+{
+  return this->Storage64Bit ? this->Connectivity64->GetMaxId() + 1 :
+    this->Connectivity32->GetMaxId() + 1;
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkOffsetCellArray::InsertNextCell(vtkIdType npts,
+                                                    const vtkIdType *pts)
+{
+  if (this->Storage64Bit)
+    {
+    vtkIdType loc = this->Connectivity64->GetMaxId() + 1;
+    ValueType64 *ptr = this->Connectivity64->WritePointer(loc, npts);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      ptr[i] = static_cast<ValueType64>(pts[i]);
+      }
+    return this->Offsets64->InsertNextValue(
+      static_cast<ValueType64>(loc + npts)) - 1;
+    }
+
+  vtkIdType loc = this->Connectivity32->GetMaxId() + 1;
+  ValueType32 *ptr = this->Connectivity32->WritePointer(loc, npts);
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    ptr[i] = static_cast<ValueType32>(pts[i]);
+    }
+  return this->Offsets32->InsertNextValue(
+    static_cast<ValueType32>(loc + npts)) - 1;
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkOffsetCellArray::InsertNextCell(vtkIdList *pts)
+{
+  return this->InsertNextCell(pts->GetNumberOfIds(), pts->GetPointer(0));
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkOffsetCellArray::GetCellSize(vtkIdType cellId)
+{
+  if (this->Storage64Bit)
+    {
+    const ValueType64 *offsets = this->Offsets64->GetPointer(cellId);
+    return static_cast<vtkIdType>(offsets[1] - offsets[0]);
+    }
+  const ValueType32 *offsets = this->Offsets32->GetPointer(cellId);
+  return static_cast<vtkIdType>(offsets[1] - offsets[0]);
+}
+
+//----------------------------------------------------------------------------
+inline void vtkOffsetCellArray::GetCellAtId(vtkIdType cellId,
+                                            vtkIdType &npts,
+                                            const vtkIdType *&pts,
+                                            vtkIdList *ptIds)
+{
+  if (this->Storage64Bit)
+    {
+    const ValueType64 *offsets = this->Offsets64->GetPointer(cellId);
+    npts = static_cast<vtkIdType>(offsets[1] - offsets[0]);
+    const ValueType64 *conn = this->Connectivity64->GetPointer(
+      static_cast<vtkIdType>(offsets[0]));
+#ifdef VTK_USE_64BIT_IDS
+    (void)ptIds;
+    pts = conn;
+#else
+    ptIds->SetNumberOfIds(npts);
+    vtkIdType *ids = ptIds->GetPointer(0);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      ids[i] = static_cast<vtkIdType>(conn[i]);
+      }
+    pts = ids;
+#endif
+    return;
+    }
+
+  const ValueType32 *offsets = this->Offsets32->GetPointer(cellId);
+  npts = static_cast<vtkIdType>(offsets[1] - offsets[0]);
+  const ValueType32 *conn = this->Connectivity32->GetPointer(
+    static_cast<vtkIdType>(offsets[0]));
+#ifdef VTK_USE_64BIT_IDS
+  ptIds->SetNumberOfIds(npts);
+  vtkIdType *ids = ptIds->GetPointer(0);
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    ids[i] = static_cast<vtkIdType>(conn[i]);
+    }
+  pts = ids;
+#else
+  (void)ptIds;
+  pts = conn;
+#endif
+}
+
+#endif
@@ -212,9 +212,10 @@ void vtkPolyVertex::Clip(double value, vtkDataArray *cellScalars,
     if ( (!insideOut && s > value) || (insideOut && s <= value) )
       {
       this->Points->GetPoint(i,x);
-      if ( locator->InsertUniquePoint(x, pts[0]) )
+      vtkIdType ptId = this->PointIds->GetId(i);
+      if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, pts[0]) )
         {
-        outPd->CopyData(inPd,this->PointIds->GetId(i),pts[0]);
+        outPd->CopyData(inPd,ptId,pts[0]);
         }
       newCellId = verts->InsertNextCell(1,pts);
       outCd->CopyData(inCd,cellId,newCellId);
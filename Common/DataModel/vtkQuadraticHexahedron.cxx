@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkQuadraticHexahedron.h"
 
+#include "vtkEdgeMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
@@ -379,6 +380,9 @@ void vtkQuadraticHexahedron::Contour(double value,
 {
   //subdivide into 8 linear hexs
   this->Subdivide(inPd,inCd,cellId, cellScalars);
+  // The linear hexahedra are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear quad separately
   for (int i=0; i<8; i++) // For each subdivided hexahedron
@@ -392,6 +396,8 @@ void vtkQuadraticHexahedron::Contour(double value,
     this->Hex->Contour(value,this->Scalars,locator,verts,lines,polys,
                        this->PointData,outPd,this->CellData,cellId,outCd);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
@@ -556,6 +562,9 @@ void vtkQuadraticHexahedron::Clip(double value,
 {
   //create eight linear hexes
   this->Subdivide(inPd,inCd,cellId,cellScalars);
+  // The linear hexahedra are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear hex separately
   for (int i=0; i<8; i++) // For each subdivided hexahedron
@@ -569,6 +578,8 @@ void vtkQuadraticHexahedron::Clip(double value,
     this->Hex->Clip(value,this->Scalars,locator,tets,this->PointData,outPd,
                     this->CellData,cellId,outCd,insideOut);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkQuadraticPyramid.h"
 
+#include "vtkEdgeMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
@@ -384,6 +385,9 @@ void vtkQuadraticPyramid::Contour(double value,
   int i;
   //subdivide into 6 linear pyramids
   this->Subdivide(inPd,inCd,cellId,cellScalars);
+  // The linear pyramids and tetrahedra are defined in terms of the local
+  // point ids of the subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear pyramid separately
   this->Scalars->SetNumberOfTuples(5);  //num of vertices
@@ -412,6 +416,8 @@ void vtkQuadraticPyramid::Contour(double value,
     this->Tetra->Contour(value,this->Scalars,locator,verts,lines,polys,
                          this->PointData,outPd,this->CellData,cellId,outCd);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
@@ -606,6 +612,9 @@ void vtkQuadraticPyramid::Clip(double value, vtkDataArray* cellScalars,
   int i;
   // create six linear pyramid + 4 tetra
   this->Subdivide(inPd,inCd,cellId,cellScalars);
+  // The linear pyramids and tetrahedra are defined in terms of the local
+  // point ids of the subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear pyramid separately
   this->Scalars->SetNumberOfTuples(5);  //num of vertices
@@ -633,6 +642,8 @@ void vtkQuadraticPyramid::Clip(double value, vtkDataArray* cellScalars,
     this->Tetra->Clip(value,this->Scalars,locator,tets,this->PointData,outPd,
                     this->CellData,cellId,outCd,insideOut);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkQuadraticQuad.h"
 
+#include "vtkEdgeMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
@@ -282,6 +283,9 @@ void vtkQuadraticQuad::Contour(double value,
 {
   //interpolate point and cell data
   this->InterpolateAttributes(inPd,inCd,cellId,cellScalars);
+  // The linear quads are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear quad separately
   for (int i=0; i<4; i++)
@@ -296,6 +300,8 @@ void vtkQuadraticQuad::Contour(double value,
     this->Quad->Contour(value,this->Scalars,locator,verts,lines,polys,
                         this->PointData,outPd,this->CellData,cellId,outCd);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 //----------------------------------------------------------------------------
 // Clip this quadratic quad using scalar value provided. Like contouring,
@@ -308,6 +314,9 @@ void vtkQuadraticQuad::Clip(double value, vtkDataArray* cellScalars,
 {
   //interpolate point and cell data
   this->InterpolateAttributes(inPd,inCd,cellId,cellScalars);
+  // The linear quads are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear quad separately
   for (int i=0; i<4; i++)
@@ -322,6 +331,8 @@ void vtkQuadraticQuad::Clip(double value, vtkDataArray* cellScalars,
     this->Quad->Clip(value,this->Scalars,locator,polys,this->PointData,
                      outPd,this->CellData,cellId,outCd,insideOut);
     }
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 
@@ -16,6 +16,7 @@
 
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkEdgeMergePoints.h"
 #include "vtkWedge.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
@@ -379,6 +380,9 @@ void vtkQuadraticWedge::Contour(double value,
 {
   //subdivide into 8 linear wedges
   this->Subdivide(inPd,inCd,cellId, cellScalars);
+  // The linear wedges are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear wedge separately
   for (int i=0; i<8; i++) //for each wedge
@@ -393,6 +397,8 @@ void vtkQuadraticWedge::Contour(double value,
                          this->PointData,outPd,this->CellData,cellId,outCd);
     }
 
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
@@ -573,6 +579,9 @@ void vtkQuadraticWedge::Clip(double value, vtkDataArray* cellScalars,
 {
   // create eight linear hexes
   this->Subdivide(inPd,inCd,cellId, cellScalars);
+  // The linear wedges are defined in terms of the local point ids of the
+  // subdivision: merge their points by coordinates.
+  int edgeMerging = vtkEdgeMergePoints::SuspendEdgeMerging(locator);
 
   //contour each linear hex separately
   for (int i=0; i<8; i++) //for each subdivided wedge
@@ -587,6 +596,8 @@ void vtkQuadraticWedge::Clip(double value, vtkDataArray* cellScalars,
                     this->CellData,cellId,outCd,insideOut);
     }
 
+
+  vtkEdgeMergePoints::ResumeEdgeMerging(locator, edgeMerging);
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,497 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticCellLinks.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkOffsetCellArray.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+# include "vtkWindows.h"
+#elif defined(__APPLE__)
+# include <libkern/OSAtomic.h>
+#endif
+
+// Atomic operations on the counts, see vtkAtomicInt32BasicImpl.h. Without
+// them the links are built on a single thread.
+#if defined(VTK_HAVE_SYNC_BUILTINS) || defined(_WIN32) || defined(__APPLE__)
+# define VTK_STATIC_CELL_LINKS_ATOMIC
+#endif
+
+vtkStandardNewMacro(vtkStaticCellLinks);
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Atomically add inc to *value and return the new value.
+inline vtkIdType vtkStaticCellLinksAdd(vtkIdType *value, vtkIdType inc)
+{
+#if defined(VTK_HAVE_SYNC_BUILTINS)
+  return __sync_add_and_fetch(value, inc);
+#elif defined(_WIN32) && defined(VTK_USE_64BIT_IDS)
+  return InterlockedExchangeAdd64(value, inc) + inc;
+#elif defined(_WIN32)
+  return InterlockedExchangeAdd(reinterpret_cast<long*>(value), inc) + inc;
+#elif defined(__APPLE__) && defined(VTK_USE_64BIT_IDS)
+  return OSAtomicAdd64Barrier(inc, reinterpret_cast<int64_t*>(value));
+#elif defined(__APPLE__)
+  return OSAtomicAdd32Barrier(inc, reinterpret_cast<int32_t*>(value));
+#else
+  return (*value += inc);
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Run a functor over [0, n), in parallel when atomics are available.
+template <class Functor>
+void vtkStaticCellLinksFor(vtkIdType n, Functor &f)
+{
+#ifdef VTK_STATIC_CELL_LINKS_ATOMIC
+  vtkSMPTools::For(0, n, f);
+#else
+  f(0, n);
+#endif
+}
+
+//----------------------------------------------------------------------------
+// The following classes give uniform, thread safe access to the point ids
+// of a cell for each kind of input. The scratch list is used when the
+// input cannot return a pointer to its own storage.
+class vtkStaticCellLinksPolyData
+{
+public:
+  vtkPolyData *Input;
+  vtkStaticCellLinksPolyData(vtkPolyData *pd) : Input(pd) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts,
+                     const vtkIdType *&pts, vtkIdList *)
+    {
+    vtkIdType *ptIds;
+    this->Input->GetCellPoints(cellId, npts, ptIds);
+    pts = ptIds;
+    }
+  bool NeedsScratch() {return false;}
+};
+
+class vtkStaticCellLinksUnstructuredGrid
+{
+public:
+  vtkUnstructuredGrid *Input;
+  vtkStaticCellLinksUnstructuredGrid(vtkUnstructuredGrid *ug) : Input(ug) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts,
+                     const vtkIdType *&pts, vtkIdList *)
+    {
+    vtkIdType *ptIds;
+    this->Input->GetCellPoints(cellId, npts, ptIds);
+    pts = ptIds;
+    }
+  bool NeedsScratch() {return false;}
+};
+
+class vtkStaticCellLinksDataSet
+{
+public:
+  vtkDataSet *Input;
+  vtkStaticCellLinksDataSet(vtkDataSet *ds) : Input(ds) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts,
+                     const vtkIdType *&pts, vtkIdList *scratch)
+    {
+    this->Input->GetCellPoints(cellId, scratch);
+    npts = scratch->GetNumberOfIds();
+    pts = scratch->GetPointer(0);
+    }
+  bool NeedsScratch() {return true;}
+};
+
+class vtkStaticCellLinksLegacy
+{
+public:
+  const vtkIdType *Data;
+  const vtkIdType *Locations;
+  vtkStaticCellLinksLegacy(const vtkIdType *data, const vtkIdType *locs)
+    : Data(data), Locations(locs) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts,
+                     const vtkIdType *&pts, vtkIdList *)
+    {
+    const vtkIdType *cell = this->Data + this->Locations[cellId];
+    npts = cell[0];
+    pts = cell + 1;
+    }
+  bool NeedsScratch() {return false;}
+};
+
+class vtkStaticCellLinksOffsets
+{
+public:
+  vtkOffsetCellArray *Input;
+  vtkStaticCellLinksOffsets(vtkOffsetCellArray *ca) : Input(ca) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts,
+                     const vtkIdType *&pts, vtkIdList *scratch)
+    {
+    this->Input->GetCellAtId(cellId, npts, pts, scratch);
+    }
+  bool NeedsScratch() {return !this->Input->IsStorageShareable();}
+};
+
+//----------------------------------------------------------------------------
+// Per-thread scratch lists, created the first time a thread needs one.
+class vtkStaticCellLinksScratch
+{
+public:
+  vtkSMPThreadLocal<vtkIdList*> Lists;
+  bool Enabled;
+
+  vtkStaticCellLinksScratch(bool enabled)
+    : Lists(static_cast<vtkIdList*>(NULL)), Enabled(enabled) {}
+  ~vtkStaticCellLinksScratch()
+    {
+    vtkSMPThreadLocal<vtkIdList*>::iterator iter;
+    for (iter = this->Lists.begin(); iter != this->Lists.end(); ++iter)
+      {
+      if (*iter)
+        {
+        (*iter)->Delete();
+        }
+      }
+    }
+  vtkIdList *Local()
+    {
+    if (!this->Enabled)
+      {
+      return NULL;
+      }
+    vtkIdList *&list = this->Lists.Local();
+    if (!list)
+      {
+      list = vtkIdList::New();
+      }
+    return list;
+    }
+};
+
+//----------------------------------------------------------------------------
+// First pass: count the number of cells using each point.
+template <class TCells>
+class vtkStaticCellLinksCount
+{
+public:
+  TCells &Cells;
+  vtkStaticCellLinksScratch &Scratch;
+  vtkIdType *Counts;
+
+  vtkStaticCellLinksCount(TCells &cells, vtkStaticCellLinksScratch &scratch,
+                          vtkIdType *counts)
+    : Cells(cells), Scratch(scratch), Counts(counts) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *scratch = this->Scratch.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Cells.GetCellPoints(cellId, npts, pts, scratch);
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        vtkStaticCellLinksAdd(this->Counts + pts[i], 1);
+        }
+      }
+    }
+
+private:
+  void operator=(const vtkStaticCellLinksCount&);
+};
+
+//----------------------------------------------------------------------------
+// Second pass: offsets hold the end of each link; scatter the cell ids
+// backwards so that the offsets end up at the start of each link.
+template <class TCells>
+class vtkStaticCellLinksInsert
+{
+public:
+  TCells &Cells;
+  vtkStaticCellLinksScratch &Scratch;
+  vtkIdType *Offsets;
+  vtkIdType *Links;
+
+  vtkStaticCellLinksInsert(TCells &cells, vtkStaticCellLinksScratch &scratch,
+                           vtkIdType *offsets, vtkIdType *links)
+    : Cells(cells), Scratch(scratch), Offsets(offsets), Links(links) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *scratch = this->Scratch.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Cells.GetCellPoints(cellId, npts, pts, scratch);
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        this->Links[vtkStaticCellLinksAdd(this->Offsets + pts[i], -1)] =
+          cellId;
+        }
+      }
+    }
+
+private:
+  void operator=(const vtkStaticCellLinksInsert&);
+};
+
+//----------------------------------------------------------------------------
+// Third pass: the scatter order depends on thread scheduling, sort each link
+// to get the same cell order as vtkCellLinks.
+class vtkStaticCellLinksSort
+{
+public:
+  const vtkIdType *Offsets;
+  vtkIdType *Links;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      vtkIdType *first = this->Links + this->Offsets[ptId];
+      vtkIdType *last = this->Links + this->Offsets[ptId+1];
+      if (last - first > 1)
+        {
+        std::sort(first, last);
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+template <class TCells>
+void vtkStaticCellLinksBuild(TCells &cells, vtkIdType numPts,
+                             vtkIdType numCells, vtkIdType *&offsets,
+                             vtkIdType *&links)
+{
+  vtkStaticCellLinksScratch scratch(cells.NeedsScratch());
+
+  offsets = new vtkIdType[numPts + 1];
+  std::fill(offsets, offsets + numPts + 1, 0);
+  vtkStaticCellLinksCount<TCells> count(cells, scratch, offsets);
+  vtkStaticCellLinksFor(numCells, count);
+
+  // Inclusive prefix sum: offsets[ptId] is the end of the link of ptId.
+  vtkIdType total = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    total += offsets[ptId];
+    offsets[ptId] = total;
+    }
+  offsets[numPts] = total;
+
+  links = new vtkIdType[total > 0 ? total : 1];
+  vtkStaticCellLinksInsert<TCells> insert(cells, scratch, offsets, links);
+  vtkStaticCellLinksFor(numCells, insert);
+
+  vtkStaticCellLinksSort sort;
+  sort.Offsets = offsets;
+  sort.Links = links;
+  vtkSMPTools::For(0, numPts, sort);
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLinks::vtkStaticCellLinks()
+{
+  this->NumberOfPoints = 0;
+  this->Offsets = NULL;
+  this->Links = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLinks::~vtkStaticCellLinks()
+{
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::Initialize()
+{
+  delete [] this->Offsets;
+  delete [] this->Links;
+  this->Offsets = NULL;
+  this->Links = NULL;
+  this->NumberOfPoints = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::BuildLinks(vtkDataSet *ds)
+{
+  this->Initialize();
+  if (!ds)
+    {
+    return;
+    }
+
+  vtkIdType numPts = ds->GetNumberOfPoints();
+  vtkIdType numCells = ds->GetNumberOfCells();
+  this->NumberOfPoints = numPts;
+
+  if (vtkPolyData *pd = vtkPolyData::SafeDownCast(ds))
+    {
+    // GetCellType() builds the cells if necessary, so that the cell
+    // accesses below are read only.
+    if (numCells > 0)
+      {
+      pd->GetCellType(0);
+      }
+    vtkStaticCellLinksPolyData cells(pd);
+    vtkStaticCellLinksBuild(cells, numPts, numCells, this->Offsets,
+                            this->Links);
+    }
+  else if (vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+    vtkStaticCellLinksUnstructuredGrid cells(ug);
+    vtkStaticCellLinksBuild(cells, numPts, numCells, this->Offsets,
+                            this->Links);
+    }
+  else
+    {
+    // vtkDataSet::GetCellPoints() is thread safe once it has been called
+    // from a single thread.
+    if (numCells > 0)
+      {
+      vtkIdList *ptIds = vtkIdList::New();
+      ds->GetCellPoints(0, ptIds);
+      ptIds->Delete();
+      }
+    vtkStaticCellLinksDataSet cells(ds);
+    vtkStaticCellLinksBuild(cells, numPts, numCells, this->Offsets,
+                            this->Links);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::BuildLinks(vtkIdType numPts, vtkCellArray *ca)
+{
+  this->Initialize();
+  if (!ca)
+    {
+    return;
+    }
+
+  // The legacy layout can only be walked sequentially; record where each
+  // cell starts so that the passes below can run in parallel.
+  vtkIdType numCells = ca->GetNumberOfCells();
+  const vtkIdType *data = ca->GetPointer();
+  vtkIdType *locations = new vtkIdType[numCells > 0 ? numCells : 1];
+  vtkIdType loc = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    locations[cellId] = loc;
+    loc += data[loc] + 1;
+    }
+
+  this->NumberOfPoints = numPts;
+  vtkStaticCellLinksLegacy cells(data, locations);
+  vtkStaticCellLinksBuild(cells, numPts, numCells, this->Offsets,
+                          this->Links);
+  delete [] locations;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::BuildLinks(vtkIdType numPts, vtkOffsetCellArray *ca)
+{
+  this->Initialize();
+  if (!ca)
+    {
+    return;
+    }
+
+  this->NumberOfPoints = numPts;
+  vtkStaticCellLinksOffsets cells(ca);
+  vtkStaticCellLinksBuild(cells, numPts, ca->GetNumberOfCells(),
+                          this->Offsets, this->Links);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1,
+                                              vtkIdType p2, vtkIdList *cellIds)
+{
+  cellIds->Reset();
+  const vtkIdType *cells1 = this->GetCells(p1);
+  const vtkIdType *cells2 = this->GetCells(p2);
+  vtkIdType ncells1 = this->GetNcells(p1);
+  vtkIdType ncells2 = this->GetNcells(p2);
+  vtkIdType j = 0;
+  for (vtkIdType i = 0; i < ncells1; i++)
+    {
+    while (j < ncells2 && cells2[j] < cells1[i])
+      {
+      j++;
+      }
+    if (j < ncells2 && cells2[j] == cells1[i] && cells1[i] != cellId)
+      {
+      cellIds->InsertNextId(cells1[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkStaticCellLinks::GetActualMemorySize()
+{
+  vtkIdType size = 0;
+  if (this->Offsets)
+    {
+    size = this->NumberOfPoints + 1 + this->GetLinksSize();
+    }
+  return static_cast<unsigned long>(
+    (size * sizeof(vtkIdType) + 1023) / 1024);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::DeepCopy(vtkStaticCellLinks *src)
+{
+  if (!src || src == this)
+    {
+    return;
+    }
+
+  this->Initialize();
+  if (src->Offsets)
+    {
+    vtkIdType linksSize = src->GetLinksSize();
+    this->NumberOfPoints = src->NumberOfPoints;
+    this->Offsets = new vtkIdType[this->NumberOfPoints + 1];
+    this->Links = new vtkIdType[linksSize > 0 ? linksSize : 1];
+    std::copy(src->Offsets, src->Offsets + this->NumberOfPoints + 1,
+              this->Offsets);
+    std::copy(src->Links, src->Links + linksSize, this->Links);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Points: " << this->NumberOfPoints << "\n";
+  os << indent << "Links Size: " << this->GetLinksSize() << "\n";
+}
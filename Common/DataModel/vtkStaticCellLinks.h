@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLinks.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticCellLinks - read-only upward links from points to cells, built in parallel
+// .SECTION Description
+// vtkStaticCellLinks provides the same information as vtkCellLinks (the list
+// of cells using each point) in a compact, read-only form: one array holds
+// the cell ids of all links back to back, and an offsets array holds, for
+// each point, the index of its first cell id (compressed sparse row
+// layout). There is no per-point allocation and no 65535 cells per point
+// limit.
+//
+// BuildLinks() runs in parallel with vtkSMPTools: the number of cells using
+// each point is counted with atomic increments, a prefix sum of the counts
+// gives the end of each link, and the cell ids are then scattered into place
+// with atomic decrements, which leaves the offsets pointing at the start of
+// each link. Each link is finally sorted so that cell ids are in increasing
+// order, exactly as vtkCellLinks builds them; the result does not depend on
+// the number of threads.
+//
+// Once built, the links cannot be modified (use vtkCellLinks for editable
+// links) and may be queried from several threads at once. Filters that only
+// need to look up the cells using a point can opt into this class instead of
+// vtkDataSet::BuildLinks().
+//
+// .SECTION See Also
+// vtkCellLinks vtkOffsetCellArray vtkSMPTools
+
+#ifndef __vtkStaticCellLinks_h
+#define __vtkStaticCellLinks_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkCellArray;
+class vtkDataSet;
+class vtkIdList;
+class vtkOffsetCellArray;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticCellLinks : public vtkObject
+{
+public:
+  static vtkStaticCellLinks *New();
+  vtkTypeMacro(vtkStaticCellLinks,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Build the links for all the cells of a dataset. For vtkPolyData, the
+  // cells are built (vtkPolyData::BuildCells()) if necessary.
+  void BuildLinks(vtkDataSet *ds);
+
+  // Description:
+  // Build the links of a legacy cell array whose cells use numPts points.
+  // Cell ids are numbered from zero in traversal order.
+  void BuildLinks(vtkIdType numPts, vtkCellArray *cells);
+
+  // Description:
+  // Build the links of an offsets/connectivity cell array whose cells use
+  // numPts points.
+  void BuildLinks(vtkIdType numPts, vtkOffsetCellArray *cells);
+
+  // Description:
+  // Get the number of points and the total number of links (cell uses).
+  vtkIdType GetNumberOfPoints()
+    {return this->NumberOfPoints;}
+  vtkIdType GetLinksSize()
+    {return this->Offsets ? this->Offsets[this->NumberOfPoints] : 0;}
+
+  // Description:
+  // Get the number of cells using the point specified by ptId.
+  vtkIdType GetNcells(vtkIdType ptId)
+    {return this->Offsets[ptId+1] - this->Offsets[ptId];}
+
+  // Description:
+  // Return the list of cell ids using the point, sorted in increasing
+  // order. GetNcells() gives its length.
+  const vtkIdType *GetCells(vtkIdType ptId)
+    {return this->Links + this->Offsets[ptId];}
+
+  // Description:
+  // Get the cells other than cellId that use both p1 and p2 (the cells
+  // across the edge (p1,p2) of cellId), in increasing order. This is the
+  // intersection of the sorted links of p1 and p2; a cell using p1 several
+  // times is listed as many times, like vtkPolyData::GetCellEdgeNeighbors().
+  void GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1, vtkIdType p2,
+                            vtkIdList *cellIds);
+
+  // Description:
+  // Direct access to the offsets (GetNumberOfPoints()+1 values) and the
+  // links (GetLinksSize() values).
+  const vtkIdType *GetOffsets()
+    {return this->Offsets;}
+  const vtkIdType *GetLinks()
+    {return this->Links;}
+
+  // Description:
+  // Release the memory and reset to an empty state.
+  void Initialize();
+
+  // Description:
+  // Return the memory in kilobytes consumed by the links.
+  unsigned long GetActualMemorySize();
+
+  // Description:
+  // Standard DeepCopy method.
+  void DeepCopy(vtkStaticCellLinks *src);
+
+protected:
+  vtkStaticCellLinks();
+  ~vtkStaticCellLinks();
+
+  vtkIdType NumberOfPoints;
+  vtkIdType *Offsets;
+  vtkIdType *Links;
+
+private:
+  vtkStaticCellLinks(const vtkStaticCellLinks&);  // Not implemented.
+  void operator=(const vtkStaticCellLinks&);  // Not implemented.
+};
+
+#endif
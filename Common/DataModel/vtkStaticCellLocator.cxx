@@ -0,0 +1,1249 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticCellLocator.h"
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Nodes at this depth are always leaves. This bounds the size of the
+// traversal stacks, which live on the call stack of each query.
+#define VTK_STATIC_CELL_LOCATOR_MAX_DEPTH 64
+
+// Number of bins used to evaluate the SAH split planes.
+#define VTK_STATIC_CELL_LOCATOR_BINS 16
+
+// Nodes with at least this many cells are binned in parallel.
+#define VTK_STATIC_CELL_LOCATOR_PARALLEL_SIZE 65536
+
+vtkStandardNewMacro(vtkStaticCellLocator);
+
+typedef vtkStaticCellLocator::Node vtkStaticCellLocatorNode;
+
+namespace
+{
+//----------------------------------------------------------------------------
+inline void vtkStaticCellLocatorInitBounds(double bounds[6])
+{
+  bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+  bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
+}
+
+inline void vtkStaticCellLocatorAddBounds(double bounds[6],
+                                          const double other[6])
+{
+  for (int i = 0; i < 3; i++)
+    {
+    bounds[2*i] = std::min(bounds[2*i], other[2*i]);
+    bounds[2*i+1] = std::max(bounds[2*i+1], other[2*i+1]);
+    }
+}
+
+inline void vtkStaticCellLocatorAddPoint(double bounds[6], const double x[3])
+{
+  for (int i = 0; i < 3; i++)
+    {
+    bounds[2*i] = std::min(bounds[2*i], x[i]);
+    bounds[2*i+1] = std::max(bounds[2*i+1], x[i]);
+    }
+}
+
+// Half of the surface area of a box, zero for an empty box.
+inline double vtkStaticCellLocatorArea(const double bounds[6])
+{
+  if (bounds[1] < bounds[0])
+    {
+    return 0.0;
+    }
+  double dx = bounds[1] - bounds[0];
+  double dy = bounds[3] - bounds[2];
+  double dz = bounds[5] - bounds[4];
+  return dx*dy + dy*dz + dz*dx;
+}
+
+inline bool vtkStaticCellLocatorInside(const double x[3],
+                                       const double bounds[6], double tol)
+{
+  return x[0] >= bounds[0] - tol && x[0] <= bounds[1] + tol &&
+    x[1] >= bounds[2] - tol && x[1] <= bounds[3] + tol &&
+    x[2] >= bounds[4] - tol && x[2] <= bounds[5] + tol;
+}
+
+inline bool vtkStaticCellLocatorOverlap(const double a[6], const double b[6])
+{
+  return a[0] <= b[1] && b[0] <= a[1] && a[2] <= b[3] && b[2] <= a[3] &&
+    a[4] <= b[5] && b[4] <= a[5];
+}
+
+inline double vtkStaticCellLocatorDistance2(const double x[3],
+                                            const double bounds[6])
+{
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; i++)
+    {
+    double d = 0.0;
+    if (x[i] < bounds[2*i])
+      {
+      d = bounds[2*i] - x[i];
+      }
+    else if (x[i] > bounds[2*i+1])
+      {
+      d = x[i] - bounds[2*i+1];
+      }
+    dist2 += d * d;
+    }
+  return dist2;
+}
+
+// Intersect the segment p1 + t*dir, t in [0,1], with the box padded by tol.
+// Return false if they do not intersect, otherwise the parameter where the
+// segment enters the box.
+inline bool vtkStaticCellLocatorClip(const double bounds[6],
+                                     const double p1[3], const double dir[3],
+                                     double tol, double &tEnter)
+{
+  double t0 = 0.0, t1 = 1.0;
+  for (int i = 0; i < 3; i++)
+    {
+    double lo = bounds[2*i] - tol;
+    double hi = bounds[2*i+1] + tol;
+    if (dir[i] == 0.0)
+      {
+      if (p1[i] < lo || p1[i] > hi)
+        {
+        return false;
+        }
+      continue;
+      }
+    double ta = (lo - p1[i]) / dir[i];
+    double tb = (hi - p1[i]) / dir[i];
+    if (ta > tb)
+      {
+      std::swap(ta, tb);
+      }
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+    if (t0 > t1)
+      {
+      return false;
+      }
+    }
+  tEnter = t0;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// A cell during the build. The build reorders an array of these in place,
+// so that the cells of a node stay contiguous in memory.
+struct vtkStaticCellLocatorItem
+{
+  double Bounds[6];
+  double Center[3];
+  vtkIdType CellId;
+};
+
+//----------------------------------------------------------------------------
+// Compute the bounds and the center of each cell.
+class vtkStaticCellLocatorCellBounds
+{
+public:
+  vtkDataSet *DataSet;
+  double (*Bounds)[6];
+  vtkStaticCellLocatorItem *Items;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      double *bounds = this->Bounds[cellId];
+      this->DataSet->GetCellBounds(cellId, bounds);
+      vtkStaticCellLocatorItem &item = this->Items[cellId];
+      std::copy(bounds, bounds + 6, item.Bounds);
+      item.Center[0] = 0.5 * (bounds[0] + bounds[1]);
+      item.Center[1] = 0.5 * (bounds[2] + bounds[3]);
+      item.Center[2] = 0.5 * (bounds[4] + bounds[5]);
+      item.CellId = cellId;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Computes the bin of a cell center along an axis.
+class vtkStaticCellLocatorBinner
+{
+public:
+  int Axis;
+  double Min;
+  double Scale;
+
+  int operator()(const vtkStaticCellLocatorItem &item) const
+    {
+    int bin = static_cast<int>(
+      (item.Center[this->Axis] - this->Min) * this->Scale);
+    return std::max(0, std::min(VTK_STATIC_CELL_LOCATOR_BINS - 1, bin));
+    }
+};
+
+//----------------------------------------------------------------------------
+// Bounds of a range of cells and of their centers.
+struct vtkStaticCellLocatorRangeBounds
+{
+  double Bounds[6];
+  double CenterBounds[6];
+
+  void Initialize()
+    {
+    vtkStaticCellLocatorInitBounds(this->Bounds);
+    vtkStaticCellLocatorInitBounds(this->CenterBounds);
+    }
+  void Add(const vtkStaticCellLocatorRangeBounds &other)
+    {
+    vtkStaticCellLocatorAddBounds(this->Bounds, other.Bounds);
+    vtkStaticCellLocatorAddBounds(this->CenterBounds, other.CenterBounds);
+    }
+  void Add(const vtkStaticCellLocatorItem *items, vtkIdType begin,
+           vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      vtkStaticCellLocatorAddBounds(this->Bounds, items[i].Bounds);
+      vtkStaticCellLocatorAddPoint(this->CenterBounds, items[i].Center);
+      }
+    }
+};
+
+// Per-bin cell counts and bounds for the SAH.
+struct vtkStaticCellLocatorBins
+{
+  vtkIdType Counts[VTK_STATIC_CELL_LOCATOR_BINS];
+  vtkStaticCellLocatorRangeBounds Ranges[VTK_STATIC_CELL_LOCATOR_BINS];
+
+  void Initialize()
+    {
+    for (int b = 0; b < VTK_STATIC_CELL_LOCATOR_BINS; b++)
+      {
+      this->Counts[b] = 0;
+      this->Ranges[b].Initialize();
+      }
+    }
+  void Add(const vtkStaticCellLocatorBins &other)
+    {
+    for (int b = 0; b < VTK_STATIC_CELL_LOCATOR_BINS; b++)
+      {
+      this->Counts[b] += other.Counts[b];
+      this->Ranges[b].Add(other.Ranges[b]);
+      }
+    }
+  void Add(const vtkStaticCellLocatorItem *items,
+           const vtkStaticCellLocatorBinner &binner, vtkIdType begin,
+           vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      int bin = binner(items[i]);
+      this->Counts[bin]++;
+      vtkStaticCellLocatorAddBounds(this->Ranges[bin].Bounds,
+                                    items[i].Bounds);
+      vtkStaticCellLocatorAddPoint(this->Ranges[bin].CenterBounds,
+                                   items[i].Center);
+      }
+    }
+};
+
+class vtkStaticCellLocatorBinBelow
+{
+public:
+  vtkStaticCellLocatorBinner Binner;
+  int Bin;
+
+  bool operator()(const vtkStaticCellLocatorItem &item) const
+    {
+    return this->Binner(item) <= this->Bin;
+    }
+};
+
+class vtkStaticCellLocatorCenterLess
+{
+public:
+  int Axis;
+
+  bool operator()(const vtkStaticCellLocatorItem &a,
+                  const vtkStaticCellLocatorItem &b) const
+    {
+    double ca = a.Center[this->Axis];
+    double cb = b.Center[this->Axis];
+    return ca < cb || (ca == cb && a.CellId < b.CellId);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Parallel reduction of the bounds of a range of cells.
+class vtkStaticCellLocatorBoundsFunctor
+{
+public:
+  const vtkStaticCellLocatorItem *Items;
+  vtkSMPThreadLocal<vtkStaticCellLocatorRangeBounds> Local;
+  vtkStaticCellLocatorRangeBounds Result;
+
+  void Initialize()
+    {
+    this->Local.Local().Initialize();
+    }
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    this->Local.Local().Add(this->Items, begin, end);
+    }
+  void Reduce()
+    {
+    this->Result.Initialize();
+    vtkSMPThreadLocal<vtkStaticCellLocatorRangeBounds>::iterator iter;
+    for (iter = this->Local.begin(); iter != this->Local.end(); ++iter)
+      {
+      this->Result.Add(*iter);
+      }
+    }
+};
+
+// Parallel binning of a range of cells.
+class vtkStaticCellLocatorBinFunctor
+{
+public:
+  const vtkStaticCellLocatorItem *Items;
+  vtkStaticCellLocatorBinner Binner;
+  vtkSMPThreadLocal<vtkStaticCellLocatorBins> Local;
+  vtkStaticCellLocatorBins Result;
+
+  void Initialize()
+    {
+    this->Local.Local().Initialize();
+    }
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    this->Local.Local().Add(this->Items, this->Binner, begin, end);
+    }
+  void Reduce()
+    {
+    this->Result.Initialize();
+    vtkSMPThreadLocal<vtkStaticCellLocatorBins>::iterator iter;
+    for (iter = this->Local.begin(); iter != this->Local.end(); ++iter)
+      {
+      this->Result.Add(*iter);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Builds the tree over the items array, which is reordered in place so
+// that the cells of each node are contiguous. The bounds of a node are
+// known from its parent: with the SAH they are gathered by the binning
+// pass, so each level of the tree costs a single pass over the cells plus
+// the partition. The reductions are exact (min, max and integer sums), so
+// the tree is the same whether a node is processed serially or in parallel.
+class vtkStaticCellLocatorBuilder
+{
+public:
+  vtkStaticCellLocatorItem *Items;
+  int LeafSize;
+  int SplitMethod;
+  bool Parallel; // process large nodes in parallel
+
+  // A subtree left to build after the top levels.
+  struct Task
+  {
+    vtkIdType Node;
+    vtkIdType Begin;
+    vtkIdType End;
+    int Depth;
+    vtkStaticCellLocatorRangeBounds Bounds;
+  };
+
+  // Bounds of the cells in [begin, end).
+  void ComputeBounds(vtkIdType begin, vtkIdType end,
+                     vtkStaticCellLocatorRangeBounds &bounds);
+
+  // Return true with the split position and the bounds of both sides if
+  // the node holding [begin, end) must be split.
+  bool Split(vtkIdType begin, vtkIdType end, int depth,
+             const vtkStaticCellLocatorRangeBounds &bounds, vtkIdType &mid,
+             vtkStaticCellLocatorRangeBounds &left,
+             vtkStaticCellLocatorRangeBounds &right);
+
+  // Serial recursive build of the subtree rooted at nodes[idx].
+  void Build(std::vector<vtkStaticCellLocatorNode> &nodes, vtkIdType idx,
+             vtkIdType begin, vtkIdType end, int depth,
+             const vtkStaticCellLocatorRangeBounds &bounds, int &maxDepth);
+
+  // Build the top levels, leaving the subtrees of at most taskSize cells
+  // to the tasks.
+  void BuildTop(std::vector<vtkStaticCellLocatorNode> &nodes, vtkIdType idx,
+                vtkIdType begin, vtkIdType end, int depth,
+                const vtkStaticCellLocatorRangeBounds &bounds,
+                vtkIdType taskSize, std::vector<Task> &tasks, int &maxDepth);
+};
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocatorBuilder::ComputeBounds(
+  vtkIdType begin, vtkIdType end, vtkStaticCellLocatorRangeBounds &bounds)
+{
+  // The thread local storage of the functors is only worth it for large
+  // ranges.
+  if (this->Parallel && end - begin >= VTK_STATIC_CELL_LOCATOR_PARALLEL_SIZE)
+    {
+    vtkStaticCellLocatorBoundsFunctor functor;
+    functor.Items = this->Items;
+    vtkSMPTools::For(begin, end, functor);
+    bounds = functor.Result;
+    }
+  else
+    {
+    bounds.Initialize();
+    bounds.Add(this->Items, begin, end);
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkStaticCellLocatorBuilder::Split(
+  vtkIdType begin, vtkIdType end, int depth,
+  const vtkStaticCellLocatorRangeBounds &bounds, vtkIdType &mid,
+  vtkStaticCellLocatorRangeBounds &left,
+  vtkStaticCellLocatorRangeBounds &right)
+{
+  vtkIdType n = end - begin;
+  if (n <= this->LeafSize || depth >= VTK_STATIC_CELL_LOCATOR_MAX_DEPTH - 1)
+    {
+    return false;
+    }
+
+  // Split along the longest axis of the cell centers.
+  const double *cb = bounds.CenterBounds;
+  int axis = 0;
+  for (int i = 1; i < 3; i++)
+    {
+    if (cb[2*i+1] - cb[2*i] > cb[2*axis+1] - cb[2*axis])
+      {
+      axis = i;
+      }
+    }
+  double extent = cb[2*axis+1] - cb[2*axis];
+
+  int best = -1;
+  vtkStaticCellLocatorBinner binner;
+  vtkStaticCellLocatorBins bins;
+  if (extent > 0.0 && this->SplitMethod == VTK_STATIC_CELL_LOCATOR_SAH)
+    {
+    // Binned SAH: evaluate the split planes between bins, and keep the one
+    // minimizing area(left) * count(left) + area(right) * count(right).
+    binner.Axis = axis;
+    binner.Min = cb[2*axis];
+    binner.Scale = VTK_STATIC_CELL_LOCATOR_BINS / extent;
+    if (this->Parallel && n >= VTK_STATIC_CELL_LOCATOR_PARALLEL_SIZE)
+      {
+      vtkStaticCellLocatorBinFunctor functor;
+      functor.Items = this->Items;
+      functor.Binner = binner;
+      vtkSMPTools::For(begin, end, functor);
+      bins = functor.Result;
+      }
+    else
+      {
+      bins.Initialize();
+      bins.Add(this->Items, binner, begin, end);
+      }
+
+    const int numPlanes = VTK_STATIC_CELL_LOCATOR_BINS - 1;
+    double rightArea[numPlanes];
+    vtkIdType rightCount[numPlanes];
+    vtkStaticCellLocatorRangeBounds box;
+    vtkIdType count = 0;
+    box.Initialize();
+    for (int b = numPlanes; b > 0; b--)
+      {
+      count += bins.Counts[b];
+      box.Add(bins.Ranges[b]);
+      rightCount[b-1] = count;
+      rightArea[b-1] = vtkStaticCellLocatorArea(box.Bounds);
+      }
+    double bestCost = VTK_DOUBLE_MAX;
+    count = 0;
+    box.Initialize();
+    for (int b = 0; b < numPlanes; b++)
+      {
+      count += bins.Counts[b];
+      box.Add(bins.Ranges[b]);
+      if (count == 0 || rightCount[b] == 0)
+        {
+        continue;
+        }
+      double cost = vtkStaticCellLocatorArea(box.Bounds) * count +
+        rightArea[b] * rightCount[b];
+      if (cost < bestCost)
+        {
+        bestCost = cost;
+        best = b;
+        }
+      }
+    }
+
+  if (best >= 0)
+    {
+    vtkStaticCellLocatorBinBelow below;
+    below.Binner = binner;
+    below.Bin = best;
+    mid = std::partition(this->Items + begin, this->Items + end, below) -
+      this->Items;
+    left.Initialize();
+    right.Initialize();
+    for (int b = 0; b < VTK_STATIC_CELL_LOCATOR_BINS; b++)
+      {
+      (b <= best ? left : right).Add(bins.Ranges[b]);
+      }
+    return true;
+    }
+
+  // Median split, also used when all the centers coincide (the range is
+  // then simply cut in two halves).
+  mid = begin + n / 2;
+  if (extent > 0.0)
+    {
+    vtkStaticCellLocatorCenterLess less;
+    less.Axis = axis;
+    std::nth_element(this->Items + begin, this->Items + mid,
+                     this->Items + end, less);
+    }
+  this->ComputeBounds(begin, mid, left);
+  this->ComputeBounds(mid, end, right);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocatorBuilder::Build(
+  std::vector<vtkStaticCellLocatorNode> &nodes, vtkIdType idx,
+  vtkIdType begin, vtkIdType end, int depth,
+  const vtkStaticCellLocatorRangeBounds &bounds, int &maxDepth)
+{
+  maxDepth = std::max(maxDepth, depth);
+  std::copy(bounds.Bounds, bounds.Bounds + 6, nodes[idx].Bounds);
+  vtkIdType mid;
+  vtkStaticCellLocatorRangeBounds leftBounds, rightBounds;
+  if (!this->Split(begin, end, depth, bounds, mid, leftBounds, rightBounds))
+    {
+    nodes[idx].Index = begin;
+    nodes[idx].Count = end - begin;
+    return;
+    }
+  vtkIdType left = static_cast<vtkIdType>(nodes.size());
+  nodes.resize(left + 2);
+  nodes[idx].Index = left;
+  nodes[idx].Count = 0;
+  this->Build(nodes, left, begin, mid, depth + 1, leftBounds, maxDepth);
+  this->Build(nodes, left + 1, mid, end, depth + 1, rightBounds, maxDepth);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocatorBuilder::BuildTop(
+  std::vector<vtkStaticCellLocatorNode> &nodes, vtkIdType idx,
+  vtkIdType begin, vtkIdType end, int depth,
+  const vtkStaticCellLocatorRangeBounds &bounds, vtkIdType taskSize,
+  std::vector<Task> &tasks, int &maxDepth)
+{
+  if (end - begin <= taskSize)
+    {
+    Task task;
+    task.Node = idx;
+    task.Begin = begin;
+    task.End = end;
+    task.Depth = depth;
+    task.Bounds = bounds;
+    tasks.push_back(task);
+    return;
+    }
+  maxDepth = std::max(maxDepth, depth);
+  std::copy(bounds.Bounds, bounds.Bounds + 6, nodes[idx].Bounds);
+  vtkIdType mid;
+  vtkStaticCellLocatorRangeBounds leftBounds, rightBounds;
+  if (!this->Split(begin, end, depth, bounds, mid, leftBounds, rightBounds))
+    {
+    nodes[idx].Index = begin;
+    nodes[idx].Count = end - begin;
+    return;
+    }
+  vtkIdType left = static_cast<vtkIdType>(nodes.size());
+  nodes.resize(left + 2);
+  nodes[idx].Index = left;
+  nodes[idx].Count = 0;
+  this->BuildTop(nodes, left, begin, mid, depth + 1, leftBounds, taskSize,
+                 tasks, maxDepth);
+  this->BuildTop(nodes, left + 1, mid, end, depth + 1, rightBounds, taskSize,
+                 tasks, maxDepth);
+}
+
+//----------------------------------------------------------------------------
+// Build the subtrees of the tasks concurrently, each one in its own array
+// of nodes rooted at index 0. The builder does not nest parallel loops.
+class vtkStaticCellLocatorBuildTasks
+{
+public:
+  vtkStaticCellLocatorBuilder Builder;
+  const std::vector<vtkStaticCellLocatorBuilder::Task> *Tasks;
+  std::vector<std::vector<vtkStaticCellLocatorNode> > *Subtrees;
+  std::vector<int> *Depths;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType t = begin; t < end; t++)
+      {
+      const vtkStaticCellLocatorBuilder::Task &task = (*this->Tasks)[t];
+      std::vector<vtkStaticCellLocatorNode> &nodes = (*this->Subtrees)[t];
+      nodes.resize(1);
+      this->Builder.Build(nodes, 0, task.Begin, task.End, task.Depth,
+                          task.Bounds, (*this->Depths)[t]);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Explicit traversal stack. The depth of the tree is bounded, and each
+// level pushes at most two nodes.
+class vtkStaticCellLocatorStack
+{
+public:
+  vtkStaticCellLocatorStack() : Size(0) {}
+  bool Empty() const {return this->Size == 0;}
+  void Push(vtkIdType node) {this->Nodes[this->Size++] = node;}
+  vtkIdType Pop() {return this->Nodes[--this->Size];}
+
+private:
+  vtkIdType Nodes[2*VTK_STATIC_CELL_LOCATOR_MAX_DEPTH + 2];
+  int Size;
+};
+
+//----------------------------------------------------------------------------
+// Locate a range of points, reusing the cell of the previous point when it
+// still contains the next one.
+class vtkStaticCellLocatorFindCells
+{
+public:
+  vtkStaticCellLocator *Locator;
+  vtkDataSet *DataSet;
+  vtkPoints *Points;
+  vtkIdType *CellIds;
+  double Tol2;
+  int MaxCellSize;
+  vtkSMPThreadLocal<vtkGenericCell*> Cells;
+
+  vtkStaticCellLocatorFindCells()
+    : Cells(static_cast<vtkGenericCell*>(NULL)) {}
+  ~vtkStaticCellLocatorFindCells()
+    {
+    vtkSMPThreadLocal<vtkGenericCell*>::iterator iter;
+    for (iter = this->Cells.begin(); iter != this->Cells.end(); ++iter)
+      {
+      if (*iter)
+        {
+        (*iter)->Delete();
+        }
+      }
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkGenericCell *&cell = this->Cells.Local();
+    if (!cell)
+      {
+      cell = vtkGenericCell::New();
+      }
+    std::vector<double> weights(this->MaxCellSize);
+    double x[3], pcoords[3], closest[3], dist2;
+    int subId;
+    vtkIdType lastCell = -1;
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Points->GetPoint(i, x);
+      if (lastCell >= 0 &&
+          cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                 &weights[0]) == 1 &&
+          dist2 <= this->Tol2)
+        {
+        this->CellIds[i] = lastCell;
+        continue;
+        }
+      lastCell = this->Locator->FindCell(x, this->Tol2, cell, pcoords,
+                                         &weights[0]);
+      this->CellIds[i] = lastCell;
+      }
+    }
+};
+}
+
+//----------------------------------------------------------------------------
+// Construct with the SAH split method and 8 cells per leaf.
+vtkStaticCellLocator::vtkStaticCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+  this->SplitMethod = VTK_STATIC_CELL_LOCATOR_SAH;
+  this->Depth = 0;
+  this->MaxCellSize = 0;
+  this->NumberOfNodes = 0;
+  this->Nodes = NULL;
+  this->CellIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLocator::~vtkStaticCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FreeSearchStructure()
+{
+  delete [] this->Nodes;
+  delete [] this->CellIds;
+  this->Nodes = NULL;
+  this->CellIds = NULL;
+  this->NumberOfNodes = 0;
+  this->Depth = 0;
+  this->FreeCellBounds();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::BuildLocator()
+{
+  if ( (this->Nodes != NULL) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+    {
+    return;
+    }
+  if ( (this->Nodes != NULL) && this->UseExistingSearchStructure )
+    {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+    }
+
+  vtkIdType numCells;
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+    {
+    vtkErrorMacro( << "No cells to subdivide");
+    return;
+    }
+  this->FreeSearchStructure();
+  vtkDebugMacro( << "Building static cell locator..." );
+
+  // Serial calls that build the cell structures of the dataset (e.g.
+  // vtkPolyData::BuildCells()), so that the parallel passes and the
+  // queries only read it.
+  double bounds[6];
+  this->DataSet->GetCellBounds(0, bounds);
+  this->DataSet->GetCellType(0);
+  this->MaxCellSize = this->DataSet->GetMaxCellSize();
+
+  // The cell bounds are kept for the queries.
+  this->CellBounds = new double[numCells][6];
+  std::vector<vtkStaticCellLocatorItem> items(numCells);
+  vtkStaticCellLocatorCellBounds cellBounds;
+  cellBounds.DataSet = this->DataSet;
+  cellBounds.Bounds = this->CellBounds;
+  cellBounds.Items = &items[0];
+  vtkSMPTools::For(0, numCells, cellBounds);
+
+  vtkStaticCellLocatorBuilder builder;
+  builder.Items = &items[0];
+  builder.LeafSize = this->NumberOfCellsPerNode;
+  builder.SplitMethod = this->SplitMethod;
+  builder.Parallel = true;
+
+  // The top levels are built one node at a time (each binned in parallel
+  // when large), until the subtrees are small enough to be built
+  // concurrently. The task size only depends on the number of cells.
+  std::vector<vtkStaticCellLocatorNode> nodes(1);
+  std::vector<vtkStaticCellLocatorBuilder::Task> tasks;
+  int depth = 0;
+  vtkIdType taskSize = std::max(static_cast<vtkIdType>(4096), numCells / 256);
+  vtkStaticCellLocatorRangeBounds rootBounds;
+  builder.ComputeBounds(0, numCells, rootBounds);
+  builder.BuildTop(nodes, 0, 0, numCells, 0, rootBounds, taskSize, tasks,
+                   depth);
+
+  std::vector<std::vector<vtkStaticCellLocatorNode> > subtrees(tasks.size());
+  std::vector<int> depths(tasks.size(), 0);
+  vtkStaticCellLocatorBuildTasks buildTasks;
+  buildTasks.Builder = builder;
+  buildTasks.Builder.Parallel = false;
+  buildTasks.Tasks = &tasks;
+  buildTasks.Subtrees = &subtrees;
+  buildTasks.Depths = &depths;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, buildTasks);
+
+  // Append the subtrees, in task order, to the top levels. The root of
+  // each subtree replaces its placeholder node, and the child indices are
+  // shifted to their place in the final array.
+  for (size_t t = 0; t < tasks.size(); t++)
+    {
+    std::vector<vtkStaticCellLocatorNode> &subtree = subtrees[t];
+    vtkIdType offset = static_cast<vtkIdType>(nodes.size()) - 1;
+    for (size_t i = 0; i < subtree.size(); i++)
+      {
+      if (subtree[i].Count == 0)
+        {
+        subtree[i].Index += offset;
+        }
+      }
+    nodes[tasks[t].Node] = subtree[0];
+    nodes.insert(nodes.end(), subtree.begin() + 1, subtree.end());
+    std::vector<vtkStaticCellLocatorNode>().swap(subtree);
+    depth = std::max(depth, depths[t]);
+    }
+
+  this->CellIds = new vtkIdType[numCells];
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    this->CellIds[i] = items[i].CellId;
+    }
+
+  this->NumberOfNodes = static_cast<vtkIdType>(nodes.size());
+  this->Nodes = new Node[this->NumberOfNodes];
+  std::copy(nodes.begin(), nodes.end(), this->Nodes);
+  this->Depth = depth;
+  this->Level = depth;
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::FindCellInLeaf(const Node *leaf,
+                                               double x[3], double tol2,
+                                               vtkGenericCell *cell,
+                                               double pcoords[3],
+                                               double *weights)
+{
+  double tol = sqrt(tol2), closest[3], dist2;
+  int subId;
+  for (vtkIdType i = 0; i < leaf->Count; i++)
+    {
+    vtkIdType cellId = this->CellIds[leaf->Index + i];
+    if ( vtkStaticCellLocatorInside(x, this->CellBounds[cellId], tol) )
+      {
+      this->DataSet->GetCell(cellId, cell);
+      if ( cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                  weights) == 1 && dist2 <= tol2 )
+        {
+        return cellId;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::FindCell(double x[3], double tol2,
+                                         vtkGenericCell *cell,
+                                         double pcoords[3], double *weights)
+{
+  if ( this->Nodes == NULL )
+    {
+    return -1;
+    }
+
+  double tol = sqrt(tol2);
+  vtkStaticCellLocatorStack stack;
+  stack.Push(0);
+  while ( !stack.Empty() )
+    {
+    const Node *node = this->Nodes + stack.Pop();
+    if ( !vtkStaticCellLocatorInside(x, node->Bounds, tol) )
+      {
+      continue;
+      }
+    if ( node->Count > 0 )
+      {
+      vtkIdType cellId =
+        this->FindCellInLeaf(node, x, tol2, cell, pcoords, weights);
+      if ( cellId >= 0 )
+        {
+        return cellId;
+        }
+      }
+    else
+      {
+      stack.Push(node->Index + 1);
+      stack.Push(node->Index);
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCells(vtkPoints *points, vtkIdList *cellIds,
+                                     double tol2)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numPts);
+  if ( this->Nodes == NULL )
+    {
+    for (vtkIdType i = 0; i < numPts; i++)
+      {
+      cellIds->SetId(i, -1);
+      }
+    return;
+    }
+
+  vtkStaticCellLocatorFindCells finder;
+  finder.Locator = this;
+  finder.DataSet = this->DataSet;
+  finder.Points = points;
+  finder.CellIds = cellIds->GetPointer(0);
+  finder.Tol2 = tol2;
+  finder.MaxCellSize = std::max(this->MaxCellSize, 1);
+  vtkSMPTools::For(0, numPts, finder);
+}
+
+//----------------------------------------------------------------------------
+int vtkStaticCellLocator::IntersectWithLine(double p1[3], double p2[3],
+                                            double tol, double& t,
+                                            double x[3], double pcoords[3],
+                                            int &subId, vtkIdType &cellId,
+                                            vtkGenericCell *cell)
+{
+  cellId = -1;
+  if ( this->Nodes == NULL )
+    {
+    return 0;
+    }
+
+  double dir[3] = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]};
+  double bestT = VTK_DOUBLE_MAX, tEnter, tCell, xCell[3], pcoordsCell[3];
+  int subIdCell;
+
+  // Visit the nodes front to back, and stop descending into nodes that
+  // the segment enters after the closest intersection found so far.
+  vtkStaticCellLocatorStack stack;
+  stack.Push(0);
+  while ( !stack.Empty() )
+    {
+    const Node *node = this->Nodes + stack.Pop();
+    if ( !vtkStaticCellLocatorClip(node->Bounds, p1, dir, tol, tEnter) ||
+         tEnter > bestT )
+      {
+      continue;
+      }
+    if ( node->Count > 0 )
+      {
+      for (vtkIdType i = 0; i < node->Count; i++)
+        {
+        vtkIdType id = this->CellIds[node->Index + i];
+        if ( !vtkStaticCellLocatorClip(this->CellBounds[id], p1, dir, tol,
+                                       tEnter) || tEnter > bestT )
+          {
+          continue;
+          }
+        this->DataSet->GetCell(id, cell);
+        if ( cell->IntersectWithLine(p1, p2, tol, tCell, xCell, pcoordsCell,
+                                     subIdCell) &&
+             (tCell < bestT || (tCell == bestT && id < cellId)) )
+          {
+          bestT = tCell;
+          cellId = id;
+          subId = subIdCell;
+          x[0] = xCell[0]; x[1] = xCell[1]; x[2] = xCell[2];
+          pcoords[0] = pcoordsCell[0];
+          pcoords[1] = pcoordsCell[1];
+          pcoords[2] = pcoordsCell[2];
+          }
+        }
+      }
+    else
+      {
+      const Node *left = this->Nodes + node->Index;
+      double tLeft = VTK_DOUBLE_MAX, tRight = VTK_DOUBLE_MAX;
+      vtkStaticCellLocatorClip(left->Bounds, p1, dir, tol, tLeft);
+      vtkStaticCellLocatorClip(left[1].Bounds, p1, dir, tol, tRight);
+      if ( tLeft <= tRight )
+        {
+        stack.Push(node->Index + 1);
+        stack.Push(node->Index);
+        }
+      else
+        {
+        stack.Push(node->Index);
+        stack.Push(node->Index + 1);
+        }
+      }
+    }
+
+  if ( cellId < 0 )
+    {
+    return 0;
+    }
+  t = bestT;
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindClosestPoint(double x[3],
+                                            double closestPoint[3],
+                                            vtkGenericCell *cell,
+                                            vtkIdType &cellId, int &subId,
+                                            double& dist2)
+{
+  int inside;
+  cellId = -1;
+  this->FindClosestPointWithinRadius(x, sqrt(VTK_DOUBLE_MAX), closestPoint,
+                                     cell, cellId, subId, dist2, inside);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::FindClosestPointWithinRadius(
+  double x[3], double radius, double closestPoint[3], vtkGenericCell *cell,
+  vtkIdType &cellId, int &subId, double& dist2, int &inside)
+{
+  if ( this->Nodes == NULL )
+    {
+    return 0;
+    }
+
+  double weightsBuffer[VTK_CELL_SIZE];
+  std::vector<double> weightsVector;
+  double *weights = weightsBuffer;
+  if ( this->MaxCellSize > VTK_CELL_SIZE )
+    {
+    weightsVector.resize(this->MaxCellSize);
+    weights = &weightsVector[0];
+    }
+
+  double minDist2 = radius * radius, point[3], pcoords[3], d2;
+  vtkIdType closest = -1;
+  int sub, result;
+
+  // Visit the closest child first so that the search radius shrinks fast.
+  vtkStaticCellLocatorStack stack;
+  stack.Push(0);
+  while ( !stack.Empty() )
+    {
+    const Node *node = this->Nodes + stack.Pop();
+    if ( vtkStaticCellLocatorDistance2(x, node->Bounds) > minDist2 )
+      {
+      continue;
+      }
+    if ( node->Count > 0 )
+      {
+      for (vtkIdType i = 0; i < node->Count; i++)
+        {
+        vtkIdType id = this->CellIds[node->Index + i];
+        if ( vtkStaticCellLocatorDistance2(x, this->CellBounds[id]) >
+             minDist2 )
+          {
+          continue;
+          }
+        this->DataSet->GetCell(id, cell);
+        result = cell->EvaluatePosition(x, point, sub, pcoords, d2, weights);
+        if ( result != -1 &&
+             (d2 < minDist2 ||
+              (d2 == minDist2 && (closest < 0 || id < closest))) )
+          {
+          closest = id;
+          minDist2 = d2;
+          subId = sub;
+          inside = result;
+          closestPoint[0] = point[0];
+          closestPoint[1] = point[1];
+          closestPoint[2] = point[2];
+          }
+        }
+      }
+    else
+      {
+      const Node *left = this->Nodes + node->Index;
+      if ( vtkStaticCellLocatorDistance2(x, left->Bounds) <=
+           vtkStaticCellLocatorDistance2(x, left[1].Bounds) )
+        {
+        stack.Push(node->Index + 1);
+        stack.Push(node->Index);
+        }
+      else
+        {
+        stack.Push(node->Index);
+        stack.Push(node->Index + 1);
+        }
+      }
+    }
+
+  if ( closest < 0 )
+    {
+    return 0;
+    }
+  cellId = closest;
+  dist2 = minDist2;
+  this->DataSet->GetCell(closest, cell);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCellsWithinBounds(double *bbox,
+                                                 vtkIdList *cells)
+{
+  cells->Reset();
+  if ( this->Nodes == NULL )
+    {
+    return;
+    }
+
+  vtkStaticCellLocatorStack stack;
+  stack.Push(0);
+  while ( !stack.Empty() )
+    {
+    const Node *node = this->Nodes + stack.Pop();
+    if ( !vtkStaticCellLocatorOverlap(bbox, node->Bounds) )
+      {
+      continue;
+      }
+    if ( node->Count > 0 )
+      {
+      for (vtkIdType i = 0; i < node->Count; i++)
+        {
+        vtkIdType id = this->CellIds[node->Index + i];
+        if ( vtkStaticCellLocatorOverlap(bbox, this->CellBounds[id]) )
+          {
+          cells->InsertNextId(id);
+          }
+        }
+      }
+    else
+      {
+      stack.Push(node->Index + 1);
+      stack.Push(node->Index);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCellsAlongLine(double p1[3], double p2[3],
+                                              double tolerance,
+                                              vtkIdList *cells)
+{
+  cells->Reset();
+  if ( this->Nodes == NULL )
+    {
+    return;
+    }
+
+  double dir[3] = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]}, tEnter;
+  vtkStaticCellLocatorStack stack;
+  stack.Push(0);
+  while ( !stack.Empty() )
+    {
+    const Node *node = this->Nodes + stack.Pop();
+    if ( !vtkStaticCellLocatorClip(node->Bounds, p1, dir, tolerance,
+                                   tEnter) )
+      {
+      continue;
+      }
+    if ( node->Count > 0 )
+      {
+      for (vtkIdType i = 0; i < node->Count; i++)
+        {
+        vtkIdType id = this->CellIds[node->Index + i];
+        if ( vtkStaticCellLocatorClip(this->CellBounds[id], p1, dir,
+                                      tolerance, tEnter) )
+          {
+          cells->InsertNextId(id);
+          }
+        }
+      }
+    else
+      {
+      stack.Push(node->Index + 1);
+      stack.Push(node->Index);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Output the boxes of the nodes at the given level, and of the leaves above
+// it.
+void vtkStaticCellLocator::GenerateRepresentation(int level, vtkPolyData *pd)
+{
+  if ( this->Nodes == NULL )
+    {
+    vtkErrorMacro(<<"Can't build representation...no data!");
+    return;
+    }
+
+  vtkPoints *pts = vtkPoints::New();
+  vtkCellArray *polys = vtkCellArray::New();
+  static const int faces[6][4] = {{0,2,6,4}, {1,5,7,3}, {0,4,5,1},
+                                  {2,3,7,6}, {0,1,3,2}, {4,6,7,5}};
+
+  std::vector<std::pair<vtkIdType, int> > stack;
+  stack.push_back(std::make_pair(static_cast<vtkIdType>(0), 0));
+  while ( !stack.empty() )
+    {
+    const Node *node = this->Nodes + stack.back().first;
+    int depth = stack.back().second;
+    stack.pop_back();
+    if ( node->Count == 0 && depth < level )
+      {
+      stack.push_back(std::make_pair(node->Index + 1, depth + 1));
+      stack.push_back(std::make_pair(node->Index, depth + 1));
+      continue;
+      }
+    vtkIdType ids[8], face[4];
+    for (int c = 0; c < 8; c++)
+      {
+      ids[c] = pts->InsertNextPoint(node->Bounds[c & 1 ? 1 : 0],
+                                    node->Bounds[c & 2 ? 3 : 2],
+                                    node->Bounds[c & 4 ? 5 : 4]);
+      }
+    for (int f = 0; f < 6; f++)
+      {
+      for (int i = 0; i < 4; i++)
+        {
+        face[i] = ids[faces[f][i]];
+        }
+      polys->InsertNextCell(4, face);
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Split Method: "
+     << (this->SplitMethod == VTK_STATIC_CELL_LOCATOR_SAH ? "SAH" : "Median")
+     << "\n";
+  os << indent << "Number Of Nodes: " << this->NumberOfNodes << "\n";
+  os << indent << "Depth: " << this->Depth << "\n";
+}
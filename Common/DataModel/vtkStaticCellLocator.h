@@ -0,0 +1,205 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticCellLocator - bounding volume hierarchy of cells, built in parallel with thread safe queries
+// .SECTION Description
+// vtkStaticCellLocator is a cell locator built as a bounding volume
+// hierarchy: a binary tree whose nodes hold the bounding box of their cells,
+// and whose leaves hold at most NumberOfCellsPerNode cells. The tree is
+// built once (bulk built) for a dataset and stored in flat arrays.
+//
+// BuildLocator() runs in parallel with vtkSMPTools. The cell bounds are
+// computed in parallel; the top levels of the tree are split one node at a
+// time with parallel binning of the cell centers, and the remaining
+// subtrees are then built concurrently. Nodes are split along the longest
+// axis of the cell centers, either at the best of a set of binned split
+// planes according to the surface area heuristic (SAH, the default) or at
+// the median. The tree does not depend on the number of threads.
+//
+// Unlike vtkCellLocator, vtkCellTreeLocator or vtkModifiedBSPTree, the
+// queries keep no state in the locator: the methods that take a
+// vtkGenericCell (and, for FindCell(), a weights buffer) only use those
+// caller supplied objects, so one locator may be shared by several threads
+// as long as each one passes its own cell and buffers. The overloads
+// without a vtkGenericCell use the locator's internal cell and are not
+// thread safe. FindCells() locates a batch of points in parallel.
+//
+// The locator must be built with BuildLocator() before it is queried.
+//
+// .SECTION See Also
+// vtkAbstractCellLocator vtkCellLocator vtkStaticPointLocator vtkSMPTools
+
+#ifndef __vtkStaticCellLocator_h
+#define __vtkStaticCellLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractCellLocator.h"
+
+class vtkCellArray;
+class vtkIdList;
+class vtkPoints;
+
+#define VTK_STATIC_CELL_LOCATOR_SAH    0
+#define VTK_STATIC_CELL_LOCATOR_MEDIAN 1
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticCellLocator : public vtkAbstractCellLocator
+{
+public:
+  // Description:
+  // Construct with the SAH split method and 8 cells per leaf.
+  static vtkStaticCellLocator *New();
+  vtkTypeMacro(vtkStaticCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Specify how the nodes of the tree are split: at the best binned split
+  // plane according to the surface area heuristic, or at the median cell
+  // center. SAH trees are faster to query for cells of varying sizes;
+  // median trees are balanced and faster to build.
+  vtkSetClampMacro(SplitMethod,int,VTK_STATIC_CELL_LOCATOR_SAH,
+                   VTK_STATIC_CELL_LOCATOR_MEDIAN);
+  vtkGetMacro(SplitMethod,int);
+  void SetSplitMethodToSAH()
+    {this->SetSplitMethod(VTK_STATIC_CELL_LOCATOR_SAH);}
+  void SetSplitMethodToMedian()
+    {this->SetSplitMethod(VTK_STATIC_CELL_LOCATOR_MEDIAN);}
+
+  // Description:
+  // Find the cell containing the point x, or -1 if there is none. The cell,
+  // parametric coordinates and interpolation weights of the point are
+  // returned in the caller supplied objects. Thread safe.
+  virtual vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                             double pcoords[3], double *weights);
+
+  // Description:
+  // Find the cells containing a batch of points, in parallel. cellIds
+  // receives one id per point, -1 for points outside of all cells.
+  // Consecutive points that fall in the same cell are located without
+  // traversing the tree.
+  void FindCells(vtkPoints *points, vtkIdList *cellIds, double tol2 = 0.0);
+
+  // Description:
+  // Return the intersection of the finite line (p1,p2) closest to p1 and
+  // the cell it lies in. Thread safe.
+  virtual int IntersectWithLine(double p1[3], double p2[3], double tol,
+                                double& t, double x[3], double pcoords[3],
+                                int &subId, vtkIdType &cellId,
+                                vtkGenericCell *cell);
+
+  // Description:
+  // Return the closest point to x on the cells, and the cell it lies in.
+  // Thread safe.
+  virtual void FindClosestPoint(double x[3], double closestPoint[3],
+                                vtkGenericCell *cell, vtkIdType &cellId,
+                                int &subId, double& dist2);
+
+  // Description:
+  // Return the closest point to x on the cells within the given radius.
+  // Returns 1 if a point is found, 0 otherwise. Thread safe.
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3],
+    vtkGenericCell *cell, vtkIdType &cellId, int &subId, double& dist2,
+    int &inside);
+
+  // Description:
+  // Return the cells whose bounds intersect a bounding box, or a finite
+  // line padded by a tolerance. Thread safe.
+  virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+  virtual void FindCellsAlongLine(double p1[3], double p2[3],
+                                  double tolerance, vtkIdList *cells);
+
+  // Description:
+  // Reimplemented from vtkAbstractCellLocator so that they are not hidden
+  // by the overloads above. These use the locator's internal cell and are
+  // not thread safe.
+  virtual vtkIdType FindCell(double x[3])
+    {return this->Superclass::FindCell(x);}
+  virtual int IntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId)
+    {return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords,
+                                                subId);}
+  virtual int IntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId)
+    {return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords,
+                                                subId, cellId);}
+  virtual int IntersectWithLine(
+    const double p1[3], const double p2[3],
+    vtkPoints *points, vtkIdList *cellIds)
+    {return this->Superclass::IntersectWithLine(p1, p2, points, cellIds);}
+  virtual void FindClosestPoint(
+    double x[3], double closestPoint[3],
+    vtkIdType &cellId, int &subId, double& dist2)
+    {this->Superclass::FindClosestPoint(x, closestPoint, cellId, subId,
+                                        dist2);}
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3],
+    vtkIdType &cellId, int &subId, double& dist2)
+    {return this->Superclass::FindClosestPointWithinRadius(
+        x, radius, closestPoint, cellId, subId, dist2);}
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3],
+    vtkGenericCell *cell, vtkIdType &cellId, int &subId, double& dist2)
+    {return this->Superclass::FindClosestPointWithinRadius(
+        x, radius, closestPoint, cell, cellId, subId, dist2);}
+
+  // Description:
+  // Return the number of nodes of the tree, and its depth.
+  vtkIdType GetNumberOfNodes()
+    {return this->NumberOfNodes;}
+  vtkGetMacro(Depth,int);
+
+  // Description:
+  // Satisfy vtkLocator abstract interface. BuildLocator() is not thread
+  // safe. GenerateRepresentation() outputs the boxes of the nodes at the
+  // given level (or of the shallower leaves).
+  virtual void FreeSearchStructure();
+  virtual void BuildLocator();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+//BTX
+  // Nodes of the tree. Internal nodes (Count == 0) have their two children
+  // at Index and Index+1; leaves hold the cells
+  // CellIds[Index..Index+Count).
+  struct Node
+  {
+    double Bounds[6];
+    vtkIdType Index;
+    vtkIdType Count;
+  };
+//ETX
+
+protected:
+  vtkStaticCellLocator();
+  ~vtkStaticCellLocator();
+
+  // Test the cells of a leaf for FindCell().
+  vtkIdType FindCellInLeaf(const Node *leaf, double x[3], double tol2,
+                           vtkGenericCell *cell, double pcoords[3],
+                           double *weights);
+
+  int SplitMethod;
+  int Depth;
+  int MaxCellSize;
+  vtkIdType NumberOfNodes;
+  Node *Nodes;
+  vtkIdType *CellIds;
+
+private:
+  vtkStaticCellLocator(const vtkStaticCellLocator&);  // Not implemented.
+  void operator=(const vtkStaticCellLocator&);  // Not implemented.
+};
+
+#endif
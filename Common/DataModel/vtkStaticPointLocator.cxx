@@ -0,0 +1,823 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticPointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticPointLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkStaticPointLocator);
+
+namespace
+{
+//----------------------------------------------------------------------------
+// A point and the bucket it falls in. Sorting these pairs groups the points
+// by bucket, in increasing point id order within each bucket.
+struct vtkStaticPointLocatorTuple
+{
+  vtkIdType Bucket;
+  vtkIdType PtId;
+
+  bool operator<(const vtkStaticPointLocatorTuple &other) const
+    {
+    return this->Bucket < other.Bucket ||
+      (this->Bucket == other.Bucket && this->PtId < other.PtId);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Compute the bucket of each point. Points is NULL when the coordinates
+// are not available as a contiguous array of type T.
+template <class T>
+class vtkStaticPointLocatorBinPoints
+{
+public:
+  const T *Points;
+  vtkDataSet *DataSet;
+  vtkStaticPointLocator *Locator;
+  vtkStaticPointLocatorTuple *Map;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      if (this->Points)
+        {
+        const T *p = this->Points + 3*ptId;
+        x[0] = p[0];
+        x[1] = p[1];
+        x[2] = p[2];
+        }
+      else
+        {
+        this->DataSet->GetPoint(ptId, x);
+        }
+      this->Map[ptId].Bucket = this->Locator->GetBucketIndex(x);
+      this->Map[ptId].PtId = ptId;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Extract the point ids from the sorted map, and the offset of each bucket
+// from the positions where the bucket changes. Empty buckets get the
+// offset of the next non-empty one.
+class vtkStaticPointLocatorOffsets
+{
+public:
+  const vtkStaticPointLocatorTuple *Map;
+  vtkIdType *Offsets;
+  vtkIdType *BucketPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->BucketPoints[i] = this->Map[i].PtId;
+      vtkIdType prev = (i > 0 ? this->Map[i-1].Bucket : -1);
+      for (vtkIdType bucket = prev + 1; bucket <= this->Map[i].Bucket;
+           bucket++)
+        {
+        this->Offsets[bucket] = i;
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Visit the buckets at Chebyshev distance level from the bucket ijk, that
+// is the shell of the block of (2*level+1)^3 buckets around it, clipped to
+// the grid.
+template <class Visitor>
+void vtkStaticPointLocatorVisitShell(const int divs[3], const int ijk[3],
+                                     int level, Visitor &visitor)
+{
+  int lo[3], hi[3], nei[3];
+  for (int i = 0; i < 3; i++)
+    {
+    lo[i] = std::max(0, ijk[i] - level);
+    hi[i] = std::min(divs[i] - 1, ijk[i] + level);
+    }
+  for (nei[2] = lo[2]; nei[2] <= hi[2]; nei[2]++)
+    {
+    bool kFace = (nei[2] == ijk[2] - level || nei[2] == ijk[2] + level);
+    for (nei[1] = lo[1]; nei[1] <= hi[1]; nei[1]++)
+      {
+      if (kFace || nei[1] == ijk[1] - level || nei[1] == ijk[1] + level)
+        {
+        for (nei[0] = lo[0]; nei[0] <= hi[0]; nei[0]++)
+          {
+          visitor.Visit(nei);
+          }
+        }
+      else
+        {
+        // Only the two ends of the row belong to the shell.
+        nei[0] = ijk[0] - level;
+        if (nei[0] >= 0)
+          {
+          visitor.Visit(nei);
+          }
+        nei[0] = ijk[0] + level;
+        if (nei[0] < divs[0])
+          {
+          visitor.Visit(nei);
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Keep the closest point seen so far.
+class vtkStaticPointLocatorClosest
+{
+public:
+  vtkStaticPointLocator *Locator;
+  const double *X;
+  vtkIdType Closest;
+  double MinDist2;
+
+  void Visit(const int ijk[3]);
+};
+
+//----------------------------------------------------------------------------
+// Keep the closest N points seen so far, sorted by distance and then by id.
+class vtkStaticPointLocatorClosestN
+{
+public:
+  typedef std::pair<double, vtkIdType> DistanceAndId;
+
+  vtkStaticPointLocator *Locator;
+  const double *X;
+  size_t N;
+  std::vector<DistanceAndId> Best;
+
+  double GetMaxDist2() const
+    {
+    return this->Best.size() < this->N ? VTK_DOUBLE_MAX :
+      this->Best.back().first;
+    }
+
+  void Visit(const int ijk[3]);
+};
+}
+
+// Give the search helpers access to the bucket structure.
+class vtkStaticPointLocatorAccess
+{
+public:
+  static double Distance2ToBucket(vtkStaticPointLocator *locator,
+                                  const double x[3], const int ijk[3])
+    {
+    return locator->Distance2ToBucket(x, ijk);
+    }
+  static const vtkIdType *GetBucket(vtkStaticPointLocator *locator,
+                                    const int ijk[3], vtkIdType &npts)
+    {
+    vtkIdType bucket = ijk[0] + static_cast<vtkIdType>(locator->Divisions[0]) *
+      (ijk[1] + static_cast<vtkIdType>(locator->Divisions[1]) * ijk[2]);
+    npts = locator->Offsets[bucket+1] - locator->Offsets[bucket];
+    return locator->BucketPoints + locator->Offsets[bucket];
+    }
+  static void GetPoint(vtkStaticPointLocator *locator, vtkIdType ptId,
+                       double x[3])
+    {
+    locator->GetPoint(ptId, x);
+    }
+};
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocatorClosest::Visit(const int ijk[3])
+{
+  if (vtkStaticPointLocatorAccess::Distance2ToBucket(
+        this->Locator, this->X, ijk) > this->MinDist2)
+    {
+    return;
+    }
+  vtkIdType npts;
+  const vtkIdType *ptIds =
+    vtkStaticPointLocatorAccess::GetBucket(this->Locator, ijk, npts);
+  double pt[3];
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    vtkStaticPointLocatorAccess::GetPoint(this->Locator, ptIds[i], pt);
+    double dist2 = vtkMath::Distance2BetweenPoints(this->X, pt);
+    if (dist2 < this->MinDist2 ||
+        (dist2 == this->MinDist2 &&
+         (this->Closest < 0 || ptIds[i] < this->Closest)))
+      {
+      this->Closest = ptIds[i];
+      this->MinDist2 = dist2;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocatorClosestN::Visit(const int ijk[3])
+{
+  if (vtkStaticPointLocatorAccess::Distance2ToBucket(
+        this->Locator, this->X, ijk) > this->GetMaxDist2())
+    {
+    return;
+    }
+  vtkIdType npts;
+  const vtkIdType *ptIds =
+    vtkStaticPointLocatorAccess::GetBucket(this->Locator, ijk, npts);
+  double pt[3];
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    vtkStaticPointLocatorAccess::GetPoint(this->Locator, ptIds[i], pt);
+    DistanceAndId candidate(vtkMath::Distance2BetweenPoints(this->X, pt),
+                            ptIds[i]);
+    if (this->Best.size() == this->N)
+      {
+      if (!(candidate < this->Best.back()))
+        {
+        continue;
+        }
+      this->Best.pop_back();
+      }
+    this->Best.insert(std::upper_bound(this->Best.begin(), this->Best.end(),
+                                       candidate), candidate);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Construct with automatic computation of divisions, averaging
+// 5 points per bucket.
+vtkStaticPointLocator::vtkStaticPointLocator()
+{
+  this->Divisions[0] = this->Divisions[1] = this->Divisions[2] = 50;
+  this->NumberOfPointsPerBucket = 5;
+  this->H[0] = this->H[1] = this->H[2] = 0.0;
+  this->NumberOfBuckets = 0;
+  this->Offsets = NULL;
+  this->BucketPoints = NULL;
+  this->FloatPoints = NULL;
+  this->DoublePoints = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticPointLocator::~vtkStaticPointLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FreeSearchStructure()
+{
+  delete [] this->Offsets;
+  delete [] this->BucketPoints;
+  this->Offsets = NULL;
+  this->BucketPoints = NULL;
+  this->FloatPoints = NULL;
+  this->DoublePoints = NULL;
+  this->NumberOfBuckets = 0;
+}
+
+//----------------------------------------------------------------------------
+inline void vtkStaticPointLocator::GetPoint(vtkIdType ptId, double x[3])
+{
+  if (this->FloatPoints)
+    {
+    const float *p = this->FloatPoints + 3*ptId;
+    x[0] = p[0];
+    x[1] = p[1];
+    x[2] = p[2];
+    }
+  else if (this->DoublePoints)
+    {
+    const double *p = this->DoublePoints + 3*ptId;
+    x[0] = p[0];
+    x[1] = p[1];
+    x[2] = p[2];
+    }
+  else
+    {
+    this->DataSet->GetPoint(ptId, x);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketIndices(const double x[3], int ijk[3])
+{
+  for (int i = 0; i < 3; i++)
+    {
+    double t = (x[i] - this->Bounds[2*i]) / this->H[i];
+    if (!(t > 0.0)) // also catches NaN
+      {
+      ijk[i] = 0;
+      }
+    else if (t >= this->Divisions[i])
+      {
+      ijk[i] = this->Divisions[i] - 1;
+      }
+    else
+      {
+      ijk[i] = static_cast<int>(t);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::GetBucketIndex(const double x[3])
+{
+  int ijk[3];
+  this->GetBucketIndices(x, ijk);
+  return ijk[0] + static_cast<vtkIdType>(this->Divisions[0]) *
+    (ijk[1] + static_cast<vtkIdType>(this->Divisions[1]) * ijk[2]);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketIds(vtkIdType bucketId,
+                                         vtkIdList *bucketIds)
+{
+  vtkIdType npts = this->GetNumberOfPointsInBucket(bucketId);
+  bucketIds->SetNumberOfIds(npts);
+  if (npts > 0)
+    {
+    std::copy(this->BucketPoints + this->Offsets[bucketId],
+              this->BucketPoints + this->Offsets[bucketId+1],
+              bucketIds->GetPointer(0));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::BuildLocator()
+{
+  vtkIdType numPts;
+  int i;
+
+  if ( (this->Offsets != NULL) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+    {
+    return;
+    }
+
+  vtkDebugMacro( << "Binning points..." );
+  this->Level = 1; //only single lowest level
+
+  if ( !this->DataSet || (numPts = this->DataSet->GetNumberOfPoints()) < 1 )
+    {
+    vtkErrorMacro( << "No points to subdivide");
+    return;
+    }
+  this->FreeSearchStructure();
+
+  // Size the buckets. Unlike vtkPointLocator, automatic divisions follow
+  // the aspect ratio of the bounds so that buckets are roughly cubical.
+  // The directions thinner than a bucket get a single division, and the
+  // bucket size is computed over the other directions only (an area for
+  // nearly flat bounds, a length for nearly linear ones), so that the
+  // number of buckets stays close to the target.
+  double *bounds = this->DataSet->GetBounds();
+  int ndivs[3];
+  if ( this->Automatic )
+    {
+    double target = static_cast<double>(numPts) /
+      this->NumberOfPointsPerBucket;
+    bool active[3];
+    for (i=0; i<3; i++)
+      {
+      active[i] = (bounds[2*i+1] > bounds[2*i]);
+      }
+    double h = VTK_DOUBLE_MAX;
+    bool changed = (target > 1.0);
+    while ( changed )
+      {
+      double size = 1.0;
+      int ndims = 0;
+      for (i=0; i<3; i++)
+        {
+        if ( active[i] )
+          {
+          size *= bounds[2*i+1] - bounds[2*i];
+          ndims++;
+          }
+        }
+      h = (ndims > 0 ? pow(size / target, 1.0 / ndims) : VTK_DOUBLE_MAX);
+      changed = false;
+      for (i=0; i<3; i++)
+        {
+        if ( active[i] && bounds[2*i+1] - bounds[2*i] < h )
+          {
+          active[i] = false;
+          changed = true;
+          }
+        }
+      }
+    for (i=0; i<3; i++)
+      {
+      double div = (active[i] ? (bounds[2*i+1] - bounds[2*i]) / h : 1.0);
+      ndivs[i] = static_cast<int>(std::min(div, target) + 0.5);
+      }
+    }
+  else
+    {
+    for (i=0; i<3; i++)
+      {
+      ndivs[i] = this->Divisions[i];
+      }
+    }
+
+  for (i=0; i<3; i++)
+    {
+    ndivs[i] = (ndivs[i] > 0 ? ndivs[i] : 1);
+    this->Divisions[i] = ndivs[i];
+    this->Bounds[2*i] = bounds[2*i];
+    this->Bounds[2*i+1] = bounds[2*i+1];
+    if ( this->Bounds[2*i+1] <= this->Bounds[2*i] ) //prevent zero width
+      {
+      this->Bounds[2*i+1] = this->Bounds[2*i] + 1.0;
+      }
+    this->H[i] = (this->Bounds[2*i+1] - this->Bounds[2*i]) / ndivs[i];
+    }
+  this->NumberOfBuckets = static_cast<vtkIdType>(ndivs[0]) * ndivs[1] *
+    ndivs[2];
+
+  // Direct access to the coordinates makes the binning and the queries
+  // much faster than vtkDataSet::GetPoint().
+  vtkPointSet *ps = vtkPointSet::SafeDownCast(this->DataSet);
+  if ( ps && ps->GetPoints() )
+    {
+    vtkPoints *points = ps->GetPoints();
+    if ( points->GetDataType() == VTK_FLOAT )
+      {
+      this->FloatPoints = static_cast<float*>(points->GetVoidPointer(0));
+      }
+    else if ( points->GetDataType() == VTK_DOUBLE )
+      {
+      this->DoublePoints = static_cast<double*>(points->GetVoidPointer(0));
+      }
+    }
+
+  // Bin the points, then group them by bucket.
+  vtkStaticPointLocatorTuple *map = new vtkStaticPointLocatorTuple[numPts];
+  if ( this->FloatPoints )
+    {
+    vtkStaticPointLocatorBinPoints<float> binner;
+    binner.Points = this->FloatPoints;
+    binner.DataSet = this->DataSet;
+    binner.Locator = this;
+    binner.Map = map;
+    vtkSMPTools::For(0, numPts, binner);
+    }
+  else
+    {
+    vtkStaticPointLocatorBinPoints<double> binner;
+    binner.Points = this->DoublePoints;
+    binner.DataSet = this->DataSet;
+    binner.Locator = this;
+    binner.Map = map;
+    vtkSMPTools::For(0, numPts, binner);
+    }
+  vtkSMPTools::Sort(map, map + numPts);
+
+  this->Offsets = new vtkIdType[this->NumberOfBuckets + 1];
+  this->BucketPoints = new vtkIdType[numPts];
+  vtkStaticPointLocatorOffsets offsets;
+  offsets.Map = map;
+  offsets.Offsets = this->Offsets;
+  offsets.BucketPoints = this->BucketPoints;
+  vtkSMPTools::For(0, numPts, offsets);
+  for (vtkIdType bucket = map[numPts-1].Bucket + 1;
+       bucket <= this->NumberOfBuckets; bucket++)
+    {
+    this->Offsets[bucket] = numPts;
+    }
+  delete [] map;
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+double vtkStaticPointLocator::Distance2ToBucket(const double x[3],
+                                               const int ijk[3])
+{
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; i++)
+    {
+    // Use the bounds themselves for the outer faces of the grid so that
+    // round-off cannot leave a point outside of its bucket.
+    double lo = (ijk[i] == 0 ? this->Bounds[2*i] :
+                 this->Bounds[2*i] + ijk[i] * this->H[i]);
+    double hi = (ijk[i] == this->Divisions[i] - 1 ? this->Bounds[2*i+1] :
+                 this->Bounds[2*i] + (ijk[i] + 1) * this->H[i]);
+    double d = 0.0;
+    if ( x[i] < lo )
+      {
+      d = lo - x[i];
+      }
+    else if ( x[i] > hi )
+      {
+      d = x[i] - hi;
+      }
+    dist2 += d * d;
+    }
+  return dist2;
+}
+
+//----------------------------------------------------------------------------
+double vtkStaticPointLocator::DistanceToUnsearched(const double x[3],
+                                                  const int ijk[3],
+                                                  int level)
+{
+  double minDist = VTK_DOUBLE_MAX;
+  bool covered = true;
+  for (int i = 0; i < 3; i++)
+    {
+    if ( ijk[i] - level > 0 )
+      {
+      covered = false;
+      minDist = std::min(minDist, x[i] -
+                         (this->Bounds[2*i] + (ijk[i] - level) * this->H[i]));
+      }
+    if ( ijk[i] + level < this->Divisions[i] - 1 )
+      {
+      covered = false;
+      minDist = std::min(minDist,
+                         (this->Bounds[2*i] + (ijk[i] + level + 1) *
+                          this->H[i]) - x[i]);
+      }
+    }
+  return covered ? -1.0 : std::max(minDist, 0.0);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPointWithinDistance2(
+  const double x[3], double maxDist2, double &dist2)
+{
+  this->BuildLocator();
+  dist2 = -1.0;
+  if ( !this->Offsets )
+    {
+    return -1;
+    }
+
+  // Search shells of buckets of increasing size around the bucket of x,
+  // until no unsearched bucket can be closer than the best point.
+  vtkStaticPointLocatorClosest closest;
+  closest.Locator = this;
+  closest.X = x;
+  closest.Closest = -1;
+  closest.MinDist2 = maxDist2;
+  int ijk[3];
+  this->GetBucketIndices(x, ijk);
+  for (int level = 0; ; level++)
+    {
+    vtkStaticPointLocatorVisitShell(this->Divisions, ijk, level, closest);
+    double dist = this->DistanceToUnsearched(x, ijk, level);
+    if ( dist < 0.0 || dist * dist > closest.MinDist2 )
+      {
+      break;
+      }
+    }
+
+  if ( closest.Closest >= 0 )
+    {
+    dist2 = closest.MinDist2;
+    }
+  return closest.Closest;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPoint(const double x[3])
+{
+  double dist2;
+  return this->FindClosestPointWithinDistance2(x, VTK_DOUBLE_MAX, dist2);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPointWithinRadius(
+  double radius, const double x[3], double& dist2)
+{
+  return this->FindClosestPointWithinDistance2(x, radius * radius, dist2);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPoints(int N, const double x[3],
+                                               vtkIdList *result)
+{
+  result->Reset();
+  this->BuildLocator();
+  if ( !this->Offsets || N < 1 )
+    {
+    return;
+    }
+
+  vtkStaticPointLocatorClosestN closest;
+  closest.Locator = this;
+  closest.X = x;
+  closest.N = static_cast<size_t>(N);
+  closest.Best.reserve(closest.N + 1);
+  int ijk[3];
+  this->GetBucketIndices(x, ijk);
+  for (int level = 0; ; level++)
+    {
+    vtkStaticPointLocatorVisitShell(this->Divisions, ijk, level, closest);
+    double dist = this->DistanceToUnsearched(x, ijk, level);
+    if ( dist < 0.0 || dist * dist > closest.GetMaxDist2() )
+      {
+      break;
+      }
+    }
+
+  vtkIdType numIds = static_cast<vtkIdType>(closest.Best.size());
+  result->SetNumberOfIds(numIds);
+  for (vtkIdType i = 0; i < numIds; i++)
+    {
+    result->SetId(i, closest.Best[i].second);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadius(double R,
+                                                   const double x[3],
+                                                   vtkIdList *result)
+{
+  result->Reset();
+  this->BuildLocator();
+  if ( !this->Offsets || R < 0.0 )
+    {
+    return;
+    }
+
+  double R2 = R * R;
+  double lo[3], hi[3];
+  int ijkMin[3], ijkMax[3], ijk[3];
+  for (int i = 0; i < 3; i++)
+    {
+    lo[i] = x[i] - R;
+    hi[i] = x[i] + R;
+    }
+  this->GetBucketIndices(lo, ijkMin);
+  this->GetBucketIndices(hi, ijkMax);
+
+  double pt[3];
+  for (ijk[2] = ijkMin[2]; ijk[2] <= ijkMax[2]; ijk[2]++)
+    {
+    for (ijk[1] = ijkMin[1]; ijk[1] <= ijkMax[1]; ijk[1]++)
+      {
+      for (ijk[0] = ijkMin[0]; ijk[0] <= ijkMax[0]; ijk[0]++)
+        {
+        if ( this->Distance2ToBucket(x, ijk) > R2 )
+          {
+          continue;
+          }
+        vtkIdType npts;
+        const vtkIdType *ptIds =
+          vtkStaticPointLocatorAccess::GetBucket(this, ijk, npts);
+        for (vtkIdType j = 0; j < npts; j++)
+          {
+          this->GetPoint(ptIds[j], pt);
+          if ( vtkMath::Distance2BetweenPoints(x, pt) <= R2 )
+            {
+            result->InsertNextId(ptIds[j]);
+            }
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Build a polygonal representation of the boundary between non-empty and
+// empty buckets.
+void vtkStaticPointLocator::GenerateRepresentation(int vtkNotUsed(level),
+                                                   vtkPolyData *pd)
+{
+  if ( this->Offsets == NULL )
+    {
+    vtkErrorMacro(<<"Can't build representation...no data!");
+    return;
+    }
+
+  vtkPoints *pts = vtkPoints::New();
+  pts->Allocate(5000);
+  vtkCellArray *polys = vtkCellArray::New();
+  polys->Allocate(10000);
+
+  int ijk[3], nei[3];
+  for (ijk[2] = 0; ijk[2] < this->Divisions[2]; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < this->Divisions[1]; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < this->Divisions[0]; ijk[0]++)
+        {
+        vtkIdType npts;
+        vtkStaticPointLocatorAccess::GetBucket(this, ijk, npts);
+        bool inside = (npts > 0);
+
+        for (int ii = 0; ii < 3; ii++)
+          {
+          // "negative" neighbor
+          nei[0] = ijk[0];
+          nei[1] = ijk[1];
+          nei[2] = ijk[2];
+          nei[ii]--;
+          if ( nei[ii] < 0 )
+            {
+            if ( inside )
+              {
+              this->GenerateFace(ii, ijk[0], ijk[1], ijk[2], pts, polys);
+              }
+            }
+          else
+            {
+            vtkIdType nptsNei;
+            vtkStaticPointLocatorAccess::GetBucket(this, nei, nptsNei);
+            if ( (nptsNei > 0) != inside )
+              {
+              this->GenerateFace(ii, ijk[0], ijk[1], ijk[2], pts, polys);
+              }
+            }
+
+          // buckets on "positive" boundaries generate their outer face
+          if ( inside && ijk[ii] + 1 >= this->Divisions[ii] )
+            {
+            nei[0] = ijk[0];
+            nei[1] = ijk[1];
+            nei[2] = ijk[2];
+            nei[ii]++;
+            this->GenerateFace(ii, nei[0], nei[1], nei[2], pts, polys);
+            }
+          }
+        }
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GenerateFace(int face, int i, int j, int k,
+                                         vtkPoints *pts, vtkCellArray *polys)
+{
+  vtkIdType ids[4];
+  double origin[3], x[3];
+
+  // define first corner
+  origin[0] = this->Bounds[0] + i * this->H[0];
+  origin[1] = this->Bounds[2] + j * this->H[1];
+  origin[2] = this->Bounds[4] + k * this->H[2];
+  ids[0] = pts->InsertNextPoint(origin);
+
+  // the two edges of the face
+  int u = (face + 1) % 3;
+  int v = (face + 2) % 3;
+  if ( face == 1 ) // keep the orientation used by vtkPointLocator
+    {
+    std::swap(u, v);
+    }
+
+  x[0] = origin[0];
+  x[1] = origin[1];
+  x[2] = origin[2];
+  x[u] += this->H[u];
+  ids[1] = pts->InsertNextPoint(x);
+  x[v] += this->H[v];
+  ids[2] = pts->InsertNextPoint(x);
+  x[u] = origin[u];
+  ids[3] = pts->InsertNextPoint(x);
+
+  polys->InsertNextCell(4,ids);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number of Points Per Bucket: "
+     << this->NumberOfPointsPerBucket << "\n";
+  os << indent << "Divisions: (" << this->Divisions[0] << ", "
+     << this->Divisions[1] << ", " << this->Divisions[2] << ")\n";
+  os << indent << "Number of Buckets: " << this->NumberOfBuckets << "\n";
+}
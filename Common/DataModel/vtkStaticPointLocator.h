@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticPointLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticPointLocator - quickly locate points in 3-space, built in parallel
+// .SECTION Description
+// vtkStaticPointLocator is a spatial search object to quickly locate points
+// in 3D. Like vtkPointLocator it divides a bounding box into a regular
+// array of rectangular buckets, but it is built once for a fixed set of
+// points: no points can be inserted afterwards (use vtkPointLocator for
+// incremental point insertion and merging).
+//
+// In exchange, the bucket contents are stored in two flat arrays, an
+// offsets array (one entry per bucket, plus one) and an array of point ids
+// sorted by bucket. BuildLocator() runs in parallel with vtkSMPTools: the
+// bucket of each point is computed independently, the (bucket, point id)
+// pairs are sorted, and the offsets are derived from the sorted pairs. Point
+// ids within a bucket are in increasing order, so the locator does not depend
+// on the number of threads.
+//
+// Once the locator is built, all the queries (FindClosestPoint(),
+// FindClosestPointWithinRadius(), FindClosestNPoints() and
+// FindPointsWithinRadius()) only read the search structure and may be called
+// from several threads at once, for example from a vtkSMPTools functor in
+// probing, glyphing or interpolation code. Call BuildLocator() before
+// starting the threads; the queries build the locator if necessary, which is
+// not thread safe.
+//
+// .SECTION Caveats
+// Points at equal distance from the query point are resolved in favor of the
+// smallest point id.
+//
+// .SECTION See Also
+// vtkPointLocator vtkKdTreePointLocator vtkStaticCellLinks vtkSMPTools
+
+#ifndef __vtkStaticPointLocator_h
+#define __vtkStaticPointLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractPointLocator.h"
+
+class vtkCellArray;
+class vtkIdList;
+class vtkPoints;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticPointLocator : public vtkAbstractPointLocator
+{
+public:
+  // Description:
+  // Construct with automatic computation of divisions, averaging
+  // 5 points per bucket.
+  static vtkStaticPointLocator *New();
+  vtkTypeMacro(vtkStaticPointLocator,vtkAbstractPointLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the number of divisions in x-y-z directions. Only used when
+  // Automatic is off.
+  vtkSetVector3Macro(Divisions,int);
+  vtkGetVectorMacro(Divisions,int,3);
+
+  // Description:
+  // Specify the average number of points in each bucket when Automatic
+  // is on.
+  vtkSetClampMacro(NumberOfPointsPerBucket,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfPointsPerBucket,int);
+
+  // Description:
+  // Given a position x, return the id of the point closest to it, or -1 if
+  // there are no points. These methods are thread safe once the locator is
+  // built.
+  virtual vtkIdType FindClosestPoint(const double x[3]);
+
+  // Description:
+  // Given a position x and a radius, return the id of the closest point
+  // within the radius (or -1 if there is none) and its squared distance
+  // dist2.
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double radius, const double x[3], double& dist2);
+
+  // Description:
+  // Find the closest N points to a position, sorted from closest to
+  // farthest. Fewer ids are returned if the dataset has less than N points.
+  virtual void FindClosestNPoints(int N, const double x[3], vtkIdList *result);
+
+  // Description:
+  // Find all points within a specified radius R of position x. The result
+  // is not sorted by distance.
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result);
+
+  // Description:
+  // Given a position x, return the index of the bucket containing it
+  // (positions outside the bounds are clamped to the nearest bucket).
+  vtkIdType GetBucketIndex(const double x[3]);
+
+  // Description:
+  // Return the number of buckets, the number of points in a bucket, and
+  // the (sorted) ids of the points in a bucket.
+  vtkGetMacro(NumberOfBuckets,vtkIdType);
+  vtkIdType GetNumberOfPointsInBucket(vtkIdType bucketId)
+    {return this->Offsets ?
+       this->Offsets[bucketId+1] - this->Offsets[bucketId] : 0;}
+  void GetBucketIds(vtkIdType bucketId, vtkIdList *bucketIds);
+
+  // Description:
+  // See vtkLocator interface documentation.
+  // These methods are not thread safe.
+  virtual void FreeSearchStructure();
+  virtual void BuildLocator();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+protected:
+  vtkStaticPointLocator();
+  ~vtkStaticPointLocator();
+
+  //BTX
+  friend class vtkStaticPointLocatorAccess;
+  //ETX
+
+  // Compute the (clamped) bucket indices of a position.
+  void GetBucketIndices(const double x[3], int ijk[3]);
+
+  // Squared distance from x to the bucket (i,j,k); zero inside it.
+  double Distance2ToBucket(const double x[3], const int ijk[3]);
+
+  // Distance from x to the nearest bucket outside the block of buckets
+  // within level of ijk, or a negative value if the block covers all of
+  // the buckets.
+  double DistanceToUnsearched(const double x[3], const int ijk[3],
+                              int level);
+
+  // Find the closest point with a squared distance not larger than
+  // maxDist2, -1 if there is none.
+  vtkIdType FindClosestPointWithinDistance2(const double x[3],
+                                            double maxDist2, double &dist2);
+
+  // Thread safe access to the coordinates of a point.
+  void GetPoint(vtkIdType ptId, double x[3]);
+
+  void GenerateFace(int face, int i, int j, int k,
+                    vtkPoints *pts, vtkCellArray *polys);
+
+  int Divisions[3];
+  int NumberOfPointsPerBucket;
+  double H[3];
+  vtkIdType NumberOfBuckets;
+
+  // Bucket b holds the point ids BucketPoints[Offsets[b]..Offsets[b+1]).
+  vtkIdType *Offsets;
+  vtkIdType *BucketPoints;
+
+  // Direct pointers to the point coordinates of vtkPointSet inputs.
+  const float *FloatPoints;
+  const double *DoublePoints;
+
+private:
+  vtkStaticPointLocator(const vtkStaticPointLocator&);  // Not implemented.
+  void operator=(const vtkStaticPointLocator&);  // Not implemented.
+};
+
+#endif
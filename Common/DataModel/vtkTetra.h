@@ -160,6 +160,13 @@ public:
   static int *GetEdgeArray(int edgeId);
   static int *GetFaceArray(int faceId);
 
+  // Description:
+  // Return the case table used by Contour() for case caseId (0 <= caseId <
+  // 16, bit i set when the scalar of vertex i is at or above the contour
+  // value). The entries are edge ids (see GetEdgeArray()), three per
+  // triangle, terminated by -1.
+  static int *GetTriangleCases(int caseId);
+
 protected:
   vtkTetra();
   ~vtkTetra();
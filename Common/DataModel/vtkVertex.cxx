@@ -230,9 +230,10 @@ void vtkVertex::Clip(double value, vtkDataArray *cellScalars,
   if ( ( !insideOut && s > value) || (insideOut && s <= value) )
     {
     this->Points->GetPoint(0, x);
-    if ( locator->InsertUniquePoint(x, pts[0]) )
+    vtkIdType ptId = this->PointIds->GetId(0);
+    if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, pts[0]) )
       {
-      outPd->CopyData(inPd,this->PointIds->GetId(0),pts[0]);
+      outPd->CopyData(inPd,ptId,pts[0]);
       }
     newCellId = verts->InsertNextCell(1,pts);
     outCd->CopyData(inCd,cellId,newCellId);
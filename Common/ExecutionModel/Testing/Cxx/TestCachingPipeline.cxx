@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCachingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkCachingPipeline restores the outputs of past requests from
+// a vtkPipelineCache instead of executing the algorithm again.
+
+#include "vtkCachingPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineCache.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#define CHECK(b) \
+  if (!(b)) \
+    { \
+    cerr << "Error on Line " << __LINE__ << ": " #b << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Produces 1000 * (time step + 1) + piece points, and counts its
+// executions.
+class TestSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TestSource *New();
+  vtkTypeMacro(TestSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  TestSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+  }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+                         vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[5] = { 0, 1, 2, 3, 4 };
+    double range[2] = { 0, 4 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 5);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    outInfo->Set(
+      vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES(), -1);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector)
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    double step = 0.0;
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+      {
+      step = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+      }
+    int piece =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(
+      1000 * (static_cast<vtkIdType>(step) + 1) + piece);
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+      {
+      points->SetPoint(i, step, piece, i);
+      }
+    output->SetPoints(points.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), step);
+    return 1;
+  }
+
+private:
+  TestSource(const TestSource&);  // Not implemented.
+  void operator=(const TestSource&);  // Not implemented.
+};
+vtkStandardNewMacro(TestSource);
+
+// Passes its input through.
+class TestFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static TestFilter *New();
+  vtkTypeMacro(TestFilter, vtkPolyDataAlgorithm);
+
+protected:
+  TestFilter() {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector)
+  {
+    vtkPolyData::GetData(outputVector)->ShallowCopy(
+      vtkPolyData::GetData(inputVector[0]));
+    return 1;
+  }
+
+private:
+  TestFilter(const TestFilter&);  // Not implemented.
+  void operator=(const TestFilter&);  // Not implemented.
+};
+vtkStandardNewMacro(TestFilter);
+
+vtkIdType UpdateTimeStep(TestSource* source, vtkCachingPipeline* executive,
+                         double step)
+{
+  executive->SetUpdateTimeStep(0, step);
+  source->Update();
+  return source->GetOutput()->GetNumberOfPoints();
+}
+}
+
+int TestCachingPipeline(int, char *[])
+{
+  vtkNew<vtkPipelineCache> cache;
+  vtkNew<vtkCachingPipeline> executive;
+  CHECK(executive->GetCache() == vtkPipelineCache::GetGlobalCache());
+  executive->SetCache(cache.GetPointer());
+
+  vtkNew<TestSource> source;
+  source->SetExecutive(executive.GetPointer());
+  source->UpdateInformation();
+
+  // Scrub back and forth over the time steps.
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 0) == 1000);
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 1) == 2000);
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 2) == 3000);
+  CHECK(source->NumberOfExecutions == 3);
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 1) == 2000);
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 0) == 1000);
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 2) == 3000);
+  CHECK(source->NumberOfExecutions == 3);
+  CHECK(source->GetOutput()->GetPoint(2999)[0] == 2.0);
+  CHECK(source->GetOutput()->GetInformation()->Get(
+          vtkDataObject::DATA_TIME_STEP()) == 2.0);
+  CHECK(cache->GetNumberOfHits() == 3);
+  CHECK(cache->GetNumberOfEntries() == 3);
+
+  // An up to date output is not taken from the cache.
+  source->Update();
+  CHECK(source->NumberOfExecutions == 3);
+  CHECK(cache->GetNumberOfHits() == 3);
+
+  // Pieces are part of the request.
+  executive->SetUpdateExtent(0, 1, 2, 0);
+  source->Update();
+  CHECK(source->GetOutput()->GetNumberOfPoints() == 3001);
+  CHECK(source->NumberOfExecutions == 4);
+  executive->SetUpdateExtent(0, 0, 1, 0);
+  source->Update();
+  CHECK(source->GetOutput()->GetNumberOfPoints() == 3000);
+  CHECK(source->NumberOfExecutions == 4);
+
+  // Modifying the algorithm invalidates the entries.
+  source->Modified();
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 1) == 2000);
+  CHECK(source->NumberOfExecutions == 5);
+  CHECK(cache->GetNumberOfEntries() == 1);
+
+  // The least recently used entries are evicted to respect the limit.
+  unsigned long entrySize = cache->GetMemorySize();
+  cache->SetMemoryLimit(3 * entrySize);
+  cache->ResetStatistics();
+  for (int step = 0; step < 5; ++step)
+    {
+    UpdateTimeStep(source.GetPointer(), executive.GetPointer(), step);
+    }
+  CHECK(cache->GetMemorySize() <= 3 * entrySize);
+  CHECK(cache->GetNumberOfEvictions() > 0);
+  int executions = source->NumberOfExecutions;
+  UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 0);
+  CHECK(source->NumberOfExecutions == executions + 1);
+  CHECK(UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 4) == 5000);
+  CHECK(source->NumberOfExecutions == executions + 1);
+
+  // Scrubbing downstream reuses the outputs of the source.
+  cache->SetMemoryLimit(1024 * entrySize);
+  executions = source->NumberOfExecutions;
+  vtkNew<TestFilter> filter;
+  filter->SetInputConnection(source->GetOutputPort());
+  vtkStreamingDemandDrivenPipeline* filterExecutive =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(filter->GetExecutive());
+  filter->UpdateInformation();
+  filterExecutive->SetUpdateTimeStep(0, 3);
+  filter->Update();
+  CHECK(filter->GetOutput()->GetNumberOfPoints() == 4000);
+  filterExecutive->SetUpdateTimeStep(0, 4);
+  filter->Update();
+  CHECK(filter->GetOutput()->GetNumberOfPoints() == 5000);
+  filterExecutive->SetUpdateTimeStep(0, 0);
+  filter->Update();
+  CHECK(filter->GetOutput()->GetNumberOfPoints() == 1000);
+  CHECK(source->NumberOfExecutions == executions + 1);
+  executions = source->NumberOfExecutions;
+  filter->SetInputConnection(NULL);
+
+  // Without a cache, every change of request executes.
+  executive->SetCache(NULL);
+  CHECK(cache->GetNumberOfEntries() == 0);
+  UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 3);
+  UpdateTimeStep(source.GetPointer(), executive.GetPointer(), 4);
+  CHECK(source->NumberOfExecutions == executions + 2);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,335 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExecutionScheduler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkExecutionScheduler executes the branches of a pipeline as
+// tasks, with the same outputs as a serial update.
+
+#include "vtkAlgorithmOutput.h"
+#include "vtkExecutionScheduler.h"
+#include "vtkExecutiveCollection.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkThreadedStreamingPipeline.h"
+
+#define CHECK(b) \
+  if (!(b)) \
+    { \
+    cerr << "Error on Line " << __LINE__ << ": " #b << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Produces NumberOfPoints points along x, and counts its executions.
+class TestSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TestSource *New();
+  vtkTypeMacro(TestSource, vtkPolyDataAlgorithm);
+
+  int NumberOfPoints;
+  int NumberOfExecutions;
+
+protected:
+  TestSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfPoints = 0;
+    this->NumberOfExecutions = 0;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector)
+  {
+    ++this->NumberOfExecutions;
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(this->NumberOfPoints);
+    for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+      {
+      points->SetPoint(i, i, this->NumberOfPoints, 0.0);
+      }
+    vtkPolyData::GetData(outputVector)->SetPoints(points.GetPointer());
+    return 1;
+  }
+
+private:
+  TestSource(const TestSource&);  // Not implemented.
+  void operator=(const TestSource&);  // Not implemented.
+};
+vtkStandardNewMacro(TestSource);
+
+// Translates the points of its input along x by Offset.
+class TestFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static TestFilter *New();
+  vtkTypeMacro(TestFilter, vtkPolyDataAlgorithm);
+
+  double Offset;
+  int NumberOfExecutions;
+
+protected:
+  TestFilter()
+  {
+    this->Offset = 0.0;
+    this->NumberOfExecutions = 0;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector)
+  {
+    ++this->NumberOfExecutions;
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(input->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+      {
+      double x[3];
+      input->GetPoint(i, x);
+      x[0] += this->Offset;
+      points->SetPoint(i, x);
+      }
+    vtkPolyData::GetData(outputVector)->SetPoints(points.GetPointer());
+    return 1;
+  }
+
+private:
+  TestFilter(const TestFilter&);  // Not implemented.
+  void operator=(const TestFilter&);  // Not implemented.
+};
+vtkStandardNewMacro(TestFilter);
+
+// Appends the points of all of its inputs.
+class TestCombiner : public vtkPolyDataAlgorithm
+{
+public:
+  static TestCombiner *New();
+  vtkTypeMacro(TestCombiner, vtkPolyDataAlgorithm);
+
+protected:
+  TestCombiner() {}
+
+  int FillInputPortInformation(int port, vtkInformation* info)
+  {
+    this->Superclass::FillInputPortInformation(port, info);
+    info->Set(vtkAlgorithm::INPUT_IS_REPEATABLE(), 1);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector)
+  {
+    vtkNew<vtkPoints> points;
+    for (int i = 0; i < inputVector[0]->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkPolyData* input = vtkPolyData::GetData(inputVector[0], i);
+      for (vtkIdType j = 0; j < input->GetNumberOfPoints(); ++j)
+        {
+        points->InsertNextPoint(input->GetPoint(j));
+        }
+      }
+    vtkPolyData::GetData(outputVector)->SetPoints(points.GetPointer());
+    return 1;
+  }
+
+private:
+  TestCombiner(const TestCombiner&);  // Not implemented.
+  void operator=(const TestCombiner&);  // Not implemented.
+};
+vtkStandardNewMacro(TestCombiner);
+
+void SetThreadedExecutive(vtkAlgorithm* algorithm)
+{
+  vtkNew<vtkThreadedStreamingPipeline> executive;
+  algorithm->SetExecutive(executive.GetPointer());
+}
+
+bool SamePoints(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double xa[3], xb[3];
+    a->GetPoint(i, xa);
+    b->GetPoint(i, xb);
+    if (xa[0] != xb[0] || xa[1] != xb[1] || xa[2] != xb[2])
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Return the end time of the traced task of executive, or -1.
+double GetEndTime(vtkExecutionScheduler* scheduler, vtkExecutive* executive)
+{
+  for (int i = 0; i < scheduler->GetNumberOfTracedTasks(); ++i)
+    {
+    if (scheduler->GetTracedTaskExecutive(i) == executive)
+      {
+      return scheduler->GetTracedTaskEndTime(i);
+      }
+    }
+  return -1.0;
+}
+}
+
+int TestExecutionScheduler(int, char *[])
+{
+  // source1 ---> filter1 ---.
+  // source2 -+-> filter2 ---+--> combiner
+  //          `-> filter3 ---'
+  vtkNew<TestSource> source1;
+  source1->NumberOfPoints = 1000;
+  vtkNew<TestSource> source2;
+  source2->NumberOfPoints = 2000;
+  vtkNew<TestFilter> filter1;
+  filter1->Offset = 1.0;
+  vtkNew<TestFilter> filter2;
+  filter2->Offset = 2.0;
+  vtkNew<TestFilter> filter3;
+  filter3->Offset = 3.0;
+  vtkNew<TestCombiner> combiner;
+  vtkAlgorithm* algorithms[6] =
+    {
+    source1.GetPointer(), source2.GetPointer(), filter1.GetPointer(),
+    filter2.GetPointer(), filter3.GetPointer(), combiner.GetPointer()
+    };
+  for (int i = 0; i < 6; ++i)
+    {
+    SetThreadedExecutive(algorithms[i]);
+    }
+  filter1->SetInputConnection(source1->GetOutputPort());
+  filter2->SetInputConnection(source2->GetOutputPort());
+  filter3->SetInputConnection(source2->GetOutputPort());
+  combiner->AddInputConnection(filter1->GetOutputPort());
+  combiner->AddInputConnection(filter2->GetOutputPort());
+  combiner->AddInputConnection(filter3->GetOutputPort());
+
+  combiner->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(combiner->GetOutput());
+  CHECK(expected->GetNumberOfPoints() == 5000);
+  CHECK(source2->NumberOfExecutions == 1);
+
+  vtkThreadedStreamingPipeline::SetMultiThreadedEnabled(true);
+  vtkExecutionScheduler* scheduler =
+    vtkExecutionScheduler::GetGlobalScheduler();
+  scheduler->TraceEnabledOn();
+  for (int threads = 1; threads <= 4; threads *= 4)
+    {
+    scheduler->SetNumberOfThreads(threads);
+    scheduler->ClearTrace();
+    source1->Modified();
+    source2->Modified();
+    combiner->Update();
+    CHECK(SamePoints(expected.GetPointer(), combiner->GetOutput()));
+    CHECK(source2->NumberOfExecutions == 1 + threads / 4 + 1);
+    CHECK(filter3->NumberOfExecutions == 1 + threads / 4 + 1);
+
+    // The sources and filters are tasks, each one ending after the task
+    // producing its input.
+    CHECK(scheduler->GetNumberOfTracedTasks() == 5);
+    for (int i = 0; i < scheduler->GetNumberOfTracedTasks(); ++i)
+      {
+      CHECK(scheduler->GetTracedTaskThread(i) >= 0 &&
+            scheduler->GetTracedTaskThread(i) < threads);
+      vtkAlgorithm* algorithm =
+        scheduler->GetTracedTaskExecutive(i)->GetAlgorithm();
+      if (algorithm->GetNumberOfInputPorts() > 0)
+        {
+        double producerEnd = GetEndTime(
+          scheduler, algorithm->GetInputConnection(0, 0)->GetProducer()->
+          GetExecutive());
+        CHECK(producerEnd >= 0.0 &&
+              producerEnd <= scheduler->GetTracedTaskStartTime(i));
+        }
+      }
+    }
+
+  // An up to date pipeline does not execute.
+  scheduler->ClearTrace();
+  combiner->Update();
+  CHECK(scheduler->GetNumberOfTracedTasks() == 0);
+
+  // Only the modified branch executes.
+  source1->Modified();
+  combiner->Update();
+  CHECK(scheduler->GetNumberOfTracedTasks() == 2);
+  CHECK(source1->NumberOfExecutions == 4);
+  CHECK(source2->NumberOfExecutions == 3);
+  CHECK(SamePoints(expected.GetPointer(), combiner->GetOutput()));
+
+  // The ready tasks start by priority.
+  scheduler->SetNumberOfThreads(1);
+  scheduler->ClearTrace();
+  source2->GetInformation()->Set(vtkExecutionScheduler::TASK_PRIORITY(), -1);
+  source1->Modified();
+  source2->Modified();
+  combiner->Update();
+  CHECK(scheduler->GetTracedTaskExecutive(0) == source2->GetExecutive());
+  source2->GetInformation()->Remove(vtkExecutionScheduler::TASK_PRIORITY());
+
+  // A released output is kept until all of its consumers executed.
+  scheduler->SetNumberOfThreads(4);
+  vtkStreamingDemandDrivenPipeline* source2Executive =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(source2->GetExecutive());
+  source2Executive->SetReleaseDataFlag(0, 1);
+  source2->Modified();
+  combiner->Update();
+  CHECK(source2->NumberOfExecutions == 5);
+  CHECK(SamePoints(expected.GetPointer(), combiner->GetOutput()));
+  CHECK(source2->GetOutput()->GetNumberOfPoints() == 0);
+  CHECK(source2Executive->GetReleaseDataFlag(0) == 1);
+  source2Executive->SetReleaseDataFlag(0, 0);
+
+  // Pulling executes the given executives as tasks too.
+  scheduler->ClearTrace();
+  filter1->Modified();
+  vtkThreadedStreamingPipeline::Pull(combiner->GetExecutive());
+  CHECK(scheduler->GetNumberOfTracedTasks() == 2);
+  CHECK(GetEndTime(scheduler, combiner->GetExecutive()) >=
+        GetEndTime(scheduler, filter1->GetExecutive()));
+  CHECK(SamePoints(expected.GetPointer(), combiner->GetOutput()));
+
+  // With the global release data flag, the outputs are released after
+  // their last consumer, and the flag is left alone by the scheduler.
+  vtkDataObject::SetGlobalReleaseDataFlag(1);
+  source2->Modified();
+  combiner->Update();
+  CHECK(vtkDataObject::GetGlobalReleaseDataFlag() == 1);
+  CHECK(source2->NumberOfExecutions == 6);
+  CHECK(source2->GetOutput()->GetNumberOfPoints() == 0);
+  CHECK(filter2->GetOutput()->GetNumberOfPoints() == 0);
+  CHECK(SamePoints(expected.GetPointer(), combiner->GetOutput()));
+  CHECK(!source2->GetOutputInformation(0)->Has(
+          vtkDemandDrivenPipeline::RELEASE_DATA()) ||
+        source2Executive->GetReleaseDataFlag(0) == 0);
+  vtkDataObject::SetGlobalReleaseDataFlag(0);
+
+  scheduler->TraceEnabledOff();
+  scheduler->ClearTrace();
+  scheduler->SetNumberOfThreads(0);
+  vtkThreadedStreamingPipeline::SetMultiThreadedEnabled(false);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,234 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParallelBlockExecution.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkCompositeDataPipeline produces the same output when the
+// blocks of a composite input are processed concurrently.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkImplicitDataSet.h"
+#include "vtkIncrementalOctreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTransform.h"
+
+#define CHECK(b) \
+  if (!(b)) \
+    { \
+    cerr << "Error on Line " << __LINE__ << ": " #b << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// An image whose scalars are the distance to a center depending on block.
+vtkSmartPointer<vtkImageData> MakeBlock(int block)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 19, 0, 19, 0, 19);
+  image->SetOrigin(20.0 * block, 0.0, 0.0);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Distance");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  double center[3] = { 20.0 * block + 5.0 + block, 10.0, 9.5 };
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    scalars->SetValue(i, sqrt(vtkMath::Distance2BetweenPoints(x, center)));
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+  return image;
+}
+
+// Returns true when the blocks of a and b are the same polydata.
+bool SameBlocks(vtkMultiBlockDataSet* a, vtkMultiBlockDataSet* b)
+{
+  if (a->GetNumberOfBlocks() != b->GetNumberOfBlocks())
+    {
+    return false;
+    }
+  for (unsigned int i = 0; i < a->GetNumberOfBlocks(); ++i)
+    {
+    vtkPolyData* pa = vtkPolyData::SafeDownCast(a->GetBlock(i));
+    vtkPolyData* pb = vtkPolyData::SafeDownCast(b->GetBlock(i));
+    if (!pa || !pb)
+      {
+      if (pa != pb || a->GetBlock(i) != b->GetBlock(i))
+        {
+        return false;
+        }
+      continue;
+      }
+    if (pa->GetNumberOfPoints() != pb->GetNumberOfPoints() ||
+        pa->GetNumberOfCells() != pb->GetNumberOfCells() ||
+        pa->GetPointData()->GetNumberOfArrays() !=
+        pb->GetPointData()->GetNumberOfArrays())
+      {
+      return false;
+      }
+    for (vtkIdType j = 0; j < pa->GetNumberOfPoints(); ++j)
+      {
+      double xa[3], xb[3];
+      pa->GetPoint(j, xa);
+      pb->GetPoint(j, xb);
+      if (xa[0] != xb[0] || xa[1] != xb[1] || xa[2] != xb[2])
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Count the executions of an algorithm.
+int NumberOfExecutions = 0;
+void CountExecution(vtkObject*, unsigned long, void*, void*)
+{
+  ++NumberOfExecutions;
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> Execute(vtkAlgorithm* algorithm,
+                                              vtkMultiBlockDataSet* input,
+                                              int parallel)
+{
+  vtkNew<vtkCompositeDataPipeline> executive;
+  executive->SetParallelBlockExecution(parallel);
+  algorithm->SetExecutive(executive.GetPointer());
+  algorithm->SetInputDataObject(0, input);
+  algorithm->Update();
+  vtkSmartPointer<vtkMultiBlockDataSet> output =
+    vtkMultiBlockDataSet::SafeDownCast(algorithm->GetOutputDataObject(0));
+  algorithm->SetInputDataObject(0, NULL);
+  return output;
+}
+}
+
+int TestParallelBlockExecution(int, char *[])
+{
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(6);
+  for (unsigned int i = 0; i < 6; ++i)
+    {
+    // Leave an empty block to check that the outputs keep their position.
+    if (i != 2)
+      {
+      input->SetBlock(i, MakeBlock(i));
+      }
+    }
+
+  vtkNew<vtkContourFilter> contour;
+  contour->SetValue(0, 4.0);
+  contour->SetValue(1, 7.5);
+  contour->ComputeScalarsOn();
+  vtkNew<vtkCallbackCommand> counter;
+  counter->SetCallback(CountExecution);
+  contour->AddObserver(vtkCommand::EndEvent, counter.GetPointer());
+  vtkSmartPointer<vtkMultiBlockDataSet> serial =
+    Execute(contour.GetPointer(), input.GetPointer(), 0);
+  CHECK(NumberOfExecutions == 6);
+  NumberOfExecutions = 0;
+  vtkSmartPointer<vtkMultiBlockDataSet> parallel =
+    Execute(contour.GetPointer(), input.GetPointer(), 1);
+  // The blocks were processed by copies of the filter.
+  CHECK(NumberOfExecutions == 1);
+  CHECK(serial && parallel && serial != parallel);
+  CHECK(vtkPolyData::SafeDownCast(parallel->GetBlock(0))->GetNumberOfCells() >
+        0);
+  CHECK(parallel->GetBlock(2) == NULL);
+  CHECK(SameBlocks(serial, parallel));
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.0, 0.0, 7.25);
+  plane->SetNormal(0.0, 0.25, 1.0);
+  vtkNew<vtkCutter> cutter;
+  cutter->SetCutFunction(plane.GetPointer());
+  cutter->SetValue(0, 0.0);
+  cutter->SetValue(1, 3.0);
+  cutter->GenerateCutScalarsOn();
+  serial = Execute(cutter.GetPointer(), input.GetPointer(), 0);
+  parallel = Execute(cutter.GetPointer(), input.GetPointer(), 1);
+  CHECK(serial && parallel && serial != parallel);
+  CHECK(vtkPolyData::SafeDownCast(parallel->GetBlock(5))->GetNumberOfCells() >
+        0);
+  CHECK(SameBlocks(serial, parallel));
+
+  // The copies have the parameters of the algorithm.
+  vtkAlgorithm* copy = contour->NewCopy();
+  CHECK(copy && copy != contour.GetPointer());
+  CHECK(vtkContourFilter::SafeDownCast(copy)->GetNumberOfContours() == 2);
+  CHECK(vtkContourFilter::SafeDownCast(copy)->GetValue(1) == 7.5);
+  copy->Delete();
+  copy = cutter->NewCopy();
+  CHECK(vtkCutter::SafeDownCast(copy)->GetCutFunction() == plane.GetPointer());
+  CHECK(vtkCutter::SafeDownCast(copy)->GetGenerateCutScalars() == 1);
+  copy->Delete();
+
+  // The copies get their own locator with the same parameters, and the
+  // blocks are processed serially with a locator whose parameters are not
+  // known.
+  vtkNew<vtkMergePoints> locator;
+  locator->SetTolerance(0.125);
+  locator->AutomaticOff();
+  locator->SetDivisions(3, 4, 5);
+  locator->SetNumberOfPointsPerBucket(7);
+  contour->SetLocator(locator.GetPointer());
+  copy = contour->NewCopy();
+  CHECK(copy);
+  vtkMergePoints *copyLocator = vtkMergePoints::SafeDownCast(
+    vtkContourFilter::SafeDownCast(copy)->GetLocator());
+  CHECK(copyLocator && copyLocator != locator.GetPointer());
+  CHECK(copyLocator->GetTolerance() == 0.125);
+  CHECK(copyLocator->GetAutomatic() == 0);
+  CHECK(copyLocator->GetDivisions()[2] == 5);
+  CHECK(copyLocator->GetNumberOfPointsPerBucket() == 7);
+  copy->Delete();
+  serial = Execute(contour.GetPointer(), input.GetPointer(), 0);
+  parallel = Execute(contour.GetPointer(), input.GetPointer(), 1);
+  CHECK(SameBlocks(serial, parallel));
+  vtkNew<vtkIncrementalOctreePointLocator> octree;
+  contour->SetLocator(octree.GetPointer());
+  CHECK(contour->NewCopy() == NULL);
+  cutter->SetLocator(octree.GetPointer());
+  CHECK(cutter->NewCopy() == NULL);
+  cutter->SetLocator(locator.GetPointer());
+
+  // A cut function that may keep state while it is evaluated is not
+  // shared among copies, the blocks are processed serially instead.
+  vtkNew<vtkImplicitDataSet> implicitDataSet;
+  implicitDataSet->SetDataSet(MakeBlock(1));
+  cutter->SetCutFunction(implicitDataSet.GetPointer());
+  CHECK(cutter->NewCopy() == NULL);
+  serial = Execute(cutter.GetPointer(), input.GetPointer(), 0);
+  parallel = Execute(cutter.GetPointer(), input.GetPointer(), 1);
+  CHECK(serial && parallel && serial != parallel);
+  CHECK(SameBlocks(serial, parallel));
+  vtkNew<vtkTransform> transform;
+  plane->SetTransform(transform.GetPointer());
+  cutter->SetCutFunction(plane.GetPointer());
+  CHECK(cutter->NewCopy() == NULL);
+
+  return EXIT_SUCCESS;
+}
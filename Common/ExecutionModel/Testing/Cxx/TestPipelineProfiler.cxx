@@ -0,0 +1,259 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkPipelineProfiler records the passes of the algorithms of a
+// pipeline and writes them as a Chrome trace.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <cstring>
+#include <string>
+#include <vtksys/ios/sstream>
+
+#define CHECK(b) \
+  if (!(b)) \
+    { \
+    cerr << "Error on Line " << __LINE__ << ": " #b << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Produces 1000 vertices.
+class TestSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TestSource *New();
+  vtkTypeMacro(TestSource, vtkPolyDataAlgorithm);
+
+protected:
+  TestSource()
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector)
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType i = 0; i < 1000; ++i)
+      {
+      points->InsertNextPoint(i, 0.0, 0.0);
+      verts->InsertNextCell(1, &i);
+      }
+    output->SetPoints(points.GetPointer());
+    output->SetVerts(verts.GetPointer());
+    return 1;
+  }
+
+private:
+  TestSource(const TestSource&);  // Not implemented.
+  void operator=(const TestSource&);  // Not implemented.
+};
+vtkStandardNewMacro(TestSource);
+
+// Keeps every other vertex of its input.
+class TestFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static TestFilter *New();
+  vtkTypeMacro(TestFilter, vtkPolyDataAlgorithm);
+
+protected:
+  TestFilter() {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector)
+  {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); i += 2)
+      {
+      verts->InsertNextCell(1, &i);
+      }
+    output->SetPoints(input->GetPoints());
+    output->SetVerts(verts.GetPointer());
+    return 1;
+  }
+
+private:
+  TestFilter(const TestFilter&);  // Not implemented.
+  void operator=(const TestFilter&);  // Not implemented.
+};
+vtkStandardNewMacro(TestFilter);
+
+// Set when the profiler observed is deleted.
+bool ProfilerDeleted = false;
+void OnProfilerDeleted(vtkObject*, unsigned long, void*, void*)
+{
+  ProfilerDeleted = true;
+}
+
+// Stops the profiler started while it executes, the profiler must not be
+// deleted before the pass ends.
+class StoppingSource : public TestSource
+{
+public:
+  static StoppingSource *New();
+  vtkTypeMacro(StoppingSource, TestSource);
+
+  bool DeletedDuringPass;
+
+protected:
+  StoppingSource() : DeletedDuringPass(false) {}
+
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector)
+  {
+    vtkPipelineProfiler::GetActiveProfiler()->Stop();
+    this->DeletedDuringPass = ProfilerDeleted;
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+private:
+  StoppingSource(const StoppingSource&);  // Not implemented.
+  void operator=(const StoppingSource&);  // Not implemented.
+};
+vtkStandardNewMacro(StoppingSource);
+
+// Return the first event of algorithm for pass, or -1.
+int FindEvent(vtkPipelineProfiler* profiler, vtkAlgorithm* algorithm,
+              const char* pass)
+{
+  for (int i = 0; i < profiler->GetNumberOfEvents(); ++i)
+    {
+    if (profiler->GetEventAlgorithm(i) == algorithm &&
+        strcmp(profiler->GetEventPass(i), pass) == 0)
+      {
+      return i;
+      }
+    }
+  return -1;
+}
+}
+
+int TestPipelineProfiler(int, char *[])
+{
+  vtkNew<TestSource> source;
+  vtkNew<TestFilter> filter;
+  filter->SetInputConnection(source->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  CHECK(vtkPipelineProfiler::GetActiveProfiler() == NULL);
+  profiler->Start();
+  CHECK(vtkPipelineProfiler::GetActiveProfiler() == profiler.GetPointer());
+  // The started profiler holds a reference to itself.
+  CHECK(profiler->GetReferenceCount() == 2);
+  filter->Update();
+  profiler->Stop();
+  CHECK(vtkPipelineProfiler::GetActiveProfiler() == NULL);
+  CHECK(profiler->GetReferenceCount() == 1);
+
+  // Each algorithm went through the passes of the pipeline.
+  const char* passes[4] =
+    {
+    "RequestDataObject", "RequestInformation", "RequestUpdateExtent",
+    "RequestData"
+    };
+  for (int i = 0; i < 4; ++i)
+    {
+    CHECK(FindEvent(profiler.GetPointer(), filter.GetPointer(), passes[i]) >= 0);
+    }
+  CHECK(FindEvent(profiler.GetPointer(), source.GetPointer(),
+                  "RequestInformation") >= 0);
+
+  int sourceData =
+    FindEvent(profiler.GetPointer(), source.GetPointer(), "RequestData");
+  int filterData =
+    FindEvent(profiler.GetPointer(), filter.GetPointer(), "RequestData");
+  CHECK(sourceData >= 0 && sourceData < filterData);
+  CHECK(strcmp(profiler->GetEventAlgorithmName(filterData), "TestFilter") == 0);
+  CHECK(profiler->GetEventThread(filterData) == 0);
+  CHECK(profiler->GetEventNumberOfInputCells(sourceData) == 0);
+  CHECK(profiler->GetEventNumberOfOutputCells(sourceData) == 1000);
+  CHECK(profiler->GetEventNumberOfInputCells(filterData) == 1000);
+  CHECK(profiler->GetEventNumberOfOutputCells(filterData) == 500);
+  CHECK(profiler->GetEventOutputMemory(sourceData) > 0);
+  CHECK(profiler->GetEventOutputMemory(sourceData) % 1024 == 0);
+  // The source executed before the filter, which does not include it.
+  CHECK(profiler->GetEventStartTime(sourceData) >= 0.0);
+  CHECK(profiler->GetEventStartTime(sourceData) +
+        profiler->GetEventWallTime(sourceData) <=
+        profiler->GetEventStartTime(filterData));
+  CHECK(profiler->GetEventWallTime(filterData) >= 0.0);
+  CHECK(profiler->GetEventCPUTime(filterData) >= 0.0);
+
+  // Nothing is recorded while stopped.
+  int numberOfEvents = profiler->GetNumberOfEvents();
+  source->Modified();
+  filter->Update();
+  CHECK(profiler->GetNumberOfEvents() == numberOfEvents);
+
+  vtksys_ios::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  std::string json = trace.str();
+  CHECK(json.find("{\"traceEvents\":[") == 0);
+  CHECK(json.find("\"name\":\"TestFilter\"") != std::string::npos);
+  CHECK(json.find("\"cat\":\"RequestData\"") != std::string::npos);
+  CHECK(json.find("\"output_cells\":500") != std::string::npos);
+  int depth = 0;
+  for (size_t i = 0; i < json.size(); ++i)
+    {
+    depth += json[i] == '{' || json[i] == '[';
+    depth -= json[i] == '}' || json[i] == ']';
+    CHECK(depth >= 0);
+    }
+  CHECK(depth == 0);
+
+  vtksys_ios::ostringstream summary;
+  profiler->PrintSummary(summary);
+  CHECK(summary.str().find("TestSource") != std::string::npos);
+  CHECK(summary.str().find("TestFilter") != std::string::npos);
+
+  profiler->Clear();
+  CHECK(profiler->GetNumberOfEvents() == 0);
+
+  // A profiler released while started is kept until it is stopped, and a
+  // profiler stopped and released during a pass is kept until the pass
+  // ends.
+  vtkNew<vtkCallbackCommand> onDeleted;
+  onDeleted->SetCallback(OnProfilerDeleted);
+  vtkPipelineProfiler* released = vtkPipelineProfiler::New();
+  released->AddObserver(vtkCommand::DeleteEvent, onDeleted.GetPointer());
+  released->Start();
+  released->Delete();
+  CHECK(!ProfilerDeleted);
+  CHECK(vtkPipelineProfiler::GetActiveProfiler() == released);
+  vtkNew<StoppingSource> stopping;
+  stopping->Update();
+  CHECK(!stopping->DeletedDuringPass);
+  CHECK(ProfilerDeleted);
+  CHECK(vtkPipelineProfiler::GetActiveProfiler() == NULL);
+
+  return EXIT_SUCCESS;
+}
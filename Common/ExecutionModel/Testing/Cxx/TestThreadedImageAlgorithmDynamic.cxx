@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedImageAlgorithmDynamic.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the dynamic scheduling of vtkThreadedImageAlgorithm: every output
+// voxel must be written exactly once, whatever the piece size.
+
+#include "vtkAtomicInt32.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+#include <vector>
+
+// A filter that adds one to each voxel, counts how many times each voxel
+// was visited and how many pieces were executed.
+class vtkCountingImageFilter : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkCountingImageFilter *New();
+  vtkTypeMacro(vtkCountingImageFilter, vtkThreadedImageAlgorithm);
+
+  vtkAtomicInt32 Pieces;
+  std::vector<int> Visits;
+
+protected:
+  vtkCountingImageFilter() {}
+
+  void ThreadedRequestData(vtkInformation *, vtkInformationVector **,
+                           vtkInformationVector *, vtkImageData ***inData,
+                           vtkImageData **outData, int ext[6], int)
+    {
+    this->Pieces.Increment();
+    for (int k = ext[4]; k <= ext[5]; k++)
+      {
+      for (int j = ext[2]; j <= ext[3]; j++)
+        {
+        for (int i = ext[0]; i <= ext[1]; i++)
+          {
+          float *inPtr =
+            static_cast<float *>(inData[0][0]->GetScalarPointer(i, j, k));
+          float *outPtr =
+            static_cast<float *>(outData[0]->GetScalarPointer(i, j, k));
+          *outPtr = *inPtr + 1.0f;
+          int ijk[3] = { i, j, k };
+          this->Visits[outData[0]->ComputePointId(ijk)]++;
+          }
+        }
+      }
+    }
+
+private:
+  vtkCountingImageFilter(const vtkCountingImageFilter&);  // Not implemented.
+  void operator=(const vtkCountingImageFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkCountingImageFilter);
+
+int TestThreadedImageAlgorithmDynamic(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 31, 0, 23, 0, 15);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  float *ptr = static_cast<float *>(image->GetScalarPointer());
+  vtkIdType n = image->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    ptr[i] = static_cast<float>(i % 7);
+    }
+
+  vtkIdType pieceSizes[] = { 1, 100, 4096, 65536 };
+  for (int dynamic = 0; dynamic < 2; dynamic++)
+    {
+    for (int s = 0; s < 4; s++)
+      {
+      vtkNew<vtkCountingImageFilter> filter;
+      filter->SetInputData(image.GetPointer());
+      filter->SetNumberOfThreads(4);
+      filter->SetEnableDynamicScheduling(dynamic);
+      filter->SetDesiredBytesPerPiece(pieceSizes[s]);
+      filter->Visits.assign(n, 0);
+      filter->Update();
+
+      vtkImageData *output = filter->GetOutput();
+      float *outPtr = static_cast<float *>(output->GetScalarPointer());
+      for (vtkIdType i = 0; i < n; i++)
+        {
+        if (filter->Visits[i] != 1 || outPtr[i] != ptr[i] + 1.0f)
+          {
+          cerr << "Voxel " << i << " visited " << filter->Visits[i]
+               << " times with dynamic scheduling " << dynamic
+               << " and pieces of " << pieceSizes[s] << " bytes." << endl;
+          return EXIT_FAILURE;
+          }
+        }
+
+      // dynamic scheduling must split the extent into more pieces than
+      // threads when the pieces are small
+      int pieces = filter->Pieces.Get();
+      if ((dynamic && s < 2 && pieces <= 4) || (!dynamic && pieces > 4))
+        {
+        cerr << "Unexpected number of pieces " << pieces
+             << " with dynamic scheduling " << dynamic
+             << " and pieces of " << pieceSizes[s] << " bytes." << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -1624,6 +1624,31 @@ double vtkAlgorithm::ComputePriority()
   return sddp->ComputePriority(0);
 }
 
+//-------------------------------------------------------------
+vtkAlgorithm* vtkAlgorithm::NewCopy()
+{
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkAlgorithm::CopyInputArraysToProcess(vtkAlgorithm* source)
+{
+  vtkInformationVector *inArrayVec =
+    source->Information->Get(INPUT_ARRAYS_TO_PROCESS());
+  if (!inArrayVec)
+    {
+    return;
+    }
+  for (int i = 0; i < inArrayVec->GetNumberOfInformationObjects(); ++i)
+    {
+    vtkInformation *inArrayInfo = inArrayVec->GetInformationObject(i);
+    if (inArrayInfo)
+      {
+      this->SetInputArrayToProcess(i, inArrayInfo);
+      }
+    }
+}
+
 //-------------------------------------------------------------
 int vtkAlgorithm::SetUpdateExtentToWholeExtent(int port)
 {
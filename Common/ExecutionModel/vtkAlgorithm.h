@@ -471,6 +471,16 @@ public:
   // skippable (REQUEST_DATA not needed) and 1.0 meaning important.
   virtual double ComputePriority();
 
+  // Description:
+  // Create a new algorithm of the same type with the same parameters, not
+  // connected to any input. Executives use such copies to run the
+  // algorithm concurrently on independent data, see
+  // vtkCompositeDataPipeline::SetParallelBlockExecution(). The copy must
+  // not share any state modified during execution with this algorithm.
+  // The default implementation returns NULL, meaning that the algorithm
+  // cannot be copied. The caller owns the returned algorithm.
+  virtual vtkAlgorithm* NewCopy();
+
   // Description:
   // These are flags that can be set that let the pipeline keep accurate
   // meta-information for ComputePriority.
@@ -601,6 +611,11 @@ protected:
   // by idx, this is only reasonable during the REQUEST_DATA pass.
   int GetInputArrayAssociation(int idx, vtkInformationVector **inputVector);
 
+  // Description:
+  // Copy the input arrays to process of another algorithm, as set with
+  // SetInputArrayToProcess(). Useful to implement NewCopy().
+  void CopyInputArraysToProcess(vtkAlgorithm* source);
+
   // Description:
   // Filters that have multiple connections on one port can use
   // this signature. This will override the connection id that the
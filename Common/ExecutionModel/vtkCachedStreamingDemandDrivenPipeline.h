@@ -15,6 +15,10 @@
 // .NAME vtkCachedStreamingDemandDrivenPipeline -
 // .SECTION Description
 // vtkCachedStreamingDemandDrivenPipeline
+//
+// .SECTION See Also
+// vtkCachingPipeline, which caches the outputs of any data type under a
+// memory limit.
 
 #ifndef __vtkCachedStreamingDemandDrivenPipeline_h
 #define __vtkCachedStreamingDemandDrivenPipeline_h
@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCachingPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineCache.h"
+
+#include <string>
+#include <vector>
+#include <vtksys/ios/sstream>
+
+vtkStandardNewMacro(vtkCachingPipeline);
+
+//----------------------------------------------------------------------------
+class vtkCachingPipelineInternals
+{
+public:
+  std::vector<vtkInformationKey*> RequestKeys;
+
+  // Describe the request made on the output information outInfo.
+  std::string ComputeRequestKey(vtkInformation* outInfo)
+    {
+    vtksys_ios::ostringstream key;
+    key.precision(17);
+    for (size_t i = 0; i < this->RequestKeys.size(); ++i)
+      {
+      vtkInformationKey* requestKey = this->RequestKeys[i];
+      if (outInfo->Has(requestKey))
+        {
+        key << requestKey->GetLocation() << "::" << requestKey->GetName()
+            << "=";
+        requestKey->Print(key, outInfo);
+        key << ";";
+        }
+      }
+    return key.str();
+    }
+
+  // Get the data objects of all the output ports.
+  static void GetOutputs(vtkInformationVector* outInfoVec,
+                         std::vector<vtkDataObject*>& outputs)
+    {
+    int numberOfOutputs = outInfoVec->GetNumberOfInformationObjects();
+    outputs.resize(numberOfOutputs);
+    for (int i = 0; i < numberOfOutputs; ++i)
+      {
+      outputs[i] = outInfoVec->GetInformationObject(i)->Get(
+        vtkDataObject::DATA_OBJECT());
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkCachingPipeline::vtkCachingPipeline()
+{
+  this->Internals = new vtkCachingPipelineInternals;
+  this->Internals->RequestKeys.push_back(UPDATE_TIME_STEP());
+  this->Internals->RequestKeys.push_back(UPDATE_PIECE_NUMBER());
+  this->Internals->RequestKeys.push_back(UPDATE_NUMBER_OF_PIECES());
+  this->Internals->RequestKeys.push_back(UPDATE_NUMBER_OF_GHOST_LEVELS());
+  this->Internals->RequestKeys.push_back(UPDATE_EXTENT());
+  this->Internals->RequestKeys.push_back(UPDATE_RESOLUTION());
+  this->Internals->RequestKeys.push_back(UPDATE_COMPOSITE_INDICES());
+
+  this->Cache = vtkPipelineCache::GetGlobalCache();
+  this->Cache->Register(this);
+}
+
+//----------------------------------------------------------------------------
+vtkCachingPipeline::~vtkCachingPipeline()
+{
+  this->SetCache(NULL);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachingPipeline::SetCache(vtkPipelineCache* cache)
+{
+  if (this->Cache == cache)
+    {
+    return;
+    }
+  if (this->Cache)
+    {
+    // The entries of this executive cannot be retrieved anymore.
+    this->Cache->RemoveEntries(this);
+    this->Cache->UnRegister(this);
+    }
+  this->Cache = cache;
+  if (this->Cache)
+    {
+    this->Cache->Register(this);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCachingPipeline::AddRequestKey(vtkInformationKey* key)
+{
+  if (!key)
+    {
+    return;
+    }
+  for (size_t i = 0; i < this->Internals->RequestKeys.size(); ++i)
+    {
+    if (this->Internals->RequestKeys[i] == key)
+      {
+      return;
+      }
+    }
+  this->Internals->RequestKeys.push_back(key);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkCachingPipeline::NeedToExecuteData(int outputPort,
+                                          vtkInformationVector** inInfoVec,
+                                          vtkInformationVector* outInfoVec)
+{
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+    {
+    return 0;
+    }
+
+  // A streaming algorithm asking to execute again is not done with the
+  // request.
+  if (outputPort < 0 || this->ContinueExecuting || !this->Cache)
+    {
+    return 1;
+    }
+
+  std::vector<vtkDataObject*> outputs;
+  vtkCachingPipelineInternals::GetOutputs(outInfoVec, outputs);
+  std::string key = this->Internals->ComputeRequestKey(
+    outInfoVec->GetInformationObject(outputPort));
+  if (outputs.empty() ||
+      !this->Cache->Retrieve(this, key.c_str(), &outputs[0],
+                             static_cast<int>(outputs.size()),
+                             this->PipelineMTime))
+    {
+    return 1;
+    }
+
+  // The restored outputs are up to date, as if the algorithm executed.
+  vtkNew<vtkInformation> request;
+  request->Set(FROM_OUTPUT_PORT(), outputPort);
+  this->MarkOutputsGenerated(request.GetPointer(), inInfoVec, outInfoVec);
+  this->DataTime.Modified();
+  this->InformationTime.Modified();
+  this->DataObjectTime.Modified();
+
+  return this->Superclass::NeedToExecuteData(outputPort, inInfoVec,
+                                             outInfoVec);
+}
+
+//----------------------------------------------------------------------------
+int vtkCachingPipeline::ExecuteData(vtkInformation* request,
+                                    vtkInformationVector** inInfoVec,
+                                    vtkInformationVector* outInfoVec)
+{
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+
+  // Keep the outputs of completed requests only.
+  if (!result || !this->Cache || this->ContinueExecuting ||
+      this->Algorithm->GetAbortExecute())
+    {
+    return result;
+    }
+
+  int outputPort = 0;
+  if (request->Has(FROM_OUTPUT_PORT()))
+    {
+    outputPort = request->Get(FROM_OUTPUT_PORT());
+    outputPort = (outputPort >= 0 ? outputPort : 0);
+    }
+  std::vector<vtkDataObject*> outputs;
+  vtkCachingPipelineInternals::GetOutputs(outInfoVec, outputs);
+  if (outputPort < static_cast<int>(outputs.size()))
+    {
+    std::string key = this->Internals->ComputeRequestKey(
+      outInfoVec->GetInformationObject(outputPort));
+    this->Cache->Store(this, key.c_str(), &outputs[0],
+                       static_cast<int>(outputs.size()), this->PipelineMTime);
+    }
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachingPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Cache: " << this->Cache << "\n";
+  os << indent << "RequestKeys:";
+  for (size_t i = 0; i < this->Internals->RequestKeys.size(); ++i)
+    {
+    os << " " << this->Internals->RequestKeys[i]->GetName();
+    }
+  os << "\n";
+}
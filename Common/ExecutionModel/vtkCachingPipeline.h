@@ -0,0 +1,92 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachingPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCachingPipeline - executive reusing the outputs of past requests
+// .SECTION Description
+// vtkCachingPipeline is a vtkCompositeDataPipeline that keeps the outputs
+// generated by its algorithm in a vtkPipelineCache. When the algorithm
+// has to execute for a request that was already satisfied since the
+// algorithm was last modified, the outputs are restored from the cache
+// instead, and the inputs are not updated. Stepping back and forth over
+// the time steps or the pieces of a reader, for example, executes it only
+// once per time step or piece, as long as the cache is large enough.
+//
+// A request is identified by the values, in the information of the
+// requesting output port, of UPDATE_TIME_STEP, UPDATE_PIECE_NUMBER,
+// UPDATE_NUMBER_OF_PIECES, UPDATE_NUMBER_OF_GHOST_LEVELS, UPDATE_EXTENT,
+// UPDATE_RESOLUTION and UPDATE_COMPOSITE_INDICES, and of the keys added
+// with AddRequestKey(). The outputs of any data type can be cached.
+//
+// \code
+// vtkCachingPipeline *executive = vtkCachingPipeline::New();
+// reader->SetExecutive(executive);
+// executive->Delete();
+// vtkPipelineCache::GetGlobalCache()->SetMemoryLimit(2097152);
+// \endcode
+//
+// .SECTION See Also
+// vtkPipelineCache vtkCachedStreamingDemandDrivenPipeline
+
+#ifndef __vtkCachingPipeline_h
+#define __vtkCachingPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkInformationKey;
+class vtkPipelineCache;
+class vtkCachingPipelineInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkCachingPipeline :
+  public vtkCompositeDataPipeline
+{
+public:
+  static vtkCachingPipeline* New();
+  vtkTypeMacro(vtkCachingPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The cache holding the outputs. It defaults to the global cache,
+  // vtkPipelineCache::GetGlobalCache(). Caching is disabled when it is
+  // NULL.
+  void SetCache(vtkPipelineCache* cache);
+  vtkGetObjectMacro(Cache, vtkPipelineCache);
+
+  // Description:
+  // Add a key of the output information to those identifying a request,
+  // for example a key set by the consumers to select the arrays that the
+  // algorithm produces. Only the keys that can be printed are supported.
+  void AddRequestKey(vtkInformationKey* key);
+
+protected:
+  vtkCachingPipeline();
+  ~vtkCachingPipeline();
+
+  virtual int NeedToExecuteData(int outputPort,
+                                vtkInformationVector** inInfoVec,
+                                vtkInformationVector* outInfoVec);
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec);
+
+  vtkPipelineCache* Cache;
+
+private:
+  vtkCachingPipelineInternals* Internals;
+
+  vtkCachingPipeline(const vtkCachingPipeline&);  // Not implemented.
+  void operator=(const vtkCachingPipeline&);  // Not implemented.
+};
+
+#endif
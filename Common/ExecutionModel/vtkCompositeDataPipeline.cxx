@@ -16,6 +16,7 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAtomicInt32.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkImageData.h"
 #include "vtkInformationDoubleKey.h"
@@ -33,10 +34,14 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUniformGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 //----------------------------------------------------------------------------
 #if defined (JB_DEBUG1)
   #ifndef WIN32
@@ -80,6 +85,7 @@ vtkCompositeDataPipeline::vtkCompositeDataPipeline()
 {
   this->InLocalLoop = 0;
   this->SuppressResetPipelineInformation = 0;
+  this->ParallelBlockExecution = 0;
   this->InformationCache = vtkInformation::New();
 
   this->GenericRequest = vtkInformation::New();
@@ -382,28 +388,35 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
     // ExecuteDataStart() should NOT Initialize() the composite output.
     this->InLocalLoop = 1;
 
-    vtkSmartPointer<vtkCompositeDataIterator> iter;
-    iter.TakeReference(input->NewIterator());
-    for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
-      iter->GoToNextItem())
+    // The blocks are processed serially unless they can be processed
+    // concurrently.
+    if (!this->ParallelBlockExecution ||
+        !this->ExecuteSimpleAlgorithmConcurrently(input, compositeOutput,
+                                                  compositePort))
       {
-      vtkDataObject* dobj = iter->GetCurrentDataObject();
-      if (dobj)
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(input->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+        iter->GoToNextItem())
         {
-        // Note that since VisitOnlyLeaves is ON on the iterator,
-        // this method is called only for leaves, hence, we are assured that
-        // neither dobj nor outObj are vtkCompositeDataSet subclasses.
-        vtkDataObject* outObj =
-          this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
-                                               outInfoVec,
-                                               inInfo,
-                                               outInfo,
-                                               r,
-                                               dobj);
-        if (outObj)
+        vtkDataObject* dobj = iter->GetCurrentDataObject();
+        if (dobj)
           {
-          compositeOutput->SetDataSet(iter, outObj);
-          outObj->FastDelete();
+          // Note that since VisitOnlyLeaves is ON on the iterator,
+          // this method is called only for leaves, hence, we are assured that
+          // neither dobj nor outObj are vtkCompositeDataSet subclasses.
+          vtkDataObject* outObj =
+            this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
+                                                 outInfoVec,
+                                                 inInfo,
+                                                 outInfo,
+                                                 r,
+                                                 dobj);
+          if (outObj)
+            {
+            compositeOutput->SetDataSet(iter, outObj);
+            outObj->FastDelete();
+            }
           }
         }
       }
@@ -437,6 +450,126 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
   this->ExecuteDataEnd(request,inInfoVec,outInfoVec);
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Execute copies of an algorithm over blocks. Each index of the loop is a
+// worker with its own copy, which executes the next block not taken yet
+// until there are none left. The output of block i is stored at index i.
+class vtkCompositeDataPipelineExecuteBlocks
+{
+public:
+  int Port;
+  int NumberOfBlocks;
+  vtkDataObject** Inputs;
+  vtkDataObject** Outputs;
+  vtkAlgorithm** Copies;
+  vtkAtomicInt32 NextBlock;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType worker = begin; worker < end; ++worker)
+      {
+      vtkAlgorithm* copy = this->Copies[worker];
+      for (int i = this->NextBlock.Increment() - 1;
+           i < this->NumberOfBlocks; i = this->NextBlock.Increment() - 1)
+        {
+        copy->SetInputDataObject(this->Port, this->Inputs[i]);
+        copy->Update();
+        vtkDataObject* output = copy->GetOutputDataObject(0);
+        if (output)
+          {
+          this->Outputs[i] = output->NewInstance();
+          this->Outputs[i]->ShallowCopy(output);
+          }
+        }
+      }
+    }
+};
+}
+
+//----------------------------------------------------------------------------
+bool vtkCompositeDataPipeline::ExecuteSimpleAlgorithmConcurrently(
+  vtkCompositeDataSet* input,
+  vtkCompositeDataSet* output,
+  int compositePort)
+{
+  if (this->Algorithm->GetNumberOfInputPorts() != 1 ||
+      this->Algorithm->GetNumberOfInputConnections(compositePort) != 1)
+    {
+    return false;
+    }
+
+  std::vector<vtkDataObject*> inputs;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(input->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+       iter->GoToNextItem())
+    {
+    if (iter->GetCurrentDataObject())
+      {
+      inputs.push_back(iter->GetCurrentDataObject());
+      }
+    }
+  if (inputs.size() < 2)
+    {
+    return false;
+    }
+
+  // The copies are made here, since the algorithm may not be copied from
+  // several threads at once. The first one tells whether it can be.
+  std::vector<vtkAlgorithm*> copies;
+  vtkAlgorithm* copy = this->Algorithm->NewCopy();
+  if (!copy)
+    {
+    return false;
+    }
+  copies.push_back(copy);
+  size_t numberOfWorkers = std::min(
+    inputs.size(),
+    static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads()));
+  while (copies.size() < numberOfWorkers &&
+         (copy = this->Algorithm->NewCopy()) != NULL)
+    {
+    copies.push_back(copy);
+    }
+
+  vtkDebugMacro(<< "Executing " << inputs.size() << " blocks concurrently");
+
+  std::vector<vtkDataObject*> outputs(inputs.size(),
+                                      static_cast<vtkDataObject*>(NULL));
+  vtkCompositeDataPipelineExecuteBlocks executeBlocks;
+  executeBlocks.Port = compositePort;
+  executeBlocks.NumberOfBlocks = static_cast<int>(inputs.size());
+  executeBlocks.Inputs = &inputs[0];
+  executeBlocks.Outputs = &outputs[0];
+  executeBlocks.Copies = &copies[0];
+  executeBlocks.NextBlock.Set(0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(copies.size()), 1,
+                   executeBlocks);
+  for (size_t c = 0; c < copies.size(); ++c)
+    {
+    copies[c]->Delete();
+    }
+
+  // Assemble the outputs in the order of the blocks.
+  size_t i = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+       iter->GoToNextItem())
+    {
+    if (iter->GetCurrentDataObject())
+      {
+      if (outputs[i])
+        {
+        output->SetDataSet(iter, outputs[i]);
+        outputs[i]->FastDelete();
+        }
+      ++i;
+      }
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
   vtkInformationVector** inInfoVec,
@@ -1145,5 +1278,7 @@ void vtkCompositeDataPipeline::MarkOutputsGenerated(
 void vtkCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ParallelBlockExecution: "
+     << this->ParallelBlockExecution << "\n";
 }
 
@@ -35,6 +35,9 @@
 // it will invoke the  vtkStreamingDemandDrivenPipeline passes in a loop,
 // passing a different block each time and will collect the results in a
 // composite dataset.
+//
+// When ParallelBlockExecution is on, the blocks are processed concurrently
+// by copies of a simple algorithm, see SetParallelBlockExecution().
 // .SECTION See also
 //  vtkCompositeDataSet
 
@@ -104,6 +107,21 @@ public:
   // *** THIS IS AN EXPERIMENTAL FEATURE. IT MAY CHANGE WITHOUT NOTICE ***
   static vtkInformationIntegerVectorKey* COMPOSITE_INDICES();
 
+  // Description:
+  // When on, a simple (non composite-aware) algorithm iterated over the
+  // blocks of a composite input processes the blocks concurrently, using
+  // vtkSMPTools. Each thread executes its own copy of the algorithm,
+  // created with vtkAlgorithm::NewCopy(), and the outputs are assembled
+  // in block order so that the result is the same as in serial mode.
+  // The blocks are processed serially when the algorithm cannot be
+  // copied, when it has more than one input connection, or when the
+  // input has less than two blocks. Observers of the algorithm do not
+  // receive the events of the blocks processed concurrently. Off by
+  // default.
+  vtkSetMacro(ParallelBlockExecution, int);
+  vtkGetMacro(ParallelBlockExecution, int);
+  vtkBooleanMacro(ParallelBlockExecution, int);
+
 
 protected:
   vtkCompositeDataPipeline();
@@ -163,6 +181,13 @@ protected:
     vtkInformation* request,
     vtkDataObject* dobj);
 
+  // Execute copies of the algorithm concurrently over the leaves of
+  // input, storing their outputs in output. Returns false, without
+  // executing anything, when the blocks have to be processed serially.
+  bool ExecuteSimpleAlgorithmConcurrently(vtkCompositeDataSet* input,
+                                          vtkCompositeDataSet* output,
+                                          int compositePort);
+
   bool ShouldIterateOverInput(int& compositePort);
 
   virtual int InputTypeIsValid(int port, int index,
@@ -200,6 +225,8 @@ protected:
 
   int NeedToExecuteBasedOnCompositeIndices(vtkInformation* outInfo);
 
+  int ParallelBlockExecution;
+
 private:
   vtkCompositeDataPipeline(const vtkCompositeDataPipeline&);  // Not implemented.
   void operator=(const vtkCompositeDataPipeline&);  // Not implemented.
@@ -593,8 +593,7 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(vtkInformation* request,
       {
       vtkInformation* inInfo = inInfoVec[i]->GetInformationObject(j);
       vtkDataObject* dataObject = inInfo->Get(vtkDataObject::DATA_OBJECT());
-      if(dataObject && (dataObject->GetGlobalReleaseDataFlag() ||
-                        inInfo->Get(RELEASE_DATA())))
+      if(dataObject && this->NeedToReleaseInputData(inInfo))
         {
         dataObject->ReleaseData();
         }
@@ -1093,6 +1092,13 @@ int vtkDemandDrivenPipeline::SetReleaseDataFlag(int port, int n)
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkDemandDrivenPipeline::NeedToReleaseInputData(vtkInformation* inInfo)
+{
+  return (vtkDataObject::GetGlobalReleaseDataFlag() ||
+          inInfo->Get(RELEASE_DATA()));
+}
+
 //----------------------------------------------------------------------------
 int vtkDemandDrivenPipeline::GetReleaseDataFlag(int port)
 {
@@ -73,6 +73,14 @@ public:
   // consumed.  Returns 1 if the the value changes and 0 otherwise.
   virtual int SetReleaseDataFlag(int port, int n);
 
+  // Description:
+  // Return whether the data of an input should be released once the
+  // algorithm is done with it, which is when the RELEASE_DATA() flag of
+  // the input information or the global release data flag is set.
+  // Algorithms that release or reuse the data of their inputs themselves
+  // should check this.
+  virtual int NeedToReleaseInputData(vtkInformation* inInfo);
+
   // Description:
   // Get whether the given output port releases data when it is consumed.
   virtual int GetReleaseDataFlag(int port);
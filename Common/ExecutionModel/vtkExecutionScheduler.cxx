@@ -31,23 +31,25 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkCommand.h"
-#include "vtkComputingResources.h"
+#include "vtkConditionVariable.h"
+#include "vtkCriticalSection.h"
+#include "vtkDataObject.h"
 #include "vtkExecutiveCollection.h"
 #include "vtkInformation.h"
-#include "vtkInformationVector.h"
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationExecutivePortVectorKey.h"
 #include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
 #include "vtkMultiThreader.h"
 #include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkThreadedStreamingPipeline.h"
-#include "vtkThreadMessager.h"
+#include "vtkTimerLog.h"
 
-#include <set>
-#include <vtksys/hash_map.hxx>
+#include <algorithm>
+#include <map>
+#include <string>
 #include <vector>
-#include <vtksys/hash_set.hxx>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkExecutionScheduler);
@@ -55,798 +57,656 @@ vtkStandardNewMacro(vtkExecutionScheduler);
 vtkInformationKeyMacro(vtkExecutionScheduler, TASK_PRIORITY, Integer);
 
 //----------------------------------------------------------------------------
-class Task
+namespace
 {
-public:
-  Task(int _priority = -1, vtkExecutive *_exec = NULL, vtkInformation *_info = NULL)
-  {
-    this->priority = _priority;
-    this->exec = _exec;
-    this->info = _info;
-  }
-
-  int             priority;
-  vtkExecutive   *exec;
-  vtkInformation *info;
+// A task recorded in the trace.
+struct vtkExecutionSchedulerTracedTask
+{
+  vtkExecutive* Executive;
+  std::string Name;
+  int Thread;
+  double StartTime;
+  double EndTime;
 };
+}
 
 //----------------------------------------------------------------------------
-class TaskWeakOrdering
+class vtkExecutionScheduler::implementation
 {
 public:
-  bool operator()(const Task& t1,
-                  const Task& t2) const
-  {
-    return t1.priority < t2.priority;
-  }
+  std::vector<vtkExecutionSchedulerTracedTask> Trace;
+  vtkSimpleCriticalSection TraceLock;
 };
 
+namespace
+{
 //----------------------------------------------------------------------------
-// Convinient definitions of vector/set of vtkExecutive
-class vtkExecutiveHasher
+// The graph of tasks of one call to vtkExecutionScheduler::Execute().
+class vtkExecutionSchedulerGraph
 {
 public:
-  size_t operator()(const vtkExecutive* e) const
+  // A task executing the REQUEST_DATA pass of an executive.
+  struct Task
   {
-    return (size_t)e;
-  }
-};
-typedef vtksys::hash_set<vtkExecutive*, vtkExecutiveHasher> vtkExecutiveSet;
-typedef std::vector<vtkExecutive*>                       vtkExecutiveVector;
+    vtkThreadedStreamingPipeline* Executive;
+    // The output port from which the data is requested.
+    int Port;
+    int Priority;
+    int NumberOfPendingProducers;
+    // True when a task it depends on failed.
+    bool Skip;
+    std::vector<int> Consumers;
+    std::vector<int> Inputs;
+  };
 
-//----------------------------------------------------------------------------
-class vtkExecutionScheduler::implementation
-{
-public:
-  // The containing object
-  vtkExecutionScheduler*  Scheduler;
-
-  // Some convenient type definitions for STL containers
-  typedef vtksys::hash_map<vtkExecutive*, int,
-    vtkExecutiveHasher>                                 ExecutiveIntHashMap;
-  typedef std::pair<int, int>                        Edge;
-  class                                                 EdgeHasher;
-  typedef vtksys::hash_set<Edge, EdgeHasher>            EdgeSet;
-  typedef std::multiset<Task, TaskWeakOrdering>      TaskPriorityQueue;
-  typedef std::vector<vtkMutexLock*>                 MutexLockVector;
-  typedef std::vector<vtkThreadMessager*>            MessagerVector;
-  class EdgeHasher
+  // An output information read by tasks.
+  struct Input
   {
-  public:
-    size_t operator()(const Edge &e) const
-    {
-      return (size_t)((e.first << 16) +  e.second);
-    }
+    vtkInformation* Information;
+    int NumberOfPendingReaders;
+    int NumberOfExecutingReaders;
+    // Release the data once all of its readers are done.
+    bool Release;
   };
 
-  vtkExecutiveSet           ExecutingTasks;
-  TaskPriorityQueue         PrioritizedTasks;
-  ExecutiveIntHashMap       DependencyNodes;
-  EdgeSet                   DependencyEdges;
-  MessagerVector            TaskDoneMessagers;
-  MutexLockVector           InputsReleasedLocks;
-  MessagerVector            InputsReleasedMessagers;
-  int                       CurrentPriority;
-
-  // Description:
-  // Start from the exec and go all the way up to the sources (modules
-  // without any inputs), then call TraverseDownToSink to update edges
-  void FindAndTraverseFromSources(vtkExecutive *exec, vtkExecutiveSet &visited);
-
-  // Description:
-  // Actual traverse down the network, for each nodes, construct and
-  // add edges connecting all of its upstream modules to itself to the
-  // dependency graph
-  void TraverseDownToSink(vtkExecutive *exec, vtkExecutiveSet &upstream,
-                          vtkExecutiveSet &visited);
-
-  // Description:
-  // Actual traverse down the network, for each nodes, construct and
-  // add edges connecting all of its upstream modules to itself to the
-  // dependency graph
-  void CollectDownToSink(vtkExecutive *exec, vtkExecutiveSet &visited,
-                         vtkExecutiveVector &graph);
-
-  // Description:
-  // A task can be executed if none of its predecessor tasks are still
-  // on the queue. This only makes sense for tasks that are currently
-  // on the queue, thus, an iterator is provided instead of the task
-  // itself.
-  bool CanExecuteTask(TaskPriorityQueue::const_iterator ti);
-  // Description:
-  // Spawn a thread to execute a module
-  void Execute(const Task &task);
-
-  // Description:
-  // Check if the given exec is a new module or not. If it is then
-  // traverse the network to update dependency edges for its connected
-  // subgraph
-  void UpdateDependencyGraph(vtkExecutive *exec);
-
-  // Description:
-  // Add the module exec to the set of dependency nodes if it is not
-  // already there and return its node id number
-  int AddToDependencyGraph(vtkExecutive *exec);
-
-  // Description:
-  // Add the given executive to the execution queue for later
-  // execution
-  void AddToQueue(vtkExecutive *exec, vtkInformation *info);
-
-  // Description:
-  // Obtain the priority from the information object if it is given,
-  // otherwise, use a priority assigned from the scheduler
-  int AcquirePriority(vtkInformation *info);
-};
+  // Orders the ready tasks by priority, then by index.
+  class TaskOrdering
+  {
+  public:
+    const std::vector<Task>* Tasks;
+    bool operator()(int a, int b) const
+      {
+      const Task& ta = (*this->Tasks)[a];
+      const Task& tb = (*this->Tasks)[b];
+      return ta.Priority < tb.Priority ||
+        (ta.Priority == tb.Priority && a < b);
+      }
+  };
 
-//----------------------------------------------------------------------------
-static vtkExecutionScheduler *globalScheduler = NULL;
+  vtkExecutionScheduler* Scheduler;
+  std::vector<vtkExecutionSchedulerTracedTask>* Trace;
+  vtkSimpleCriticalSection* TraceLock;
+  int TraceEnabled;
+  int ConcurrentSharedInputs;
 
-//----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ScheduleThread(void *data);
-void * vtkExecutionScheduler_ExecuteThread(void *data);
+  std::vector<Task> Tasks;
+  std::vector<Input> Inputs;
+  std::vector<int> Ready;
+  int NumberOfRemainingTasks;
+  int Result;
+  vtkMutexLock* Lock;
+  vtkConditionVariable* Condition;
 
-//----------------------------------------------------------------------------
-vtkExecutionScheduler* vtkExecutionScheduler::GetGlobalScheduler()
-{
-  if (!globalScheduler)
+  vtkExecutionSchedulerGraph()
     {
-    globalScheduler = vtkExecutionScheduler::New();
+    this->Lock = vtkMutexLock::New();
+    this->Condition = vtkConditionVariable::New();
+    this->NumberOfRemainingTasks = 0;
+    this->Result = 1;
+    }
+  ~vtkExecutionSchedulerGraph()
+    {
+    this->Lock->Delete();
+    this->Condition->Delete();
     }
-  return globalScheduler;
-}
-
-//----------------------------------------------------------------------------
-vtkExecutionScheduler::vtkExecutionScheduler()
-  : Implementation(new implementation)
-{
-  this->Resources = vtkComputingResources::New();
-  this->Resources->ObtainMaximumResources();
-  this->ResourceMessager = vtkThreadMessager::New();
-  this->ScheduleLock = vtkMutexLock::New();
-  this->ScheduleMessager = vtkThreadMessager::New();
-  this->ScheduleThreader = vtkMultiThreader::New();
-  this->ScheduleThreader->SetNumberOfThreads(1);
-  this->ScheduleThreadId = -1;
-  this->Implementation->Scheduler = this;
-  this->Implementation->CurrentPriority = 0;
-}
 
-//----------------------------------------------------------------------------
-vtkExecutionScheduler::~vtkExecutionScheduler()
-{
-  this->Resources->Delete();
-  this->ResourceMessager->Delete();
-  this->ScheduleLock->Delete();
-  this->ScheduleMessager->Delete();
-  this->ScheduleThreader->Delete();
-  delete this->Implementation;
-}
+  bool Build(vtkExecutiveCollection* execs);
+  void Run(int thread);
 
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::PrintSelf(ostream &os, vtkIndent indent)
-{
-  this->Superclass::PrintSelf(os, indent);
-}
+private:
+  void AddReady(int taskId);
+  int NextReady();
+  void Finish(int taskId, int result, int thread, double start, double end);
+};
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::SchedulePropagate(vtkExecutiveCollection *execs, vtkInformation* vtkNotUsed(info))
+bool vtkExecutionSchedulerGraph::Build(vtkExecutiveCollection* execs)
 {
-  execs->InitTraversal();
-  vtkExecutiveSet    visited;
-  vtkExecutiveVector graph;
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
-    {
-    this->Implementation->CollectDownToSink(e, visited, graph);
-    }
-
-  for (vtkExecutiveVector::iterator vi=graph.begin();
-       vi!=graph.end(); vi++)
+  std::map<vtkExecutive*, int> taskIds;
+  vtkCollectionSimpleIterator cookie;
+  execs->InitTraversal(cookie);
+  for (vtkExecutive* e = execs->GetNextExecutive(cookie); e != 0;
+       e = execs->GetNextExecutive(cookie))
     {
-    (*vi)->Update();
-    vtkAlgorithm *rep =(*vi)->GetAlgorithm();
-    if (rep->IsA("vtkDataRepresentation"))
+    vtkThreadedStreamingPipeline* exec =
+      vtkThreadedStreamingPipeline::SafeDownCast(e);
+    if (!exec)
       {
-      rep->InvokeEvent(vtkCommand::UpdateEvent, NULL);
+      vtkErrorWithObjectMacro(this->Scheduler, "Cannot execute a "
+                              << e->GetClassName() << " as a task.");
+      return false;
       }
-    }
-}
-
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::Schedule(vtkExecutiveCollection *execs, vtkInformation *info)
-{
-  if (this->ScheduleThreadId == -1)
-    {
-    this->ScheduleThreadId = this->ScheduleThreader->
-      SpawnThread((vtkThreadFunctionType)(vtkExecutionScheduler_ScheduleThread), this);
-    }
-  this->ScheduleLock->Lock();
-  vtkExecutiveVector G;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
-    {
-    if (this->Implementation->ExecutingTasks.find(e) != this->Implementation->ExecutingTasks.end())
+    if (taskIds.find(exec) != taskIds.end())
       {
-      return;
+      continue;
       }
-    if (this->Implementation->DependencyNodes.find(e) == this->Implementation->DependencyNodes.end())
+    taskIds[exec] = static_cast<int>(this->Tasks.size());
+    Task task;
+    task.Executive = exec;
+    task.Port = exec->GetNumberOfOutputPorts() > 0 ? 0 : -1;
+    vtkInformation* algorithmInfo = exec->GetAlgorithm()->GetInformation();
+    task.Priority = algorithmInfo->Has(vtkExecutionScheduler::TASK_PRIORITY()) ?
+      algorithmInfo->Get(vtkExecutionScheduler::TASK_PRIORITY()) : 0;
+    task.NumberOfPendingProducers = 0;
+    task.Skip = false;
+    this->Tasks.push_back(task);
+    }
+
+  // Connect each task to the tasks producing its inputs.
+  std::map<vtkInformation*, int> inputIds;
+  std::vector<bool> consumed(this->Tasks.size(), false);
+  for (size_t t = 0; t < this->Tasks.size(); ++t)
+    {
+    vtkThreadedStreamingPipeline* exec = this->Tasks[t].Executive;
+    for (int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
       {
-      this->Implementation->UpdateDependencyGraph(e);
+      vtkInformationVector* inVector = exec->GetInputInformation()[i];
+      for (int j = 0; j < inVector->GetNumberOfInformationObjects(); ++j)
+        {
+        vtkInformation* inInfo = inVector->GetInformationObject(j);
+        vtkExecutive* producer;
+        int producerPort;
+        vtkExecutive::PRODUCER()->Get(inInfo, producer, producerPort);
+        if (!producer)
+          {
+          continue;
+          }
+
+        std::map<vtkInformation*, int>::iterator ii = inputIds.find(inInfo);
+        if (ii == inputIds.end())
+          {
+          Input input;
+          input.Information = inInfo;
+          input.NumberOfPendingReaders = 0;
+          input.NumberOfExecutingReaders = 0;
+          input.Release = false;
+          ii = inputIds.insert(std::make_pair(
+            inInfo, static_cast<int>(this->Inputs.size()))).first;
+          this->Inputs.push_back(input);
+          }
+        std::vector<int>& taskInputs = this->Tasks[t].Inputs;
+        if (std::find(taskInputs.begin(), taskInputs.end(), ii->second) !=
+            taskInputs.end())
+          {
+          continue;
+          }
+        taskInputs.push_back(ii->second);
+        this->Inputs[ii->second].NumberOfPendingReaders++;
+
+        std::map<vtkExecutive*, int>::iterator pi = taskIds.find(producer);
+        if (pi != taskIds.end())
+          {
+          Task& producerTask = this->Tasks[pi->second];
+          if (!consumed[pi->second] || producerPort < producerTask.Port)
+            {
+            producerTask.Port = producerPort;
+            }
+          consumed[pi->second] = true;
+          producerTask.Consumers.push_back(static_cast<int>(t));
+          this->Tasks[t].NumberOfPendingProducers++;
+          }
+        }
       }
-    G.push_back(e);
     }
 
-  // Create an adjacency matrix
-  unsigned i, j, k, p;
-  unsigned N = (unsigned)G.size();
-  int *A = (int*)malloc(N*N*sizeof(int));
-  int *degree = (int*)malloc(N*sizeof(int));
-  memset(A, 0, N*N*sizeof(int));
-  memset(degree, 0, N*sizeof(int));
-  for (i = 0; i < N; i++)
+  // The tasks do not release their inputs, see
+  // vtkThreadedStreamingPipeline::NeedToReleaseInputData(). An input is
+  // released by the scheduler after its last reader, and only when all of
+  // its consumers are tasks, the other consumers may need it later.
+  int globalRelease = vtkDataObject::GetGlobalReleaseDataFlag();
+  for (size_t i = 0; i < this->Inputs.size(); ++i)
     {
-    int src = (*(this->Implementation->DependencyNodes.find(G[i]))).second;
-    for (j = 0; j < N; j++)
+    Input& input = this->Inputs[i];
+    if (!globalRelease &&
+        !input.Information->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
+      {
+      continue;
+      }
+    input.Release = true;
+    int numberOfConsumers =
+      vtkExecutive::CONSUMERS()->Length(input.Information);
+    vtkExecutive** consumers =
+      vtkExecutive::CONSUMERS()->GetExecutives(input.Information);
+    for (int c = 0; c < numberOfConsumers; ++c)
       {
-      int dst = (*(this->Implementation->DependencyNodes.find(G[j]))).second;
-      if (this->Implementation->DependencyEdges.find(implementation::Edge(src, dst)) !=
-          this->Implementation->DependencyEdges.end())
+      if (consumers[c] && taskIds.find(consumers[c]) == taskIds.end())
         {
-        A[i*N+j] = 1;
-        degree[j]++;
+        input.Release = false;
         }
       }
     }
 
-  unsigned *S = (unsigned*)malloc(N*sizeof(unsigned));
-  k = 0;
-  for (j = 0; j < N; j++)
+  for (size_t t = 0; t < this->Tasks.size(); ++t)
     {
-    if (degree[j] == 0)
+    if (this->Tasks[t].NumberOfPendingProducers == 0)
       {
-      S[k++] = j;
+      this->Ready.push_back(static_cast<int>(t));
       }
     }
-  p = 0;
-  while (p < k)
-    {
-    i = S[p++];
-    this->Implementation->AddToQueue(G[i], info);
-    for (j = 0; j < N; j++)
-      if (A[i*N+j])
-        {
-        degree[j]--;
-        A[i*N+j] = 0;
-        if (degree[j] == 0)
-          {
-          S[k++] = j;
-          }
-        }
-    }
-  free(S);
-  free(degree);
-  free(A);
-
-  // Wake the scheduling thread up if it is currently waiting for tasks
-  this->ScheduleMessager->SendWakeMessage();
-  this->ScheduleLock->Unlock();
-
+  TaskOrdering ordering;
+  ordering.Tasks = &this->Tasks;
+  std::sort(this->Ready.begin(), this->Ready.end(), ordering);
+  this->NumberOfRemainingTasks = static_cast<int>(this->Tasks.size());
+  return true;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::UpdateDependencyGraph(vtkExecutive *exec)
+void vtkExecutionSchedulerGraph::AddReady(int taskId)
 {
-  vtkExecutiveSet visited;
-  this->FindAndTraverseFromSources(exec, visited);
+  TaskOrdering ordering;
+  ordering.Tasks = &this->Tasks;
+  this->Ready.insert(std::lower_bound(this->Ready.begin(), this->Ready.end(),
+                                      taskId, ordering), taskId);
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::FindAndTraverseFromSources
-(vtkExecutive *exec, vtkExecutiveSet &visited)
+// Return the position in Ready of the first task that can start, or -1.
+int vtkExecutionSchedulerGraph::NextReady()
 {
-  if (visited.find(exec) != visited.end())
-    {
-    return;
-    }
-  visited.insert(exec);
-  bool isSource = true;
-  for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
+  for (size_t r = 0; r < this->Ready.size(); ++r)
     {
-    int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
-    vtkInformationVector* inVector = exec->GetInputInformation()[i];
-    for(int j = 0; j < nic; ++j)
+    const Task& task = this->Tasks[this->Ready[r]];
+    bool canStart = true;
+    if (!this->ConcurrentSharedInputs && !task.Skip)
       {
-      vtkInformation* inInfo = inVector->GetInformationObject(j);
-      vtkExecutive* e;
-      int producerPort;
-      vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
-      if (e)
+      for (size_t i = 0; i < task.Inputs.size(); ++i)
         {
-        isSource = false;
-        this->FindAndTraverseFromSources(e, visited);
+        if (this->Inputs[task.Inputs[i]].NumberOfExecutingReaders > 0)
+          {
+          canStart = false;
+          break;
+          }
         }
       }
+    if (canStart)
+      {
+      return static_cast<int>(r);
+      }
     }
-  if (isSource)
-    {
-    vtkExecutiveSet upstream;
-    vtkExecutiveSet downVisited;
-    this->TraverseDownToSink(exec, upstream, downVisited);
-    }
+  return -1;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::TraverseDownToSink
-(vtkExecutive *exec, vtkExecutiveSet &upstream, vtkExecutiveSet &visited)
+void vtkExecutionSchedulerGraph::Run(int thread)
 {
-  if (visited.find(exec)!=visited.end())
-    {
-    return;
-    }
-
-  // Now mark all edges from upstream modules to exec as dependency edges
-  int vId = this->AddToDependencyGraph(exec);
-  for (vtkExecutiveSet::const_iterator it = upstream.begin(); it != upstream.end(); it++)
+  this->Lock->Lock();
+  while (this->NumberOfRemainingTasks > 0)
     {
-    implementation::ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find(*it);
-    this->DependencyEdges.insert(Edge((*hit).second, vId));
-    }
+    int next = this->NextReady();
+    if (next < 0)
+      {
+      // Wait for a task to finish.
+      this->Condition->Wait(this->Lock);
+      continue;
+      }
+    int taskId = this->Ready[next];
+    this->Ready.erase(this->Ready.begin() + next);
+    Task& task = this->Tasks[taskId];
+    for (size_t i = 0; i < task.Inputs.size(); ++i)
+      {
+      this->Inputs[task.Inputs[i]].NumberOfExecutingReaders++;
+      }
+    this->Lock->Unlock();
 
-  // Mark as visited
-  visited.insert(exec);
+    int result = 0;
+    double start = 0.0;
+    double end = 0.0;
+    if (!task.Skip)
+      {
+      start = vtkTimerLog::GetUniversalTime();
+      result = task.Executive->ExecuteTask(task.Port);
+      end = vtkTimerLog::GetUniversalTime();
+      }
 
-  // Then insert it to the upstream list for going down
-  upstream.insert(exec);
-  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
-    {
-    vtkInformation* info = exec->GetOutputInformation(i);
-    int consumerCount = vtkExecutive::CONSUMERS()->Length(info);
-    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(info);
-    for (int j = 0; j < consumerCount; j++)
-      if (e[j])
-        {
-        this->TraverseDownToSink(e[j], upstream, visited);
-        }
+    this->Lock->Lock();
+    this->Finish(taskId, result, thread, start, end);
+    this->Condition->Broadcast();
     }
-
-  // Take it out of the upstream and prepare for back-tracking
-  upstream.erase(exec);
+  this->Lock->Unlock();
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::CollectDownToSink
-(vtkExecutive *exec, vtkExecutiveSet &visited, vtkExecutiveVector &graph)
+void vtkExecutionSchedulerGraph::Finish(int taskId, int result, int thread,
+                                        double start, double end)
 {
-  if (visited.find(exec)!=visited.end())
+  Task& task = this->Tasks[taskId];
+  --this->NumberOfRemainingTasks;
+  if (!result)
     {
-    return;
+    this->Result = 0;
     }
 
-  // Mark as visited
-  visited.insert(exec);
-
-  // Add it to the ordered graph
-  graph.push_back(exec);
+  if (this->TraceEnabled && !task.Skip)
+    {
+    vtkExecutionSchedulerTracedTask traced;
+    traced.Executive = task.Executive;
+    traced.Name = task.Executive->GetAlgorithm()->GetClassName();
+    traced.Thread = thread;
+    traced.StartTime = start;
+    traced.EndTime = end;
+    this->TraceLock->Lock();
+    this->Trace->push_back(traced);
+    this->TraceLock->Unlock();
+    }
 
-  // Then traverse down
-  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
+  for (size_t i = 0; i < task.Inputs.size(); ++i)
     {
-    vtkInformation* info = exec->GetOutputInformation(i);
-    int consumerCount = vtkExecutive::CONSUMERS()->Length(info);
-    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(info);
-    for (int j = 0; j < consumerCount; j++)
+    Input& input = this->Inputs[task.Inputs[i]];
+    input.NumberOfExecutingReaders--;
+    if (--input.NumberOfPendingReaders == 0 && input.Release)
       {
-      if (e[j])
+      vtkDataObject* data = input.Information->Get(vtkDataObject::DATA_OBJECT());
+      if (data)
         {
-        this->CollectDownToSink(e[j], visited, graph);
+        data->ReleaseData();
         }
       }
     }
-}
 
-//----------------------------------------------------------------------------
-int vtkExecutionScheduler::implementation::AddToDependencyGraph(vtkExecutive *exec)
-{
-  // We never remove vertices, it's ok to just return the size of
-  // DependencyGraph as a node id
-  implementation::ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find(exec);
-  // Check if this is a new module or an untouched sub-network
-  int vId = -1;
-  if (hit == this->DependencyNodes.end())
-    {
-    vId = (int)this->DependencyNodes.size();
-    this->DependencyNodes[exec] = vId;
-
-    // Make sure that we have enough thread messagers for this vId
-    while (this->TaskDoneMessagers.size()<=(size_t)vId)
+  for (size_t c = 0; c < task.Consumers.size(); ++c)
+    {
+    Task& consumer = this->Tasks[task.Consumers[c]];
+    if (!result)
       {
-      this->TaskDoneMessagers.push_back(vtkThreadMessager::New());
+      consumer.Skip = true;
       }
-
-    while (this->InputsReleasedMessagers.size()<=(size_t)vId)
+    if (--consumer.NumberOfPendingProducers == 0)
       {
-      this->InputsReleasedMessagers.push_back(vtkThreadMessager::New());
-      this->InputsReleasedLocks.push_back(vtkMutexLock::New());
+      this->AddReady(task.Consumers[c]);
       }
     }
-  // We have this module in our cache before
-  else
-    {
-    vId = (*hit).second;
-    }
-  return vId;
 }
 
 //----------------------------------------------------------------------------
-int vtkExecutionScheduler::implementation::AcquirePriority(vtkInformation * info)
+VTK_THREAD_RETURN_TYPE vtkExecutionSchedulerRun(void* arg)
 {
-  int priority;
-  if (info && info->Has(TASK_PRIORITY()))
-    {
-    priority = info->Get(TASK_PRIORITY());
-    }
-  else
-    {
-    priority = this->CurrentPriority++;
-    }
-  return priority;
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkExecutionSchedulerGraph*>(info->UserData)->Run(
+    info->ThreadID);
+  return VTK_THREAD_RETURN_VALUE;
+}
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::AddToQueue(vtkExecutive *exec, vtkInformation * info)
-{
-  int priority = this->AcquirePriority(info);
-  this->PrioritizedTasks.insert(Task(priority, exec, info));
-  vtkMutexLock *lock = this->Scheduler->GetInputsReleasedLock(exec);
-  if (lock)
-    {
-//     fprintf(stderr, "A %s\n", exec->GetAlgorithm()->GetClassName());
-    lock->Lock();
-    }
-}
+static vtkExecutionScheduler *globalScheduler = NULL;
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitUntilDone(vtkExecutiveCollection *execs)
+vtkExecutionScheduler* vtkExecutionScheduler::GetGlobalScheduler()
 {
-  vtkExecutiveSet::const_iterator it;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
+  if (!globalScheduler)
     {
-    this->WaitForTaskDone(e);
+    globalScheduler = vtkExecutionScheduler::New();
     }
+  return globalScheduler;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitUntilAllDone()
+vtkExecutionScheduler::vtkExecutionScheduler()
+  : Implementation(new implementation)
 {
-  while (true)
-    {
-    vtkExecutive *exec = NULL;
-    this->ScheduleLock->Lock();
-    if (this->Implementation->PrioritizedTasks.size() > 0)
-      exec = (*(this->Implementation->PrioritizedTasks.begin())).exec;
-    this->ScheduleLock->Unlock();
-    if (exec)
-      this->WaitForTaskDone(exec);
-    else
-      break;
-    }
+  this->NumberOfThreads = 0;
+  this->ConcurrentSharedInputs = 0;
+  this->TraceEnabled = 0;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitUntilReleased(vtkExecutiveCollection *execs)
+vtkExecutionScheduler::~vtkExecutionScheduler()
 {
-  vtkExecutiveSet::const_iterator it;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
-    {
-    this->WaitForInputsReleased(e);
-    }
+  delete this->Implementation;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitForTaskDone(vtkExecutive *exec)
+void vtkExecutionScheduler::PrintSelf(ostream &os, vtkIndent indent)
 {
-  vtkThreadMessager *messager = this->GetTaskDoneMessager(exec);
-  if (messager)
-    messager->WaitForMessage();
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "ConcurrentSharedInputs: "
+     << this->ConcurrentSharedInputs << "\n";
+  os << indent << "TraceEnabled: " << this->TraceEnabled << "\n";
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitForInputsReleased(vtkExecutive *exec)
+int vtkExecutionScheduler::Execute(vtkExecutiveCollection *execs)
 {
-  vtkMutexLock *lock = this->GetInputsReleasedLock(exec);
-  if (lock)
+  vtkExecutionSchedulerGraph graph;
+  graph.Scheduler = this;
+  graph.Trace = &this->Implementation->Trace;
+  graph.TraceLock = &this->Implementation->TraceLock;
+  graph.TraceEnabled = this->TraceEnabled;
+  graph.ConcurrentSharedInputs = this->ConcurrentSharedInputs;
+  if (!execs || !graph.Build(execs))
+    {
+    return 0;
+    }
+  if (graph.Tasks.empty())
+    {
+    return 1;
+    }
+
+  int numberOfThreads = this->NumberOfThreads > 0 ? this->NumberOfThreads :
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  numberOfThreads =
+    std::min(numberOfThreads, static_cast<int>(graph.Tasks.size()));
+
+  if (numberOfThreads <= 1)
+    {
+    graph.Run(0);
+    }
+  else
     {
-    lock->Lock();
-    lock->Unlock();
+    vtkMultiThreader* threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(vtkExecutionSchedulerRun, &graph);
+    threader->SingleMethodExecute();
+    threader->Delete();
     }
-//   vtkThreadMessager *messager = this->GetInputsReleasedMessager(exec);
-//   if (messager)
-//     messager->WaitForMessage();
+
+  return graph.Result;
 }
 
 //----------------------------------------------------------------------------
-vtkThreadMessager* vtkExecutionScheduler::GetTaskDoneMessager(vtkExecutive *exec)
+void vtkExecutionScheduler::Schedule(vtkExecutiveCollection *execs,
+                                     vtkInformation* vtkNotUsed(info))
 {
-  implementation::ExecutiveIntHashMap::iterator hit =
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end())
+  // Propagate the pipeline information and the update extents first, the
+  // executives to update may be upstream of each other.
+  bool threaded = true;
+  vtkCollectionSimpleIterator cookie;
+  execs->InitTraversal(cookie);
+  for (vtkExecutive *e = execs->GetNextExecutive(cookie); e != 0;
+       e = execs->GetNextExecutive(cookie))
     {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++)
+    vtkThreadedStreamingPipeline* exec =
+      vtkThreadedStreamingPipeline::SafeDownCast(e);
+    if (!exec)
       {
-      if ((*ti).exec==exec)
-        {
-        return this->Implementation->TaskDoneMessagers[(*hit).second];
-        }
+      threaded = false;
+      break;
+      }
+    if (exec->UpdateInformation())
+      {
+      exec->PropagateUpdateExtent(exec->GetNumberOfOutputPorts() > 0 ? 0 : -1);
       }
     }
-  return NULL;
-}
 
-//----------------------------------------------------------------------------
-vtkMutexLock* vtkExecutionScheduler::GetInputsReleasedLock(vtkExecutive *exec)
-{
-  implementation::ExecutiveIntHashMap::iterator hit =
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end())
+  if (!threaded)
     {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++)
+    execs->InitTraversal(cookie);
+    for (vtkExecutive *e = execs->GetNextExecutive(cookie); e != 0;
+         e = execs->GetNextExecutive(cookie))
       {
-      if ((*ti).exec == exec)
-        {
-        return this->Implementation->InputsReleasedLocks[(*hit).second];
-        }
+      e->Update();
       }
+    return;
     }
-  return NULL;
-}
 
-//----------------------------------------------------------------------------
-vtkThreadMessager* vtkExecutionScheduler::GetInputsReleasedMessager(vtkExecutive *exec)
-{
-  implementation::ExecutiveIntHashMap::iterator hit =
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end())
+  vtkExecutiveCollection *tasks = vtkExecutiveCollection::New();
+  execs->InitTraversal(cookie);
+  for (vtkExecutive *e = execs->GetNextExecutive(cookie); e != 0;
+       e = execs->GetNextExecutive(cookie))
     {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++)
+    if (!tasks->IsItemPresent(e))
       {
-      if ((*ti).exec==exec)
-        {
-        return this->Implementation->InputsReleasedMessagers[(*hit).second];
-        }
+      tasks->AddItem(e);
       }
+    vtkThreadedStreamingPipeline::CollectUpstreamTasks(e, tasks);
     }
-  return NULL;
+  this->Execute(tasks);
+  tasks->Delete();
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::ReleaseResources(vtkExecutive *exec)
+// Add exec and the executives downstream of it to execs, once.
+static void vtkExecutionSchedulerCollectDownstream(
+  vtkExecutive *exec, vtkExecutiveCollection *execs)
 {
-  vtkThreadedStreamingPipeline *threadedExec = vtkThreadedStreamingPipeline::
-    SafeDownCast(exec);
-  if (threadedExec)
+  if (execs->IsItemPresent(exec))
     {
-    this->ScheduleLock->Lock();
-    this->Resources->Collect(threadedExec->GetResources());
-    this->ResourceMessager->SendWakeMessage();
-    this->ScheduleLock->Unlock();
+    return;
     }
-}
-
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::ReacquireResources(vtkExecutive *exec)
-{
-  vtkThreadedStreamingPipeline *threadedExec = vtkThreadedStreamingPipeline::
-    SafeDownCast(exec);
-  if (threadedExec)
+  execs->AddItem(exec);
+  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
     {
-    while (!this->Resources->Reserve(threadedExec->GetResources()))
+    vtkInformation* outInfo = exec->GetOutputInformation(i);
+    int consumerCount = vtkExecutive::CONSUMERS()->Length(outInfo);
+    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(outInfo);
+    for (int j = 0; j < consumerCount; j++)
       {
-      this->ResourceMessager->WaitForMessage();
+      if (e[j])
+        {
+        vtkExecutionSchedulerCollectDownstream(e[j], execs);
+        }
       }
     }
 }
 
 //----------------------------------------------------------------------------
-bool vtkExecutionScheduler::implementation::CanExecuteTask
-(TaskPriorityQueue::const_iterator taskIter)
+void vtkExecutionScheduler::SchedulePropagate(vtkExecutiveCollection *execs,
+                                              vtkInformation* info)
 {
-  if (this->ExecutingTasks.find((*taskIter).exec) != this->ExecutingTasks.end())
-    {
-    return false;
-    }
-  ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find((*taskIter).exec);
-  if (hit == this->DependencyNodes.end())
+  vtkExecutiveCollection *graph = vtkExecutiveCollection::New();
+  vtkCollectionSimpleIterator cookie;
+  execs->InitTraversal(cookie);
+  for (vtkExecutive *e = execs->GetNextExecutive(cookie); e != 0;
+       e = execs->GetNextExecutive(cookie))
     {
-    return true;
+    vtkExecutionSchedulerCollectDownstream(e, graph);
     }
-  int dst = (*hit).second;
-  TaskPriorityQueue::const_iterator ti;
-  for (ti = this->PrioritizedTasks.begin();
-       ti != taskIter; ti++)
+  this->Schedule(graph, info);
+
+  // Let the views render the representations updated.
+  graph->InitTraversal(cookie);
+  for (vtkExecutive *e = graph->GetNextExecutive(cookie); e != 0;
+       e = graph->GetNextExecutive(cookie))
     {
-    if ((*ti).priority > (*taskIter).priority)
-      {
-      break;
-      }
-    hit = this->DependencyNodes.find((*ti).exec);
-    int src = (*hit).second;
-    if (this->DependencyEdges.find(Edge(src, dst)) != this->DependencyEdges.end())
+    vtkAlgorithm *rep = e->GetAlgorithm();
+    if (rep->IsA("vtkDataRepresentation"))
       {
-      return false;
+      rep->InvokeEvent(vtkCommand::UpdateEvent, NULL);
       }
     }
-  return true;
+  graph->Delete();
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::RescheduleFrom(vtkExecutive *exec,
-                                           vtkComputingResources *resources)
+int vtkExecutionScheduler::GetNumberOfTracedTasks()
 {
-  vtkExecutiveVector upstream;
-  // Compute the total time
-  float totalUpStreamTime = 0.0;
-  for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
-    {
-    int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
-    vtkInformationVector* inVector = exec->GetInputInformation()[i];
-    for(int j = 0; j < nic; ++j)
-      {
-      vtkInformation* inInfo = inVector->GetInformationObject(j);
-      vtkExecutive* e;
-      int producerPort;
-      vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
-      if (e && vtkThreadedStreamingPipeline::SafeDownCast(e))
-        {
-        upstream.push_back(e);
-        }
-      }
-    }
-  for (size_t i = 0; i < upstream.size(); i++)
-    {
-    totalUpStreamTime += vtkThreadedStreamingPipeline::SafeDownCast(upstream[i])->LastDataRequestTimeFromSource;
-    }
+  return static_cast<int>(this->Implementation->Trace.size());
+}
 
-  // Then distribute the resources based on those ratios
-  vtkProcessingUnitResource *totalResources[] =
-    {
-      resources->GetResourceFor(vtkThreadedStreamingPipeline::PROCESSING_UNIT_CPU),
-      resources->GetResourceFor(vtkThreadedStreamingPipeline::PROCESSING_UNIT_GPU),
-    };
-  for (size_t i = 0; i < upstream.size(); i++)
+//----------------------------------------------------------------------------
+vtkExecutive* vtkExecutionScheduler::GetTracedTaskExecutive(int task)
+{
+  if (task < 0 || task >= this->GetNumberOfTracedTasks())
     {
-    float ratio = vtkThreadedStreamingPipeline::
-      SafeDownCast(upstream[i])->LastDataRequestTimeFromSource/totalUpStreamTime;
-    for (size_t j = 0; j < sizeof(totalResources)/sizeof(vtkProcessingUnitResource*); j++)
-      {
-      vtkProcessingUnitResource* moduleResource = vtkThreadedStreamingPipeline::
-        SafeDownCast(upstream[i])->GetResources()->
-        GetResourceFor(totalResources[j]->ProcessingUnit());
-      moduleResource->IncreaseByRatio(ratio, totalResources[j]);
-      }
+    return NULL;
     }
+  return this->Implementation->Trace[task].Executive;
+}
 
-  // Try to reserve upstream
-  for (size_t i = 0; i < upstream.size(); i++)
+//----------------------------------------------------------------------------
+const char* vtkExecutionScheduler::GetTracedTaskName(int task)
+{
+  if (task < 0 || task >= this->GetNumberOfTracedTasks())
     {
-    this->RescheduleFrom(upstream[i],
-                         vtkThreadedStreamingPipeline::
-                         SafeDownCast(upstream[i])->GetResources());
+    return NULL;
     }
+  return this->Implementation->Trace[task].Name.c_str();
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::RescheduleNetwork(vtkExecutive *sink)
+int vtkExecutionScheduler::GetTracedTaskThread(int task)
 {
-  this->Resources->ObtainMaximumResources();
-  this->RescheduleFrom(sink, this->Resources);
+  if (task < 0 || task >= this->GetNumberOfTracedTasks())
+    {
+    return -1;
+    }
+  return this->Implementation->Trace[task].Thread;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::ClassInitialize()
+double vtkExecutionScheduler::GetTracedTaskStartTime(int task)
 {
-  // Currently empty - initialize late when required.
+  if (task < 0 || task >= this->GetNumberOfTracedTasks())
+    {
+    return 0.0;
+    }
+  return this->Implementation->Trace[task].StartTime;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::ClassFinalize()
+double vtkExecutionScheduler::GetTracedTaskEndTime(int task)
 {
-  // Clean up our singleton (if it was ever initalized).
-  if (globalScheduler)
+  if (task < 0 || task >= this->GetNumberOfTracedTasks())
     {
-    globalScheduler->FastDelete();
+    return 0.0;
     }
+  return this->Implementation->Trace[task].EndTime;
 }
 
 //----------------------------------------------------------------------------
-typedef struct
-{
-  vtkExecutionScheduler *scheduler;
-  Task task;
-} ExecutionData;
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::Execute(const Task &task)
+void vtkExecutionScheduler::ClearTrace()
 {
-  ExecutionData *eData = new ExecutionData();
-  eData->scheduler = this->Scheduler;
-  eData->task = task;
-  this->Scheduler->ScheduleThreader->SpawnThread((vtkThreadFunctionType)(vtkExecutionScheduler_ExecuteThread), eData);
+  this->Implementation->Trace.clear();
 }
 
 //----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ScheduleThread(void *data)
+void vtkExecutionScheduler::PrintTrace(ostream &os)
 {
-  vtkExecutionScheduler *self = static_cast<vtkExecutionScheduler*>
-    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
-  while (true)
-    {
-    self->ScheduleLock->Lock();
-    bool needToWait = true;
-    vtkExecutionScheduler::implementation::TaskPriorityQueue::iterator ti;
-    for (ti = self->Implementation->PrioritizedTasks.begin();
-         ti != self->Implementation->PrioritizedTasks.end(); ti++)
-      {
-      if (self->Implementation->CanExecuteTask(ti))
-        {
-        vtkThreadedStreamingPipeline *exec = vtkThreadedStreamingPipeline::
-          SafeDownCast((*ti).exec);
-        if (self->Resources->Reserve(exec->GetResources()))
-          {
-          needToWait = false;
-          self->Implementation->ExecutingTasks.insert(exec);
-          self->ScheduleLock->Unlock();
-          self->Implementation->Execute(*ti);
-          break;
-          }
-        }
-      }
-    if (needToWait)
+  std::vector<vtkExecutionSchedulerTracedTask>& trace =
+    this->Implementation->Trace;
+  double origin = 0.0;
+  for (size_t i = 0; i < trace.size(); ++i)
+    {
+    if (i == 0 || trace[i].StartTime < origin)
       {
-      self->ScheduleLock->Unlock();
-      self->ScheduleMessager->WaitForMessage();
+      origin = trace[i].StartTime;
       }
     }
-  return NULL;
+  for (size_t i = 0; i < trace.size(); ++i)
+    {
+    os << trace[i].Name << " (" << trace[i].Executive << ")"
+       << " thread " << trace[i].Thread
+       << " start " << (trace[i].StartTime - origin) * 1000.0 << " ms"
+       << " end " << (trace[i].EndTime - origin) * 1000.0 << " ms"
+       << " duration "
+       << (trace[i].EndTime - trace[i].StartTime) * 1000.0 << " ms\n";
+    }
 }
 
 //----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ExecuteThread(void *data)
+void vtkExecutionScheduler::ClassInitialize()
 {
-  ExecutionData *eData = static_cast<ExecutionData*>
-    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
-  vtkExecutionScheduler *self = eData->scheduler;
-  Task task = eData->task;
-  vtkThreadedStreamingPipeline *exec = vtkThreadedStreamingPipeline::
-    SafeDownCast(task.exec);
-  vtkThreadMessager *messager = self->GetTaskDoneMessager(task.exec);
-  vtkMutexLock *lock = self->GetInputsReleasedLock(task.exec);
-  exec->GetResources()->Deploy(exec, task.info);
-  self->ScheduleLock->Lock();
-  self->Implementation->PrioritizedTasks.erase(task);
-  self->Implementation->ExecutingTasks.erase(exec);
-  self->Resources->Collect(exec->GetResources());
-  self->ResourceMessager->SendWakeMessage();
-  self->ScheduleLock->Unlock();
-  exec->ReleaseInputs();
-  self->ScheduleMessager->SendWakeMessage();
-  if (task.info && task.info->Has(vtkThreadedStreamingPipeline::AUTO_PROPAGATE()))
-    {
-      fprintf(stderr, "Push DOWN from %s\n", exec->GetAlgorithm()->GetClassName());
-    exec->Push(task.info);
-    }
-  if (messager)
-    {
-    messager->SendWakeMessage();
-    }
-  delete eData;
-  fprintf(stderr, "Release now\n");
-  lock->Unlock();
-  return NULL;
+  // Currently empty - initialize late when required.
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionScheduler::ClassFinalize()
+{
+  // Clean up our singleton (if it was ever initalized).
+  if (globalScheduler)
+    {
+    globalScheduler->FastDelete();
+    }
 }
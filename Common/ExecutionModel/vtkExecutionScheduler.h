@@ -27,14 +27,41 @@
   T. Silva, SCI Institute, University of Utah, Technical Report
   #UUSCI-2009-005, 2009.
 -------------------------------------------------------------------------*/
-// .NAME vtkExecutionScheduler - Scheduling execution with
-// thread/computing resources distributing
+// .NAME vtkExecutionScheduler - executes a pipeline as a graph of tasks
 // .SECTION Description
-// This is a class for balancing the computing resources throughout
-// the network
-
+// vtkExecutionScheduler executes the REQUEST_DATA pass of a set of
+// vtkThreadedStreamingPipeline executives as a graph of tasks. Each
+// executive is a task depending on the tasks producing its inputs. A task
+// is started as soon as the tasks it depends on are done, on one of up to
+// NumberOfThreads threads, so that the independent branches of a pipeline
+// execute concurrently. The executives do not update their inputs when
+// executed by the scheduler, the scheduler does it for them.
+//
+// The outputs do not depend on the number of threads or on the timing of
+// the tasks: each algorithm executes once, after all of its inputs are
+// generated, exactly as in a serial update. When several tasks are ready,
+// they are started in a fixed order: by increasing TASK_PRIORITY() of the
+// algorithm information, then in the order of the executives given. By
+// default, the tasks reading the same data object are not executed at the
+// same time, since the methods of most datasets, GetCell() for example,
+// cannot be called concurrently. See ConcurrentSharedInputs.
+//
+// The memory used is bounded: at most NumberOfThreads tasks execute at the
+// same time, and an output whose release data flag is set, or any output
+// when the global release data flag is set, is released once all of the
+// tasks reading it are done, instead of after the first of them.
+//
+// When TraceEnabled is on, the scheduler records when each task started
+// and ended, and on which thread. See PrintTrace().
+//
+// vtkThreadedStreamingPipeline uses the global scheduler to update its
+// inputs when multi-threaded updates are enabled.
+//
+// The pieces of a streamed update share the data objects of the pipeline,
+// so they are executed one after the other, each one as a graph of tasks.
+//
 // .SECTION See Also
-// vtkComputingResources vtkThreadedStreamingPipeline
+// vtkThreadedStreamingPipeline
 
 #ifndef __vtkExecutionScheduler_h
 #define __vtkExecutionScheduler_h
@@ -44,10 +71,6 @@
 #include "vtkExecutionSchedulerManager.h" // For singleton instantiation/cleanup
 
 class vtkExecutive;
-class vtkComputingResources;
-class vtkMultiThreader;
-class vtkMutexLock;
-class vtkThreadMessager;
 class vtkInformation;
 class vtkInformationIntegerKey;
 class vtkExecutiveCollection;
@@ -63,105 +86,85 @@ public:
   // Return the global instance of the scheduler
   static vtkExecutionScheduler *GetGlobalScheduler();
 
- // Description:
-  // Key to store the priority of a task
-  static vtkInformationIntegerKey* TASK_PRIORITY();
-
-  // Description:
-  // Put the current set of executives (modules) to the be scheduled given its
-  // dependency graph which will be used to compute the set
-  // topological orders
-  void Schedule(vtkExecutiveCollection *execs, vtkInformation *info);
-
   // Description:
-  // Put the current set of executives (modules) to the be scheduled
-  // given its dependency graph which will be used to compute the set
-  // topological orders. Then wait for their execution to be complete
-  void SchedulePropagate(vtkExecutiveCollection *execs, vtkInformation *info);
-
-  // Description:
-  // Wait until the current set of executives (modules) have finished executing
-  void WaitUntilDone(vtkExecutiveCollection *execs);
-
-  // Description:
-  // Wait until the current set of executives (modules) have their inputs released
-  void WaitUntilReleased(vtkExecutiveCollection *execs);
-
-  // Description:
-  // Wait for all tasks to be done
-  void WaitUntilAllDone();
-
-  // Description:
-  // Wait for a task that is on the scheduling queue to be done. If
-  // the task is not there, this will return immediately. If the exec
-  // is NULL, any task that is done will trigger this the return
-  void WaitForTaskDone(vtkExecutive *exec);
+  // Key of the algorithm information ordering the tasks ready to execute:
+  // the tasks with the lowest priority are started first. The priority of
+  // a task defaults to 0.
+  static vtkInformationIntegerKey* TASK_PRIORITY();
 
   // Description:
-  // Similar to WaitForTaskDone but return whenever input connections
-  // of a task are released instead of done computing. But exec cannot
-  // be NULL.
-  void WaitForInputsReleased(vtkExecutive *exec);
+  // The maximum number of tasks executing at the same time. When 0, the
+  // default, vtkMultiThreader::GetGlobalDefaultNumberOfThreads() is used.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
 
   // Description:
-  // Return the thread messager reserved for the given exec to notify
-  // when it is done
-  vtkThreadMessager* GetTaskDoneMessager(vtkExecutive *exec);
+  // When on, tasks reading the same data object may execute at the same
+  // time. This is only safe when the algorithms reading a shared data
+  // object use its thread safe methods only. Off by default.
+  vtkSetMacro(ConcurrentSharedInputs, int);
+  vtkGetMacro(ConcurrentSharedInputs, int);
+  vtkBooleanMacro(ConcurrentSharedInputs, int);
 
   // Description:
-  // Return the thread messager reserved for the given exec to notify
-  // when it releases its inputs
-  vtkThreadMessager* GetInputsReleasedMessager(vtkExecutive *exec);
+  // Execute the REQUEST_DATA pass of the given executives, which must be
+  // vtkThreadedStreamingPipeline executives, as a graph of tasks, and
+  // return when they are all done. The other passes must have been
+  // executed already. The executives that are up to date do not execute.
+  // When a task fails, the tasks depending on it are not executed and 0
+  // is returned.
+  int Execute(vtkExecutiveCollection *execs);
 
   // Description:
-  // Return the mutex lock reserved for the given exec to notify
-  // when it releases its inputs
-  vtkMutexLock* GetInputsReleasedLock(vtkExecutive *exec);
+  // Update the given executives: propagate their pipeline information and
+  // update extents, then execute them and the executives upstream that
+  // need to as a graph of tasks. When one of the given executives is not
+  // a vtkThreadedStreamingPipeline, they are all updated serially
+  // instead. The information is not used.
+  void Schedule(vtkExecutiveCollection *execs, vtkInformation *info);
 
   // Description:
-  // Release the resources that are being used by the given exec
-  void ReleaseResources(vtkExecutive *exec);
+  // Same as Schedule() for the given executives and all the executives
+  // downstream of them. vtkCommand::UpdateEvent is then invoked on the
+  // representations updated, from the calling thread.
+  void SchedulePropagate(vtkExecutiveCollection *execs, vtkInformation *info);
 
   // Description:
-  // Re-acquire the resource released earlier by ReleaseResource
-  void ReacquireResources(vtkExecutive *exec);
+  // Record the tasks executed, see PrintTrace(). Off by default.
+  vtkSetMacro(TraceEnabled, int);
+  vtkGetMacro(TraceEnabled, int);
+  vtkBooleanMacro(TraceEnabled, int);
 
   // Description:
-  // Redistribute the thread resources over the network from a sink
-  // with a maximum resource
-  void RescheduleNetwork(vtkExecutive *sink);
+  // The tasks recorded since the last call to ClearTrace(), in the order
+  // they ended: the class name of the algorithm, the thread, in
+  // [0, NumberOfThreads), and the universal time, in seconds, at which the
+  // task started and ended.
+  int GetNumberOfTracedTasks();
+  vtkExecutive* GetTracedTaskExecutive(int task);
+  const char* GetTracedTaskName(int task);
+  int GetTracedTaskThread(int task);
+  double GetTracedTaskStartTime(int task);
+  double GetTracedTaskEndTime(int task);
+  void ClearTrace();
 
   // Description:
-  // Redistribute the thread resources from a sink given a certain
-  // amount of resource
-  void RescheduleFrom(vtkExecutive *sink, vtkComputingResources *resources);
+  // Print one line per traced task with its name, thread, and start and
+  // end times in milliseconds relative to the first traced task.
+  void PrintTrace(ostream &os);
 
 protected:
   vtkExecutionScheduler();
   ~vtkExecutionScheduler();
 
-  vtkComputingResources       *Resources;
-  vtkThreadMessager           *ScheduleMessager;
-  vtkThreadMessager           *ResourceMessager;
-  vtkMutexLock                *ScheduleLock;
-  vtkMultiThreader            *ScheduleThreader;
-  int                          ScheduleThreadId;
+  int NumberOfThreads;
+  int ConcurrentSharedInputs;
+  int TraceEnabled;
 
 //BTX
   class implementation;
   implementation* const Implementation;
   friend class implementation;
-
-  // Description:
-  // The scheduling thread that is responsible for queueing up module
-  // execution in the right order
-  friend void * vtkExecutionScheduler_ScheduleThread(void *data);
-
-  // Description:
-  // Execute thread function that is responsible for forking process
-  // for each module
-  friend void * vtkExecutionScheduler_ExecuteThread(void *data);
-
 //ETX
 
   // Description: Functions and friend class to take care of initialization
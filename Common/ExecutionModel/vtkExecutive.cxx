@@ -25,6 +25,7 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <vector>
@@ -741,9 +742,21 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  vtkPipelineProfiler* profiler =
+    vtkPipelineProfiler::RegisterActiveProfiler(this);
+  vtkPipelineProfiler::Pass pass;
+  if (profiler)
+    {
+    profiler->BeginPass(pass, this, request, inInfo);
+    }
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if (profiler)
+    {
+    profiler->EndPass(pass, this, outInfo);
+    profiler->UnRegister(this);
+    }
 
   // If the algorithm failed report it now.
   if(!result)
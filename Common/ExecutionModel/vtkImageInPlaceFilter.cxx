@@ -62,9 +62,10 @@ int vtkImageInPlaceFilter::RequestData(
   outSize = (outExt[1] - outExt[0] + 1);
   outSize = outSize * (outExt[3] - outExt[2] + 1);
   outSize = outSize * (outExt[5] - outExt[4] + 1);
-  if (inSize == outSize &&
-      (vtkDataObject::GetGlobalReleaseDataFlag() ||
-       inInfo->Get(vtkDemandDrivenPipeline::RELEASE_DATA())))
+  vtkDemandDrivenPipeline* executive =
+    vtkDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+  if (inSize == outSize && executive &&
+      executive->NeedToReleaseInputData(inInfo))
     {
     // pass the data
     output->GetPointData()->PassData(input->GetPointData());
@@ -0,0 +1,326 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineCache.h"
+
+#include "vtkCriticalSection.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkPipelineCache);
+
+vtkPipelineCache *vtkPipelineCache::GlobalCache = 0;
+vtkPipelineCacheCleanup vtkPipelineCache::Cleanup;
+
+//----------------------------------------------------------------------------
+class vtkPipelineCacheInternals
+{
+public:
+  struct Entry
+  {
+    vtkExecutive* Owner;
+    std::string Key;
+    std::vector<vtkDataObject*> Outputs;
+    unsigned long Time;
+    unsigned long MemorySize;
+  };
+
+  // Most recently used first.
+  typedef std::list<Entry> EntryList;
+  typedef std::map<std::pair<vtkExecutive*, std::string>,
+                   EntryList::iterator> EntryMap;
+
+  EntryList Entries;
+  EntryMap Index;
+  unsigned long MemorySize;
+
+  vtkPipelineCacheInternals() : MemorySize(0) {}
+  ~vtkPipelineCacheInternals()
+    {
+    while (!this->Entries.empty())
+      {
+      this->Remove(this->Entries.begin());
+      }
+    }
+
+  void Remove(EntryList::iterator entry)
+    {
+    for (size_t i = 0; i < entry->Outputs.size(); ++i)
+      {
+      if (entry->Outputs[i])
+        {
+        entry->Outputs[i]->Delete();
+        }
+      }
+    this->MemorySize -= entry->MemorySize;
+    this->Index.erase(std::make_pair(entry->Owner, entry->Key));
+    this->Entries.erase(entry);
+    }
+};
+
+//----------------------------------------------------------------------------
+// The data information that vtkDataObject::ShallowCopy() does not copy
+// because it describes the request that produced the data.
+static void vtkPipelineCacheCopyInformation(vtkDataObject* source,
+                                            vtkDataObject* target)
+{
+  vtkInformation* sourceInfo = source->GetInformation();
+  vtkInformation* targetInfo = target->GetInformation();
+  targetInfo->CopyEntry(sourceInfo, vtkDataObject::DATA_PIECE_NUMBER());
+  targetInfo->CopyEntry(sourceInfo, vtkDataObject::DATA_NUMBER_OF_PIECES());
+  targetInfo->CopyEntry(sourceInfo,
+                        vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS());
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineCacheCleanup::vtkPipelineCacheCleanup()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineCacheCleanup::~vtkPipelineCacheCleanup()
+{
+  // Release the global cache and the data it holds.
+  if (vtkPipelineCache::GlobalCache)
+    {
+    vtkPipelineCache::GlobalCache->Delete();
+    vtkPipelineCache::GlobalCache = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineCache::vtkPipelineCache()
+{
+  this->MemoryLimit = 524288;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Internals = new vtkPipelineCacheInternals;
+  this->Lock = new vtkSimpleCriticalSection;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineCache::~vtkPipelineCache()
+{
+  delete this->Internals;
+  delete this->Lock;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineCache *vtkPipelineCache::GetGlobalCache()
+{
+  if (!vtkPipelineCache::GlobalCache)
+    {
+    vtkPipelineCache::GlobalCache = vtkPipelineCache::New();
+    }
+  return vtkPipelineCache::GlobalCache;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineCache::SetMemoryLimit(unsigned long limit)
+{
+  if (this->MemoryLimit == limit)
+    {
+    return;
+    }
+  this->Lock->Lock();
+  this->MemoryLimit = limit;
+  this->Evict();
+  this->Lock->Unlock();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineCache::Store(vtkExecutive* owner, const char* key,
+                            vtkDataObject** outputs, int numberOfOutputs,
+                            unsigned long time)
+{
+  vtkPipelineCacheInternals::Entry entry;
+  entry.Owner = owner;
+  entry.Key = key;
+  entry.Time = time;
+  entry.MemorySize = 0;
+  entry.Outputs.resize(numberOfOutputs, 0);
+  for (int i = 0; i < numberOfOutputs; ++i)
+    {
+    if (outputs[i])
+      {
+      entry.MemorySize += outputs[i]->GetActualMemorySize();
+      }
+    }
+
+  this->Lock->Lock();
+  vtkPipelineCacheInternals::EntryMap::iterator found =
+    this->Internals->Index.find(std::make_pair(owner, entry.Key));
+  if (found != this->Internals->Index.end())
+    {
+    this->Internals->Remove(found->second);
+    }
+  if (entry.MemorySize > this->MemoryLimit)
+    {
+    this->Lock->Unlock();
+    return 0;
+    }
+
+  for (int i = 0; i < numberOfOutputs; ++i)
+    {
+    if (outputs[i])
+      {
+      entry.Outputs[i] = outputs[i]->NewInstance();
+      entry.Outputs[i]->ShallowCopy(outputs[i]);
+      vtkPipelineCacheCopyInformation(outputs[i], entry.Outputs[i]);
+      }
+    }
+  this->Internals->Entries.push_front(entry);
+  this->Internals->Index[std::make_pair(owner, entry.Key)] =
+    this->Internals->Entries.begin();
+  this->Internals->MemorySize += entry.MemorySize;
+  this->Evict();
+  this->Lock->Unlock();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineCache::Retrieve(vtkExecutive* owner, const char* key,
+                               vtkDataObject** outputs, int numberOfOutputs,
+                               unsigned long pipelineMTime)
+{
+  this->Lock->Lock();
+
+  // Forget what the executive cached before it was modified.
+  vtkPipelineCacheInternals::EntryList::iterator it =
+    this->Internals->Entries.begin();
+  while (it != this->Internals->Entries.end())
+    {
+    vtkPipelineCacheInternals::EntryList::iterator entry = it++;
+    if (entry->Owner == owner && entry->Time < pipelineMTime)
+      {
+      this->Internals->Remove(entry);
+      }
+    }
+
+  vtkPipelineCacheInternals::EntryMap::iterator found =
+    this->Internals->Index.find(std::make_pair(owner, std::string(key)));
+  if (found == this->Internals->Index.end() ||
+      static_cast<int>(found->second->Outputs.size()) != numberOfOutputs)
+    {
+    ++this->NumberOfMisses;
+    this->Lock->Unlock();
+    return 0;
+    }
+
+  vtkPipelineCacheInternals::EntryList::iterator entry = found->second;
+  for (int i = 0; i < numberOfOutputs; ++i)
+    {
+    vtkDataObject* cached = entry->Outputs[i];
+    if (cached && outputs[i])
+      {
+      outputs[i]->ShallowCopy(cached);
+      vtkPipelineCacheCopyInformation(cached, outputs[i]);
+      }
+    }
+  this->Internals->Entries.splice(this->Internals->Entries.begin(),
+                                  this->Internals->Entries, entry);
+  ++this->NumberOfHits;
+  this->Lock->Unlock();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineCache::RemoveEntries(vtkExecutive* owner)
+{
+  this->Lock->Lock();
+  vtkPipelineCacheInternals::EntryList::iterator it =
+    this->Internals->Entries.begin();
+  while (it != this->Internals->Entries.end())
+    {
+    vtkPipelineCacheInternals::EntryList::iterator entry = it++;
+    if (entry->Owner == owner)
+      {
+      this->Internals->Remove(entry);
+      }
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineCache::RemoveAllEntries()
+{
+  this->Lock->Lock();
+  while (!this->Internals->Entries.empty())
+    {
+    this->Internals->Remove(this->Internals->Entries.begin());
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineCache::GetNumberOfEntries()
+{
+  this->Lock->Lock();
+  int number = static_cast<int>(this->Internals->Entries.size());
+  this->Lock->Unlock();
+  return number;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineCache::GetMemorySize()
+{
+  this->Lock->Lock();
+  unsigned long size = this->Internals->MemorySize;
+  this->Lock->Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineCache::ResetStatistics()
+{
+  this->Lock->Lock();
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineCache::Evict()
+{
+  while (this->Internals->MemorySize > this->MemoryLimit &&
+         !this->Internals->Entries.empty())
+    {
+    vtkPipelineCacheInternals::EntryList::iterator last =
+      this->Internals->Entries.end();
+    this->Internals->Remove(--last);
+    ++this->NumberOfEvictions;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryLimit: " << this->MemoryLimit << "\n";
+  os << indent << "NumberOfEntries: " << this->GetNumberOfEntries() << "\n";
+  os << indent << "MemorySize: " << this->GetMemorySize() << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
+}
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineCache - memory-limited LRU cache of algorithm outputs
+// .SECTION Description
+// vtkPipelineCache stores the outputs generated by algorithms so that the
+// executive of an algorithm can give them back, instead of executing the
+// algorithm again, when the same request is made later. Each entry holds
+// shallow copies of all the outputs of an algorithm for one request; it
+// is identified by the executive that stored it and by a key describing
+// the request, which the executive builds (see vtkCachingPipeline).
+//
+// The total memory of the entries, as given by
+// vtkDataObject::GetActualMemorySize(), is kept below MemoryLimit by
+// evicting the least recently used entries. Since the entries share their
+// arrays with the outputs of the pipeline, the memory released by an
+// eviction is only released when the pipeline does not use the data
+// anymore either.
+//
+// The cache counts the hits, the misses and the evictions, which helps to
+// size MemoryLimit. A single global cache is shared by default by all the
+// caching executives, so that MemoryLimit bounds the memory of the whole
+// application. The cache is thread safe.
+//
+// .SECTION See Also
+// vtkCachingPipeline vtkCachedStreamingDemandDrivenPipeline
+
+#ifndef __vtkPipelineCache_h
+#define __vtkPipelineCache_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataObject;
+class vtkExecutive;
+class vtkPipelineCacheInternals;
+class vtkSimpleCriticalSection;
+
+//BTX
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineCacheCleanup
+{
+public:
+  vtkPipelineCacheCleanup();
+  ~vtkPipelineCacheCleanup();
+
+private:
+  vtkPipelineCacheCleanup(const vtkPipelineCacheCleanup& other); // no copy constructor
+  vtkPipelineCacheCleanup& operator=(const vtkPipelineCacheCleanup& rhs); // no copy assignment
+};
+//ETX
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineCache : public vtkObject
+{
+public:
+  static vtkPipelineCache *New();
+  vtkTypeMacro(vtkPipelineCache,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return the cache shared by the executives that are not given one.
+  static vtkPipelineCache *GetGlobalCache();
+
+  // Description:
+  // The maximum memory of the entries, in kibibytes. Entries larger than
+  // the limit are not stored. The default is 524288 (512 MiB).
+  void SetMemoryLimit(unsigned long limit);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // Store shallow copies of the numberOfOutputs data objects of outputs
+  // for the request key of the executive owner. The entry is valid until
+  // the pipeline modified time of the executive exceeds time. Any previous
+  // entry of owner for key is replaced. Return 1 if the entry is stored.
+  int Store(vtkExecutive* owner, const char* key, vtkDataObject** outputs,
+            int numberOfOutputs, unsigned long time);
+
+  // Description:
+  // Shallow copy the data objects stored for the request key of the
+  // executive owner into outputs, after removing the entries of owner
+  // older than pipelineMTime. Return 1 on a hit and 0 on a miss. The entry
+  // becomes the most recently used.
+  int Retrieve(vtkExecutive* owner, const char* key, vtkDataObject** outputs,
+               int numberOfOutputs, unsigned long pipelineMTime);
+
+  // Description:
+  // Remove the entries of the executive owner, or of all executives.
+  void RemoveEntries(vtkExecutive* owner);
+  void RemoveAllEntries();
+
+  // Description:
+  // The number of entries and their total memory, in kibibytes.
+  int GetNumberOfEntries();
+  unsigned long GetMemorySize();
+
+  // Description:
+  // Statistics of the cache: the number of successful and failed
+  // retrievals, and the number of entries evicted to respect
+  // MemoryLimit.
+  vtkGetMacro(NumberOfHits, unsigned long);
+  vtkGetMacro(NumberOfMisses, unsigned long);
+  vtkGetMacro(NumberOfEvictions, unsigned long);
+  void ResetStatistics();
+
+//BTX
+  // Releases the global cache when the program exits.
+  static vtkPipelineCacheCleanup Cleanup;
+//ETX
+
+protected:
+  vtkPipelineCache();
+  ~vtkPipelineCache();
+
+  // Remove least recently used entries until the memory is below the
+  // limit. Must be called with the lock held.
+  void Evict();
+
+  unsigned long MemoryLimit;
+  unsigned long NumberOfHits;
+  unsigned long NumberOfMisses;
+  unsigned long NumberOfEvictions;
+
+private:
+  friend class vtkPipelineCacheCleanup;
+  static vtkPipelineCache *GlobalCache;
+
+  vtkPipelineCacheInternals* Internals;
+  vtkSimpleCriticalSection* Lock;
+
+  vtkPipelineCache(const vtkPipelineCache&);  // Not implemented.
+  void operator=(const vtkPipelineCache&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,530 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAtomicInt32.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkCriticalSection.h"
+#include "vtkDataObject.h"
+#include "vtkDataSet.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+// The profiler started is read by the executives of all threads, it is
+// only accessed with ActiveProfilerLock held. ActiveProfilerSet lets the
+// executives skip the lock while no profiler is started.
+vtkPipelineProfiler *vtkPipelineProfiler::ActiveProfiler = 0;
+static vtkSimpleCriticalSection vtkPipelineProfilerActiveProfilerLock;
+static vtkAtomicInt32 vtkPipelineProfilerActiveProfilerSet;
+
+//----------------------------------------------------------------------------
+class vtkPipelineProfilerInternals
+{
+public:
+  struct Event
+  {
+    vtkAlgorithm* Algorithm;
+    std::string AlgorithmName;
+    const char* Pass;
+    int Thread;
+    double StartTime;
+    double WallTime;
+    double CPUTime;
+    vtkIdType NumberOfInputCells;
+    vtkIdType NumberOfOutputCells;
+    vtkTypeInt64 OutputMemory;
+  };
+
+  std::vector<Event> Events;
+  std::vector<vtkMultiThreaderIDType> Threads;
+  double Origin;
+  bool HasOrigin;
+
+  vtkPipelineProfilerInternals() : Origin(0.0), HasOrigin(false) {}
+
+  // Number the threads in the order they are seen.
+  int GetThreadIndex(vtkMultiThreaderIDType id)
+    {
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+        {
+        return static_cast<int>(i);
+        }
+      }
+    this->Threads.push_back(id);
+    return static_cast<int>(this->Threads.size()) - 1;
+    }
+
+  // The CPU time of the calling thread, when available.
+  static double GetThreadCPUTime()
+    {
+#if defined(_WIN32)
+    FILETIME creation, exited, kernel, user;
+    if (GetThreadTimes(GetCurrentThread(), &creation, &exited, &kernel, &user))
+      {
+      ULARGE_INTEGER k, u;
+      k.LowPart = kernel.dwLowDateTime;
+      k.HighPart = kernel.dwHighDateTime;
+      u.LowPart = user.dwLowDateTime;
+      u.HighPart = user.dwHighDateTime;
+      return static_cast<double>(k.QuadPart + u.QuadPart) * 1.0e-7;
+      }
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec t;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0)
+      {
+      return static_cast<double>(t.tv_sec) + t.tv_nsec * 1.0e-9;
+      }
+#endif
+    return vtkTimerLog::GetCPUTime();
+    }
+
+  static vtkIdType GetNumberOfCells(vtkDataObject* data)
+    {
+    if (vtkDataSet* ds = vtkDataSet::SafeDownCast(data))
+      {
+      return ds->GetNumberOfCells();
+      }
+    vtkIdType numberOfCells = 0;
+    if (vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(data))
+      {
+      vtkCompositeDataIterator* iter = cds->NewIterator();
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+           iter->GoToNextItem())
+        {
+        if (vtkDataSet* block =
+            vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+          {
+          numberOfCells += block->GetNumberOfCells();
+          }
+        }
+      iter->Delete();
+      }
+    return numberOfCells;
+    }
+
+  static const char* GetPassName(vtkInformation* request)
+    {
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+      {
+      return "RequestData";
+      }
+    if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+      {
+      return "RequestUpdateExtent";
+      }
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+      {
+      return "RequestInformation";
+      }
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+      {
+      return "RequestDataObject";
+      }
+    if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_TIME()))
+      {
+      return "RequestUpdateTime";
+      }
+    if (request->Has(vtkStreamingDemandDrivenPipeline::
+                     REQUEST_TIME_DEPENDENT_INFORMATION()))
+      {
+      return "RequestTimeDependentInformation";
+      }
+    return "Request";
+    }
+
+  static void WriteJSONString(ostream& os, const std::string& s)
+    {
+    os << '"';
+    for (size_t i = 0; i < s.size(); ++i)
+      {
+      char c = s[i];
+      if (c == '"' || c == '\\')
+        {
+        os << '\\' << c;
+        }
+      else if (static_cast<unsigned char>(c) < 0x20)
+        {
+        os << ' ';
+        }
+      else
+        {
+        os << c;
+        }
+      }
+    os << '"';
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+{
+  this->Internals = new vtkPipelineProfilerInternals;
+  this->Lock = new vtkSimpleCriticalSection;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  // A started profiler holds a reference to itself, it is stopped here.
+  delete this->Lock;
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Start()
+{
+  this->Lock->Lock();
+  if (!this->Internals->HasOrigin)
+    {
+    this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+    this->Internals->HasOrigin = true;
+    }
+  this->Lock->Unlock();
+
+  vtkPipelineProfiler *previous = 0;
+  vtkPipelineProfilerActiveProfilerLock.Lock();
+  if (vtkPipelineProfiler::ActiveProfiler != this)
+    {
+    previous = vtkPipelineProfiler::ActiveProfiler;
+    vtkPipelineProfiler::ActiveProfiler = this;
+    this->Register(this);
+    vtkPipelineProfilerActiveProfilerSet.Set(1);
+    }
+  vtkPipelineProfilerActiveProfilerLock.Unlock();
+  if (previous)
+    {
+    previous->UnRegister(previous);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Stop()
+{
+  bool stopped = false;
+  vtkPipelineProfilerActiveProfilerLock.Lock();
+  if (vtkPipelineProfiler::ActiveProfiler == this)
+    {
+    vtkPipelineProfiler::ActiveProfiler = 0;
+    vtkPipelineProfilerActiveProfilerSet.Set(0);
+    stopped = true;
+    }
+  vtkPipelineProfilerActiveProfilerLock.Unlock();
+  // This may delete the profiler.
+  if (stopped)
+    {
+    this->UnRegister(this);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler *vtkPipelineProfiler::GetActiveProfiler()
+{
+  vtkPipelineProfilerActiveProfilerLock.Lock();
+  vtkPipelineProfiler *profiler = vtkPipelineProfiler::ActiveProfiler;
+  vtkPipelineProfilerActiveProfilerLock.Unlock();
+  return profiler;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler *vtkPipelineProfiler::RegisterActiveProfiler(
+  vtkObjectBase *owner)
+{
+  if (!vtkPipelineProfilerActiveProfilerSet.Get())
+    {
+    return 0;
+    }
+  vtkPipelineProfilerActiveProfilerLock.Lock();
+  vtkPipelineProfiler *profiler = vtkPipelineProfiler::ActiveProfiler;
+  if (profiler)
+    {
+    profiler->Register(owner);
+    }
+  vtkPipelineProfilerActiveProfilerLock.Unlock();
+  return profiler;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  this->Lock->Lock();
+  this->Internals->Events.clear();
+  this->Internals->Threads.clear();
+  this->Internals->HasOrigin =
+    vtkPipelineProfiler::GetActiveProfiler() == this;
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::BeginPass(Pass& pass, vtkExecutive* executive,
+                                    vtkInformation* request,
+                                    vtkInformationVector** inInfo)
+{
+  pass.Name = vtkPipelineProfilerInternals::GetPassName(request);
+  pass.NumberOfInputCells = 0;
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+    {
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+      {
+      for (int j = 0; j < inInfo[i]->GetNumberOfInformationObjects(); ++j)
+        {
+        pass.NumberOfInputCells += vtkPipelineProfilerInternals::
+          GetNumberOfCells(inInfo[i]->GetInformationObject(j)->Get(
+                             vtkDataObject::DATA_OBJECT()));
+        }
+      }
+    }
+  pass.StartCPUTime = vtkPipelineProfilerInternals::GetThreadCPUTime();
+  pass.StartTime = vtkTimerLog::GetUniversalTime();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::EndPass(Pass& pass, vtkExecutive* executive,
+                                  vtkInformationVector* outInfo)
+{
+  double endTime = vtkTimerLog::GetUniversalTime();
+  double endCPUTime = vtkPipelineProfilerInternals::GetThreadCPUTime();
+
+  vtkPipelineProfilerInternals::Event event;
+  event.Algorithm = executive->GetAlgorithm();
+  event.AlgorithmName = event.Algorithm->GetClassName();
+  event.Pass = pass.Name;
+  event.WallTime = endTime - pass.StartTime;
+  event.CPUTime = std::max(endCPUTime - pass.StartCPUTime, 0.0);
+  event.NumberOfInputCells = pass.NumberOfInputCells;
+  event.NumberOfOutputCells = 0;
+  event.OutputMemory = 0;
+  if (strcmp(pass.Name, "RequestData") == 0)
+    {
+    for (int i = 0; i < outInfo->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkDataObject* output =
+        outInfo->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+      if (output)
+        {
+        event.NumberOfOutputCells +=
+          vtkPipelineProfilerInternals::GetNumberOfCells(output);
+        event.OutputMemory +=
+          static_cast<vtkTypeInt64>(output->GetActualMemorySize()) * 1024;
+        }
+      }
+    }
+
+  this->Lock->Lock();
+  event.Thread = this->Internals->GetThreadIndex(
+    vtkMultiThreader::GetCurrentThreadID());
+  event.StartTime = pass.StartTime - this->Internals->Origin;
+  this->Internals->Events.push_back(event);
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfEvents()
+{
+  this->Lock->Lock();
+  int number = static_cast<int>(this->Internals->Events.size());
+  this->Lock->Unlock();
+  return number;
+}
+
+//----------------------------------------------------------------------------
+// Define the accessors of the members of the events. The events recorded
+// may only be moved by a pipeline executing at the same time.
+#define vtkPipelineProfilerGetEventMacro(name, type, member, defaultValue) \
+type vtkPipelineProfiler::GetEvent##name(int event) \
+{ \
+  if (event < 0 || event >= this->GetNumberOfEvents()) \
+    { \
+    vtkErrorMacro("No event " << event << "."); \
+    return defaultValue; \
+    } \
+  return this->Internals->Events[event].member; \
+}
+
+vtkPipelineProfilerGetEventMacro(Algorithm, vtkAlgorithm*, Algorithm, NULL)
+vtkPipelineProfilerGetEventMacro(AlgorithmName, const char*,
+                                 AlgorithmName.c_str(), NULL)
+vtkPipelineProfilerGetEventMacro(Pass, const char*, Pass, NULL)
+vtkPipelineProfilerGetEventMacro(Thread, int, Thread, -1)
+vtkPipelineProfilerGetEventMacro(StartTime, double, StartTime, 0.0)
+vtkPipelineProfilerGetEventMacro(WallTime, double, WallTime, 0.0)
+vtkPipelineProfilerGetEventMacro(CPUTime, double, CPUTime, 0.0)
+vtkPipelineProfilerGetEventMacro(NumberOfInputCells, vtkIdType,
+                                 NumberOfInputCells, 0)
+vtkPipelineProfilerGetEventMacro(NumberOfOutputCells, vtkIdType,
+                                 NumberOfOutputCells, 0)
+vtkPipelineProfilerGetEventMacro(OutputMemory, vtkTypeInt64, OutputMemory, 0)
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  this->Lock->Lock();
+  std::vector<vtkPipelineProfilerInternals::Event>& events =
+    this->Internals->Events;
+  std::streamsize precision = os.precision(15);
+  os << "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i)
+    {
+    const vtkPipelineProfilerInternals::Event& event = events[i];
+    // Complete events, with times in microseconds.
+    os << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    vtkPipelineProfilerInternals::WriteJSONString(os, event.AlgorithmName);
+    os << ",\"cat\":\"" << event.Pass << "\",\"ph\":\"X\""
+       << ",\"ts\":" << event.StartTime * 1.0e6
+       << ",\"dur\":" << event.WallTime * 1.0e6
+       << ",\"pid\":0,\"tid\":" << event.Thread
+       << ",\"args\":{\"pass\":\"" << event.Pass << "\""
+       << ",\"algorithm\":\"" << event.Algorithm << "\""
+       << ",\"cpu_ms\":" << event.CPUTime * 1.0e3;
+    if (strcmp(event.Pass, "RequestData") == 0)
+      {
+      os << ",\"input_cells\":" << event.NumberOfInputCells
+         << ",\"output_cells\":" << event.NumberOfOutputCells
+         << ",\"output_bytes\":" << event.OutputMemory;
+      }
+    os << "}}";
+    }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os.precision(precision);
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::WriteChromeTrace(const char* fileName)
+{
+  if (!fileName)
+    {
+    vtkErrorMacro("No file name given.");
+    return 0;
+    }
+  ofstream os(fileName);
+  if (!os)
+    {
+    vtkErrorMacro("Cannot open " << fileName << " for writing.");
+    return 0;
+    }
+  this->WriteChromeTrace(os);
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+struct vtkPipelineProfilerSummary
+{
+  std::string Name;
+  vtkAlgorithm* Algorithm;
+  int NumberOfExecutions;
+  double WallTime;
+  double CPUTime;
+  vtkIdType NumberOfOutputCells;
+  vtkTypeInt64 OutputMemory;
+
+  bool operator<(const vtkPipelineProfilerSummary& other) const
+    {
+    return this->WallTime > other.WallTime;
+    }
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  std::vector<vtkPipelineProfilerSummary> summaries;
+  std::map<vtkAlgorithm*, size_t> index;
+  double wallTime = 0.0;
+  this->Lock->Lock();
+  std::vector<vtkPipelineProfilerInternals::Event>& events =
+    this->Internals->Events;
+  for (size_t i = 0; i < events.size(); ++i)
+    {
+    const vtkPipelineProfilerInternals::Event& event = events[i];
+    std::map<vtkAlgorithm*, size_t>::iterator found =
+      index.find(event.Algorithm);
+    if (found == index.end() ||
+        summaries[found->second].Name != event.AlgorithmName)
+      {
+      vtkPipelineProfilerSummary summary;
+      summary.Name = event.AlgorithmName;
+      summary.Algorithm = event.Algorithm;
+      summary.NumberOfExecutions = 0;
+      summary.WallTime = 0.0;
+      summary.CPUTime = 0.0;
+      summary.NumberOfOutputCells = 0;
+      summary.OutputMemory = 0;
+      index[event.Algorithm] = summaries.size();
+      summaries.push_back(summary);
+      found = index.find(event.Algorithm);
+      }
+    vtkPipelineProfilerSummary& summary = summaries[found->second];
+    if (strcmp(event.Pass, "RequestData") == 0)
+      {
+      ++summary.NumberOfExecutions;
+      summary.NumberOfOutputCells += event.NumberOfOutputCells;
+      summary.OutputMemory += event.OutputMemory;
+      }
+    summary.WallTime += event.WallTime;
+    summary.CPUTime += event.CPUTime;
+    wallTime += event.WallTime;
+    }
+  this->Lock->Unlock();
+
+  std::stable_sort(summaries.begin(), summaries.end());
+  os << "Algorithm, executions, wall time (ms), %, CPU time (ms), "
+     << "output cells, output bytes\n";
+  for (size_t i = 0; i < summaries.size(); ++i)
+    {
+    const vtkPipelineProfilerSummary& summary = summaries[i];
+    os << summary.Name << " (" << summary.Algorithm << "), "
+       << summary.NumberOfExecutions << ", "
+       << summary.WallTime * 1.0e3 << ", "
+       << (wallTime > 0.0 ? 100.0 * summary.WallTime / wallTime : 0.0) << ", "
+       << summary.CPUTime * 1.0e3 << ", "
+       << summary.NumberOfOutputCells << ", "
+       << summary.OutputMemory << "\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Active: "
+     << (vtkPipelineProfiler::ActiveProfiler == this ? "On\n" : "Off\n");
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << "\n";
+}
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineProfiler - records the passes executed by a pipeline
+// .SECTION Description
+// vtkPipelineProfiler records an event for each request that the
+// executives send to their algorithm while it is started: the
+// RequestDataObject, RequestInformation, RequestUpdateExtent and
+// RequestData passes of every algorithm of the pipelines updated. Each
+// event holds the algorithm, the pass, the thread that executed it, its
+// wall clock and CPU times and, for RequestData, the number of cells of
+// the inputs and of the outputs and the memory of the outputs.
+//
+// The events can be written in the Chrome trace event format, which
+// chrome://tracing and other trace viewers display as a timeline with one
+// row per thread, and summarized per algorithm by PrintSummary() to find
+// the slowest stages of a pipeline.
+//
+// A single profiler is started at a time. The profiler is thread safe, the
+// passes executed concurrently by vtkExecutionScheduler or by
+// vtkSMPTools are recorded with their thread. A started profiler holds a
+// reference to itself until it is stopped, and the executives hold one
+// while they record a pass, so that it may be stopped or released while
+// pipelines are running on other threads. The pipelines are not slowed
+// down while no profiler is started.
+//
+// .SECTION Caveats
+// The times of a pass do not include the passes it forwards upstream, but
+// include the pipelines updated by the algorithm itself, which are
+// recorded as nested events. The CPU time is the one of the thread
+// executing the pass, when the platform provides it, and of the process
+// otherwise.
+//
+// .SECTION See Also
+// vtkExecutive vtkExecutionScheduler vtkTimerLog
+
+#ifndef __vtkPipelineProfiler_h
+#define __vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkExecutive;
+class vtkInformation;
+class vtkInformationVector;
+class vtkPipelineProfilerInternals;
+class vtkSimpleCriticalSection;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler *New();
+  vtkTypeMacro(vtkPipelineProfiler,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Start recording the passes executed by all the pipelines, replacing
+  // the profiler started, if any. The times of the events are relative to
+  // the first start since the last call to Clear().
+  void Start();
+
+  // Description:
+  // Stop recording. The events recorded are kept. The profiler is not
+  // deleted until it is stopped.
+  void Stop();
+
+  // Description:
+  // Return the profiler started, or NULL.
+  static vtkPipelineProfiler *GetActiveProfiler();
+
+  // Description:
+  // Return the profiler started, or NULL, registered by the given owner,
+  // which must unregister it when done. This is how the executives keep
+  // the profiler alive while they execute a pass.
+  static vtkPipelineProfiler *RegisterActiveProfiler(vtkObjectBase *owner);
+
+  // Description:
+  // Remove the events recorded.
+  void Clear();
+
+  // Description:
+  // The events recorded, in the order the passes ended. The algorithm of
+  // an event may have been deleted since, its class name is kept. The
+  // pass is "RequestDataObject", "RequestInformation",
+  // "RequestUpdateExtent", "RequestData", "RequestUpdateTime",
+  // "RequestTimeDependentInformation" or "Request" for other requests.
+  // The threads are numbered in the order they first executed a pass. The
+  // times are in seconds, the start time is relative to the start of the
+  // profiler. The cell counts and the memory of the outputs, in bytes,
+  // are only computed for RequestData, they are 0 for the other passes.
+  int GetNumberOfEvents();
+  vtkAlgorithm* GetEventAlgorithm(int event);
+  const char* GetEventAlgorithmName(int event);
+  const char* GetEventPass(int event);
+  int GetEventThread(int event);
+  double GetEventStartTime(int event);
+  double GetEventWallTime(int event);
+  double GetEventCPUTime(int event);
+  vtkIdType GetEventNumberOfInputCells(int event);
+  vtkIdType GetEventNumberOfOutputCells(int event);
+  vtkTypeInt64 GetEventOutputMemory(int event);
+
+  // Description:
+  // Write the events in the Chrome trace event JSON format. Return 0 if
+  // the file cannot be written.
+  void WriteChromeTrace(ostream& os);
+  int WriteChromeTrace(const char* fileName);
+
+  // Description:
+  // Print, for each algorithm, the number of times it executed
+  // RequestData, its total wall clock and CPU times, and the cells and
+  // the memory it generated, the slowest algorithms first.
+  void PrintSummary(ostream& os);
+
+//BTX
+  // Description:
+  // A pass being executed, see BeginPass().
+  struct Pass
+  {
+    const char* Name;
+    double StartTime;
+    double StartCPUTime;
+    vtkIdType NumberOfInputCells;
+  };
+
+  // Description:
+  // Called by vtkExecutive around the requests it sends to its algorithm.
+  void BeginPass(Pass& pass, vtkExecutive* executive, vtkInformation* request,
+                 vtkInformationVector** inInfo);
+  void EndPass(Pass& pass, vtkExecutive* executive,
+               vtkInformationVector* outInfo);
+//ETX
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler();
+
+private:
+  static vtkPipelineProfiler *ActiveProfiler;
+
+  vtkPipelineProfilerInternals* Internals;
+  vtkSimpleCriticalSection* Lock;
+
+  vtkPipelineProfiler(const vtkPipelineProfiler&);  // Not implemented.
+  void operator=(const vtkPipelineProfiler&);  // Not implemented.
+};
+
+#endif
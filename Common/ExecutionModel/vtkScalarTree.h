@@ -25,6 +25,11 @@
 // and then specify a scalar value in the InitTraversal() method. Then
 // calls to GetNextCell() return cells whose scalar data contains the
 // scalar value specified.
+//
+// GetNextCell() keeps the traversal state in the tree. Parallel algorithms
+// use the batch interface instead: after InitTraversal(), the candidate
+// cells are split into batches (GetNumberOfCellBatches()), and the batches
+// (GetCellBatch()) can be processed concurrently.
 
 // .SECTION See Also
 // vtkSimpleScalarTree
@@ -52,6 +57,13 @@ public:
   virtual void SetDataSet(vtkDataSet*);
   vtkGetObjectMacro(DataSet,vtkDataSet);
 
+  // Description:
+  // Set the point scalars to build the tree from. When not set (the
+  // default), the active point scalars of the dataset are used. Only the
+  // first component of the scalars is considered.
+  virtual void SetScalars(vtkDataArray*);
+  vtkGetObjectMacro(Scalars,vtkDataArray);
+
   // Description:
   // Construct the scalar tree from the dataset provided. Checks build times
   // and modified time from input and reconstructs the tree if necessary.
@@ -74,12 +86,23 @@ public:
   virtual vtkCell *GetNextCell(vtkIdType &cellId, vtkIdList* &ptIds,
                                vtkDataArray *cellScalars) = 0;
 
+  // Description:
+  // Get the number of cell batches for the scalar value specified in
+  // InitTraversal(), and the ids of the cells of a batch. The batches hold
+  // all the cells whose scalar data may contain the scalar value (some of
+  // them may not contain it). GetNumberOfCellBatches() must be called,
+  // from a single thread, after InitTraversal(); GetCellBatch() is then
+  // thread safe. The returned ids are valid until the next traversal.
+  virtual vtkIdType GetNumberOfCellBatches() = 0;
+  virtual const vtkIdType *GetCellBatch(vtkIdType batchNum,
+                                        vtkIdType &numCells) = 0;
+
 protected:
   vtkScalarTree();
   ~vtkScalarTree();
 
   vtkDataSet   *DataSet;    //the dataset over which the scalar tree is built
-  vtkDataArray *Scalars;    //the scalars of the DataSet
+  vtkDataArray *Scalars;    //the scalars to build the tree from
 
   vtkTimeStamp BuildTime; //time at which tree was built
   double       ScalarValue; //current scalar value for traversal
@@ -15,11 +15,12 @@
 #include "vtkSimpleScalarTree.h"
 
 #include "vtkCell.h"
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
-#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 
 vtkStandardNewMacro(vtkSimpleScalarTree);
 
@@ -33,6 +34,91 @@ public:
   TScalar max;
 };
 
+namespace
+{
+// Compute the scalar range of the leaves of the tree, leaf i covering the
+// cells [i*branchingFactor, (i+1)*branchingFactor). The scalars are read
+// through a raw pointer so that the leaves can be processed concurrently.
+template <class T>
+class vtkSimpleScalarTreeLeafRanges
+{
+public:
+  vtkDataSet *DataSet;
+  const T *Scalars;
+  int NumberOfComponents;
+  int BranchingFactor;
+  vtkIdType NumberOfCells;
+  vtkScalarRange<double> *Leafs;
+  vtkSMPThreadLocal<vtkIdList*> CellPts;
+
+  vtkSimpleScalarTreeLeafRanges()
+    : CellPts(static_cast<vtkIdList*>(NULL)) {}
+  ~vtkSimpleScalarTreeLeafRanges()
+    {
+    vtkSMPThreadLocal<vtkIdList*>::iterator iter;
+    for (iter = this->CellPts.begin(); iter != this->CellPts.end(); ++iter)
+      {
+      if (*iter)
+        {
+        (*iter)->Delete();
+        }
+      }
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *&cellPts = this->CellPts.Local();
+    if (!cellPts)
+      {
+      cellPts = vtkIdList::New();
+      }
+    for (vtkIdType leaf = begin; leaf < end; leaf++)
+      {
+      vtkScalarRange<double> *tree = this->Leafs + leaf;
+      vtkIdType cellId = leaf * this->BranchingFactor;
+      vtkIdType lastId = cellId + this->BranchingFactor;
+      if (lastId > this->NumberOfCells)
+        {
+        lastId = this->NumberOfCells;
+        }
+      for ( ; cellId < lastId; cellId++ )
+        {
+        this->DataSet->GetCellPoints(cellId, cellPts);
+        vtkIdType numScalars = cellPts->GetNumberOfIds();
+        for ( vtkIdType j=0; j < numScalars; j++ )
+          {
+          double s = static_cast<double>(
+            this->Scalars[cellPts->GetId(j) * this->NumberOfComponents]);
+          if ( s < tree->min )
+            {
+            tree->min = s;
+            }
+          if ( s > tree->max )
+            {
+            tree->max = s;
+            }
+          }
+        }
+      }
+    }
+};
+
+template <class T>
+void vtkSimpleScalarTreeComputeLeafRanges(
+  vtkDataSet *dataSet, const T *scalars, int numComp, int branchingFactor,
+  vtkIdType numLeafs, vtkScalarRange<double> *leafs)
+{
+  vtkSimpleScalarTreeLeafRanges<T> ranges;
+  ranges.DataSet = dataSet;
+  ranges.Scalars = scalars;
+  ranges.NumberOfComponents = numComp;
+  ranges.BranchingFactor = branchingFactor;
+  ranges.NumberOfCells = dataSet->GetNumberOfCells();
+  ranges.Leafs = leafs;
+  vtkSMPTools::For(0, numLeafs, ranges);
+}
+}
+
 // Instantiate scalar tree with maximum level of 20 and branching
 // factor of 5.
 vtkSimpleScalarTree::vtkSimpleScalarTree()
@@ -43,11 +129,15 @@ vtkSimpleScalarTree::vtkSimpleScalarTree()
   this->BranchingFactor = 3;
   this->Tree = NULL;
   this->TreeSize = 0;
+  this->BatchSize = 1000;
+  this->CandidateCells = NULL;
+  this->NumberOfCandidateCells = -1;
 }
 
 vtkSimpleScalarTree::~vtkSimpleScalarTree()
 {
   delete [] this->Tree;
+  delete [] this->CandidateCells;
 }
 
 // Initialize locator. Frees memory and resets object as appropriate.
@@ -55,20 +145,19 @@ void vtkSimpleScalarTree::Initialize()
 {
   delete [] this->Tree;
   this->Tree = NULL;
+  delete [] this->CandidateCells;
+  this->CandidateCells = NULL;
+  this->NumberOfCandidateCells = -1;
 }
 
 // Construct the scalar tree from the dataset provided. Checks build times
 // and modified time from input and reconstructs the tree if necessaery.
 void vtkSimpleScalarTree::BuildTree()
 {
-  vtkIdType numCells, cellId, i, j, numScalars;
+  vtkIdType numCells, cellId, i, j;
   int level, offset, parentOffset, prod;
   vtkIdType numNodes, node, numLeafs, leaf, numParentLeafs;
-  vtkCell *cell;
-  vtkIdList *cellPts;
   vtkScalarRange<double> *tree, *parent;
-  double *s;
-  vtkDoubleArray *cellScalars;
 
   // Check input...see whether we have to rebuild
   //
@@ -78,24 +167,30 @@ void vtkSimpleScalarTree::BuildTree()
     return;
     }
 
-  if ( this->Tree != NULL && this->BuildTime > this->MTime
-    && this->BuildTime > this->DataSet->GetMTime() )
+  // The scalars set with SetScalars() (the superclass ivar) take precedence
+  // over the active scalars of the dataset.
+  vtkDataArray *scalars = this->GetScalars();
+  if ( ! scalars )
     {
+    scalars = this->DataSet->GetPointData()->GetScalars();
+    }
+  if ( ! scalars )
+    {
+    vtkErrorMacro( << "No scalar data to build trees with");
     return;
     }
 
-  vtkDebugMacro( << "Building scalar tree..." );
-
-  this->Scalars = this->DataSet->GetPointData()->GetScalars();
-  if ( ! this->Scalars )
+  if ( this->Tree != NULL && this->BuildTime > this->MTime
+    && this->BuildTime > this->DataSet->GetMTime()
+    && scalars == this->Scalars && this->BuildTime > scalars->GetMTime() )
     {
-    vtkErrorMacro( << "No scalar data to build trees with");
     return;
     }
 
+  vtkDebugMacro( << "Building scalar tree..." );
+
+  this->Scalars = scalars;
   this->Initialize();
-  cellScalars = vtkDoubleArray::New();
-  cellScalars->Allocate(100);
 
   // Compute the number of levels in the tree
   //
@@ -118,33 +213,45 @@ void vtkSimpleScalarTree::BuildTree()
     TTree[i].max = -VTK_DOUBLE_MAX;
     }
 
-  // Loop over all cells getting range of scalar data and place into leafs
+  // Loop over all cells getting range of scalar data and place into leafs.
+  // A first serial call lets the dataset build its cell structures (as
+  // vtkPolyData does) before the leaves are processed in parallel.
   //
-  for ( cellId=0, node=0; node < numLeafs; node++ )
+  vtkIdList *cellPts = vtkIdList::New();
+  this->DataSet->GetCellPoints(0, cellPts);
+  switch ( this->Scalars->GetDataType() )
     {
-    tree = TTree + offset + node;
-    for ( i=0; i < this->BranchingFactor && cellId < numCells; i++, cellId++ )
-      {
-      cell = this->DataSet->GetCell(cellId);
-      cellPts = cell->GetPointIds();
-      numScalars = cellPts->GetNumberOfIds();
-      cellScalars->SetNumberOfTuples(numScalars);
-      this->Scalars->GetTuples(cellPts, cellScalars);
-      s = cellScalars->GetPointer(0);
-
-      for ( j=0; j < numScalars; j++ )
+    vtkTemplateMacro(
+      vtkSimpleScalarTreeComputeLeafRanges(
+        this->DataSet,
+        static_cast<VTK_TT*>(this->Scalars->GetVoidPointer(0)),
+        this->Scalars->GetNumberOfComponents(), this->BranchingFactor,
+        numLeafs, TTree + offset));
+
+    default:
+      for ( cellId=0, node=0; node < numLeafs; node++ )
         {
-        if ( s[j] < tree->min )
-          {
-          tree->min = s[j];
-          }
-        if ( s[j] > tree->max )
+        tree = TTree + offset + node;
+        for ( i=0; i < this->BranchingFactor && cellId < numCells;
+              i++, cellId++ )
           {
-          tree->max = s[j];
+          this->DataSet->GetCellPoints(cellId, cellPts);
+          for ( j=0; j < cellPts->GetNumberOfIds(); j++ )
+            {
+            double s = this->Scalars->GetComponent(cellPts->GetId(j), 0);
+            if ( s < tree->min )
+              {
+              tree->min = s;
+              }
+            if ( s > tree->max )
+              {
+              tree->max = s;
+              }
+            }
           }
         }
-      }
     }
+  cellPts->Delete();
 
   // Now build top levels of tree in bottom-up fashion
   //
@@ -177,7 +284,6 @@ void vtkSimpleScalarTree::BuildTree()
     }
 
   this->BuildTime.Modified();
-  cellScalars->Delete();
 }
 
 // Begin to traverse the cells based on a scalar value. Returned cells
@@ -190,6 +296,7 @@ void vtkSimpleScalarTree::InitTraversal(double scalarValue)
 
   this->ScalarValue = scalarValue;
   this->TreeIndex = this->TreeSize;
+  this->NumberOfCandidateCells = -1;
 
   // Check root of tree for overlap with scalar value
   //
@@ -336,6 +443,92 @@ vtkCell *vtkSimpleScalarTree::GetNextCell(vtkIdType& cellId,
   return NULL;
 }
 
+// Gather the cells of the leaves below node index (at the given level)
+// whose range contains the scalar value. The cells are only counted when
+// CandidateCells is NULL.
+void vtkSimpleScalarTree::GatherCandidateCells(vtkIdType index, int level,
+                                               vtkIdType &numCandidates)
+{
+  vtkScalarRange<double> *tree = static_cast<
+    vtkScalarRange<double>*>(this->Tree) + index;
+  if ( tree->min > this->ScalarValue || tree->max < this->ScalarValue )
+    {
+    return;
+    }
+
+  if ( level < this->Level )
+    {
+    vtkIdType childIndex = this->BranchingFactor*index + 1;
+    for ( int i=0; i < this->BranchingFactor &&
+            childIndex + i < this->TreeSize; i++ )
+      {
+      this->GatherCandidateCells(childIndex + i, level + 1, numCandidates);
+      }
+    return;
+    }
+
+  vtkIdType cellId = (index - this->LeafOffset) * this->BranchingFactor;
+  vtkIdType lastId = cellId + this->BranchingFactor;
+  if ( lastId > this->DataSet->GetNumberOfCells() )
+    {
+    lastId = this->DataSet->GetNumberOfCells();
+    }
+  for ( ; cellId < lastId; cellId++, numCandidates++ )
+    {
+    if ( this->CandidateCells )
+      {
+      this->CandidateCells[numCandidates] = cellId;
+      }
+    }
+}
+
+// Gather the candidate cells of the current traversal, the first time the
+// batches are requested.
+vtkIdType vtkSimpleScalarTree::GetNumberOfCellBatches()
+{
+  if ( this->Tree == NULL )
+    {
+    return 0;
+    }
+
+  if ( this->NumberOfCandidateCells < 0 )
+    {
+    delete [] this->CandidateCells;
+    this->CandidateCells = NULL;
+    vtkIdType numCandidates = 0;
+    this->GatherCandidateCells(0, 0, numCandidates);
+    if ( numCandidates > 0 )
+      {
+      this->CandidateCells = new vtkIdType[numCandidates];
+      numCandidates = 0;
+      this->GatherCandidateCells(0, 0, numCandidates);
+      }
+    this->NumberOfCandidateCells = numCandidates;
+    }
+
+  return (this->NumberOfCandidateCells + this->BatchSize - 1) /
+    this->BatchSize;
+}
+
+const vtkIdType *vtkSimpleScalarTree::GetCellBatch(vtkIdType batchNum,
+                                                   vtkIdType &numCells)
+{
+  vtkIdType first = batchNum * this->BatchSize;
+  if ( this->NumberOfCandidateCells <= 0 || batchNum < 0 ||
+       first >= this->NumberOfCandidateCells )
+    {
+    numCells = 0;
+    return NULL;
+    }
+
+  numCells = this->NumberOfCandidateCells - first;
+  if ( numCells > this->BatchSize )
+    {
+    numCells = this->BatchSize;
+    }
+  return this->CandidateCells + first;
+}
+
 void vtkSimpleScalarTree::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
@@ -343,5 +536,6 @@ void vtkSimpleScalarTree::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Level: " << this->Level << "\n" ;
   os << indent << "Max Level: " << this->MaxLevel << "\n" ;
   os << indent << "Branching Factor: " << this->BranchingFactor << "\n" ;
+  os << indent << "Batch Size: " << this->BatchSize << "\n" ;
 }
 
@@ -28,6 +28,11 @@
 // cell ids (0,n-1); leaf node i=1 contains the range from cell ids (n,2n-1);
 // and so on. The implication is that there are no direct lists of cell ids
 // per leaf node, instead the cell ids are implicitly known.
+//
+// The scalar ranges of the leaves are computed in parallel with
+// vtkSMPTools. For the batch interface, the cells of the leaves whose range
+// contains the scalar value are gathered in InitTraversal() order and split
+// into batches of at least BatchSize cells.
 
 #ifndef __vtkSimpleScalarTree_h
 #define __vtkSimpleScalarTree_h
@@ -70,6 +75,12 @@ public:
   vtkSetClampMacro(MaxLevel,int,1,VTK_INT_MAX);
   vtkGetMacro(MaxLevel,int);
 
+  // Description:
+  // Set the number of cells per batch returned by GetCellBatch() (the
+  // last batch may be smaller). The default is 1000.
+  vtkSetClampMacro(BatchSize,vtkIdType,1,VTK_ID_MAX);
+  vtkGetMacro(BatchSize,vtkIdType);
+
   // Description:
   // Construct the scalar tree from the dataset provided. Checks build times
   // and modified time from input and reconstructs the tree if necessary.
@@ -92,24 +103,36 @@ public:
   virtual vtkCell *GetNextCell(vtkIdType &cellId, vtkIdList* &ptIds,
                                vtkDataArray *cellScalars);
 
+  // Description:
+  // Thread safe access to the cells that may contain the scalar value
+  // specified in InitTraversal(). See vtkScalarTree.
+  virtual vtkIdType GetNumberOfCellBatches();
+  virtual const vtkIdType *GetCellBatch(vtkIdType batchNum,
+                                        vtkIdType &numCells);
+
 protected:
   vtkSimpleScalarTree();
   ~vtkSimpleScalarTree();
 
-  vtkDataArray *Scalars;
+  vtkDataArray *Scalars; //scalars the tree was built from
   int MaxLevel;
   int Level;
   int BranchingFactor; //number of children per node
   vtkScalarNode *Tree; //pointerless scalar range tree
   int TreeSize; //allocated size of tree
+  vtkIdType BatchSize;
 
 private:
   vtkIdType TreeIndex; //traversal location within tree
   vtkIdType LeafOffset; //offset to leaf nodes of tree
   int       ChildNumber; //current child in traversal
   vtkIdType CellId; //current cell id being examined
+  vtkIdType *CandidateCells; //cells of the leaves spanning the scalar value
+  vtkIdType NumberOfCandidateCells; //-1 until gathered for the traversal
   int       FindStartLeaf(vtkIdType index, int level);
   int       FindNextLeaf(vtkIdType index,int level);
+  void      GatherCandidateCells(vtkIdType index, int level,
+                                 vtkIdType &numCandidates);
 
 private:
   vtkSimpleScalarTree(const vtkSimpleScalarTree&);  // Not implemented.
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkThreadedImageAlgorithm.h"
 
+#include "vtkAtomicInt32.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
 #include "vtkDataArray.h"
@@ -24,13 +25,33 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimerLog.h"
 
 
+// Initial value of EnableDynamicScheduling for new filters.
+static int vtkThreadedImageAlgorithmGlobalDynamicScheduling = 0;
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SetGlobalDefaultEnableDynamicScheduling(
+  int val)
+{
+  vtkThreadedImageAlgorithmGlobalDynamicScheduling = val;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedImageAlgorithm::GetGlobalDefaultEnableDynamicScheduling()
+{
+  return vtkThreadedImageAlgorithmGlobalDynamicScheduling;
+}
+
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+  this->EnableDynamicScheduling =
+    vtkThreadedImageAlgorithmGlobalDynamicScheduling;
+  this->DesiredBytesPerPiece = 65536;
 }
 
 //----------------------------------------------------------------------------
@@ -45,6 +66,10 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "EnableDynamicScheduling: "
+     << (this->EnableDynamicScheduling ? "On\n" : "Off\n");
+  os << indent << "DesiredBytesPerPiece: "
+     << this->DesiredBytesPerPiece << "\n";
 }
 
 struct vtkImageThreadStruct
@@ -55,8 +80,52 @@ struct vtkImageThreadStruct
   vtkInformationVector *OutputsInfo;
   vtkImageData   ***Inputs;
   vtkImageData   **Outputs;
+  // For dynamic scheduling: the number of pieces (zero when the extent is
+  // split statically, one piece per thread) and the next piece to execute.
+  int NumberOfPieces;
+  vtkAtomicInt32 NextPiece;
 };
 
+//----------------------------------------------------------------------------
+// Split the extent into pieces of roughly DesiredBytesPerPiece bytes of
+// output scalars, and at least one piece per thread.
+int vtkThreadedImageAlgorithm::ComputeNumberOfPieces(vtkImageData *outData,
+                                                     int extent[6])
+{
+  vtkIdType bytesPerVoxel = 1;
+  if (outData)
+    {
+    bytesPerVoxel = outData->GetScalarSize() *
+      outData->GetNumberOfScalarComponents();
+    }
+
+  vtkIdType numVoxels = 1;
+  for (int i = 0; i < 3; ++i)
+    {
+    if (extent[2*i+1] < extent[2*i])
+      {
+      return this->NumberOfThreads;
+      }
+    numVoxels *= extent[2*i+1] - extent[2*i] + 1;
+    }
+
+  vtkIdType numPieces = (numVoxels*bytesPerVoxel + this->DesiredBytesPerPiece
+                         - 1)/this->DesiredBytesPerPiece;
+  if (numPieces < this->NumberOfThreads)
+    {
+    numPieces = this->NumberOfThreads;
+    }
+  if (numPieces > numVoxels)
+    {
+    numPieces = numVoxels;
+    }
+  if (numPieces > VTK_INT_MAX)
+    {
+    numPieces = VTK_INT_MAX;
+    }
+  return static_cast<int>(numPieces);
+}
+
 //----------------------------------------------------------------------------
 // For streaming and threads.  Splits output update extent into num pieces.
 // This method needs to be called num times.  Results must not overlap for
@@ -182,6 +251,37 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
       }
     }
 
+  // with dynamic scheduling, keep taking the next piece until none are left
+  if (str->NumberOfPieces > 0)
+    {
+    for (;;)
+      {
+      int piece = str->NextPiece.Increment() - 1;
+      if (piece >= str->NumberOfPieces)
+        {
+        break;
+        }
+      // the extent might split into fewer pieces than requested
+      total = str->Filter->SplitExtent(splitExt, ext, piece,
+                                       str->NumberOfPieces);
+      if (piece >= total)
+        {
+        break;
+        }
+      if (splitExt[1] < splitExt[0] ||
+          splitExt[3] < splitExt[2] ||
+          splitExt[5] < splitExt[4])
+        {
+        continue;
+        }
+      str->Filter->ThreadedRequestData(str->Request,
+                                       str->InputsInfo, str->OutputsInfo,
+                                       str->Inputs, str->Outputs,
+                                       splitExt, threadId);
+      }
+    return VTK_THREAD_RETURN_VALUE;
+    }
+
   // execute the actual method with appropriate extent
   // first find out how many pieces extent can be split into.
   total = str->Filter->SplitExtent(splitExt, ext, threadId, threadCount);
@@ -283,6 +383,16 @@ int vtkThreadedImageAlgorithm::RequestData(
     this->CopyAttributeData(str.Inputs[0][0],str.Outputs[0],inputVector);
     }
 
+  // decide whether to split the output into many pieces, only the first
+  // output is used to estimate the size of the pieces
+  str.NumberOfPieces = 0;
+  if (this->EnableDynamicScheduling && this->NumberOfThreads > 1 &&
+      str.Outputs && str.Outputs[0])
+    {
+    str.NumberOfPieces = this->ComputeNumberOfPieces(
+      str.Outputs[0], str.Outputs[0]->GetExtent());
+    }
+
   this->Threader->SetNumberOfThreads(this->NumberOfThreads);
   this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);
 
@@ -292,6 +402,13 @@ int vtkThreadedImageAlgorithm::RequestData(
   this->Threader->SingleMethodExecute();
   this->Debug = debug;
 
+  // record how long it took to get all the threads going
+  if (vtkTimerLog::GetLogging())
+    {
+    vtkTimerLog::FormatAndMarkEvent("%s dispatch %.1f us",
+      this->GetClassName(), 1.0e6*this->Threader->GetLastDispatchLatency());
+    }
+
   // free up the arrays
   for (i = 0; i < this->GetNumberOfInputPorts(); ++i)
     {
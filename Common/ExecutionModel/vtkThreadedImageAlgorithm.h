@@ -19,6 +19,11 @@
 // into smaller extents so that the vtkImageData limits are observed. It
 // also provides support for multithreading. If you don't need any of this
 // functionality, consider using vtkSimpleImageToImageAlgorithm instead.
+//
+// By default the output extent is split into one piece per thread. With
+// EnableDynamicScheduling on, it is split into many smaller pieces which
+// the threads pick up one at a time until none are left, so that threads
+// that finish early keep working when the cost per voxel is uneven.
 // .SECTION See also
 // vtkSimpleImageToImageAlgorithm
 
@@ -59,6 +64,33 @@ public:
   vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Enable/Disable dynamic scheduling of the pieces. When on, the output
+  // extent is split into pieces of about DesiredBytesPerPiece bytes that
+  // are handed out to the threads from a shared counter. Each thread
+  // therefore calls ThreadedRequestData() several times with the same
+  // threadId, so subclasses that keep per-thread results must accumulate
+  // them rather than reset them in ThreadedRequestData().
+  // Initialized from GetGlobalDefaultEnableDynamicScheduling().
+  vtkSetMacro(EnableDynamicScheduling, int);
+  vtkGetMacro(EnableDynamicScheduling, int);
+  vtkBooleanMacro(EnableDynamicScheduling, int);
+
+  // Description:
+  // Set/Get the value used to initialize EnableDynamicScheduling in the
+  // constructor. It is off by default.
+  static void SetGlobalDefaultEnableDynamicScheduling(int val);
+  static int GetGlobalDefaultEnableDynamicScheduling();
+
+  // Description:
+  // The approximate size, in bytes of output scalars, of the pieces that
+  // are handed out to the threads when dynamic scheduling is enabled.
+  // Smaller pieces balance the load better but cost more overhead. The
+  // output is always split into at least NumberOfThreads pieces. The
+  // default is 65536.
+  vtkSetClampMacro(DesiredBytesPerPiece, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(DesiredBytesPerPiece, vtkIdType);
+
   // Description:
   // Putting this here until I merge graphics and imaging streaming.
   virtual int SplitExtent(int splitExt[6], int startExt[6],
@@ -70,6 +102,13 @@ protected:
 
   vtkMultiThreader *Threader;
   int NumberOfThreads;
+  int EnableDynamicScheduling;
+  vtkIdType DesiredBytesPerPiece;
+
+  // Description:
+  // Compute the number of pieces to split the given extent of the output
+  // into when dynamic scheduling is enabled.
+  virtual int ComputeNumberOfPieces(vtkImageData *outData, int extent[6]);
 
   // Description:
   // This is called by the superclass.
@@ -30,24 +30,19 @@
 #include "vtkThreadedStreamingPipeline.h"
 
 #include "vtkAlgorithm.h"
-#include "vtkAlgorithmOutput.h"
 #include "vtkComputingResources.h"
 #include "vtkExecutionScheduler.h"
 #include "vtkExecutive.h"
 #include "vtkExecutiveCollection.h"
 #include "vtkInformation.h"
-#include "vtkInformationVector.h"
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationExecutivePortVectorKey.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationVector.h"
-#include "vtkMultiThreader.h"
-#include "vtkMutexLock.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
-#include "vtkThreadMessager.h"
 #include "vtkTimerLog.h"
-#include <vtksys/hash_set.hxx>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkThreadedStreamingPipeline);
@@ -57,18 +52,6 @@ vtkInformationKeyRestrictedMacro(vtkThreadedStreamingPipeline,
                                  EXTRA_INFORMATION, ObjectBase,
                                  "vtkInformation");
 
-//----------------------------------------------------------------------------
-// Convinient definitions of vector/set of vtkExecutive
-class vtkExecutiveHasher
-{
-public:
-  size_t operator()(const vtkExecutive* e) const
-  {
-    return (size_t)e;
-  }
-};
-typedef vtksys::hash_set<vtkExecutive*, vtkExecutiveHasher> vtkExecutiveSet;
-
 //----------------------------------------------------------------------------
 vtkThreadedStreamingPipeline::vtkThreadedStreamingPipeline()
 {
@@ -76,7 +59,8 @@ vtkThreadedStreamingPipeline::vtkThreadedStreamingPipeline()
   this->LastDataRequestTimeFromSource = 0.0f;
   this->ForceDataRequest = NULL;
   this->Resources = NULL;
-  this->Scheduler = NULL;
+  this->InTask = 0;
+  this->ExecutingTask = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -90,10 +74,6 @@ vtkThreadedStreamingPipeline::~vtkThreadedStreamingPipeline()
     {
     this->Resources->Delete();
     }
-  if (this->Scheduler)
-    {
-    this->Scheduler->Delete();
-    }
 }
 
 //----------------------------------------------------------------------------
@@ -112,6 +92,12 @@ void vtkThreadedStreamingPipeline::SetMultiThreadedEnabled(bool enabled)
   MultiThreadedEnabled = enabled;
 }
 
+//----------------------------------------------------------------------------
+bool vtkThreadedStreamingPipeline::GetMultiThreadedEnabled()
+{
+  return MultiThreadedEnabled;
+}
+
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::SetAutoPropagatePush(bool enabled)
 {
@@ -119,9 +105,10 @@ void vtkThreadedStreamingPipeline::SetAutoPropagatePush(bool enabled)
 }
 
 //----------------------------------------------------------------------------
-static void
-CollectUpstreamModules(vtkExecutive *exec, vtkExecutiveSet &eSet)
+int vtkThreadedStreamingPipeline::CollectUpstreamTasks(
+  vtkExecutive *exec, vtkExecutiveCollection *tasks)
 {
+  int result = 1;
   for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
     {
     int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
@@ -132,14 +119,70 @@ CollectUpstreamModules(vtkExecutive *exec, vtkExecutiveSet &eSet)
       vtkExecutive* e;
       int producerPort;
       vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
-      if (eSet.find(e)!=eSet.end())
+      if (!e || tasks->IsItemPresent(e))
+        {
+        continue;
+        }
+      vtkThreadedStreamingPipeline* te =
+        vtkThreadedStreamingPipeline::SafeDownCast(e);
+      if (!te)
+        {
+        // Update it as a vtkCompositeDataPipeline would.
+        vtkNew<vtkInformation> request;
+        request->Set(REQUEST_DATA());
+        request->Set(FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+        request->Set(ALGORITHM_AFTER_FORWARD(), 1);
+        request->Set(FROM_OUTPUT_PORT(), producerPort);
+        if (!e->ProcessRequest(request.GetPointer(), e->GetInputInformation(),
+                               e->GetOutputInformation()))
+          {
+          result = 0;
+          }
+        continue;
+        }
+      // When a producer is up to date, so are the executives upstream.
+      if (!te->NeedToExecuteData(producerPort, te->GetInputInformation(),
+                                 te->GetOutputInformation()))
         {
         continue;
         }
-      eSet.insert(e);
-      CollectUpstreamModules(e, eSet);
+      tasks->AddItem(te);
+      if (!vtkThreadedStreamingPipeline::CollectUpstreamTasks(te, tasks))
+        {
+        result = 0;
+        }
       }
     }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedStreamingPipeline::ExecuteTask(int port)
+{
+  vtkNew<vtkInformation> request;
+  request->Set(REQUEST_DATA());
+  request->Set(FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+  request->Set(ALGORITHM_AFTER_FORWARD(), 1);
+  request->Set(FROM_OUTPUT_PORT(), port);
+  this->InTask = 1;
+  this->ExecutingTask = 1;
+  int result = this->ProcessRequest(request.GetPointer(),
+                                    this->GetInputInformation(),
+                                    this->GetOutputInformation());
+  this->InTask = 0;
+  this->ExecutingTask = 0;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedStreamingPipeline::NeedToReleaseInputData(
+  vtkInformation* inInfo)
+{
+  if (this->ExecutingTask)
+    {
+    return 0;
+    }
+  return this->Superclass::NeedToReleaseInputData(inInfo);
 }
 
 //----------------------------------------------------------------------------
@@ -166,21 +209,7 @@ void vtkThreadedStreamingPipeline::Pull(vtkExecutiveCollection *execs)
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Pull(vtkExecutiveCollection *execs, vtkInformation *info)
 {
-  vtkExecutiveSet eSet;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
-    {
-    eSet.insert(e);
-    CollectUpstreamModules(e, eSet);
-    }
-  vtkExecutiveCollection *collectedExecs = vtkExecutiveCollection::New();
-  for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
-    {
-    collectedExecs->AddItem(*ti);
-    }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(collectedExecs, info);
-  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilDone(collectedExecs);
-  collectedExecs->Delete();
+  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
 }
 
 //----------------------------------------------------------------------------
@@ -207,25 +236,22 @@ void vtkThreadedStreamingPipeline::Push(vtkExecutiveCollection *execs)
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Push(vtkExecutiveCollection *execs, vtkInformation *info)
 {
-  vtkExecutiveSet eSet;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
+  vtkCollectionSimpleIterator cookie;
+  execs->InitTraversal(cookie);
+  for (vtkExecutive *e = execs->GetNextExecutive(cookie); e != 0;
+       e = execs->GetNextExecutive(cookie))
     {
-    eSet.insert(e);
     e->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
     }
-  if (AutoPropagatePush)
+  if (AutoPropagatePush ||
+      (info && info->Has(vtkThreadedStreamingPipeline::AUTO_PROPAGATE())))
     {
-    if (info==NULL)
-      {
-      info = vtkInformation::New();
-      }
-    info->Set(vtkThreadedStreamingPipeline::AUTO_PROPAGATE(), 1);
+    vtkExecutionScheduler::GetGlobalScheduler()->SchedulePropagate(execs, info);
+    }
+  else
+    {
+    vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
     }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-  fprintf(stderr, "OK 2 %d\n", execs->GetNumberOfItems());
-  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilReleased(execs);
-  fprintf(stderr, "OK 3\n");
 }
 
 //----------------------------------------------------------------------------
@@ -235,20 +261,19 @@ void vtkThreadedStreamingPipeline::Pull()
 }
 
 //----------------------------------------------------------------------------
-void vtkThreadedStreamingPipeline::Pull(vtkInformation *info)
+void vtkThreadedStreamingPipeline::Pull(vtkInformation *vtkNotUsed(info))
 {
-  vtkExecutiveSet eSet;
-  CollectUpstreamModules(this, eSet);
-  vtkExecutiveCollection *execs = vtkExecutiveCollection::New();
-  for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
+  if (!this->UpdateInformation() ||
+      !this->PropagateUpdateExtent(this->GetNumberOfOutputPorts() > 0 ? 0 : -1))
     {
-    execs->AddItem(*ti);
+    return;
     }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-  vtkExecutionScheduler::GetGlobalScheduler()->ReleaseResources(this);
-  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilDone(execs);
-  vtkExecutionScheduler::GetGlobalScheduler()->ReacquireResources(this);
-  execs->Delete();
+  vtkExecutiveCollection *tasks = vtkExecutiveCollection::New();
+  if (vtkThreadedStreamingPipeline::CollectUpstreamTasks(this, tasks))
+    {
+    vtkExecutionScheduler::GetGlobalScheduler()->Execute(tasks);
+    }
+  tasks->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -260,47 +285,24 @@ void vtkThreadedStreamingPipeline::Push()
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Push(vtkInformation *info)
 {
-  vtkExecutiveSet eSet;
-  for(int i = 0; i < this->GetNumberOfOutputPorts(); ++i) {
+  vtkExecutiveCollection *execs = vtkExecutiveCollection::New();
+  for(int i = 0; i < this->GetNumberOfOutputPorts(); ++i)
+    {
     vtkInformation* outInfo = this->GetOutputInformation(i);
     int consumerCount = vtkExecutive::CONSUMERS()->Length(outInfo);
     vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(outInfo);
-    for (int j=0; j<consumerCount; j++)
+    for (int j = 0; j < consumerCount; j++)
       {
-      eSet.insert(e[j]);
-      e[j]->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
+      if (e[j] && !execs->IsItemPresent(e[j]))
+        {
+        execs->AddItem(e[j]);
+        }
       }
-  }
-  vtkExecutiveCollection *execs = vtkExecutiveCollection::New();
-  for (vtkExecutiveSet::iterator ti=eSet.begin(); ti!=eSet.end(); ti++)
-    {
-    execs->AddItem(*ti);
-    }
-  if (AutoPropagatePush)
-    {
-    vtkExecutionScheduler::GetGlobalScheduler()->SchedulePropagate(execs, info);
-    }
-  else
-    {
-    vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-    vtkExecutionScheduler::GetGlobalScheduler()->ReleaseResources(this);
-    vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilReleased(execs);
-    vtkExecutionScheduler::GetGlobalScheduler()->ReacquireResources(this);
     }
+  vtkThreadedStreamingPipeline::Push(execs, info);
   execs->Delete();
 }
 
-//----------------------------------------------------------------------------
-void vtkThreadedStreamingPipeline::ReleaseInputs()
-{
-  vtkThreadMessager *messager = vtkExecutionScheduler::
-    GetGlobalScheduler()->GetInputsReleasedMessager(this);
-  if (messager)
-    {
-    messager->SendWakeMessage();
-    }
-}
-
 //----------------------------------------------------------------------------
 int vtkThreadedStreamingPipeline
 ::ProcessRequest(vtkInformation* request,
@@ -388,16 +390,44 @@ vtkComputingResources *vtkThreadedStreamingPipeline::GetResources() {
 //----------------------------------------------------------------------------
 int vtkThreadedStreamingPipeline::ForwardUpstream(vtkInformation* request)
 {
-  if (MultiThreadedEnabled && request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  if (!request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()) ||
+      this->SharedInputInformation)
     {
-    this->Pull();
-    return 1;
+    return this->Superclass::ForwardUpstream(request);
     }
-  else
+
+  if (this->InTask)
+    {
+    // The scheduler updated the inputs before starting the task. An
+    // algorithm asking to execute again forwards its next requests.
+    this->InTask = 0;
+    return this->Algorithm->ModifyRequest(request, BeforeForward) &&
+      this->Algorithm->ModifyRequest(request, AfterForward);
+    }
+
+  if (!MultiThreadedEnabled)
     {
     return this->Superclass::ForwardUpstream(request);
     }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+    {
+    return 0;
+    }
+  vtkExecutiveCollection *tasks = vtkExecutiveCollection::New();
+  int result = vtkThreadedStreamingPipeline::CollectUpstreamTasks(this, tasks);
+  if (!vtkExecutionScheduler::GetGlobalScheduler()->Execute(tasks))
+    {
+    result = 0;
+    }
+  tasks->Delete();
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+    {
+    return 0;
+    }
+  return result;
 }
+
 //----------------------------------------------------------------------------
 int vtkThreadedStreamingPipeline::ForwardUpstream(int i, int j, vtkInformation* request)
 {
@@ -29,8 +29,14 @@
   -------------------------------------------------------------------------*/
 // .NAME vtkThreadedStreamingPipeline - Executive supporting multi-threads
 // .SECTION Description
-// vtkThreadeStreamingDemandDrivenPipeline is an executive that supports
-// updating input ports based on the number of threads available.
+// vtkThreadedStreamingPipeline is an executive that supports updating
+// input ports based on the number of threads available. When
+// multi-threaded updates are enabled, the executives upstream of an
+// updated vtkThreadedStreamingPipeline that need to execute are executed
+// by the global vtkExecutionScheduler as a graph of tasks, so that the
+// independent branches of the pipeline execute concurrently. The other
+// executives upstream are updated serially, as by a
+// vtkCompositeDataPipeline.
 
 // .SECTION See Also
 // vtkExecutionScheduler
@@ -43,7 +49,6 @@
 #include "vtkCompositeDataPipeline.h"
 
 class vtkComputingResources;
-class vtkExecutionScheduler;
 class vtkExecutiveCollection;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedStreamingPipeline : public vtkCompositeDataPipeline
@@ -76,6 +81,7 @@ public:
   // Description:
   // Enable/Disable Multi-Threaded updating mechanism
   static void SetMultiThreadedEnabled(bool enabled);
+  static bool GetMultiThreadedEnabled();
 
   // Description:
   // Enable/Disable automatic propagation of Push events
@@ -133,10 +139,6 @@ public:
   // Triggers downstream modules to update but not including itself
   void Push(vtkInformation *info);
 
-  // Description:
-  // Release all the locks for input ports living upstream
-  void ReleaseInputs();
-
   // Description:
   // Generalized interface for asking the executive to fulfill update
   // requests.
@@ -148,6 +150,27 @@ public:
   // Send a direct REQUEST_DATA (on all ports) to this executive
   int ForceUpdateData(int processingUnit, vtkInformation *info);
 
+  // Description:
+  // Execute the REQUEST_DATA pass of this executive for the given output
+  // port without updating its inputs, which must be up to date. This is
+  // how vtkExecutionScheduler executes a task.
+  int ExecuteTask(int port);
+
+  // Description:
+  // While executed as a task, the inputs are not released after the
+  // algorithm executes, since other tasks may still read them.
+  // vtkExecutionScheduler releases them after their last reader instead.
+  virtual int NeedToReleaseInputData(vtkInformation* inInfo);
+
+  // Description:
+  // Add to tasks the vtkThreadedStreamingPipeline executives upstream of
+  // exec that need to execute, and are not in tasks already. The other
+  // executives upstream of exec are updated immediately. The pipeline
+  // information and update extents must have been propagated. Return 0
+  // if an update failed.
+  static int CollectUpstreamTasks(vtkExecutive *exec,
+                                  vtkExecutiveCollection *tasks);
+
   // Description:
   // Update the LastDataRequestTimeFromSource using its upstream time
   void UpdateRequestDataTimeFromSource();
@@ -160,7 +183,6 @@ public:
   float                  LastDataRequestTimeFromSource;
   vtkInformation        *ForceDataRequest;
   vtkComputingResources *Resources;
-  vtkExecutionScheduler *Scheduler;
 
 protected:
   vtkThreadedStreamingPipeline();
@@ -169,6 +191,13 @@ protected:
   virtual int ForwardUpstream(vtkInformation* request);
   virtual int ForwardUpstream(int i, int j, vtkInformation* request);
 
+  // Set while executed as a task, the inputs are already up to date.
+  int InTask;
+
+  // Set for the whole execution of a task, including the iterations of
+  // an algorithm asking to execute again.
+  int ExecutingTask;
+
 private:
   vtkThreadedStreamingPipeline(const vtkThreadedStreamingPipeline&);  // Not implemented.
   void operator=(const vtkThreadedStreamingPipeline&);  // Not implemented.
@@ -16,6 +16,7 @@
 #include <vtkCellDataToPointData.h>
 #include <vtkDataArray.h>
 #include <vtkCellData.h>
+#include <vtkConstantArray.h>
 #include <vtkDataSet.h>
 #include <vtkDataSetTriangleFilter.h>
 #include <vtkPointData.h>
@@ -82,7 +83,31 @@ int TestCellDataToPointData (int, char*[])
     }
   variance /= nvalues;
 
-  bool const ok = fabs(mean) < 1e-4 && fabs(variance) < 1e-4;
+  bool ok = fabs(mean) < 1e-4 && fabs(variance) < 1e-4;
+
+  // an implicit cell array is averaged through the tuple API
+  vsp(UnstructuredGrid, grid);
+    grid->ShallowCopy(c2g->GetOutput());
+  vtkConstantArray<double>* const constant = vtkConstantArray<double>::New();
+    constant->SetName("Constant");
+    constant->SetNumberOfComponents(2);
+    constant->SetNumberOfTuples(grid->GetNumberOfCells());
+    constant->SetConstantValue(7.0);
+    grid->GetCellData()->AddArray(constant);
+    constant->Delete();
+
+  vsp(CellDataToPointData, cc2p);
+    cc2p->SetInputData(grid);
+    cc2p->Update();
+
+  vtkDataArray* const z =
+    cc2p->GetOutput()->GetPointData()->GetArray("Constant");
+  ok = ok && z && z->GetNumberOfTuples() == grid->GetNumberOfPoints();
+  for (vtkIdType i = 0; ok && i < z->GetNumberOfTuples(); ++i)
+    {
+    ok = z->GetComponent(i, 0) == 7.0 && z->GetComponent(i, 1) == 7.0;
+    }
+
   return !ok; // zero indicates test succeed
 }
 
@@ -0,0 +1,391 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContour3DLinearGrid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkContour3DLinearGrid.h"
+#include "vtkContourGrid.h"
+#include "vtkDoubleArray.h"
+#include "vtkEdgeMergePoints.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSimpleScalarTree.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// A res^3 lattice over [0,1]^3 whose slabs along x are made of voxels,
+// hexahedra, tetrahedra, wedges and pyramids in turn. The pyramids share
+// an extra point at the center of their hexahedron.
+void MakeGrid(int res, vtkUnstructuredGrid *ug)
+{
+  vtkNew<vtkPoints> points;
+  vtkIdType n = res + 1;
+  for (int k = 0; k <= res; k++)
+    {
+    for (int j = 0; j <= res; j++)
+      {
+      for (int i = 0; i <= res; i++)
+        {
+        points->InsertNextPoint(static_cast<double>(i) / res,
+                                static_cast<double>(j) / res,
+                                static_cast<double>(k) / res);
+        }
+      }
+    }
+  ug->Allocate(6 * res * res * res);
+  for (int k = 0; k < res; k++)
+    {
+    for (int j = 0; j < res; j++)
+      {
+      for (int i = 0; i < res; i++)
+        {
+        vtkIdType p[8];
+        p[0] = i + n * (j + n * k);
+        p[1] = p[0] + 1;
+        p[2] = p[0] + 1 + n;
+        p[3] = p[0] + n;
+        for (int v = 0; v < 4; v++)
+          {
+          p[v + 4] = p[v] + n * n;
+          }
+        switch (i % 5)
+          {
+          case 0:
+            {
+            vtkIdType voxel[8] = {p[0], p[1], p[3], p[2],
+                                  p[4], p[5], p[7], p[6]};
+            ug->InsertNextCell(VTK_VOXEL, 8, voxel);
+            }
+            break;
+          case 1:
+            ug->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+            break;
+          case 2:
+            {
+            // Six tetrahedra around the diagonal p0-p6.
+            static const int tets[6][4] = {
+              {0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6},
+              {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+            for (int t = 0; t < 6; t++)
+              {
+              vtkIdType tet[4];
+              for (int v = 0; v < 4; v++)
+                {
+                tet[v] = p[tets[t][v]];
+                }
+              ug->InsertNextCell(VTK_TETRA, 4, tet);
+              }
+            }
+            break;
+          case 3:
+            {
+            vtkIdType wedge1[6] = {p[0], p[1], p[2], p[4], p[5], p[6]};
+            vtkIdType wedge2[6] = {p[0], p[2], p[3], p[4], p[6], p[7]};
+            ug->InsertNextCell(VTK_WEDGE, 6, wedge1);
+            ug->InsertNextCell(VTK_WEDGE, 6, wedge2);
+            }
+            break;
+          default:
+            {
+            double x0[3], x6[3];
+            points->GetPoint(p[0], x0);
+            points->GetPoint(p[6], x6);
+            vtkIdType center = points->InsertNextPoint(
+              0.5 * (x0[0] + x6[0]), 0.5 * (x0[1] + x6[1]),
+              0.5 * (x0[2] + x6[2]));
+            static const int faces[6][4] = {
+              {0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+              {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+            for (int f = 0; f < 6; f++)
+              {
+              vtkIdType pyramid[5];
+              for (int v = 0; v < 4; v++)
+                {
+                pyramid[v] = p[faces[f][v]];
+                }
+              pyramid[4] = center;
+              ug->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+              }
+            }
+          }
+        }
+      }
+    }
+  ug->SetPoints(points.GetPointer());
+
+  // Smooth float scalars, an integer point array and the cell ids.
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Ints");
+  ints->SetNumberOfComponents(2);
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ptId++)
+    {
+    double x[3];
+    points->GetPoint(ptId, x);
+    scalars->InsertNextValue(static_cast<float>(
+      sin(5.0 * x[0]) * cos(4.0 * x[1]) + x[2] * x[2] +
+      vtkMath::Random(-0.01, 0.01)));
+    ints->InsertNextTuple2(1000.0 * x[0], -1000.0 * x[1] * x[2]);
+    }
+  ug->GetPointData()->SetScalars(scalars.GetPointer());
+  ug->GetPointData()->AddArray(ints.GetPointer());
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < ug->GetNumberOfCells(); cellId++)
+    {
+    cellIds->InsertNextValue(cellId);
+    }
+  ug->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+// Compare the output of vtkContour3DLinearGrid with the output of the
+// serial vtkContourGrid path: the same points (in any order) with the same
+// attributes, and the same triangles with the same cell data.
+bool Compare(vtkPolyData *output, vtkPolyData *expected, const char *label)
+{
+  vtkIdType numPts = output->GetNumberOfPoints();
+  vtkIdType numTris = output->GetNumberOfCells();
+  if (numPts != expected->GetNumberOfPoints() ||
+      numTris != expected->GetNumberOfCells() || numTris == 0)
+    {
+    cerr << label << ": " << numPts << " points and " << numTris
+         << " triangles instead of " << expected->GetNumberOfPoints()
+         << " and " << expected->GetNumberOfCells() << endl;
+    return false;
+    }
+
+  vtkNew<vtkPointLocator> locator;
+  locator->SetDataSet(expected);
+  locator->BuildLocator();
+  vtkDataArray *scalars = output->GetPointData()->GetArray("Scalars");
+  vtkDataArray *expectedScalars =
+    expected->GetPointData()->GetArray("Scalars");
+  vtkDataArray *ints = output->GetPointData()->GetArray("Ints");
+  vtkDataArray *expectedInts = expected->GetPointData()->GetArray("Ints");
+  if (!scalars || !ints || !output->GetPointData()->GetScalars())
+    {
+    cerr << label << ": missing point data" << endl;
+    return false;
+    }
+  std::vector<vtkIdType> map(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    map[ptId] = locator->FindClosestPoint(x);
+    expected->GetPoint(map[ptId], y);
+    if (vtkMath::Distance2BetweenPoints(x, y) > 1e-12 ||
+        fabs(scalars->GetTuple1(ptId) -
+             expectedScalars->GetTuple1(map[ptId])) > 1e-5 ||
+        fabs(ints->GetComponent(ptId, 0) -
+             expectedInts->GetComponent(map[ptId], 0)) > 1 ||
+        fabs(ints->GetComponent(ptId, 1) -
+             expectedInts->GetComponent(map[ptId], 1)) > 1)
+      {
+      cerr << label << ": point " << ptId << " differs" << endl;
+      return false;
+      }
+    }
+
+  // Triangles as sorted triples of expected point ids, with their cell id.
+  vtkDataArray *cellIds = output->GetCellData()->GetArray("CellIds");
+  vtkDataArray *expectedCellIds = expected->GetCellData()->GetArray("CellIds");
+  if (!cellIds)
+    {
+    cerr << label << ": missing cell data" << endl;
+    return false;
+    }
+  std::vector<std::vector<vtkIdType> > tris, expectedTris;
+  vtkIdType npts, *pts;
+  vtkCellArray *polys = output->GetPolys();
+  polys->InitTraversal();
+  for (vtkIdType triId = 0; polys->GetNextCell(npts, pts); triId++)
+    {
+    std::vector<vtkIdType> tri(4);
+    for (int i = 0; i < 3; i++)
+      {
+      tri[i] = map[pts[i]];
+      }
+    std::sort(tri.begin(), tri.begin() + 3);
+    tri[3] = static_cast<vtkIdType>(cellIds->GetTuple1(triId));
+    tris.push_back(tri);
+    }
+  polys = expected->GetPolys();
+  polys->InitTraversal();
+  for (vtkIdType triId = 0; polys->GetNextCell(npts, pts); triId++)
+    {
+    std::vector<vtkIdType> tri(pts, pts + 3);
+    std::sort(tri.begin(), tri.end());
+    tri.push_back(static_cast<vtkIdType>(expectedCellIds->GetTuple1(triId)));
+    expectedTris.push_back(tri);
+    }
+  std::sort(tris.begin(), tris.end());
+  std::sort(expectedTris.begin(), expectedTris.end());
+  if (tris != expectedTris)
+    {
+    cerr << label << ": the triangles differ" << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestContour3DLinearGrid(int, char*[])
+{
+  vtkMath::RandomSeed(1234);
+
+  vtkNew<vtkUnstructuredGrid> ug;
+  MakeGrid(20, ug.GetPointer());
+  if (!vtkContour3DLinearGrid::CanFullyProcessDataObject(ug.GetPointer()))
+    {
+    cerr << "The grid should be fully processed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The reference: vtkContourGrid does not delegate to
+  // vtkContour3DLinearGrid when the grid has a string array.
+  vtkNew<vtkUnstructuredGrid> ugWithStrings;
+  ugWithStrings->ShallowCopy(ug.GetPointer());
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Strings");
+  strings->SetNumberOfValues(ug->GetNumberOfCells());
+  ugWithStrings->GetCellData()->AddArray(strings.GetPointer());
+  if (vtkContour3DLinearGrid::CanFullyProcessDataObject(
+        ugWithStrings.GetPointer()))
+    {
+    cerr << "The grid with strings should not be fully processed" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkContourGrid> reference;
+  reference->SetInputData(ugWithStrings.GetPointer());
+  reference->GenerateValues(3, -0.5, 0.75);
+  reference->Update();
+
+  vtkNew<vtkContour3DLinearGrid> contour;
+  contour->SetInputData(ug.GetPointer());
+  contour->GenerateValues(3, -0.5, 0.75);
+  contour->Update();
+  if (!Compare(contour->GetOutput(), reference->GetOutput(), "Batches"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkSimpleScalarTree> tree;
+  tree->SetBranchingFactor(4);
+  tree->SetBatchSize(50);
+  contour->SetScalarTree(tree.GetPointer());
+  contour->UseScalarTreeOn();
+  contour->Update();
+  if (!Compare(contour->GetOutput(), reference->GetOutput(), "Scalar tree"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // vtkContourGrid delegates to vtkContour3DLinearGrid when it merges the
+  // points by edge.
+  vtkNew<vtkContourGrid> delegating;
+  vtkNew<vtkEdgeMergePoints> edgeLocator;
+  delegating->SetLocator(edgeLocator.GetPointer());
+  delegating->SetInputData(ug.GetPointer());
+  delegating->GenerateValues(3, -0.5, 0.75);
+  delegating->Update();
+  if (!Compare(delegating->GetOutput(), reference->GetOutput(), "Delegated"))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // By default, vtkContourGrid still merges coincident points: two
+  // tetrahedra sharing a face through duplicated points give 4 points.
+  static const double tetPts[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {1, 0, 1},
+    {2, 0, 0}, {1, 0, 0}, {1, 1, 0}, {1, 0, 1}
+  };
+  vtkNew<vtkUnstructuredGrid> tets;
+  vtkNew<vtkPoints> tetPoints;
+  vtkNew<vtkDoubleArray> tetScalars;
+  for (int i = 0; i < 8; i++)
+    {
+    tetPoints->InsertNextPoint(tetPts[i]);
+    tetScalars->InsertNextValue(tetPts[i][1]);
+    }
+  tets->SetPoints(tetPoints.GetPointer());
+  tets->GetPointData()->SetScalars(tetScalars.GetPointer());
+  vtkIdType tetIds[2][4] = {{0, 1, 2, 3}, {4, 5, 6, 7}};
+  tets->Allocate(2);
+  tets->InsertNextCell(VTK_TETRA, 4, tetIds[0]);
+  tets->InsertNextCell(VTK_TETRA, 4, tetIds[1]);
+  vtkNew<vtkContourGrid> merging;
+  merging->SetInputData(tets.GetPointer());
+  merging->SetValue(0, 0.5);
+  merging->Update();
+  if (merging->GetOutput()->GetNumberOfPoints() != 4 ||
+      merging->GetOutput()->GetNumberOfCells() != 2)
+    {
+    cerr << "Coincident points are not merged: "
+         << merging->GetOutput()->GetNumberOfPoints() << " points" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The scalar tree batches hold every cell whose range contains the
+  // value.
+  double value = 0.3;
+  tree->SetDataSet(ug.GetPointer());
+  tree->SetScalars(NULL);
+  tree->InitTraversal(value);
+  std::vector<vtkIdType> candidates;
+  for (vtkIdType batch = 0; batch < tree->GetNumberOfCellBatches(); batch++)
+    {
+    vtkIdType numCells;
+    const vtkIdType *cells = tree->GetCellBatch(batch, numCells);
+    candidates.insert(candidates.end(), cells, cells + numCells);
+    }
+  std::sort(candidates.begin(), candidates.end());
+  vtkDataArray *scalars = ug->GetPointData()->GetScalars();
+  vtkNew<vtkIdList> cellPts;
+  for (vtkIdType cellId = 0; cellId < ug->GetNumberOfCells(); cellId++)
+    {
+    ug->GetCellPoints(cellId, cellPts.GetPointer());
+    double range[2] = {VTK_DOUBLE_MAX, VTK_DOUBLE_MIN};
+    for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); i++)
+      {
+      double s = scalars->GetTuple1(cellPts->GetId(i));
+      range[0] = std::min(range[0], s);
+      range[1] = std::max(range[1], s);
+      }
+    if (range[0] <= value && value <= range[1] &&
+        !std::binary_search(candidates.begin(), candidates.end(), cellId))
+      {
+      cerr << "Cell " << cellId << " missing from the batches" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormals.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkPolygon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// A res x res grid of quads over a bumpy height field, with every third
+// quad reversed and an unused point at the end.
+void MakeSurface(int res, vtkPolyData *pd)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= res; j++)
+    {
+    for (int i = 0; i <= res; i++)
+      {
+      double x = static_cast<double>(i) / res;
+      double y = static_cast<double>(j) / res;
+      points->InsertNextPoint(x, y, 0.1*sin(7.0*x)*cos(5.0*y));
+      }
+    }
+  points->InsertNextPoint(2.0, 2.0, 2.0);
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < res; j++)
+    {
+    for (int i = 0; i < res; i++)
+      {
+      vtkIdType p = j*(res + 1) + i;
+      vtkIdType quad[4] = { p, p + 1, p + res + 2, p + res + 1 };
+      if ((i + j) % 3 == 0)
+        {
+        std::swap(quad[1], quad[3]);
+        }
+      polys->InsertNextCell(4, quad);
+      }
+    }
+  pd->SetPoints(points.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+}
+
+// A cube made of 6 quads sharing its 8 corners.
+void MakeCube(vtkPolyData *pd)
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 8; i++)
+    {
+    points->InsertNextPoint(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+    }
+  vtkIdType faces[6][4] =
+    {
+    { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 },
+    { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 }
+    };
+  vtkNew<vtkCellArray> polys;
+  for (int i = 0; i < 6; i++)
+    {
+    polys->InsertNextCell(4, faces[i]);
+    }
+  pd->SetPoints(points.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+}
+
+// Compute the point normals of the output the way the serial filter
+// accumulated them, polygon after polygon, and compare them exactly.
+int CheckPointNormals(vtkPolyData *output)
+{
+  vtkIdType numPts = output->GetNumberOfPoints();
+  std::vector<float> sums(3*numPts, 0.0f);
+  vtkIdType npts, *pts;
+  vtkCellArray *polys = output->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+    {
+    double n[3];
+    vtkPolygon::ComputeNormal(output->GetPoints(), npts, pts, n);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      for (int j = 0; j < 3; j++)
+        {
+        sums[3*pts[i]+j] = static_cast<float>(
+          static_cast<double>(sums[3*pts[i]+j]) +
+          static_cast<float>(n[j]));
+        }
+      }
+    }
+
+  vtkFloatArray *normals =
+    vtkFloatArray::SafeDownCast(output->GetPointData()->GetNormals());
+  if (!normals || normals->GetNumberOfTuples() != numPts)
+    {
+    cerr << "Missing point normals" << endl;
+    return 1;
+    }
+  double n[3] = { 0.0, 0.0, 0.0 };
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    double sum[3] = { sums[3*i], sums[3*i+1], sums[3*i+2] };
+    double length = vtkMath::Norm(sum);
+    if (length != 0.0)
+      {
+      for (int j = 0; j < 3; j++)
+        {
+        n[j] = sum[j] / length;
+        }
+      }
+    for (int j = 0; j < 3; j++)
+      {
+      if (normals->GetValue(3*i+j) != static_cast<float>(n[j]))
+        {
+        cerr << "Wrong normal for point " << i << endl;
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+}
+
+int TestPolyDataNormals(int, char *[])
+{
+  int rval = 0;
+
+  // Without splitting, the point normals are the averages of the normals
+  // of the consistently ordered polygons.
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(100, surface.GetPointer());
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(surface.GetPointer());
+  normals->SplittingOff();
+  normals->ComputeCellNormalsOn();
+  normals->Update();
+  vtkPolyData *output = normals->GetOutput();
+  if (output->GetNumberOfPoints() != surface->GetNumberOfPoints())
+    {
+    cerr << "Points were added without splitting" << endl;
+    rval = 1;
+    }
+  rval |= CheckPointNormals(output);
+  vtkDataArray *cellNormals = output->GetCellData()->GetNormals();
+  double side = (cellNormals ? cellNormals->GetComponent(0, 2) : 0.0);
+  for (vtkIdType i = 0; cellNormals && i < cellNormals->GetNumberOfTuples();
+       i++)
+    {
+    if (cellNormals->GetComponent(i, 2)*side <= 0.0)
+      {
+      cerr << "Inconsistent ordering of polygon " << i << endl;
+      rval = 1;
+      break;
+      }
+    }
+
+  // A feature angle smaller than the bumps splits the surface, but the
+  // point normals are still the averages of the polygons using the points.
+  normals->SplittingOn();
+  normals->SetFeatureAngle(1.0);
+  normals->Update();
+  if (output->GetNumberOfPoints() <= surface->GetNumberOfPoints())
+    {
+    cerr << "No point was split" << endl;
+    rval = 1;
+    }
+  rval |= CheckPointNormals(output);
+
+  // Each corner of a cube is split in three, one point per face.
+  vtkNew<vtkPolyData> cube;
+  MakeCube(cube.GetPointer());
+  normals->SetInputData(cube.GetPointer());
+  normals->SetFeatureAngle(30.0);
+  normals->Update();
+  if (output->GetNumberOfPoints() != 24)
+    {
+    cerr << "Expected 24 points, got " << output->GetNumberOfPoints() << endl;
+    rval = 1;
+    }
+  rval |= CheckPointNormals(output);
+
+  return rval;
+}
@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothPolyDataFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+
+#include <cmath>
+
+namespace
+{
+// A res x res grid of triangles over a noisy height field, with a vertex
+// cell on its center point. The points are numbered backwards if reversed.
+void MakeNoisyPlane(int res, int dataType, bool reversed, vtkPolyData *pd)
+{
+  vtkIdType numPts = (res + 1) * (res + 1);
+  vtkNew<vtkPoints> points;
+  points->SetDataType(dataType);
+  points->SetNumberOfPoints(numPts);
+  vtkMath::RandomSeed(1234);
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    double x[3] = { static_cast<double>(i % (res + 1)) / res,
+                    static_cast<double>(i / (res + 1)) / res,
+                    vtkMath::Random(-0.05, 0.05) };
+    points->SetPoint(reversed ? numPts - 1 - i : i, x);
+    }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < res; j++)
+    {
+    for (int i = 0; i < res; i++)
+      {
+      vtkIdType p = j*(res + 1) + i;
+      vtkIdType tri[2][3] =
+        {
+        { p, p + 1, p + res + 2 }, { p, p + res + 2, p + res + 1 }
+        };
+      for (int t = 0; t < 2; t++)
+        {
+        for (int k = 0; reversed && k < 3; k++)
+          {
+          tri[t][k] = numPts - 1 - tri[t][k];
+          }
+        polys->InsertNextCell(3, tri[t]);
+        }
+      }
+    }
+  vtkNew<vtkCellArray> verts;
+  vtkIdType center = (res / 2) * (res + 2);
+  if (reversed)
+    {
+    center = numPts - 1 - center;
+    }
+  verts->InsertNextCell(1, &center);
+  pd->SetPoints(points.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+  pd->SetVerts(verts.GetPointer());
+}
+
+double Roughness(vtkPolyData *pd)
+{
+  double sum = 0.0;
+  for (vtkIdType i = 0; i < pd->GetNumberOfPoints(); i++)
+    {
+    sum += fabs(pd->GetPoint(i)[2]);
+    }
+  return sum;
+}
+}
+
+int TestSmoothPolyDataFilter(int, char *[])
+{
+  int rval = 0;
+  const int res = 40;
+
+  vtkNew<vtkPolyData> plane;
+  MakeNoisyPlane(res, VTK_FLOAT, false, plane.GetPointer());
+  vtkNew<vtkSmoothPolyDataFilter> smooth;
+  smooth->SetInputData(plane.GetPointer());
+  smooth->SetNumberOfIterations(50);
+  smooth->SetRelaxationFactor(0.2);
+  smooth->BoundarySmoothingOff();
+  smooth->Update();
+  vtkPolyData *output = smooth->GetOutput();
+  if (output->GetNumberOfPoints() != plane->GetNumberOfPoints() ||
+      output->GetPoints()->GetDataType() != VTK_FLOAT)
+    {
+    cerr << "Wrong output points" << endl;
+    return 1;
+    }
+  if (Roughness(output) > 0.5 * Roughness(plane.GetPointer()))
+    {
+    cerr << "The noise was not smoothed" << endl;
+    rval = 1;
+    }
+
+  // The boundary and the vertex cell are fixed.
+  vtkIdType fixedIds[3] = { 0, res, (res / 2) * (res + 2) };
+  for (int i = 0; i < 3; i++)
+    {
+    double x[3], y[3];
+    plane->GetPoint(fixedIds[i], x);
+    output->GetPoint(fixedIds[i], y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << "Fixed point " << fixedIds[i] << " moved" << endl;
+      rval = 1;
+      }
+    }
+
+  // By default, the points are moved in place, and the output points are
+  // float.
+  vtkNew<vtkPolyData> doublePlane;
+  MakeNoisyPlane(res, VTK_DOUBLE, false, doublePlane.GetPointer());
+  smooth->SetInputData(doublePlane.GetPointer());
+  smooth->BoundarySmoothingOn();
+  smooth->Update();
+  if (output->GetPoints()->GetDataType() != VTK_FLOAT)
+    {
+    cerr << "The output points are not float" << endl;
+    return 1;
+    }
+  vtkNew<vtkPolyData> reversed;
+  MakeNoisyPlane(res, VTK_DOUBLE, true, reversed.GetPointer());
+  vtkNew<vtkSmoothPolyDataFilter> smooth2;
+  smooth2->SetInputData(reversed.GetPointer());
+  smooth2->SetNumberOfIterations(50);
+  smooth2->SetRelaxationFactor(0.2);
+  smooth2->Update();
+  vtkPolyData *output2 = smooth2->GetOutput();
+  bool sameSweep = true;
+  for (vtkIdType i = 0; sameSweep && i < output->GetNumberOfPoints(); i++)
+    {
+    double x[3], y[3];
+    output->GetPoint(i, x);
+    output2->GetPoint(output->GetNumberOfPoints() - 1 - i, y);
+    sameSweep = (x[0] == y[0] && x[1] == y[1] && x[2] == y[2]);
+    }
+  if (sameSweep)
+    {
+    cerr << "The in place sweep does not depend on the point order" << endl;
+    rval = 1;
+    }
+
+  // With Jacobi updates, each iteration moves the points from the previous
+  // ones, so renumbering the points does not change the result, and double
+  // points stay double.
+  smooth->JacobiUpdateOn();
+  smooth->Update();
+  smooth2->JacobiUpdateOn();
+  smooth2->Update();
+  if (Roughness(output) > 0.5 * Roughness(doublePlane.GetPointer()))
+    {
+    cerr << "The noise was not smoothed by Jacobi updates" << endl;
+    rval = 1;
+    }
+  if (output->GetPoints()->GetDataType() != VTK_DOUBLE ||
+      output2->GetPoints()->GetDataType() != VTK_DOUBLE)
+    {
+    cerr << "Double precision points were not kept" << endl;
+    return 1;
+    }
+  vtkIdType numPts = output->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    double x[3], y[3];
+    output->GetPoint(i, x);
+    output2->GetPoint(numPts - 1 - i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << "Renumbered point " << i << " differs" << endl;
+      rval = 1;
+      break;
+      }
+    }
+
+  return rval;
+}
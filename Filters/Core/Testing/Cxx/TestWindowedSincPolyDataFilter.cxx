@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestWindowedSincPolyDataFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <cmath>
+
+namespace
+{
+// A res x res grid of quads over a noisy height field.
+void MakeNoisyPlane(int res, int dataType, vtkPolyData *pd)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(dataType);
+  vtkMath::RandomSeed(5678);
+  for (int j = 0; j <= res; j++)
+    {
+    for (int i = 0; i <= res; i++)
+      {
+      points->InsertNextPoint(static_cast<double>(i) / res,
+                              static_cast<double>(j) / res,
+                              vtkMath::Random(-0.05, 0.05));
+      }
+    }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < res; j++)
+    {
+    for (int i = 0; i < res; i++)
+      {
+      vtkIdType p = j*(res + 1) + i;
+      vtkIdType quad[4] = { p, p + 1, p + res + 2, p + res + 1 };
+      polys->InsertNextCell(4, quad);
+      }
+    }
+  pd->SetPoints(points.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+}
+
+double Roughness(vtkPolyData *pd)
+{
+  double sum = 0.0;
+  for (vtkIdType i = 0; i < pd->GetNumberOfPoints(); i++)
+    {
+    sum += fabs(pd->GetPoint(i)[2]);
+    }
+  return sum;
+}
+}
+
+int TestWindowedSincPolyDataFilter(int, char *[])
+{
+  int rval = 0;
+
+  vtkNew<vtkPolyData> plane;
+  MakeNoisyPlane(40, VTK_FLOAT, plane.GetPointer());
+  vtkNew<vtkWindowedSincPolyDataFilter> smooth;
+  smooth->SetInputData(plane.GetPointer());
+  smooth->SetNumberOfIterations(20);
+  smooth->BoundarySmoothingOff();
+  smooth->Update();
+  vtkPolyData *output = smooth->GetOutput();
+  if (output->GetNumberOfPoints() != plane->GetNumberOfPoints() ||
+      output->GetPoints()->GetDataType() != VTK_FLOAT)
+    {
+    cerr << "Wrong output points" << endl;
+    return 1;
+    }
+  if (Roughness(output) > 0.5 * Roughness(plane.GetPointer()))
+    {
+    cerr << "The noise was not smoothed" << endl;
+    rval = 1;
+    }
+  double x[3], y[3];
+  plane->GetPoint(40, x);
+  output->GetPoint(40, y);
+  if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+    cerr << "A boundary point moved" << endl;
+    rval = 1;
+    }
+
+  // Double precision points stay double, and give the same result up to
+  // the float precision.
+  vtkNew<vtkPolyData> floatOutput;
+  floatOutput->DeepCopy(output);
+  vtkNew<vtkPolyData> doublePlane;
+  MakeNoisyPlane(40, VTK_DOUBLE, doublePlane.GetPointer());
+  smooth->SetInputData(doublePlane.GetPointer());
+  smooth->Update();
+  if (output->GetPoints()->GetDataType() != VTK_DOUBLE)
+    {
+    cerr << "Double precision points were not kept" << endl;
+    return 1;
+    }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++)
+    {
+    floatOutput->GetPoint(i, x);
+    output->GetPoint(i, y);
+    if (sqrt(vtkMath::Distance2BetweenPoints(x, y)) > 1e-5)
+      {
+      cerr << "Double precision smoothing differs at point " << i << endl;
+      rval = 1;
+      break;
+      }
+    }
+
+  // A polyline is smoothed without any polygon.
+  vtkNew<vtkPolyData> line;
+  vtkNew<vtkPoints> linePoints;
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(20);
+  for (int i = 0; i < 20; i++)
+    {
+    linePoints->InsertNextPoint(i, (i % 2) * 0.2, 0.0);
+    lines->InsertCellPoint(i);
+    }
+  line->SetPoints(linePoints.GetPointer());
+  line->SetLines(lines.GetPointer());
+  smooth->SetInputData(line.GetPointer());
+  smooth->SetEdgeAngle(90.0);
+  smooth->Update();
+  output->GetPoint(9, y);
+  if (output->GetNumberOfPoints() != 20 || fabs(y[1]) >= 0.2)
+    {
+    cerr << "The polyline was not smoothed" << endl;
+    rval = 1;
+    }
+
+  return rval;
+}
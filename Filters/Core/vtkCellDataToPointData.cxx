@@ -16,6 +16,7 @@
 
 #include "vtkCellData.h"
 #include "vtkCell.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -28,7 +29,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
-#include <functional>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellDataToPointData);
 
@@ -147,48 +148,121 @@ void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
 }
 
 //----------------------------------------------------------------------------
-// Helper template function that implement the major part of the algorighm
-// which will be expanded by the vtkTemplateMacro. The template function is
-// provided so that coverage test can cover this function.
+// Helper functor that implements the major part of the algorithm. It is
+// called with the typed range of the cell array, which is fixed-size for
+// scalars, vectors and tensors so that the loops over the components are
+// unrolled, and which stores its components interleaved or in separate
+// buffers. The point array has the type and the number of components of
+// the cell array, with interleaved components.
 namespace
 {
-  template <typename T>
-  void __spread (vtkUnstructuredGrid* const src, vtkUnsignedIntArray* const num,
-             vtkDataArray* const srcarray, vtkDataArray* const dstarray,
-             vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps)
+  struct Spread
   {
-    T const* const srcptr = static_cast<T const*>(srcarray->GetVoidPointer(0));
-    T      * const dstptr = static_cast<T      *>(dstarray->GetVoidPointer(0));
+    vtkUnstructuredGrid* Source;
+    vtkUnsignedIntArray* Num;
+    vtkDataArray* Destination;
+    vtkIdType NumberOfPoints;
 
-    // zero initialization
-    std::fill_n(dstptr, npoints*ncomps, T(0));
+    template <typename T, int N>
+    void operator()(vtkDataArrayTupleRange<T, N>& src)
+    {
+      this->Execute<T, N>(src);
+    }
 
-    // accumulate
-    T const* srcbeg = srcptr;
-    vtkNew<vtkIdList> pids;
-    for (vtkIdType cid = 0; cid < ncells; ++cid, srcbeg += ncomps)
+    template <typename T, int N>
+    void operator()(vtkSOADataArrayTupleRange<T, N>& src)
+    {
+      this->Execute<T, N>(src);
+    }
+
+    template <typename T, int N, class SourceRange>
+    void Execute(SourceRange const& src)
+    {
+      vtkDataArrayTupleRange<T, N> dst(
+        static_cast<T*>(this->Destination->GetVoidPointer(0)),
+        this->NumberOfPoints, src.GetNumberOfComponents());
+      int const ncomps = src.GetNumberOfComponents();
+
+      // zero initialization
+      std::fill(dst.GetValueBegin(), dst.GetValueEnd(), T(0));
+
+      // accumulate cell data to point data <==> point_data += cell_data
+      vtkIdType const ncells = this->Source->GetNumberOfCells();
+      vtkIdType npts, *pts;
+      for (vtkIdType cid = 0; cid < ncells; ++cid)
+        {
+        this->Source->GetCellPoints(cid, npts, pts);
+        for (vtkIdType i = 0; i < npts; ++i)
+          {
+          T* const dsttuple = dst.GetTuple(pts[i]);
+          for (int c = 0; c < ncomps; ++c)
+            {
+            dsttuple[c] += src(cid, c);
+            }
+          }
+        }
+
+      // average
+      unsigned int const* const num = this->Num->GetPointer(0);
+      for (vtkIdType pid = 0; pid < this->NumberOfPoints; ++pid)
+        {
+        // guard against divide by zero
+        if (unsigned int const denum = num[pid])
+          {
+          // divide point data by the number of cells using it <==>
+          // point_data /= denum
+          T const tdenum = static_cast<T>(denum);
+          T* const dsttuple = dst.GetTuple(pid);
+          for (int c = 0; c < ncomps; ++c)
+            {
+            dsttuple[c] /= tdenum;
+            }
+          }
+        }
+    }
+  };
+
+  // Same as Spread, through the tuple API, for the arrays that are neither
+  // interleaved nor vtkSOADataArrayTemplate, such as the implicit arrays.
+  void SpreadTuples(vtkUnstructuredGrid* const src,
+                    vtkUnsignedIntArray* const num,
+                    vtkDataArray* const srcarray, vtkDataArray* const dstarray,
+                    vtkIdType npoints)
+  {
+    int const ncomps = srcarray->GetNumberOfComponents();
+    std::vector<double> sums(npoints*ncomps, 0.0);
+    std::vector<double> tuple(ncomps);
+
+    // accumulate cell data to point data <==> point_data += cell_data
+    vtkIdType const ncells = src->GetNumberOfCells();
+    vtkIdType npts, *pts;
+    for (vtkIdType cid = 0; cid < ncells; ++cid)
       {
-      src->GetCellPoints(cid, pids.GetPointer());
-      for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
+      srcarray->GetTuple(cid, &tuple[0]);
+      src->GetCellPoints(cid, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
         {
-        T* const dstbeg = dstptr + pids->GetId(i)*ncomps;
-        // accumulate cell data to point data <==> point_data += cell_data
-        std::transform(srcbeg,srcbeg+ncomps,dstbeg,dstbeg,std::plus<T>());
+        double* const sum = &sums[pts[i]*ncomps];
+        for (int c = 0; c < ncomps; ++c)
+          {
+          sum[c] += tuple[c];
+          }
         }
       }
 
     // average
-    T* dstbeg = dstptr;
-    for (vtkIdType pid = 0; pid < npoints; ++pid, dstbeg += ncomps)
+    for (vtkIdType pid = 0; pid < npoints; ++pid)
       {
+      double* const sum = &sums[pid*ncomps];
       // guard against divide by zero
       if (unsigned int const denum = num->GetValue(pid))
         {
-        // divide point data by the number of cells using it <==>
-        // point_data /= denum
-        std::transform(dstbeg, dstbeg+ncomps, dstbeg,
-          std::bind2nd(std::divides<T>(), denum));
+        for (int c = 0; c < ncomps; ++c)
+          {
+          sum[c] /= denum;
+          }
         }
+      dstarray->SetTuple(pid, sum);
       }
   }
 }
@@ -288,11 +362,15 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     vtkDataArray* const dstarray = dstpointdata->GetArray(dstid);
     dstarray->SetNumberOfTuples(npoints);
 
-    vtkIdType const ncomps = srcarray->GetNumberOfComponents();
-    switch (srcarray->GetDataType())
+    Spread spread;
+    spread.Source = src;
+    spread.Num = num;
+    spread.Destination = dstarray;
+    spread.NumberOfPoints = npoints;
+    if (!vtkDataArrayRangeDispatch::Execute(srcarray, spread) &&
+        !vtkDataArrayRangeDispatch::ExecuteSOA(srcarray, spread))
       {
-      vtkTemplateMacro
-        (__spread<VTK_TT>(src,num,srcarray,dstarray,ncells,npoints,ncomps));
+      SpreadTuples(src, num, srcarray, dstarray, npoints);
       }
     }
 
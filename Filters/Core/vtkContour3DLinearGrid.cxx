@@ -0,0 +1,911 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkContour3DLinearGrid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkContour3DLinearGrid.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkContourValues.h"
+#include "vtkEdgeMergePoints.h"
+#include "vtkGarbageCollector.h"
+#include "vtkHexahedron.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkPyramid.h"
+#include "vtkSMPTools.h"
+#include "vtkSimpleScalarTree.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTetra.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkWedge.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkContour3DLinearGrid);
+vtkCxxSetObjectMacro(vtkContour3DLinearGrid,ScalarTree,vtkScalarTree);
+
+// Number of cells per batch when the scalar tree is not used.
+#define VTK_CONTOUR_3D_LINEAR_GRID_BATCH_SIZE 1000
+
+namespace
+{
+//----------------------------------------------------------------------------
+// The case tables of the supported cells. Voxels use the hexahedron tables
+// with their points reordered.
+struct vtkContour3DCellCases
+{
+  int NumberOfPoints;
+  const int *PointMap;
+  int *(*GetEdgeArray)(int);
+  int *(*GetTriangleCases)(int);
+
+  bool Set(int cellType)
+    {
+    static const int voxelMap[8] = {0, 1, 3, 2, 4, 5, 7, 6};
+    this->PointMap = NULL;
+    switch (cellType)
+      {
+      case VTK_TETRA:
+        this->NumberOfPoints = 4;
+        this->GetEdgeArray = vtkTetra::GetEdgeArray;
+        this->GetTriangleCases = vtkTetra::GetTriangleCases;
+        return true;
+      case VTK_VOXEL:
+        this->PointMap = voxelMap;
+        // fall through
+      case VTK_HEXAHEDRON:
+        this->NumberOfPoints = 8;
+        this->GetEdgeArray = vtkHexahedron::GetEdgeArray;
+        this->GetTriangleCases = vtkHexahedron::GetTriangleCases;
+        return true;
+      case VTK_WEDGE:
+        this->NumberOfPoints = 6;
+        this->GetEdgeArray = vtkWedge::GetEdgeArray;
+        this->GetTriangleCases = vtkWedge::GetTriangleCases;
+        return true;
+      case VTK_PYRAMID:
+        this->NumberOfPoints = 5;
+        this->GetEdgeArray = vtkPyramid::GetEdgeArray;
+        this->GetTriangleCases = vtkPyramid::GetTriangleCases;
+        return true;
+      default:
+        return false;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// A triangle vertex is identified by the mesh edge (V0 < V1) it lies on,
+// or by the mesh vertex V0 == V1 when it lies on that vertex.
+struct vtkContour3DEdge
+{
+  vtkIdType V0;
+  vtkIdType V1;
+
+  bool operator==(const vtkContour3DEdge &other) const
+    {
+    return this->V0 == other.V0 && this->V1 == other.V1;
+    }
+};
+
+// An output point, interpolated from V1 (t = 0) to V2 (t = 1).
+struct vtkContour3DPoint
+{
+  vtkIdType V1;
+  vtkIdType V2;
+  double T;
+};
+
+// The triangles generated by a batch of cells: three vertices and one
+// cell id per triangle.
+struct vtkContour3DBatch
+{
+  std::vector<vtkContour3DEdge> Edges;
+  std::vector<vtkIdType> CellIds;
+};
+
+//----------------------------------------------------------------------------
+// Generate the triangles of the batches of cells. The batches come from
+// the scalar tree, or are consecutive ranges of BatchSize cells.
+template <class TS>
+class vtkContour3DProcessBatches
+{
+public:
+  const vtkIdType *Connectivity;
+  const vtkIdType *Locations;
+  const unsigned char *Types;
+  const TS *Scalars;
+  int NumberOfComponents;
+  double Value;
+  vtkScalarTree *Tree;
+  vtkIdType NumberOfCells;
+  vtkContour3DBatch *Batches;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType batch = begin; batch < end; batch++)
+      {
+      vtkIdType numCells;
+      const vtkIdType *cellIds = NULL;
+      vtkIdType first = 0;
+      if (this->Tree)
+        {
+        cellIds = this->Tree->GetCellBatch(batch, numCells);
+        }
+      else
+        {
+        first = batch * VTK_CONTOUR_3D_LINEAR_GRID_BATCH_SIZE;
+        numCells = std::min(
+          static_cast<vtkIdType>(VTK_CONTOUR_3D_LINEAR_GRID_BATCH_SIZE),
+          this->NumberOfCells - first);
+        }
+      for (vtkIdType i = 0; i < numCells; i++)
+        {
+        this->ProcessCell(cellIds ? cellIds[i] : first + i,
+                          this->Batches[batch]);
+        }
+      }
+    }
+
+  void ProcessCell(vtkIdType cellId, vtkContour3DBatch &output) const
+    {
+    vtkContour3DCellCases cases;
+    if (!cases.Set(this->Types[cellId]))
+      {
+      return;
+      }
+    const vtkIdType *cellPts = this->Connectivity + this->Locations[cellId];
+    if (cellPts[0] != cases.NumberOfPoints)
+      {
+      return;
+      }
+    cellPts++;
+
+    vtkIdType pts[8];
+    double s[8];
+    int index = 0;
+    for (int i = 0; i < cases.NumberOfPoints; i++)
+      {
+      pts[i] = cellPts[cases.PointMap ? cases.PointMap[i] : i];
+      s[i] = static_cast<double>(
+        this->Scalars[pts[i] * this->NumberOfComponents]);
+      if (s[i] >= this->Value)
+        {
+        index |= 1 << i;
+        }
+      }
+
+    for (int *edge = cases.GetTriangleCases(index); edge[0] > -1; edge += 3)
+      {
+      vtkContour3DEdge tri[3];
+      for (int i = 0; i < 3; i++)
+        {
+        // Same interpolation direction as vtkCell::Contour(): from the
+        // smaller scalar to the larger one.
+        int *vert = cases.GetEdgeArray(edge[i]);
+        int v1 = vert[0], v2 = vert[1];
+        if (!(s[v2] - s[v1] > 0))
+          {
+          std::swap(v1, v2);
+          }
+        if (s[v2] == this->Value)
+          {
+          tri[i].V0 = tri[i].V1 = pts[v2];
+          }
+        else
+          {
+          tri[i].V0 = std::min(pts[v1], pts[v2]);
+          tri[i].V1 = std::max(pts[v1], pts[v2]);
+          }
+        }
+      if (!(tri[0] == tri[1]) && !(tri[0] == tri[2]) && !(tri[1] == tri[2]))
+        {
+        output.Edges.insert(output.Edges.end(), tri, tri + 3);
+        output.CellIds.push_back(cellId);
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Gather the triangles of the batches, in batch order: the edges to merge,
+// the cell ids, and the cell sizes of the connectivity.
+class vtkContour3DGatherBatches
+{
+public:
+  vtkContour3DBatch *Batches;
+  const vtkIdType *BatchOffsets; // first triangle of each batch
+  vtkIdType FirstTriangle; // of this contour value
+  vtkIdType *Edges;
+  vtkIdType *CellIds;
+  vtkIdType *Connectivity;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType batch = begin; batch < end; batch++)
+      {
+      vtkContour3DBatch &output = this->Batches[batch];
+      vtkIdType numTris = static_cast<vtkIdType>(output.CellIds.size());
+      for (vtkIdType i = 0; i < numTris; i++)
+        {
+        vtkIdType tri = this->BatchOffsets[batch] + i;
+        vtkIdType outTri = this->FirstTriangle + tri;
+        this->CellIds[outTri] = output.CellIds[i];
+        this->Connectivity[4*outTri] = 3;
+        for (int j = 0; j < 3; j++)
+          {
+          const vtkContour3DEdge &edge = output.Edges[3*i + j];
+          this->Edges[6*tri + 2*j] = edge.V0;
+          this->Edges[6*tri + 2*j + 1] = edge.V1;
+          }
+        }
+      // Release the batch memory as soon as possible.
+      std::vector<vtkContour3DEdge>().swap(output.Edges);
+      std::vector<vtkIdType>().swap(output.CellIds);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Connect the triangles to the merged points.
+class vtkContour3DAssignPoints
+{
+public:
+  const vtkIdType *PointMap; // distinct edge of each triangle vertex
+  vtkIdType FirstTriangle;
+  vtkIdType FirstPoint;
+  vtkIdType *Connectivity;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType tri = begin; tri < end; tri++)
+      {
+      vtkIdType *conn = this->Connectivity + 4*(this->FirstTriangle + tri) + 1;
+      for (int j = 0; j < 3; j++)
+        {
+        conn[j] = this->FirstPoint + this->PointMap[3*tri + j];
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Create the new points from the distinct edges, oriented from the smaller
+// scalar to the larger one, and compute their interpolation parameter.
+template <class TS>
+class vtkContour3DInterpolationParameters
+{
+public:
+  const TS *Scalars;
+  int NumberOfComponents;
+  double Value;
+  const vtkIdType *UniqueEdges;
+  vtkContour3DPoint *Points; // the first new point
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      vtkContour3DPoint &pt = this->Points[ptId];
+      pt.V1 = this->UniqueEdges[2*ptId];
+      pt.V2 = this->UniqueEdges[2*ptId + 1];
+      if (pt.V1 == pt.V2)
+        {
+        pt.T = 1.0;
+        continue;
+        }
+      double s1 = static_cast<double>(
+        this->Scalars[pt.V1 * this->NumberOfComponents]);
+      double s2 = static_cast<double>(
+        this->Scalars[pt.V2 * this->NumberOfComponents]);
+      if (!(s2 - s1 > 0))
+        {
+        std::swap(pt.V1, pt.V2);
+        std::swap(s1, s2);
+        }
+      pt.T = (this->Value - s1) / (s2 - s1);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Compute the coordinates of the output points.
+template <class TIn, class TOut>
+class vtkContour3DInterpolatePoints
+{
+public:
+  const TIn *InPoints;
+  TOut *OutPoints;
+  const vtkContour3DPoint *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      const vtkContour3DPoint &pt = this->Points[ptId];
+      const TIn *x1 = this->InPoints + 3*pt.V1;
+      const TIn *x2 = this->InPoints + 3*pt.V2;
+      TOut *x = this->OutPoints + 3*ptId;
+      for (int i = 0; i < 3; i++)
+        {
+        double c1 = static_cast<double>(x1[i]);
+        double c2 = static_cast<double>(x2[i]);
+        x[i] = static_cast<TOut>(c1 + pt.T * (c2 - c1));
+        }
+      }
+    }
+};
+
+template <class TIn, class TOut>
+void vtkContour3DInterpolatePointsExecute(const TIn *inPoints,
+                                          TOut *outPoints,
+                                          const vtkContour3DPoint *points,
+                                          vtkIdType numPts)
+{
+  vtkContour3DInterpolatePoints<TIn, TOut> interpolator;
+  interpolator.InPoints = inPoints;
+  interpolator.OutPoints = outPoints;
+  interpolator.Points = points;
+  vtkSMPTools::For(0, numPts, interpolator);
+}
+
+template <class TOut>
+void vtkContour3DInterpolatePointsExecute(vtkDataArray *inPoints,
+                                          TOut *outPoints,
+                                          const vtkContour3DPoint *points,
+                                          vtkIdType numPts)
+{
+  switch (inPoints->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkContour3DInterpolatePointsExecute(
+        static_cast<const VTK_TT*>(inPoints->GetVoidPointer(0)),
+        outPoints, points, numPts));
+    }
+}
+
+//----------------------------------------------------------------------------
+// Pairs of input and output arrays of point or cell data, accessed through
+// raw pointers so that tuples can be written concurrently.
+class vtkContour3DArrayPair
+{
+public:
+  virtual ~vtkContour3DArrayPair() {}
+  virtual void Interpolate(const vtkContour3DPoint &pt,
+                           vtkIdType outId) const = 0;
+  virtual void Copy(vtkIdType inId, vtkIdType outId) const = 0;
+};
+
+template <class T>
+class vtkContour3DArrayPairImpl : public vtkContour3DArrayPair
+{
+public:
+  const T *Input;
+  T *Output;
+  int NumberOfComponents;
+
+  vtkContour3DArrayPairImpl(const T *input, T *output, int numComp)
+    : Input(input), Output(output), NumberOfComponents(numComp) {}
+
+  // Same as vtkDataArray::InterpolateTuple() with two source tuples.
+  virtual void Interpolate(const vtkContour3DPoint &pt,
+                           vtkIdType outId) const
+    {
+    const T *in1 = this->Input + pt.V1 * this->NumberOfComponents;
+    const T *in2 = this->Input + pt.V2 * this->NumberOfComponents;
+    T *out = this->Output + outId * this->NumberOfComponents;
+    for (int i = 0; i < this->NumberOfComponents; i++)
+      {
+      double c = (1.0 - pt.T) * static_cast<double>(in1[i]) +
+        pt.T * static_cast<double>(in2[i]);
+      out[i] = static_cast<T>(c);
+      }
+    }
+
+  virtual void Copy(vtkIdType inId, vtkIdType outId) const
+    {
+    std::copy(this->Input + inId * this->NumberOfComponents,
+              this->Input + (inId + 1) * this->NumberOfComponents,
+              this->Output + outId * this->NumberOfComponents);
+    }
+};
+
+class vtkContour3DArrays
+{
+public:
+  std::vector<vtkContour3DArrayPair*> Pairs;
+
+  ~vtkContour3DArrays()
+    {
+    for (size_t i = 0; i < this->Pairs.size(); i++)
+      {
+      delete this->Pairs[i];
+      }
+    }
+
+  // Pair the arrays created by InterpolateAllocate() or CopyAllocate() in
+  // out with the arrays of in, by name, and size them to numTuples. The
+  // output arrays that cannot be paired are removed.
+  void Add(vtkDataSetAttributes *in, vtkDataSetAttributes *out,
+           vtkIdType numTuples)
+    {
+    for (int i = out->GetNumberOfArrays() - 1; i >= 0; i--)
+      {
+      vtkDataArray *outArray = out->GetArray(i);
+      const char *name = outArray ? outArray->GetName() : NULL;
+      vtkDataArray *inArray = name ? in->GetArray(name) : NULL;
+      vtkContour3DArrayPair *pair = NULL;
+      if (inArray && inArray->GetDataType() == outArray->GetDataType() &&
+          inArray->GetNumberOfComponents() ==
+          outArray->GetNumberOfComponents())
+        {
+        outArray->SetNumberOfTuples(numTuples);
+        switch (outArray->GetDataType())
+          {
+          vtkTemplateMacro(
+            pair = new vtkContour3DArrayPairImpl<VTK_TT>(
+              static_cast<const VTK_TT*>(inArray->GetVoidPointer(0)),
+              static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
+              outArray->GetNumberOfComponents()));
+          }
+        }
+      if (pair)
+        {
+        this->Pairs.push_back(pair);
+        }
+      else
+        {
+        out->RemoveArray(i);
+        }
+      }
+    }
+};
+
+class vtkContour3DInterpolateAttributes
+{
+public:
+  const vtkContour3DArrays *Arrays;
+  const vtkContour3DPoint *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    size_t numPairs = this->Arrays->Pairs.size();
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      for (size_t i = 0; i < numPairs; i++)
+        {
+        this->Arrays->Pairs[i]->Interpolate(this->Points[ptId], ptId);
+        }
+      }
+    }
+};
+
+class vtkContour3DCopyAttributes
+{
+public:
+  const vtkContour3DArrays *Arrays;
+  const vtkIdType *CellIds;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    size_t numPairs = this->Arrays->Pairs.size();
+    for (vtkIdType triId = begin; triId < end; triId++)
+      {
+      for (size_t i = 0; i < numPairs; i++)
+        {
+        this->Arrays->Pairs[i]->Copy(this->CellIds[triId], triId);
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Whether the array can be accessed through a raw pointer of its type.
+bool vtkContour3DIsSupportedArray(vtkAbstractArray *array)
+{
+  if (!vtkDataArray::SafeDownCast(array))
+    {
+    return false;
+    }
+  switch (array->GetDataType())
+    {
+    case VTK_DOUBLE:
+    case VTK_FLOAT:
+#if defined(VTK_TYPE_USE_LONG_LONG)
+    case VTK_LONG_LONG:
+    case VTK_UNSIGNED_LONG_LONG:
+#endif
+#if defined(VTK_TYPE_USE___INT64)
+    case VTK___INT64:
+    case VTK_UNSIGNED___INT64:
+#endif
+    case VTK_ID_TYPE:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+      return true;
+    default:
+      return false;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Extract the contour of one value: generate the triangles of the batches,
+// merge their vertices, and append the triangles and the new points.
+template <class TS>
+void vtkContour3DExtract(vtkUnstructuredGrid *input, const TS *scalars,
+                         int numComp, double value, vtkScalarTree *tree,
+                         std::vector<vtkIdType> &connectivity,
+                         std::vector<vtkIdType> &cellIds,
+                         std::vector<vtkContour3DPoint> &points)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numBatches;
+  if (tree)
+    {
+    tree->InitTraversal(value);
+    numBatches = tree->GetNumberOfCellBatches();
+    }
+  else
+    {
+    numBatches = (numCells + VTK_CONTOUR_3D_LINEAR_GRID_BATCH_SIZE - 1) /
+      VTK_CONTOUR_3D_LINEAR_GRID_BATCH_SIZE;
+    }
+  if (numBatches < 1)
+    {
+    return;
+    }
+
+  std::vector<vtkContour3DBatch> batches(numBatches);
+  vtkContour3DProcessBatches<TS> process;
+  process.Connectivity = input->GetCells()->GetPointer();
+  process.Locations = input->GetCellLocationsArray()->GetPointer(0);
+  process.Types = input->GetCellTypesArray()->GetPointer(0);
+  process.Scalars = scalars;
+  process.NumberOfComponents = numComp;
+  process.Value = value;
+  process.Tree = tree;
+  process.NumberOfCells = numCells;
+  process.Batches = &batches[0];
+  vtkSMPTools::For(0, numBatches, process);
+
+  std::vector<vtkIdType> batchOffsets(numBatches);
+  vtkIdType numTris = 0;
+  for (vtkIdType batch = 0; batch < numBatches; batch++)
+    {
+    batchOffsets[batch] = numTris;
+    numTris += static_cast<vtkIdType>(batches[batch].CellIds.size());
+    }
+  if (numTris == 0)
+    {
+    return;
+    }
+
+  vtkIdType firstTri = static_cast<vtkIdType>(cellIds.size());
+  cellIds.resize(firstTri + numTris);
+  connectivity.resize(4 * (firstTri + numTris));
+  std::vector<vtkIdType> edges(6 * numTris);
+  vtkContour3DGatherBatches gather;
+  gather.Batches = &batches[0];
+  gather.BatchOffsets = &batchOffsets[0];
+  gather.FirstTriangle = firstTri;
+  gather.Edges = &edges[0];
+  gather.CellIds = &cellIds[0];
+  gather.Connectivity = &connectivity[0];
+  vtkSMPTools::For(0, numBatches, gather);
+
+  // Merge the triangle vertices lying on the same edge.
+  std::vector<vtkIdType> pointMap(3 * numTris);
+  vtkNew<vtkIdTypeArray> uniqueEdges;
+  vtkIdType numNewPts = vtkEdgeMergePoints::MergeEdges(
+    3 * numTris, &edges[0], &pointMap[0], uniqueEdges.GetPointer());
+  std::vector<vtkIdType>().swap(edges);
+
+  vtkIdType firstPt = static_cast<vtkIdType>(points.size());
+  points.resize(firstPt + numNewPts);
+
+  vtkContour3DAssignPoints assign;
+  assign.PointMap = &pointMap[0];
+  assign.FirstTriangle = firstTri;
+  assign.FirstPoint = firstPt;
+  assign.Connectivity = &connectivity[0];
+  vtkSMPTools::For(0, numTris, assign);
+
+  vtkContour3DInterpolationParameters<TS> parameters;
+  parameters.Scalars = scalars;
+  parameters.NumberOfComponents = numComp;
+  parameters.Value = value;
+  parameters.UniqueEdges = uniqueEdges->GetPointer(0);
+  parameters.Points = &points[firstPt];
+  vtkSMPTools::For(0, numNewPts, parameters);
+}
+}
+
+//----------------------------------------------------------------------------
+// Construct object with a single contour value of 0.0.
+vtkContour3DLinearGrid::vtkContour3DLinearGrid()
+{
+  this->ContourValues = vtkContourValues::New();
+
+  this->ComputeNormals = 0;
+  this->ComputeScalars = 1;
+  this->UseScalarTree = 0;
+  this->ScalarTree = NULL;
+  this->OutputPointsPrecision = DEFAULT_PRECISION;
+
+  // by default process active point scalars
+  this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
+                               vtkDataSetAttributes::SCALARS);
+}
+
+//----------------------------------------------------------------------------
+vtkContour3DLinearGrid::~vtkContour3DLinearGrid()
+{
+  this->ContourValues->Delete();
+  this->SetScalarTree(NULL);
+}
+
+//----------------------------------------------------------------------------
+// Overload standard modified time function. If contour values are modified,
+// then this object is modified as well.
+unsigned long vtkContour3DLinearGrid::GetMTime()
+{
+  unsigned long mTime = this->Superclass::GetMTime();
+  unsigned long time = this->ContourValues->GetMTime();
+  return ( time > mTime ? time : mTime );
+}
+
+//----------------------------------------------------------------------------
+int vtkContour3DLinearGrid::CanFullyProcessDataObject(vtkDataObject *object)
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(object);
+  if ( !grid || !grid->GetPoints() || !grid->GetCellTypesArray() ||
+       (grid->GetPoints()->GetDataType() != VTK_FLOAT &&
+        grid->GetPoints()->GetDataType() != VTK_DOUBLE) )
+    {
+    return 0;
+    }
+
+  vtkUnsignedCharArray *types = grid->GetCellTypesArray();
+  vtkContour3DCellCases cases;
+  for (vtkIdType cellId = 0; cellId < types->GetNumberOfTuples(); cellId++)
+    {
+    if ( !cases.Set(types->GetValue(cellId)) )
+      {
+      return 0;
+      }
+    }
+
+  vtkDataSetAttributes *attributes[2] =
+    {grid->GetPointData(), grid->GetCellData()};
+  for (int i = 0; i < 2; i++)
+    {
+    for (int j = 0; j < attributes[i]->GetNumberOfArrays(); j++)
+      {
+      vtkAbstractArray *array = attributes[i]->GetAbstractArray(j);
+      if ( !vtkContour3DIsSupportedArray(array) || !array->GetName() )
+        {
+        return 0;
+        }
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkContour3DLinearGrid::RequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info objects
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkUnstructuredGrid *input = vtkUnstructuredGrid::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData *output = vtkPolyData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkDebugMacro(<< "Executing contour filter");
+
+  int numContours = this->ContourValues->GetNumberOfContours();
+  double *values = this->ContourValues->GetValues();
+  vtkDataArray *inScalars = this->GetInputArrayToProcess(0,inputVector);
+  vtkIdType numCells = input->GetNumberOfCells();
+  if ( !inScalars || numCells < 1 || numContours < 1 )
+    {
+    vtkDebugMacro(<<"No data to contour");
+    return 1;
+    }
+  if ( !vtkContour3DIsSupportedArray(inScalars) ||
+       inScalars->GetNumberOfTuples() != input->GetNumberOfPoints() )
+    {
+    vtkErrorMacro(<<"The scalars must be a numeric point data array");
+    return 1;
+    }
+
+  vtkScalarTree *tree = NULL;
+  if ( this->UseScalarTree )
+    {
+    if ( this->ScalarTree == NULL )
+      {
+      this->ScalarTree = vtkSimpleScalarTree::New();
+      }
+    this->ScalarTree->SetDataSet(input);
+    this->ScalarTree->SetScalars(inScalars);
+    tree = this->ScalarTree;
+    }
+
+  // Extract the triangles and the points of each contour value in turn.
+  std::vector<vtkIdType> connectivity;
+  std::vector<vtkIdType> cellIds;
+  std::vector<vtkContour3DPoint> points;
+  for (int i = 0; i < numContours && !this->GetAbortExecute(); i++)
+    {
+    switch (inScalars->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkContour3DExtract(
+          input, static_cast<const VTK_TT*>(inScalars->GetVoidPointer(0)),
+          inScalars->GetNumberOfComponents(), values[i], tree,
+          connectivity, cellIds, points));
+      }
+    this->UpdateProgress(0.8 * (i + 1) / numContours);
+    }
+
+  vtkIdType numPts = static_cast<vtkIdType>(points.size());
+  vtkIdType numTris = static_cast<vtkIdType>(cellIds.size());
+  if ( numTris == 0 )
+    {
+    return 1;
+    }
+
+  // Output points, in the precision requested.
+  vtkDataArray *inPoints = input->GetPoints()->GetData();
+  vtkNew<vtkPoints> newPts;
+  if ( this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION ||
+       (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION &&
+        inPoints->GetDataType() == VTK_FLOAT) )
+    {
+    newPts->SetDataType(VTK_FLOAT);
+    newPts->SetNumberOfPoints(numPts);
+    vtkContour3DInterpolatePointsExecute(
+      inPoints, static_cast<float*>(newPts->GetVoidPointer(0)),
+      &points[0], numPts);
+    }
+  else
+    {
+    newPts->SetDataType(VTK_DOUBLE);
+    newPts->SetNumberOfPoints(numPts);
+    vtkContour3DInterpolatePointsExecute(
+      inPoints, static_cast<double*>(newPts->GetVoidPointer(0)),
+      &points[0], numPts);
+    }
+  output->SetPoints(newPts.GetPointer());
+
+  // Interpolated point data.
+  vtkPointData *inPd = input->GetPointData(), *outPd = output->GetPointData();
+  if ( !this->ComputeScalars )
+    {
+    outPd->CopyScalarsOff();
+    }
+  outPd->InterpolateAllocate(inPd, numPts);
+  vtkContour3DArrays pointArrays;
+  pointArrays.Add(inPd, outPd, numPts);
+  vtkContour3DInterpolateAttributes interpolate;
+  interpolate.Arrays = &pointArrays;
+  interpolate.Points = &points[0];
+  vtkSMPTools::For(0, numPts, interpolate);
+  std::vector<vtkContour3DPoint>().swap(points);
+
+  // Triangles and their cell data.
+  vtkNew<vtkIdTypeArray> connectivityArray;
+  connectivityArray->SetNumberOfTuples(4 * numTris);
+  std::copy(connectivity.begin(), connectivity.end(),
+            connectivityArray->GetPointer(0));
+  std::vector<vtkIdType>().swap(connectivity);
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->SetCells(numTris, connectivityArray.GetPointer());
+  output->SetPolys(newPolys.GetPointer());
+
+  vtkCellData *inCd = input->GetCellData(), *outCd = output->GetCellData();
+  outCd->CopyAllocate(inCd, numTris);
+  vtkContour3DArrays cellArrays;
+  cellArrays.Add(inCd, outCd, numTris);
+  vtkContour3DCopyAttributes copy;
+  copy.Arrays = &cellArrays;
+  copy.CellIds = &cellIds[0];
+  vtkSMPTools::For(0, numTris, copy);
+
+  if ( this->ComputeNormals )
+    {
+    vtkNew<vtkPolyDataNormals> normalsFilter;
+    normalsFilter->SetOutputPointsPrecision(this->OutputPointsPrecision);
+    vtkNew<vtkPolyData> tempInput;
+    tempInput->ShallowCopy(output);
+    normalsFilter->SetInputData(tempInput.GetPointer());
+    normalsFilter->SetFeatureAngle(180.);
+    normalsFilter->SetUpdateExtent(
+      0,
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()),
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()),
+      outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()));
+    normalsFilter->Update();
+    output->ShallowCopy(normalsFilter->GetOutput());
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkContour3DLinearGrid::FillInputPortInformation(int, vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkContour3DLinearGrid::ReportReferences(vtkGarbageCollector* collector)
+{
+  this->Superclass::ReportReferences(collector);
+  // The scalar tree shares our input and is therefore involved in a
+  // reference loop.
+  vtkGarbageCollectorReport(collector, this->ScalarTree, "ScalarTree");
+}
+
+//----------------------------------------------------------------------------
+void vtkContour3DLinearGrid::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Compute Normals: "
+     << (this->ComputeNormals ? "On\n" : "Off\n");
+  os << indent << "Compute Scalars: "
+     << (this->ComputeScalars ? "On\n" : "Off\n");
+  os << indent << "Use Scalar Tree: "
+     << (this->UseScalarTree ? "On\n" : "Off\n");
+  if ( this->ScalarTree )
+    {
+    os << indent << "Scalar Tree: " << this->ScalarTree << "\n";
+    }
+  else
+    {
+    os << indent << "Scalar Tree: (none)\n";
+    }
+
+  this->ContourValues->PrintSelf(os,indent.GetNextIndent());
+
+  os << indent << "Precision of the output points: "
+     << this->OutputPointsPrecision << "\n";
+}
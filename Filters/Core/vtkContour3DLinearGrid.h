@@ -0,0 +1,199 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkContour3DLinearGrid.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkContour3DLinearGrid - multithreaded isosurfaces of unstructured grids of linear 3D cells
+// .SECTION Description
+// vtkContour3DLinearGrid generates isosurfaces from a vtkUnstructuredGrid
+// made of linear 3D cells (tetrahedra, hexahedra, voxels, wedges and
+// pyramids). Other cells are ignored; CanFullyProcessDataObject() tells
+// whether a dataset is fully handled by this filter. It uses the case
+// tables of the cells, as vtkContourGrid does, but runs in parallel with
+// vtkSMPTools. vtkContourGrid delegates to this filter when its locator is
+// a vtkEdgeMergePoints.
+//
+// For each contour value, the cells are processed in batches, in
+// parallel, and each batch generates its triangles independently. The
+// vertices of the triangles are identified by the mesh edge they lie on
+// (or by the mesh vertex, for vertices whose scalar equals the contour
+// value) rather than by their coordinates: coincident vertices are merged
+// with vtkEdgeMergePoints::MergeEdges(), which sorts these edge ids in
+// parallel, so no spatial locator, bounds or tolerance are needed.
+// Degenerate triangles are discarded, as vtkCell::Contour() does. The
+// output points, their interpolated point data, the triangles and their
+// cell data are then generated in parallel.
+// The output does not depend on the number of threads. Unlike
+// vtkMergePoints, coincident input points are not merged, so an input with
+// duplicated points yields duplicated output points.
+//
+// With UseScalarTree on, the batches come from a vtkScalarTree (a
+// vtkSimpleScalarTree by default) and only the cells of the tree leaves
+// whose scalar range contains the contour value are visited. This pays
+// off when several contours are extracted from the same data.
+//
+// .SECTION Caveats
+// The contour is computed on the first component of the scalars. Only
+// numeric (vtkDataArray) point and cell data are passed to the output.
+// Output points and triangles are ordered by contour value, then by cell.
+//
+// .SECTION See Also
+// vtkContourGrid vtkContourFilter vtkSimpleScalarTree vtkEdgeMergePoints
+// vtkSMPTools
+
+#ifndef __vtkContour3DLinearGrid_h
+#define __vtkContour3DLinearGrid_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPolyDataAlgorithm.h"
+
+#include "vtkContourValues.h" // Needed for inline methods
+
+class vtkScalarTree;
+
+class VTKFILTERSCORE_EXPORT vtkContour3DLinearGrid : public vtkPolyDataAlgorithm
+{
+public:
+  vtkTypeMacro(vtkContour3DLinearGrid,vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Construct object with a single contour value of 0.0.
+  static vtkContour3DLinearGrid *New();
+
+  // Description:
+  // Methods to set / get contour values.
+  void SetValue(int i, double value);
+  double GetValue(int i);
+  double *GetValues();
+  void GetValues(double *contourValues);
+  void SetNumberOfContours(int number);
+  int GetNumberOfContours();
+  void GenerateValues(int numContours, double range[2]);
+  void GenerateValues(int numContours, double rangeStart, double rangeEnd);
+
+  // Description:
+  // Modified GetMTime Because we delegate to vtkContourValues
+  unsigned long GetMTime();
+
+  // Description:
+  // Set/Get the computation of normals. As in vtkContourGrid, the normals
+  // are computed by vtkPolyDataNormals once the surface is extracted.
+  vtkSetMacro(ComputeNormals,int);
+  vtkGetMacro(ComputeNormals,int);
+  vtkBooleanMacro(ComputeNormals,int);
+
+  // Description:
+  // Set/Get the computation of scalars.
+  vtkSetMacro(ComputeScalars,int);
+  vtkGetMacro(ComputeScalars,int);
+  vtkBooleanMacro(ComputeScalars,int);
+
+  // Description:
+  // Enable the use of a scalar tree to select the cells to process.
+  vtkSetMacro(UseScalarTree,int);
+  vtkGetMacro(UseScalarTree,int);
+  vtkBooleanMacro(UseScalarTree,int);
+
+  // Description:
+  // Set / get the scalar tree used when UseScalarTree is on. By default,
+  // an instance of vtkSimpleScalarTree is created.
+  virtual void SetScalarTree(vtkScalarTree*);
+  vtkGetObjectMacro(ScalarTree,vtkScalarTree);
+
+  // Description:
+  // Set/get the desired precision for the output types. See the
+  // documentation for the vtkAlgorithm::DesiredOutputPrecision enum for an
+  // explanation of the available precision settings.
+  vtkSetClampMacro(OutputPointsPrecision,int,SINGLE_PRECISION,
+                   DEFAULT_PRECISION);
+  vtkGetMacro(OutputPointsPrecision,int);
+
+  // Description:
+  // Return 1 if the object is a vtkUnstructuredGrid made only of cells
+  // this filter processes, with float or double points and numeric point
+  // and cell data arrays, 0 otherwise.
+  static int CanFullyProcessDataObject(vtkDataObject *object);
+
+protected:
+  vtkContour3DLinearGrid();
+  ~vtkContour3DLinearGrid();
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+                          vtkInformationVector *);
+  virtual int FillInputPortInformation(int port, vtkInformation *info);
+  virtual void ReportReferences(vtkGarbageCollector*);
+
+  vtkContourValues *ContourValues;
+  int ComputeNormals;
+  int ComputeScalars;
+  int UseScalarTree;
+  vtkScalarTree *ScalarTree;
+  int OutputPointsPrecision;
+
+private:
+  vtkContour3DLinearGrid(const vtkContour3DLinearGrid&);  // Not implemented.
+  void operator=(const vtkContour3DLinearGrid&);  // Not implemented.
+};
+
+// Description:
+// Set a particular contour value at contour number i. The index i ranges
+// between 0<=i<NumberOfContours.
+inline void vtkContour3DLinearGrid::SetValue(int i, double value)
+{this->ContourValues->SetValue(i,value);}
+
+// Description:
+// Get the ith contour value.
+inline double vtkContour3DLinearGrid::GetValue(int i)
+{return this->ContourValues->GetValue(i);}
+
+// Description:
+// Get a pointer to an array of contour values. There will be
+// GetNumberOfContours() values in the list.
+inline double *vtkContour3DLinearGrid::GetValues()
+{return this->ContourValues->GetValues();}
+
+// Description:
+// Fill a supplied list with contour values. There will be
+// GetNumberOfContours() values in the list. Make sure you allocate
+// enough memory to hold the list.
+inline void vtkContour3DLinearGrid::GetValues(double *contourValues)
+{this->ContourValues->GetValues(contourValues);}
+
+// Description:
+// Set the number of contours to place into the list. You only really
+// need to use this method to reduce list size. The method SetValue()
+// will automatically increase list size as needed.
+inline void vtkContour3DLinearGrid::SetNumberOfContours(int number)
+{this->ContourValues->SetNumberOfContours(number);}
+
+// Description:
+// Get the number of contours in the list of contour values.
+inline int vtkContour3DLinearGrid::GetNumberOfContours()
+{return this->ContourValues->GetNumberOfContours();}
+
+// Description:
+// Generate numContours equally spaced contour values between specified
+// range. Contour values will include min/max range values.
+inline void vtkContour3DLinearGrid::GenerateValues(int numContours,
+                                                   double range[2])
+{this->ContourValues->GenerateValues(numContours, range);}
+
+// Description:
+// Generate numContours equally spaced contour values between specified
+// range. Contour values will include min/max range values.
+inline void vtkContour3DLinearGrid::GenerateValues(int numContours,
+                                                   double rangeStart,
+                                                   double rangeEnd)
+{this->ContourValues->GenerateValues(numContours, rangeStart, rangeEnd);}
+
+#endif
@@ -639,6 +639,73 @@ void vtkContourFilter::CreateDefaultLocator()
     }
 }
 
+vtkAlgorithm* vtkContourFilter::NewCopy()
+{
+  if (strcmp(this->GetClassName(), "vtkContourFilter") != 0)
+    {
+    return NULL;
+    }
+
+  // The locator and the scalar tree hold the state of an execution, the
+  // copy gets its own with the same parameters, or the filter executes
+  // serially when these parameters are not known.
+  vtkIncrementalPointLocator *locator = NULL;
+  if (this->Locator)
+    {
+    locator = vtkContourHelper::NewLocatorCopy(this->Locator);
+    if (!locator)
+      {
+      return NULL;
+      }
+    }
+  vtkSimpleScalarTree *scalarTree = NULL;
+  if (this->ScalarTree)
+    {
+    if (strcmp(this->ScalarTree->GetClassName(), "vtkSimpleScalarTree") != 0)
+      {
+      if (locator)
+        {
+        locator->Delete();
+        }
+      return NULL;
+      }
+    vtkSimpleScalarTree *source =
+      static_cast<vtkSimpleScalarTree*>(this->ScalarTree);
+    scalarTree = vtkSimpleScalarTree::New();
+    scalarTree->SetBranchingFactor(source->GetBranchingFactor());
+    scalarTree->SetMaxLevel(source->GetMaxLevel());
+    scalarTree->SetBatchSize(source->GetBatchSize());
+    }
+
+  vtkContourFilter *copy = vtkContourFilter::New();
+  int numContours = this->ContourValues->GetNumberOfContours();
+  copy->ContourValues->SetNumberOfContours(numContours);
+  for (int i = 0; i < numContours; i++)
+    {
+    copy->ContourValues->SetValue(i, this->ContourValues->GetValue(i));
+    }
+  copy->ComputeNormals = this->ComputeNormals;
+  copy->ComputeGradients = this->ComputeGradients;
+  copy->ComputeScalars = this->ComputeScalars;
+  copy->UseScalarTree = this->UseScalarTree;
+  copy->OutputPointsPrecision = this->OutputPointsPrecision;
+  copy->GenerateTriangles = this->GenerateTriangles;
+  copy->SetArrayComponent(this->GetArrayComponent());
+  copy->CopyInputArraysToProcess(this);
+
+  if (locator)
+    {
+    copy->SetLocator(locator);
+    locator->Delete();
+    }
+  if (scalarTree)
+    {
+    copy->SetScalarTree(scalarTree);
+    scalarTree->Delete();
+    }
+  return copy;
+}
+
 void vtkContourFilter::SetArrayComponent( int comp )
 {
   this->SynchronizedTemplates2D->SetArrayComponent( comp );
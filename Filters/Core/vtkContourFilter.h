@@ -147,6 +147,15 @@ public:
   vtkGetMacro(GenerateTriangles,int);
   vtkBooleanMacro(GenerateTriangles,int);
 
+  // Description:
+  // Create a copy of this filter with the same contour values and
+  // parameters, and its own locator and scalar tree with the same
+  // parameters, so that the copy can execute concurrently with this filter.
+  // Returns NULL for subclasses, whose additional parameters are not
+  // copied, and when the locator is not a vtkPointLocator, vtkMergePoints
+  // or vtkEdgeMergePoints or the scalar tree is not a vtkSimpleScalarTree.
+  virtual vtkAlgorithm* NewCopy();
+
   // Description:
   // see vtkAlgorithm for details
   virtual int ProcessRequest(vtkInformation*,
@@ -34,6 +34,7 @@
 #include "vtkPointLocator.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkContourHelper.h"
+#include "vtkContour3DLinearGrid.h"
 #include <math.h>
 
 vtkStandardNewMacro(vtkContourGrid);
@@ -366,6 +367,45 @@ int vtkContourGrid::RequestData(
 
   vtkDebugMacro(<< "Executing contour filter");
 
+  // Grids of linear 3D cells are contoured in parallel when the points are
+  // merged by edge, as vtkContour3DLinearGrid does. The other locators also
+  // merge coincident input points, so they keep the serial path.
+  if ( this->GenerateTriangles &&
+       this->Locator && this->Locator->IsA("vtkEdgeMergePoints") &&
+       vtkContour3DLinearGrid::CanFullyProcessDataObject(input) )
+    {
+    vtkNew<vtkContour3DLinearGrid> contour;
+    for (int i = 0; i < numContours; i++)
+      {
+      contour->SetValue(i, values[i]);
+      }
+    contour->SetComputeNormals(this->ComputeNormals);
+    contour->SetComputeScalars(computeScalars);
+    contour->SetOutputPointsPrecision(this->OutputPointsPrecision);
+    contour->SetUseScalarTree(useScalarTree);
+    if ( useScalarTree )
+      {
+      if ( scalarTree == NULL )
+        {
+        scalarTree = vtkSimpleScalarTree::New();
+        }
+      contour->SetScalarTree(scalarTree);
+      }
+    contour->SetInputArrayToProcess(0, this->GetInputArrayInformation(0));
+    vtkNew<vtkUnstructuredGrid> tempInput;
+    tempInput->ShallowCopy(input);
+    contour->SetInputData(tempInput.GetPointer());
+    contour->SetUpdateExtent(
+      0,
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()),
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()),
+      outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()));
+    contour->Update();
+    output->ShallowCopy(contour->GetOutput());
+    return 1;
+    }
+
   if ( this->Locator == NULL )
     {
     this->CreateDefaultLocator();
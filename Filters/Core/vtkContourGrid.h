@@ -117,6 +117,10 @@ public:
   // Description:
   // Set / get a spatial locator for merging points. By default,
   // an instance of vtkMergePoints is used.
+  // vtkEdgeMergePoints merges the points by the input edge they lie on
+  // instead of by their coordinates; grids of linear 3D cells are then
+  // contoured in parallel by vtkContour3DLinearGrid when GenerateTriangles
+  // is on.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -22,6 +22,9 @@
 #include "vtkIdList.h"
 #include "vtkCell.h"
 #include "vtkDataArray.h"
+#include "vtkPointLocator.h"
+
+#include <string.h>
 
 vtkContourHelper::vtkContourHelper(vtkIncrementalPointLocator *locator,
                                    vtkCellArray *verts,
@@ -104,3 +107,24 @@ void vtkContourHelper::Contour(vtkCell* cell, double value, vtkDataArray *cellSc
       }
     }
 }
+
+vtkIncrementalPointLocator* vtkContourHelper::NewLocatorCopy(
+  vtkIncrementalPointLocator *locator)
+{
+  // These classes have no parameters other than those of vtkPointLocator.
+  const char *name = locator->GetClassName();
+  if (strcmp(name, "vtkPointLocator") != 0 &&
+      strcmp(name, "vtkMergePoints") != 0 &&
+      strcmp(name, "vtkEdgeMergePoints") != 0)
+    {
+    return NULL;
+    }
+  vtkPointLocator *source = static_cast<vtkPointLocator*>(locator);
+  vtkPointLocator *copy = static_cast<vtkPointLocator*>(source->NewInstance());
+  copy->SetTolerance(source->GetTolerance());
+  copy->SetAutomatic(source->GetAutomatic());
+  copy->SetMaxLevel(source->GetMaxLevel());
+  copy->SetDivisions(source->GetDivisions());
+  copy->SetNumberOfPointsPerBucket(source->GetNumberOfPointsPerBucket());
+  return copy;
+}
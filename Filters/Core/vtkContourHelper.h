@@ -49,6 +49,13 @@ public:
   ~vtkContourHelper();
   void Contour(vtkCell* cell, double value, vtkDataArray *cellScalars, vtkIdType cellId);
 
+  // Description:
+  // Return a new locator of the same class and with the same parameters as
+  // the given one, for a copy of a filter that executes concurrently, or
+  // NULL when the parameters of its class are not known.
+  static vtkIncrementalPointLocator* NewLocatorCopy(
+    vtkIncrementalPointLocator *locator);
+
  private:
   vtkIncrementalPointLocator* Locator;
   vtkCellArray* Verts;
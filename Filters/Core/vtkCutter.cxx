@@ -993,6 +993,75 @@ void vtkCutter::CreateDefaultLocator()
     }
 }
 
+//----------------------------------------------------------------------------
+// Whether an implicit function keeps no state while it is evaluated, so
+// that it can be evaluated from several threads at once.  Subclasses of
+// the functions listed may add state, and so do transforms, which update
+// themselves when used.
+static bool vtkCutterIsStatelessFunction(vtkImplicitFunction *function)
+{
+  static const char *classNames[] = {
+    "vtkPlane", "vtkSphere", "vtkBox", "vtkCylinder", "vtkQuadric", NULL
+  };
+  if (!function || function->GetTransform())
+    {
+    return false;
+    }
+  for (int i = 0; classNames[i] != NULL; i++)
+    {
+    if (strcmp(function->GetClassName(), classNames[i]) == 0)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+vtkAlgorithm* vtkCutter::NewCopy()
+{
+  // The copies share the cut function, which they evaluate concurrently.
+  if (strcmp(this->GetClassName(), "vtkCutter") != 0 ||
+      !vtkCutterIsStatelessFunction(this->CutFunction))
+    {
+    return NULL;
+    }
+
+  // The locator holds the state of an execution, the copy gets its own
+  // with the same parameters, or the filter executes serially when these
+  // parameters are not known.
+  vtkIncrementalPointLocator *locator = NULL;
+  if (this->Locator)
+    {
+    locator = vtkContourHelper::NewLocatorCopy(this->Locator);
+    if (!locator)
+      {
+      return NULL;
+      }
+    }
+
+  vtkCutter *copy = vtkCutter::New();
+  int numContours = this->ContourValues->GetNumberOfContours();
+  copy->ContourValues->SetNumberOfContours(numContours);
+  for (int i = 0; i < numContours; i++)
+    {
+    copy->ContourValues->SetValue(i, this->ContourValues->GetValue(i));
+    }
+  copy->SetCutFunction(this->CutFunction);
+  copy->SortBy = this->SortBy;
+  copy->GenerateCutScalars = this->GenerateCutScalars;
+  copy->GenerateTriangles = this->GenerateTriangles;
+  copy->OutputPointsPrecision = this->OutputPointsPrecision;
+  copy->CopyInputArraysToProcess(this);
+
+  if (locator)
+    {
+    copy->SetLocator(locator);
+    locator->Delete();
+    }
+  return copy;
+}
+
 //----------------------------------------------------------------------------
 int vtkCutter::RequestUpdateExtent(
   vtkInformation *,
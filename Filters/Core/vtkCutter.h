@@ -147,6 +147,8 @@ public:
   // Description:
   // Specify a spatial locator for merging points. By default,
   // an instance of vtkMergePoints is used.
+  // vtkEdgeMergePoints merges the points by the input edge they lie on
+  // instead of by their coordinates.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -177,6 +179,17 @@ public:
   // locator is used to merge coincident points.
   void CreateDefaultLocator();
 
+  // Description:
+  // Create a copy of this filter with the same contour values, cut
+  // function and parameters, and its own locator with the same parameters,
+  // so that the copy can execute concurrently with this filter. The cut
+  // function is shared, so NULL is returned unless it is a vtkPlane,
+  // vtkSphere, vtkBox, vtkCylinder or vtkQuadric without a transform, which
+  // can be evaluated concurrently. NULL is also returned for subclasses,
+  // whose additional parameters are not copied, and when the locator is not
+  // a vtkPointLocator, vtkMergePoints or vtkEdgeMergePoints.
+  virtual vtkAlgorithm* NewCopy();
+
   // Description:
   // Normally I would put this in a different class, but since
   // This is a temporary fix until we convert this class and contour filter
@@ -15,6 +15,7 @@
 #include "vtkElevationFilter.h"
 
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
@@ -22,10 +23,62 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSmartPointer.h"
 
 vtkStandardNewMacro(vtkElevationFilter);
 
+namespace
+{
+// Computes the elevation scalars of the points [Begin, End).
+struct vtkElevationWorker
+{
+  double LowPoint[3];
+  double DiffVector[3];
+  double Length2;
+  double ScalarRange[2];
+  float *Scalars;
+  vtkIdType Begin;
+  vtkIdType End;
+
+  // Project a point into the 1D system and map it into the scalar range.
+  float Elevation(double x, double y, double z) const
+    {
+    double v[3] = { x - this->LowPoint[0],
+                    y - this->LowPoint[1],
+                    z - this->LowPoint[2] };
+    double s = vtkMath::Dot(v, this->DiffVector) / this->Length2;
+    s = (s < 0.0 ? 0.0 : s > 1.0 ? 1.0 : s);
+    return static_cast<float>(this->ScalarRange[0] +
+      s*(this->ScalarRange[1] - this->ScalarRange[0]));
+    }
+
+  // Points with interleaved or separate components.
+  template <class Range>
+  void Execute(const Range& points)
+    {
+    for (vtkIdType i = this->Begin; i < this->End; ++i)
+      {
+      this->Scalars[i] =
+        this->Elevation(points(i, 0), points(i, 1), points(i, 2));
+      }
+    }
+
+  template <class T, int N>
+  void operator()(vtkDataArrayTupleRange<T, N>& points)
+    {
+    this->Execute(points);
+    }
+
+  template <class T, int N>
+  void operator()(vtkSOADataArrayTupleRange<T, N>& points)
+    {
+    this->Execute(points);
+    }
+};
+}
+
 //----------------------------------------------------------------------------
 vtkElevationFilter::vtkElevationFilter()
 {
@@ -105,29 +158,42 @@ int vtkElevationFilter::RequestData(vtkInformation*,
   double numPtsInv = 1.0/numPts;
   int abort = 0;
 
-  // Compute parametric coordinate and map into scalar range.
-  double diffScalar = this->ScalarRange[1] - this->ScalarRange[0];
+  // Compute parametric coordinate and map into scalar range. The points
+  // of point sets are read with their native type and layout, the others
+  // through vtkDataSet::GetPoint().
+  vtkElevationWorker worker;
+  for(int i=0; i < 3; ++i)
+    {
+    worker.LowPoint[i] = this->LowPoint[i];
+    worker.DiffVector[i] = diffVector[i];
+    }
+  worker.Length2 = length2;
+  worker.ScalarRange[0] = this->ScalarRange[0];
+  worker.ScalarRange[1] = this->ScalarRange[1];
+  worker.Scalars = newScalars->GetPointer(0);
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+  vtkDataArray* points = (pointSet && pointSet->GetPoints() ?
+                          pointSet->GetPoints()->GetData() : NULL);
   vtkDebugMacro("Generating elevation scalars!");
-  for(vtkIdType i=0; i < numPts && !abort; ++i)
+  for(vtkIdType begin=0; begin < numPts && !abort; begin += tenth)
     {
     // Periodically update progress and check for an abort request.
-    if(i % tenth == 0)
+    this->UpdateProgress((begin+1)*numPtsInv);
+    abort = this->GetAbortExecute();
+
+    worker.Begin = begin;
+    worker.End = (begin + tenth < numPts ? begin + tenth : numPts);
+    if(!points ||
+       (!vtkDataArrayRangeDispatch::ExecuteFixed<3>(points, worker) &&
+        !vtkDataArrayRangeDispatch::ExecuteFixedSOA<3>(points, worker)))
       {
-      this->UpdateProgress((i+1)*numPtsInv);
-      abort = this->GetAbortExecute();
+      for(vtkIdType i=worker.Begin; i < worker.End; ++i)
+        {
+        double x[3];
+        input->GetPoint(i, x);
+        worker.Scalars[i] = worker.Elevation(x[0], x[1], x[2]);
+        }
       }
-
-    // Project this input point into the 1D system.
-    double x[3];
-    input->GetPoint(i, x);
-    double v[3] = { x[0] - this->LowPoint[0],
-                    x[1] - this->LowPoint[1],
-                    x[2] - this->LowPoint[2] };
-    double s = vtkMath::Dot(v, diffVector) / length2;
-    s = (s < 0.0 ? 0.0 : s > 1.0 ? 1.0 : s);
-
-    // Store the resulting scalar value.
-    newScalars->SetValue(i, this->ScalarRange[0] + s*diffScalar);
     }
 
   // Copy all the input geometry and data to the output.
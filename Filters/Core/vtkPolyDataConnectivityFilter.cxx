@@ -26,6 +26,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
 
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
 
@@ -54,6 +55,9 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
 
   this->MarkVisitedPointIds = 0;
   this->VisitedPointIds = vtkIdList::New();
+
+  this->UseStaticCellLinks = 0;
+  this->StaticLinks = NULL;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -86,8 +90,9 @@ int vtkPolyDataConnectivityFilter::RequestData(
   vtkIdType numPts, numCells;
   vtkPoints *inPts;
   vtkPoints *newPts;
-  vtkIdType *cells, *pts, npts, id, n;
-  unsigned short ncells;
+  vtkIdType *pts, npts, id, n;
+  const vtkIdType *cells;
+  vtkIdType ncells;
   vtkIdType maxCellsInRegion;
   vtkIdType largestRegionId = 0;
   vtkPointData *pd=input->GetPointData(), *outputPD=output->GetPointData();
@@ -133,7 +138,15 @@ int vtkPolyDataConnectivityFilter::RequestData(
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if ( this->UseStaticCellLinks )
+    {
+    this->StaticLinks = vtkStaticCellLinks::New();
+    this->StaticLinks->BuildLinks(this->Mesh);
+    }
+  else
+    {
+    this->Mesh->BuildLinks();
+    }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -218,7 +231,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
         pt = this->Seeds->GetId(i);
         if ( pt >= 0 )
           {
-          this->Mesh->GetPointCells(pt,ncells,cells);
+          this->GetPointCells(pt,ncells,cells);
           for (j=0; j < ncells; j++)
             {
             this->Wave->InsertNextId(cells[j]);
@@ -251,7 +264,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
           minDist2 = dist2;
           }
         }
-      this->Mesh->GetPointCells(minId,ncells,cells);
+      this->GetPointCells(minId,ncells,cells);
       for (j=0; j < ncells; j++)
         {
         this->Wave->InsertNextId(cells[j]);
@@ -422,6 +435,11 @@ int vtkPolyDataConnectivityFilter::RequestData(
   delete [] this->Visited;
   delete [] this->PointMap;
   this->Mesh->Delete();
+  if ( this->StaticLinks )
+    {
+    this->StaticLinks->Delete();
+    this->StaticLinks = NULL;
+    }
   output->Squeeze();
   this->CellIds->Delete();
   this->PointIds->Delete();
@@ -439,6 +457,27 @@ int vtkPolyDataConnectivityFilter::RequestData(
   return 1;
 }
 
+// Get the cells using a point, from the static links if they were built.
+//
+void vtkPolyDataConnectivityFilter::GetPointCells(vtkIdType ptId,
+                                                  vtkIdType &ncells,
+                                                  const vtkIdType *&cells)
+{
+  if ( this->StaticLinks )
+    {
+    ncells = this->StaticLinks->GetNcells(ptId);
+    cells = this->StaticLinks->GetCells(ptId);
+    }
+  else
+    {
+    unsigned short numCells;
+    vtkIdType *cellIds;
+    this->Mesh->GetPointCells(ptId, numCells, cellIds);
+    ncells = numCells;
+    cells = cellIds;
+    }
+}
+
 // Mark current cell as visited and assign region number.  Note:
 // traversal occurs across shared vertices.
 //
@@ -446,9 +485,9 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark ()
 {
   vtkIdType cellId, ptId, numIds, i;
   int j, k;
-  vtkIdType *pts, *cells, npts;
+  vtkIdType *pts, npts, ncells;
+  const vtkIdType *cells;
   vtkIdList *tmpWave;
-  unsigned short ncells;
 
   while ( (numIds=this->Wave->GetNumberOfIds()) > 0 )
     {
@@ -470,7 +509,7 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark ()
               this->PointMap[ptId], this->RegionNumber);
             }
 
-          this->Mesh->GetPointCells(ptId,ncells,cells);
+          this->GetPointCells(ptId,ncells,cells);
 
           // check connectivity criterion (geometric + scalar)
           for (k=0; k < ncells; k++)
@@ -634,6 +673,8 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   double *range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
+  os << indent << "Use Static Cell Links: "
+     << (this->UseStaticCellLinks ? "On\n" : "Off\n");
 
   os << indent << "RegionSizes: ";
   if (this->GetNumberOfExtractedRegions() > 10)
@@ -60,6 +60,7 @@
 class vtkDataArray;
 class vtkIdList;
 class vtkIdTypeArray;
+class vtkStaticCellLinks;
 
 class VTKFILTERSCORE_EXPORT vtkPolyDataConnectivityFilter : public vtkPolyDataAlgorithm
 {
@@ -173,6 +174,14 @@ public:
   // has been set.
   vtkGetObjectMacro( VisitedPointIds, vtkIdList );
 
+  // Description:
+  // Find the cells using each point with a vtkStaticCellLinks, built in
+  // parallel, instead of the links of vtkPolyData::BuildLinks(). The
+  // extracted regions are the same. Default is OFF.
+  vtkSetMacro( UseStaticCellLinks, int );
+  vtkGetMacro( UseStaticCellLinks, int );
+  vtkBooleanMacro( UseStaticCellLinks, int );
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter();
@@ -198,6 +207,10 @@ protected:
 
   void TraverseAndMark();
 
+  // Get the cells using a point from the links in use.
+  void GetPointCells(vtkIdType ptId, vtkIdType &ncells,
+                     const vtkIdType *&cells);
+
   // used to support algorithm execution
   vtkDataArray *CellScalars;
   vtkIdList *NeighborCellPointIds;
@@ -217,6 +230,9 @@ protected:
 
   int MarkVisitedPointIds;
 
+  int UseStaticCellLinks;
+  vtkStaticCellLinks *StaticLinks;
+
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&);  // Not implemented.
   void operator=(const vtkPolyDataConnectivityFilter&);  // Not implemented.
@@ -16,6 +16,7 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkFloatArray.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
@@ -24,8 +25,346 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
-#include "vtkTriangleStrip.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+#include "vtkTriangleStrip.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Compute the normals of a range of polygons.
+class vtkPolyDataNormalsPolyNormals
+{
+public:
+  vtkPolyDataNormalsPolyNormals(vtkPolyData *mesh, vtkPoints *points,
+                                float *normals)
+    : Mesh(mesh), Points(points), Normals(normals) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    vtkIdType npts, *pts;
+    double n[3];
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      float *normal = this->Normals + 3*cellId;
+      for (int j = 0; j < 3; j++)
+        {
+        normal[j] = static_cast<float>(n[j]);
+        }
+      }
+    }
+
+private:
+  vtkPolyData *Mesh;
+  vtkPoints *Points;
+  float *Normals;
+};
+
+//----------------------------------------------------------------------------
+// Label the regions of the cells around each point of a range that are
+// connected by edges that are not feature edges. The labels are stored in
+// Regions, parallel to the links of the point, and the number of regions
+// minus one, the number of points to add, in Counts[ptId+1].
+class vtkPolyDataNormalsMarkRegions
+{
+public:
+  vtkPolyDataNormalsMarkRegions(vtkPolyData *mesh, vtkStaticCellLinks *links,
+                                const float *polyNormals, double cosAngle,
+                                int *regions, vtkIdType *counts)
+    : Mesh(mesh), Links(links), PolyNormals(polyNormals), CosAngle(cosAngle),
+      Regions(regions), Counts(counts) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    vtkIdList *cellIds = vtkIdList::New();
+    cellIds->Allocate(VTK_CELL_SIZE);
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      this->Counts[ptId+1] = this->MarkRegions(ptId, cellIds) - 1;
+      }
+    cellIds->Delete();
+    }
+
+  // Start moving around the "cycle" of points using the point. Label each
+  // subregion of cells connected to this point that are connected (and not
+  // separated by a feature edge) with a given region number. Return the
+  // number of regions.
+  int MarkRegions(vtkIdType ptId, vtkIdList *cellIds) const
+    {
+    const vtkIdType *cells = this->Links->GetCells(ptId);
+    vtkIdType ncells = this->Links->GetNcells(ptId);
+    int *regions = this->Regions + (cells - this->Links->GetLinks());
+    vtkIdType i, j;
+    if ( ncells <= 1 )
+      {
+      std::fill(regions, regions + ncells, 0);
+      return 1; //point does not need to be further disconnected
+      }
+
+    // Start by initializing the cells as unvisited. A cell using the point
+    // several times is labeled at its first link.
+    std::fill(regions, regions + ncells, -1);
+
+    // Loop over all cells and mark the region that each is in.
+    //
+    vtkIdType numPts;
+    vtkIdType *pts;
+    int numRegions = 0;
+    vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+    double thisNormal[3], neiNormal[3];
+    for (j=0; j<ncells; j++) //for all cells connected to point
+      {
+      if ( regions[this->Find(cells, ncells, cells[j])] < 0 )
+        {
+        regions[j] = numRegions;
+        //okay, mark all the cells connected to this seed cell and using ptId
+        this->Mesh->GetCellPoints(cells[j],numPts,pts);
+
+        //find the two edges
+        for (spot=0; spot < numPts; spot++)
+          {
+          if ( pts[spot] == ptId )
+            {
+            break;
+            }
+          }
+
+        if ( spot == 0 )
+          {
+          neiPt[0] = pts[spot+1];
+          neiPt[1] = pts[numPts-1];
+          }
+        else if ( spot == (numPts-1) )
+          {
+          neiPt[0] = pts[spot-1];
+          neiPt[1] = pts[0];
+          }
+        else
+          {
+          neiPt[0] = pts[spot+1];
+          neiPt[1] = pts[spot-1];
+          }
+
+        for (i=0; i<2; i++) //for each of the two edges of the seed cell
+          {
+          cellId = cells[j];
+          nei = neiPt[i];
+          while ( cellId >= 0 ) //while we can grow this region
+            {
+            this->Links->GetCellEdgeNeighbors(cellId, ptId, nei, cellIds);
+            vtkIdType neiIndex = -1;
+            if ( cellIds->GetNumberOfIds() == 1 )
+              {
+              neiCellId = cellIds->GetId(0);
+              neiIndex = this->Find(cells, ncells, neiCellId);
+              }
+            if ( neiIndex >= 0 && regions[neiIndex] < 0 )
+              {
+              const float *thisNormalIn = this->PolyNormals + 3*cellId;
+              const float *neiNormalIn = this->PolyNormals + 3*neiCellId;
+              for (int k=0; k < 3; k++)
+                {
+                thisNormal[k] = thisNormalIn[k];
+                neiNormal[k] = neiNormalIn[k];
+                }
+
+              if ( vtkMath::Dot(thisNormal,neiNormal) > this->CosAngle )
+                {
+                //visit and arrange to visit next edge neighbor
+                regions[neiIndex] = numRegions;
+                cellId = neiCellId;
+                this->Mesh->GetCellPoints(cellId,numPts,pts);
+
+                for (spot=0; spot < numPts; spot++)
+                  {
+                  if ( pts[spot] == ptId )
+                    {
+                    break;
+                    }
+                  }
+
+                if (spot == 0)
+                  {
+                  nei = (pts[spot+1] != nei ? pts[spot+1] : pts[numPts-1]);
+                  }
+                else if (spot == (numPts-1))
+                  {
+                  nei = (pts[spot-1] != nei ? pts[spot-1] : pts[0]);
+                  }
+                else
+                  {
+                  nei = (pts[spot+1] != nei ? pts[spot+1] : pts[spot-1]);
+                  }
+
+                }//if not separated by edge angle
+              else
+                {
+                cellId = -1; //separated by edge angle
+                }
+              }//if can move to edge neighbor
+            else
+              {
+              cellId = -1;//separated by previous visit, boundary, or non-manifold
+              }
+            }//while visit wave is propagating
+          }//for each of the two edges of the starting cell
+        numRegions++;
+        }//if cell is unvisited
+      }//for all cells connected to point ptId
+
+    // Copy the labels to the other links of the cells using the point
+    // several times.
+    for (j=1; j<ncells; j++)
+      {
+      if ( cells[j] == cells[j-1] )
+        {
+        regions[j] = regions[j-1];
+        }
+      }
+    return numRegions;
+    }
+
+  // Return the index of the first link to cellId.
+  static vtkIdType Find(const vtkIdType *cells, vtkIdType ncells,
+                        vtkIdType cellId)
+    {
+    return std::lower_bound(cells, cells + ncells, cellId) - cells;
+    }
+
+private:
+  vtkPolyData *Mesh;
+  vtkStaticCellLinks *Links;
+  const float *PolyNormals;
+  double CosAngle;
+  int *Regions;
+  vtkIdType *Counts;
+};
+
+//----------------------------------------------------------------------------
+// For all cells of a range not in the first region of one of their points,
+// the point is replaced with a new point, which is a duplicate of the
+// point, but disconnected topologically. NewIds holds the first new point of
+// each point.
+class vtkPolyDataNormalsSplitCells
+{
+public:
+  vtkPolyDataNormalsSplitCells(vtkPolyData *mesh, vtkStaticCellLinks *links,
+                               const int *regions, const vtkIdType *newIds)
+    : Mesh(mesh), Links(links), Regions(regions), NewIds(newIds) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    vtkIdType npts, *pts;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      // the points are replaced last to first, so that the earlier uses of
+      // a point used several times are still in place to be counted
+      for (vtkIdType i = npts-1; i >= 0; i--)
+        {
+        vtkIdType ptId = pts[i];
+        if ( this->NewIds[ptId+1] == this->NewIds[ptId] )
+          {
+          continue; //a single region
+          }
+        const vtkIdType *cells = this->Links->GetCells(ptId);
+        vtkIdType link = vtkPolyDataNormalsMarkRegions::Find(
+          cells, this->Links->GetNcells(ptId), cellId);
+        for (vtkIdType j = 0; j < i; j++)
+          {
+          link += (pts[j] == ptId);
+          }
+        int region = this->Regions[(cells - this->Links->GetLinks()) + link];
+        if ( region > 0 )
+          {
+          pts[i] = this->NewIds[ptId] + region - 1;
+          }
+        }
+      }
+    }
+
+private:
+  vtkPolyData *Mesh;
+  vtkStaticCellLinks *Links;
+  const int *Regions;
+  const vtkIdType *NewIds;
+};
+
+//----------------------------------------------------------------------------
+// Sum the normals of the polygons around each point of a range, in the
+// order of the polygons, and normalize them. When the mesh is split, the
+// polygons of each region are summed into the normal of the point of the
+// region. A point not used by any polygon is left null.
+class vtkPolyDataNormalsPointNormals
+{
+public:
+  vtkPolyDataNormalsPointNormals(vtkStaticCellLinks *links,
+                                 const int *regions, const vtkIdType *newIds,
+                                 const float *polyNormals, float *normals,
+                                 double flipDirection)
+    : Links(links), Regions(regions), NewIds(newIds),
+      PolyNormals(polyNormals), Normals(normals),
+      FlipDirection(flipDirection) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    std::vector<float> sums;
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      const vtkIdType *cells = this->Links->GetCells(ptId);
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      const int *regions = (this->Regions ?
+        this->Regions + (cells - this->Links->GetLinks()) : NULL);
+      int numRegions = (this->NewIds ?
+        static_cast<int>(this->NewIds[ptId+1] - this->NewIds[ptId]) + 1 : 1);
+
+      // The sums are computed in double precision, like the normals.
+      sums.assign(3*numRegions, 0.0f);
+      for (vtkIdType i = 0; i < ncells; i++)
+        {
+        const float *polyNormal = this->PolyNormals + 3*cells[i];
+        float *sum = &sums[0] + 3*(regions ? regions[i] : 0);
+        for (int j = 0; j < 3; j++)
+          {
+          sum[j] = static_cast<float>(
+            static_cast<double>(sum[j]) + static_cast<double>(polyNormal[j]));
+          }
+        }
+
+      for (int r = 0; r < numRegions; r++)
+        {
+        vtkIdType newId = (r == 0 ? ptId : this->NewIds[ptId] + r - 1);
+        double vertNormal[3];
+        for (int j = 0; j < 3; j++)
+          {
+          vertNormal[j] = sums[3*r+j];
+          }
+        double length = vtkMath::Norm(vertNormal);
+        float *normal = this->Normals + 3*newId;
+        for (int j = 0; j < 3; j++)
+          {
+          normal[j] = (length != 0.0 ? static_cast<float>(
+            vertNormal[j] / length * this->FlipDirection) : 0.0f);
+          }
+        }
+      }
+    }
+
+private:
+  vtkStaticCellLinks *Links;
+  const int *Regions;
+  const vtkIdType *NewIds;
+  const float *PolyNormals;
+  float *Normals;
+  double FlipDirection;
+};
+}
 
 vtkStandardNewMacro(vtkPolyDataNormals);
 
@@ -70,7 +409,6 @@ int vtkPolyDataNormals::RequestData(
   vtkIdType i;
   vtkIdType *pts = 0;
   vtkIdType numNewPts;
-  double polyNormal[3], vertNormal[3], length;
   double flipDirection=1.0;
   vtkIdType numPolys, numStrips;
   vtkIdType cellId;
@@ -84,6 +422,9 @@ int vtkPolyDataNormals::RequestData(
   double n[3];
   vtkCellArray *newPolys;
   vtkIdType ptId, oldId;
+  std::vector<int> regions;
+  std::vector<vtkIdType> newIds;
+  std::vector<vtkIdType> map;
 
   vtkDebugMacro(<<"Generating surface normals");
 
@@ -143,7 +484,10 @@ int vtkPolyDataNormals::RequestData(
     this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
     }
-  this->OldMesh->BuildLinks();
+  // The links are built in parallel, with the cells of each point in
+  // increasing order; they also serve as the edge table of the mesh.
+  this->Links = vtkStaticCellLinks::New();
+  this->Links->BuildLinks(this->OldMesh);
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
@@ -161,7 +505,7 @@ int vtkPolyDataNormals::RequestData(
 
   // The visited array keeps track of which polygons have been visited.
   //
-  if ( this->Consistency || this->Splitting || this->AutoOrientNormals )
+  if ( this->Consistency || this->AutoOrientNormals )
     {
     this->Visited = new int[numPolys];
     memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys*sizeof(int));
@@ -193,11 +537,11 @@ int vtkPolyDataNormals::RequestData(
     // the mesh. Report bugs/issues to cvolpe@ara.com.
     int foundLeftmostCell;
     vtkIdType leftmostCellID=-1, currentPointID, currentCellID;
-    vtkIdType *leftmostCells;
-    unsigned short nleftmostCells;
+    const vtkIdType *leftmostCells;
+    vtkIdType nleftmostCells;
     vtkIdType *cellPts;
     vtkIdType nCellPts;
-    int cIdx;
+    vtkIdType cIdx;
     double bestNormalAbsXComponent;
     int bestReverseFlag;
     vtkPriorityQueue *leftmostPoints = vtkPriorityQueue::New();
@@ -227,7 +571,8 @@ int vtkPolyDataNormals::RequestData(
       // at that point
       do {
         currentPointID = leftmostPoints->Pop();
-        this->OldMesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
+        nleftmostCells = this->Links->GetNcells(currentPointID);
+        leftmostCells = this->Links->GetCells(currentPointID);
         bestNormalAbsXComponent = 0.0;
         bestReverseFlag = 0;
         for (cIdx = 0; cIdx < nleftmostCells; cIdx++)
@@ -316,20 +661,22 @@ int vtkPolyDataNormals::RequestData(
   this->PolyNormals->Allocate(3*numPolys);
   this->PolyNormals->SetName("Normals");
   this->PolyNormals->SetNumberOfTuples(numPolys);
-
-  for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
-       cellId++ )
+  float *polyNormals = this->PolyNormals->GetPointer(0);
+
+  // The normals are computed in parallel, a tenth of the polygons at a time
+  // to report progress.
+  vtkPolyDataNormalsPolyNormals computeNormals(this->NewMesh, inPts,
+                                               polyNormals);
+  vtkIdType tenth = numPolys/10 + 1;
+  for (cellId=0; cellId < numPolys; cellId += tenth)
     {
-    if ((cellId % 1000) == 0)
+    this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
+    if (this->GetAbortExecute())
       {
-      this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
-      if (this->GetAbortExecute())
-        {
-        break;
-        }
+      break;
       }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(cellId,n);
+    vtkSMPTools::For(cellId, std::min(cellId + tenth, numPolys),
+                     computeNormals);
     }
 
   // Split mesh if sharp features
@@ -339,23 +686,45 @@ int vtkPolyDataNormals::RequestData(
     //  edges found, split mesh creating new nodes.  Update polygon
     // connectivity.
     //
-      this->CosAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
-    //  Splitting will create new points.  We have to create index array
-    // to map new points into old points.
+    this->CosAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
+
+    //  The regions around each point are labeled in parallel. For N
+    //  regions, N-1 duplicate (split) points are created, numbered in the
+    //  order of the points: newIds[ptId] is the first split point of ptId.
     //
-    this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (i=0; i < numPts; i++)
+    regions.resize(this->Links->GetLinksSize());
+    newIds.resize(numPts+1);
+    vtkPolyDataNormalsMarkRegions markRegions(
+      this->OldMesh, this->Links, polyNormals, this->CosAngle,
+      regions.empty() ? NULL : &regions[0], &newIds[0]);
+    vtkSMPTools::For(0, numPts, markRegions);
+    newIds[0] = numPts;
+    for (ptId=0; ptId < numPts; ptId++)
       {
-      this->Map->SetId(i,i);
+      newIds[ptId+1] += newIds[ptId];
       }
+    numNewPts = newIds[numPts];
 
+    //  The split points replace the point in the polygons not in its
+    //  first region, in parallel over the polygons.
+    //
+    vtkPolyDataNormalsSplitCells splitCells(
+      this->NewMesh, this->Links, regions.empty() ? NULL : &regions[0],
+      &newIds[0]);
+    vtkSMPTools::For(0, numPolys, splitCells);
+
+    //  Splitting has created new points.  We have to create index array
+    // to map new points into old points.
+    //
+    map.resize(numNewPts);
     for (ptId=0; ptId < numPts; ptId++)
       {
-      this->MarkAndSplit(ptId);
-      }//for all input points
-
-    numNewPts = this->Map->GetNumberOfIds();
+      map[ptId] = ptId;
+      for (i=newIds[ptId]; i < newIds[ptId+1]; i++)
+        {
+        map[i] = ptId;
+        }
+      }
 
     vtkDebugMacro(<<"Created " << numNewPts-numPts << " new points");
 
@@ -387,11 +756,10 @@ int vtkPolyDataNormals::RequestData(
     newPts->SetNumberOfPoints(numNewPts);
     for (ptId=0; ptId < numNewPts; ptId++)
       {
-      oldId = this->Map->GetId(ptId);
+      oldId = map[ptId];
       newPts->SetPoint(ptId,inPts->GetPoint(oldId));
       outPD->CopyData(pd,oldId,ptId);
       }
-    this->Map->Delete();
     } //splitting
 
   else //no splitting, so no new points
@@ -401,7 +769,7 @@ int vtkPolyDataNormals::RequestData(
     outPD->PassData(pd);
     }
 
-  if ( this->Consistency || this->Splitting )
+  if ( this->Visited )
     {
     delete [] this->Visited;
     this->CellIds->Delete();
@@ -421,42 +789,35 @@ int vtkPolyDataNormals::RequestData(
   newNormals->SetNumberOfComponents(3);
   newNormals->SetNumberOfTuples(numNewPts);
   newNormals->SetName("Normals");
-  n[0] = n[1] = n[2] = 0.0;
-  for (i=0; i < numNewPts; i++)
-    {
-    newNormals->SetTuple(i,n);
-    }
+  vtkDataArrayTupleRange<float, 3> pointNormals(newNormals);
+  std::fill(pointNormals.GetValueBegin(), pointNormals.GetValueEnd(), 0.0f);
 
   if (this->ComputePointNormals)
     {
-    for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
-          cellId++ )
-      {
-      this->PolyNormals->GetTuple(cellId, polyNormal);
-
-      for (i=0; i < npts; i++)
-        {
-        newNormals->GetTuple(pts[i], vertNormal);
-        for (j=0; j < 3; j++)
-          {
-          n[j] = vertNormal[j] + polyNormal[j];
-          }
-        newNormals->SetTuple(pts[i],n);
-        }
-      }
-
+    // Each point gathers the normals of its polygons in parallel, in the
+    // order of the polygons, so that the sums do not depend on the number
+    // of threads.
+    vtkPolyDataNormalsPointNormals computePointNormals(
+      this->Links, regions.empty() ? NULL : &regions[0],
+      newIds.empty() ? NULL : &newIds[0], polyNormals,
+      pointNormals.GetValueBegin(), flipDirection);
+    vtkSMPTools::For(0, numPts, computePointNormals);
+
+    // As before, a point that is not used by any polygon gets the normal
+    // of the previous point.
+    float *previous = NULL;
     for (i=0; i < numNewPts; i++)
       {
-      newNormals->GetTuple(i, vertNormal);
-      length = vtkMath::Norm(vertNormal);
-      if (length != 0.0)
+      float *vertNormalOut = pointNormals.GetTuple(i);
+      if (previous && vertNormalOut[0] == 0.0f && vertNormalOut[1] == 0.0f &&
+          vertNormalOut[2] == 0.0f)
         {
         for (j=0; j < 3; j++)
           {
-          n[j] = vertNormal[j] / length * flipDirection;
+          vertNormalOut[j] = previous[j];
           }
         }
-      newNormals->SetTuple(i,n);
+      previous = vertNormalOut;
       }
     }
 
@@ -495,6 +856,7 @@ int vtkPolyDataNormals::RequestData(
   output->SetVerts(input->GetVerts());
   output->SetLines(input->GetLines());
 
+  this->Links->Delete();
   this->OldMesh->Delete();
   this->NewMesh->Delete();
 
@@ -526,7 +888,7 @@ void vtkPolyDataNormals::TraverseAndOrder (void)
         p1 = pts[j];
         p2 = pts[(j+1)%npts];
 
-        this->OldMesh->GetCellEdgeNeighbors(cellId, p1, p2, this->CellIds);
+        this->Links->GetCellEdgeNeighbors(cellId, p1, p2, this->CellIds);
 
         //  Check the direction of the neighbor ordering.  Should be
         //  consistent with us (i.e., if we are n1->n2,
@@ -573,167 +935,6 @@ void vtkPolyDataNormals::TraverseAndOrder (void)
   return;
 }
 
-//
-//  Mark polygons around vertex.  Create new vertex (if necessary) and
-//  replace (i.e., split mesh).
-//
-void vtkPolyDataNormals::MarkAndSplit (vtkIdType ptId)
-{
-  int i,j;
-
-  // Get the cells using this point and make sure that we have to do something
-  unsigned short ncells;
-  vtkIdType *cells;
-  this->OldMesh->GetPointCells(ptId,ncells,cells);
-  if ( ncells <= 1 )
-    {
-    return; //point does not need to be further disconnected
-    }
-
-  // Start moving around the "cycle" of points using the point. Label
-  // each point as requiring a visit. Then label each subregion of cells
-  // connected to this point that are connected (and not separated by
-  // a feature edge) with a given region number. For each N regions
-  // created, N-1 duplicate (split) points are created. The split point
-  // replaces the current point ptId in the polygons connectivity array.
-  //
-  // Start by initializing the cells as unvisited
-  for (i=0; i<ncells; i++)
-    {
-    this->Visited[cells[i]] = -1;
-    }
-
-  // Loop over all cells and mark the region that each is in.
-  //
-  vtkIdType numPts;
-  vtkIdType *pts;
-  int numRegions = 0;
-  vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
-  double thisNormal[3], neiNormal[3];
-  for (j=0; j<ncells; j++) //for all cells connected to point
-    {
-    if ( this->Visited[cells[j]] < 0 ) //for all unvisited cells
-      {
-      this->Visited[cells[j]] = numRegions;
-      //okay, mark all the cells connected to this seed cell and using ptId
-      this->OldMesh->GetCellPoints(cells[j],numPts,pts);
-
-      //find the two edges
-      for (spot=0; spot < numPts; spot++)
-        {
-        if ( pts[spot] == ptId )
-          {
-          break;
-          }
-        }
-
-      if ( spot == 0 )
-        {
-        neiPt[0] = pts[spot+1];
-        neiPt[1] = pts[numPts-1];
-        }
-      else if ( spot == (numPts-1) )
-        {
-        neiPt[0] = pts[spot-1];
-        neiPt[1] = pts[0];
-        }
-      else
-        {
-        neiPt[0] = pts[spot+1];
-        neiPt[1] = pts[spot-1];
-        }
-
-      for (i=0; i<2; i++) //for each of the two edges of the seed cell
-        {
-        cellId = cells[j];
-        nei = neiPt[i];
-        while ( cellId >= 0 ) //while we can grow this region
-          {
-          this->OldMesh->GetCellEdgeNeighbors(cellId,ptId,nei,this->CellIds);
-          if ( this->CellIds->GetNumberOfIds() == 1 &&
-               this->Visited[(neiCellId=this->CellIds->GetId(0))] < 0 )
-            {
-            this->PolyNormals->GetTuple(cellId, thisNormal);
-            this->PolyNormals->GetTuple(neiCellId, neiNormal);
-
-            if ( vtkMath::Dot(thisNormal,neiNormal) > CosAngle )
-              {
-              //visit and arrange to visit next edge neighbor
-              this->Visited[neiCellId] = numRegions;
-              cellId = neiCellId;
-              this->OldMesh->GetCellPoints(cellId,numPts,pts);
-
-              for (spot=0; spot < numPts; spot++)
-                {
-                if ( pts[spot] == ptId )
-                  {
-                  break;
-                  }
-                }
-
-              if (spot == 0)
-                {
-                nei = (pts[spot+1] != nei ? pts[spot+1] : pts[numPts-1]);
-                }
-              else if (spot == (numPts-1))
-                {
-                nei = (pts[spot-1] != nei ? pts[spot-1] : pts[0]);
-                }
-              else
-                {
-                nei = (pts[spot+1] != nei ? pts[spot+1] : pts[spot-1]);
-                }
-
-              }//if not separated by edge angle
-            else
-              {
-              cellId = -1; //separated by edge angle
-              }
-            }//if can move to edge neighbor
-          else
-            {
-            cellId = -1;//separated by previous visit, boundary, or non-manifold
-            }
-          }//while visit wave is propagating
-        }//for each of the two edges of the starting cell
-      numRegions++;
-      }//if cell is unvisited
-    }//for all cells connected to point ptId
-
-  if ( numRegions <=1 )
-    {
-    return; //a single region, no splitting ever required
-    }
-
-  // Okay, for all cells not in the first region, the ptId is
-  // replaced with a new ptId, which is a duplicate of the first
-  // point, but disconnected topologically.
-  //
-  vtkIdType lastId = this->Map->GetNumberOfIds();
-  vtkIdType replacementPoint;
-  for (j=0; j<ncells; j++)
-    {
-    if (this->Visited[cells[j]] > 0 ) //replace point if splitting needed
-      {
-      replacementPoint = lastId + this->Visited[cells[j]] - 1;
-
-      this->Map->InsertId(replacementPoint, ptId);
-
-      this->NewMesh->GetCellPoints(cells[j],numPts,pts);
-      for (i=0; i < numPts; i++)
-        {
-        if ( pts[i] == ptId )
-          {
-          pts[i] = replacementPoint; // this is very nasty! direct write!
-          break;
-          }
-        }//replace ptId with split point
-      }//if not in first regions and requiring splitting
-    }//for all cells connected to ptId
-
-  return;
-}
-
 void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
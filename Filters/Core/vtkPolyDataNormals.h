@@ -36,6 +36,12 @@
 // averaging them at shared points. When sharp edges are present, the edges
 // are split and new points generated to prevent blurry edges (due to
 // Gouraud shading).
+//
+// The polygon normals, the splitting of the points around sharp edges and
+// the averaging of the point normals run in parallel with vtkSMPTools, on
+// the cells of each point given by a vtkStaticCellLinks. The output does
+// not depend on the number of threads. Only the traversals that make the
+// polygon ordering consistent are serial.
 
 // .SECTION Caveats
 // Normals are computed only for polygons and triangle strips. Normals are
@@ -53,6 +59,7 @@
 class vtkFloatArray;
 class vtkIdList;
 class vtkPolyData;
+class vtkStaticCellLinks;
 
 class VTKFILTERSCORE_EXPORT vtkPolyDataNormals : public vtkPolyDataAlgorithm
 {
@@ -157,9 +164,9 @@ private:
   vtkIdList *Wave;
   vtkIdList *Wave2;
   vtkIdList *CellIds;
-  vtkIdList *Map;
   vtkPolyData *OldMesh;
   vtkPolyData *NewMesh;
+  vtkStaticCellLinks *Links;
   int *Visited;
   vtkFloatArray *PolyNormals;
   double CosAngle;
@@ -168,11 +175,6 @@ private:
   // checked and properly ordered polygons.
   void TraverseAndOrder(void);
 
-  // Check the point id give to see whether it lies on a feature
-  // edge. If so, split the point (i.e., duplicate it) to topologically
-  // separate the mesh.
-  void MarkAndSplit(vtkIdType ptId);
-
 private:
   vtkPolyDataNormals(const vtkPolyDataNormals&);  // Not implemented.
   void operator=(const vtkPolyDataNormals&);  // Not implemented.
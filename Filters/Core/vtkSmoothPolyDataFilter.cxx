@@ -25,9 +25,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
 // The following code defines a helper class for performing mesh smoothing
@@ -113,7 +119,8 @@ vtkSmoothPoint *vtkSmoothPoints::Resize(vtkIdType sz)
 // feature edge smoothing turned off; feature
 // angle 45 degrees; edge angle 15 degrees; and boundary smoothing turned
 // on. Error scalars and vectors are not generated (by default). The
-// convergence criterion is 0.0 of the bounding box diagonal.
+// convergence criterion is 0.0 of the bounding box diagonal. Jacobi
+// updates are turned off.
 vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
 {
   this->Convergence = 0.0; //goes to number of specied iterations
@@ -129,6 +136,8 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorScalars = 0;
   this->GenerateErrorVectors = 0;
 
+  this->JacobiUpdate = 0;
+
   // optional second input
   this->SetNumberOfInputPorts(2);
 }
@@ -153,12 +162,174 @@ vtkPolyData *vtkSmoothPolyDataFilter::GetSource()
 #define VTK_FEATURE_EDGE_VERTEX 2
 #define VTK_BOUNDARY_EDGE_VERTEX 3
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
-  {
-  char      type;
-  vtkIdList *edges; // connected edges (list of connected point ids)
-} vtkMeshVertex, *vtkMeshVertexPtr;
+namespace
+{
+//----------------------------------------------------------------------------
+// The vertices connected to each point (the edges), in compressed sparse row
+// layout. During the topological analysis each point fills a slot sized for
+// the largest number of vertices it may be connected to (two per use of the
+// point by a line or a polygon), so that no per-point list is allocated;
+// Reset() and InsertNextId() behave like the vtkIdList methods. Squeeze()
+// then packs the lists back to back: the vertices connected to point i are
+// Ids[Offsets[i]] to Ids[Offsets[i+1]-1].
+class vtkSmoothPolyDataFilterEdges
+{
+public:
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Counts;
+  std::vector<vtkIdType> Ids;
+
+  vtkSmoothPolyDataFilterEdges(vtkIdType numPts)
+    : Offsets(numPts+1, 0), Counts(numPts, 0) {}
+
+  // Make room for the edges of the points of a set of cells.
+  void AddCells(vtkCellArray *cells)
+    {
+    vtkIdType npts, *pts;
+    for (cells->InitTraversal(); cells->GetNextCell(npts,pts); )
+      {
+      for (vtkIdType j=0; j < npts; j++)
+        {
+        this->Offsets[pts[j]+1] += 2;
+        }
+      }
+    }
+
+  // Turn the sizes of the slots into offsets once all cells were added.
+  void Allocate()
+    {
+    for (size_t i=1; i < this->Offsets.size(); i++)
+      {
+      this->Offsets[i] += this->Offsets[i-1];
+      }
+    this->Ids.resize(this->Offsets.back());
+    }
+
+  vtkIdType GetNumberOfIds(vtkIdType ptId) const
+    {
+    return this->Counts[ptId];
+    }
+  vtkIdType GetId(vtkIdType ptId, vtkIdType i) const
+    {
+    return this->Ids[this->Offsets[ptId] + i];
+    }
+  void Reset(vtkIdType ptId)
+    {
+    this->Counts[ptId] = 0;
+    }
+  void InsertNextId(vtkIdType ptId, vtkIdType id)
+    {
+    this->Ids[this->Offsets[ptId] + this->Counts[ptId]++] = id;
+    }
+
+  void Squeeze()
+    {
+    vtkIdType numPts = static_cast<vtkIdType>(this->Counts.size());
+    std::vector<vtkIdType> ids;
+    ids.reserve(this->Offsets[numPts]);
+    for (vtkIdType i=0; i < numPts; i++)
+      {
+      std::vector<vtkIdType>::iterator first =
+        this->Ids.begin() + this->Offsets[i];
+      this->Offsets[i] = static_cast<vtkIdType>(ids.size());
+      ids.insert(ids.end(), first, first + this->Counts[i]);
+      }
+    this->Offsets[numPts] = static_cast<vtkIdType>(ids.size());
+    this->Ids.swap(ids);
+    std::vector<vtkIdType>().swap(this->Counts);
+    }
+};
+
+//----------------------------------------------------------------------------
+// One smoothing iteration. Each point that is allowed to move goes toward
+// the average of its connected vertices, as found at the previous
+// iteration (Jacobi update), so that the points are independent of each
+// other and are processed in parallel. The largest motion is reduced over
+// the threads for the convergence test.
+template <class T>
+class vtkSmoothPolyDataFilterIteration
+{
+public:
+  const vtkIdType *Offsets;
+  const vtkIdType *Ids;
+  const char *Types;
+  const T *X;
+  T *XNew;
+  double Factor;
+  vtkSMPThreadLocal<double> LocalMaxDist;
+  double MaxDist;
+
+  void Initialize()
+    {
+    this->LocalMaxDist.Local() = 0.0;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double &maxDist = this->LocalMaxDist.Local();
+    for (vtkIdType i=begin; i < end; i++)
+      {
+      vtkIdType npts = this->Offsets[i+1] - this->Offsets[i];
+      if ( this->Types[i] == VTK_FIXED_VERTEX || npts == 0 )
+        {
+        continue;
+        }
+      const vtkIdType *ids = this->Ids + this->Offsets[i];
+      const T *xi = this->X + 3*i;
+      double x[3] = { xi[0], xi[1], xi[2] };
+      double deltaX[3] = { 0.0, 0.0, 0.0 };
+      for (vtkIdType j=0; j < npts; j++)
+        {
+        const T *y = this->X + 3*ids[j];
+        for (int k=0; k < 3; k++)
+          {
+          deltaX[k] += (y[k] - x[k]) / npts;
+          }
+        }
+
+      T *xNew = this->XNew + 3*i;
+      for (int k=0; k < 3; k++)
+        {
+        xNew[k] = static_cast<T>(x[k] + this->Factor * deltaX[k]);
+        }
+      double dist = vtkMath::Norm(deltaX);
+      if ( dist > maxDist )
+        {
+        maxDist = dist;
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    this->MaxDist = 0.0;
+    typename vtkSMPThreadLocal<double>::iterator iter;
+    for (iter = this->LocalMaxDist.begin();
+         iter != this->LocalMaxDist.end(); ++iter)
+      {
+      this->MaxDist = std::max(this->MaxDist, *iter);
+      }
+    }
+};
+
+// Run one iteration from the points to the new points and return the
+// largest motion.
+template <class T>
+double vtkSmoothPolyDataFilterIterate(const vtkSmoothPolyDataFilterEdges &edges,
+                                      const char *types, vtkPoints *points,
+                                      vtkPoints *newPts, double factor)
+{
+  vtkSmoothPolyDataFilterIteration<T> iteration;
+  iteration.Offsets = &edges.Offsets[0];
+  iteration.Ids = edges.Ids.empty() ? NULL : &edges.Ids[0];
+  iteration.Types = types;
+  iteration.X = static_cast<T *>(points->GetVoidPointer(0));
+  iteration.XNew = static_cast<T *>(newPts->GetVoidPointer(0));
+  iteration.Factor = factor;
+  vtkSMPTools::For(0, points->GetNumberOfPoints(), iteration);
+  return iteration.MaxDist;
+}
+}
 
 int vtkSmoothPolyDataFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -187,19 +358,18 @@ int vtkSmoothPolyDataFilter::RequestData(
   vtkIdType npts = 0;
   vtkIdType *pts = 0;
   vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3], conv, maxDist, dist, factor;
+  double xNew[3], conv, maxDist;
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
   double CosEdgeAngle; // Cosine of angle between adjacent edges
   double closestPt[3], dist2, *w = NULL;
   int iterationNumber, abortExecute;
   vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
-  vtkPolyData *inMesh, *Mesh;
+  vtkPolyData *inMesh = NULL, *Mesh = NULL;
   vtkPoints *inPts;
   vtkTriangleFilter *toTris=NULL;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
-  vtkPoints *newPts;
-  vtkMeshVertexPtr Verts;
+  vtkPoints *newPts, *prevPts;
   vtkCellLocator *cellLocator=NULL;
 
   // Check input
@@ -242,60 +412,77 @@ int vtkSmoothPolyDataFilter::RequestData(
   // using a subset of the attached vertices.
   //
   vtkDebugMacro(<<"Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-  for (i=0; i<numPts; i++)
-    {
-    Verts[i].type = VTK_SIMPLE_VERTEX; //can smooth
-    Verts[i].edges = NULL;
-    }
+  std::vector<char> types(numPts, VTK_SIMPLE_VERTEX); //can smooth
+  vtkSmoothPolyDataFilterEdges edges(numPts);
 
   inPts = input->GetPoints();
   conv = this->Convergence * input->GetLength();
 
+  inLines=input->GetLines();
+  inPolys=input->GetPolys();
+  numPolys = inPolys->GetNumberOfCells();
+  inStrips=input->GetStrips();
+  numStrips = inStrips->GetNumberOfCells();
+
+  if ( numPolys > 0 || numStrips > 0 )
+    {
+    inMesh = vtkPolyData::New();
+    inMesh->SetPoints(inPts);
+    inMesh->SetPolys(inPolys);
+    Mesh = inMesh;
+
+    if ( numStrips > 0 )
+      { // convert data to triangles
+      inMesh->SetStrips(inStrips);
+      toTris = vtkTriangleFilter::New();
+      toTris->SetInputData(inMesh);
+      toTris->Update();
+      Mesh = toTris->GetOutput();
+      }
+    edges.AddCells(Mesh->GetPolys());
+    }
+  edges.AddCells(inLines);
+  edges.Allocate();
+
   // check vertices first. Vertices are never smoothed_--------------
   for (inVerts=input->GetVerts(), inVerts->InitTraversal();
   inVerts->GetNextCell(npts,pts); )
     {
     for (j=0; j<npts; j++)
       {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      types[pts[j]] = VTK_FIXED_VERTEX;
       }
     }
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines=input->GetLines(), inLines->InitTraversal();
-  inLines->GetNextCell(npts,pts); )
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
     {
     for (j=0; j<npts; j++)
       {
-      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+      if ( types[pts[j]] == VTK_SIMPLE_VERTEX )
         {
         if ( j == (npts-1) ) //end-of-line marked FIXED
           {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
+          types[pts[j]] = VTK_FIXED_VERTEX;
           }
         else if ( j == 0 ) //beginning-of-line marked FIXED
           {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          inPts->GetPoint(pts[0],x2);
-          inPts->GetPoint(pts[1],x3);
+          types[pts[0]] = VTK_FIXED_VERTEX;
           }
         else //is edge vertex (unless already edge vertex!)
           {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0,pts[j-1]);
-          Verts[pts[j]].edges->SetId(1,pts[j+1]);
+          types[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          edges.Reset(pts[j]);
+          edges.InsertNextId(pts[j],pts[j-1]);
+          edges.InsertNextId(pts[j],pts[j+1]);
           }
         } //if simple vertex
 
-      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX )
+      else if ( types[pts[j]] == VTK_FEATURE_EDGE_VERTEX )
         { //multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = NULL;
+        types[pts[j]] = VTK_FIXED_VERTEX;
+        edges.Reset(pts[j]);
         }
 
       } //for all points in this line
@@ -303,12 +490,7 @@ int vtkSmoothPolyDataFilter::RequestData(
   this->UpdateProgress(0.25);
 
   // now polygons and triangle strips-------------------------------
-  inPolys=input->GetPolys();
-  numPolys = inPolys->GetNumberOfCells();
-  inStrips=input->GetStrips();
-  numStrips = inStrips->GetNumberOfCells();
-
-  if ( numPolys > 0 || numStrips > 0 )
+  if ( Mesh )
     { //build cell structure
     vtkCellArray *polys;
     vtkIdType cellId;
@@ -317,26 +499,16 @@ int vtkSmoothPolyDataFilter::RequestData(
     vtkIdType *neiPts;
     double normal[3], neiNormal[3];
     vtkIdList *neighbors;
+    vtkStaticCellLinks *links;
 
     neighbors = vtkIdList::New();
     neighbors->Allocate(VTK_CELL_SIZE);
 
-    inMesh = vtkPolyData::New();
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
-
-    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
-      { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris = vtkTriangleFilter::New();
-      toTris->SetInputData(inMesh);
-      toTris->Update();
-      Mesh = toTris->GetOutput();
-      }
-
-    Mesh->BuildLinks(); //to do neighborhood searching
+    //to do neighborhood searching
     polys = Mesh->GetPolys();
+    links = vtkStaticCellLinks::New();
+    links->BuildLinks(Mesh->GetNumberOfPoints(), polys);
+    Mesh->BuildCells();
     this->UpdateProgress(0.375);
 
     for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
@@ -347,18 +519,7 @@ int vtkSmoothPolyDataFilter::RequestData(
         p1 = pts[i];
         p2 = pts[(i+1)%npts];
 
-        if ( Verts[p1].edges == NULL )
-          {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16,6);
-          }
-        if ( Verts[p2].edges == NULL )
-          {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16,6);
-          }
-
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
+        links->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
         numNei = neighbors->GetNumberOfIds();
 
         edge = VTK_SIMPLE_VERTEX;
@@ -400,37 +561,37 @@ int vtkSmoothPolyDataFilter::RequestData(
           continue;
           }
 
-        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
+        if ( edge && types[p1] == VTK_SIMPLE_VERTEX )
           {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
+          edges.Reset(p1);
+          edges.InsertNextId(p1,p2);
+          types[p1] = edge;
           }
-        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
+        else if ( (edge && types[p1] == VTK_BOUNDARY_EDGE_VERTEX) ||
+        (edge && types[p1] == VTK_FEATURE_EDGE_VERTEX) ||
+        (!edge && types[p1] == VTK_SIMPLE_VERTEX ) )
           {
-          Verts[p1].edges->InsertNextId(p2);
-          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
+          edges.InsertNextId(p1,p2);
+          if ( types[p1] && edge == VTK_BOUNDARY_EDGE_VERTEX )
             {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
+            types[p1] = VTK_BOUNDARY_EDGE_VERTEX;
             }
           }
 
-        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
+        if ( edge && types[p2] == VTK_SIMPLE_VERTEX )
           {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
+          edges.Reset(p2);
+          edges.InsertNextId(p2,p1);
+          types[p2] = edge;
           }
-        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
-        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
+        else if ( (edge && types[p2] == VTK_BOUNDARY_EDGE_VERTEX ) ||
+        (edge && types[p2] == VTK_FEATURE_EDGE_VERTEX) ||
+        (!edge && types[p2] == VTK_SIMPLE_VERTEX ) )
           {
-          Verts[p2].edges->InsertNextId(p1);
-          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
+          edges.InsertNextId(p2,p1);
+          if ( types[p2] && edge == VTK_BOUNDARY_EDGE_VERTEX )
             {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
+            types[p2] = VTK_BOUNDARY_EDGE_VERTEX;
             }
           }
         }
@@ -439,6 +600,7 @@ int vtkSmoothPolyDataFilter::RequestData(
     inMesh->Delete();
     if (toTris) {toTris->Delete();}
 
+    links->Delete();
     neighbors->Delete();
     }//if strips or polys
 
@@ -447,38 +609,38 @@ int vtkSmoothPolyDataFilter::RequestData(
   //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
     {
-    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
+    if ( types[i] == VTK_SIMPLE_VERTEX )
       {
       numSimple++;
       }
 
-    else if ( Verts[i].type == VTK_FIXED_VERTEX )
+    else if ( types[i] == VTK_FIXED_VERTEX )
       {
       numFixed++;
       }
 
-    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
-    Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+    else if ( types[i] == VTK_FEATURE_EDGE_VERTEX ||
+    types[i] == VTK_BOUNDARY_EDGE_VERTEX )
       { //see how many edges; if two, what the angle is
 
       if ( !this->BoundarySmoothing &&
-      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+      types[i] == VTK_BOUNDARY_EDGE_VERTEX )
         {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        types[i] = VTK_FIXED_VERTEX;
         numBEdges++;
         }
 
-      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
+      else if ( (npts = edges.GetNumberOfIds(i)) != 2 )
         {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        types[i] = VTK_FIXED_VERTEX;
         numFixed++;
         }
 
       else //check angle between edges
         {
-        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
+        inPts->GetPoint(edges.GetId(i,0),x1);
         inPts->GetPoint(i,x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
+        inPts->GetPoint(edges.GetId(i,1),x3);
 
         for (k=0; k<3; k++)
           {
@@ -490,11 +652,11 @@ int vtkSmoothPolyDataFilter::RequestData(
              vtkMath::Dot(l1,l2) < CosEdgeAngle)
           {
           numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
+          types[i] = VTK_FIXED_VERTEX;
           }
         else
           {
-          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
+          if ( types[i] == VTK_FEATURE_EDGE_VERTEX )
             {
             numFEdges++;
             }
@@ -507,6 +669,9 @@ int vtkSmoothPolyDataFilter::RequestData(
       }//if edge vertex
     }//for all points
 
+  // pack the connected vertices for the smoothing iterations
+  edges.Squeeze();
+
   vtkDebugMacro(<<"Found\n\t" << numSimple << " simple vertices\n\t"
                 << numFEdges << " feature edge vertices\n\t"
                 << numBEdges << " boundary edge vertices\n\t"
@@ -514,9 +679,16 @@ int vtkSmoothPolyDataFilter::RequestData(
 
   vtkDebugMacro(<<"Beginning smoothing iterations...");
 
-  // We've setup the topology...now perform Laplacian smoothing
+  // We've setup the topology...now perform Laplacian smoothing. With Jacobi
+  // updates, each iteration reads the points of the previous one, so two
+  // sets of points are swapped, and they are kept in double precision if
+  // the input points are.
   //
   newPts = vtkPoints::New();
+  if ( this->JacobiUpdate && inPts->GetDataType() == VTK_DOUBLE )
+    {
+    newPts->SetDataTypeToDouble();
+    }
   newPts->SetNumberOfPoints(numPts);
 
   // If Source defined, we do constrained smoothing (that is, points are
@@ -541,13 +713,19 @@ int vtkSmoothPolyDataFilter::RequestData(
     }
   else //smooth normally
     {
-    for (i=0; i<numPts; i++) //initialize to old coordinates
+    for (i=0; i < numPts; i++) //initialize to old coordinates
       {
       newPts->SetPoint(i,inPts->GetPoint(i));
       }
     }
+  prevPts = NULL;
+  if ( this->JacobiUpdate )
+    {
+    prevPts = vtkPoints::New();
+    prevPts->SetDataType(newPts->GetDataType());
+    prevPts->DeepCopy(newPts);
+    }
 
-  factor = this->RelaxationFactor;
   for ( maxDist=VTK_DOUBLE_MAX, iterationNumber=0, abortExecute=0;
   maxDist > conv && iterationNumber < this->NumberOfIterations && !abortExecute;
   iterationNumber++ )
@@ -563,17 +741,23 @@ int vtkSmoothPolyDataFilter::RequestData(
         }
       }
 
-    maxDist=0.0;
-    for (i=0; i<numPts; i++)
+    if ( !this->JacobiUpdate )
       {
-      if ( Verts[i].type != VTK_FIXED_VERTEX && Verts[i].edges != NULL &&
-      (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
+      // Move the points in place, each one from the points already moved.
+      maxDist=0.0;
+      for (i=0; i<numPts; i++)
         {
+        if ( types[i] == VTK_FIXED_VERTEX ||
+             (npts = edges.Offsets[i+1] - edges.Offsets[i]) == 0 )
+          {
+          continue;
+          }
+        const vtkIdType *ids = &edges.Ids[edges.Offsets[i]];
+        double x[3], y[3], deltaX[3] = { 0.0, 0.0, 0.0 };
         newPts->GetPoint(i, x); //use current points
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
         for (j=0; j<npts; j++)
           {
-          newPts->GetPoint(Verts[i].edges->GetId(j), y);
+          newPts->GetPoint(ids[j], y);
           for (k=0; k<3; k++)
             {
             deltaX[k] += (y[k] - x[k]) / npts;
@@ -582,7 +766,7 @@ int vtkSmoothPolyDataFilter::RequestData(
 
         for (k=0;k<3;k++)
           {
-          xNew[k] = x[k] + factor * deltaX[k];
+          xNew[k] = x[k] + this->RelaxationFactor * deltaX[k];
           }
 
         // Constrain point to surface
@@ -609,13 +793,63 @@ int vtkSmoothPolyDataFilter::RequestData(
           }
 
         newPts->SetPoint(i,xNew);
-        if ( (dist = vtkMath::Norm(deltaX)) > maxDist )
+        double dist = vtkMath::Norm(deltaX);
+        if ( dist > maxDist )
           {
           maxDist = dist;
           }
-        }//if can move point
-      }//for all points
+        }//for all points
+      }
+    else
+      {
+      // Jacobi update, in parallel, from the points of the previous
+      // iteration.
+      std::swap(prevPts, newPts);
+      if ( newPts->GetDataType() == VTK_DOUBLE )
+        {
+        maxDist = vtkSmoothPolyDataFilterIterate<double>(
+          edges, &types[0], prevPts, newPts, this->RelaxationFactor);
+        }
+      else
+        {
+        maxDist = vtkSmoothPolyDataFilterIterate<float>(
+          edges, &types[0], prevPts, newPts, this->RelaxationFactor);
+        }
+
+      // Constrain points to surface
+      if ( source )
+        {
+        for (i=0; i<numPts; i++)
+          {
+          if ( types[i] == VTK_FIXED_VERTEX ||
+               edges.Offsets[i+1] == edges.Offsets[i] )
+            {
+            continue;
+            }
+          vtkSmoothPoint *sPtr = this->SmoothPoints->GetSmoothPoint(i);
+          vtkCell *cell=NULL;
+
+          newPts->GetPoint(i, xNew);
+          if ( sPtr->cellId >= 0 ) //in cell
+            {
+            cell = source->GetCell(sPtr->cellId);
+            }
+
+          if ( !cell || cell->EvaluatePosition(xNew, closestPt,
+          sPtr->subId, sPtr->p, dist2, w) == 0)
+            { // not in cell anymore
+            cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId,
+                                          sPtr->subId, dist2);
+            }
+          newPts->SetPoint(i, closestPt);
+          }
+        }
+      }
     } //for not converged or within iteration count
+  if ( prevPts )
+    {
+    prevPts->Delete();
+    }
 
   vtkDebugMacro(<<"Performed " << iterationNumber << " smoothing passes");
   if ( source )
@@ -673,17 +907,6 @@ int vtkSmoothPolyDataFilter::RequestData(
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  //free up connectivity storage
-  for (i=0; i<numPts; i++)
-    {
-    if ( Verts[i].edges != NULL )
-      {
-      Verts[i].edges->Delete();
-      Verts[i].edges = NULL;
-      }
-    }
-  delete [] Verts;
-
   return 1;
 }
 
@@ -715,6 +938,7 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Boundary Smoothing: " << (this->BoundarySmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "Jacobi Update: " << (this->JacobiUpdate ? "On\n" : "Off\n");
   if ( this->GetSource() )
     {
       os << indent << "Source: " << static_cast<void *>(this->GetSource()) << "\n";
@@ -32,6 +32,18 @@
 // vertices is a single iteration. Many iterations (generally around 20 or
 // so) are repeated until the desired result is obtained.
 //
+// The connectivity array is stored as one compact array of vertex ids
+// with per-vertex offsets. By default, the vertices are moved in place one
+// after the other, so each vertex sees the vertices already moved during
+// the same iteration, and the output points are float. With JacobiUpdate
+// on, each iteration only reads the coordinates produced by the previous
+// one instead, so the vertices are smoothed in parallel with vtkSMPTools
+// and the result depends neither on the number of threads nor on the
+// order of the points. The result differs slightly from the default one,
+// and the coordinates are then kept in double precision if the input
+// points are double. Constraining the points to the Source surface is
+// done serially.
+//
 // There are some special instance variables used to control the execution
 // of this filter. (These ivars basically control what vertices can be
 // smoothed, and the creation of the connectivity array.) The
@@ -164,6 +176,14 @@ public:
   vtkGetMacro(GenerateErrorVectors,int);
   vtkBooleanMacro(GenerateErrorVectors,int);
 
+  // Description:
+  // Turn on/off Jacobi updates, where each iteration moves the vertices
+  // from their positions at the previous iteration, in parallel, instead
+  // of moving them in place one after the other. Off by default.
+  vtkSetMacro(JacobiUpdate,int);
+  vtkGetMacro(JacobiUpdate,int);
+  vtkBooleanMacro(JacobiUpdate,int);
+
   // Description:
   // Specify the source object which is used to constrain smoothing. The
   // source defines a surface that the input (as it is smoothed) is
@@ -187,6 +207,7 @@ protected:
   int BoundarySmoothing;
   int GenerateErrorScalars;
   int GenerateErrorVectors;
+  int JacobiUpdate;
 
   vtkSmoothPoints *SmoothPoints;
 private:
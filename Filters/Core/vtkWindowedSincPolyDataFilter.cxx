@@ -24,9 +24,13 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
 // Construct object with number of iterations 20; passband .1;
@@ -57,12 +61,241 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
 #define VTK_FEATURE_EDGE_VERTEX 2
 #define VTK_BOUNDARY_EDGE_VERTEX 3
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
-  {
-  char      type;
-  vtkIdList *edges; // connected edges (list of connected point ids)
-} vtkMeshVertex, *vtkMeshVertexPtr;
+namespace
+{
+//----------------------------------------------------------------------------
+// The vertices connected to each point (the edges), in compressed sparse row
+// layout. During the topological analysis each point fills a slot sized for
+// the largest number of vertices it may be connected to (two per use of the
+// point by a line or a polygon), so that no per-point list is allocated;
+// Reset() and InsertNextId() behave like the vtkIdList methods. Squeeze()
+// then packs the lists back to back: the vertices connected to point i are
+// Ids[Offsets[i]] to Ids[Offsets[i+1]-1].
+class vtkWindowedSincPolyDataFilterEdges
+{
+public:
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Counts;
+  std::vector<vtkIdType> Ids;
+
+  vtkWindowedSincPolyDataFilterEdges(vtkIdType numPts)
+    : Offsets(numPts+1, 0), Counts(numPts, 0) {}
+
+  // Make room for the edges of the points of a set of cells.
+  void AddCells(vtkCellArray *cells)
+    {
+    vtkIdType npts, *pts;
+    for (cells->InitTraversal(); cells->GetNextCell(npts,pts); )
+      {
+      for (vtkIdType j=0; j < npts; j++)
+        {
+        this->Offsets[pts[j]+1] += 2;
+        }
+      }
+    }
+
+  // Turn the sizes of the slots into offsets once all cells were added.
+  void Allocate()
+    {
+    for (size_t i=1; i < this->Offsets.size(); i++)
+      {
+      this->Offsets[i] += this->Offsets[i-1];
+      }
+    this->Ids.resize(this->Offsets.back());
+    }
+
+  vtkIdType GetNumberOfIds(vtkIdType ptId) const
+    {
+    return this->Counts[ptId];
+    }
+  vtkIdType GetId(vtkIdType ptId, vtkIdType i) const
+    {
+    return this->Ids[this->Offsets[ptId] + i];
+    }
+  void Reset(vtkIdType ptId)
+    {
+    this->Counts[ptId] = 0;
+    }
+  void InsertNextId(vtkIdType ptId, vtkIdType id)
+    {
+    this->Ids[this->Offsets[ptId] + this->Counts[ptId]++] = id;
+    }
+
+  void Squeeze()
+    {
+    vtkIdType numPts = static_cast<vtkIdType>(this->Counts.size());
+    std::vector<vtkIdType> ids;
+    ids.reserve(this->Offsets[numPts]);
+    for (vtkIdType i=0; i < numPts; i++)
+      {
+      std::vector<vtkIdType>::iterator first =
+        this->Ids.begin() + this->Offsets[i];
+      this->Offsets[i] = static_cast<vtkIdType>(ids.size());
+      ids.insert(ids.end(), first, first + this->Counts[i]);
+      }
+    this->Offsets[numPts] = static_cast<vtkIdType>(ids.size());
+    this->Ids.swap(ids);
+    std::vector<vtkIdType>().swap(this->Counts);
+    }
+};
+
+//----------------------------------------------------------------------------
+// One iteration of the windowed sinc smoothing, following the notation of
+// Taubin's TR: X[0], X[1], X[2] and X[3] are newPts[zero], newPts[one],
+// newPts[two] and newPts[three]. Each point only reads the previous
+// iterations, so the points are processed in parallel and the result does
+// not depend on the number of threads.
+template <class T>
+class vtkWindowedSincPolyDataFilterIteration
+{
+public:
+  const vtkIdType *Offsets;
+  const vtkIdType *Ids;
+  const char *Types;
+  T *X[4];
+  double C0;
+  double C1;
+  int First;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    if (this->First)
+      {
+      this->FirstIteration(begin, end);
+      }
+    else
+      {
+      this->NextIteration(begin, end);
+      }
+    }
+
+  // newPts[one] is half a Laplacian step from newPts[zero] and newPts[three]
+  // is c0 newPts[zero] + c1 newPts[one].
+  void FirstIteration(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i=begin; i < end; i++)
+      {
+      vtkIdType npts = this->Offsets[i+1] - this->Offsets[i];
+      const T *x0 = this->X[0] + 3*i;
+      T *x1 = this->X[1] + 3*i;
+      T *x3 = this->X[3] + 3*i;
+      if ( npts == 0 )
+        {
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian)
+        for (int k=0; k < 3; k++)
+          {
+          x1[k] = 0;
+          x3[k] = x0[k];
+          }
+        continue;
+        }
+
+      // point is allowed to move
+      const vtkIdType *ids = this->Ids + this->Offsets[i];
+      double x[3] = { x0[0], x0[1], x0[2] };
+      double deltaX[3] = { 0.0, 0.0, 0.0 };
+
+      // calculate the negative of the laplacian
+      for (vtkIdType j=0; j < npts; j++) //for all connected points
+        {
+        const T *y = this->X[0] + 3*ids[j];
+        for (int k=0; k < 3; k++)
+          {
+          deltaX[k] += (x[k] - y[k]) / npts;
+          }
+        }
+      // newPts[one] = newPts[zero] - 0.5 newPts[one]
+      for (int k=0; k < 3; k++)
+        {
+        deltaX[k] = x[k] - 0.5*deltaX[k];
+        x1[k] = static_cast<T>(deltaX[k]);
+        }
+
+      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
+      for (int k=0; k < 3; k++)
+        {
+        x3[k] = (this->Types[i] == VTK_FIXED_VERTEX ? x0[k] :
+                 static_cast<T>(this->C0*x[k] + this->C1*deltaX[k]));
+        }
+      }
+    }
+
+  // newPts[two] is the next Chebyshev term computed from newPts[zero] and
+  // newPts[one], and is added to newPts[three] with the coefficient c1.
+  void NextIteration(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i=begin; i < end; i++)
+      {
+      vtkIdType npts = this->Offsets[i+1] - this->Offsets[i];
+      T *x2 = this->X[2] + 3*i;
+      if ( npts == 0 )
+        {
+        // point is not allowed to move (zero out the Laplacian). Its
+        // newPts[one] was zeroed by the previous iteration.
+        x2[0] = x2[1] = x2[2] = 0;
+        continue;
+        }
+
+      // point is allowed to move
+      const vtkIdType *ids = this->Ids + this->Offsets[i];
+      const T *p_x0 = this->X[0] + 3*i;
+      const T *p_x1 = this->X[1] + 3*i;
+      double deltaX[3] = { 0.0, 0.0, 0.0 };
+
+      // calculate the negative laplacian of x1
+      for (vtkIdType j=0; j < npts; j++)
+        {
+        const T *y = this->X[1] + 3*ids[j];
+        for (int k=0; k < 3; k++)
+          {
+          deltaX[k] += (static_cast<double>(p_x1[k]) - y[k]) / npts;
+          }
+        }
+
+      // Taubin:  x2 = (x1 - x0) + (x1 - x2)
+      for (int k=0; k < 3; k++)
+        {
+        deltaX[k] = static_cast<double>(p_x1[k]) - p_x0[k] + p_x1[k] -
+          deltaX[k];
+        x2[k] = static_cast<T>(deltaX[k]);
+        }
+
+      // smooth the vertex (x3 = x3 + cj x2)
+      if ( this->Types[i] != VTK_FIXED_VERTEX )
+        {
+        T *x3 = this->X[3] + 3*i;
+        for (int k=0; k < 3; k++)
+          {
+          x3[k] = static_cast<T>(x3[k] + this->C1 * deltaX[k]);
+          }
+        }
+      }
+    }
+};
+
+// Run an iteration on newPts; c0 is only used by the first iteration.
+template <class T>
+void vtkWindowedSincPolyDataFilterIterate(
+  const vtkWindowedSincPolyDataFilterEdges &edges, const char *types,
+  vtkPoints *newPts[4], int zero, int one, int two, int three,
+  int first, double c0, double c1)
+{
+  vtkWindowedSincPolyDataFilterIteration<T> iteration;
+  iteration.Offsets = &edges.Offsets[0];
+  iteration.Ids = edges.Ids.empty() ? NULL : &edges.Ids[0];
+  iteration.Types = types;
+  int index[4] = { zero, one, two, three };
+  for (int k=0; k < 4; k++)
+    {
+    iteration.X[k] = static_cast<T *>(newPts[index[k]]->GetVoidPointer(0));
+    }
+  iteration.C0 = c0;
+  iteration.C1 = c1;
+  iteration.First = first;
+  vtkSMPTools::For(0, newPts[zero]->GetNumberOfPoints(), iteration);
+}
+}
 
 int vtkWindowedSincPolyDataFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -84,21 +317,19 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   vtkIdType npts = 0;
   vtkIdType *pts = 0;
   vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
   double CosEdgeAngle; // Cosine of angle between adjacent edges
   int iterationNumber, abortExecute;
   vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
-  vtkPolyData *inMesh = NULL, *Mesh;
+  vtkPolyData *inMesh = NULL, *Mesh = NULL;
   vtkPoints *inPts;
   vtkTriangleFilter *toTris=NULL;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints *newPts[4];
-  vtkMeshVertexPtr Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
 
@@ -149,61 +380,77 @@ int vtkWindowedSincPolyDataFilter::RequestData(
 // using a subset of the attached vertices.
 //
   vtkDebugMacro(<<"Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-  for (i=0; i<numPts; i++)
-    {
-    Verts[i].type = VTK_SIMPLE_VERTEX; //can smooth
-    Verts[i].edges = NULL;
-    }
+  std::vector<char> types(numPts, VTK_SIMPLE_VERTEX); //can smooth
+  vtkWindowedSincPolyDataFilterEdges edges(numPts);
 
   inPts = input->GetPoints();
 
+  inLines=input->GetLines();
+  inPolys=input->GetPolys();
+  numPolys = inPolys->GetNumberOfCells();
+  inStrips=input->GetStrips();
+  numStrips = inStrips->GetNumberOfCells();
+
+  if ( numPolys > 0 || numStrips > 0 )
+    {
+    inMesh = vtkPolyData::New();
+    inMesh->SetPoints(inPts);
+    inMesh->SetPolys(inPolys);
+    Mesh = inMesh;
+
+    if ( numStrips > 0 )
+      { // convert data to triangles
+      inMesh->SetStrips(inStrips);
+      toTris = vtkTriangleFilter::New();
+      toTris->SetInputData(inMesh);
+      toTris->Update();
+      Mesh = toTris->GetOutput();
+      }
+    edges.AddCells(Mesh->GetPolys());
+    }
+  edges.AddCells(inLines);
+  edges.Allocate();
+
   // check vertices first. Vertices are never smoothed_--------------
   for (inVerts=input->GetVerts(), inVerts->InitTraversal();
   inVerts->GetNextCell(npts,pts); )
     {
     for (j=0; j<npts; j++)
       {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      types[pts[j]] = VTK_FIXED_VERTEX;
       }
     }
 
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines=input->GetLines(), inLines->InitTraversal();
-  inLines->GetNextCell(npts,pts); )
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
     {
     for (j=0; j<npts; j++)
       {
-      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+      if ( types[pts[j]] == VTK_SIMPLE_VERTEX )
         {
         if ( j == (npts-1) ) //end-of-line marked FIXED
           {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
+          types[pts[j]] = VTK_FIXED_VERTEX;
           }
         else if ( j == 0 ) //beginning-of-line marked FIXED
           {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          inPts->GetPoint(pts[0],x2);
-          inPts->GetPoint(pts[1],x3);
+          types[pts[0]] = VTK_FIXED_VERTEX;
           }
         else //is edge vertex (unless already edge vertex!)
           {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          //Verts[pts[j]].edges = new vtkIdList(2,2);
-          Verts[pts[j]].edges->SetId(0,pts[j-1]);
-          Verts[pts[j]].edges->SetId(1,pts[j+1]);
+          types[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          edges.Reset(pts[j]);
+          edges.InsertNextId(pts[j],pts[j-1]);
+          edges.InsertNextId(pts[j],pts[j+1]);
           }
         } //if simple vertex
 
-      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX )
+      else if ( types[pts[j]] == VTK_FEATURE_EDGE_VERTEX )
         { //multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = NULL;
+        types[pts[j]] = VTK_FIXED_VERTEX;
+        edges.Reset(pts[j]);
         }
 
       } //for all points in this line
@@ -212,12 +459,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   this->UpdateProgress(0.25);
 
   // now polygons and triangle strips-------------------------------
-  inPolys=input->GetPolys();
-  numPolys = inPolys->GetNumberOfCells();
-  inStrips=input->GetStrips();
-  numStrips = inStrips->GetNumberOfCells();
-
-  if ( numPolys > 0 || numStrips > 0 )
+  if ( Mesh )
     { //build cell structure
     vtkCellArray *polys;
     vtkIdType cellId;
@@ -226,25 +468,16 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     vtkIdType *neiPts;
     double normal[3], neiNormal[3];
     vtkIdList *neighbors;
+    vtkStaticCellLinks *links;
 
-    inMesh = vtkPolyData::New();
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
     neighbors = vtkIdList::New();
     neighbors->Allocate(VTK_CELL_SIZE);
 
-    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
-      { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris = vtkTriangleFilter::New();
-      toTris->SetInputData(inMesh);
-      toTris->Update();
-      Mesh = toTris->GetOutput();
-      }
-
-    Mesh->BuildLinks(); //to do neighborhood searching
+    //to do neighborhood searching
     polys = Mesh->GetPolys();
+    links = vtkStaticCellLinks::New();
+    links->BuildLinks(Mesh->GetNumberOfPoints(), polys);
+    Mesh->BuildCells();
 
     for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
          cellId++)
@@ -254,20 +487,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(
         p1 = pts[i];
         p2 = pts[(i+1)%npts];
 
-        if ( Verts[p1].edges == NULL )
-          {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16,6);
-          // Verts[p1].edges = new vtkIdList(6,6);
-          }
-        if ( Verts[p2].edges == NULL )
-          {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16,6);
-          // Verts[p2].edges = new vtkIdList(6,6);
-          }
-
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
+        links->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
         numNei = neighbors->GetNumberOfIds();
 
         edge = VTK_SIMPLE_VERTEX;
@@ -315,47 +535,48 @@ int vtkWindowedSincPolyDataFilter::RequestData(
           continue;
           }
 
-        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
+        if ( edge && types[p1] == VTK_SIMPLE_VERTEX )
           {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
+          edges.Reset(p1);
+          edges.InsertNextId(p1,p2);
+          types[p1] = edge;
           }
-        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
+        else if ( (edge && types[p1] == VTK_BOUNDARY_EDGE_VERTEX) ||
+        (edge && types[p1] == VTK_FEATURE_EDGE_VERTEX) ||
+        (!edge && types[p1] == VTK_SIMPLE_VERTEX ) )
           {
-          Verts[p1].edges->InsertNextId(p2);
-          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
+          edges.InsertNextId(p1,p2);
+          if ( types[p1] && edge == VTK_BOUNDARY_EDGE_VERTEX )
             {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
+            types[p1] = VTK_BOUNDARY_EDGE_VERTEX;
             }
           }
 
-        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
+        if ( edge && types[p2] == VTK_SIMPLE_VERTEX )
           {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
+          edges.Reset(p2);
+          edges.InsertNextId(p2,p1);
+          types[p2] = edge;
           }
-        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
-        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
+        else if ( (edge && types[p2] == VTK_BOUNDARY_EDGE_VERTEX ) ||
+        (edge && types[p2] == VTK_FEATURE_EDGE_VERTEX) ||
+        (!edge && types[p2] == VTK_SIMPLE_VERTEX ) )
           {
-          Verts[p2].edges->InsertNextId(p1);
-          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
+          edges.InsertNextId(p2,p1);
+          if ( types[p2] && edge == VTK_BOUNDARY_EDGE_VERTEX )
             {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
+            types[p2] = VTK_BOUNDARY_EDGE_VERTEX;
             }
           }
         }
       }
 
-    //    delete inMesh; // delete this later, windowed sinc smoothing needs it
+    inMesh->Delete();
     if (toTris)
       {
       toTris->Delete();
       }
+    links->Delete();
     neighbors->Delete();
     }//if strips or polys
 
@@ -364,39 +585,39 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
     {
-    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
+    if ( types[i] == VTK_SIMPLE_VERTEX )
       {
       numSimple++;
       }
 
-    else if ( Verts[i].type == VTK_FIXED_VERTEX )
+    else if ( types[i] == VTK_FIXED_VERTEX )
       {
       numFixed++;
       }
 
-    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
-    Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+    else if ( types[i] == VTK_FEATURE_EDGE_VERTEX ||
+    types[i] == VTK_BOUNDARY_EDGE_VERTEX )
       { //see how many edges; if two, what the angle is
 
       if ( !this->BoundarySmoothing &&
-      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+      types[i] == VTK_BOUNDARY_EDGE_VERTEX )
         {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        types[i] = VTK_FIXED_VERTEX;
         numBEdges++;
         }
 
-      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
+      else if ( (npts = edges.GetNumberOfIds(i)) != 2 )
         {
         // can only smooth edges on 2-manifold surfaces
-        Verts[i].type = VTK_FIXED_VERTEX;
+        types[i] = VTK_FIXED_VERTEX;
         numFixed++;
         }
 
       else //check angle between edges
         {
-        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
+        inPts->GetPoint(edges.GetId(i,0),x1);
         inPts->GetPoint(i,x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
+        inPts->GetPoint(edges.GetId(i,1),x3);
 
         for (k=0; k<3; k++)
           {
@@ -407,11 +628,11 @@ int vtkWindowedSincPolyDataFilter::RequestData(
             && (vtkMath::Dot(l1,l2) < CosEdgeAngle))
           {
           numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
+          types[i] = VTK_FIXED_VERTEX;
           }
         else
           {
-          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
+          if ( types[i] == VTK_FEATURE_EDGE_VERTEX )
             {
             numFEdges++;
             }
@@ -424,6 +645,9 @@ int vtkWindowedSincPolyDataFilter::RequestData(
       }//if edge vertex
     }//for all points
 
+  // pack the connected vertices for the smoothing iterations
+  edges.Squeeze();
+
   vtkDebugMacro(<<"Found\n\t" << numSimple << " simple vertices\n\t"
                 << numFEdges << " feature edge vertices\n\t"
                 << numBEdges << " boundary edge vertices\n\t"
@@ -433,17 +657,18 @@ int vtkWindowedSincPolyDataFilter::RequestData(
 //
   vtkDebugMacro(<<"Beginning smoothing iterations...");
 
-  // need 4 vectors of points
+  // need 4 vectors of points, in double precision if the input points are
   zero=0; one=1; two=2; three=3;
 
-  newPts[0] = vtkPoints::New();
-  newPts[0]->SetNumberOfPoints(numPts);
-  newPts[1] = vtkPoints::New();
-  newPts[1]->SetNumberOfPoints(numPts);
-  newPts[2] = vtkPoints::New();
-  newPts[2]->SetNumberOfPoints(numPts);
-  newPts[3] = vtkPoints::New();
-  newPts[3]->SetNumberOfPoints(numPts);
+  for (i=0; i<4; i++)
+    {
+    newPts[i] = vtkPoints::New();
+    if ( inPts->GetDataType() == VTK_DOUBLE )
+      {
+      newPts[i]->SetDataTypeToDouble();
+      }
+    newPts[i]->SetNumberOfPoints(numPts);
+    }
 
   // Get the center and length of the input dataset
   double *inCenter = input->GetCenter();
@@ -451,10 +676,8 @@ int vtkWindowedSincPolyDataFilter::RequestData(
 
   if (!this->NormalizeCoordinates)
     {
-    for (i=0; i<numPts; i++) //initialize to old coordinates
-      {
-      newPts[zero]->SetPoint(i,inPts->GetPoint(i));
-      }
+    //initialize to old coordinates
+    newPts[zero]->GetData()->DeepCopy(inPts->GetData());
     }
   else
     {
@@ -490,9 +713,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   c = new double[this->NumberOfIterations+1];
   cprime = new double[this->NumberOfIterations+1];
 
-  double zerovector[3];
-  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;
-
   //
   // Calculate the weights and the Chebychev coefficients c.
   //
@@ -579,53 +799,16 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     }
 
   // first iteration
-  for (i=0; i<numPts; i++)
+  if ( newPts[zero]->GetDataType() == VTK_DOUBLE )
     {
-    if ( Verts[i].edges != NULL &&
-         (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-      {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); //use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-      // calculate the negative of the laplacian
-      for (j=0; j<npts; j++) //for all connected points
-        {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k=0; k<3; k++)
-          {
-          deltaX[k] += (x[k] - y[k]) / npts;
-          }
-        }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k=0; k<3; k++)
-        {
-        deltaX[k] = x[k] - 0.5*deltaX[k];
-        }
-      newPts[one]->SetPoint(i, deltaX);
-
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k=0; k < 3; k++)
-        {
-        deltaX[k] = c[0]*x[k] + c[1]*deltaX[k];
-        }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-        {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-        }
-      else
-        {
-        newPts[three]->SetPoint(i, deltaX);
-        }
-      }//if can move point
-    else
-      {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
-    }//for all points
+    vtkWindowedSincPolyDataFilterIterate<double>(
+      edges, &types[0], newPts, zero, one, two, three, 1, c[0], c[1]);
+    }
+  else
+    {
+    vtkWindowedSincPolyDataFilterIterate<float>(
+      edges, &types[0], newPts, zero, one, two, three, 1, c[0], c[1]);
+    }
 
   // for the rest of the iterations
   for ( iterationNumber=2, abortExecute=0;
@@ -642,53 +825,18 @@ int vtkWindowedSincPolyDataFilter::RequestData(
         }
       }
 
-    for (i=0; i<numPts; i++)
+    if ( newPts[zero]->GetDataType() == VTK_DOUBLE )
       {
-      if ( Verts[i].edges != NULL &&
-           (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-        {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); //use current points
-        newPts[one]->GetPoint(i, p_x1);
-
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-        // calculate the negative laplacian of x1
-        for (j=0; j<npts; j++)
-          {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k=0; k<3; k++)
-            {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
-            }
-          }//for all connected points
-
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k=0; k<3; k++)
-          {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
-          }
-        newPts[two]->SetPoint(i, deltaX);
-
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k=0;k<3;k++)
-          {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-          }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
-          {
-          newPts[three]->SetPoint(i,xNew);
-          }
-        }//if can move point
-      else
-        {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-        }
-      }//for all points
+      vtkWindowedSincPolyDataFilterIterate<double>(
+        edges, &types[0], newPts, zero, one, two, three, 0, 0.0,
+        c[iterationNumber]);
+      }
+    else
+      {
+      vtkWindowedSincPolyDataFilterIterate<float>(
+        edges, &types[0], newPts, zero, one, two, three, 0, 0.0,
+        c[iterationNumber]);
+      }
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -780,16 +928,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // finally delete the constructed (local) mesh
-  inMesh->Delete();
-
-  //free up connectivity storage
-  for (i=0; i<numPts; i++)
-    {
-    if ( Verts[i].edges != NULL ) {Verts[i].edges->Delete();}
-    }
-  delete [] Verts;
-
   return 1;
 }
 
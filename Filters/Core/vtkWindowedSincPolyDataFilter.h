@@ -123,6 +123,13 @@
 // ivar GenerateErrorVectors is on, then a vector representing change in
 // position is computed.
 //
+// The connectivity array is stored as one compact array of vertex ids with
+// per-vertex offsets, and each iteration applies the next Chebyshev term to
+// all vertices in parallel with vtkSMPTools. Since an iteration only reads
+// the terms computed by the previous ones, the result does not depend on
+// the number of threads. The coordinates are kept in double precision if
+// the input points are double, and in float otherwise.
+//
 // .SECTION Caveats
 // The smoothing operation reduces high frequency information in the
 // geometry of the mesh. With excessive smoothing important details may be
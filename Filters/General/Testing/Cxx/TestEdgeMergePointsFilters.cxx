@@ -0,0 +1,248 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEdgeMergePointsFilters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that contouring, cutting and clipping filters produce the
+// same output with vtkEdgeMergePoints as with the default vtkMergePoints.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkClipDataSet.h"
+#include "vtkContourGrid.h"
+#include "vtkCutter.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkEdgeMergePoints.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+// A grid of res^3 hexahedra with random scalars and vectors. The string
+// array keeps vtkContourGrid from delegating to vtkContour3DLinearGrid.
+void MakeGrid(int res, vtkUnstructuredGrid *grid)
+{
+  int dim = res + 1;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  for (int k = 0; k < dim; k++)
+    {
+    for (int j = 0; j < dim; j++)
+      {
+      for (int i = 0; i < dim; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        scalars->InsertNextValue(vtkMath::Random(0.0, 1.0));
+        vectors->InsertNextTuple3(i + j, j * k, vtkMath::Random());
+        names->InsertNextValue("point");
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(scalars.GetPointer());
+  grid->GetPointData()->AddArray(vectors.GetPointer());
+  grid->GetPointData()->AddArray(names.GetPointer());
+
+  grid->Allocate(res * res * res);
+  for (int k = 0; k < res; k++)
+    {
+    for (int j = 0; j < res; j++)
+      {
+      for (int i = 0; i < res; i++)
+        {
+        vtkIdType p = i + dim * (j + dim * k);
+        vtkIdType hex[8] = {p, p + 1, p + 1 + dim, p + dim,
+                            p + dim * dim, p + 1 + dim * dim,
+                            p + 1 + dim + dim * dim, p + dim + dim * dim};
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+      }
+    }
+}
+
+// A grid of res^2 quadratic quads in the z = 0 plane, whose subdivision
+// is contoured and clipped in terms of local point ids.
+void MakeQuadraticGrid(int res, vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkUnstructuredGrid> hexahedra;
+  MakeGrid(2 * res, hexahedra.GetPointer());
+  grid->SetPoints(hexahedra->GetPoints());
+  grid->GetPointData()->ShallowCopy(hexahedra->GetPointData());
+
+  int dim = 2 * res + 1;
+  grid->Allocate(res * res);
+  for (int j = 0; j < res; j++)
+    {
+    for (int i = 0; i < res; i++)
+      {
+      vtkIdType p = 2 * i + dim * 2 * j;
+      vtkIdType quad[8] = {p, p + 2, p + 2 + 2 * dim, p + 2 * dim,
+                           p + 1, p + 2 + dim, p + 1 + 2 * dim, p + dim};
+      grid->InsertNextCell(VTK_QUADRATIC_QUAD, 8, quad);
+      }
+    }
+}
+
+bool SameArrays(vtkDataArray *a1, vtkDataArray *a2)
+{
+  if (!a1 || !a2 ||
+      a1->GetNumberOfTuples() != a2->GetNumberOfTuples() ||
+      a1->GetNumberOfComponents() != a2->GetNumberOfComponents())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a1->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < a1->GetNumberOfComponents(); c++)
+      {
+      if (a1->GetComponent(i, c) != a2->GetComponent(i, c))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SameCells(vtkCellArray *c1, vtkCellArray *c2)
+{
+  return c1->GetNumberOfCells() == c2->GetNumberOfCells() &&
+    SameArrays(c1->GetData(), c2->GetData());
+}
+
+// Same points, point data and cells.
+bool SameOutput(const char *name, vtkPointSet *o1, vtkPointSet *o2)
+{
+  bool same = o1->GetNumberOfPoints() > 0 &&
+    SameArrays(o1->GetPoints()->GetData(), o2->GetPoints()->GetData()) &&
+    SameArrays(o1->GetPointData()->GetArray("Scalars"),
+               o2->GetPointData()->GetArray("Scalars")) &&
+    SameArrays(o1->GetPointData()->GetArray("Vectors"),
+               o2->GetPointData()->GetArray("Vectors"));
+  vtkPolyData *pd1 = vtkPolyData::SafeDownCast(o1);
+  vtkPolyData *pd2 = vtkPolyData::SafeDownCast(o2);
+  vtkUnstructuredGrid *ug1 = vtkUnstructuredGrid::SafeDownCast(o1);
+  vtkUnstructuredGrid *ug2 = vtkUnstructuredGrid::SafeDownCast(o2);
+  if (pd1 && pd2)
+    {
+    same = same && SameCells(pd1->GetLines(), pd2->GetLines()) &&
+      SameCells(pd1->GetPolys(), pd2->GetPolys());
+    }
+  else if (ug1 && ug2)
+    {
+    same = same && SameCells(ug1->GetCells(), ug2->GetCells());
+    }
+  else
+    {
+    same = false;
+    }
+  if (!same)
+    {
+    cerr << name << ": the outputs differ with vtkEdgeMergePoints" << endl;
+    }
+  return same;
+}
+
+bool TestFilters(vtkUnstructuredGrid *grid)
+{
+  bool success = true;
+
+  // Several contour values, so that several points lie on the same edges.
+  vtkNew<vtkContourGrid> contour1;
+  vtkNew<vtkContourGrid> contour2;
+  vtkContourGrid *contours[2] = {contour1.GetPointer(), contour2.GetPointer()};
+  for (int i = 0; i < 2; i++)
+    {
+    contours[i]->SetInputData(grid);
+    contours[i]->GenerateValues(3, 0.25, 0.75);
+    contours[i]->ComputeScalarsOn();
+    }
+  vtkNew<vtkEdgeMergePoints> locator1;
+  contour2->SetLocator(locator1.GetPointer());
+  contour1->Update();
+  contour2->Update();
+  success &= SameOutput("vtkContourGrid",
+                        contour1->GetOutput(), contour2->GetOutput());
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(1.5, 1.5, 1.5);
+  plane->SetNormal(1.0, 2.0, 3.0);
+  vtkNew<vtkCutter> cutter1;
+  vtkNew<vtkCutter> cutter2;
+  vtkCutter *cutters[2] = {cutter1.GetPointer(), cutter2.GetPointer()};
+  for (int i = 0; i < 2; i++)
+    {
+    cutters[i]->SetInputData(grid);
+    cutters[i]->SetCutFunction(plane.GetPointer());
+    cutters[i]->GenerateValues(4, -2.0, 2.0);
+    }
+  vtkNew<vtkEdgeMergePoints> locator2;
+  cutter2->SetLocator(locator2.GetPointer());
+  cutter1->Update();
+  cutter2->Update();
+  success &= SameOutput("vtkCutter",
+                        cutter1->GetOutput(), cutter2->GetOutput());
+
+  vtkNew<vtkClipDataSet> clip1;
+  vtkNew<vtkClipDataSet> clip2;
+  vtkClipDataSet *clips[2] = {clip1.GetPointer(), clip2.GetPointer()};
+  for (int i = 0; i < 2; i++)
+    {
+    clips[i]->SetInputData(grid);
+    clips[i]->SetValue(0.5);
+    }
+  vtkNew<vtkEdgeMergePoints> locator3;
+  clip2->SetLocator(locator3.GetPointer());
+  clip1->Update();
+  clip2->Update();
+  success &= SameOutput("vtkClipDataSet",
+                        clip1->GetOutput(), clip2->GetOutput());
+
+  return success;
+}
+}
+
+int TestEdgeMergePointsFilters(int, char *[])
+{
+  vtkMath::RandomSeed(4321);
+  vtkNew<vtkUnstructuredGrid> hexahedra;
+  MakeGrid(6, hexahedra.GetPointer());
+
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(hexahedra.GetPointer());
+  tetrahedralize->Update();
+
+  vtkNew<vtkUnstructuredGrid> quads;
+  MakeQuadraticGrid(4, quads.GetPointer());
+
+  if (!TestFilters(hexahedra.GetPointer()) ||
+      !TestFilters(tetrahedralize->GetOutput()) ||
+      !TestFilters(quads.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
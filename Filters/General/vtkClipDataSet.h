@@ -140,6 +140,8 @@ public:
   // Description:
   // Specify a spatial locator for merging points. By default, an
   // instance of vtkMergePoints is used.
+  // vtkEdgeMergePoints merges the points by the input edge they lie on
+  // instead of by their coordinates.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -24,7 +24,9 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkStructuredGrid.h"
+#include "vtkStructuredPointArray.h"
 
 #include "vtkNew.h"
 
@@ -71,36 +73,12 @@ int vtkImageDataToPointSet::CopyStructure(vtkStructuredGrid *outData,
 
   outData->SetExtent(extent);
 
-  vtkNew<vtkPoints> points;
-  points->SetDataTypeToDouble();
-  points->SetNumberOfPoints(inData->GetNumberOfPoints());
-
-  vtkIdType pointId = 0;
-  int ijk[3];
-  for (ijk[2] = extent[4]; ijk[2] <= extent[5]; ijk[2]++)
-    {
-    for (ijk[1] = extent[2]; ijk[1] <= extent[3]; ijk[1]++)
-      {
-      for (ijk[0] = extent[0]; ijk[0] <= extent[1]; ijk[0]++)
-        {
-        double coord[3];
-
-        for (int axis = 0; axis < 3; axis++)
-          {
-          coord[axis] = origin[axis] + spacing[axis]*ijk[axis];
-          }
-
-        points->SetPoint(pointId, coord);
-        pointId++;
-        }
-      }
-    }
+  // The points are computed from the geometry of the image, not stored.
+  vtkNew<vtkStructuredPointArray<double> > coordinates;
+  coordinates->SetImage(origin, spacing, extent);
 
-  if (pointId != points->GetNumberOfPoints())
-    {
-    vtkErrorMacro(<< "Somehow misscounted points");
-    return 0;
-    }
+  vtkNew<vtkPoints> points;
+  points->SetData(coordinates.GetPointer());
 
   outData->SetPoints(points.GetPointer());
 
@@ -220,8 +220,11 @@ int vtkImageMarchingCubes::RequestData(
       }
     this->InvokeEvent(vtkCommand::EndEvent,NULL);
 
-    if (vtkDataObject::GetGlobalReleaseDataFlag() ||
-        inInfo->Has(vtkStreamingDemandDrivenPipeline::RELEASE_DATA()))
+    vtkDemandDrivenPipeline* executive =
+      vtkDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+    if (executive ? executive->NeedToReleaseInputData(inInfo) :
+        (vtkDataObject::GetGlobalReleaseDataFlag() ||
+         inInfo->Has(vtkStreamingDemandDrivenPipeline::RELEASE_DATA())))
       {
       inData->ReleaseData();
       }
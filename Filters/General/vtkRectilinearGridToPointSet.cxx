@@ -25,6 +25,7 @@
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkStructuredGrid.h"
+#include "vtkStructuredPointArray.h"
 
 #include "vtkNew.h"
 
@@ -69,34 +70,12 @@ int vtkRectilinearGridToPointSet::CopyStructure(vtkStructuredGrid *outData,
 
   outData->SetExtent(extent);
 
-  vtkNew<vtkPoints> points;
-  points->SetDataTypeToDouble();
-  points->SetNumberOfPoints(inData->GetNumberOfPoints());
-
-  vtkIdType pointId = 0;
-  int ijk[3];
-  for (ijk[2] = extent[4]; ijk[2] <= extent[5]; ijk[2]++)
-    {
-    for (ijk[1] = extent[2]; ijk[1] <= extent[3]; ijk[1]++)
-      {
-      for (ijk[0] = extent[0]; ijk[0] <= extent[1]; ijk[0]++)
-        {
-        double coord[3];
-        coord[0] = xcoord->GetComponent(ijk[0]-extent[0], 0);
-        coord[1] = ycoord->GetComponent(ijk[1]-extent[2], 0);
-        coord[2] = zcoord->GetComponent(ijk[2]-extent[4], 0);
-
-        points->SetPoint(pointId, coord);
-        pointId++;
-        }
-      }
-    }
+  // The points are computed from the coordinates of the grid, not stored.
+  vtkNew<vtkStructuredPointArray<double> > coordinates;
+  coordinates->SetRectilinear(xcoord, ycoord, zcoord);
 
-  if (pointId != points->GetNumberOfPoints())
-    {
-    vtkErrorMacro(<< "Somehow misscounted points");
-    return 0;
-    }
+  vtkNew<vtkPoints> points;
+  points->SetData(coordinates.GetPointer());
 
   outData->SetPoints(points.GetPointer());
 
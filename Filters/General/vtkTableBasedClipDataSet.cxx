@@ -2029,6 +2029,10 @@ void vtkTableBasedClipDataSet::ClipDataSet( vtkDataSet * pDataSet,
   clipData->SetClipFunction( this->ClipFunction );
   clipData->SetUseValueAsOffset( this->UseValueAsOffset );
   clipData->SetGenerateClipScalars( this->GenerateClipScalars );
+  if ( this->Locator )
+    {
+    clipData->SetLocator( this->Locator );
+    }
 
   if ( !this->ClipFunction )
     {
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageEuclideanDistanceLinear.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the linear algorithm of vtkImageEuclideanDistance with the
+// Saito algorithm and with a brute force search, including the signed
+// distances and the ids of the nearest features.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Make a mask with the given fraction of zero voxels.
+void MakeMask(vtkImageData *image, const int dims[3], double fraction,
+              vtkMinimalStandardRandomSequence *random)
+{
+  image->SetDimensions(const_cast<int *>(dims));
+  image->AllocateScalars(VTK_SHORT, 1);
+  short *ptr = static_cast<short *>(image->GetScalarPointer());
+  vtkIdType n = image->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    ptr[i] = (random->GetValue() < fraction ? 0 : 1);
+    random->Next();
+    }
+}
+
+// The squared distance between two points of the image.
+double Distance2(vtkImageData *image, vtkIdType i, vtkIdType j)
+{
+  double p[3];
+  double q[3];
+  image->GetPoint(i, p);
+  image->GetPoint(j, q);
+  return ((p[0] - q[0])*(p[0] - q[0]) + (p[1] - q[1])*(p[1] - q[1]) +
+          (p[2] - q[2])*(p[2] - q[2]));
+}
+}
+
+int TestImageEuclideanDistanceLinear(int, char *[])
+{
+  int rval = 0;
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  static const int dims[4][3] = {
+    { 12, 10, 9 }, { 31, 1, 1 }, { 1, 17, 6 }, { 40, 33, 1 }
+  };
+  static const double fractions[3] = { 0.002, 0.05, 0.4 };
+
+  for (int d = 0; d < 4; d++)
+    {
+    for (int f = 0; f < 3; f++)
+      {
+      vtkNew<vtkImageData> image;
+      MakeMask(image.GetPointer(), dims[d], fractions[f], random.GetPointer());
+      vtkIdType n = image->GetNumberOfPoints();
+      short *mask = static_cast<short *>(image->GetScalarPointer());
+
+      // with isotropic spacing, the result must be the same as Saito's
+      vtkNew<vtkImageEuclideanDistance> saito;
+      saito->SetInputData(image.GetPointer());
+      saito->SetAlgorithmToSaito();
+      saito->Update();
+
+      vtkNew<vtkImageEuclideanDistance> linear;
+      linear->SetInputData(image.GetPointer());
+      linear->SetAlgorithmToLinear();
+      linear->Update();
+
+      double *expected =
+        static_cast<double *>(saito->GetOutput()->GetScalarPointer());
+      double *values =
+        static_cast<double *>(linear->GetOutput()->GetScalarPointer());
+      for (vtkIdType i = 0; i < n; i++)
+        {
+        if (values[i] != expected[i])
+          {
+          cerr << "Linear and Saito differ for mask " << d << ", " << f
+               << " at point " << i << ": " << values[i] << " instead of "
+               << expected[i] << endl;
+          rval = 1;
+          break;
+          }
+        }
+
+      // with anisotropic spacing, compare with a brute force search
+      image->SetSpacing(0.7, 1.3, 2.1);
+      linear->SignedDistanceOn();
+      linear->ComputeFeatureIdsOn();
+      linear->Update();
+      vtkImageData *output = linear->GetOutput();
+      values = static_cast<double *>(output->GetScalarPointer());
+      vtkIdTypeArray *ids = vtkIdTypeArray::SafeDownCast(
+        output->GetPointData()->GetArray("FeatureIds"));
+      if (ids == 0 || ids->GetNumberOfTuples() != n)
+        {
+        cerr << "No feature ids for mask " << d << ", " << f << endl;
+        rval = 1;
+        continue;
+        }
+
+      for (vtkIdType i = 0; i < n; i++)
+        {
+        // the distance to the nearest voxel on the other side of the mask
+        double best = VTK_DOUBLE_MAX;
+        for (vtkIdType j = 0; j < n; j++)
+          {
+          if ((mask[j] == 0) != (mask[i] == 0))
+            {
+            best = std::min(best, Distance2(image.GetPointer(), i, j));
+            }
+          }
+        if (best == VTK_DOUBLE_MAX)
+          {
+          // no voxels on the other side
+          continue;
+          }
+        best = (mask[i] == 0 ? -best : best);
+
+        vtkIdType id = ids->GetValue(i);
+        if (fabs(values[i] - best) > 1e-9*fabs(best) ||
+            id < 0 || id >= n || (mask[id] == 0) == (mask[i] == 0) ||
+            fabs(Distance2(image.GetPointer(), i, id) - fabs(best)) >
+            1e-9*fabs(best))
+          {
+          cerr << "Wrong signed distance for mask " << d << ", " << f
+               << " at point " << i << ": " << values[i] << " with id "
+               << id << " instead of " << best << endl;
+          rval = 1;
+          break;
+          }
+        }
+      }
+    }
+
+  return rval;
+}
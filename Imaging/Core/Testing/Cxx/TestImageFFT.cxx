@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageFFT.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare vtkImageFFT with a direct evaluation of the discrete Fourier
+// transform, for sizes that use each kind of factor, and check that
+// vtkImageRFFT gives back the original image.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRFFT.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// The value of the image at a point, for real or complex images.
+double ImageValue(int x, int y, int c)
+{
+  return (c == 0 ? ((x*7 + y*13) % 11) - 3.0 : ((x*5 + y*3) % 7) - 2.0);
+}
+
+// The discrete Fourier transform of the image at (u, v).
+void DirectTransform(int ext[6], int nc, int u, int v, double result[2])
+{
+  int nx = ext[1] - ext[0] + 1;
+  int ny = ext[3] - ext[2] + 1;
+  result[0] = 0.0;
+  result[1] = 0.0;
+  for (int y = 0; y < ny; y++)
+    {
+    for (int x = 0; x < nx; x++)
+      {
+      double phase = -2.0*vtkMath::Pi()*(static_cast<double>(u)*x/nx +
+                                         static_cast<double>(v)*y/ny);
+      double re = ImageValue(x + ext[0], y + ext[2], 0);
+      double im = (nc > 1 ? ImageValue(x + ext[0], y + ext[2], 1) : 0.0);
+      result[0] += re*cos(phase) - im*sin(phase);
+      result[1] += re*sin(phase) + im*cos(phase);
+      }
+    }
+}
+}
+
+int TestImageFFT(int, char *[])
+{
+  int rval = 0;
+
+  // powers of two, mixed factors, small primes and large primes
+  static const int sizes[6][2] = {
+    { 16, 8 }, { 12, 30 }, { 7, 1 }, { 17, 13 }, { 67, 10 }, { 1, 29 }
+  };
+
+  for (int s = 0; s < 6; s++)
+    {
+    for (int nc = 1; nc <= 2; nc++)
+      {
+      int ext[6] = { -2, sizes[s][0] - 3, 3, sizes[s][1] + 2, 0, 0 };
+      vtkNew<vtkImageData> image;
+      image->SetExtent(ext);
+      image->AllocateScalars(VTK_FLOAT, nc);
+      vtkDataArray *scalars = image->GetPointData()->GetScalars();
+      vtkIdType i = 0;
+      for (int y = ext[2]; y <= ext[3]; y++)
+        {
+        for (int x = ext[0]; x <= ext[1]; x++)
+          {
+          for (int c = 0; c < nc; c++)
+            {
+            scalars->SetComponent(i, c, ImageValue(x, y, c));
+            }
+          i++;
+          }
+        }
+
+      vtkNew<vtkImageFFT> fft;
+      fft->SetDimensionality(2);
+      fft->SetInputData(image.GetPointer());
+      fft->Update();
+      vtkImageData *output = fft->GetOutput();
+
+      double maxDiff = 0.0;
+      for (int v = 0; v < sizes[s][1]; v++)
+        {
+        for (int u = 0; u < sizes[s][0]; u++)
+          {
+          double expected[2];
+          DirectTransform(ext, nc, u, v, expected);
+          for (int c = 0; c < 2; c++)
+            {
+            double value = output->GetScalarComponentAsDouble(
+              u + ext[0], v + ext[2], 0, c);
+            maxDiff = std::max(maxDiff, fabs(value - expected[c]));
+            }
+          }
+        }
+      if (maxDiff > 1e-9)
+        {
+        cerr << "FFT of size " << sizes[s][0] << "x" << sizes[s][1]
+             << " with " << nc << " components is off by " << maxDiff
+             << endl;
+        rval = 1;
+        }
+
+      // the reverse transform must give back the image
+      vtkNew<vtkImageRFFT> rfft;
+      rfft->SetDimensionality(2);
+      rfft->SetInputConnection(fft->GetOutputPort());
+      rfft->Update();
+      output = rfft->GetOutput();
+      maxDiff = 0.0;
+      for (int y = ext[2]; y <= ext[3]; y++)
+        {
+        for (int x = ext[0]; x <= ext[1]; x++)
+          {
+          for (int c = 0; c < 2; c++)
+            {
+            double expected = (c < nc ? ImageValue(x, y, c) : 0.0);
+            double value = output->GetScalarComponentAsDouble(x, y, 0, c);
+            maxDiff = std::max(maxDiff, fabs(value - expected));
+            }
+          }
+        }
+      if (maxDiff > 1e-12)
+        {
+        cerr << "RFFT of size " << sizes[s][0] << "x" << sizes[s][1]
+             << " with " << nc << " components is off by " << maxDiff
+             << endl;
+        rval = 1;
+        }
+
+      // a part of the transform must match the whole transform
+      vtkNew<vtkImageData> whole;
+      whole->DeepCopy(fft->GetOutput());
+      int subExt[6] = { ext[0] + sizes[s][0]/3, ext[1], ext[2],
+                        ext[3] - sizes[s][1]/2, 0, 0 };
+      fft->Modified();
+      fft->UpdateInformation();
+      vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+        fft->GetOutputInformation(0), subExt);
+      fft->Update();
+      output = fft->GetOutput();
+      int *outExt = output->GetExtent();
+      if (!std::equal(subExt, subExt + 6, outExt))
+        {
+        cerr << "Wrong output extent" << endl;
+        rval = 1;
+        continue;
+        }
+      bool same = true;
+      for (int y = subExt[2]; same && y <= subExt[3]; y++)
+        {
+        for (int x = subExt[0]; same && x <= subExt[1]; x++)
+          {
+          for (int c = 0; c < 2; c++)
+            {
+            same &= (output->GetScalarComponentAsDouble(x, y, 0, c) ==
+                     whole->GetScalarComponentAsDouble(x, y, 0, c));
+            }
+          }
+        }
+      if (!same)
+        {
+        cerr << "Wrong value for part of the extent" << endl;
+        rval = 1;
+        }
+      }
+    }
+
+  return rval;
+}
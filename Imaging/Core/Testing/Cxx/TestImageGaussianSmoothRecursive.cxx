@@ -0,0 +1,200 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageGaussianSmoothRecursive.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the recursive mode of vtkImageGaussianSmooth with the FIR mode,
+// for smoothing and for the derivatives of the gaussian.
+
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkNew.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Fill an image with a function of the position.
+void MakeImage(vtkImageData *image, int ext[6], int function)
+{
+  image->SetExtent(ext);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  for (int z = ext[4]; z <= ext[5]; z++)
+    {
+    for (int y = ext[2]; y <= ext[3]; y++)
+      {
+      for (int x = ext[0]; x <= ext[1]; x++)
+        {
+        float *ptr = static_cast<float *>(image->GetScalarPointer(x, y, z));
+        switch (function)
+          {
+          case 0:
+            *ptr = static_cast<float>(
+              100.0*sin(x/7.0)*cos(y/9.0) + 50.0*cos((x + z)/11.0));
+            break;
+          case 1:
+            *ptr = static_cast<float>(2.0*x + 3.0*y);
+            break;
+          case 2:
+            *ptr = static_cast<float>(0.5*x*x);
+            break;
+          }
+        }
+      }
+    }
+}
+
+// Return the largest difference between two images within a margin of
+// their boundaries, and the largest value in the first image.
+double Difference(vtkImageData *image1, vtkImageData *image2,
+                  int margin, double *maxValue)
+{
+  int *ext = image1->GetExtent();
+  double maxDiff = 0.0;
+  *maxValue = 0.0;
+  for (int z = ext[4]; z <= ext[5]; z++)
+    {
+    for (int y = ext[2] + margin; y <= ext[3] - margin; y++)
+      {
+      for (int x = ext[0] + margin; x <= ext[1] - margin; x++)
+        {
+        double v1 = image1->GetScalarComponentAsDouble(x, y, z, 0);
+        double v2 = image2->GetScalarComponentAsDouble(x, y, z, 0);
+        maxDiff = std::max(maxDiff, fabs(v1 - v2));
+        *maxValue = std::max(*maxValue, fabs(v1));
+        }
+      }
+    }
+  return maxDiff;
+}
+}
+
+int TestImageGaussianSmoothRecursive(int, char *[])
+{
+  int rval = 0;
+  int ext[6] = { 0, 119, -10, 89, 0, 0 };
+
+  vtkNew<vtkImageData> image;
+  MakeImage(image.GetPointer(), ext, 0);
+
+  // The recursive filter must be within a small fraction of the FIR
+  // filter, away from the boundaries where the two are different.
+  static const int orders[5][2] = {
+    { 0, 0 }, { 1, 0 }, { 0, 1 }, { 2, 0 }, { 1, 1 }
+  };
+  static const double tolerances[5] = { 0.002, 0.01, 0.01, 0.02, 0.02 };
+  for (int i = 0; i < 5; i++)
+    {
+    vtkNew<vtkImageGaussianSmooth> fir;
+    fir->SetInputData(image.GetPointer());
+    fir->SetDimensionality(2);
+    fir->SetStandardDeviations(3.0, 4.0);
+    fir->SetRadiusFactors(5.0, 5.0);
+    fir->SetDerivativeOrders(orders[i][0], orders[i][1], 0);
+    fir->Update();
+
+    vtkNew<vtkImageGaussianSmooth> recursive;
+    recursive->SetInputData(image.GetPointer());
+    recursive->SetDimensionality(2);
+    recursive->SetStandardDeviations(3.0, 4.0);
+    recursive->SetDerivativeOrders(orders[i][0], orders[i][1], 0);
+    recursive->SetModeToRecursive();
+    recursive->Update();
+
+    double maxValue;
+    double maxDiff = Difference(fir->GetOutput(), recursive->GetOutput(),
+                                25, &maxValue);
+    if (maxDiff > tolerances[i]*maxValue)
+      {
+      cerr << "Orders " << orders[i][0] << ", " << orders[i][1]
+           << ": difference " << maxDiff << " for values up to "
+           << maxValue << endl;
+      rval = 1;
+      }
+
+    // The output for a part of the extent must be the same as the
+    // corresponding part of the whole output.
+    vtkNew<vtkImageData> whole;
+    whole->DeepCopy(recursive->GetOutput());
+    int subExt[6] = { 30, 70, 20, 50, 0, 0 };
+    recursive->Modified();
+    recursive->UpdateInformation();
+    vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+      recursive->GetOutputInformation(0), subExt);
+    recursive->Update();
+    vtkImageData *output = recursive->GetOutput();
+    int *outExt = output->GetExtent();
+    for (int j = 0; j < 6; j++)
+      {
+      if (outExt[j] != subExt[j])
+        {
+        cerr << "Wrong output extent" << endl;
+        rval = 1;
+        break;
+        }
+      }
+    for (int y = subExt[2]; rval == 0 && y <= subExt[3]; y++)
+      {
+      for (int x = subExt[0]; x <= subExt[1]; x++)
+        {
+        if (output->GetScalarComponentAsDouble(x, y, 0, 0) !=
+            whole->GetScalarComponentAsDouble(x, y, 0, 0))
+          {
+          cerr << "Orders " << orders[i][0] << ", " << orders[i][1]
+               << ": wrong value for part of the extent" << endl;
+          rval = 1;
+          break;
+          }
+        }
+      }
+    }
+
+  // The derivatives of simple functions are exact away from the boundaries,
+  // in both modes and in three dimensions.
+  int ext3[6] = { 0, 39, 0, 29, 0, 24 };
+  static const int functions[3] = { 1, 1, 2 };
+  static const int orders3[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 2, 0, 0 } };
+  static const double expected[3] = { 2.0, 3.0, 1.0 };
+  for (int i = 0; i < 3; i++)
+    {
+    vtkNew<vtkImageData> image3;
+    MakeImage(image3.GetPointer(), ext3, functions[i]);
+    for (int mode = VTK_GAUSSIAN_SMOOTH_FIR;
+         mode <= VTK_GAUSSIAN_SMOOTH_RECURSIVE; mode++)
+      {
+      vtkNew<vtkImageGaussianSmooth> smooth;
+      smooth->SetInputData(image3.GetPointer());
+      smooth->SetStandardDeviation(2.0);
+      smooth->SetRadiusFactor(3.0);
+      smooth->SetDerivativeOrders(const_cast<int *>(orders3[i]));
+      smooth->SetMode(mode);
+      smooth->Update();
+      vtkImageData *output = smooth->GetOutput();
+      for (int z = 0; z <= 24; z++)
+        {
+        double v = output->GetScalarComponentAsDouble(20, 15, z, 0);
+        if (fabs(v - expected[i]) > 1e-3)
+          {
+          cerr << smooth->GetModeAsString() << " derivative "
+               << i << " at z = " << z << " is " << v << " instead of "
+               << expected[i] << endl;
+          rval = 1;
+          break;
+          }
+        }
+      }
+    }
+
+  return rval;
+}
@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageInterpolatePoints.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that InterpolatePointsIJK gives exactly the same values as
+// calling InterpolateIJK for each point.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageInterpolator.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// Generate points within the structured bounds of the image, with runs
+// of three points on integer or half-integer positions.
+template<class F>
+void MakePoints(const int extent[6], int n, std::vector<F> &points)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  points.resize(3*n);
+  for (int i = 0; i < n; i++)
+    {
+    for (int j = 0; j < 3; j++)
+      {
+      double lo = extent[2*j] - 0.5*(extent[2*j] == extent[2*j+1]);
+      double hi = extent[2*j+1] + 0.5*(extent[2*j] == extent[2*j+1]);
+      double x = random->GetRangeValue(lo, hi);
+      random->Next();
+      if ((i/3) % 4 == 1)
+        {
+        x = static_cast<int>(x);
+        }
+      else if ((i/3) % 4 == 3)
+        {
+        x = static_cast<int>(x) + 0.5;
+        x = (x < hi ? x : hi);
+        }
+      points[3*i+j] = static_cast<F>(x);
+      }
+    }
+}
+
+template<class F>
+int CheckInterpolator(vtkImageInterpolator *interpolator,
+                      const int extent[6])
+{
+  int n = 101;
+  std::vector<F> points;
+  MakePoints(extent, n, points);
+
+  int nc = interpolator->GetNumberOfComponents();
+  std::vector<F> expected(n*nc);
+  std::vector<F> values(n*nc);
+  for (int i = 0; i < n; i++)
+    {
+    interpolator->InterpolateIJK(&points[3*i], &expected[i*nc]);
+    }
+
+  // use both even and odd numbers of points
+  for (int m = n - 1; m <= n; m++)
+    {
+    memset(&values[0], 0, values.size()*sizeof(F));
+    interpolator->InterpolatePointsIJK(&points[0], &values[0], m);
+    if (memcmp(&values[0], &expected[0], m*nc*sizeof(F)) != 0)
+      {
+      return 1;
+      }
+    }
+
+  return 0;
+}
+}
+
+int TestImageInterpolatePoints(int, char *[])
+{
+  int rval = 0;
+
+  static const int types[] = {
+    VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT, VTK_FLOAT, VTK_DOUBLE
+  };
+  static const int extents[2][6] = {
+    { -2, 6, 1, 8, 0, 6 },
+    { 0, 9, -3, 4, 2, 2 }
+  };
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2);
+
+  for (int t = 0; t < 5; t++)
+    {
+    for (int e = 0; e < 2; e++)
+      {
+      for (int nc = 1; nc <= 3; nc += 2)
+        {
+        vtkNew<vtkImageData> image;
+        image->SetExtent(const_cast<int *>(extents[e]));
+        image->AllocateScalars(types[t], nc);
+        vtkDataArray *scalars = image->GetPointData()->GetScalars();
+        for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+          {
+          for (int c = 0; c < nc; c++)
+            {
+            scalars->SetComponent(i, c, random->GetRangeValue(0.0, 250.0));
+            random->Next();
+            }
+          }
+
+        for (int mode = VTK_NEAREST_INTERPOLATION;
+             mode <= VTK_CUBIC_INTERPOLATION; mode++)
+          {
+          for (int border = VTK_IMAGE_BORDER_CLAMP;
+               border <= VTK_IMAGE_BORDER_MIRROR; border++)
+            {
+            vtkNew<vtkImageInterpolator> interpolator;
+            interpolator->SetInterpolationMode(mode);
+            interpolator->SetBorderMode(border);
+            interpolator->Initialize(image.GetPointer());
+            interpolator->Update();
+
+            if (CheckInterpolator<double>(interpolator.GetPointer(),
+                                          extents[e]) ||
+                CheckInterpolator<float>(interpolator.GetPointer(),
+                                         extents[e]))
+              {
+              cerr << "Mismatch for type " << types[t] << ", extent " << e
+                   << ", components " << nc << ", "
+                   << interpolator->GetInterpolationModeAsString() << ", "
+                   << interpolator->GetBorderModeAsString() << endl;
+              rval = 1;
+              }
+            }
+          }
+        }
+      }
+    }
+
+  return rval;
+}
@@ -0,0 +1,248 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMedian3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the histogram path of vtkImageMedian3D for 8-bit and 16-bit
+// data with the sorting path for float data, for several kernel shapes and
+// percentiles, and compare vtkImageHybridMedian2D with a direct evaluation.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageHybridMedian2D.h"
+#include "vtkImageMedian3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Make an image with random values in the given range.
+void MakeImage(vtkImageData *image, int ext[6], int scalarType,
+               double lo, double hi, vtkMinimalStandardRandomSequence *random)
+{
+  image->SetExtent(ext);
+  image->AllocateScalars(scalarType, 1);
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+    {
+    scalars->SetComponent(
+      i, 0, static_cast<int>(random->GetRangeValue(lo, hi)));
+    random->Next();
+    }
+}
+
+// Copy an image to a float image.
+void MakeFloatImage(vtkImageData *image, vtkImageData *floatImage)
+{
+  floatImage->SetExtent(image->GetExtent());
+  floatImage->AllocateScalars(VTK_FLOAT, 1);
+  floatImage->GetPointData()->GetScalars()->DeepCopy(
+    image->GetPointData()->GetScalars());
+}
+
+// Whether two images have the same values.
+bool SameValues(vtkImageData *image1, vtkImageData *image2)
+{
+  vtkDataArray *scalars1 = image1->GetPointData()->GetScalars();
+  vtkDataArray *scalars2 = image2->GetPointData()->GetScalars();
+  if (scalars1->GetNumberOfTuples() != scalars2->GetNumberOfTuples())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < scalars1->GetNumberOfTuples(); i++)
+    {
+    if (scalars1->GetComponent(i, 0) != scalars2->GetComponent(i, 0))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// The median of the values in a neighborhood, as chosen by the filter.
+double Median(std::vector<double> &values)
+{
+  std::sort(values.begin(), values.end());
+  return values[values.size()/2];
+}
+
+// The hybrid median at (x, y), computed directly.
+double HybridMedian(vtkImageData *image, int x, int y, int z)
+{
+  int *ext = image->GetExtent();
+  double center = image->GetScalarComponentAsDouble(x, y, z, 0);
+  double medians[2];
+  for (int diagonal = 0; diagonal < 2; diagonal++)
+    {
+    std::vector<double> values(1, center);
+    for (int dir = 0; dir < 4; dir++)
+      {
+      // the + neighborhood goes along the axes, the x one along diagonals
+      int dx = (diagonal ? (dir < 2 ? 1 : -1) : (dir == 0) - (dir == 1));
+      int dy = (diagonal ? (dir % 2 ? 1 : -1) : (dir == 2) - (dir == 3));
+      for (int d = 1; d <= 2; d++)
+        {
+        int px = x + d*dx;
+        int py = y + d*dy;
+        if (px >= ext[0] && px <= ext[1] && py >= ext[2] && py <= ext[3])
+          {
+          values.push_back(image->GetScalarComponentAsDouble(px, py, z, 0));
+          }
+        }
+      }
+    medians[diagonal] = Median(values);
+    }
+  std::vector<double> values(medians, medians + 2);
+  values.push_back(center);
+  return Median(values);
+}
+}
+
+int TestImageMedian3D(int, char *[])
+{
+  int rval = 0;
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  int ext[6] = { -3, 19, 2, 20, 0, 6 };
+  static const int types[3] = {
+    VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT
+  };
+  static const double ranges[3][2] = {
+    { 0.0, 256.0 }, { -3000.0, 3000.0 }, { 0.0, 65536.0 }
+  };
+
+  // odd, even, flat and boundary-clipped kernels
+  static const int kernels[7][3] = {
+    { 1, 1, 1 }, { 3, 3, 3 }, { 5, 5, 1 }, { 4, 2, 1 }, { 2, 2, 2 },
+    { 1, 6, 3 }, { 9, 7, 5 }
+  };
+  static const double percentiles[4] = { 0.0, 30.0, 50.0, 100.0 };
+
+  for (int t = 0; t < 3; t++)
+    {
+    vtkNew<vtkImageData> image;
+    MakeImage(image.GetPointer(), ext, types[t], ranges[t][0], ranges[t][1],
+              random.GetPointer());
+    vtkNew<vtkImageData> floatImage;
+    MakeFloatImage(image.GetPointer(), floatImage.GetPointer());
+
+    for (int k = 0; k < 7; k++)
+      {
+      for (int p = 0; p < 4; p++)
+        {
+        vtkNew<vtkImageMedian3D> median;
+        median->SetInputData(image.GetPointer());
+        median->SetKernelSize(kernels[k][0], kernels[k][1], kernels[k][2]);
+        median->SetPercentile(percentiles[p]);
+        median->Update();
+
+        vtkNew<vtkImageMedian3D> sorted;
+        sorted->SetInputData(floatImage.GetPointer());
+        sorted->SetKernelSize(kernels[k][0], kernels[k][1], kernels[k][2]);
+        sorted->SetPercentile(percentiles[p]);
+        sorted->Update();
+
+        if (!SameValues(median->GetOutput(), sorted->GetOutput()))
+          {
+          cerr << "Median of type " << types[t] << " with kernel "
+               << kernels[k][0] << "x" << kernels[k][1] << "x"
+               << kernels[k][2] << " and percentile " << percentiles[p]
+               << " differs from the float median" << endl;
+          rval = 1;
+          }
+
+        if (t != 0 || (p != 0 && p != 3))
+          {
+          continue;
+          }
+
+        // the percentiles 0 and 100 are the minimum and maximum of the
+        // neighborhood clipped by the image bounds
+        vtkImageData *output = sorted->GetOutput();
+        bool correct = true;
+        for (int z = ext[4]; correct && z <= ext[5]; z++)
+          {
+          for (int y = ext[2]; correct && y <= ext[3]; y++)
+            {
+            for (int x = ext[0]; correct && x <= ext[1]; x++)
+              {
+              int lo[3] = { x, y, z };
+              int hi[3];
+              for (int j = 0; j < 3; j++)
+                {
+                lo[j] -= kernels[k][j]/2;
+                hi[j] = std::min(lo[j] + kernels[k][j] - 1, ext[2*j+1]);
+                lo[j] = std::max(lo[j], ext[2*j]);
+                }
+              double expected = (p == 0 ? VTK_DOUBLE_MAX : VTK_DOUBLE_MIN);
+              for (int k2 = lo[2]; k2 <= hi[2]; k2++)
+                {
+                for (int k1 = lo[1]; k1 <= hi[1]; k1++)
+                  {
+                  for (int k0 = lo[0]; k0 <= hi[0]; k0++)
+                    {
+                    double v =
+                      floatImage->GetScalarComponentAsDouble(k0, k1, k2, 0);
+                    expected = (p == 0 ? std::min(expected, v) :
+                                std::max(expected, v));
+                    }
+                  }
+                }
+              correct =
+                (output->GetScalarComponentAsDouble(x, y, z, 0) == expected);
+              }
+            }
+          }
+        if (!correct)
+          {
+          cerr << "Percentile " << percentiles[p] << " with kernel "
+               << kernels[k][0] << "x" << kernels[k][1] << "x"
+               << kernels[k][2] << " is not the "
+               << (p == 0 ? "minimum" : "maximum") << endl;
+          rval = 1;
+          }
+        }
+      }
+
+    // the hybrid median, including the clipped neighborhoods at the
+    // boundaries
+    vtkNew<vtkImageHybridMedian2D> hybrid;
+    hybrid->SetInputData(image.GetPointer());
+    hybrid->Update();
+    vtkImageData *output = hybrid->GetOutput();
+    bool same = true;
+    for (int z = ext[4]; same && z <= ext[5]; z++)
+      {
+      for (int y = ext[2]; same && y <= ext[3]; y++)
+        {
+        for (int x = ext[0]; same && x <= ext[1]; x++)
+          {
+          same = (output->GetScalarComponentAsDouble(x, y, z, 0) ==
+                  HybridMedian(image.GetPointer(), x, y, z));
+          }
+        }
+      }
+    if (!same)
+      {
+      cerr << "Hybrid median of type " << types[t] << " is wrong" << endl;
+      rval = 1;
+      }
+    }
+
+  return rval;
+}
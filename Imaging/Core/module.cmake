@@ -17,6 +17,7 @@ vtk_module(vtkImagingCore
     vtkInteractionImage
     vtkImagingMath # Move tests
     vtkImagingStencil # Move tests
+    vtkImagingFourier # Move tests
     vtkImagingGeneral # Move tests
     vtkImagingStatistics # Move tests
     vtkRenderingImage # Move tests
@@ -89,6 +89,8 @@ vtkAbstractImageInterpolator::vtkAbstractImageInterpolator()
     &(vtkInterpolateNOP<double>::RowInterpolationFunc);
   this->RowInterpolationFuncFloat =
     &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+  this->PointsInterpolationFuncDouble = NULL;
+  this->PointsInterpolationFuncFloat = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -305,6 +307,8 @@ void vtkAbstractImageInterpolator::Update()
       &(vtkInterpolateNOP<double>::RowInterpolationFunc);
     this->RowInterpolationFuncFloat =
       &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+    this->PointsInterpolationFuncDouble = NULL;
+    this->PointsInterpolationFuncFloat = NULL;
 
     return;
     }
@@ -382,6 +386,8 @@ void vtkAbstractImageInterpolator::Update()
   this->GetInterpolationFunc(&this->InterpolationFuncFloat);
   this->GetRowInterpolationFunc(&this->RowInterpolationFuncDouble);
   this->GetRowInterpolationFunc(&this->RowInterpolationFuncFloat);
+  this->GetPointsInterpolationFunc(&this->PointsInterpolationFuncDouble);
+  this->GetPointsInterpolationFunc(&this->PointsInterpolationFuncFloat);
 }
 
 //----------------------------------------------------------------------------
@@ -442,6 +448,48 @@ double vtkAbstractImageInterpolator::Interpolate(
   return value;
 }
 
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolatePointsIJK(
+  const double *points, double *value, int n)
+{
+  if (this->PointsInterpolationFuncDouble)
+    {
+    this->PointsInterpolationFuncDouble(
+      this->InterpolationInfo, points, value, n);
+    }
+  else
+    {
+    int numscalars = this->InterpolationInfo->NumberOfComponents;
+    for (int i = 0; i < n; i++)
+      {
+      this->InterpolationFuncDouble(this->InterpolationInfo, points, value);
+      points += 3;
+      value += numscalars;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolatePointsIJK(
+  const float *points, float *value, int n)
+{
+  if (this->PointsInterpolationFuncFloat)
+    {
+    this->PointsInterpolationFuncFloat(
+      this->InterpolationInfo, points, value, n);
+    }
+  else
+    {
+    int numscalars = this->InterpolationInfo->NumberOfComponents;
+    for (int i = 0; i < n; i++)
+      {
+      this->InterpolationFuncFloat(this->InterpolationInfo, points, value);
+      points += 3;
+      value += numscalars;
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::GetInterpolationFunc(
   void (**)(vtkInterpolationInfo *, const double [3], double *))
@@ -466,6 +514,20 @@ void vtkAbstractImageInterpolator::GetRowInterpolationFunc(
 {
 }
 
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetPointsInterpolationFunc(
+  void (**func)(vtkInterpolationInfo *, const double *, double *, int))
+{
+  *func = NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetPointsInterpolationFunc(
+  void (**func)(vtkInterpolationInfo *, const float *, float *, int))
+{
+  *func = NULL;
+}
+
 //----------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::PrecomputeWeightsForExtent(
   const double [16], const int [6], int [6], vtkInterpolationWeights *&)
@@ -128,6 +128,16 @@ public:
   void InterpolateIJK(const double point[3], double *value);
   void InterpolateIJK(const float point[3], float *value);
 
+  // Description:
+  // Interpolate n points at once.  The points are given in structured
+  // coords as n consecutive (i,j,k) triples, and must have been checked
+  // with CheckBoundsIJK.  The values are stored consecutively, with
+  // GetNumberOfComponents() values per point.  The results are identical
+  // to calling InterpolateIJK for each point, but interpolators can use
+  // a faster method that works on many points at a time.
+  void InterpolatePointsIJK(const double *points, double *value, int n);
+  void InterpolatePointsIJK(const float *points, float *value, int n);
+
   // Description:
   // Check an x,y,z point to see if it is within the bounds for the
   // structured coords of the image.  This is meant to be called prior
@@ -245,6 +255,16 @@ protected:
     void (**floatfunc)(
       vtkInterpolationWeights *, int, int, int, float *, int));
 
+  // Description:
+  // Get the functions that interpolate many points at once.  The default
+  // sets them to NULL, and InterpolateIJK will be called for each point.
+  virtual void GetPointsInterpolationFunc(
+    void (**doublefunc)(
+      vtkInterpolationInfo *, const double *, double *, int));
+  virtual void GetPointsInterpolationFunc(
+    void (**floatfunc)(
+      vtkInterpolationInfo *, const float *, float *, int));
+
   vtkDataArray *Scalars;
   double StructuredBoundsDouble[6];
   float StructuredBoundsFloat[6];
@@ -273,6 +293,13 @@ protected:
     vtkInterpolationWeights *weights, int idX, int idY, int idZ,
     float *outPtr, int n);
 
+  void (*PointsInterpolationFuncDouble)(
+    vtkInterpolationInfo *info, const double *points, double *outPtr,
+    int n);
+  void (*PointsInterpolationFuncFloat)(
+    vtkInterpolationInfo *info, const float *points, float *outPtr,
+    int n);
+
 private:
 
   vtkAbstractImageInterpolator(const vtkAbstractImageInterpolator&);  // Not implemented.
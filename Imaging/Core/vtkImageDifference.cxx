@@ -35,6 +35,9 @@ vtkImageDifference::vtkImageDifference()
   this->AllowShift = 1;
   this->Averaging = 1;
   this->SetNumberOfInputPorts(2);
+  // ThreadedRequestData() resets the error of its thread, so each thread
+  // must be given exactly one piece.
+  this->EnableDynamicScheduling = 0;
 }
 
 
@@ -28,6 +28,13 @@
 # undef VTK_USE_UINT64
 # define VTK_USE_UINT64 0
 
+// use SSE2 for double precision on x86_64, where it is always available
+#if defined(VTK_INTERPOLATE_64BIT_FLOOR) && \
+    (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define VTK_IMAGE_INTERPOLATOR_SSE2
+#endif
+
 vtkStandardNewMacro(vtkImageInterpolator);
 
 //----------------------------------------------------------------------------
@@ -510,6 +517,527 @@ void vtkImageInterpolatorGetInterpolationFunc(
     }
 }
 
+//----------------------------------------------------------------------------
+// Interpolation of many points at a time.  The generic version simply
+// calls the single-point functions above.
+
+template<class F, class T>
+struct vtkImageNLCPointsInterpolate
+{
+  static void Nearest(
+    vtkInterpolationInfo *info, const F *points, F *outPtr, int n);
+
+  static void Trilinear(
+    vtkInterpolationInfo *info, const F *points, F *outPtr, int n);
+
+  static void Tricubic(
+    vtkInterpolationInfo *info, const F *points, F *outPtr, int n);
+};
+
+//----------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCPointsInterpolate<F, T>::Nearest(
+  vtkInterpolationInfo *info, const F *points, F *outPtr, int n)
+{
+  int numscalars = info->NumberOfComponents;
+  for (int i = 0; i < n; i++)
+    {
+    vtkImageNLCInterpolate<F, T>::Nearest(info, points, outPtr);
+    points += 3;
+    outPtr += numscalars;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCPointsInterpolate<F, T>::Trilinear(
+  vtkInterpolationInfo *info, const F *points, F *outPtr, int n)
+{
+  int numscalars = info->NumberOfComponents;
+  for (int i = 0; i < n; i++)
+    {
+    vtkImageNLCInterpolate<F, T>::Trilinear(info, points, outPtr);
+    points += 3;
+    outPtr += numscalars;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCPointsInterpolate<F, T>::Tricubic(
+  vtkInterpolationInfo *info, const F *points, F *outPtr, int n)
+{
+  int numscalars = info->NumberOfComponents;
+  for (int i = 0; i < n; i++)
+    {
+    vtkImageNLCInterpolate<F, T>::Tricubic(info, points, outPtr);
+    points += 3;
+    outPtr += numscalars;
+    }
+}
+
+#ifdef VTK_IMAGE_INTERPOLATOR_SSE2
+//----------------------------------------------------------------------------
+// SSE2 versions for double precision, which interpolate two points at a
+// time.  Every operation is done in the same order as in the single-point
+// functions, so the results are identical.  Only the clamp border mode
+// is done with SSE2, other border modes use the single-point functions.
+
+// Load two samples as the two lanes of a vector.
+template<class T>
+inline __m128d vtkImageNLCLoad2(const T *ptr0, const T *ptr1)
+{
+  return _mm_set_pd(static_cast<double>(*ptr1), static_cast<double>(*ptr0));
+}
+
+//----------------------------------------------------------------------------
+// The vtkInterpolationMath::Floor of two values.  After the large constant
+// is added, the lowest 16 bits of the mantissa are the fraction and the
+// bits above them are the integer.  The integers are returned in the two
+// low lanes.
+inline __m128i vtkImageNLCFloor2(__m128d x, __m128d &f)
+{
+  x = _mm_add_pd(
+    x, _mm_set1_pd(103079215104.0 + VTK_INTERPOLATE_FLOOR_TOL));
+  __m128d i = _mm_and_pd(
+    x, _mm_castsi128_pd(_mm_set_epi32(-1, -65536, -1, -65536)));
+  f = _mm_sub_pd(x, i);
+  return _mm_shuffle_epi32(
+    _mm_srli_epi64(_mm_castpd_si128(x), 16), _MM_SHUFFLE(2, 2, 2, 0));
+}
+
+//----------------------------------------------------------------------------
+// The vtkInterpolationMath::Round of two values.
+inline __m128i vtkImageNLCRound2(__m128d x)
+{
+  x = _mm_add_pd(
+    x, _mm_set1_pd(103079215104.5 + VTK_INTERPOLATE_FLOOR_TOL));
+  return _mm_shuffle_epi32(
+    _mm_srli_epi64(_mm_castpd_si128(x), 16), _MM_SHUFFLE(2, 2, 2, 0));
+}
+
+//----------------------------------------------------------------------------
+// The vtkInterpolationMath::Clamp of four indices.
+inline __m128i vtkImageNLCClamp4(__m128i a, __m128i b, __m128i c)
+{
+  __m128i m = _mm_cmpgt_epi32(a, c);
+  a = _mm_or_si128(_mm_and_si128(m, c), _mm_andnot_si128(m, a));
+  a = _mm_sub_epi32(a, b);
+  return _mm_and_si128(a, _mm_cmpgt_epi32(a, _mm_setzero_si128()));
+}
+
+//----------------------------------------------------------------------------
+// Compute the clamped indices for linear interpolation along one axis
+// for two points, and return the fractions.  The indices are stored
+// as idx[0..1] for the lower sample and idx[2..3] for the upper sample.
+inline __m128d vtkImageNLCLinearIndices2(
+  double x0, double x1, int minX, int maxX, int idx[4])
+{
+  __m128d f;
+  __m128i i0 = vtkImageNLCFloor2(_mm_set_pd(x1, x0), f);
+  __m128i step = _mm_shuffle_epi32(
+    _mm_castpd_si128(_mm_cmpneq_pd(f, _mm_setzero_pd())),
+    _MM_SHUFFLE(2, 2, 2, 0));
+  __m128i i1 = _mm_sub_epi32(i0, step);
+  __m128i i = vtkImageNLCClamp4(
+    _mm_unpacklo_epi64(i0, i1), _mm_set1_epi32(minX), _mm_set1_epi32(maxX));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(idx), i);
+  return f;
+}
+
+//----------------------------------------------------------------------------
+// Compute the clamped indices and the weights for cubic interpolation
+// along one axis for two points, and return the fractions.  The indices
+// are stored as idx[0..3] for the first point, idx[4..7] for the second.
+inline __m128d vtkImageNLCCubicIndices2(
+  double x0, double x1, int minX, int maxX, int idx[8], __m128d w[4])
+{
+  __m128d f;
+  __m128i i0 = vtkImageNLCFloor2(_mm_set_pd(x1, x0), f);
+  __m128i offsets = _mm_set_epi32(2, 1, 0, -1);
+  __m128i lo = _mm_set1_epi32(minX);
+  __m128i hi = _mm_set1_epi32(maxX);
+  __m128i a = _mm_add_epi32(
+    _mm_shuffle_epi32(i0, _MM_SHUFFLE(0, 0, 0, 0)), offsets);
+  __m128i b = _mm_add_epi32(
+    _mm_shuffle_epi32(i0, _MM_SHUFFLE(1, 1, 1, 1)), offsets);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(idx),
+                   vtkImageNLCClamp4(a, lo, hi));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(idx + 4),
+                   vtkImageNLCClamp4(b, lo, hi));
+
+  // same as vtkTricubicInterpWeights
+  __m128d sign = _mm_set1_pd(-0.0);
+  __m128d one = _mm_set1_pd(1.0);
+  __m128d fm1 = _mm_sub_pd(f, one);
+  __m128d fd2 = _mm_mul_pd(f, _mm_set1_pd(0.5));
+  __m128d ft3 = _mm_mul_pd(f, _mm_set1_pd(3.0));
+  w[0] = _mm_mul_pd(_mm_mul_pd(_mm_xor_pd(fd2, sign), fm1), fm1);
+  w[1] = _mm_mul_pd(
+    _mm_sub_pd(_mm_mul_pd(_mm_sub_pd(ft3, _mm_set1_pd(2.0)), fd2), one),
+    fm1);
+  w[2] = _mm_mul_pd(
+    _mm_xor_pd(
+      _mm_sub_pd(_mm_mul_pd(_mm_sub_pd(ft3, _mm_set1_pd(4.0)), f), one),
+      sign),
+    fd2);
+  w[3] = _mm_mul_pd(_mm_mul_pd(f, fd2), fm1);
+
+  return f;
+}
+
+//----------------------------------------------------------------------------
+template<class T>
+struct vtkImageNLCPointsInterpolate<double, T>
+{
+  static void Nearest(
+    vtkInterpolationInfo *info, const double *points, double *outPtr,
+    int n);
+
+  static void Trilinear(
+    vtkInterpolationInfo *info, const double *points, double *outPtr,
+    int n);
+
+  static void Tricubic(
+    vtkInterpolationInfo *info, const double *points, double *outPtr,
+    int n);
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageNLCPointsInterpolate<double, T>::Nearest(
+  vtkInterpolationInfo *info, const double *points, double *outPtr, int n)
+{
+  int numscalars = info->NumberOfComponents;
+  if (info->BorderMode == VTK_IMAGE_BORDER_CLAMP)
+    {
+    const T *inPtr = static_cast<const T *>(info->Pointer);
+    int *inExt = info->Extent;
+    vtkIdType *inInc = info->Increments;
+    __m128i loXY = _mm_set_epi32(inExt[2], inExt[2], inExt[0], inExt[0]);
+    __m128i hiXY = _mm_set_epi32(inExt[3], inExt[3], inExt[1], inExt[1]);
+    __m128i loZ = _mm_set1_epi32(inExt[4]);
+    __m128i hiZ = _mm_set1_epi32(inExt[5]);
+
+    for (; n >= 2; n -= 2)
+      {
+      int idXY[4], idZ[4];
+      __m128i iX = vtkImageNLCRound2(_mm_set_pd(points[3], points[0]));
+      __m128i iY = vtkImageNLCRound2(_mm_set_pd(points[4], points[1]));
+      __m128i iZ = vtkImageNLCRound2(_mm_set_pd(points[5], points[2]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(idXY),
+        vtkImageNLCClamp4(_mm_unpacklo_epi64(iX, iY), loXY, hiXY));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(idZ),
+        vtkImageNLCClamp4(iZ, loZ, hiZ));
+
+      for (int i = 0; i < 2; i++)
+        {
+        const T *tmpPtr = inPtr + (idXY[i]*inInc[0] + idXY[2+i]*inInc[1] +
+                                   idZ[i]*inInc[2]);
+        int c = numscalars;
+        do
+          {
+          *outPtr++ = *tmpPtr++;
+          }
+        while (--c);
+        }
+
+      points += 6;
+      }
+    }
+
+  for (; n > 0; n--)
+    {
+    vtkImageNLCInterpolate<double, T>::Nearest(info, points, outPtr);
+    points += 3;
+    outPtr += numscalars;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageNLCPointsInterpolate<double, T>::Trilinear(
+  vtkInterpolationInfo *info, const double *points, double *outPtr, int n)
+{
+  int numscalars = info->NumberOfComponents;
+  if (info->BorderMode == VTK_IMAGE_BORDER_CLAMP)
+    {
+    const T *inPtr = static_cast<const T *>(info->Pointer);
+    int *inExt = info->Extent;
+    vtkIdType *inInc = info->Increments;
+    __m128d one = _mm_set1_pd(1.0);
+
+    for (; n >= 2; n -= 2)
+      {
+      int idX[4], idY[4], idZ[4];
+      __m128d fx = vtkImageNLCLinearIndices2(
+        points[0], points[3], inExt[0], inExt[1], idX);
+      __m128d fy = vtkImageNLCLinearIndices2(
+        points[1], points[4], inExt[2], inExt[3], idY);
+      __m128d fz = vtkImageNLCLinearIndices2(
+        points[2], points[5], inExt[4], inExt[5], idZ);
+
+      // the offsets for the first point (a) and the second point (b)
+      vtkIdType factY0a = idY[0]*inInc[1];
+      vtkIdType factY0b = idY[1]*inInc[1];
+      vtkIdType factY1a = idY[2]*inInc[1];
+      vtkIdType factY1b = idY[3]*inInc[1];
+      vtkIdType factZ0a = idZ[0]*inInc[2];
+      vtkIdType factZ0b = idZ[1]*inInc[2];
+      vtkIdType factZ1a = idZ[2]*inInc[2];
+      vtkIdType factZ1b = idZ[3]*inInc[2];
+
+      vtkIdType i00a = factY0a + factZ0a;
+      vtkIdType i01a = factY0a + factZ1a;
+      vtkIdType i10a = factY1a + factZ0a;
+      vtkIdType i11a = factY1a + factZ1a;
+      vtkIdType i00b = factY0b + factZ0b;
+      vtkIdType i01b = factY0b + factZ1b;
+      vtkIdType i10b = factY1b + factZ0b;
+      vtkIdType i11b = factY1b + factZ1b;
+
+      __m128d rx = _mm_sub_pd(one, fx);
+      __m128d ry = _mm_sub_pd(one, fy);
+      __m128d rz = _mm_sub_pd(one, fz);
+
+      __m128d ryrz = _mm_mul_pd(ry, rz);
+      __m128d fyrz = _mm_mul_pd(fy, rz);
+      __m128d ryfz = _mm_mul_pd(ry, fz);
+      __m128d fyfz = _mm_mul_pd(fy, fz);
+
+      const T *inPtr0a = inPtr + idX[0]*inInc[0];
+      const T *inPtr0b = inPtr + idX[1]*inInc[0];
+      const T *inPtr1a = inPtr + idX[2]*inInc[0];
+      const T *inPtr1b = inPtr + idX[3]*inInc[0];
+
+      int c = numscalars;
+      do
+        {
+        __m128d v0 = _mm_mul_pd(
+          ryrz, vtkImageNLCLoad2(inPtr0a + i00a, inPtr0b + i00b));
+        v0 = _mm_add_pd(v0, _mm_mul_pd(
+          ryfz, vtkImageNLCLoad2(inPtr0a + i01a, inPtr0b + i01b)));
+        v0 = _mm_add_pd(v0, _mm_mul_pd(
+          fyrz, vtkImageNLCLoad2(inPtr0a + i10a, inPtr0b + i10b)));
+        v0 = _mm_add_pd(v0, _mm_mul_pd(
+          fyfz, vtkImageNLCLoad2(inPtr0a + i11a, inPtr0b + i11b)));
+
+        __m128d v1 = _mm_mul_pd(
+          ryrz, vtkImageNLCLoad2(inPtr1a + i00a, inPtr1b + i00b));
+        v1 = _mm_add_pd(v1, _mm_mul_pd(
+          ryfz, vtkImageNLCLoad2(inPtr1a + i01a, inPtr1b + i01b)));
+        v1 = _mm_add_pd(v1, _mm_mul_pd(
+          fyrz, vtkImageNLCLoad2(inPtr1a + i10a, inPtr1b + i10b)));
+        v1 = _mm_add_pd(v1, _mm_mul_pd(
+          fyfz, vtkImageNLCLoad2(inPtr1a + i11a, inPtr1b + i11b)));
+
+        __m128d v = _mm_add_pd(_mm_mul_pd(rx, v0), _mm_mul_pd(fx, v1));
+        _mm_storel_pd(outPtr, v);
+        _mm_storeh_pd(outPtr + numscalars, v);
+
+        outPtr++;
+        inPtr0a++;
+        inPtr0b++;
+        inPtr1a++;
+        inPtr1b++;
+        }
+      while (--c);
+
+      outPtr += numscalars;
+      points += 6;
+      }
+    }
+
+  for (; n > 0; n--)
+    {
+    vtkImageNLCInterpolate<double, T>::Trilinear(info, points, outPtr);
+    points += 3;
+    outPtr += numscalars;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageNLCPointsInterpolate<double, T>::Tricubic(
+  vtkInterpolationInfo *info, const double *points, double *outPtr, int n)
+{
+  int numscalars = info->NumberOfComponents;
+  if (info->BorderMode == VTK_IMAGE_BORDER_CLAMP)
+    {
+    const T *inPtr = static_cast<const T *>(info->Pointer);
+    int *inExt = info->Extent;
+    vtkIdType *inInc = info->Increments;
+
+    // check if only one slice in a particular direction
+    int multipleY = (inExt[2] != inExt[3]);
+    int multipleZ = (inExt[4] != inExt[5]);
+
+    for (; n >= 2; n -= 2)
+      {
+      int idX[8], idY[8], idZ[8];
+      __m128d wX[4], wY[4], wZ[4];
+      vtkImageNLCCubicIndices2(
+        points[0], points[3], inExt[0], inExt[1], idX, wX);
+      __m128d fy = vtkImageNLCCubicIndices2(
+        points[1], points[4], inExt[2], inExt[3], idY, wY);
+      __m128d fz = vtkImageNLCCubicIndices2(
+        points[2], points[5], inExt[4], inExt[5], idZ, wZ);
+
+      // a fractional offset of zero means one sample is enough, but
+      // both points must use the same number of samples
+      int maskY = _mm_movemask_pd(_mm_cmpneq_pd(fy, _mm_setzero_pd()));
+      int maskZ = _mm_movemask_pd(_mm_cmpneq_pd(fz, _mm_setzero_pd()));
+      maskY = (multipleY ? maskY : 0);
+      maskZ = (multipleZ ? maskZ : 0);
+      if (maskY == 1 || maskY == 2 || maskZ == 1 || maskZ == 2)
+        {
+        vtkImageNLCInterpolate<double, T>::Tricubic(
+          info, points, outPtr);
+        vtkImageNLCInterpolate<double, T>::Tricubic(
+          info, points + 3, outPtr + numscalars);
+        outPtr += 2*numscalars;
+        points += 6;
+        continue;
+        }
+
+      // the limits to use when doing the interpolation
+      int j1 = 1;
+      int j2 = 1;
+      int k1 = 1;
+      int k2 = 1;
+      if (maskY)
+        {
+        j1 = 0;
+        j2 = 3;
+        }
+      else
+        {
+        wY[1] = _mm_set1_pd(1.0);
+        }
+      if (maskZ)
+        {
+        k1 = 0;
+        k2 = 3;
+        }
+      else
+        {
+        wZ[1] = _mm_set1_pd(1.0);
+        }
+
+      vtkIdType factXa[4], factXb[4];
+      vtkIdType factYa[4], factYb[4];
+      vtkIdType factZa[4], factZb[4];
+      for (int l = 0; l < 4; l++)
+        {
+        factXa[l] = idX[l]*inInc[0];
+        factXb[l] = idX[4+l]*inInc[0];
+        factYa[l] = idY[l]*inInc[1];
+        factYb[l] = idY[4+l]*inInc[1];
+        factZa[l] = idZ[l]*inInc[2];
+        factZb[l] = idZ[4+l]*inInc[2];
+        }
+
+      const T *inPtra = inPtr;
+      const T *inPtrb = inPtr;
+      int c = numscalars;
+      do // loop over components
+        {
+        __m128d val = _mm_setzero_pd();
+        int k = k1;
+        do // loop over z
+          {
+          __m128d ifz = wZ[k];
+          int j = j1;
+          do // loop over y
+            {
+            __m128d fzy = _mm_mul_pd(ifz, wY[j]);
+            const T *tmpPtra = inPtra + (factZa[k] + factYa[j]);
+            const T *tmpPtrb = inPtrb + (factZb[k] + factYb[j]);
+            __m128d v = _mm_mul_pd(
+              wX[0], vtkImageNLCLoad2(tmpPtra + factXa[0],
+                                      tmpPtrb + factXb[0]));
+            v = _mm_add_pd(v, _mm_mul_pd(
+              wX[1], vtkImageNLCLoad2(tmpPtra + factXa[1],
+                                      tmpPtrb + factXb[1])));
+            v = _mm_add_pd(v, _mm_mul_pd(
+              wX[2], vtkImageNLCLoad2(tmpPtra + factXa[2],
+                                      tmpPtrb + factXb[2])));
+            v = _mm_add_pd(v, _mm_mul_pd(
+              wX[3], vtkImageNLCLoad2(tmpPtra + factXa[3],
+                                      tmpPtrb + factXb[3])));
+            val = _mm_add_pd(val, _mm_mul_pd(fzy, v));
+            }
+          while (++j <= j2);
+          }
+        while (++k <= k2);
+
+        _mm_storel_pd(outPtr, val);
+        _mm_storeh_pd(outPtr + numscalars, val);
+        outPtr++;
+        inPtra++;
+        inPtrb++;
+        }
+      while (--c);
+
+      outPtr += numscalars;
+      points += 6;
+      }
+    }
+
+  for (; n > 0; n--)
+    {
+    vtkImageNLCInterpolate<double, T>::Tricubic(info, points, outPtr);
+    points += 3;
+    outPtr += numscalars;
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------
+// Get the points interpolation function for the specified data types
+template<class F>
+void vtkImageInterpolatorGetPointsInterpolationFunc(
+  void (**interpolate)(vtkInterpolationInfo *, const F *, F *, int),
+  int dataType, int interpolationMode)
+{
+  switch (interpolationMode)
+    {
+    case VTK_NEAREST_INTERPOLATION:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(
+          *interpolate =
+            &(vtkImageNLCPointsInterpolate<F, VTK_TT>::Nearest)
+          );
+        default:
+          *interpolate = 0;
+        }
+      break;
+    case VTK_LINEAR_INTERPOLATION:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(
+          *interpolate =
+            &(vtkImageNLCPointsInterpolate<F, VTK_TT>::Trilinear)
+          );
+        default:
+          *interpolate = 0;
+        }
+      break;
+    case VTK_CUBIC_INTERPOLATION:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(
+          *interpolate =
+            &(vtkImageNLCPointsInterpolate<F, VTK_TT>::Tricubic)
+          );
+        default:
+          *interpolate = 0;
+        }
+      break;
+    }
+}
+
 //----------------------------------------------------------------------------
 // Interpolation for precomputed weights
 
@@ -1078,6 +1606,22 @@ void vtkImageInterpolator::GetRowInterpolationFunc(
     func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
 }
 
+//----------------------------------------------------------------------------
+void vtkImageInterpolator::GetPointsInterpolationFunc(
+  void (**func)(vtkInterpolationInfo *, const double *, double *, int))
+{
+  vtkImageInterpolatorGetPointsInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageInterpolator::GetPointsInterpolationFunc(
+  void (**func)(vtkInterpolationInfo *, const float *, float *, int))
+{
+  vtkImageInterpolatorGetPointsInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
 //----------------------------------------------------------------------------
 void vtkImageInterpolator::PrecomputeWeightsForExtent(
   const double matrix[16], const int extent[6], int newExtent[6],
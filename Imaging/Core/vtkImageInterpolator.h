@@ -111,6 +111,15 @@ protected:
     void (**floatfunc)(
       vtkInterpolationWeights *, int, int, int, float *, int));
 
+  // Description:
+  // Get the functions that interpolate many points at once.
+  virtual void GetPointsInterpolationFunc(
+    void (**doublefunc)(
+      vtkInterpolationInfo *, const double *, double *, int));
+  virtual void GetPointsInterpolationFunc(
+    void (**floatfunc)(
+      vtkInterpolationInfo *, const float *, float *, int));
+
   int InterpolationMode;
 
 private:
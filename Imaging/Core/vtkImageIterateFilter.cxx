@@ -182,7 +182,12 @@ int vtkImageIterateFilter::RequestData(vtkInformation* request,
       return 0;
       }
 
-    if(in->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
+    // the input of the first iteration may still be needed by others,
+    // the executive knows when it can be released
+    vtkDemandDrivenPipeline* executive =
+      vtkDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+    if(in->Get(vtkDemandDrivenPipeline::RELEASE_DATA()) &&
+       (i > 0 || !executive || executive->NeedToReleaseInputData(in)))
       {
       vtkDataObject* inData = in->Get(vtkDataObject::DATA_OBJECT());
       inData->ReleaseData();
@@ -2072,6 +2072,14 @@ void vtkImageResliceExecute(vtkImageReslice *self,
     floatPtr = new F [inComponents*(outExt[1] - outExt[0] + nsamples)];
     }
 
+  // without slabs, store the points for the row and interpolate them
+  // all at once, since this is much faster than one point at a time
+  F *pointPtr = 0;
+  if (!optimizeNearest && nsamples <= 1)
+    {
+    pointPtr = new F [3*(outExt[1] - outExt[0] + 1)];
+    }
+
   // set color for area outside of input volume extent
   void *background;
   vtkAllocBackgroundPixel(&background,
@@ -2169,10 +2177,21 @@ void vtkImageResliceExecute(vtkImageReslice *self,
 
                 if (interpolator->CheckBoundsIJK(inPoint))
                   {
-                  // do the interpolation
                   sampleCount++;
                   isInBounds = 1;
-                  interpolator->InterpolateIJK(inPoint, tmpPtr);
+                  if (pointPtr)
+                    {
+                    // save the point, interpolate the segment later
+                    F *savePoint = pointPtr + 3*(idX - idXmin);
+                    savePoint[0] = inPoint[0];
+                    savePoint[1] = inPoint[1];
+                    savePoint[2] = inPoint[2];
+                    }
+                  else
+                    {
+                    // do the interpolation
+                    interpolator->InterpolateIJK(inPoint, tmpPtr);
+                    }
                   tmpPtr += inComponents;
                   }
                 }
@@ -2194,6 +2213,13 @@ void vtkImageResliceExecute(vtkImageReslice *self,
 
             if (wasInBounds)
               {
+              if (pointPtr)
+                {
+                interpolator->InterpolatePointsIJK(
+                  pointPtr + 3*(startIdX - idXmin),
+                  tmpPtr - inComponents*(idX - startIdX), numpixels);
+                }
+
               if (outputStencil)
                 {
                 outputStencil->InsertNextExtent(startIdX, endIdX, idY, idZ);
@@ -2288,6 +2314,7 @@ void vtkImageResliceExecute(vtkImageReslice *self,
   if (!optimizeNearest)
     {
     delete [] floatPtr;
+    delete [] pointPtr;
     }
 }
 
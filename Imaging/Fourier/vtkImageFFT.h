@@ -19,9 +19,11 @@
 // the output is always complex doubles with real values in component0, and
 // imaginary values in component1.  The filter is fastest for images that
 // have power of two sizes.  The filter uses a butterfly diagram for each
-// prime factor of the dimension.  This makes images with prime number dimensions
-// (i.e. 17x17) much slower to compute.  Multi dimensional (i.e volumes)
-// FFT's are decomposed so that each axis executes serially.
+// prime factor of the dimension, and images with large prime factors in
+// their dimensions (i.e. 257x257) are computed as convolutions of power of
+// two size.  Multi dimensional (i.e volumes) FFT's are decomposed so that
+// each axis executes serially, with the rows of each axis computed in
+// parallel.  Real input (one component) is transformed in half the time.
 
 
 #ifndef __vtkImageFFT_h
@@ -58,14 +60,9 @@ protected:
   virtual int IterativeRequestUpdateExtent(vtkInformation* in,
                                            vtkInformation* out);
 
-  virtual void ThreadedRequestData(
-    vtkInformation* vtkNotUsed( request ),
-    vtkInformationVector** inputVector,
-    vtkInformationVector* vtkNotUsed( outputVector ),
-    vtkImageData ***inDataVec,
-    vtkImageData **outDataVec,
-    int outExt[6],
-    int threadId);
+  virtual int RequestData(vtkInformation* request,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
 private:
   vtkImageFFT(const vtkImageFFT&);  // Not implemented.
   void operator=(const vtkImageFFT&);  // Not implemented.
@@ -14,9 +14,652 @@
 =========================================================================*/
 #include "vtkImageFourierFilter.h"
 
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <vector>
 #include <math.h>
 
+/*=========================================================================
+        Transform plans.
+=========================================================================*/
+
+namespace
+{
+// Prime factors larger than this are handled with Bluestein's algorithm.
+const int vtkImageFourierMaxRadix = 23;
+
+//----------------------------------------------------------------------------
+// A plan for the complex transform of a given length and direction, which
+// is applied to a batch of interleaved lines: element j of line b is at
+// data[j*batch + b], so that all the butterflies of a stage run over
+// contiguous memory.  Lengths are factored into 4, 2, 3 and other primes
+// for a Stockham autosort transform with precomputed twiddle factors, and
+// lengths with a prime factor above vtkImageFourierMaxRadix are computed
+// as a convolution of power-of-two length (Bluestein's algorithm).
+// The plan is not modified by Execute(), so threads can share it.
+class vtkImageFourierPlan
+{
+public:
+  vtkImageFourierPlan(int n, int fb);
+  ~vtkImageFourierPlan() { delete this->Inner; }
+
+  // Description:
+  // The number of complex values needed for scratch space by Execute().
+  vtkIdType GetScratchSize(int batch) const;
+
+  // Description:
+  // Transform the lines in place.
+  void Execute(vtkImageComplex *data, int batch,
+               vtkImageComplex *scratch) const;
+
+private:
+  void ExecuteBluestein(vtkImageComplex *data, int batch,
+                        vtkImageComplex *scratch) const;
+
+  int N;
+  int FB;
+  std::vector<int> Factors;
+  // the twiddle factors for each stage, followed by its roots of unity
+  std::vector<vtkImageComplex> Twiddles;
+  // for Bluestein: the chirp, the transformed convolution kernel, and
+  // a forward plan for the power-of-two length of the convolution
+  std::vector<vtkImageComplex> Chirp;
+  std::vector<vtkImageComplex> Kernel;
+  vtkImageFourierPlan *Inner;
+
+  vtkImageFourierPlan(const vtkImageFourierPlan&);  // Not implemented.
+  void operator=(const vtkImageFourierPlan&);  // Not implemented.
+};
+
+//----------------------------------------------------------------------------
+// Compute exp(-fb*2*pi*i*k/n) without accumulating rounding errors.
+inline vtkImageComplex vtkImageFourierRoot(long long k, long long n, int fb)
+{
+  vtkImageComplex c;
+  double phase = -(2.0 * vtkMath::Pi()) * fb * static_cast<double>(k % n) / n;
+  vtkImageComplexPolarSet(c, 1.0, phase);
+  return c;
+}
+
+//----------------------------------------------------------------------------
+vtkImageFourierPlan::vtkImageFourierPlan(int n, int fb)
+{
+  this->N = n;
+  this->FB = fb;
+  this->Inner = 0;
+
+  // find the factors, using 4 as a factor whenever possible, so that
+  // the largest factor is the last one
+  int rest = n;
+  while (rest % 4 == 0)
+    {
+    this->Factors.push_back(4);
+    rest /= 4;
+    }
+  for (int p = 2; p*p <= rest; ++p)
+    {
+    while (rest % p == 0)
+      {
+      this->Factors.push_back(p);
+      rest /= p;
+      }
+    }
+  if (rest > 1)
+    {
+    this->Factors.push_back(rest);
+    }
+
+  if (!this->Factors.empty() &&
+      this->Factors.back() > vtkImageFourierMaxRadix)
+    {
+    // convolve with the chirp using a power-of-two length of at least 2n-1
+    this->Factors.clear();
+    int m = 1;
+    while (m < 2*n - 1)
+      {
+      m *= 2;
+      }
+    this->Inner = new vtkImageFourierPlan(m, 1);
+    this->Chirp.resize(n);
+    this->Kernel.resize(m);
+    for (int k = 0; k < m; ++k)
+      {
+      vtkImageComplexEuclidSet(this->Kernel[k], 0.0, 0.0);
+      }
+    for (int k = 0; k < n; ++k)
+      {
+      // exp(-fb*pi*i*k*k/n)
+      long long kk = static_cast<long long>(k)*k;
+      this->Chirp[k] = vtkImageFourierRoot(kk, 2*static_cast<long long>(n),
+                                           fb);
+      // the kernel includes the scale of the inverse transform
+      vtkImageComplexConjugate(this->Chirp[k], this->Kernel[k]);
+      vtkImageComplexScale(this->Kernel[k], 1.0/m, this->Kernel[k]);
+      if (k > 0)
+        {
+        this->Kernel[m - k] = this->Kernel[k];
+        }
+      }
+    std::vector<vtkImageComplex> scratch(this->Inner->GetScratchSize(1));
+    this->Inner->Execute(&this->Kernel[0], 1, &scratch[0]);
+    return;
+    }
+
+  // the twiddle factors of each stage, followed by its roots of unity
+  int length = n;
+  for (size_t i = 0; i < this->Factors.size(); ++i)
+    {
+    int p = this->Factors[i];
+    int m = length / p;
+    for (int q = 0; q < m; ++q)
+      {
+      for (int r = 1; r < p; ++r)
+        {
+        this->Twiddles.push_back(
+          vtkImageFourierRoot(static_cast<long long>(q)*r, length, fb));
+        }
+      }
+    for (int r = 0; r < p; ++r)
+      {
+      this->Twiddles.push_back(vtkImageFourierRoot(r, p, fb));
+      }
+    length = m;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkImageFourierPlan::GetScratchSize(int batch) const
+{
+  if (this->Inner)
+    {
+    vtkIdType m = static_cast<vtkIdType>(this->Kernel.size())*batch;
+    return m + this->Inner->GetScratchSize(batch);
+    }
+  return static_cast<vtkIdType>(this->N)*batch;
+}
+
+//----------------------------------------------------------------------------
+// One stage of the Stockham transform, for the radix p:
+//   y[t + s*(p*q + r)] = w^(q*r) * sum_j x[t + s*(q + j*m)] * u^(j*r)
+// where w and u are the roots of unity of orders p*m and p, and where
+// s includes the batch size.
+void vtkImageFourierRadix2(const vtkImageComplex *x, vtkImageComplex *y,
+                           int m, vtkIdType s, const vtkImageComplex *w)
+{
+  for (int q = 0; q < m; ++q)
+    {
+    vtkImageComplex wq = w[q];
+    const vtkImageComplex *x0 = x + s*q;
+    const vtkImageComplex *x1 = x + s*(q + m);
+    vtkImageComplex *y0 = y + s*2*q;
+    vtkImageComplex *y1 = y0 + s;
+    for (vtkIdType t = 0; t < s; ++t)
+      {
+      vtkImageComplex a = x0[t];
+      vtkImageComplex b = x1[t];
+      vtkImageComplex d;
+      vtkImageComplexAdd(a, b, y0[t]);
+      vtkImageComplexSubtract(a, b, d);
+      vtkImageComplexMultiply(d, wq, y1[t]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierRadix3(const vtkImageComplex *x, vtkImageComplex *y,
+                           int m, vtkIdType s, const vtkImageComplex *w,
+                           int fb)
+{
+  // sin(2*pi/3), with the sign of the transform
+  const double c = -0.86602540378443864676 * fb;
+  for (int q = 0; q < m; ++q)
+    {
+    vtkImageComplex w1 = w[2*q];
+    vtkImageComplex w2 = w[2*q + 1];
+    const vtkImageComplex *x0 = x + s*q;
+    const vtkImageComplex *x1 = x + s*(q + m);
+    const vtkImageComplex *x2 = x + s*(q + 2*m);
+    vtkImageComplex *y0 = y + s*3*q;
+    vtkImageComplex *y1 = y0 + s;
+    vtkImageComplex *y2 = y1 + s;
+    for (vtkIdType t = 0; t < s; ++t)
+      {
+      vtkImageComplex a = x0[t];
+      vtkImageComplex sum, dif, b, z1, z2;
+      vtkImageComplexAdd(x1[t], x2[t], sum);
+      vtkImageComplexSubtract(x1[t], x2[t], dif);
+      vtkImageComplexAdd(a, sum, y0[t]);
+      // a - sum/2 -/+ i*c*dif
+      b.Real = a.Real - 0.5*sum.Real;
+      b.Imag = a.Imag - 0.5*sum.Imag;
+      vtkImageComplexEuclidSet(z1, b.Real - c*dif.Imag, b.Imag + c*dif.Real);
+      vtkImageComplexEuclidSet(z2, b.Real + c*dif.Imag, b.Imag - c*dif.Real);
+      vtkImageComplexMultiply(z1, w1, y1[t]);
+      vtkImageComplexMultiply(z2, w2, y2[t]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierRadix4(const vtkImageComplex *x, vtkImageComplex *y,
+                           int m, vtkIdType s, const vtkImageComplex *w,
+                           int fb)
+{
+  for (int q = 0; q < m; ++q)
+    {
+    vtkImageComplex w1 = w[3*q];
+    vtkImageComplex w2 = w[3*q + 1];
+    vtkImageComplex w3 = w[3*q + 2];
+    const vtkImageComplex *x0 = x + s*q;
+    const vtkImageComplex *x1 = x + s*(q + m);
+    const vtkImageComplex *x2 = x + s*(q + 2*m);
+    const vtkImageComplex *x3 = x + s*(q + 3*m);
+    vtkImageComplex *y0 = y + s*4*q;
+    vtkImageComplex *y1 = y0 + s;
+    vtkImageComplex *y2 = y1 + s;
+    vtkImageComplex *y3 = y2 + s;
+    for (vtkIdType t = 0; t < s; ++t)
+      {
+      vtkImageComplex s02, d02, s13, d13, z;
+      vtkImageComplexAdd(x0[t], x2[t], s02);
+      vtkImageComplexSubtract(x0[t], x2[t], d02);
+      vtkImageComplexAdd(x1[t], x3[t], s13);
+      vtkImageComplexSubtract(x1[t], x3[t], d13);
+      // multiply d13 by the root of order 4, which is -i*fb
+      vtkImageComplexEuclidSet(z, fb*d13.Imag, -fb*d13.Real);
+      vtkImageComplexAdd(s02, s13, y0[t]);
+      vtkImageComplex z1, z2, z3;
+      vtkImageComplexAdd(d02, z, z1);
+      vtkImageComplexSubtract(s02, s13, z2);
+      vtkImageComplexSubtract(d02, z, z3);
+      vtkImageComplexMultiply(z1, w1, y1[t]);
+      vtkImageComplexMultiply(z2, w2, y2[t]);
+      vtkImageComplexMultiply(z3, w3, y3[t]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierRadixN(const vtkImageComplex *x, vtkImageComplex *y,
+                           int p, int m, vtkIdType s,
+                           const vtkImageComplex *w,
+                           const vtkImageComplex *u)
+{
+  vtkImageComplex a[vtkImageFourierMaxRadix];
+  for (int q = 0; q < m; ++q)
+    {
+    const vtkImageComplex *wq = w + (p - 1)*q;
+    for (vtkIdType t = 0; t < s; ++t)
+      {
+      for (int j = 0; j < p; ++j)
+        {
+        a[j] = x[t + s*(q + j*m)];
+        }
+      for (int r = 0; r < p; ++r)
+        {
+        vtkImageComplex sum = a[0];
+        int k = 0;
+        for (int j = 1; j < p; ++j)
+          {
+          k += r;
+          k -= (k >= p ? p : 0);
+          vtkImageComplex temp;
+          vtkImageComplexMultiply(a[j], u[k], temp);
+          vtkImageComplexAdd(sum, temp, sum);
+          }
+        if (r > 0)
+          {
+          vtkImageComplexMultiply(sum, wq[r - 1], sum);
+          }
+        y[t + s*(p*q + r)] = sum;
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierPlan::Execute(vtkImageComplex *data, int batch,
+                                  vtkImageComplex *scratch) const
+{
+  if (this->Inner)
+    {
+    this->ExecuteBluestein(data, batch, scratch);
+    return;
+    }
+
+  vtkImageComplex *x = data;
+  vtkImageComplex *y = scratch;
+  const vtkImageComplex *w = (this->Twiddles.empty() ? 0 :
+                              &this->Twiddles[0]);
+  int length = this->N;
+  vtkIdType s = batch;
+  for (size_t i = 0; i < this->Factors.size(); ++i)
+    {
+    int p = this->Factors[i];
+    int m = length / p;
+    switch (p)
+      {
+      case 2:
+        vtkImageFourierRadix2(x, y, m, s, w);
+        break;
+      case 3:
+        vtkImageFourierRadix3(x, y, m, s, w, this->FB);
+        break;
+      case 4:
+        vtkImageFourierRadix4(x, y, m, s, w, this->FB);
+        break;
+      default:
+        vtkImageFourierRadixN(x, y, p, m, s, w, w + (p - 1)*m);
+        break;
+      }
+    w += (p - 1)*m + p;
+    length = m;
+    s *= p;
+    vtkImageComplex *tmp = x;
+    x = y;
+    y = tmp;
+    }
+
+  // if the results ended up in the scratch space, copy them
+  if (x != data)
+    {
+    vtkIdType size = static_cast<vtkIdType>(this->N)*batch;
+    for (vtkIdType i = 0; i < size; ++i)
+      {
+      data[i] = x[i];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Bluestein's algorithm: the transform is the chirp times the convolution
+// of the chirp-multiplied data with the conjugate chirp, and the inverse
+// transform for the convolution is computed by conjugating the forward one.
+void vtkImageFourierPlan::ExecuteBluestein(vtkImageComplex *data, int batch,
+                                           vtkImageComplex *scratch) const
+{
+  int n = this->N;
+  int m = static_cast<int>(this->Kernel.size());
+  vtkImageComplex *a = scratch;
+  vtkImageComplex *inner = scratch + static_cast<vtkIdType>(m)*batch;
+
+  for (int k = 0; k < n; ++k)
+    {
+    vtkImageComplex c = this->Chirp[k];
+    for (int b = 0; b < batch; ++b)
+      {
+      vtkImageComplexMultiply(data[k*batch + b], c, a[k*batch + b]);
+      }
+    }
+  for (vtkIdType i = static_cast<vtkIdType>(n)*batch;
+       i < static_cast<vtkIdType>(m)*batch; ++i)
+    {
+    vtkImageComplexEuclidSet(a[i], 0.0, 0.0);
+    }
+
+  this->Inner->Execute(a, batch, inner);
+  for (int k = 0; k < m; ++k)
+    {
+    vtkImageComplex c = this->Kernel[k];
+    for (int b = 0; b < batch; ++b)
+      {
+      vtkImageComplex *v = &a[static_cast<vtkIdType>(k)*batch + b];
+      vtkImageComplexMultiply(*v, c, *v);
+      v->Imag = -v->Imag;
+      }
+    }
+  this->Inner->Execute(a, batch, inner);
+
+  for (int k = 0; k < n; ++k)
+    {
+    vtkImageComplex c = this->Chirp[k];
+    for (int b = 0; b < batch; ++b)
+      {
+      vtkImageComplex v = a[k*batch + b];
+      v.Imag = -v.Imag;
+      vtkImageComplexMultiply(v, c, data[k*batch + b]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// A plan for the forward transform of real lines of even length n.  The
+// even and odd samples are packed into the real and imaginary parts of a
+// complex line of length n/2, and the spectrum is recovered from the
+// transform of the packed line, which halves the work.
+class vtkImageFourierRealPlan
+{
+public:
+  vtkImageFourierRealPlan(int n) : Half(n/2, 1)
+    {
+    this->N = n;
+    this->Twiddles.resize(n/2);
+    for (int k = 0; k < n/2; ++k)
+      {
+      this->Twiddles[k] = vtkImageFourierRoot(k, n, 1);
+      }
+    }
+
+  vtkIdType GetScratchSize(int batch) const
+    {
+    return this->Half.GetScratchSize(batch);
+    }
+
+  // Description:
+  // Transform the n/2 packed values of each line in "in" (which is
+  // modified) and store the n values of the spectrum in "out".
+  void Execute(vtkImageComplex *in, vtkImageComplex *out, int batch,
+               vtkImageComplex *scratch) const;
+
+private:
+  int N;
+  vtkImageFourierPlan Half;
+  std::vector<vtkImageComplex> Twiddles;
+};
+
+//----------------------------------------------------------------------------
+void vtkImageFourierRealPlan::Execute(vtkImageComplex *in,
+                                      vtkImageComplex *out, int batch,
+                                      vtkImageComplex *scratch) const
+{
+  int n = this->N;
+  int m = n/2;
+  this->Half.Execute(in, batch, scratch);
+
+  for (int b = 0; b < batch; ++b)
+    {
+    vtkImageComplex z = in[b];
+    vtkImageComplexEuclidSet(out[b], z.Real + z.Imag, 0.0);
+    vtkImageComplexEuclidSet(out[m*batch + b], z.Real - z.Imag, 0.0);
+    }
+  for (int k = 1; k < m; ++k)
+    {
+    vtkImageComplex w = this->Twiddles[k];
+    const vtkImageComplex *z1 = in + k*batch;
+    const vtkImageComplex *z2 = in + (m - k)*batch;
+    vtkImageComplex *x1 = out + k*batch;
+    vtkImageComplex *x2 = out + (n - k)*batch;
+    for (int b = 0; b < batch; ++b)
+      {
+      // the transforms of the even and odd samples
+      vtkImageComplex e, o;
+      vtkImageComplexEuclidSet(e, 0.5*(z1[b].Real + z2[b].Real),
+                               0.5*(z1[b].Imag - z2[b].Imag));
+      vtkImageComplexEuclidSet(o, 0.5*(z1[b].Imag + z2[b].Imag),
+                               0.5*(z2[b].Real - z1[b].Real));
+      vtkImageComplexMultiply(o, w, o);
+      vtkImageComplexAdd(e, o, x1[b]);
+      vtkImageComplexConjugate(x1[b], x2[b]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Transform blocks of lines along one axis, where the lines of each block
+// are adjacent along the fastest of the other axes, so that gathering a
+// block into a batch reads whole cache lines.  The input has one or more
+// components (the first two are the real and imaginary parts), and the
+// output is complex and may be the same memory as the input.
+template <class T>
+class vtkImageFourierLines
+{
+public:
+  const vtkImageFourierPlan *Plan;
+  const vtkImageFourierRealPlan *RealPlan;
+  const T *InPtr;
+  int InComponents;
+  vtkIdType InIncs[3];
+  double *OutPtr;
+  vtkIdType OutIncs[3];
+  int Length;
+  int Size[2];
+  int Batch;
+  double Scale;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    int n = this->Length;
+    int batch = this->Batch;
+    int blocks = (this->Size[0] + batch - 1)/batch;
+    std::vector<vtkImageComplex> data(static_cast<size_t>(n)*batch);
+    std::vector<vtkImageComplex> spectrum;
+    std::vector<vtkImageComplex> scratch;
+    if (this->RealPlan)
+      {
+      spectrum.resize(static_cast<size_t>(n)*batch);
+      scratch.resize(this->RealPlan->GetScratchSize(batch));
+      }
+    else
+      {
+      scratch.resize(this->Plan->GetScratchSize(batch));
+      }
+
+    for (vtkIdType block = begin; block < end; ++block)
+      {
+      int first = static_cast<int>(block % blocks)*batch;
+      int idx2 = static_cast<int>(block / blocks);
+      int count = std::min(batch, this->Size[0] - first);
+      const T *inPtr = this->InPtr + first*this->InIncs[1] +
+        idx2*this->InIncs[2];
+      double *outPtr = this->OutPtr + first*this->OutIncs[1] +
+        idx2*this->OutIncs[2];
+      vtkImageComplex *result = &data[0];
+
+      if (this->RealPlan)
+        {
+        // pack the even and odd samples of real lines
+        for (int j = 0; j < n/2; ++j)
+          {
+          const T *ptr = inPtr + 2*j*this->InIncs[0];
+          vtkImageComplex *p = &data[j*count];
+          for (int b = 0; b < count; ++b)
+            {
+            p[b].Real = static_cast<double>(ptr[0]);
+            p[b].Imag = static_cast<double>(ptr[this->InIncs[0]]);
+            ptr += this->InIncs[1];
+            }
+          }
+        this->RealPlan->Execute(&data[0], &spectrum[0], count, &scratch[0]);
+        result = &spectrum[0];
+        }
+      else
+        {
+        for (int j = 0; j < n; ++j)
+          {
+          const T *ptr = inPtr + j*this->InIncs[0];
+          vtkImageComplex *p = &data[j*count];
+          for (int b = 0; b < count; ++b)
+            {
+            p[b].Real = static_cast<double>(ptr[0]);
+            p[b].Imag = (this->InComponents > 1 ?
+                         static_cast<double>(ptr[1]) : 0.0);
+            ptr += this->InIncs[1];
+            }
+          }
+        this->Plan->Execute(&data[0], count, &scratch[0]);
+        }
+
+      for (int j = 0; j < n; ++j)
+        {
+        double *ptr = outPtr + j*this->OutIncs[0];
+        const vtkImageComplex *p = result + j*count;
+        for (int b = 0; b < count; ++b)
+          {
+          ptr[0] = p[b].Real*this->Scale;
+          ptr[1] = p[b].Imag*this->Scale;
+          ptr += this->OutIncs[1];
+          }
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Transform the lines along an axis of the extent.
+template <class T>
+void vtkImageFourierExecuteAxis(
+  int axis, int fb, int ext[6],
+  const T *inPtr, int inComponents, vtkIdType inIncs[3],
+  double *outPtr, vtkIdType outIncs[3])
+{
+  // the lines of a block are adjacent along axis1
+  int axis1 = (axis == 0 ? 1 : 0);
+  int axis2 = (axis == 2 ? 1 : 2);
+  int n = ext[2*axis+1] - ext[2*axis] + 1;
+
+  vtkImageFourierLines<T> lines;
+  lines.InPtr = inPtr;
+  lines.InComponents = inComponents;
+  lines.InIncs[0] = inIncs[axis];
+  lines.InIncs[1] = inIncs[axis1];
+  lines.InIncs[2] = inIncs[axis2];
+  lines.OutPtr = outPtr;
+  lines.OutIncs[0] = outIncs[axis];
+  lines.OutIncs[1] = outIncs[axis1];
+  lines.OutIncs[2] = outIncs[axis2];
+  lines.Length = n;
+  lines.Size[0] = ext[2*axis1+1] - ext[2*axis1] + 1;
+  lines.Size[1] = ext[2*axis2+1] - ext[2*axis2] + 1;
+  // the inverse transform is scaled by 1/n
+  lines.Scale = (fb == -1 ? 1.0/n : 1.0);
+
+  // keep a batch of lines within about 128k, but use at least a few
+  // lines to make use of the cache lines along axis1
+  lines.Batch = std::max(4, std::min(16, 8192/n));
+  lines.Batch = std::min(lines.Batch, lines.Size[0]);
+
+  // the real transform only applies to the first axis, because the
+  // input of the other axes is the complex output
+  vtkImageFourierPlan *plan = 0;
+  vtkImageFourierRealPlan *realPlan = 0;
+  if (fb == 1 && inComponents == 1 && n % 2 == 0)
+    {
+    realPlan = new vtkImageFourierRealPlan(n);
+    }
+  else
+    {
+    plan = new vtkImageFourierPlan(n, fb);
+    }
+  lines.Plan = plan;
+  lines.RealPlan = realPlan;
+
+  vtkIdType blocks = (lines.Size[0] + lines.Batch - 1)/lines.Batch;
+  vtkSMPTools::For(0, blocks*lines.Size[1], lines);
+
+  delete plan;
+  delete realPlan;
+}
+
+} // end anonymous namespace
+
+
 /*=========================================================================
         Vectors of complex numbers.
 =========================================================================*/
@@ -144,69 +787,123 @@ void vtkImageFourierFilter::ExecuteFftStepN(vtkImageComplex *p_in,
 
 //----------------------------------------------------------------------------
 // This function calculates the whole fft (or rfft) of an array.
-// The contents of the input array are changed.
-// It is engineered for no decimation so input and output cannot be equal.
+// The contents of the input array are not changed.
 // (fb = 1) => fft, (fb = -1) => rfft;
 void vtkImageFourierFilter::ExecuteFftForwardBackward(vtkImageComplex *in,
                                                       vtkImageComplex *out,
                                                       int N, int fb)
 {
-  vtkImageComplex *p1, *p2, *p3;
-  int block_size = 1;
-  int rest_size = N;
-  int n = 2;
-  int idx;
+  vtkImageFourierPlan plan(N, fb);
+  std::vector<vtkImageComplex> scratch(plan.GetScratchSize(1));
 
   // If this is a reverse transform (scale accordingly).
-  if(fb == -1)
+  double scale = (fb == -1 ? 1.0/N : 1.0);
+  for (int idx = 0; idx < N; ++idx)
     {
-    p1 = in;
-    for(idx = 0; idx < N; ++idx)
+    vtkImageComplexScale(out[idx], scale, in[idx]);
+    }
+
+  plan.Execute(out, 1, &scratch[0]);
+}
+
+//----------------------------------------------------------------------------
+// The axes are transformed one after the other in the output data (or in
+// a temporary image if only part of the output was requested), instead of
+// executing the iterations of the superclass with an image for each axis.
+int vtkImageFourierFilter::RequestDataForwardBackward(
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector,
+  int fb)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkImageData *inData = vtkImageData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkImageData *outData = vtkImageData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  int outExt[6], wholeExt[6], ext[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  this->AllocateOutputData(outData, outInfo, outExt);
+  this->CopyAttributeData(inData, outData, inputVector);
+
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] ||
+      outExt[4] > outExt[5])
+    {
+    return 1;
+    }
+
+  // Input has to have real components at least.
+  if (inData->GetPointData()->GetScalars() == 0 ||
+      inData->GetNumberOfScalarComponents() < 1)
+    {
+    vtkErrorMacro(<< "Execute: No real components");
+    return 0;
+    }
+
+  // the transformed axes use their whole extent
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  bool partial = false;
+  for (int idx = 0; idx < 6; ++idx)
+    {
+    ext[idx] = outExt[idx];
+    if (idx < 2*this->Dimensionality)
       {
-      p1->Real = p1->Real / N;
-      p1->Imag = p1->Imag / N;
-      ++p1;
+      ext[idx] = wholeExt[idx];
+      partial |= (ext[idx] != outExt[idx]);
       }
     }
-  p1 = in;
-  p2 = out;
-  while(block_size < N && n <= N)
+
+  vtkImageData *workData = outData;
+  if (partial)
     {
-    if((rest_size % n) == 0)
+    workData = vtkImageData::New();
+    workData->SetExtent(ext);
+    workData->AllocateScalars(VTK_DOUBLE, 2);
+    }
+  double *workPtr = static_cast<double *>(
+    workData->GetScalarPointerForExtent(ext));
+  vtkIdType *workIncs = workData->GetIncrements();
+
+  // the first axis converts the input to complex values
+  void *inPtr = inData->GetScalarPointerForExtent(ext);
+  vtkIdType *inIncs = inData->GetIncrements();
+  int numComponents = inData->GetNumberOfScalarComponents();
+  int rval = 1;
+  switch (inData->GetScalarType())
+    {
+    vtkTemplateMacro(
+      vtkImageFourierExecuteAxis(0, fb, ext, static_cast<VTK_TT *>(inPtr),
+                                 numComponents, inIncs, workPtr, workIncs));
+    default:
+      vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      rval = 0;
+    }
+  this->UpdateProgress(1.0/this->Dimensionality);
+
+  // the other axes are transformed in place
+  for (int axis = 1; rval && axis < this->Dimensionality; ++axis)
+    {
+    if (this->AbortExecute)
       {
-      // n is a prime factor, perform one "butterfly" stage of the fft.
-      if(n == 2)
-        {
-        this->ExecuteFftStep2(p1, p2, N, block_size, fb);
-        }
-      else
-        {
-        this->ExecuteFftStepN(p1, p2, N, block_size, n, fb);
-        }
-      block_size = block_size * n;
-      rest_size = rest_size / n;
-      // switch input and output.
-      p3 = p1;
-      p1 = p2;
-      p2 = p3;
+      break;
       }
-    else
+    if (ext[2*axis] < ext[2*axis+1])
       {
-      // n is not a prime factor. increment n to see if n+1 is.
-      ++n;
+      vtkImageFourierExecuteAxis(axis, fb, ext, workPtr, 2, workIncs,
+                                 workPtr, workIncs);
       }
+    this->UpdateProgress((axis + 1.0)/this->Dimensionality);
     }
-  // If the results ended up in the input, copy to output.
-  if(p1 != out)
+
+  if (workData != outData)
     {
-    for(n = 0; n < N; ++n)
-      {
-      *out++ = *p1++;
-      }
+    outData->CopyAndCastFrom(workData, outExt);
+    workData->Delete();
     }
-}
-
 
+  return rval;
+}
 
 //----------------------------------------------------------------------------
 // This function calculates the whole fft of an array.
@@ -18,6 +18,13 @@
 // this superclass is a container for methods that manipulate these structure
 // including fast Fourier transforms.  Complex numbers may become a class.
 // This should really be a helper class.
+//
+// The transforms use mixed radix butterflies (4, 2, 3 and other small
+// primes) for any length, and Bluestein's algorithm for lengths with
+// a large prime factor.  The subclasses transform all of the axes within
+// a single output image, computing blocks of adjacent rows together with
+// the rows shared among threads, and real input is packed into complex
+// rows of half the length.
 #ifndef __vtkImageFourierFilter_h
 #define __vtkImageFourierFilter_h
 
@@ -95,15 +102,13 @@ public:
 
   // Description:
   // This function calculates the whole fft of an array.
-  // The contents of the input array are changed.
-  // (It is engineered for no decimation)
+  // The input and output arrays can be the same.
   void ExecuteFft(vtkImageComplex *in, vtkImageComplex *out, int N);
 
 
   // Description:
-  // This function calculates the whole fft of an array.
-  // The contents of the input array are changed.
-  // (It is engineered for no decimation)
+  // This function calculates the whole inverse fft of an array.
+  // The input and output arrays can be the same.
   void ExecuteRfft(vtkImageComplex *in, vtkImageComplex *out, int N);
 
   //ETX
@@ -112,7 +117,17 @@ protected:
   vtkImageFourierFilter() {};
   ~vtkImageFourierFilter() {};
 
+  // Description:
+  // Compute the forward (fb = 1) or reverse (fb = -1) transform along
+  // the first Dimensionality axes, for RequestData() of the subclasses.
+  int RequestDataForwardBackward(vtkInformationVector **inputVector,
+                                 vtkInformationVector *outputVector,
+                                 int fb);
+
   //BTX
+  // Description:
+  // The butterfly steps of the original transform, which are no longer
+  // used by ExecuteFft() and ExecuteRfft().
   void ExecuteFftStep2(vtkImageComplex *p_in, vtkImageComplex *p_out,
                        int N, int bsize, int fb);
   void ExecuteFftStepN(vtkImageComplex *p_in, vtkImageComplex *p_out,
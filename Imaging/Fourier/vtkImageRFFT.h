@@ -19,9 +19,11 @@
 // the output is always complex doubles with real values in component0, and
 // imaginary values in component1.  The filter is fastest for images that
 // have power of two sizes.  The filter uses a butterfly fitlers for each
-// prime factor of the dimension.  This makes images with prime number dimensions
-// (i.e. 17x17) much slower to compute.  Multi dimensional (i.e volumes)
-// FFT's are decomposed so that each axis executes in series.
+// prime factor of the dimension, and images with large prime factors in
+// their dimensions (i.e. 257x257) are computed as convolutions of power of
+// two size.  Multi dimensional (i.e volumes) FFT's are decomposed so that
+// each axis executes in series, with the rows of each axis computed in
+// parallel.
 // In most cases the RFFT will produce an image whose imaginary values are all
 // zero's. In this case vtkImageExtractComponents can be used to remove
 // this imaginary components leaving only the real image.
@@ -64,14 +66,9 @@ protected:
   virtual int IterativeRequestUpdateExtent(vtkInformation* in,
                                            vtkInformation* out);
 
-  virtual void ThreadedRequestData(
-    vtkInformation* vtkNotUsed( request ),
-    vtkInformationVector** inputVector,
-    vtkInformationVector* vtkNotUsed( outputVector ),
-    vtkImageData ***inDataVec,
-    vtkImageData **outDataVec,
-    int outExt[6],
-    int threadId);
+  virtual int RequestData(vtkInformation* request,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
 private:
   vtkImageRFFT(const vtkImageRFFT&);  // Not implemented.
   void operator=(const vtkImageRFFT&);  // Not implemented.
@@ -107,6 +107,7 @@ vtkSmartPointer<vtkDataArray> vtkTableFFT::DoFFT(vtkDataArray *input)
 
   // Compute the FFT
   VTK_CREATE(vtkImageFFT, fft);
+  fft->SetDimensionality(1);
   fft->SetInputData(imgInput);
   fft->Update();
 
@@ -14,12 +14,17 @@
 =========================================================================*/
 #include "vtkImageEuclideanDistance.h"
 
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <vector>
 #include <math.h>
 
 vtkStandardNewMacro(vtkImageEuclideanDistance);
@@ -32,6 +37,8 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  this->SignedDistance = 0;
+  this->ComputeFeatureIds = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -662,6 +669,446 @@ int vtkImageEuclideanDistance::IterativeRequestData(
 }
 
 
+//----------------------------------------------------------------------------
+// The linear algorithm transforms blocks of rows along one axis.  The rows
+// of a block are adjacent along the fastest of the other axes, and they
+// are gathered together so that the strided axes read whole cache lines.
+// Along the first axis, the distances to the zero voxels of each row are
+// found with two scans as in Saito's algorithm.  Along the other axes,
+// the lower envelope of the parabolas rooted at the distances from the
+// previous axes is computed as described by Felzenszwalb and Huttenlocher.
+template <class T>
+class vtkImageEuclideanDistanceRows
+{
+public:
+  const T *InPtr;
+  vtkIdType InIncs[3];
+  double *OutPtr;
+  vtkIdType *IdPtr;
+  vtkIdType OutIncs[3];
+  const double *Sq;
+  double MaximumDistance;
+  int Initialize;
+  int Invert;
+  int First;
+  int Length;
+  int Size[2];
+  int Batch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    int n = this->Length;
+    int batch = this->Batch;
+    int blocks = (this->Size[0] + batch - 1)/batch;
+    std::vector<double> f(static_cast<size_t>(n)*batch);
+    std::vector<vtkIdType> ids(this->IdPtr ? f.size() : 0);
+    std::vector<int> v(n);
+    std::vector<double> z(2*n + 2);
+    std::vector<double> g(n);
+    std::vector<vtkIdType> gids(this->IdPtr ? n : 0);
+
+    for (vtkIdType block = begin; block < end; ++block)
+      {
+      int first = static_cast<int>(block % blocks)*batch;
+      int idx2 = static_cast<int>(block / blocks);
+      int count = std::min(batch, this->Size[0] - first);
+      vtkIdType offset = first*this->OutIncs[1] + idx2*this->OutIncs[2];
+      const T *inPtr = this->InPtr + first*this->InIncs[1] +
+        idx2*this->InIncs[2];
+
+      // gather the rows
+      for (int j = 0; j < n; ++j)
+        {
+        const T *ptr = inPtr + j*this->InIncs[0];
+        for (int b = 0; b < count; ++b)
+          {
+          f[b*n + j] = static_cast<double>(*ptr);
+          ptr += this->InIncs[1];
+          }
+        }
+      if (this->First && (this->Initialize || this->Invert))
+        {
+        // the input is used as a mask, which is inverted for the
+        // distances of the zero voxels, rather than as starting distances
+        double maxDist = this->MaximumDistance;
+        for (int i = 0; i < count*n; ++i)
+          {
+          f[i] = ((f[i] == 0) != (this->Invert != 0) ? 0.0 : maxDist);
+          }
+        }
+      if (this->IdPtr)
+        {
+        for (int j = 0; j < n; ++j)
+          {
+          const vtkIdType *ptr = this->IdPtr + offset + j*this->OutIncs[0];
+          for (int b = 0; b < count; ++b)
+            {
+            ids[b*n + j] = (this->First ? -1 : *ptr);
+            ptr += this->OutIncs[1];
+            }
+          }
+        }
+
+      for (int b = 0; b < count; ++b)
+        {
+        vtkIdType *rowIds = (this->IdPtr ? &ids[b*n] : 0);
+        if (this->First)
+          {
+          this->ExecuteFirst(&f[b*n], rowIds,
+                             offset + b*this->OutIncs[1]);
+          }
+        else
+          {
+          this->ExecuteEnvelope(&f[b*n], rowIds, &v[0], &z[0], &g[0],
+                                (this->IdPtr ? &gids[0] : 0));
+          }
+        }
+
+      // scatter the rows
+      for (int j = 0; j < n; ++j)
+        {
+        double *ptr = this->OutPtr + offset + j*this->OutIncs[0];
+        for (int b = 0; b < count; ++b)
+          {
+          *ptr = f[b*n + j];
+          ptr += this->OutIncs[1];
+          }
+        }
+      if (this->IdPtr)
+        {
+        for (int j = 0; j < n; ++j)
+          {
+          vtkIdType *ptr = this->IdPtr + offset + j*this->OutIncs[0];
+          for (int b = 0; b < count; ++b)
+            {
+            *ptr = ids[b*n + j];
+            ptr += this->OutIncs[1];
+            }
+          }
+        }
+      }
+    }
+
+  // The distances to the nearest zero voxels of the row, forwards and
+  // backwards, where "offset" is the point id of the start of the row.
+  void ExecuteFirst(double *f, vtkIdType *ids, vtkIdType offset)
+    {
+    int n = this->Length;
+    vtkIdType inc = this->OutIncs[0];
+    int last = -1;
+    for (int i = 0; i < n; ++i)
+      {
+      if (f[i] == 0)
+        {
+        last = i;
+        if (ids)
+          {
+          ids[i] = offset + i*inc;
+          }
+        }
+      else
+        {
+        double d = (last >= 0 ? this->Sq[i - last] : this->MaximumDistance);
+        if (d < f[i])
+          {
+          f[i] = d;
+          if (ids)
+            {
+            ids[i] = (last >= 0 ? offset + last*inc : -1);
+            }
+          }
+        }
+      }
+    last = -1;
+    for (int i = n - 1; i >= 0; --i)
+      {
+      if (f[i] == 0)
+        {
+        last = i;
+        }
+      else
+        {
+        double d = (last >= 0 ? this->Sq[last - i] : this->MaximumDistance);
+        if (d < f[i])
+          {
+          f[i] = d;
+          if (ids)
+            {
+            ids[i] = (last >= 0 ? offset + last*inc : -1);
+            }
+          }
+        }
+      }
+    }
+
+  // The lower envelope of the parabolas f[q] + (p - q)^2.  The envelope
+  // is stored as the roots v[k] of the parabolas, their values g[k] and
+  // ids gids[k], and the positions where each becomes the lowest as the
+  // fractions z[2*k]/z[2*k+1], which are compared without dividing.
+  void ExecuteEnvelope(double *f, vtkIdType *ids, int *v, double *z,
+                       double *g, vtkIdType *gids)
+    {
+    int n = this->Length;
+    const double *sq = this->Sq;
+    // twice the square of the spacing
+    double s2 = 2*sq[1];
+    int k = 0;
+    v[0] = 0;
+    g[0] = f[0];
+    if (ids)
+      {
+      gids[0] = ids[0];
+      }
+    for (int q = 1; q < n; ++q)
+      {
+      double fq = f[q] + sq[q];
+      double num;
+      double den;
+      for (;;)
+        {
+        num = fq - (g[k] + sq[v[k]]);
+        den = s2*(q - v[k]);
+        // the first parabola is the lowest as far as -infinity
+        if (k == 0 || num*z[2*k+1] > z[2*k]*den)
+          {
+          break;
+          }
+        --k;
+        }
+      ++k;
+      v[k] = q;
+      z[2*k] = num;
+      z[2*k+1] = den;
+      g[k] = f[q];
+      if (ids)
+        {
+        gids[k] = ids[q];
+        }
+      }
+    // the last parabola is the lowest as far as +infinity
+    z[2*k+2] = 1.0;
+    z[2*k+3] = 0.0;
+
+    k = 0;
+    for (int p = 0; p < n; ++p)
+      {
+      while (z[2*k+2] < p*z[2*k+3])
+        {
+        ++k;
+        }
+      double d = g[k] + sq[p > v[k] ? p - v[k] : v[k] - p];
+      if (d < f[p])
+        {
+        f[p] = d;
+        if (ids)
+          {
+          ids[p] = gids[k];
+          }
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Transform the rows along one axis with the linear algorithm.
+template <class T>
+void vtkImageEuclideanDistanceLinearAxis(
+  vtkImageEuclideanDistance *self, int axis, int ext[6], double spacing,
+  const T *inPtr, vtkIdType inIncs[3], double *outPtr, vtkIdType *idPtr,
+  vtkIdType outIncs[3], int invert)
+{
+  // the rows of a block are adjacent along axis1
+  int axis1 = (axis == 0 ? 1 : 0);
+  int axis2 = (axis == 2 ? 1 : 2);
+  int n = ext[2*axis+1] - ext[2*axis] + 1;
+
+  // precompute the squares of the distances along the axis
+  std::vector<double> sq(n + 1);
+  for (int df = 0; df <= n; ++df)
+    {
+    sq[df] = df*df*spacing;
+    }
+
+  vtkImageEuclideanDistanceRows<T> rows;
+  rows.InPtr = inPtr;
+  rows.InIncs[0] = inIncs[axis];
+  rows.InIncs[1] = inIncs[axis1];
+  rows.InIncs[2] = inIncs[axis2];
+  rows.OutPtr = outPtr;
+  rows.IdPtr = idPtr;
+  rows.OutIncs[0] = outIncs[axis];
+  rows.OutIncs[1] = outIncs[axis1];
+  rows.OutIncs[2] = outIncs[axis2];
+  rows.Sq = &sq[0];
+  rows.MaximumDistance = self->GetMaximumDistance();
+  rows.Initialize = self->GetInitialize();
+  rows.Invert = invert;
+  rows.First = (axis == 0);
+  rows.Length = n;
+  rows.Size[0] = ext[2*axis1+1] - ext[2*axis1] + 1;
+  rows.Size[1] = ext[2*axis2+1] - ext[2*axis2] + 1;
+
+  // keep a block of rows within about 64k, but use at least a few rows
+  // to make use of the cache lines along axis1
+  rows.Batch = std::max(4, std::min(64, 8192/n));
+  rows.Batch = std::min(rows.Batch, rows.Size[0]);
+  if (outIncs[axis] == 1)
+    {
+    // the rows are contiguous and gain nothing from being gathered
+    rows.Batch = 1;
+    }
+
+  vtkIdType blocks = (rows.Size[0] + rows.Batch - 1)/rows.Batch;
+  vtkSMPTools::For(0, blocks*rows.Size[1], rows);
+}
+
+//----------------------------------------------------------------------------
+// Give the zero voxels minus their distance to the non-zero voxels.
+class vtkImageEuclideanDistanceSigned
+{
+public:
+  double *OutPtr;
+  vtkIdType *IdPtr;
+  const double *OutsidePtr;
+  const vtkIdType *OutsideIdPtr;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (this->OutPtr[i] == 0)
+        {
+        this->OutPtr[i] = -this->OutsidePtr[i];
+        if (this->IdPtr)
+          {
+          this->IdPtr[i] = this->OutsideIdPtr[i];
+          }
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Compute the distance map for the whole extent with the linear algorithm.
+void vtkImageEuclideanDistance::ExecuteLinear(vtkImageData *inData,
+                                              int ext[6], double *outPtr,
+                                              vtkIdType *idPtr, int invert)
+{
+  void *inPtr = inData->GetScalarPointerForExtent(ext);
+  vtkIdType *inIncs = inData->GetIncrements();
+  double *spacing = inData->GetSpacing();
+
+  // the output is contiguous over the extent
+  vtkIdType outIncs[3];
+  outIncs[0] = 1;
+  outIncs[1] = ext[1] - ext[0] + 1;
+  outIncs[2] = outIncs[1]*(ext[3] - ext[2] + 1);
+
+  int passes = this->Dimensionality*(this->SignedDistance ? 2 : 1);
+  for (int axis = 0; axis < this->Dimensionality; ++axis)
+    {
+    if (this->AbortExecute)
+      {
+      break;
+      }
+
+    double s = (this->ConsiderAnisotropy ? spacing[axis] : 1.0);
+    if (axis == 0)
+      {
+      switch (inData->GetScalarType())
+        {
+        vtkTemplateMacro(
+          vtkImageEuclideanDistanceLinearAxis(
+            this, axis, ext, s*s, static_cast<VTK_TT *>(inPtr), inIncs,
+            outPtr, idPtr, outIncs, invert));
+        default:
+          vtkErrorMacro(<< "Execute: Unknown ScalarType");
+          return;
+        }
+      }
+    else
+      {
+      vtkImageEuclideanDistanceLinearAxis(
+        this, axis, ext, s*s, outPtr, outIncs, outPtr, idPtr, outIncs,
+        invert);
+      }
+
+    this->UpdateProgress(
+      (invert*this->Dimensionality + axis + 1.0)/passes);
+    }
+}
+
+//----------------------------------------------------------------------------
+// The linear algorithm computes all axes within the output, the other
+// algorithms use the iterations of the superclass.
+int vtkImageEuclideanDistance::RequestData(
+  vtkInformation* request,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  if (this->Algorithm != VTK_EDT_LINEAR)
+    {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkImageData *inData = vtkImageData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkImageData *outData = vtkImageData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  int ext[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext);
+  this->AllocateOutputScalars(outData, ext, outInfo);
+
+  vtkDebugMacro(<<"Executing image euclidean distance");
+
+  if (ext[0] > ext[1] || ext[2] > ext[3] || ext[4] > ext[5])
+    {
+    return 1;
+    }
+
+  if (!inData->GetScalarPointerForExtent(ext))
+    {
+    vtkErrorMacro(<< "Execute: No scalars for update extent.")
+    return 1;
+    }
+
+  double *outPtr = static_cast<double *>(outData->GetScalarPointer());
+  vtkIdType numPts = outData->GetNumberOfPoints();
+  vtkIdType *idPtr = 0;
+  if (this->ComputeFeatureIds)
+    {
+    vtkIdTypeArray *ids = vtkIdTypeArray::New();
+    ids->SetName("FeatureIds");
+    ids->SetNumberOfTuples(numPts);
+    outData->GetPointData()->AddArray(ids);
+    idPtr = ids->GetPointer(0);
+    ids->Delete();
+    }
+
+  this->ExecuteLinear(inData, ext, outPtr, idPtr, 0);
+
+  if (this->SignedDistance && !this->AbortExecute)
+    {
+    // the distances of the zero voxels to the non-zero voxels
+    std::vector<double> outside(numPts);
+    std::vector<vtkIdType> outsideIds(idPtr ? numPts : 0);
+    this->ExecuteLinear(inData, ext, &outside[0],
+                        (idPtr ? &outsideIds[0] : 0), 1);
+
+    vtkImageEuclideanDistanceSigned sign;
+    sign.OutPtr = outPtr;
+    sign.IdPtr = idPtr;
+    sign.OutsidePtr = &outside[0];
+    sign.OutsideIdPtr = (idPtr ? &outsideIds[0] : 0);
+    vtkSMPTools::For(0, numPts, sign);
+    }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // For streaming and threads.  Splits output update extent into num pieces.
 // This method needs to be called num times.  Results must not overlap for
@@ -747,10 +1194,19 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << "Saito\n";
     }
+  else if ( this->Algorithm == VTK_EDT_LINEAR )
+    {
+    os << "Linear\n";
+    }
   else
     {
     os << "Saito Cached\n";
     }
+
+  os << indent << "Signed Distance: "
+     << (this->SignedDistance ? "On\n" : "Off\n");
+  os << indent << "Compute Feature Ids: "
+     << (this->ComputeFeatureIds ? "On\n" : "Off\n");
 }
 
 
@@ -29,6 +29,13 @@
 // slow it very significantly. In that case, one should use
 // ::SetAlgorithmToSaitoCached() instead for better performance.
 //
+// ::SetAlgorithmToLinear() selects the algorithm of Felzenszwalb and
+// Huttenlocher, which computes the same distances in a time that is
+// linear in the number of voxels, whatever the shape of the objects.
+// It transforms all of the axes within the output, with the rows of each
+// axis shared among threads, and it can also produce a signed distance
+// map and the ids of the nearest features.
+//
 // References:
 //
 // T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
@@ -38,6 +45,9 @@
 // O. Cuisenaire. Distance Transformation: fast algorithms and applications
 // to medical image processing. PhD Thesis, Universite catholique de Louvain,
 // October 1999. http://ltswww.epfl.ch/~cuisenai/papers/oc_thesis.pdf
+//
+// P. F. Felzenszwalb and D. P. Huttenlocher. Distance Transforms of
+// Sampled Functions. Theory of Computing, 8(19). pp. 415--428, 2012.
 
 
 #ifndef __vtkImageEuclideanDistance_h
@@ -48,6 +58,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_LINEAR 2
 
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
 {
@@ -93,13 +104,34 @@ public:
   // Selects a Euclidean DT algorithm.
   // 1. Saito
   // 2. Saito-cached
-  // More algorithms will be added later on.
+  // 3. Linear (Felzenszwalb and Huttenlocher)
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
   void SetAlgorithmToSaito ()
     { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached ()
     { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
+  void SetAlgorithmToLinear ()
+    { this->SetAlgorithm(VTK_EDT_LINEAR); }
+
+  // Description:
+  // Give negative distances to the zero voxels: each of them is set to
+  // minus the square of the distance to the nearest non-zero voxel.
+  // This is only done by the linear algorithm.  Off by default.
+  vtkSetMacro(SignedDistance, int);
+  vtkGetMacro(SignedDistance, int);
+  vtkBooleanMacro(SignedDistance, int);
+
+  // Description:
+  // Add a "FeatureIds" array to the output point data, with the point
+  // id of the zero voxel (or, for the zero voxels of a signed distance
+  // map, the non-zero voxel) that each distance was measured to.  The id
+  // is -1 where the distance is MaximumDistance, or comes from the input
+  // when Initialize is off.  This is only done by the linear algorithm.
+  // Off by default.
+  vtkSetMacro(ComputeFeatureIds, int);
+  vtkGetMacro(ComputeFeatureIds, int);
+  vtkBooleanMacro(ComputeFeatureIds, int);
 
   virtual int IterativeRequestData(vtkInformation*,
                                    vtkInformationVector**,
@@ -113,6 +145,8 @@ protected:
   int Initialize;
   int ConsiderAnisotropy;
   int Algorithm;
+  int SignedDistance;
+  int ComputeFeatureIds;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData *outData,
@@ -124,6 +158,17 @@ protected:
   virtual int IterativeRequestUpdateExtent(vtkInformation* in,
                                            vtkInformation* out);
 
+  virtual int RequestData(vtkInformation* request,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
+
+  // Description:
+  // Compute the distances along each axis with the linear algorithm,
+  // from the zero voxels of the input, or from the non-zero voxels if
+  // "invert" is set.  The ids of the features are stored if idPtr is set.
+  void ExecuteLinear(vtkImageData *inData, int ext[6], double *outPtr,
+                     vtkIdType *idPtr, int invert);
+
 private:
   vtkImageEuclideanDistance(const vtkImageEuclideanDistance&);  // Not implemented.
   void operator=(const vtkImageEuclideanDistance&);  // Not implemented.
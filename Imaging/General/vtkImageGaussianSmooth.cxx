@@ -18,9 +18,11 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <math.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageGaussianSmooth);
 
@@ -34,6 +36,10 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->Mode = VTK_GAUSSIAN_SMOOTH_FIR;
+  this->DerivativeOrders[0] = 0;
+  this->DerivativeOrders[1] = 0;
+  this->DerivativeOrders[2] = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -61,34 +67,99 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
      << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", "
      << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "Mode: " << this->GetModeAsString() << "\n";
+
+  os << indent << "DerivativeOrders: ( "
+     << this->DerivativeOrders[0] << ", "
+     << this->DerivativeOrders[1] << ", "
+     << this->DerivativeOrders[2] << " )\n";
+}
+
+//----------------------------------------------------------------------------
+const char *vtkImageGaussianSmooth::GetModeAsString()
+{
+  switch (this->Mode)
+    {
+    case VTK_GAUSSIAN_SMOOTH_FIR:
+      return "FIR";
+    case VTK_GAUSSIAN_SMOOTH_RECURSIVE:
+      return "Recursive";
+    }
+  return "";
+}
+
+//----------------------------------------------------------------------------
+int vtkImageGaussianSmooth::ComputeRadius(int axis)
+{
+  int radius = static_cast<int>(this->StandardDeviations[axis]
+                                * this->RadiusFactors[axis]);
+
+  // derivatives need at least the neighboring pixels
+  if (radius < 1 && this->DerivativeOrders[axis] != 0)
+    {
+    radius = 1;
+    }
+
+  return radius;
 }
 
 //----------------------------------------------------------------------------
 void vtkImageGaussianSmooth::ComputeKernel(double *kernel, int min, int max,
-                                           double std)
+                                           double std, int order)
 {
   int x;
   double sum;
 
   // handle special case
-  if (std == 0.0)
+  if (std == 0.0 && order == 0)
     {
     kernel[0] = 1.0;
     return;
     }
 
-  // fill in kernel
+  // fill in kernel, with equal weights for central differences
   sum = 0.0;
   for (x = min; x <= max; ++x)
     {
-    sum += kernel[x-min] =
-      exp(- (static_cast<double>(x*x)) / (std * std * 2.0));
+    sum += kernel[x-min] = (std == 0.0 ? 1.0 :
+      exp(- (static_cast<double>(x*x)) / (std * std * 2.0)));
+    }
+
+  if (order == 1)
+    {
+    // the derivative is weighted by x, and is normalized so that the
+    // response to a unit ramp is one
+    sum = 0.0;
+    for (x = min; x <= max; ++x)
+      {
+      kernel[x-min] *= x;
+      sum += x*kernel[x-min];
+      }
+    }
+  else if (order == 2)
+    {
+    // the second derivative is weighted by x*x minus a constant that
+    // gives it a zero sum, and is normalized so that the response to
+    // x*x/2 is one
+    double sum2 = 0.0;
+    for (x = min; x <= max; ++x)
+      {
+      sum2 += x*x*kernel[x-min];
+      }
+    double c = sum2/sum;
+    sum = 0.0;
+    for (x = min; x <= max; ++x)
+      {
+      kernel[x-min] *= x*x - c;
+      sum += 0.5*x*x*kernel[x-min];
+      }
     }
 
   // normalize
   for (x = min; x <= max; ++x)
     {
-    kernel[x-min] /= sum;
+    kernel[x-min] = (sum != 0.0 ? kernel[x-min]/sum : 0.0);
     }
 }
 
@@ -125,8 +196,15 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int *inExt,
   // Expand filtered axes
   for (idx = 0; idx < this->Dimensionality; ++idx)
     {
-    radius = static_cast<int>(this->StandardDeviations[idx]
-                              * this->RadiusFactors[idx]);
+    // the recursive filter needs whole rows
+    if (this->Mode == VTK_GAUSSIAN_SMOOTH_RECURSIVE)
+      {
+      inExt[idx*2] = wholeExtent[idx*2];
+      inExt[idx*2+1] = wholeExtent[idx*2+1];
+      continue;
+      }
+
+    radius = this->ComputeRadius(idx);
     inExt[idx*2] -= radius;
     if (inExt[idx*2] < wholeExtent[idx*2])
       {
@@ -236,6 +314,328 @@ vtkImageGaussianSmoothExecute(vtkImageGaussianSmooth *self, int axis,
     }
 }
 
+//----------------------------------------------------------------------------
+// The coefficients of the recursive gaussian of Deriche, as a sum of a
+// causal and an anti-causal fourth order filter:
+//   y[i] = N0*x[i] + ... + N3*x[i-3] - D1*y[i-1] - ... - D4*y[i-4]
+//   z[i] = M1*x[i+1] + ... + M4*x[i+4] - D1*z[i+1] - ... - D4*z[i+4]
+// The coefficients are normalized so that the filter, or its derivative,
+// has the same response as the gaussian to a constant, a ramp or x*x/2.
+class vtkImageGaussianSmoothIIR
+{
+public:
+  double N[4];
+  double M[4];
+  double D[4];
+
+  vtkImageGaussianSmoothIIR(double sigma, int order);
+
+  // Filter a line of n input values with stride inc, write the output
+  // values from position start to end into out with stride outInc.
+  template <class T>
+  void Filter(const T *in, vtkIdType inc, int n, T *out, vtkIdType outInc,
+              int start, int end, double *buffer) const;
+
+private:
+  static void ComputeN(double sigma, const double p[8], double n[4],
+                       double s[3]);
+  static void ComputeD(double sigma, const double p[8], double d[4],
+                       double s[3]);
+};
+
+//----------------------------------------------------------------------------
+// The parameters a1, b1, w1, l1, a2, b2, w2, l2 of the approximation
+//   (a1*cos(w1*x/sigma) + b1*sin(w1*x/sigma))*exp(l1*x/sigma) +
+//   (a2*cos(w2*x/sigma) + b2*sin(w2*x/sigma))*exp(l2*x/sigma)
+// for x >= 0, first for the gaussian from Deriche's 1990 paper, then for
+// the gaussian and its first and second derivatives with common poles
+// from his 1993 paper.  The first set is more accurate for smoothing.
+static const double vtkImageGaussianSmoothDeriche[4][8] = {
+  { 1.68, 3.735, 0.6318, -1.783, -0.6803, -0.2598, 1.997, -1.723 },
+  { 1.3530, 1.8151, 0.6681, -1.3932, -0.3531, 0.0902, 2.0787, -1.3732 },
+  { -0.6724, -3.4327, 0.6681, -1.3932, 0.6724, 0.6100, 2.0787, -1.3732 },
+  { -1.3563, 5.2318, 0.6681, -1.3932, 0.3446, -2.2355, 2.0787, -1.3732 }
+};
+
+//----------------------------------------------------------------------------
+// Compute the causal numerator, and its sums weighted by 1, i and i*i.
+void vtkImageGaussianSmoothIIR::ComputeN(double sigma, const double p[8],
+                                         double n[4], double s[3])
+{
+  double a1 = p[0], b1 = p[1], a2 = p[4], b2 = p[5];
+  double sin1 = sin(p[2]/sigma);
+  double sin2 = sin(p[6]/sigma);
+  double cos1 = cos(p[2]/sigma);
+  double cos2 = cos(p[6]/sigma);
+  double exp1 = exp(p[3]/sigma);
+  double exp2 = exp(p[7]/sigma);
+
+  n[0] = a1 + a2;
+  n[1] = exp2*(b2*sin2 - (a2 + 2*a1)*cos2) +
+         exp1*(b1*sin1 - (a1 + 2*a2)*cos1);
+  n[2] = 2*exp1*exp2*((a1 + a2)*cos2*cos1 - b1*cos2*sin1 - b2*cos1*sin2) +
+         a2*exp1*exp1 + a1*exp2*exp2;
+  n[3] = exp2*exp1*exp1*(b2*sin2 - a2*cos2) +
+         exp1*exp2*exp2*(b1*sin1 - a1*cos1);
+
+  s[0] = n[0] + n[1] + n[2] + n[3];
+  s[1] = n[1] + 2*n[2] + 3*n[3];
+  s[2] = n[1] + 4*n[2] + 9*n[3];
+}
+
+//----------------------------------------------------------------------------
+// Compute the denominator, and its sums weighted by 1, i and i*i, where
+// the sums include the leading coefficient of one.
+void vtkImageGaussianSmoothIIR::ComputeD(double sigma, const double p[8],
+                                         double d[4], double s[3])
+{
+  double cos1 = cos(p[2]/sigma);
+  double cos2 = cos(p[6]/sigma);
+  double exp1 = exp(p[3]/sigma);
+  double exp2 = exp(p[7]/sigma);
+
+  d[0] = -2*(exp2*cos2 + exp1*cos1);
+  d[1] = 4*cos2*cos1*exp1*exp2 + exp1*exp1 + exp2*exp2;
+  d[2] = -2*cos1*exp1*exp2*exp2 - 2*cos2*exp2*exp1*exp1;
+  d[3] = exp1*exp1*exp2*exp2;
+
+  s[0] = 1.0 + d[0] + d[1] + d[2] + d[3];
+  s[1] = d[0] + 2*d[1] + 3*d[2] + 4*d[3];
+  s[2] = d[0] + 4*d[1] + 9*d[2] + 16*d[3];
+}
+
+//----------------------------------------------------------------------------
+vtkImageGaussianSmoothIIR::vtkImageGaussianSmoothIIR(double sigma, int order)
+{
+  int i;
+
+  if (sigma == 0.0)
+    {
+    // the identity, or central differences
+    for (i = 0; i < 4; i++)
+      {
+      this->N[i] = this->M[i] = this->D[i] = 0.0;
+      }
+    this->N[0] = (order == 0 ? 1.0 : (order == 1 ? 0.0 : -2.0));
+    this->N[1] = (order == 0 ? 0.0 : (order == 1 ? -0.5 : 1.0));
+    this->M[0] = (order == 0 ? 0.0 : (order == 1 ? 0.5 : 1.0));
+    return;
+    }
+
+  const double *p = vtkImageGaussianSmoothDeriche[order == 0 ? 0 : order + 1];
+  double sn[3], sd[3], scale;
+  ComputeN(sigma, p, this->N, sn);
+  ComputeD(sigma, p, this->D, sd);
+
+  if (order == 0)
+    {
+    scale = 2*sn[0]/sd[0] - this->N[0];
+    }
+  else if (order == 1)
+    {
+    scale = 2*(sn[0]*sd[1] - sn[1]*sd[0])/(sd[0]*sd[0]);
+    }
+  else
+    {
+    // remove the response to a constant from the second derivative
+    double n0[4], sn0[3];
+    ComputeN(sigma, vtkImageGaussianSmoothDeriche[1], n0, sn0);
+    double beta = -(2*sn[0] - sd[0]*this->N[0])/(2*sn0[0] - sd[0]*n0[0]);
+    for (i = 0; i < 4; i++)
+      {
+      this->N[i] += beta*n0[i];
+      }
+    for (i = 0; i < 3; i++)
+      {
+      sn[i] += beta*sn0[i];
+      }
+    scale = (sn[2]*sd[0]*sd[0] - sd[2]*sn[0]*sd[0] -
+             2*sn[1]*sd[1]*sd[0] + 2*sd[1]*sd[1]*sn[0])/
+      (sd[0]*sd[0]*sd[0]);
+    }
+
+  for (i = 0; i < 4; i++)
+    {
+    this->N[i] /= scale;
+    }
+
+  // the anti-causal filter is the mirror of the causal filter, and is
+  // negated for the first derivative
+  double sign = (order == 1 ? -1.0 : 1.0);
+  this->M[0] = sign*(this->N[1] - this->D[0]*this->N[0]);
+  this->M[1] = sign*(this->N[2] - this->D[1]*this->N[0]);
+  this->M[2] = sign*(this->N[3] - this->D[2]*this->N[0]);
+  this->M[3] = sign*(-this->D[3]*this->N[0]);
+}
+
+//----------------------------------------------------------------------------
+// The input is extended past both of its ends by its end values, and the
+// filters start from their steady state for these values.  The buffer
+// must hold 2*(n + 8) values.
+template <class T>
+void vtkImageGaussianSmoothIIR::Filter(const T *in, vtkIdType inc, int n,
+                                       T *out, vtkIdType outInc,
+                                       int start, int end,
+                                       double *buffer) const
+{
+  const double *N = this->N;
+  const double *M = this->M;
+  const double *D = this->D;
+  double *x = buffer + 4;
+  double *y = buffer + n + 12;
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+    x[i] = static_cast<double>(in[i*inc]);
+    }
+  for (i = 1; i <= 4; i++)
+    {
+    x[-i] = x[0];
+    x[n - 1 + i] = x[n - 1];
+    }
+
+  // the causal filter
+  double sumN = N[0] + N[1] + N[2] + N[3];
+  double sumD = 1.0 + D[0] + D[1] + D[2] + D[3];
+  for (i = 1; i <= 4; i++)
+    {
+    y[-i] = x[0]*sumN/sumD;
+    }
+  for (i = 0; i <= end; i++)
+    {
+    y[i] = N[0]*x[i] + N[1]*x[i-1] + N[2]*x[i-2] + N[3]*x[i-3] -
+      D[0]*y[i-1] - D[1]*y[i-2] - D[2]*y[i-3] - D[3]*y[i-4];
+    }
+
+  // the anti-causal filter, which reuses the end of the buffer
+  double sumM = M[0] + M[1] + M[2] + M[3];
+  double z[4];
+  for (i = 0; i < 4; i++)
+    {
+    z[i] = x[n - 1]*sumM/sumD;
+    }
+  for (i = n - 1; i >= start; i--)
+    {
+    double zi = M[0]*x[i+1] + M[1]*x[i+2] + M[2]*x[i+3] + M[3]*x[i+4] -
+      D[0]*z[0] - D[1]*z[1] - D[2]*z[2] - D[3]*z[3];
+    z[3] = z[2];
+    z[2] = z[1];
+    z[1] = z[0];
+    z[0] = zi;
+    if (i <= end)
+      {
+      out[(i - start)*outInc] = static_cast<T>(y[i] + zi);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Filter the rows of an image along one axis, with the rows distributed
+// over the threads.
+template <class T>
+class vtkImageGaussianSmoothRows
+{
+public:
+  const vtkImageGaussianSmoothIIR *Filter;
+  const T *InPtr;
+  T *OutPtr;
+  vtkIdType InIncs[3];
+  vtkIdType OutIncs[3];
+  int Size[3];
+  int Length;
+  int Start;
+  int End;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    std::vector<double> buffer(2*(this->Length + 8));
+    for (vtkIdType row = begin; row < end; row++)
+      {
+      // the index of the row along the component and the two other axes
+      vtkIdType idx = row;
+      int idxC = static_cast<int>(idx % this->Size[0]);
+      idx /= this->Size[0];
+      int idx1 = static_cast<int>(idx % this->Size[1]);
+      int idx2 = static_cast<int>(idx / this->Size[1]);
+      this->Filter->Filter(
+        this->InPtr + idxC + idx1*this->InIncs[1] + idx2*this->InIncs[2],
+        this->InIncs[0], this->Length,
+        this->OutPtr + idxC + idx1*this->OutIncs[1] + idx2*this->OutIncs[2],
+        this->OutIncs[0], this->Start, this->End, &buffer[0]);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImageGaussianSmoothRecursiveExecute(
+  const vtkImageGaussianSmoothIIR *filter, int axis,
+  vtkImageData *inData, int inExt[6], T *inPtr,
+  vtkImageData *outData, int outExt[6], T *outPtr)
+{
+  vtkIdType *inIncs = inData->GetIncrements();
+  vtkIdType *outIncs = outData->GetIncrements();
+
+  // put the filtered axis first, followed by the other two axes
+  int axis1 = (axis == 0 ? 1 : 0);
+  int axis2 = (axis == 2 ? 1 : 2);
+
+  vtkImageGaussianSmoothRows<T> rows;
+  rows.Filter = filter;
+  rows.InPtr = inPtr;
+  rows.OutPtr = outPtr;
+  rows.InIncs[0] = inIncs[axis];
+  rows.InIncs[1] = inIncs[axis1];
+  rows.InIncs[2] = inIncs[axis2];
+  rows.OutIncs[0] = outIncs[axis];
+  rows.OutIncs[1] = outIncs[axis1];
+  rows.OutIncs[2] = outIncs[axis2];
+  rows.Size[0] = outData->GetNumberOfScalarComponents();
+  rows.Size[1] = outExt[2*axis1+1] - outExt[2*axis1] + 1;
+  rows.Size[2] = outExt[2*axis2+1] - outExt[2*axis2] + 1;
+  rows.Length = inExt[2*axis+1] - inExt[2*axis] + 1;
+  rows.Start = outExt[2*axis] - inExt[2*axis];
+  rows.End = outExt[2*axis+1] - inExt[2*axis];
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(rows.Size[0])*rows.Size[1]*
+                   rows.Size[2], rows);
+}
+
+//----------------------------------------------------------------------------
+// This method filters along one axis with the recursive gaussian, using
+// whole rows of the input for each row of the output.
+void vtkImageGaussianSmooth::ExecuteAxisRecursive(int axis,
+                                                  vtkImageData *inData,
+                                                  int inExt[6],
+                                                  vtkImageData *outData,
+                                                  int outExt[6])
+{
+  vtkImageGaussianSmoothIIR filter(this->StandardDeviations[axis],
+                                   this->DerivativeOrders[axis]);
+
+  // the input rows start at inExt along the axis, and at outExt along
+  // the other axes
+  int coords[3] = { outExt[0], outExt[2], outExt[4] };
+  coords[axis] = inExt[2*axis];
+  void *inPtr = inData->GetScalarPointer(coords);
+  void *outPtr = outData->GetScalarPointerForExtent(outExt);
+
+  switch (inData->GetScalarType())
+    {
+    vtkTemplateMacro(
+      vtkImageGaussianSmoothRecursiveExecute(&filter, axis,
+                                             inData, inExt,
+                                             static_cast<VTK_TT*>(inPtr),
+                                             outData, outExt,
+                                             static_cast<VTK_TT*>(outPtr))
+      );
+    default:
+      vtkErrorMacro("Unknown scalar type");
+      return;
+    }
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 size_t vtkImageGaussianSmoothGetTypeSize(T*)
@@ -267,6 +667,19 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
   int coords[3];
   vtkIdType *outIncs, outIncA;
 
+  if (this->Mode == VTK_GAUSSIAN_SMOOTH_RECURSIVE)
+    {
+    this->ExecuteAxisRecursive(axis, inData, inExt, outData, outExt);
+    if (total)
+      {
+      *pcount += (outExt[1] - outExt[0] + 1) * (outExt[3] - outExt[2] + 1)
+        * (outExt[5] - outExt[4] + 1) * outData->GetNumberOfScalarComponents();
+      this->UpdateProgress(static_cast<double>(*pcount) /
+                           static_cast<double>(total));
+      }
+    return;
+    }
+
   // Get the correct starting pointer of the output
   outPtr = outData->GetScalarPointerForExtent(outExt);
   outIncs = outData->GetIncrements();
@@ -294,8 +707,7 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
   wholeMax = wholeExtent[axis*2+1];
 
   // allocate memory for the kernel
-  radius = static_cast<int>(this->StandardDeviations[axis]
-                            * this->RadiusFactors[axis]);
+  radius = this->ComputeRadius(axis);
   size = 2*radius + 1;
   kernel = new double[size];
 
@@ -329,7 +741,8 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
       {
       this->ComputeKernel(kernel, -radius+kernelLeftClip,
                           radius-kernelRightClip,
-                          static_cast<double>(this->StandardDeviations[axis]));
+                          static_cast<double>(this->StandardDeviations[axis]),
+                          this->DerivativeOrders[axis]);
       kernelSize = size - kernelLeftClip - kernelRightClip;
       }
     previousClipped = currentClipped;
@@ -357,6 +770,76 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis,
   delete [] kernel;
 }
 
+//----------------------------------------------------------------------------
+// The recursive gaussian runs along whole rows of the input, so rather than
+// splitting the output into pieces for the threads, the rows along each
+// axis are distributed over the threads.
+int vtkImageGaussianSmooth::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  for (int idx = 0; idx < this->Dimensionality && idx < 3; ++idx)
+    {
+    if (this->DerivativeOrders[idx] < 0 || this->DerivativeOrders[idx] > 2)
+      {
+      vtkErrorMacro("RequestData: DerivativeOrders must be 0, 1 or 2");
+      return 0;
+      }
+    }
+
+  if (this->Mode != VTK_GAUSSIAN_SMOOTH_RECURSIVE)
+    {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkImageData *inData = vtkImageData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkImageData *outData = vtkImageData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  int outExt[6], inExt[6], wholeExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  this->AllocateOutputData(outData, outInfo, outExt);
+  this->CopyAttributeData(inData, outData, inputVector);
+
+  // this filter expects that input is the same type as output.
+  if (inData->GetScalarType() != outData->GetScalarType())
+    {
+    vtkErrorMacro("Execute: input ScalarType, "
+                  << inData->GetScalarType()
+                  << ", must match out ScalarType "
+                  << outData->GetScalarType());
+    return 1;
+    }
+
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] ||
+      outExt[4] > outExt[5])
+    {
+    return 1;
+    }
+
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  for (int idx = 0; idx < 6; ++idx)
+    {
+    inExt[idx] = outExt[idx];
+    }
+  this->InternalRequestUpdateExtent(inExt, wholeExt);
+
+  // progress is updated after each axis
+  int count = 0, cycle = 0;
+  int total = this->Dimensionality * (outExt[1] - outExt[0] + 1)
+    * (outExt[3] - outExt[2] + 1) * (outExt[5] - outExt[4] + 1)
+    * inData->GetNumberOfScalarComponents();
+
+  this->ExecuteAxes(inData, inExt, outData, outExt,
+                    &cycle, total / 50, &count, total, inInfo);
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // This method decomposes the gaussian and smooths along each axis.
 void vtkImageGaussianSmooth::ThreadedRequestData(
@@ -402,11 +885,24 @@ void vtkImageGaussianSmooth::ThreadedRequestData(
   outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
   this->InternalRequestUpdateExtent(inExt, wholeExt);
 
+  this->ExecuteAxes(inData[0][0], inExt, outData[0], outExt,
+                    &cycle, target, &count, total, inInfo);
+}
+
+//----------------------------------------------------------------------------
+// This method smooths along each axis in turn, through intermediate images
+// that are clipped to the output extent along the axes that are done.
+void vtkImageGaussianSmooth::ExecuteAxes(vtkImageData *inData, int inExt[6],
+                                         vtkImageData *outData, int outExt[6],
+                                         int *pcycle, int target,
+                                         int *pcount, int total,
+                                         vtkInformation *inInfo)
+{
   switch (this->Dimensionality)
     {
     case 1:
-      this->ExecuteAxis(0, inData[0][0], inExt, outData[0], outExt,
-                        &cycle, target, &count, total, inInfo);
+      this->ExecuteAxis(0, inData, inExt, outData, outExt,
+                        pcycle, target, pcount, total, inInfo);
       break;
     case 2:
       int tempExt[6];
@@ -418,12 +914,12 @@ void vtkImageGaussianSmooth::ThreadedRequestData(
       // create a temp data for intermediate results
       tempData = vtkImageData::New();
       tempData->SetExtent(tempExt);
-      tempData->AllocateScalars(inData[0][0]->GetScalarType(),
-                                inData[0][0]->GetNumberOfScalarComponents());
-      this->ExecuteAxis(1, inData[0][0], inExt, tempData, tempExt,
-                        &cycle, target, &count, total, inInfo);
-      this->ExecuteAxis(0, tempData, tempExt, outData[0], outExt,
-                        &cycle, target, &count, total, inInfo);
+      tempData->AllocateScalars(inData->GetScalarType(),
+                                inData->GetNumberOfScalarComponents());
+      this->ExecuteAxis(1, inData, inExt, tempData, tempExt,
+                        pcycle, target, pcount, total, inInfo);
+      this->ExecuteAxis(0, tempData, tempExt, outData, outExt,
+                        pcycle, target, pcount, total, inInfo);
       // release temporary data
       tempData->Delete();
       break;
@@ -443,20 +939,20 @@ void vtkImageGaussianSmooth::ThreadedRequestData(
       // create a temp data for intermediate results
       temp0Data = vtkImageData::New();
       temp0Data->SetExtent(temp0Ext);
-      temp0Data->AllocateScalars(inData[0][0]->GetScalarType(),
-                                 inData[0][0]->GetNumberOfScalarComponents());
+      temp0Data->AllocateScalars(inData->GetScalarType(),
+                                 inData->GetNumberOfScalarComponents());
 
       temp1Data = vtkImageData::New();
       temp1Data->SetExtent(temp1Ext);
-      temp1Data->AllocateScalars(inData[0][0]->GetScalarType(),
-                                 inData[0][0]->GetNumberOfScalarComponents());
-      this->ExecuteAxis(2, inData[0][0], inExt, temp0Data, temp0Ext,
-                        &cycle, target, &count, total, inInfo);
+      temp1Data->AllocateScalars(inData->GetScalarType(),
+                                 inData->GetNumberOfScalarComponents());
+      this->ExecuteAxis(2, inData, inExt, temp0Data, temp0Ext,
+                        pcycle, target, pcount, total, inInfo);
       this->ExecuteAxis(1, temp0Data, temp0Ext, temp1Data, temp1Ext,
-                        &cycle, target, &count, total, inInfo);
+                        pcycle, target, pcount, total, inInfo);
       temp0Data->Delete();
-      this->ExecuteAxis(0, temp1Data, temp1Ext, outData[0], outExt,
-                        &cycle, target, &count, total, inInfo);
+      this->ExecuteAxis(0, temp1Data, temp1Ext, outData, outExt,
+                        pcycle, target, pcount, total, inInfo);
       temp1Data->Delete();
       break;
     }
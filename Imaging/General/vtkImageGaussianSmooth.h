@@ -16,6 +16,13 @@
 // .SECTION Description
 // vtkImageGaussianSmooth implements a convolution of the input image
 // with a gaussian. Supports from one to three dimensional convolutions.
+// The default FIR mode convolves with a kernel that is clamped to zero
+// at RadiusFactors times the standard deviation, so its cost grows with
+// the standard deviation.  The recursive mode instead approximates the
+// gaussian with a fourth order recursive (IIR) filter after Deriche,
+// whose cost does not depend on the standard deviation.  Either mode can
+// also compute the first or second derivative of the gaussian along
+// each axis, see SetDerivativeOrders().
 
 #ifndef __vtkImageGaussianSmooth_h
 #define __vtkImageGaussianSmooth_h
@@ -24,6 +31,9 @@
 #include "vtkImagingGeneralModule.h" // For export macro
 #include "vtkThreadedImageAlgorithm.h"
 
+#define VTK_GAUSSIAN_SMOOTH_FIR 0
+#define VTK_GAUSSIAN_SMOOTH_RECURSIVE 1
+
 class VTKIMAGINGGENERAL_EXPORT vtkImageGaussianSmooth : public vtkThreadedImageAlgorithm
 {
 public:
@@ -70,6 +80,32 @@ public:
   vtkSetMacro(Dimensionality, int);
   vtkGetMacro(Dimensionality, int);
 
+  // Description:
+  // Set/Get how the gaussian is computed.  The FIR mode (the default)
+  // convolves with a kernel of radius RadiusFactors*StandardDeviations.
+  // The recursive mode ignores the RadiusFactors, and needs the whole
+  // extent of the input along the smoothed axes.  It runs in constant
+  // time per pixel and is best for standard deviations of a few pixels
+  // or more, while for a standard deviation below one pixel it is a
+  // poor approximation of the gaussian.
+  vtkSetClampMacro(Mode, int, VTK_GAUSSIAN_SMOOTH_FIR,
+                   VTK_GAUSSIAN_SMOOTH_RECURSIVE);
+  void SetModeToFIR()
+    { this->SetMode(VTK_GAUSSIAN_SMOOTH_FIR); }
+  void SetModeToRecursive()
+    { this->SetMode(VTK_GAUSSIAN_SMOOTH_RECURSIVE); }
+  vtkGetMacro(Mode, int);
+  const char *GetModeAsString();
+
+  // Description:
+  // Set/Get the order of the gaussian derivative along each axis, which
+  // can be 0 (smoothing, the default), 1 or 2.  The derivatives are in
+  // pixel units, and can be negative, so the input should have a signed
+  // scalar type.  With a standard deviation of zero, the derivatives
+  // become central differences.
+  vtkSetVector3Macro(DerivativeOrders, int);
+  vtkGetVector3Macro(DerivativeOrders, int);
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth();
@@ -77,14 +113,27 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  int Mode;
+  int DerivativeOrders[3];
 
-  void ComputeKernel(double *kernel, int min, int max, double std);
+  void ComputeKernel(double *kernel, int min, int max, double std,
+                     int order = 0);
+  int ComputeRadius(int axis);
   virtual int RequestUpdateExtent (vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   void InternalRequestUpdateExtent(int *, int*);
   void ExecuteAxis(int axis, vtkImageData *inData, int inExt[6],
                    vtkImageData *outData, int outExt[6],
                    int *pcycle, int target, int *pcount, int total,
                    vtkInformation *inInfo);
+  void ExecuteAxisRecursive(int axis, vtkImageData *inData, int inExt[6],
+                            vtkImageData *outData, int outExt[6]);
+  void ExecuteAxes(vtkImageData *inData, int inExt[6],
+                   vtkImageData *outData, int outExt[6],
+                   int *pcycle, int target, int *pcount, int total,
+                   vtkInformation *inInfo);
+  virtual int RequestData(vtkInformation *request,
+                          vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
                            vtkInformationVector *outputVector,
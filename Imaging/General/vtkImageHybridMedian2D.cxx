@@ -19,9 +19,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
-#include <vector>
 #include <algorithm>
-#include <numeric>
 
 vtkStandardNewMacro(vtkImageHybridMedian2D);
 
@@ -53,7 +51,9 @@ void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D *self,
   T *inPtr0, *inPtr1, *inPtrC;
   T *outPtr0, *outPtr1, *outPtrC, *ptr;
   T median1, median2, temp;
-  std::vector<T> array;
+  // the + and x neighborhoods have at most 9 pixels each
+  T array[9];
+  int size;
   unsigned long count = 0;
   unsigned long target;
 
@@ -98,119 +98,119 @@ void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D *self,
           // compute median of + neighborhood
           // note that y axis direction is up in vtk images, not down
           // as in screen coordinates
-          array.clear();
+          size = 0;
           // Center
           ptr = inPtrC;
-          array.push_back( *ptr );
+          array[size++] = *ptr;
           // left
           ptr = inPtrC;
           if (idx0 > wholeMin0)
             {
             ptr -= inInc0;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx0 - 1 > wholeMin0)
             {
             ptr -= inInc0;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           // right
           ptr = inPtrC;
           if (idx0 < wholeMax0)
             {
             ptr += inInc0;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx0 + 1 < wholeMax0)
             {
             ptr += inInc0;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           // down
           ptr = inPtrC;
           if (idx1 > wholeMin1)
             {
             ptr -= inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx1 - 1 > wholeMin1)
             {
             ptr -= inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           // up
           ptr = inPtrC;
           if (idx1 < wholeMax1)
             {
             ptr += inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx1 + 1 < wholeMax1)
             {
             ptr += inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
 
-          std::sort(array.begin(),array.end());
-          median1 = array[static_cast<unsigned int>(0.5*array.size())];
+          std::nth_element(array, array + size/2, array + size);
+          median1 = array[size/2];
 
           // compute median of x neighborhood
           // note that y axis direction is up in vtk images, not down
           // as in screen coordinates
-          array.clear();
+          size = 0;
           // Center
           ptr = inPtrC;
-          array.push_back( *ptr );
+          array[size++] = *ptr;
           // lower left
           if (idx0 > wholeMin0 && idx1 > wholeMin1)
             {
             ptr -= inInc0 + inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx0-1 > wholeMin0 && idx1-1 > wholeMin1)
             {
             ptr -= inInc0 + inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           // upper right
           ptr = inPtrC;
           if (idx0 < wholeMax0 && idx1 < wholeMax1)
             {
             ptr += inInc0 + inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx0+1 < wholeMax0 && idx1+1 < wholeMax1)
             {
             ptr += inInc0 + inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           // upper left
           ptr = inPtrC;
           if (idx0 > wholeMin0 && idx1 < wholeMax1)
             {
             ptr += -inInc0 + inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx0-1 > wholeMin0 && idx1+1 < wholeMax1)
             {
             ptr += -inInc0 + inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           // lower right
           ptr = inPtrC;
           if (idx0 < wholeMax0 && idx1 > wholeMin1)
             {
             ptr += inInc0 - inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
           if (idx0+1 < wholeMax0 && idx1-1 > wholeMin1)
             {
             ptr += inInc0 - inInc1;
-            array.push_back( *ptr );
+            array[size++] = *ptr;
             }
 
-          std::sort(array.begin(),array.end());
-          median2 = array[static_cast<unsigned int>(0.5*array.size())];
+          std::nth_element(array, array + size/2, array + size);
+          median2 = array[size/2];
 
           // Compute the median of the three. (med1, med2 and center)
           if (median1 > median2)
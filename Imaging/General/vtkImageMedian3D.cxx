@@ -22,6 +22,10 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMedian3D);
 
@@ -30,6 +34,7 @@ vtkStandardNewMacro(vtkImageMedian3D);
 vtkImageMedian3D::vtkImageMedian3D()
 {
   this->NumberOfElements = 0;
+  this->Percentile = 50.0;
   this->SetKernelSize(1,1,1);
   this->HandleBoundaries = 1;
 }
@@ -45,6 +50,7 @@ void vtkImageMedian3D::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "Percentile: " << this->Percentile << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -180,6 +186,97 @@ double *vtkImageMedian3DAccumulateMedian(int &UpNum, int &DownNum,
   return Median;
 }
 
+//-----------------------------------------------------------------------------
+// The rank of the requested percentile among n samples.
+inline int vtkImageMedian3DRank(double percentile, int n)
+{
+  return static_cast<int>(percentile*0.01*(n - 1) + 0.5);
+}
+
+//-----------------------------------------------------------------------------
+// A histogram with one bin per value, for 8-bit and 16-bit integers.  The
+// bins are grouped into blocks, and the count for each block is kept so
+// that a search can skip over whole blocks.  The bin that held the last
+// rank is remembered along with the number of samples below it, since the
+// rank moves only a little as the neighborhood slides.
+class vtkImageMedian3DHistogram
+{
+public:
+  vtkImageMedian3DHistogram(int bits) :
+    BlockShift(bits/2), Bins(1 << bits), Blocks(1 << (bits - bits/2)),
+    Current(0), Below(0) {}
+
+  void Add(int bin)
+  {
+    ++this->Bins[bin];
+    ++this->Blocks[bin >> this->BlockShift];
+    this->Below += (bin < this->Current);
+  }
+
+  void Remove(int bin)
+  {
+    --this->Bins[bin];
+    --this->Blocks[bin >> this->BlockShift];
+    this->Below -= (bin < this->Current);
+  }
+
+  // Find the bin of the sample with the given rank.
+  int Find(int rank);
+
+private:
+  int BlockShift;
+  std::vector<int> Bins;
+  std::vector<int> Blocks;
+  int Current;
+  int Below;
+};
+
+//-----------------------------------------------------------------------------
+int vtkImageMedian3DHistogram::Find(int rank)
+{
+  int blockMask = (1 << this->BlockShift) - 1;
+  int bin = this->Current;
+  int below = this->Below;
+
+  // move down while there are too many samples below the bin
+  while (below > rank)
+    {
+    int block = (bin >> this->BlockShift) - 1;
+    if ((bin & blockMask) == 0 && below - this->Blocks[block] > rank)
+      {
+      below -= this->Blocks[block];
+      bin -= blockMask + 1;
+      }
+    else
+      {
+      below -= this->Bins[--bin];
+      }
+    }
+
+  // move up while the rank is above the bin
+  for (;;)
+    {
+    int block = (bin >> this->BlockShift);
+    if ((bin & blockMask) == 0 && below + this->Blocks[block] <= rank)
+      {
+      below += this->Blocks[block];
+      bin += blockMask + 1;
+      }
+    else if (below + this->Bins[bin] <= rank)
+      {
+      below += this->Bins[bin++];
+      }
+    else
+      {
+      break;
+      }
+    }
+
+  this->Current = bin;
+  this->Below = below;
+  return bin;
+}
+
 } // end anonymous namespace
 
 //-----------------------------------------------------------------------------
@@ -217,6 +314,8 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
   int *inExt;
   unsigned long count = 0;
   unsigned long target;
+  double percentile = self->GetPercentile();
+  int numSamples;
 
   if (!inArray)
     {
@@ -296,6 +395,33 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
         {
         for (outIdxC = 0; outIdxC < numComp; outIdxC++)
           {
+          if (percentile != 50.0)
+            {
+            // Find the requested rank among the neighborhood values
+            numSamples = 0;
+            tmpPtr2 = inPtr0 + outIdxC;
+            for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
+              {
+              tmpPtr1 = tmpPtr2;
+              for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+                {
+                tmpPtr0 = tmpPtr1;
+                for (hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
+                  {
+                  Sort[numSamples++] = *tmpPtr0;
+                  tmpPtr0 += inInc0;
+                  }
+                tmpPtr1 += inInc1;
+                }
+              tmpPtr2 += inInc2;
+              }
+            Median = Sort + vtkImageMedian3DRank(percentile, numSamples);
+            std::nth_element(Sort, Median, Sort + numSamples);
+            *outPtr = static_cast<T>(*Median);
+            outPtr++;
+            continue;
+            }
+
           // Compute median of neighborhood
           // Note: For boundary, NumNeighborhood could be changed for
           // a faster sort.
@@ -369,6 +495,174 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
   delete [] Sort;
 }
 
+//-----------------------------------------------------------------------------
+// For 8-bit and 16-bit integer types, slide a histogram of the neighborhood
+// along each row, so that only the planes of samples that enter or leave
+// the neighborhood have to be added to or removed from the histogram.
+template <class T>
+void vtkImageMedian3DHistogramExecute(vtkImageMedian3D *self,
+                                      vtkImageData *inData,
+                                      vtkImageData *outData, T *outPtr,
+                                      int outExt[6], int id,
+                                      vtkDataArray *inArray)
+{
+  int *kernelMiddle, *kernelSize, *inExt;
+  int outIdx0, outIdx1, outIdx2, outIdxC;
+  vtkIdType inInc0, inInc1, inInc2;
+  vtkIdType outIncX, outIncY, outIncZ;
+  int hoodMin0, hoodMax0, hoodMin1, hoodMax1, hoodMin2, hoodMax2;
+  int hoodIdx1, hoodIdx2;
+  int windowMin0, windowMax0;
+  int numComp, numSamples, bin;
+  T *inPtr, *inPtr1, *tmpPtr1, *tmpPtr2, *lastPtr;
+  T *outPtr0;
+  unsigned long count = 0;
+  unsigned long target;
+
+  if (!inArray)
+    {
+    return;
+    }
+
+  // The histogram bin for value v is v + offset
+  int offset = -static_cast<int>(vtkTypeTraits<T>::Min());
+  vtkImageMedian3DHistogram histogram(8*sizeof(T));
+  double percentile = self->GetPercentile();
+
+  // Get information to march through data
+  inData->GetIncrements(inInc0, inInc1, inInc2);
+  outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
+  kernelMiddle = self->GetKernelMiddle();
+  kernelSize = self->GetKernelSize();
+  inExt = inData->GetExtent();
+  numComp = inArray->GetNumberOfComponents();
+  inPtr = static_cast<T *>(inArray->GetVoidPointer(0));
+
+  target = static_cast<unsigned long>((outExt[5] - outExt[4] + 1)*
+                                      (outExt[3] - outExt[2] + 1)/50.0);
+  target++;
+
+  for (outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+    {
+    // The neighborhood, clipped by the input extent
+    hoodMin2 = outIdx2 - kernelMiddle[2];
+    hoodMax2 = hoodMin2 + kernelSize[2] - 1;
+    hoodMin2 = (hoodMin2 > inExt[4]) ? hoodMin2 : inExt[4];
+    hoodMax2 = (hoodMax2 < inExt[5]) ? hoodMax2 : inExt[5];
+    for (outIdx1 = outExt[2];
+         !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+      {
+      if (!id)
+        {
+        if (!(count%target))
+          {
+          self->UpdateProgress(count/(50.0*target));
+          }
+        count++;
+        }
+      hoodMin1 = outIdx1 - kernelMiddle[1];
+      hoodMax1 = hoodMin1 + kernelSize[1] - 1;
+      hoodMin1 = (hoodMin1 > inExt[2]) ? hoodMin1 : inExt[2];
+      hoodMax1 = (hoodMax1 < inExt[3]) ? hoodMax1 : inExt[3];
+      inPtr1 = inPtr + (hoodMin1 - inExt[2])*inInc1 +
+        (hoodMin2 - inExt[4])*inInc2 - inExt[0]*inInc0;
+      lastPtr = inPtr1 + (hoodMax1 - hoodMin1)*inInc1 +
+        (hoodMax2 - hoodMin2)*inInc2;
+      numSamples = (hoodMax1 - hoodMin1 + 1)*(hoodMax2 - hoodMin2 + 1);
+
+      for (outIdxC = 0; outIdxC < numComp; outIdxC++)
+        {
+        // The histogram holds the planes from windowMin0 to windowMax0
+        windowMin0 = outExt[0] - kernelMiddle[0];
+        windowMin0 = (windowMin0 > inExt[0]) ? windowMin0 : inExt[0];
+        windowMax0 = windowMin0 - 1;
+        outPtr0 = outPtr + outIdxC;
+        for (outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+          {
+          hoodMin0 = outIdx0 - kernelMiddle[0];
+          hoodMax0 = hoodMin0 + kernelSize[0] - 1;
+          hoodMin0 = (hoodMin0 > inExt[0]) ? hoodMin0 : inExt[0];
+          hoodMax0 = (hoodMax0 < inExt[1]) ? hoodMax0 : inExt[1];
+
+          // Add the planes that entered the neighborhood
+          while (windowMax0 < hoodMax0)
+            {
+            ++windowMax0;
+            tmpPtr2 = inPtr1 + windowMax0*inInc0 + outIdxC;
+            for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
+              {
+              tmpPtr1 = tmpPtr2;
+              for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+                {
+                histogram.Add(*tmpPtr1 + offset);
+                tmpPtr1 += inInc1;
+                }
+              tmpPtr2 += inInc2;
+              }
+            }
+
+          // Remove the planes that left the neighborhood
+          while (windowMin0 < hoodMin0)
+            {
+            tmpPtr2 = inPtr1 + windowMin0*inInc0 + outIdxC;
+            for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
+              {
+              tmpPtr1 = tmpPtr2;
+              for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+                {
+                histogram.Remove(*tmpPtr1 + offset);
+                tmpPtr1 += inInc1;
+                }
+              tmpPtr2 += inInc2;
+              }
+            ++windowMin0;
+            }
+
+          int n = (hoodMax0 - hoodMin0 + 1)*numSamples;
+          if (percentile != 50.0)
+            {
+            bin = histogram.Find(vtkImageMedian3DRank(percentile, n));
+            }
+          else if (n & 1)
+            {
+            bin = histogram.Find(n/2);
+            }
+          else
+            {
+            // For an even number of samples, the median is taken from
+            // all of the samples except the last one
+            int last = lastPtr[hoodMax0*inInc0 + outIdxC] + offset;
+            histogram.Remove(last);
+            bin = histogram.Find((n - 2)/2);
+            histogram.Add(last);
+            }
+
+          *outPtr0 = static_cast<T>(bin - offset);
+          outPtr0 += numComp;
+          }
+
+        // Empty the histogram for the next row
+        for (; windowMin0 <= windowMax0; ++windowMin0)
+          {
+          tmpPtr2 = inPtr1 + windowMin0*inInc0 + outIdxC;
+          for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
+            {
+            tmpPtr1 = tmpPtr2;
+            for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+              {
+              histogram.Remove(*tmpPtr1 + offset);
+              tmpPtr1 += inInc1;
+              }
+            tmpPtr2 += inInc2;
+            }
+          }
+        }
+      outPtr += (outExt[1] - outExt[0] + 1)*numComp + outIncY;
+      }
+    outPtr += outIncZ;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output region types.
@@ -402,13 +696,43 @@ void vtkImageMedian3D::ThreadedRequestData(
 
   switch (inArray->GetDataType())
     {
-    vtkTemplateMacro(
-      vtkImageMedian3DExecute(this,inData[0][0],
-                              static_cast<VTK_TT *>(inPtr),
-                              outData[0], static_cast<VTK_TT *>(outPtr),
-                              outExt, id,inArray));
+    // Use a histogram for types with at most 65536 values
+    case VTK_CHAR:
+      vtkImageMedian3DHistogramExecute(this, inData[0][0], outData[0],
+                                       static_cast<char *>(outPtr),
+                                       outExt, id, inArray);
+      break;
+    case VTK_SIGNED_CHAR:
+      vtkImageMedian3DHistogramExecute(this, inData[0][0], outData[0],
+                                       static_cast<signed char *>(outPtr),
+                                       outExt, id, inArray);
+      break;
+    case VTK_UNSIGNED_CHAR:
+      vtkImageMedian3DHistogramExecute(this, inData[0][0], outData[0],
+                                       static_cast<unsigned char *>(outPtr),
+                                       outExt, id, inArray);
+      break;
+    case VTK_SHORT:
+      vtkImageMedian3DHistogramExecute(this, inData[0][0], outData[0],
+                                       static_cast<short *>(outPtr),
+                                       outExt, id, inArray);
+      break;
+    case VTK_UNSIGNED_SHORT:
+      vtkImageMedian3DHistogramExecute(this, inData[0][0], outData[0],
+                                       static_cast<unsigned short *>(outPtr),
+                                       outExt, id, inArray);
+      break;
     default:
-      vtkErrorMacro(<< "Execute: Unknown input ScalarType");
-      return;
+      switch (inArray->GetDataType())
+        {
+        vtkTemplateMacro(
+          vtkImageMedian3DExecute(this,inData[0][0],
+                                  static_cast<VTK_TT *>(inPtr),
+                                  outData[0], static_cast<VTK_TT *>(outPtr),
+                                  outExt, id,inArray));
+        default:
+          vtkErrorMacro(<< "Execute: Unknown input ScalarType");
+          return;
+        }
     }
 }
@@ -18,7 +18,15 @@
 // median value from a rectangular neighborhood around that pixel.
 // Neighborhoods can be no more than 3 dimensional.  Setting one
 // axis of the neighborhood kernelSize to 1 changes the filter
-// into a 2D median.
+// into a 2D median.  By setting the Percentile, the filter becomes
+// a rank filter that can produce e.g. the minimum or the maximum of
+// the neighborhood instead of the median.
+//
+// For 8-bit and 16-bit integer data, a histogram of the neighborhood
+// is kept while the neighborhood slides along each row, so that only
+// the samples that enter and leave the neighborhood have to be visited.
+// This makes large kernels much faster than with other data types,
+// where the samples of each neighborhood are sorted.
 
 
 #ifndef __vtkImageMedian3D_h
@@ -44,11 +52,20 @@ public:
   // Return the number of elements in the median mask
   vtkGetMacro(NumberOfElements,int);
 
+  // Description:
+  // The percentile of the neighborhood values that is produced, where 0
+  // gives the minimum and 100 gives the maximum.  The default is 50, the
+  // median.  When a neighborhood has an even number of samples, the
+  // median is taken from all of its samples except for the last one.
+  vtkSetClampMacro(Percentile,double,0.0,100.0);
+  vtkGetMacro(Percentile,double);
+
 protected:
   vtkImageMedian3D();
   ~vtkImageMedian3D();
 
   int NumberOfElements;
+  double Percentile;
 
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
@@ -15,10 +15,12 @@
 #include "vtkDiscretizableColorTransferFunction.h"
 
 #include "vtkCommand.h"
+#include "vtkDataArrayRange.h"
 #include "vtkLookupTable.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPiecewiseFunction.h"
+#include "vtkSMPTools.h"
 #include "vtkTuple.h"
 
 #include <vector>
@@ -29,6 +31,62 @@ public:
   std::vector<vtkTuple<double, 3> > IndexedColors;
 };
 
+namespace
+{
+// Set the alpha of the RGBA colors of a range of scalars from the scalar
+// opacity function, which is only read.
+template <class TRange>
+class vtkDiscretizableColorTransferFunctionOpacity
+{
+public:
+  vtkDiscretizableColorTransferFunctionOpacity(const TRange& range,
+                                               vtkPiecewiseFunction *opacity,
+                                               unsigned char *colors)
+    : Range(range), Opacity(opacity), Colors(colors) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      double alpha =
+        this->Opacity->GetValue(static_cast<double>(this->Range(i, 0)));
+      this->Colors[4*i+3] = static_cast<unsigned char>(alpha * 255.0 + 0.5);
+      }
+    }
+
+private:
+  const TRange& Range;
+  vtkPiecewiseFunction *Opacity;
+  unsigned char *Colors;
+};
+
+struct vtkDiscretizableColorTransferFunctionOpacityWorker
+{
+  vtkPiecewiseFunction *Opacity;
+  unsigned char *Colors;
+
+  template <class TRange>
+  void Execute(const TRange& range)
+    {
+    vtkDiscretizableColorTransferFunctionOpacity<TRange> functor(
+      range, this->Opacity, this->Colors);
+    vtkSMPTools::For(0, range.GetNumberOfTuples(), 1024, functor);
+    }
+
+  template <class T, int N>
+  void operator()(vtkDataArrayTupleRange<T, N>& range)
+    {
+    this->Execute(range);
+    }
+
+  template <class T, int N>
+  void operator()(vtkSOADataArrayTupleRange<T, N>& range)
+    {
+    this->Execute(range);
+    }
+};
+}
+
 vtkStandardNewMacro(vtkDiscretizableColorTransferFunction);
 vtkCxxSetObjectMacro(vtkDiscretizableColorTransferFunction,
   ScalarOpacityFunction, vtkPiecewiseFunction);
@@ -342,11 +400,20 @@ vtkUnsignedCharArray* vtkDiscretizableColorTransferFunction::MapScalars(vtkDataA
      this->EnableOpacityMapping &&
      this->ScalarOpacityFunction.GetPointer())
     {
-    for(vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+    // the opacity of the values of arrays with a single component is
+    // computed in parallel
+    vtkDiscretizableColorTransferFunctionOpacityWorker worker;
+    worker.Opacity = this->ScalarOpacityFunction;
+    worker.Colors = colors->GetPointer(0);
+    if (!vtkDataArrayRangeDispatch::ExecuteFixed<1>(scalars, worker) &&
+        !vtkDataArrayRangeDispatch::ExecuteFixedSOA<1>(scalars, worker))
       {
-      double value = scalars->GetTuple1(i);
-      double alpha = this->ScalarOpacityFunction->GetValue(value);
-      colors->SetValue(4*i+3, static_cast<unsigned char>(alpha * 255.0 + 0.5));
+      for(vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+        {
+        double value = scalars->GetTuple1(i);
+        double alpha = this->ScalarOpacityFunction->GetValue(value);
+        colors->SetValue(4*i+3, static_cast<unsigned char>(alpha * 255.0 + 0.5));
+        }
       }
     }
 
@@ -66,6 +66,19 @@ protected:
   vtkLookupTableWithEnabling(int sze=256, int ext=256);
   ~vtkLookupTableWithEnabling();
 
+  // Description:
+  // Map the magnitudes through MapScalarsThroughTable2(), which disables
+  // the colors.
+  void MapVectorMagnitudesThroughTable(void *input, unsigned char *output,
+                                       int inputDataType, int numberOfValues,
+                                       int numberOfComponents, int vectorSize,
+                                       int outputFormat)
+    {
+    this->vtkScalarsToColors::MapVectorMagnitudesThroughTable(
+      input, output, inputDataType, numberOfValues, numberOfComponents,
+      vectorSize, outputFormat);
+    }
+
   vtkDataArray *EnabledArray;
 
 private: